@@ -35,6 +35,8 @@ int AbstractTriangulation::clear() {
   hasPreconditionedVertexNeighbors_ = false;
   hasPreconditionedVertexStars_ = false;
   hasPreconditionedVertexTriangles_ = false;
+  hasBoundedVertexNeighbors_ = false;
+  hasBoundedVertexStars_ = false;
 
   boundaryEdges_.clear();
   boundaryTriangles_.clear();
@@ -31,14 +31,42 @@
     call;                                                                 \
   }; break
 
-#define ttkTemplateMacro(triangulationType, call)                            \
+// The triangulations specialized on the grid dimension are dispatched as
+// their generic base class, so that every call is instantiated for three
+// triangulation types only. Filters whose inner loops use vertex neighbors
+// or cell vertices can use ttkGridTemplateMacro instead.
+#define ttkTemplateMacro(triangulationType, call)                              \
+  switch(triangulationType) {                                                  \
+    ttkTemplateMacroCase(                                                      \
+      ttk::Triangulation::Type::EXPLICIT, ttk::ExplicitTriangulation, call);   \
+    case ttk::Triangulation::Type::IMPLICIT_2D:                                \
+    case ttk::Triangulation::Type::IMPLICIT_3D:                                \
+      ttkTemplateMacroCase(                                                    \
+        ttk::Triangulation::Type::IMPLICIT, ttk::ImplicitTriangulation, call); \
+    case ttk::Triangulation::Type::PERIODIC_2D:                                \
+    case ttk::Triangulation::Type::PERIODIC_3D:                                \
+      ttkTemplateMacroCase(ttk::Triangulation::Type::PERIODIC,                 \
+                           ttk::PeriodicImplicitTriangulation, call);          \
+  }
+
+// Same as ttkTemplateMacro, with the triangulations specialized on the
+// grid dimension (seven instantiations instead of three).
+#define ttkGridTemplateMacro(triangulationType, call)                        \
   switch(triangulationType) {                                                \
     ttkTemplateMacroCase(                                                    \
       ttk::Triangulation::Type::EXPLICIT, ttk::ExplicitTriangulation, call); \
     ttkTemplateMacroCase(                                                    \
       ttk::Triangulation::Type::IMPLICIT, ttk::ImplicitTriangulation, call); \
+    ttkTemplateMacroCase(ttk::Triangulation::Type::IMPLICIT_2D,              \
+                         ttk::ImplicitTriangulation2D, call);                \
+    ttkTemplateMacroCase(ttk::Triangulation::Type::IMPLICIT_3D,              \
+                         ttk::ImplicitTriangulation3D, call);                \
     ttkTemplateMacroCase(ttk::Triangulation::Type::PERIODIC,                 \
                          ttk::PeriodicImplicitTriangulation, call);          \
+    ttkTemplateMacroCase(ttk::Triangulation::Type::PERIODIC_2D,              \
+                         ttk::PeriodicImplicitTriangulation2D, call);        \
+    ttkTemplateMacroCase(ttk::Triangulation::Type::PERIODIC_3D,              \
+                         ttk::PeriodicImplicitTriangulation3D, call);        \
   }
 
 namespace ttk {
@@ -2323,9 +2351,41 @@ namespace ttk {
     /// \sa getVertexNeighborNumber()
     virtual inline int preconditionVertexNeighbors() {
 
-      if(!hasPreconditionedVertexNeighbors_) {
+      if(!hasPreconditionedVertexNeighbors_ || hasBoundedVertexNeighbors_) {
         preconditionVertexNeighborsInternal();
         hasPreconditionedVertexNeighbors_ = true;
+        hasBoundedVertexNeighbors_ = false;
+      }
+      return 0;
+    }
+
+    /// Pre-process the vertex neighbors within a memory budget.
+    ///
+    /// Same as preconditionVertexNeighbors(), except that triangulations
+    /// that store this relation (explicit ones) may compute it by blocks
+    /// of vertices on first access and evict the least recently used
+    /// blocks once \p memoryBudget (in bytes) is exceeded. This is meant
+    /// for localized traversals of meshes that do not fit in memory once
+    /// fully preconditioned.
+    ///
+    /// The budget only applies to this request: the triangulation itself
+    /// is not put in a bounded mode. A later call to
+    /// preconditionVertexNeighbors() materializes the whole relation, and
+    /// concurrent bounded requests share one cache sized by the largest
+    /// budget.
+    /// \param memoryBudget Memory budget in bytes (0: no bound, same as
+    /// preconditionVertexNeighbors()).
+    /// \return Returns 0 upon success, negative values otherwise.
+    /// \sa preconditionVertexNeighbors()
+    virtual inline int preconditionVertexNeighbors(const size_t memoryBudget) {
+
+      if(memoryBudget == 0) {
+        return preconditionVertexNeighbors();
+      }
+      if(!hasPreconditionedVertexNeighbors_ || hasBoundedVertexNeighbors_) {
+        preconditionBoundedVertexNeighborsInternal(memoryBudget);
+        hasPreconditionedVertexNeighbors_ = true;
+        hasBoundedVertexNeighbors_ = true;
       }
       return 0;
     }
@@ -2349,9 +2409,41 @@ namespace ttk {
     /// \sa getVertexStarNumber()
     virtual inline int preconditionVertexStars() {
 
-      if(!hasPreconditionedVertexStars_) {
+      if(!hasPreconditionedVertexStars_ || hasBoundedVertexStars_) {
         preconditionVertexStarsInternal();
         hasPreconditionedVertexStars_ = true;
+        hasBoundedVertexStars_ = false;
+      }
+      return 0;
+    }
+
+    /// Pre-process the vertex stars within a memory budget.
+    ///
+    /// Same as preconditionVertexStars(), except that triangulations
+    /// that store this relation (explicit ones) may compute it by blocks
+    /// of vertices on first access and evict the least recently used
+    /// blocks once \p memoryBudget (in bytes) is exceeded. This is meant
+    /// for localized traversals of meshes that do not fit in memory once
+    /// fully preconditioned.
+    ///
+    /// The budget only applies to this request: the triangulation itself
+    /// is not put in a bounded mode. A later call to
+    /// preconditionVertexStars() materializes the whole relation, and
+    /// concurrent bounded requests share one cache sized by the largest
+    /// budget.
+    /// \param memoryBudget Memory budget in bytes (0: no bound, same as
+    /// preconditionVertexStars()).
+    /// \return Returns 0 upon success, negative values otherwise.
+    /// \sa preconditionVertexStars()
+    virtual inline int preconditionVertexStars(const size_t memoryBudget) {
+
+      if(memoryBudget == 0) {
+        return preconditionVertexStars();
+      }
+      if(!hasPreconditionedVertexStars_ || hasBoundedVertexStars_) {
+        preconditionBoundedVertexStarsInternal(memoryBudget);
+        hasPreconditionedVertexStars_ = true;
+        hasBoundedVertexStars_ = true;
       }
       return 0;
     }
@@ -3147,10 +3239,20 @@ namespace ttk {
       return 0;
     }
 
+    virtual inline int preconditionBoundedVertexNeighborsInternal(
+      const size_t /*memoryBudget*/) {
+      return preconditionVertexNeighborsInternal();
+    }
+
     virtual inline int preconditionVertexStarsInternal() {
       return 0;
     }
 
+    virtual inline int preconditionBoundedVertexStarsInternal(
+      const size_t /*memoryBudget*/) {
+      return preconditionVertexStarsInternal();
+    }
+
     virtual inline int preconditionVertexTrianglesInternal() {
       return 0;
     }
@@ -3189,6 +3291,8 @@ namespace ttk {
       hasPreconditionedTriangleStars_, hasPreconditionedVertexEdges_,
       hasPreconditionedVertexLinks_, hasPreconditionedVertexNeighbors_,
       hasPreconditionedVertexStars_, hasPreconditionedVertexTriangles_;
+    // vertex neighbors and stars preconditioned within a memory budget
+    bool hasBoundedVertexNeighbors_{}, hasBoundedVertexStars_{};
 
     std::array<int, 3> gridDimensions_;
 
@@ -0,0 +1,100 @@
+/// \ingroup base
+/// \class ttk::ImplicitGridStencil
+/// \date October 2021.
+///
+/// \brief Compile-time stencils of the implicit triangulations of 2D and 3D
+/// grids.
+///
+/// For a grid dimension, gives the grid offsets of the neighbors of a
+/// vertex and the voxel corners of the cells of a voxel, in the local
+/// orderings of ImplicitTriangulation::getVertexNeighbor() and
+/// ImplicitTriangulation::getCellVertex().
+///
+/// \sa ttk::ImplicitTriangulationDim
+/// \sa ttk::PeriodicImplicitTriangulationDim
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace ttk {
+
+  template <size_t dim>
+  struct ImplicitGridStencil;
+
+  template <>
+  struct ImplicitGridStencil<2> {
+    /// number of neighbors of a vertex (inside the grid)
+    static constexpr int vertexNeighborNumber = 6;
+    /// number of triangles in a square
+    static constexpr int cellsPerVoxel = 2;
+
+    /// (x, y) offsets of the neighbors of a vertex
+    static inline const std::array<std::array<int, 2>, 6> &vertexNeighbors() {
+      static constexpr std::array<std::array<int, 2>, 6> offsets{{
+        {{-1, 0}},
+        {{0, -1}},
+        {{1, -1}},
+        {{1, 0}},
+        {{0, 1}},
+        {{-1, 1}},
+      }};
+      return offsets;
+    }
+
+    /// corners (x + 2y) of the vertices of the two triangles of a square
+    static inline const std::array<std::array<int, 3>, 2> &cellVertices() {
+      static constexpr std::array<std::array<int, 3>, 2> corners{{
+        {{0, 1, 2}}, // top
+        {{1, 3, 2}}, // bottom
+      }};
+      return corners;
+    }
+  };
+
+  template <>
+  struct ImplicitGridStencil<3> {
+    /// number of neighbors of a vertex (inside the grid)
+    static constexpr int vertexNeighborNumber = 14;
+    /// number of tetrahedra in a voxel
+    static constexpr int cellsPerVoxel = 6;
+
+    /// (x, y, z) offsets of the neighbors of a vertex
+    static inline const std::array<std::array<int, 3>, 14> &
+      vertexNeighbors() {
+      static constexpr std::array<std::array<int, 3>, 14> offsets{{
+        {{0, -1, -1}},
+        {{1, -1, -1}},
+        {{0, 0, -1}},
+        {{1, 0, -1}},
+        {{0, -1, 0}},
+        {{1, -1, 0}},
+        {{1, 0, 0}},
+        {{-1, 0, 1}},
+        {{0, 0, 1}},
+        {{-1, 0, 0}},
+        {{-1, 1, 0}},
+        {{0, 1, 0}},
+        {{-1, 1, 1}},
+        {{0, 1, 1}},
+      }};
+      return offsets;
+    }
+
+    /// corners (x + 2y + 4z) of the vertices of the six tetrahedra of a
+    /// voxel
+    static inline const std::array<std::array<int, 4>, 6> &cellVertices() {
+      static constexpr std::array<std::array<int, 4>, 6> corners{{
+        {{0, 1, 2, 6}}, // abcg
+        {{1, 2, 3, 6}}, // bcdg
+        {{0, 1, 4, 6}}, // abeg
+        {{1, 4, 5, 6}}, // befg
+        {{1, 5, 6, 7}}, // bfgh
+        {{1, 3, 6, 7}}, // bdgh
+      }};
+      return corners;
+    }
+  };
+
+} // namespace ttk
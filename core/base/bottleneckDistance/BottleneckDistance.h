@@ -25,9 +25,10 @@
 // base code includes
 #include <AssignmentMunkres.h>
 #include <GabowTarjan.h>
+#include <PersistenceDiagramColumns.h>
 #include <Triangulation.h>
 
-#include <functional>
+#include <array>
 #include <string>
 #include <tuple>
 
@@ -46,9 +47,18 @@ namespace ttk {
 
     ~BottleneckDistance(){};
 
+    /// Legacy entry point: diagrams given as tuple vectors with
+    /// setCTDiagram1() and setCTDiagram2(), converted once to columns.
     template <typename dataType>
     int execute(bool usePersistenceMetric);
 
+    /// Matching between two columnar diagrams.
+    template <typename dataType>
+    int execute(const PersistenceDiagramColumns<dataType> &diagram1,
+                const PersistenceDiagramColumns<dataType> &diagram2,
+                std::vector<matchingTuple> &matchings,
+                bool usePersistenceMetric);
+
     inline int setPersistencePercentThreshold(double t) {
       zeroThreshold_ = t;
       return 0;
@@ -105,6 +115,13 @@ namespace ttk {
       return 0;
     }
 
+    /// Relative error allowed on the bottleneck distance (0 for the
+    /// exact distance).
+    inline int setBottleneckEpsilon(const double epsilon) {
+      bottleneckEpsilon_ = epsilon;
+      return 0;
+    }
+
     inline void message(const char *s) {
       std::stringstream msg;
       msg << s;
@@ -125,6 +142,17 @@ namespace ttk {
       return (var1 > var2) ? var1 - var2 : var2 - var1;
     }
 
+    /// Positive integer power, with a compile-time exponent if @p W > 0
+    /// (same rounding as Geometry::powInt).
+    template <int W, typename type>
+    static type powW(const type var, const int n) {
+      type res = var;
+      for(int i = 1; i < (W > 0 ? W : n); ++i) {
+        res *= var;
+      }
+      return res;
+    }
+
   protected:
     void *outputCT1_;
     void *outputCT2_;
@@ -140,31 +168,28 @@ namespace ttk {
     double pz_;
     double pe_;
     double ps_;
+    double bottleneckEpsilon_{0.0};
 
   private:
     template <typename dataType>
-    int computeBottleneck(const std::vector<diagramTuple> &d1,
-                          const std::vector<diagramTuple> &d2,
+    int computeBottleneck(const PersistenceDiagramColumns<dataType> &d1,
+                          const PersistenceDiagramColumns<dataType> &d2,
                           std::vector<matchingTuple> &matchings,
                           bool usePersistenceMetric);
 
     template <typename dataType>
-    double computeGeometricalRange(const std::vector<diagramTuple> &CTDiagram1,
-                                   const std::vector<diagramTuple> &CTDiagram2,
-                                   int d1Size,
-                                   int d2Size) const;
+    double computeGeometricalRange(
+      const PersistenceDiagramColumns<dataType> &CTDiagram1,
+      const PersistenceDiagramColumns<dataType> &CTDiagram2) const;
 
     template <typename dataType>
     double computeMinimumRelevantPersistence(
-      const std::vector<diagramTuple> &CTDiagram1,
-      const std::vector<diagramTuple> &CTDiagram2,
-      int d1Size,
-      int d2Size) const;
+      const PersistenceDiagramColumns<dataType> &CTDiagram1,
+      const PersistenceDiagramColumns<dataType> &CTDiagram2) const;
 
     template <typename dataType>
     void computeMinMaxSaddleNumberAndMapping(
-      const std::vector<diagramTuple> &CTDiagram,
-      int dSize,
+      const PersistenceDiagramColumns<dataType> &CTDiagram,
       int &nbMin,
       int &nbMax,
       int &nbSaddle,
@@ -173,15 +198,38 @@ namespace ttk {
       std::vector<int> &sadMap,
       dataType zeroThresh);
 
+    /// Distance between the i-th pair of @p a and the j-th pair of @p b,
+    /// used to weight the final matchings (the cost matrices are built
+    /// with the equivalent vectorized computeCostRow kernel).
+    template <typename dataType>
+    dataType computePairDistance(const PersistenceDiagramColumns<dataType> &a,
+                                 int i,
+                                 const PersistenceDiagramColumns<dataType> &b,
+                                 int j,
+                                 int wasserstein) const;
+
+    /// Distances of the pairs of a diagram to the diagonal.
+    template <typename dataType>
+    void computeDiagonalDistances(
+      const PersistenceDiagramColumns<dataType> &diagram,
+      int wasserstein,
+      std::vector<dataType> &distances) const;
+
+    /// Distances between the i-th pair of @p rows and every pair of
+    /// @p cols (vectorized over @p cols). The pairs of @p cols must be of
+    /// the same class (minimum, maximum or saddle) as the row pair. @p W
+    /// is the Wasserstein exponent if known at compile time, 0 otherwise.
+    template <int W, typename dataType>
+    void computeCostRow(const PersistenceDiagramColumns<dataType> &rows,
+                        int i,
+                        const PersistenceDiagramColumns<dataType> &cols,
+                        int wasserstein,
+                        double *costs) const;
+
     template <typename dataType>
     void buildCostMatrices(
-      const std::vector<diagramTuple> &CTDiagram1,
-      const std::vector<diagramTuple> &CTDiagram2,
-      int d1Size,
-      int d2Size,
-      std::function<dataType(const diagramTuple, const diagramTuple)>
-        &distanceFunction,
-      std::function<dataType(const diagramTuple)> &diagonalDistanceFunction,
+      const PersistenceDiagramColumns<dataType> &diagram1,
+      const PersistenceDiagramColumns<dataType> &diagram2,
       double zeroThresh,
       std::vector<std::vector<dataType>> &minMatrix,
       std::vector<std::vector<dataType>> &maxMatrix,
@@ -207,6 +255,16 @@ namespace ttk {
                                   std::vector<matchingTuple> &matchings,
                                   GabowTarjan &solver);
 
+    // Bottleneck matching without cost matrix, between the pairs
+    // map1 of CTDiagram1 and the pairs map2 of CTDiagram2.
+    template <typename dataType>
+    void solveGeometricBottleneck(
+      const PersistenceDiagramColumns<dataType> &diagram1,
+      const PersistenceDiagramColumns<dataType> &diagram2,
+      const std::vector<int> &map1,
+      const std::vector<int> &map2,
+      std::vector<matchingTuple> &matchings);
+
     template <typename dataType>
     dataType buildMappings(const std::vector<matchingTuple> &inputMatchings,
                            bool transposeGlobal,
@@ -6,6 +6,22 @@ constexpr unsigned long long str2int(const char *str, int h = 0) {
 
 template <typename dataType>
 int BottleneckDistance::execute(const bool usePersistenceMetric) {
+  PersistenceDiagramColumns<dataType> diagram1{}, diagram2{};
+  diagram1.fromTuples(
+    *static_cast<const std::vector<diagramTuple> *>(outputCT1_));
+  diagram2.fromTuples(
+    *static_cast<const std::vector<diagramTuple> *>(outputCT2_));
+  return this->execute(diagram1, diagram2,
+                       *static_cast<std::vector<matchingTuple> *>(matchings_),
+                       usePersistenceMetric);
+}
+
+template <typename dataType>
+int BottleneckDistance::execute(
+  const PersistenceDiagramColumns<dataType> &diagram1,
+  const PersistenceDiagramColumns<dataType> &diagram2,
+  std::vector<matchingTuple> &matchings,
+  const bool usePersistenceMetric) {
   Timer t;
 
   bool fromParaView = pvAlgorithm_ >= 0;
@@ -13,11 +29,8 @@ int BottleneckDistance::execute(const bool usePersistenceMetric) {
     switch(pvAlgorithm_) {
       case 0:
         this->printMsg("Solving with the TTK approach");
-        this->computeBottleneck<dataType>(
-          *static_cast<const std::vector<diagramTuple> *>(outputCT1_),
-          *static_cast<const std::vector<diagramTuple> *>(outputCT2_),
-          *static_cast<std::vector<matchingTuple> *>(matchings_),
-          usePersistenceMetric);
+        this->computeBottleneck(
+          diagram1, diagram2, matchings, usePersistenceMetric);
         break;
       case 1: {
         std::stringstream msg;
@@ -47,11 +60,8 @@ int BottleneckDistance::execute(const bool usePersistenceMetric) {
       case str2int("0"):
       case str2int("ttk"):
         this->printMsg("Solving with the TTK approach");
-        this->computeBottleneck<dataType>(
-          *static_cast<const std::vector<diagramTuple> *>(outputCT1_),
-          *static_cast<const std::vector<diagramTuple> *>(outputCT2_),
-          *static_cast<std::vector<matchingTuple> *>(matchings_),
-          usePersistenceMetric);
+        this->computeBottleneck(
+          diagram1, diagram2, matchings, usePersistenceMetric);
         break;
       case str2int("1"):
       case str2int("legacy"): {
@@ -86,10 +96,8 @@ int BottleneckDistance::execute(const bool usePersistenceMetric) {
 
 template <typename dataType>
 double BottleneckDistance::computeGeometricalRange(
-  const std::vector<diagramTuple> &CTDiagram1,
-  const std::vector<diagramTuple> &CTDiagram2,
-  const int d1Size,
-  const int d2Size) const {
+  const PersistenceDiagramColumns<dataType> &CTDiagram1,
+  const PersistenceDiagramColumns<dataType> &CTDiagram2) const {
   float minX1, maxX1, minY1, maxY1, minZ1, maxZ1;
   float minX2, maxX2, minY2, maxY2, minZ2, maxZ2;
   float minX, minY, minZ, maxX, maxY, maxZ;
@@ -98,29 +106,20 @@ double BottleneckDistance::computeGeometricalRange(
   maxX1 = maxY1 = maxZ1 = maxX2 = maxY2 = maxZ2
     = std::numeric_limits<float>::min();
 
-  for(int i = 0; i < d1Size; ++i) {
-    const diagramTuple &t = CTDiagram1[i];
-    float xa = std::get<7>(t), ya = std::get<8>(t), za = std::get<9>(t);
-    float xb = std::get<11>(t), yb = std::get<12>(t), zb = std::get<13>(t);
-    minX1 = std::min(std::min(minX1, xa), xb);
-    minY1 = std::min(std::min(minY1, ya), yb);
-    minZ1 = std::min(std::min(minZ1, za), zb);
-    maxX1 = std::max(std::max(maxX1, xa), xb);
-    maxY1 = std::max(std::max(maxY1, ya), yb);
-    maxZ1 = std::max(std::max(maxZ1, za), zb);
-  }
-
-  for(int i = 0; i < d2Size; ++i) {
-    const diagramTuple &t = CTDiagram2[i];
-    float xa = std::get<7>(t), ya = std::get<8>(t), za = std::get<9>(t);
-    float xb = std::get<11>(t), yb = std::get<12>(t), zb = std::get<13>(t);
-    minX2 = std::min(std::min(minX2, xa), xb);
-    minY2 = std::min(std::min(minY2, ya), yb);
-    minZ2 = std::min(std::min(minZ2, za), zb);
-    maxX2 = std::max(std::max(maxX2, xa), xb);
-    maxY2 = std::max(std::max(maxY2, ya), yb);
-    maxZ2 = std::max(std::max(maxZ2, za), zb);
-  }
+  const auto bounds = [](const PersistenceDiagramColumns<dataType> &diagram,
+                         float &xMin, float &yMin, float &zMin, float &xMax,
+                         float &yMax, float &zMax) {
+    for(size_t i = 0; i < diagram.size(); ++i) {
+      xMin = std::min(std::min(xMin, diagram.birthX[i]), diagram.deathX[i]);
+      yMin = std::min(std::min(yMin, diagram.birthY[i]), diagram.deathY[i]);
+      zMin = std::min(std::min(zMin, diagram.birthZ[i]), diagram.deathZ[i]);
+      xMax = std::max(std::max(xMax, diagram.birthX[i]), diagram.deathX[i]);
+      yMax = std::max(std::max(yMax, diagram.birthY[i]), diagram.deathY[i]);
+      zMax = std::max(std::max(zMax, diagram.birthZ[i]), diagram.deathZ[i]);
+    }
+  };
+  bounds(CTDiagram1, minX1, minY1, minZ1, maxX1, maxY1, maxZ1);
+  bounds(CTDiagram2, minX2, minY2, minZ2, maxX2, maxY2, maxZ2);
 
   minX = std::min(minX1, minX2);
   maxX = std::max(maxX1, maxX2);
@@ -135,23 +134,21 @@ double BottleneckDistance::computeGeometricalRange(
 
 template <typename dataType>
 double BottleneckDistance::computeMinimumRelevantPersistence(
-  const std::vector<diagramTuple> &CTDiagram1,
-  const std::vector<diagramTuple> &CTDiagram2,
-  const int d1Size,
-  const int d2Size) const {
+  const PersistenceDiagramColumns<dataType> &CTDiagram1,
+  const PersistenceDiagramColumns<dataType> &CTDiagram2) const {
   double sp = zeroThreshold_;
   double s = sp > 0.0 && sp < 100.0 ? sp / 100.0 : 0;
 
-  std::vector<dataType> toSort;
-  for(int i = 0; i < d1Size; ++i) {
-    const diagramTuple &t = CTDiagram1[i];
-    dataType persistence = abs<dataType>(std::get<4>(t));
-    toSort.push_back(persistence);
+  std::vector<dataType> toSort(CTDiagram1.size() + CTDiagram2.size());
+  const dataType *const pers1 = CTDiagram1.persistence.data();
+  const dataType *const pers2 = CTDiagram2.persistence.data();
+  dataType *const abs1 = toSort.data();
+  dataType *const abs2 = toSort.data() + CTDiagram1.size();
+  for(size_t i = 0; i < CTDiagram1.size(); ++i) {
+    abs1[i] = abs<dataType>(pers1[i]);
   }
-  for(int i = 0; i < d2Size; ++i) {
-    const diagramTuple &t = CTDiagram2[i];
-    dataType persistence = abs<dataType>(std::get<4>(t));
-    toSort.push_back(persistence);
+  for(size_t i = 0; i < CTDiagram2.size(); ++i) {
+    abs2[i] = abs<dataType>(pers2[i]);
   }
   sort(toSort.begin(), toSort.end());
 
@@ -159,23 +156,12 @@ double BottleneckDistance::computeMinimumRelevantPersistence(
   double maxVal = toSort.at(toSort.size() - 1);
   s *= (maxVal - minVal);
 
-  // double epsilon = 0.0000001;
-  // int largeSize = 2000;
-  // dataType zeroThresh = (dataType) epsilon;
-  // if (d1Size + d2Size > largeSize + 1) {
-  //   zeroThresh = toSort.at(d1Size + d2Size - largeSize);
-  //   if (toSort.at(d1Size + d2Size - (largeSize+1)) == zeroThresh)
-  //     zeroThresh += (dataType) epsilon;
-  // }
-  // if (zeroThresh < epsilon) zeroThresh = epsilon;
-
   return s;
 }
 
 template <typename dataType>
 void BottleneckDistance::computeMinMaxSaddleNumberAndMapping(
-  const std::vector<diagramTuple> &CTDiagram,
-  int dSize,
+  const PersistenceDiagramColumns<dataType> &CTDiagram,
   int &nbMin,
   int &nbMax,
   int &nbSaddle,
@@ -183,44 +169,203 @@ void BottleneckDistance::computeMinMaxSaddleNumberAndMapping(
   std::vector<int> &maxMap,
   std::vector<int> &sadMap,
   const dataType zeroThresh) {
-  for(int i = 0; i < dSize; ++i) {
-    const diagramTuple &t = CTDiagram[i];
-    BNodeType nt1 = std::get<1>(t);
-    BNodeType nt2 = std::get<3>(t);
-    dataType dt = std::get<4>(t);
-    if(abs<dataType>(dt) < zeroThresh)
+  using Columns = PersistenceDiagramColumns<dataType>;
+
+  std::vector<unsigned char> classes{};
+  CTDiagram.getPairClasses(classes);
+
+  for(size_t i = 0; i < CTDiagram.size(); ++i) {
+    if(abs<dataType>(CTDiagram.persistence[i]) < zeroThresh)
       continue;
 
-    if(nt1 == BLocalMin && nt2 == BLocalMax) {
+    if(classes[i] & Columns::MAX_PAIR) {
       nbMax++;
       maxMap.push_back(i);
-    } else {
-      if(nt1 == BLocalMax || nt2 == BLocalMax) {
-        nbMax++;
-        maxMap.push_back(i);
-      }
-      if(nt1 == BLocalMin || nt2 == BLocalMin) {
-        nbMin++;
-        minMap.push_back(i);
-      }
-      if((nt1 == BSaddle1 && nt2 == BSaddle2)
-         || (nt1 == BSaddle2 && nt2 == BSaddle1)) {
-        nbSaddle++;
-        sadMap.push_back(i);
-      }
+    }
+    if(classes[i] & Columns::MIN_PAIR) {
+      nbMin++;
+      minMap.push_back(i);
+    }
+    if(classes[i] & Columns::SADDLE_PAIR) {
+      nbSaddle++;
+      sadMap.push_back(i);
+    }
+  }
+}
+
+template <typename dataType>
+dataType BottleneckDistance::computePairDistance(
+  const PersistenceDiagramColumns<dataType> &a,
+  const int i,
+  const PersistenceDiagramColumns<dataType> &b,
+  const int j,
+  const int wasserstein) const {
+
+  const int w = wasserstein > 1 ? wasserstein : 1; // L_inf not managed.
+
+  // We don't match critical points of different index.
+  // This must be ensured before calling the distance function.
+  const bool isMin1 = a.birthType[i] == BLocalMin;
+  const bool isMax1 = a.deathType[i] == BLocalMax;
+
+  const dataType x
+    = ((isMin1 && !isMax1) ? pe_ : ps_)
+      * Geometry::pow(abs_diff<dataType>(a.birth[i], b.birth[j]), w);
+  const dataType y
+    = (isMax1 ? pe_ : ps_)
+      * Geometry::pow(abs_diff<dataType>(a.death[i], b.death[j]), w);
+  const double geoDistance
+    = isMax1
+        ? (px_ * Geometry::pow(abs<float>(a.deathX[i] - b.deathX[j]), w)
+           + py_ * Geometry::pow(abs<float>(a.deathY[i] - b.deathY[j]), w)
+           + pz_ * Geometry::pow(abs<float>(a.deathZ[i] - b.deathZ[j]), w))
+      : isMin1
+        ? (px_ * Geometry::pow(abs<float>(a.birthX[i] - b.birthX[j]), w)
+           + py_ * Geometry::pow(abs<float>(a.birthY[i] - b.birthY[j]), w)
+           + pz_ * Geometry::pow(abs<float>(a.birthZ[i] - b.birthZ[j]), w))
+        : (px_
+             * Geometry::pow(abs<float>(a.birthX[i] + a.deathX[i]) / 2
+                               - abs<float>(b.birthX[j] + b.deathX[j]) / 2,
+                             w)
+           + py_
+               * Geometry::pow(abs<float>(a.birthY[i] + a.deathY[i]) / 2
+                                 - abs<float>(b.birthY[j] + b.deathY[j]) / 2,
+                               w)
+           + pz_
+               * Geometry::pow(abs<float>(a.birthZ[i] + a.deathZ[i]) / 2
+                                 - abs<float>(b.birthZ[j] + b.deathZ[j]) / 2,
+                               w));
+
+  const double persDistance = x + y;
+  const double val = persDistance + geoDistance;
+  return Geometry::pow(val, 1.0 / w);
+}
+
+template <typename dataType>
+void BottleneckDistance::computeDiagonalDistances(
+  const PersistenceDiagramColumns<dataType> &diagram,
+  const int wasserstein,
+  std::vector<dataType> &distances) const {
+
+  const int w = wasserstein > 1 ? wasserstein : 1;
+  const int n = diagram.size();
+  const double px = px_, py = py_, pz = pz_, pe = pe_, ps = ps_;
+
+  std::vector<double> values(n);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd
+#endif // TTK_ENABLE_OPENMP
+  for(int i = 0; i < n; ++i) {
+    const bool isMin1 = diagram.birthType[i] == BLocalMin;
+    const bool isMax1 = diagram.deathType[i] == BLocalMax;
+    const double infDistance
+      = (isMin1 || isMax1 ? pe : ps)
+        * Geometry::pow(
+          abs_diff<dataType>(diagram.birth[i], diagram.death[i]), w);
+    const double x1 = diagram.birthX[i], x2 = diagram.deathX[i];
+    const double y1 = diagram.birthY[i], y2 = diagram.deathY[i];
+    const double z1 = diagram.birthZ[i], z2 = diagram.deathZ[i];
+    const double geoDistance = px * Geometry::pow(abs<double>(x2 - x1), w)
+                               + py * Geometry::pow(abs<double>(y2 - y1), w)
+                               + pz * Geometry::pow(abs<double>(z2 - z1), w);
+    values[i] = infDistance + geoDistance;
+  }
+
+  distances.resize(n);
+  for(int i = 0; i < n; ++i) {
+    distances[i] = w == 1 ? values[i] : Geometry::pow(values[i], 1.0 / w);
+  }
+}
+
+template <int W, typename dataType>
+void BottleneckDistance::computeCostRow(
+  const PersistenceDiagramColumns<dataType> &rows,
+  const int i,
+  const PersistenceDiagramColumns<dataType> &cols,
+  const int wasserstein,
+  double *const costs) const {
+
+  const int w = wasserstein > 1 ? wasserstein : 1; // L_inf not managed.
+  const int n = cols.size();
+
+  // We don't match critical points of different index: the columns have
+  // already been restricted to the class of the row pair.
+  const bool isMin1 = rows.birthType[i] == BLocalMin;
+  const bool isMax1 = rows.deathType[i] == BLocalMax;
+
+  const double px = px_, py = py_, pz = pz_;
+  const double wx = (isMin1 && !isMax1) ? pe_ : ps_;
+  const double wy = isMax1 ? pe_ : ps_;
+  const dataType rX = rows.birth[i];
+  const dataType rY = rows.death[i];
+  const dataType *const cX = cols.birth.data();
+  const dataType *const cY = cols.death.data();
+
+  if(isMax1 || isMin1) {
+    // geometrical distance between the death (resp. birth) extrema
+    const float ax = isMax1 ? rows.deathX[i] : rows.birthX[i];
+    const float ay = isMax1 ? rows.deathY[i] : rows.birthY[i];
+    const float az = isMax1 ? rows.deathZ[i] : rows.birthZ[i];
+    const float *const bx = isMax1 ? cols.deathX.data() : cols.birthX.data();
+    const float *const by = isMax1 ? cols.deathY.data() : cols.birthY.data();
+    const float *const bz = isMax1 ? cols.deathZ.data() : cols.birthZ.data();
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd
+#endif // TTK_ENABLE_OPENMP
+    for(int k = 0; k < n; ++k) {
+      const dataType x
+        = wx * powW<W>(abs_diff<dataType>(rX, cX[k]), w);
+      const dataType y
+        = wy * powW<W>(abs_diff<dataType>(rY, cY[k]), w);
+      const double geoDistance
+        = px * powW<W>(abs<float>(ax - bx[k]), w)
+          + py * powW<W>(abs<float>(ay - by[k]), w)
+          + pz * powW<W>(abs<float>(az - bz[k]), w);
+      const double persDistance = x + y;
+      costs[k] = persDistance + geoDistance;
+    }
+  } else {
+    // geometrical distance between the pair midpoints
+    const float ax = abs<float>(rows.birthX[i] + rows.deathX[i]) / 2;
+    const float ay = abs<float>(rows.birthY[i] + rows.deathY[i]) / 2;
+    const float az = abs<float>(rows.birthZ[i] + rows.deathZ[i]) / 2;
+    const float *const bx1 = cols.birthX.data();
+    const float *const by1 = cols.birthY.data();
+    const float *const bz1 = cols.birthZ.data();
+    const float *const bx2 = cols.deathX.data();
+    const float *const by2 = cols.deathY.data();
+    const float *const bz2 = cols.deathZ.data();
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd
+#endif // TTK_ENABLE_OPENMP
+    for(int k = 0; k < n; ++k) {
+      const dataType x
+        = wx * powW<W>(abs_diff<dataType>(rX, cX[k]), w);
+      const dataType y
+        = wy * powW<W>(abs_diff<dataType>(rY, cY[k]), w);
+      const double geoDistance
+        = px * powW<W>(ax - abs<float>(bx1[k] + bx2[k]) / 2, w)
+          + py * powW<W>(ay - abs<float>(by1[k] + by2[k]) / 2, w)
+          + pz * powW<W>(az - abs<float>(bz1[k] + bz2[k]) / 2, w);
+      const double persDistance = x + y;
+      costs[k] = persDistance + geoDistance;
+    }
+  }
+
+  if(w > 1) {
+    for(int k = 0; k < n; ++k) {
+      costs[k] = Geometry::pow(costs[k], 1.0 / w);
     }
   }
 }
 
 template <typename dataType>
 void BottleneckDistance::buildCostMatrices(
-  const std::vector<diagramTuple> &CTDiagram1,
-  const std::vector<diagramTuple> &CTDiagram2,
-  const int d1Size,
-  const int d2Size,
-  std::function<dataType(const diagramTuple, const diagramTuple)>
-    &distanceFunction,
-  std::function<dataType(const diagramTuple)> &diagonalDistanceFunction,
+  const PersistenceDiagramColumns<dataType> &diagram1,
+  const PersistenceDiagramColumns<dataType> &diagram2,
   const double zeroThresh,
   std::vector<std::vector<dataType>> &minMatrix,
   std::vector<std::vector<dataType>> &maxMatrix,
@@ -229,162 +374,166 @@ void BottleneckDistance::buildCostMatrices(
   const bool reverseMax,
   const bool reverseSad,
   const int wasserstein) {
-  int maxI = 0, minI = 0;
-  int maxJ = 0, minJ = 0;
-  int sadI = 0, sadJ = 0;
 
-  for(int i = 0; i < d1Size; ++i) {
-    const diagramTuple &t1 = CTDiagram1[i];
-    if(abs<dataType>(std::get<4>(t1)) < zeroThresh)
+  // pair classes (a minimum-maximum pair is a maximum pair; the last
+  // class gathers the degenerate pairs that are both minimum and maximum
+  // pairs)
+  enum { NONE = -1, MIN = 0, MAX = 1, SAD = 2, MINMAX = 3 };
+
+  const int w = wasserstein > 1 ? wasserstein : 1; // L_inf not managed.
+
+  const auto pairClass = [](const BNodeType t1, const BNodeType t2) {
+    bool isMin = (t1 == BLocalMin || t2 == BLocalMin);
+    bool isMax = (t1 == BLocalMax || t2 == BLocalMax);
+    const bool isSad = (t1 == BSaddle1 && t2 == BSaddle2)
+                       || (t1 == BSaddle2 && t2 == BSaddle1);
+    if(t1 == BLocalMin && t2 == BLocalMax) {
+      isMin = false;
+      isMax = true;
+    }
+    if(isMin && isMax) {
+      return static_cast<int>(MINMAX);
+    }
+    return isMin   ? static_cast<int>(MIN)
+           : isMax ? static_cast<int>(MAX)
+           : isSad ? static_cast<int>(SAD)
+                   : static_cast<int>(NONE);
+  };
+
+  const int d1Size = diagram1.size();
+  const int d2Size = diagram2.size();
+
+  std::vector<dataType> diagonal1{}, diagonal2{};
+  this->computeDiagonalDistances(diagram1, wasserstein, diagonal1);
+  this->computeDiagonalDistances(diagram2, wasserstein, diagonal2);
+
+  // columns of every class: a MINMAX column matches the MIN, MAX and
+  // MINMAX rows
+  std::array<std::vector<int>, 4> colIds{};
+  std::vector<int> colClass(d2Size, NONE);
+  for(int j = 0; j < d2Size; ++j) {
+    if(abs<dataType>(diagram2.persistence[j]) < zeroThresh)
       continue;
+    colClass[j] = pairClass(diagram2.birthType[j], diagram2.deathType[j]);
+    if(colClass[j] == MIN || colClass[j] == MINMAX)
+      colIds[MIN].emplace_back(j);
+    if(colClass[j] == MAX || colClass[j] == MINMAX)
+      colIds[MAX].emplace_back(j);
+    if(colClass[j] == SAD)
+      colIds[SAD].emplace_back(j);
+    if(colClass[j] == MINMAX)
+      colIds[MINMAX].emplace_back(j);
+  }
 
-    BNodeType t11 = std::get<1>(t1);
-    BNodeType t13 = std::get<3>(t1);
-    bool isMin1 = (t11 == BLocalMin || t13 == BLocalMin);
-    bool isMax1 = (t11 == BLocalMax || t13 == BLocalMax);
-    bool isSad1 = (t11 == BSaddle1 && t13 == BSaddle2)
-                  || (t11 == BSaddle2 && t13 == BSaddle1);
-    if(t11 == BLocalMin && t13 == BLocalMax) {
-      isMin1 = false;
-      isMax1 = true;
+  std::array<PersistenceDiagramColumns<dataType>, 4> cols{};
+  std::array<std::vector<dataType>, 4> colDiagonals{};
+  for(size_t c = 0; c < cols.size(); ++c) {
+    cols[c].gather(diagram2, colIds[c]);
+    colDiagonals[c].resize(colIds[c].size());
+    for(size_t k = 0; k < colIds[c].size(); ++k) {
+      colDiagonals[c][k] = diagonal2[colIds[c][k]];
     }
+  }
 
-    minJ = 0;
-    maxJ = 0;
-    sadJ = 0;
+  // row index of every pair of the first diagram in its cost matrices
+  std::vector<int> rowClass(d1Size, NONE);
+  std::vector<int> rowIndex(d1Size), maxRowIndex(d1Size);
+  int minI = 0, maxI = 0, sadI = 0;
+  for(int i = 0; i < d1Size; ++i) {
+    if(abs<dataType>(diagram1.persistence[i]) < zeroThresh)
+      continue;
+    rowClass[i] = pairClass(diagram1.birthType[i], diagram1.deathType[i]);
+    switch(rowClass[i]) {
+      case MIN:
+        rowIndex[i] = minI++;
+        break;
+      case MAX:
+        rowIndex[i] = maxI++;
+        break;
+      case SAD:
+        rowIndex[i] = sadI++;
+        break;
+      case MINMAX:
+        rowIndex[i] = minI++;
+        maxRowIndex[i] = maxI++;
+        break;
+    }
+  }
 
-    for(int j = 0; j < d2Size; ++j) {
-      const diagramTuple &t2 = CTDiagram2[j];
-      if(abs<dataType>(std::get<4>(t2)) < zeroThresh)
-        continue;
+  const auto setCost = [](std::vector<std::vector<dataType>> &matrix,
+                          const bool reverse, const int i, const int j,
+                          const dataType cost) {
+    if(reverse)
+      matrix[j][i] = cost;
+    else
+      matrix[i][j] = cost;
+  };
 
-      BNodeType t21 = std::get<1>(t2);
-      BNodeType t23 = std::get<3>(t2);
-      bool isMin2 = (t21 == BLocalMin || t23 == BLocalMin);
-      bool isMax2 = (t21 == BLocalMax || t23 == BLocalMax);
-      bool isSad2 = (t21 == BSaddle1 && t23 == BSaddle2)
-                    || (t21 == BSaddle2 && t23 == BSaddle1);
-      if(t21 == BLocalMin && t23 == BLocalMax) {
-        isMin2 = false;
-        isMax2 = true;
-      }
-      if((isMin1 && !isMin2) || (isMax1 && !isMax2) || (isSad1 && !isSad2))
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  {
+    std::vector<double> costs{};
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif // TTK_ENABLE_OPENMP
+    for(int i = 0; i < d1Size; ++i) {
+      const int c = rowClass[i];
+      if(c == NONE)
         continue;
 
-      dataType distance = distanceFunction(t1, t2);
-      dataType diag1 = diagonalDistanceFunction(t1);
-      dataType diag2 = diagonalDistanceFunction(t2);
-
-      if(distance > diag1 + diag2)
-        distance = std::numeric_limits<dataType>::max();
-
-      if(isMin1 && isMin2) {
-        if(reverseMin)
-          minMatrix[minJ++][minI] = distance;
-        else
-          minMatrix[minI][minJ++] = distance;
-      } else if(isMax1 && isMax2) {
-        if(reverseMax)
-          maxMatrix[maxJ++][maxI] = distance;
-        else
-          maxMatrix[maxI][maxJ++] = distance;
-      } else if(isSad1 && isSad2) {
-        if(reverseSad)
-          sadMatrix[sadJ++][sadI] = distance;
-        else
-          sadMatrix[sadI][sadJ++] = distance;
+      // MINMAX rows are stored in the minimum matrix
+      auto &matrix = c == SAD ? sadMatrix : c == MAX ? maxMatrix : minMatrix;
+      const bool reverse
+        = c == SAD ? reverseSad : c == MAX ? reverseMax : reverseMin;
+      const auto &colDiagonal = colDiagonals[c];
+      const int n = cols[c].size();
+      const dataType diag1 = diagonal1[i];
+
+      costs.resize(n);
+      // instantiate the kernel for the usual exponents so that the
+      // compiler can unroll the powers and vectorize the row
+      if(w == 1)
+        this->computeCostRow<1>(diagram1, i, cols[c], w, costs.data());
+      else if(w == 2)
+        this->computeCostRow<2>(diagram1, i, cols[c], w, costs.data());
+      else
+        this->computeCostRow<0>(diagram1, i, cols[c], w, costs.data());
+
+      for(int k = 0; k < n; ++k) {
+        dataType distance = costs[k];
+        if(distance > diag1 + colDiagonal[k])
+          distance = std::numeric_limits<dataType>::max();
+        setCost(matrix, reverse, rowIndex[i], k, distance);
       }
-    }
 
-    dataType distanceToDiagonal = diagonalDistanceFunction(t1);
-    if(isMin1) {
-      if(reverseMin)
-        minMatrix[minJ++][minI] = distanceToDiagonal;
-      else
-        minMatrix[minI][minJ++] = distanceToDiagonal;
-    }
-    if(isMax1) {
-      if(reverseMax)
-        maxMatrix[maxJ++][maxI] = distanceToDiagonal;
-      else
-        maxMatrix[maxI][maxJ++] = distanceToDiagonal;
+      // match with the diagonal
+      setCost(matrix, reverse, rowIndex[i], n, diag1);
+      if(c == MINMAX)
+        setCost(maxMatrix, reverseMax, maxRowIndex[i], 0, diag1);
     }
-    if(isSad1) {
-      if(reverseSad)
-        sadMatrix[sadJ++][sadI] = distanceToDiagonal;
-      else
-        sadMatrix[sadI][sadJ++] = distanceToDiagonal;
-    }
-
-    if(isMin1)
-      ++minI;
-    if(isMax1)
-      ++maxI;
-    if(isSad1)
-      ++sadI;
   }
 
-  minJ = 0;
-  maxJ = 0;
-  sadJ = 0;
-
   // Last row: match remaining J components with diagonal.
+  int maxJ = 0, minJ = 0, sadJ = 0;
   for(int j = 0; j < d2Size; ++j) {
-    const diagramTuple &t2 = CTDiagram2[j];
-    if(abs<dataType>(std::get<4>(t2)) < zeroThresh)
-      continue;
-
-    BNodeType t21 = std::get<1>(t2);
-    BNodeType t23 = std::get<3>(t2);
-    bool isMin2 = (t21 == BLocalMin || t23 == BLocalMin);
-    bool isMax2 = (t21 == BLocalMax || t23 == BLocalMax);
-    bool isSad2 = (t21 == BSaddle1 && t23 == BSaddle2)
-                  || (t21 == BSaddle2 && t23 == BSaddle1);
-    if(t21 == BLocalMin && t23 == BLocalMax) {
-      isMin2 = false;
-      isMax2 = true;
-    }
-
-    dataType distanceToDiagonal = diagonalDistanceFunction(t2);
-    if(isMin2) {
-      if(reverseMin)
-        minMatrix[minJ++][minI] = distanceToDiagonal;
-      else
-        minMatrix[minI][minJ++] = distanceToDiagonal;
-    }
-    if(isMax2) {
-      if(reverseMax)
-        maxMatrix[maxJ++][maxI] = distanceToDiagonal;
-      else
-        maxMatrix[maxI][maxJ++] = distanceToDiagonal;
-    }
-    if(isSad2) {
-      if(reverseSad)
-        sadMatrix[sadJ++][sadI] = distanceToDiagonal;
-      else
-        sadMatrix[sadI][sadJ++] = distanceToDiagonal;
-    }
+    const int c = colClass[j];
+    if(c == MIN || c == MINMAX)
+      setCost(minMatrix, reverseMin, minI, minJ++, diagonal2[j]);
+    if(c == MAX || c == MINMAX)
+      setCost(maxMatrix, reverseMax, maxI, maxJ++, diagonal2[j]);
+    if(c == SAD)
+      setCost(sadMatrix, reverseSad, sadI, sadJ++, diagonal2[j]);
   }
 
   // Last cell
-  {
-    if(reverseMin)
-      minMatrix[minJ][minI] = std::numeric_limits<dataType>::max();
-    else
-      minMatrix[minI][minJ] = std::numeric_limits<dataType>::max();
-  }
-  {
-    if(reverseMax)
-      maxMatrix[maxJ][maxI] = std::numeric_limits<dataType>::max();
-    else
-      maxMatrix[maxI][maxJ] = std::numeric_limits<dataType>::max();
-  }
-  {
-    if(reverseSad)
-      sadMatrix[sadJ][sadI] = std::numeric_limits<dataType>::max();
-    else
-      sadMatrix[sadI][sadJ] = std::numeric_limits<dataType>::max();
-  }
+  setCost(minMatrix, reverseMin, minI, minJ,
+          std::numeric_limits<dataType>::max());
+  setCost(maxMatrix, reverseMax, maxI, maxJ,
+          std::numeric_limits<dataType>::max());
+  setCost(sadMatrix, reverseSad, sadI, sadJ,
+          std::numeric_limits<dataType>::max());
 }
 
 template <typename dataType>
@@ -408,16 +557,63 @@ void BottleneckDistance::solveInfinityWasserstein(
   std::vector<std::vector<dataType>> &matrix,
   std::vector<matchingTuple> &matchings,
   GabowTarjan &solver) {
-  std::vector<std::vector<dataType>> bottleneckMatrix(
-    nbRow, std::vector<dataType>(nbCol));
-
-  // Copy input matrix.
-  for(int i = 0; i < nbRow; ++i)
-    for(int j = 0; j < nbCol; ++j)
-      bottleneckMatrix[i][j] = matrix[i][j];
 
   // Solve.
-  solver.setInput<dataType>(nbRow, nbCol, (void *)&bottleneckMatrix);
+  solver.setThreadNumber(threadNumber_);
+  solver.setDebugLevel(debugLevel_);
+  solver.setEpsilon(bottleneckEpsilon_);
+  solver.setInput<dataType>(nbRow, nbCol, (void *)&matrix);
+  solver.run<dataType>(matchings);
+  solver.clear<dataType>();
+}
+
+template <typename dataType>
+void BottleneckDistance::solveGeometricBottleneck(
+  const PersistenceDiagramColumns<dataType> &diagram1,
+  const PersistenceDiagramColumns<dataType> &diagram2,
+  const std::vector<int> &map1,
+  const std::vector<int> &map2,
+  std::vector<matchingTuple> &matchings) {
+
+  PersistenceDiagramColumns<dataType> pairs1{}, pairs2{};
+  pairs1.gather(diagram1, map1);
+  pairs2.gather(diagram2, map2);
+
+  std::vector<dataType> diagonal1{}, diagonal2{};
+  this->computeDiagonalDistances(pairs1, -1, diagonal1);
+  this->computeDiagonalDistances(pairs2, -1, diagonal2);
+
+  // the pair distance is larger than the L-infinity distance in the
+  // birth-death plane, scaled by the smallest persistence weight
+  const double scale = std::min(pe_, ps_);
+  const auto embed = [scale](const PersistenceDiagramColumns<dataType> &pairs,
+                             std::vector<std::array<double, 2>> &embedding) {
+    embedding.resize(pairs.size());
+    for(size_t i = 0; i < pairs.size(); ++i) {
+      embedding[i] = {scale * pairs.birth[i], scale * pairs.death[i]};
+    }
+  };
+  std::vector<std::array<double, 2>> embedding1{}, embedding2{};
+  embed(pairs1, embedding1);
+  embed(pairs2, embedding2);
+
+  // same cost as the matrix entries (see buildCostMatrices)
+  const auto cost = [&](const int i, const int j) -> double {
+    const dataType distance
+      = this->computePairDistance(diagram1, map1[i], diagram2, map2[j], -1);
+    if(distance > diagonal1[i] + diagonal2[j])
+      return std::numeric_limits<dataType>::max();
+    return distance;
+  };
+
+  GabowTarjan solver{};
+  solver.setThreadNumber(threadNumber_);
+  solver.setDebugLevel(debugLevel_);
+  solver.setEpsilon(bottleneckEpsilon_);
+  solver.setInput(
+    embedding1, embedding2,
+    std::vector<double>(diagonal1.begin(), diagonal1.end()),
+    std::vector<double>(diagonal2.begin(), diagonal2.end()), cost);
   solver.run<dataType>(matchings);
   solver.clear<dataType>();
 }
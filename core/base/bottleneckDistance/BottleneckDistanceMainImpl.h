@@ -1,26 +1,18 @@
 #pragma once
 
-//  vector <   -- diagram
-//    tuple <    -- pair of critical points
-//      int , NodeType
-//      int, NodeType
-//      dataType  -- persistance of pair
-//      int  -- type (0/min, 1/saddle, 2/max)
-//      dataType            -- scalar value at vertex 1
-//      float, float, float -- vertex 1 coordinates
-//      dataType            -- scalar value at vertex 2
-//      float, float, float -- vertex 2 coordinates
+// diagrams: one column per pair field (see PersistenceDiagramColumns)
 template <typename dataType>
-int BottleneckDistance::computeBottleneck(const std::vector<diagramTuple> &d1,
-                                          const std::vector<diagramTuple> &d2,
-                                          std::vector<matchingTuple> &matchings,
-                                          const bool usePersistenceMetric) {
+int BottleneckDistance::computeBottleneck(
+  const PersistenceDiagramColumns<dataType> &d1,
+  const PersistenceDiagramColumns<dataType> &d2,
+  std::vector<matchingTuple> &matchings,
+  const bool usePersistenceMetric) {
   auto d1Size = (int)d1.size();
   auto d2Size = (int)d2.size();
 
   bool transposeOriginal = d1Size > d2Size;
-  const std::vector<diagramTuple> &CTDiagram1 = transposeOriginal ? d2 : d1;
-  const std::vector<diagramTuple> &CTDiagram2 = transposeOriginal ? d1 : d2;
+  const auto &CTDiagram1 = transposeOriginal ? d2 : d1;
+  const auto &CTDiagram2 = transposeOriginal ? d1 : d2;
   if(transposeOriginal) {
     int temp = d1Size;
     d1Size = d2Size;
@@ -38,8 +30,8 @@ int BottleneckDistance::computeBottleneck(const std::vector<diagramTuple> &d1,
     return -4;
 
   // Needed to limit computation time.
-  const dataType zeroThresh = this->computeMinimumRelevantPersistence<dataType>(
-    CTDiagram1, CTDiagram2, d1Size, d2Size);
+  const dataType zeroThresh
+    = this->computeMinimumRelevantPersistence(CTDiagram1, CTDiagram2);
 
   // Initialize solvers.
   std::vector<matchingTuple> minMatchings;
@@ -62,12 +54,12 @@ int BottleneckDistance::computeBottleneck(const std::vector<diagramTuple> &d1,
   std::vector<int> sadMap1;
   std::vector<int> sadMap2;
 
-  this->computeMinMaxSaddleNumberAndMapping(CTDiagram1, d1Size, nbRowMin,
-                                            nbRowMax, nbRowSad, minMap1,
-                                            maxMap1, sadMap1, zeroThresh);
-  this->computeMinMaxSaddleNumberAndMapping(CTDiagram2, d2Size, nbColMin,
-                                            nbColMax, nbColSad, minMap2,
-                                            maxMap2, sadMap2, zeroThresh);
+  this->computeMinMaxSaddleNumberAndMapping(CTDiagram1, nbRowMin, nbRowMax,
+                                            nbRowSad, minMap1, maxMap1,
+                                            sadMap1, zeroThresh);
+  this->computeMinMaxSaddleNumberAndMapping(CTDiagram2, nbColMin, nbColMax,
+                                            nbColSad, minMap2, maxMap2,
+                                            sadMap2, zeroThresh);
 
   // Automatically transpose if nb rows > nb cols
   maxRowColMin = std::max(nbRowMin + 1, nbColMin + 1);
@@ -78,107 +70,39 @@ int BottleneckDistance::computeBottleneck(const std::vector<diagramTuple> &d1,
   minRowColMax = std::min(nbRowMax + 1, nbColMax + 1);
   minRowColSad = std::min(nbRowSad + 1, nbColSad + 1);
 
-  std::vector<std::vector<dataType>> minMatrix(
-    (unsigned long)minRowColMin, std::vector<dataType>(maxRowColMin));
-  std::vector<std::vector<dataType>> maxMatrix(
-    (unsigned long)minRowColMax, std::vector<dataType>(maxRowColMax));
-  std::vector<std::vector<dataType>> sadMatrix(
-    (unsigned long)minRowColSad, std::vector<dataType>(maxRowColSad));
-
-  double px = px_;
-  double py = py_;
-  double pz = pz_;
-  double pe = pe_;
-  double ps = ps_;
-
-  std::function<dataType(const diagramTuple, const diagramTuple)>
-    distanceFunction
-    = [wasserstein, px, py, pz, pe, ps](
-        const diagramTuple a, const diagramTuple b) -> dataType {
-    BNodeType ta1 = std::get<1>(a);
-    BNodeType ta2 = std::get<3>(a);
-    const int w = wasserstein > 1 ? wasserstein : 1; // L_inf not managed.
-
-    // We don't match critical points of different index.
-    // This must be ensured before calling the distance function.
-    // BNodeType tb1 = get<1>(b);
-    // BNodeType tb2 = get<3>(b);
-    bool isMin1 = ta1 == BLocalMin;
-    bool isMax1 = ta2 == BLocalMax;
-    // bool isBoth = isMin1 && isMax1;
-
-    dataType rX = std::get<6>(a);
-    dataType rY = std::get<10>(a);
-    dataType cX = std::get<6>(b);
-    dataType cY = std::get<10>(b);
-    dataType x = ((isMin1 && !isMax1) ? pe : ps)
-                 * Geometry::pow(abs_diff<dataType>(rX, cX), w);
-    dataType y
-      = (isMax1 ? pe : ps) * Geometry::pow(abs_diff<dataType>(rY, cY), w);
-    double geoDistance
-      = isMax1
-          ? (px * Geometry::pow(abs(std::get<11>(a) - std::get<11>(b)), w)
-             + py * Geometry::pow(abs(std::get<12>(a) - std::get<12>(b)), w)
-             + pz * Geometry::pow(abs(std::get<13>(a) - std::get<13>(b)), w))
-        : isMin1
-          ? (px * Geometry::pow(abs(std::get<7>(a) - std::get<7>(b)), w)
-             + py * Geometry::pow(abs(std::get<8>(a) - std::get<8>(b)), w)
-             + pz * Geometry::pow(abs(std::get<9>(a) - std::get<9>(b)), w))
-          : (px
-               * Geometry::pow(abs(std::get<7>(a) + std::get<11>(a)) / 2
-                                 - abs(std::get<7>(b) + std::get<11>(b)) / 2,
-                               w)
-             + py
-                 * Geometry::pow(abs(std::get<8>(a) + std::get<12>(a)) / 2
-                                   - abs(std::get<8>(b) + std::get<12>(b)) / 2,
-                                 w)
-             + pz
-                 * Geometry::pow(abs(std::get<9>(a) + std::get<13>(a)) / 2
-                                   - abs(std::get<9>(b) + std::get<13>(b)) / 2,
-                                 w));
-
-    double persDistance = x + y;
-    double val = persDistance + geoDistance;
-    val = Geometry::pow(val, 1.0 / w);
-    return val;
-  };
-
-  std::function<dataType(const diagramTuple)> diagonalDistanceFunction
-    = [wasserstein, px, py, pz, ps, pe](const diagramTuple a) -> dataType {
-    BNodeType ta1 = std::get<1>(a);
-    BNodeType ta2 = std::get<3>(a);
-    const int w = wasserstein > 1 ? wasserstein : 1;
-    bool isMin1 = ta1 == BLocalMin;
-    bool isMax1 = ta2 == BLocalMax;
-
-    dataType rX = std::get<6>(a);
-    dataType rY = std::get<10>(a);
-    double x1 = std::get<7>(a);
-    double y1 = std::get<8>(a);
-    double z1 = std::get<9>(a);
-    double x2 = std::get<11>(a);
-    double y2 = std::get<12>(a);
-    double z2 = std::get<13>(a);
-
-    double infDistance = (isMin1 || isMax1 ? pe : ps)
-                         * Geometry::pow(abs_diff<dataType>(rX, rY), w);
-    double geoDistance = (px * Geometry::pow(abs(x2 - x1), w)
-                          + py * Geometry::pow(abs(y2 - y1), w)
-                          + pz * Geometry::pow(abs(z2 - z1), w));
-    double val = infDistance + geoDistance;
-    return Geometry::pow(val, 1.0 / w);
-  };
-
-  const bool transposeMin = nbRowMin > nbColMin;
-  const bool transposeMax = nbRowMax > nbColMax;
-  const bool transposeSad = nbRowSad > nbColSad;
+  // The bottleneck matching does not need the cost matrices if the pair
+  // distance is bounded from below by the distance in the birth-death
+  // plane (non-negative geometrical terms, see GabowTarjan).
+  bool geometricBottleneck = wasserstein < 0 && pe_ > 0 && ps_ > 0;
+  if(geometricBottleneck && (px_ != 0 || py_ != 0 || pz_ != 0)) {
+    // the pair midpoint term of the distance can be negative
+    for(const auto diagram : {&CTDiagram1, &CTDiagram2}) {
+      for(size_t i = 0; i < diagram->size(); ++i) {
+        if(diagram->birthType[i] != BLocalMin
+           && diagram->deathType[i] != BLocalMax)
+          geometricBottleneck = false;
+      }
+    }
+  }
+
+  std::vector<std::vector<dataType>> minMatrix{}, maxMatrix{}, sadMatrix{};
+  if(!geometricBottleneck) {
+    minMatrix.resize(minRowColMin, std::vector<dataType>(maxRowColMin));
+    maxMatrix.resize(minRowColMax, std::vector<dataType>(maxRowColMax));
+    sadMatrix.resize(minRowColSad, std::vector<dataType>(maxRowColSad));
+  }
+
+  const bool transposeMin = !geometricBottleneck && nbRowMin > nbColMin;
+  const bool transposeMax = !geometricBottleneck && nbRowMax > nbColMax;
+  const bool transposeSad = !geometricBottleneck && nbRowSad > nbColSad;
 
   Timer t;
 
-  this->buildCostMatrices(
-    CTDiagram1, CTDiagram2, d1Size, d2Size, distanceFunction,
-    diagonalDistanceFunction, zeroThresh, minMatrix, maxMatrix, sadMatrix,
-    transposeMin, transposeMax, transposeSad, wasserstein);
+  if(!geometricBottleneck) {
+    this->buildCostMatrices(CTDiagram1, CTDiagram2, zeroThresh, minMatrix,
+                            maxMatrix, sadMatrix, transposeMin, transposeMax,
+                            transposeSad, wasserstein);
+  }
 
   if(wasserstein > 0) {
 
@@ -203,6 +127,26 @@ int BottleneckDistance::computeBottleneck(const std::vector<diagramTuple> &d1,
         minRowColSad, maxRowColSad, sadMatrix, sadMatchings, solverSad);
     }
 
+  } else if(geometricBottleneck) {
+
+    if(nbRowMin > 0 && nbColMin > 0) {
+      this->printMsg("Affecting minima...");
+      this->solveGeometricBottleneck(
+        CTDiagram1, CTDiagram2, minMap1, minMap2, minMatchings);
+    }
+
+    if(nbRowMax > 0 && nbColMax > 0) {
+      this->printMsg("Affecting maxima...");
+      this->solveGeometricBottleneck(
+        CTDiagram1, CTDiagram2, maxMap1, maxMap2, maxMatchings);
+    }
+
+    if(nbRowSad > 0 && nbColSad > 0) {
+      this->printMsg("Affecting saddles...");
+      this->solveGeometricBottleneck(
+        CTDiagram1, CTDiagram2, sadMap1, sadMap2, sadMatchings);
+    }
+
   } else {
 
     // Launch solving for minima.
@@ -269,11 +213,6 @@ int BottleneckDistance::computeBottleneck(const std::vector<diagramTuple> &d1,
     int j = transposeOriginal ? std::get<0>(mt) : std::get<1>(mt);
     // dataType val = std::get<2>(t);
 
-    diagramTuple t1 = CTDiagram1[i];
-    diagramTuple t2 = CTDiagram2[j];
-    // dataType rX = std::get<6>(t1); dataType rY = std::get<10>(t1);
-    // dataType cX = std::get<6>(t2); dataType cY = std::get<10>(t2);
-    // dataType x = rX - cX; dataType y = rY - cY;
     paired1[i] = true;
     paired2[j] = true;
     // dataType lInf = std::max(abs<dataType>(x), abs<dataType>(y));
@@ -282,13 +221,14 @@ int BottleneckDistance::computeBottleneck(const std::vector<diagramTuple> &d1,
     // wasserstein) != val)))
     //++numberOfMismatches;
 
-    dataType partialDistance = distanceFunction(t1, t2);
+    dataType partialDistance
+      = this->computePairDistance(CTDiagram1, i, CTDiagram2, j, wasserstein);
     // wasserstein > 0 ? pow(lInf, wasserstein) : std::max(d, lInf);
 
     if(wasserstein > 0)
       d += partialDistance;
     else
-      d = partialDistance;
+      d = std::max(d, partialDistance);
   }
 
   if(numberOfMismatches > 0) {
@@ -0,0 +1,243 @@
+#include <BottleneckDistance.h>
+
+void ttk::GabowTarjan::buildGrid(
+  const std::vector<std::array<double, 2>> &embedding, PairGrid &grid) const {
+
+  const int n = embedding.size();
+
+  std::array<double, 2> lo{std::numeric_limits<double>::max(),
+                           std::numeric_limits<double>::max()};
+  std::array<double, 2> hi{std::numeric_limits<double>::lowest(),
+                           std::numeric_limits<double>::lowest()};
+  for(const auto &p : embedding) {
+    for(int k = 0; k < 2; ++k) {
+      lo[k] = std::min(lo[k], p[k]);
+      hi[k] = std::max(hi[k], p[k]);
+    }
+  }
+  if(n == 0) {
+    lo = {0, 0};
+    hi = {0, 0};
+  }
+
+  // about one pair per cell
+  const double extent = std::max(hi[0] - lo[0], hi[1] - lo[1]);
+  const int resolution = std::max(1, (int)std::sqrt((double)n));
+  grid.Origin = lo;
+  grid.CellSize = extent > 0 ? extent / resolution : 1.0;
+  for(int k = 0; k < 2; ++k) {
+    grid.Dimensions[k] = std::min(
+      resolution, (int)((hi[k] - lo[k]) / grid.CellSize) + 1);
+  }
+
+  const auto cellOf = [&grid](const std::array<double, 2> &p) {
+    std::array<int, 2> c{};
+    for(int k = 0; k < 2; ++k) {
+      c[k] = std::min(grid.Dimensions[k] - 1,
+                      (int)((p[k] - grid.Origin[k]) / grid.CellSize));
+    }
+    return c[1] * grid.Dimensions[0] + c[0];
+  };
+
+  // counting sort of the pairs by cell
+  const int nCells = grid.Dimensions[0] * grid.Dimensions[1];
+  grid.CellStart.assign(nCells + 1, 0);
+  for(const auto &p : embedding) {
+    grid.CellStart[cellOf(p) + 1]++;
+  }
+  for(int c = 0; c < nCells; ++c) {
+    grid.CellStart[c + 1] += grid.CellStart[c];
+  }
+  std::vector<int> offsets(grid.CellStart.begin(), grid.CellStart.end() - 1);
+  grid.Points.resize(n);
+  grid.Coordinates.resize(n);
+  for(int i = 0; i < n; ++i) {
+    const int k = offsets[cellOf(embedding[i])]++;
+    grid.Points[k] = i;
+    grid.Coordinates[k] = embedding[i];
+  }
+}
+
+int ttk::GabowTarjan::HopcroftKarp(const std::vector<int> &left,
+                                   const std::vector<std::vector<int>> &edges,
+                                   std::vector<int> &pairLeft,
+                                   std::vector<int> &pairRight) const {
+
+  const int infinity = std::numeric_limits<int>::max();
+  // BFS layer of the left vertices
+  std::vector<int> layers(pairLeft.size(), infinity);
+  // next edge to explore for every left vertex (DFS)
+  std::vector<size_t> nextEdge(pairLeft.size(), 0);
+  std::vector<int> stack{};
+  int matching = 0;
+
+  // greedy initialization
+  for(const auto v : left) {
+    for(const auto u : edges[v]) {
+      if(pairRight[u] == -1) {
+        pairLeft[v] = u;
+        pairRight[u] = v;
+        ++matching;
+        break;
+      }
+    }
+  }
+
+  while(true) {
+    // BFS: layers of the alternating paths from the free left vertices
+    std::queue<int> vertexQueue;
+    for(const auto v : left) {
+      if(pairLeft[v] == -1) {
+        layers[v] = 0;
+        vertexQueue.push(v);
+      } else {
+        layers[v] = infinity;
+      }
+    }
+    int freeLayer = infinity;
+    while(!vertexQueue.empty()) {
+      const int v = vertexQueue.front();
+      vertexQueue.pop();
+      if(layers[v] >= freeLayer)
+        continue;
+      for(const auto u : edges[v]) {
+        const int w = pairRight[u];
+        if(w == -1) {
+          freeLayer = std::min(freeLayer, layers[v] + 1);
+        } else if(layers[w] == infinity) {
+          layers[w] = layers[v] + 1;
+          vertexQueue.push(w);
+        }
+      }
+    }
+    if(freeLayer == infinity)
+      break;
+
+    // DFS: vertex-disjoint shortest augmenting paths
+    for(const auto v : left)
+      nextEdge[v] = 0;
+
+    for(const auto root : left) {
+      if(pairLeft[root] != -1)
+        continue;
+      stack.clear();
+      stack.emplace_back(root);
+      while(!stack.empty()) {
+        const int v = stack.back();
+        if(nextEdge[v] == edges[v].size()) {
+          // dead end
+          layers[v] = infinity;
+          stack.pop_back();
+          if(!stack.empty())
+            nextEdge[stack.back()]++;
+          continue;
+        }
+        const int u = edges[v][nextEdge[v]];
+        const int w = pairRight[u];
+        if(w == -1) {
+          if(layers[v] + 1 == freeLayer) {
+            // augment along the stack
+            for(const auto x : stack) {
+              const int y = edges[x][nextEdge[x]];
+              pairLeft[x] = y;
+              pairRight[y] = x;
+            }
+            ++matching;
+            break;
+          }
+          nextEdge[v]++;
+        } else if(layers[w] == layers[v] + 1) {
+          stack.emplace_back(w);
+        } else {
+          nextEdge[v]++;
+        }
+      }
+    }
+  }
+
+  return matching;
+}
+
+bool ttk::GabowTarjan::mergeMatchings(const double t,
+                                      const std::vector<int> &pairLeft1,
+                                      const std::vector<int> &pairRight1,
+                                      const std::vector<int> &pairLeft2,
+                                      const std::vector<int> &pairRight2,
+                                      std::vector<int> &match1,
+                                      std::vector<int> &match2) const {
+
+  // The union of both matchings is made of alternating paths and cycles.
+  // On each of them, the edges of one of the matchings cover all the
+  // required pairs.
+  match1.assign(Size1, -1);
+  match2.assign(Size2, -1);
+
+  std::vector<bool> visited1(Size1, false), visited2(Size2, false);
+  std::vector<int> component1{}, component2{};
+  // vertices to visit: pairs of the first diagram are positive, pairs of
+  // the second diagram are stored as -(j + 1)
+  std::vector<int> stack{};
+
+  for(unsigned int k = 0; k < Size1 + Size2; ++k) {
+    const bool first = k < Size1;
+    const int start = first ? k : k - Size1;
+    if(first ? visited1[start] : visited2[start])
+      continue;
+
+    component1.clear();
+    component2.clear();
+    stack.clear();
+    stack.emplace_back(first ? start : -(start + 1));
+    if(first)
+      visited1[start] = true;
+    else
+      visited2[start] = true;
+
+    while(!stack.empty()) {
+      const int v = stack.back();
+      stack.pop_back();
+      if(v >= 0) {
+        component1.emplace_back(v);
+        for(const auto j : {pairLeft1[v], pairRight2[v]}) {
+          if(j >= 0 && !visited2[j]) {
+            visited2[j] = true;
+            stack.emplace_back(-(j + 1));
+          }
+        }
+      } else {
+        const int j = -v - 1;
+        component2.emplace_back(j);
+        for(const auto i : {pairRight1[j], pairLeft2[j]}) {
+          if(i >= 0 && !visited1[i]) {
+            visited1[i] = true;
+            stack.emplace_back(i);
+          }
+        }
+      }
+    }
+
+    bool useFirst = true;
+    for(const auto j : component2)
+      if(Diagonal2[j] > t && pairRight1[j] == -1)
+        useFirst = false;
+
+    if(useFirst) {
+      for(const auto i : component1)
+        match1[i] = pairLeft1[i];
+      for(const auto j : component2)
+        match2[j] = pairRight1[j];
+    } else {
+      for(const auto i : component1) {
+        if(Diagonal1[i] > t && pairRight2[i] == -1) {
+          this->printErr("Could not merge the matchings.");
+          return false;
+        }
+        match1[i] = pairRight2[i];
+      }
+      for(const auto j : component2)
+        match2[j] = pairLeft2[j];
+    }
+  }
+
+  return true;
+}
@@ -1,16 +1,44 @@
+/// \ingroup base
+/// \class ttk::GabowTarjan
+///
+/// \brief Bottleneck matching between two persistence diagrams.
+///
+/// The bottleneck distance is the smallest threshold t such that the
+/// bipartite graph of the pairs closer than t (augmented with the
+/// diagonal) has a perfect matching. Instead of sorting the complete
+/// edge list, the threshold is searched (doubling search from below, then
+/// bisection) and the edges below the current threshold are enumerated on
+/// demand, either by scanning a cost matrix or, when a geometric lower
+/// bound of the cost is provided, from a uniform grid of the pairs. Once
+/// the bounds are close, the edges of the remaining range are pooled with
+/// their costs and the exact distance is searched among the candidate
+/// thresholds, several of them being tested in parallel.
+///
+/// The perfect matching test only looks at the "required" pairs, whose
+/// distance to the diagonal exceeds the threshold: a perfect matching
+/// exists if and only if some matching covers the required pairs of both
+/// diagrams. Two Hopcroft-Karp matchings (one per diagram) are computed
+/// in parallel and merged into such a matching (Mendelsohn-Dulmage),
+/// which avoids the complete graph between the diagonal copies.
+///
+/// An epsilon-approximate mode stops the search as soon as the relative
+/// gap between the bounds is below epsilon.
+
 #pragma once
 
-#include "MatchingGraph.h"
 #include <Debug.h>
+
 #include <algorithm>
-#include <iostream>
-#include <map>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
 #include <queue>
 #include <vector>
 
 namespace ttk {
 
-  class GabowTarjan : public Debug {
+  class GabowTarjan : virtual public Debug {
 
   public:
     GabowTarjan() {
@@ -20,15 +48,12 @@ namespace ttk {
     ~GabowTarjan() {
     }
 
-    template <typename dataType>
-    dataType Distance(dataType maxLevel);
-
-    template <typename dataType>
-    void printCurrentMatching();
-
     template <typename dataType>
     int run(std::vector<matchingTuple> &matchings);
 
+    /// Set a (rowSize x colSize) cost matrix as input. The last column
+    /// (resp. row) holds the distances to the diagonal of the pairs of the
+    /// first (resp. second) diagram.
     template <typename dataType>
     inline void setInput(int rowSize_, int colSize_, void *C_) {
       Cptr = C_;
@@ -40,98 +65,190 @@ namespace ttk {
         this->printMsg("One or more empty diagram(s).");
       }
 
-      MaxSize = Size1 + Size2;
-      Edges.clear();
-
-      // Connect diagonal points.
-      for(unsigned int i = Size1; i < MaxSize; ++i)
-        for(unsigned int j = MaxSize + Size2; j < 2 * MaxSize; ++j)
-          Edges.emplace_back(Edge(i, j, (double)0));
-
-      // Connect real points.
-      for(unsigned int i = 0; i < Size1; ++i) {
-        unsigned int k = MaxSize;
-        for(unsigned int j = 0; j < Size2; ++j) {
-          auto val = (double)(*C)[i][j];
-          Edges.emplace_back(Edge(i, k++, val));
-        }
-      }
+      Diagonal1.resize(Size1);
+      Diagonal2.resize(Size2);
+      for(unsigned int i = 0; i < Size1; ++i)
+        Diagonal1[i] = (double)(*C)[i][Size2];
+      for(unsigned int j = 0; j < Size2; ++j)
+        Diagonal2[j] = (double)(*C)[Size1][j];
 
-      // Connect real points with their diagonal.
-      for(unsigned int i = 0; i < Size1; ++i) {
-        auto val = (double)(*C)[i][Size2];
-        Edges.emplace_back(Edge(i, MaxSize + Size2 + i, val));
-      }
+      Cost = nullptr;
+      Embedding1.clear();
+      Embedding2.clear();
+    }
 
-      for(unsigned int j = 0, k = MaxSize; j < Size2; ++j, ++k) {
-        auto val = (double)(*C)[Size1][j];
-        Edges.emplace_back(Edge(Size1 + (k - MaxSize), k, val));
-      }
+    /// Set two diagrams as input, without cost matrix.
+    ///
+    /// \param embedding1 2D embedding of the pairs of the first diagram
+    /// \param embedding2 2D embedding of the pairs of the second diagram
+    /// \param diagonal1 distances to the diagonal of the first diagram
+    /// \param diagonal2 distances to the diagonal of the second diagram
+    /// \param cost distance between a pair of the first diagram and a pair
+    /// of the second diagram. It must be larger than the L-infinity
+    /// distance between their embeddings.
+    inline void setInput(const std::vector<std::array<double, 2>> &embedding1,
+                         const std::vector<std::array<double, 2>> &embedding2,
+                         const std::vector<double> &diagonal1,
+                         const std::vector<double> &diagonal2,
+                         const std::function<double(int, int)> &cost) {
+      Cptr = nullptr;
+      Size1 = embedding1.size();
+      Size2 = embedding2.size();
+      Embedding1 = embedding1;
+      Embedding2 = embedding2;
+      Diagonal1 = diagonal1;
+      Diagonal2 = diagonal2;
+      Cost = cost;
+    }
 
-      std::sort(Edges.begin(), Edges.end());
+    /// Relative error allowed on the bottleneck distance (0 for the exact
+    /// distance).
+    inline void setEpsilon(const double epsilon) {
+      Epsilon = epsilon;
     }
 
     template <typename dataType>
     inline void clear() {
-      MaxSize = 0;
       Size1 = 0;
       Size2 = 0;
-      Edges.clear();
-      Pair.clear();
-      Connections.clear();
-      Layers.clear();
+      Cptr = nullptr;
+      Cost = nullptr;
+      Embedding1.clear();
+      Embedding2.clear();
+      Diagonal1.clear();
+      Diagonal2.clear();
+      Match1.clear();
+      Match2.clear();
+      Grid1 = {};
+      Grid2 = {};
+      Pool1.clear();
+      Pool2.clear();
+      PoolUpper = -1.0;
     }
 
   private:
-    // Original cost matrix.
-    void *Cptr;
+    // Original cost matrix (matrix input).
+    void *Cptr{nullptr};
 
-    /*
-     * Total number of persistencePairs
-     */
-    unsigned int MaxSize;
-    unsigned int Size1;
-    unsigned int Size2;
+    // Cost function and pair embeddings (geometric input).
+    std::function<double(int, int)> Cost{};
+    std::vector<std::array<double, 2>> Embedding1{};
+    std::vector<std::array<double, 2>> Embedding2{};
 
     /*
-     * Edges between all nodes given by
-     * persistencePairs in both persistence diagrams
+     * Number of persistence pairs in each diagram
      */
-    std::vector<Edge> Edges;
+    unsigned int Size1{0};
+    unsigned int Size2{0};
+
+    // Distances to the diagonal.
+    std::vector<double> Diagonal1{};
+    std::vector<double> Diagonal2{};
+
+    double Epsilon{0.0};
 
     /*
-     * Pairing between vertices in persistence diagrams,
-     * -1 means the vertex is not paired to any other vertex.
-     * Non negative number, index of the vertex to
-     * which the given vertex is paired.
+     * Matching of the last feasible threshold: index of the pair of the
+     * other diagram, -1 for the diagonal.
      */
-    std::vector<int> Pair;
+    std::vector<int> Match1{};
+    std::vector<int> Match2{};
 
     /*
-     * Connection matrix, gives edges between
-     * vertices in the first and second diagram
+     * Uniform grid over the embedding of a diagram (compressed storage:
+     * the pairs of cell c are Points[CellStart[c]] to
+     * Points[CellStart[c + 1] - 1], with their embedding in Coordinates).
      */
-    std::vector<std::vector<int>> Connections;
+    struct PairGrid {
+      std::array<double, 2> Origin{};
+      double CellSize{1.0};
+      std::array<int, 2> Dimensions{};
+      std::vector<int> CellStart{};
+      std::vector<int> Points{};
+      std::vector<std::array<double, 2>> Coordinates{};
+    };
+    PairGrid Grid1{};
+    PairGrid Grid2{};
+    // Absolute slack on the grid queries (embedding round-off).
+    double GridSlack{0.0};
 
     /*
-     * Layers used in the Hopcroft-Karp algorithm
-     * The layer information is required for a NIL vertex
-     * and all vertices in PersistencePairs1
-     * Hence 0 slot is used for NIL and all the vertices
-     * in PersistencePairs1 are shifted by one.
-     * So to read layer of the vertex 0 we access Layers[1]
+     * Edge pool: edges (with their cost) of cost at most PoolUpper
+     * adjacent to the pairs farther than PoolLower from the diagonal.
+     * Once built, the edges of any threshold in (PoolLower, PoolUpper]
+     * are filtered from the pool instead of being enumerated again.
      */
-    std::vector<int> Layers;
+    std::vector<std::vector<std::pair<int, double>>> Pool1{};
+    std::vector<std::vector<std::pair<int, double>>> Pool2{};
+    double PoolLower{0.0};
+    double PoolUpper{-1.0};
+
+    // Largest cost of the matching (Match1, Match2).
+    template <typename dataType>
+    double matchingCost() const;
 
     template <typename dataType>
-    bool DFS(int v);
+    inline double cost(const int i, const int j) const {
+      if(Cptr != nullptr) {
+        return (double)(*static_cast<std::vector<std::vector<dataType>> *>(
+          Cptr))[i][j];
+      }
+      return Cost(i, j);
+    }
+
+    void buildGrid(const std::vector<std::array<double, 2>> &embedding,
+                   PairGrid &grid) const;
+
+    // Call f on the pairs of the grid in the L-infinity ball (p, radius).
+    template <typename Functor>
+    void queryGrid(const PairGrid &grid,
+                   const std::array<double, 2> &p,
+                   double radius,
+                   Functor &f) const;
 
+    // Edges between the required pairs of each diagram (distance to the
+    // diagonal larger than t) and the pairs of the other diagram closer
+    // than t. Returns false if a required pair has no edge.
     template <typename dataType>
-    bool BFS();
+    bool computeEdges(double t,
+                      std::vector<std::vector<int>> &edges1,
+                      std::vector<std::vector<int>> &edges2) const;
+
+    // Fill the edge pool for the thresholds in (lower, upper] and store
+    // the sorted candidate thresholds (diagonal distances and edge costs)
+    // of that range.
+    template <typename dataType>
+    void buildEdgePool(double lower,
+                       double upper,
+                       std::vector<double> &candidates);
+
+    // Is there a perfect matching with the edges of cost at most t?
+    // If so, store it in match1 and match2.
+    template <typename dataType>
+    bool isFeasible(double t,
+                    std::vector<int> &match1,
+                    std::vector<int> &match2) const;
+
+    // Hopcroft-Karp algorithm: maximum matching between the left vertices
+    // listed in left and the right vertices, returns its size
+    int HopcroftKarp(const std::vector<int> &left,
+                     const std::vector<std::vector<int>> &edges,
+                     std::vector<int> &pairLeft,
+                     std::vector<int> &pairRight) const;
+
+    // Merge a matching covering the required pairs of the first diagram
+    // and a matching covering the required pairs of the second diagram
+    // into a matching covering both (stored in match1 and match2).
+    bool mergeMatchings(double t,
+                        const std::vector<int> &pairLeft1,
+                        const std::vector<int> &pairRight1,
+                        const std::vector<int> &pairLeft2,
+                        const std::vector<int> &pairRight2,
+                        std::vector<int> &match1,
+                        std::vector<int> &match2) const;
 
-    // Hopcroft-Karp algorithm: find a maximal matching
     template <typename dataType>
-    void HopcroftKarp(unsigned int &matching);
+    double Distance();
   };
 
 // Namespace ttk
@@ -1,286 +1,385 @@
 #pragma once
 
-#include "MatchingGraph.h"
-#include <iostream>
 #include <vector>
 
-template <typename dataType>
-bool GabowTarjan::DFS(int v) {
-  if(v < 0)
-    return true;
-
-  // for every adjacent vertex u of v
-  for(unsigned int i = 0; i < Connections[v].size(); ++i) {
-    int u = Connections[v][i];
-    if(Layers[Pair[u] + 1] == Layers[v + 1] + 1) {
-      if(DFS<dataType>(Pair[u])) {
-        Pair[u] = v;
-        Pair[v] = u;
-        return true;
-      }
+template <typename Functor>
+void GabowTarjan::queryGrid(const PairGrid &grid,
+                            const std::array<double, 2> &p,
+                            const double radius,
+                            Functor &f) const {
+  std::array<int, 2> cellMin{}, cellMax{};
+  for(int k = 0; k < 2; ++k) {
+    const double lo = (p[k] - radius - grid.Origin[k]) / grid.CellSize;
+    const double hi = (p[k] + radius - grid.Origin[k]) / grid.CellSize;
+    if(hi < 0 || lo >= grid.Dimensions[k]) {
+      return;
     }
+    cellMin[k] = lo < 0 ? 0 : static_cast<int>(lo);
+    cellMax[k] = hi >= grid.Dimensions[k] - 1 ? grid.Dimensions[k] - 1
+                                              : static_cast<int>(hi);
   }
 
-  Layers[v + 1] = -1;
-
-  return false;
+  for(int y = cellMin[1]; y <= cellMax[1]; ++y) {
+    for(int x = cellMin[0]; x <= cellMax[0]; ++x) {
+      const int c = y * grid.Dimensions[0] + x;
+      for(int k = grid.CellStart[c]; k < grid.CellStart[c + 1]; ++k) {
+        const auto &q = grid.Coordinates[k];
+        if(std::abs(q[0] - p[0]) <= radius && std::abs(q[1] - p[1]) <= radius)
+          f(grid.Points[k]);
+      }
+    }
+  }
 }
 
 template <typename dataType>
-bool GabowTarjan::BFS() {
-  std::queue<int> vertexQueue;
-
-  // For every vertex v given by PersistencePairs1
-  for(unsigned int v = 0; v < MaxSize; v++) {
-    // If its not paired to vertex in PersistencePairs2
-    if(Pair[v] < 0) {
-      // Set its layer to 0 and put it in the queue
-      Layers[v + 1] = 0;
-      vertexQueue.push(v);
+bool GabowTarjan::computeEdges(const double t,
+                               std::vector<std::vector<int>> &edges1,
+                               std::vector<std::vector<int>> &edges2) const {
+  const int size1 = Size1;
+  const int size2 = Size2;
+  // the embedding distance is a lower bound of the cost, up to round-off
+  const double radius = t * (1.0 + 1e-6) + GridSlack;
+  // filter the edge pool if it covers t
+  const bool usePool = t > PoolLower && t <= PoolUpper;
+  // early exit when a required pair has no edge
+  bool covered = true;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(int i = 0; i < size1; ++i) {
+    if(Diagonal1[i] <= t)
+      continue;
+    bool stillCovered;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic read
+#endif // TTK_ENABLE_OPENMP
+    stillCovered = covered;
+    if(!stillCovered)
+      continue;
+    auto &edges = edges1[i];
+    const auto addEdge = [&](const int j) {
+      if(this->cost<dataType>(i, j) <= t)
+        edges.emplace_back(j);
+    };
+    if(usePool) {
+      for(const auto &e : Pool1[i])
+        if(e.second <= t)
+          edges.emplace_back(e.first);
+    } else if(Cptr != nullptr) {
+      for(int j = 0; j < size2; ++j)
+        addEdge(j);
     } else {
-      // Otherwise mark it as matched (set Layer to NIL)
-      Layers[v + 1] = -1;
+      this->queryGrid(Grid2, Embedding1[i], radius, addEdge);
+    }
+    if(edges.empty()) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic write
+#endif // TTK_ENABLE_OPENMP
+      covered = false;
     }
   }
-
-  // Set layer for NIL
-  Layers[0] = -1;
-
-  // Search the vertices in the queue
-  while(!vertexQueue.empty()) {
-    int v = vertexQueue.front();
-    vertexQueue.pop();
-    if(Layers[v + 1] > Layers[0]) {
-      for(unsigned int i = 0; i < Connections[v].size(); ++i) {
-        int u = Connections[v][i];
-        // Check if the vertex has an edge to the match vertex
-        if(Layers[Pair[u] + 1] < 0) {
-          // Set the layer of the vertex (it can be NIL) which is matched to the
-          // matched vertex u
-          Layers[Pair[u] + 1] = Layers[v + 1] + 1;
-          // If the pairing vertex is not NIL add it into the queue
-          if(Pair[u] != -1)
-            vertexQueue.push(Pair[u]);
-        }
-      }
+  if(!covered)
+    return false;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(int j = 0; j < size2; ++j) {
+    if(Diagonal2[j] <= t)
+      continue;
+    bool stillCovered;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic read
+#endif // TTK_ENABLE_OPENMP
+    stillCovered = covered;
+    if(!stillCovered)
+      continue;
+    auto &edges = edges2[j];
+    const auto addEdge = [&](const int i) {
+      if(this->cost<dataType>(i, j) <= t)
+        edges.emplace_back(i);
+    };
+    if(usePool) {
+      for(const auto &e : Pool2[j])
+        if(e.second <= t)
+          edges.emplace_back(e.first);
+    } else if(Cptr != nullptr) {
+      for(int i = 0; i < size1; ++i)
+        addEdge(i);
+    } else {
+      this->queryGrid(Grid1, Embedding2[j], radius, addEdge);
+    }
+    if(edges.empty()) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic write
+#endif // TTK_ENABLE_OPENMP
+      covered = false;
     }
   }
 
-  return Layers[0] != -1;
+  return covered;
 }
 
 template <typename dataType>
-void GabowTarjan::HopcroftKarp(unsigned int &matching) {
-  while(BFS<dataType>())
-    for(unsigned int vertex = 0; vertex < MaxSize; ++vertex) {
-      if(Pair[vertex] == -1) {
-        if(DFS<dataType>(vertex))
-          ++matching;
-      }
+void GabowTarjan::buildEdgePool(const double lower,
+                                const double upper,
+                                std::vector<double> &candidates) {
+  const int size1 = Size1;
+  const int size2 = Size2;
+  const double radius = upper * (1.0 + 1e-6) + GridSlack;
+
+  Pool1.assign(Size1, {});
+  Pool2.assign(Size2, {});
+
+  // only the edges adjacent to a pair required for some threshold in
+  // (lower, upper] can be part of the matching
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(int k = 0; k < size1 + size2; ++k) {
+    const bool first = k < size1;
+    const int v = first ? k : k - size1;
+    if((first ? Diagonal1[v] : Diagonal2[v]) <= lower)
+      continue;
+    auto &edges = first ? Pool1[v] : Pool2[v];
+    const auto addEdge = [&](const int w) {
+      const double c
+        = first ? this->cost<dataType>(v, w) : this->cost<dataType>(w, v);
+      if(c <= upper)
+        edges.emplace_back(w, c);
+    };
+    if(Cptr != nullptr) {
+      for(int w = 0; w < (first ? size2 : size1); ++w)
+        addEdge(w);
+    } else if(first) {
+      this->queryGrid(Grid2, Embedding1[v], radius, addEdge);
+    } else {
+      this->queryGrid(Grid1, Embedding2[v], radius, addEdge);
     }
+  }
+
+  PoolLower = lower;
+  PoolUpper = upper;
+
+  candidates.clear();
+  for(const auto d : Diagonal1)
+    if(d > lower && d <= upper)
+      candidates.emplace_back(d);
+  for(const auto d : Diagonal2)
+    if(d > lower && d <= upper)
+      candidates.emplace_back(d);
+  for(const auto &pool : {&Pool1, &Pool2})
+    for(const auto &edges : *pool)
+      for(const auto &e : edges)
+        if(e.second > lower)
+          candidates.emplace_back(e.second);
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(
+    std::unique(candidates.begin(), candidates.end()), candidates.end());
 }
 
 template <typename dataType>
-dataType GabowTarjan::Distance(dataType maxLevel) {
-  // Clear the pairing
-  Pair.clear();
-  Pair.assign(2 * MaxSize, -1);
-
-  // Clearing Layers
-  Layers.clear();
-  Layers.resize(MaxSize + 1);
-
-  // No vertices are matched
-  unsigned int matching = 0;
-  unsigned int matching0 = 0;
-
-  // Clear the connection matrix and set it to the right size
-  Connections.clear();
-  Connections.resize(MaxSize);
-
-  // The maximal weight of the edges which are used for the matching
-  double currentWeight = 0;
-
-  // First non added edge is an iterator pointing to the first edge
-  // in Edges which was added to the Connections
-  unsigned int firstNotAddedEdge = 0;
-  unsigned int nbEdges = (unsigned int)Edges.size();
-
-  unsigned int lowerBound = 0;
-  unsigned int upperBound = nbEdges;
-  unsigned int guessEdge = (lowerBound + nbEdges) / 2;
-
-  std::map<int, int> offPairings;
-
-  // Repeat till all the vertices are matched
-  while(matching < MaxSize) {
-    // Save initial matching.
-    matching0 = matching;
-    unsigned int oldGuessEdge = guessEdge;
-
-    currentWeight = Edges[guessEdge].weight;
-    while(Edges[guessEdge].weight == currentWeight && guessEdge < nbEdges)
-      ++guessEdge;
-
-    if(guessEdge >= nbEdges) {
-      this->printMsg("ran out of edges.");
-    }
+bool GabowTarjan::isFeasible(const double t,
+                             std::vector<int> &match1,
+                             std::vector<int> &match2) const {
+  std::vector<std::vector<int>> edges1(Size1), edges2(Size2);
+  if(!this->computeEdges<dataType>(t, edges1, edges2))
+    return false;
+
+  std::vector<int> left1{}, left2{};
+  for(unsigned int i = 0; i < Size1; ++i)
+    if(Diagonal1[i] > t)
+      left1.emplace_back(i);
+  for(unsigned int j = 0; j < Size2; ++j)
+    if(Diagonal2[j] > t)
+      left2.emplace_back(j);
+
+  // matchings covering the required pairs of each diagram
+  std::vector<int> pairLeft1(Size1, -1), pairRight1(Size2, -1);
+  std::vector<int> pairLeft2(Size2, -1), pairRight2(Size1, -1);
+  int matching1 = 0, matching2 = 0;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel sections num_threads(std::min(threadNumber_, 2))
+#endif // TTK_ENABLE_OPENMP
+  {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp section
+#endif // TTK_ENABLE_OPENMP
+    matching1 = this->HopcroftKarp(left1, edges1, pairLeft1, pairRight1);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp section
+#endif // TTK_ENABLE_OPENMP
+    matching2 = this->HopcroftKarp(left2, edges2, pairLeft2, pairRight2);
+  }
 
-    // Add the edges with the current weight (distance) to the connection matrix
-    while(firstNotAddedEdge >= guessEdge) {
-      int v1 = Edges[firstNotAddedEdge].v1;
-      int v2 = Edges[firstNotAddedEdge].v2;
+  if(matching1 < (int)left1.size() || matching2 < (int)left2.size())
+    return false;
 
-      std::vector<int> vec1 = Connections[v1];
-      vec1.erase(std::remove(vec1.begin(), vec1.end(), v2), vec1.end());
-      Connections[v1] = vec1;
+  return this->mergeMatchings(
+    t, pairLeft1, pairRight1, pairLeft2, pairRight2, match1, match2);
+}
 
-      --firstNotAddedEdge;
-    }
+template <typename dataType>
+double GabowTarjan::matchingCost() const {
+  double res = 0;
+  for(unsigned int i = 0; i < Size1; ++i)
+    res = std::max(res, Match1[i] < 0 ? Diagonal1[i]
+                                      : this->cost<dataType>(i, Match1[i]));
+  for(unsigned int j = 0; j < Size2; ++j)
+    if(Match2[j] < 0)
+      res = std::max(res, Diagonal2[j]);
+  return res;
+}
 
-    // Edges[firstNotAddedEdge].weight == currentWeight && firstNotAddedEdge <
-    // nbEdges
-    while(firstNotAddedEdge < guessEdge) {
-      int v1 = Edges[firstNotAddedEdge].v1;
-      int v2 = Edges[firstNotAddedEdge].v2;
+template <typename dataType>
+double GabowTarjan::Distance() {
+  Match1.assign(Size1, -1);
+  Match2.assign(Size2, -1);
+  Pool1.clear();
+  Pool2.clear();
+  PoolUpper = -1.0;
+
+  if(Cptr == nullptr) {
+    this->buildGrid(Embedding1, Grid1);
+    this->buildGrid(Embedding2, Grid2);
+    // round-off of the embedding coordinates
+    double magnitude = 0;
+    for(const auto &embedding : {&Embedding1, &Embedding2})
+      for(const auto &p : *embedding)
+        magnitude = std::max(
+          magnitude, std::max(std::abs(p[0]), std::abs(p[1])));
+    GridSlack = 1e-9 * magnitude;
+  }
 
-      Connections[v1].push_back(v2);
-      ++firstNotAddedEdge;
+  // Matching every pair with the diagonal is always possible.
+  double upper = 0;
+  for(const auto d : Diagonal1)
+    upper = std::max(upper, d);
+  for(const auto d : Diagonal2)
+    upper = std::max(upper, d);
+  // Largest threshold known to be infeasible (none yet).
+  double lower = -1;
+
+  std::vector<int> match1{}, match2{};
+
+  // Doubling search from below: the tests under the distance are cheap
+  // (few edges, early exit), while the graphs far above it are dense.
+  for(double t = upper / 1024; t < upper; t *= 2) {
+    if(this->isFeasible<dataType>(t, match1, match2)) {
+      upper = t;
+      Match1.swap(match1);
+      Match2.swap(match2);
+      break;
     }
+    lower = t;
+  }
 
-    // Clear the pairing
-    Pair.clear();
-    Pair.assign(2 * MaxSize, -1);
-    // Clearing Layers
-    Layers.clear();
-    Layers.resize(MaxSize + 1);
-
-    // Temporarily augment matching.
-    this->printMsg("Guessing for " + std::to_string(guessEdge) + "...");
-
-    matching = 0;
-    HopcroftKarp<dataType>(matching);
-    // printCurrentMatching<dataType>();
-
-    if(matching >= MaxSize) {
-
-      // Reset matching.
-      matching = matching0;
-      upperBound = guessEdge;
-      guessEdge = (lowerBound + guessEdge) / 2;
-
-      // Ended binary search.
-      if(oldGuessEdge == guessEdge) {
-        this->printMsg("Binary search success.");
-        return Edges[(guessEdge > 0 ? guessEdge - 1 : guessEdge)].weight;
+  // Bisection between the bounds. Once they are close enough, the
+  // edges of the remaining range are pooled (the pool is then about as
+  // large as the edge set of a single feasibility test) and the exact
+  // distance is searched among the candidate thresholds.
+  const int maxIterations = 64;
+  std::vector<double> candidates{};
+  bool exact = false;
+
+  for(int iteration = 0;; ++iteration) {
+    const double l = std::max(lower, 0.0);
+    if(upper <= l)
+      break;
+    if(Epsilon > 0 && upper - l <= Epsilon * upper)
+      break;
+    if(PoolUpper < 0
+       && (upper - l <= 1e-1 * upper || iteration >= maxIterations)) {
+      this->buildEdgePool<dataType>(lower, upper, candidates);
+      // the following tests only filter the pool
+      if(Epsilon <= 0) {
+        exact = true;
+        break;
       }
+    }
 
+    const double t = (l + upper) / 2;
+    if(this->isFeasible<dataType>(t, match1, match2)) {
+      upper = t;
+      Match1.swap(match1);
+      Match2.swap(match2);
     } else {
+      lower = t;
+    }
+  }
 
-      // Check if we did not run out of edges. This should never happen.
-      if(firstNotAddedEdge == nbEdges) {
-        std::stringstream msg;
-        ttk::Debug d;
-        this->printMsg("Not enough edges to find the matching!");
-        // return -1;
-        return currentWeight;
+  // Search among the candidate thresholds: the feasibility tests of
+  // several candidates run in parallel.
+  if(exact && !candidates.empty()) {
+    this->printMsg("Searching among " + std::to_string(candidates.size())
+                     + " candidates.",
+                   debug::Priority::DETAIL);
+    int lo = 0, hi = candidates.size() - 1;
+    int found = -1;
+    while(lo < hi) {
+      const int nProbes = std::max(1, std::min(threadNumber_, hi - lo));
+      std::vector<int> probes(nProbes);
+      std::vector<char> feasible(nProbes, false);
+      std::vector<std::vector<int>> matches1(nProbes), matches2(nProbes);
+      for(int k = 0; k < nProbes; ++k)
+        probes[k] = lo + (int)((long)(hi - lo) * (k + 1) / (nProbes + 1));
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nProbes)
+#endif // TTK_ENABLE_OPENMP
+      for(int k = 0; k < nProbes; ++k) {
+        feasible[k] = this->isFeasible<dataType>(
+          candidates[probes[k]], matches1[k], matches2[k]);
       }
 
-      lowerBound = guessEdge;
-      guessEdge = (guessEdge + upperBound) / 2;
-      // Increase the value of the current weight
-      // currentWeight = Edges[firstNotAddedEdge].weight;
-
-      // Ended binary search.
-      if(oldGuessEdge == guessEdge) {
-        this->printMsg("Binary search success.");
-        return Edges[(guessEdge > 0 ? guessEdge - 1 : guessEdge)].weight;
+      int first = 0;
+      while(first < nProbes && !feasible[first])
+        ++first;
+      if(first < nProbes) {
+        hi = found = probes[first];
+        Match1.swap(matches1[first]);
+        Match2.swap(matches2[first]);
       }
+      if(first > 0)
+        lo = probes[first - 1] + 1;
     }
-  }
-
-  return -1;
-}
-
-template <typename dataType>
-void GabowTarjan::printCurrentMatching() {
-  int size = 2 * MaxSize;
-  std::vector<int> missedPlaces;
-
-  {
-    std::stringstream msg;
-    msg << "Assignment matrix: " << std::endl;
-    for(int i = 0; i < size; ++i) {
-      int k = Pair[i];
-      if(k < 0 || k > size)
-        missedPlaces.push_back(i);
-      for(int j = 0; j < size; ++j) {
-        msg << (j == k ? "1 " : "0 ");
+    if(found != hi) {
+      if(this->isFeasible<dataType>(candidates[hi], match1, match2)) {
+        Match1.swap(match1);
+        Match2.swap(match2);
+      } else {
+        this->printErr("No feasible threshold found.");
       }
-      msg << std::endl;
     }
-    msg << "/Assignment matrix." << std::endl << std::endl;
-    this->printMsg(msg.str(), debug::Priority::VERBOSE);
   }
 
-  {
-    std::stringstream msg;
-    ttk::Debug d;
-    msg << "Missed:" << std::endl;
-    for(unsigned int i = 0; i < missedPlaces.size(); ++i) {
-      msg << missedPlaces.at(i) << " ";
-    }
-    msg << std::endl << std::endl;
-    this->printMsg(msg.str());
-  }
+  return this->matchingCost<dataType>();
 }
 
 template <typename dataType>
 int GabowTarjan::run(std::vector<matchingTuple> &matchings) {
   // Compute distance.
-  double dist = Distance<dataType>(1);
+  double dist = Distance<dataType>();
   this->printMsg("Computed distance " + std::to_string(dist));
 
   // Fill matchings.
   matchings.clear();
-  auto C = (std::vector<std::vector<dataType>> *)Cptr;
 
   for(unsigned int i = 0; i < Size1; ++i) {
-    if(Pair[i] == -1)
-      continue;
-
-    int j = Pair[i] - MaxSize;
-    if(j <= -1 || (j < (int)Size2 && Pair[j + MaxSize] != (int)i)) {
-      this->printErr("Hopcroft-Karp built an invalid matching.");
-      // return -1;
-    }
-
-    if(j >= (int)Size2) {
-      matchingTuple t = std::make_tuple(i, j, (*C)[i][Size2]);
-      matchings.push_back(t);
+    const int j = Match1[i];
+    if(j < 0) {
+      matchings.emplace_back(i, Size2, Diagonal1[i]);
     } else {
-      matchingTuple t = std::make_tuple(i, j, (*C)[i][j]);
-      matchings.push_back(t);
+      matchings.emplace_back(i, j, this->cost<dataType>(i, j));
     }
   }
 
-  for(unsigned int j = Size1; j < MaxSize; ++j) {
-    if(Pair[j] == -1)
-      continue;
-
-    int i = Pair[j] - MaxSize - Size2;
-    if(i > -1 && (i >= (int)Size1 || Pair[i + MaxSize + Size2] != (int)j)) {
-      this->printErr("Hopcroft-Karp built an invalid matching.");
-      // return -1;
-    }
-
-    if(i <= -1) {
-      matchingTuple t = std::make_tuple(i, j - Size1, (*C)[Size1][j - Size1]);
-      matchings.push_back(t);
-    } else {
-      // Already added by symmetry.
-      matchingTuple t = std::make_tuple(i, j - Size1, (*C)[i][j - Size1]);
-      matchings.push_back(t);
+  for(unsigned int j = 0; j < Size2; ++j) {
+    if(Match2[j] < 0) {
+      matchings.emplace_back(-1, j, Diagonal2[j]);
     }
   }
 
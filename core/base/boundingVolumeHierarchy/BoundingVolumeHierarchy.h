@@ -7,14 +7,23 @@
 /// Based on implementation described in Physically Based Rendering:
 /// From Theory to Implementation by Matt Pharr, Wenzel Jakob and
 /// Greg Humphreys.
+///
+/// The hierarchy is built top-down with a binned surface area heuristic
+/// (subtrees are built in parallel) and stored as a flat array of nodes,
+/// the two children of an interior node being adjacent. Triangles are
+/// copied in leaf order in a precomputed form (first vertex and two edges)
+/// for the intersection tests. Rays can be traced one by one or by packets
+/// of coherent rays (e.g. neighbouring pixels) sharing the same traversal.
 
 #pragma once
 
 #include "Ray.h"
+#include <BaseClass.h>
 #include <Geometry.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <limits>
-#include <stack>
 #include <vector>
 
 namespace ttk {
@@ -22,361 +31,404 @@ namespace ttk {
   class BoundingVolumeHierarchy {
   protected:
     struct Node {
-      Node() {
-      }
-      // leaf constructor
-      Node(const std::vector<int> &triangleIndices,
-           const size_t nTriangles,
-           const float *pMin,
-           const float *pMax) {
-        m_minX = pMin[0];
-        m_minY = pMin[1];
-        m_minZ = pMin[2];
-        m_maxX = pMax[0];
-        m_maxY = pMax[1];
-        m_maxZ = pMax[2];
-        indices = triangleIndices;
-        numTriangles = nTriangles;
-        m_left = m_right = nullptr;
-      }
-      // interior constructor
-      Node(const int axis, Node *left, Node *right) {
-        numTriangles = 0;
-        m_left = left;
-        m_right = right;
-        m_splitAxis = axis;
-        m_minX = std::min(left->m_minX, right->m_minX);
-        m_minY = std::min(left->m_minY, right->m_minY);
-        m_minZ = std::min(left->m_minZ, right->m_minZ);
-        m_maxX = std::max(left->m_maxX, right->m_maxX);
-        m_maxY = std::max(left->m_maxY, right->m_maxY);
-        m_maxZ = std::max(left->m_maxZ, right->m_maxZ);
-      }
-
-      ~Node() {
-        if(m_left)
-          delete m_left;
-        if(m_right)
-          delete m_right;
-      }
-
-      std::vector<int> indices;
+      float m_min[3];
+      // interior node: index of the left child (the right one follows),
+      // leaf: index of the first triangle
+      int m_leftOrFirst;
+      float m_max[3];
+      // 0 for interior nodes
       int numTriangles;
-      float m_minX, m_minY, m_minZ;
-      float m_maxX, m_maxY, m_maxZ;
-      Node *m_left;
-      Node *m_right;
-      int m_splitAxis;
     };
 
     struct Triangle {
       int m_index;
-      float m_centroid_x, m_centroid_y, m_centroid_z;
-      float m_minX, m_minY, m_minZ;
-      float m_maxX, m_maxY, m_maxZ;
-      Triangle() {
-      }
+      float m_centroid[3];
+      float m_min[3];
+      float m_max[3];
+    };
 
-      void init(const int &index,
-                const float &centroid_x,
-                const float &centroid_y,
-                const float &centroid_z,
-                const float *pMin,
-                const float *pMax) {
-        m_index = index;
-        m_centroid_x = centroid_x;
-        m_centroid_y = centroid_y;
-        m_centroid_z = centroid_z;
-        m_minX = pMin[0];
-        m_minY = pMin[1];
-        m_minZ = pMin[2];
-
-        m_maxX = pMax[0];
-        m_maxY = pMax[1];
-        m_maxZ = pMax[2];
+    struct Bounds {
+      float m_min[3]{std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::max()};
+      float m_max[3]{std::numeric_limits<float>::lowest(),
+                     std::numeric_limits<float>::lowest(),
+                     std::numeric_limits<float>::lowest()};
+
+      inline void grow(const float *pMin, const float *pMax) {
+        for(int i = 0; i < 3; i++) {
+          m_min[i] = std::min(m_min[i], pMin[i]);
+          m_max[i] = std::max(m_max[i], pMax[i]);
+        }
+      }
+      inline float area() const {
+        const float dx = m_max[0] - m_min[0];
+        const float dy = m_max[1] - m_min[1];
+        const float dz = m_max[2] - m_min[2];
+        return dx < 0 ? 0 : dx * dy + dy * dz + dz * dx;
       }
     };
 
+    // number of bins of the surface area heuristic
+    static constexpr int NBINS{16};
+    // leaves hold at most this number of triangles (unless they cannot be
+    // split)
+    static constexpr int MAX_LEAF_SIZE{4};
+    // nodes deeper than this are leaves, bounds the traversal stack
+    static constexpr int MAX_DEPTH{64};
+    // subtrees with more triangles are built in a separate task
+    static constexpr int TASK_SIZE{4096};
+
   public:
     BoundingVolumeHierarchy(const float *coords,
                             const IT *connectivityList,
-                            const size_t &nTriangles) {
+                            const size_t &nTriangles,
+                            const int threadNumber = ttk::globalThreadNumber_) {
       std::vector<Triangle> triangles;
-      buildTriangleList(triangles, coords, connectivityList, nTriangles);
-
-      this->nodes = buildTree(triangles, 0, nTriangles);
+      buildTriangleList(
+        triangles, coords, connectivityList, nTriangles, threadNumber);
+
+      if(nTriangles == 0)
+        return;
+
+      // a binary tree with nTriangles leaves has at most 2 * nTriangles - 1
+      // nodes (index 1 is skipped to keep children pairs aligned)
+      this->nodes.resize(2 * nTriangles + 1);
+      std::atomic<int> nodeCount{2};
+      this->nodes[0].m_leftOrFirst = 0;
+      this->nodes[0].numTriangles = nTriangles;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber)
+#pragma omp single nowait
+#endif // TTK_ENABLE_OPENMP
+      this->buildTree(triangles, 0, 0, nodeCount);
+
+      this->nodes.resize(nodeCount);
+
+      // triangles in leaf order: first vertex and the two edges from it
+      this->triangleIds.resize(nTriangles);
+      this->triangleData.resize(9 * nTriangles);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < nTriangles; i++) {
+        const int ti = triangles[i].m_index;
+        const float *v0 = &coords[connectivityList[ti * 3 + 0] * 3];
+        const float *v1 = &coords[connectivityList[ti * 3 + 1] * 3];
+        const float *v2 = &coords[connectivityList[ti * 3 + 2] * 3];
+        float *data = &this->triangleData[9 * i];
+        data[0] = v0[0];
+        data[1] = v0[1];
+        data[2] = v0[2];
+        ttk::Geometry::subtractVectors(v0, v1, &data[3]);
+        ttk::Geometry::subtractVectors(v0, v2, &data[6]);
+        this->triangleIds[i] = ti;
+      }
     }
 
-    ~BoundingVolumeHierarchy() {
-      if(this->nodes)
-        delete this->nodes;
-    }
+    void buildTree(std::vector<Triangle> &triangles,
+                   const int nodeId,
+                   const int depth,
+                   std::atomic<int> &nodeCount) {
 
-    Node *
-      buildTree(std::vector<Triangle> &triangles, size_t start, size_t end) {
+      Node &node = this->nodes[nodeId];
+      const int start = node.m_leftOrFirst;
+      const int numberTriangles = node.numTriangles;
+      const int end = start + numberTriangles;
 
-      float minX, minY, minZ;
-      float maxX, maxY, maxZ;
-      minX = minY = minZ = std::numeric_limits<float>::max();
-      maxX = maxY = maxZ = std::numeric_limits<float>::min();
-      for(size_t i = start; i < end; i++) {
+      Bounds bounds, centroidBounds;
+      for(int i = start; i < end; i++) {
         const Triangle &t = triangles[i];
-        minX = std::min(t.m_minX, minX);
-        minY = std::min(t.m_minY, minY);
-        minZ = std::min(t.m_minZ, minZ);
+        bounds.grow(t.m_min, t.m_max);
+        centroidBounds.grow(t.m_centroid, t.m_centroid);
+      }
+      for(int i = 0; i < 3; i++) {
+        node.m_min[i] = bounds.m_min[i];
+        node.m_max[i] = bounds.m_max[i];
+      }
 
-        maxX = std::max(t.m_maxX, maxX);
-        maxY = std::max(t.m_maxY, maxY);
-        maxZ = std::max(t.m_maxZ, maxZ);
+      if(numberTriangles == 1 || depth >= MAX_DEPTH)
+        return;
+
+      // bin the triangles along the largest extent of their centroids (as in
+      // PBRT)
+      int axis = 0;
+      for(int a = 1; a < 3; a++) {
+        if(centroidBounds.m_max[a] - centroidBounds.m_min[a]
+           > centroidBounds.m_max[axis] - centroidBounds.m_min[axis])
+          axis = a;
       }
-      int numberTriangles = end - start;
-      if(numberTriangles == 1) {
-        const Triangle &t = triangles[start];
-        std::vector<int> indices = {t.m_index};
-        float pMin[3] = {t.m_minX, t.m_minY, t.m_minZ};
-        float pMax[3] = {t.m_maxX, t.m_maxY, t.m_maxZ};
-        return new Node(indices, 1, pMin, pMax);
-      } else {
-        // find the bounds of the centroids, figure out what dimension to split
-        // on
-        float cminX, cminY, cminZ;
-        float cmaxX, cmaxY, cmaxZ;
-        cminX = cminY = cminZ = std::numeric_limits<float>::max();
-        cmaxX = cmaxY = cmaxZ = std::numeric_limits<float>::min();
-        for(size_t i = start; i < end; i++) {
+      const float cmin = centroidBounds.m_min[axis];
+      const float extent = centroidBounds.m_max[axis] - cmin;
+      const float scale = extent > 0 ? NBINS / extent : 0;
+      const auto binIndex = [axis, cmin, scale](const Triangle &t) {
+        return std::min(
+          static_cast<int>((t.m_centroid[axis] - cmin) * scale), NBINS - 1);
+      };
+
+      // find the best split plane among the bins
+      int split = -1;
+      float splitCost = std::numeric_limits<float>::max();
+      if(extent > 0) {
+        std::array<Bounds, NBINS> bins{};
+        std::array<int, NBINS> counts{};
+        for(int i = start; i < end; i++) {
           const Triangle &t = triangles[i];
-          cminX = std::min(t.m_centroid_x, cminX);
-          cminY = std::min(t.m_centroid_y, cminY);
-          cminZ = std::min(t.m_centroid_z, cminZ);
-
-          cmaxX = std::max(t.m_centroid_x, cmaxX);
-          cmaxY = std::max(t.m_centroid_y, cmaxY);
-          cmaxZ = std::max(t.m_centroid_z, cmaxZ);
-        }
-        // figure out the biggest extent, use that dimension
-        float diffX = std::abs(cmaxX - cminX);
-        float diffY = std::abs(cmaxY - cminY);
-        float diffZ = std::abs(cmaxZ - cminZ);
-        float maximumExtent = std::max({diffX, diffY, diffZ});
-        int axis;
-        float minToCheck, maxToCheck;
-        if(maximumExtent == diffX) {
-          axis = 0;
-          minToCheck = cminX;
-          maxToCheck = cmaxX;
-        } else if(maximumExtent == diffY) {
-          axis = 1;
-          minToCheck = cminY;
-          maxToCheck = cmaxY;
-        } else {
-          axis = 2;
-          minToCheck = cminZ;
-          maxToCheck = cmaxZ;
+          const int b = binIndex(t);
+          bins[b].grow(t.m_min, t.m_max);
+          counts[b]++;
         }
-        size_t half = (start + end) / 2;
-        // partition triangles into two sets and build children
-        if(minToCheck == maxToCheck) {
 
-          std::vector<int> triangleIndices;
-          for(size_t i = start; i < end; i++) {
-            triangleIndices.push_back(triangles[i].m_index);
+        // sweep from the right to store the costs of the right sides
+        std::array<float, NBINS - 1> rightCosts{};
+        Bounds right;
+        int nRight = 0;
+        for(int b = NBINS - 1; b > 0; b--) {
+          right.grow(bins[b].m_min, bins[b].m_max);
+          nRight += counts[b];
+          rightCosts[b - 1] = nRight * right.area();
+        }
+        Bounds left;
+        int nLeft = 0;
+        for(int b = 0; b < NBINS - 1; b++) {
+          left.grow(bins[b].m_min, bins[b].m_max);
+          nLeft += counts[b];
+          const float cost = nLeft * left.area() + rightCosts[b];
+          if(nLeft > 0 && nLeft < numberTriangles && cost < splitCost) {
+            splitCost = cost;
+            split = b;
           }
-          float pMin[3] = {minX, minY, minZ};
-          float pMax[3] = {maxX, maxY, maxZ};
-          return new Node(triangleIndices, triangleIndices.size(), pMin, pMax);
-        } else {
-          // partition triangles into equally sized subsets
-          std::nth_element(&triangles[start], &triangles[half],
-                           &triangles[end - 1] + 1,
-                           [axis](const Triangle &t1, const Triangle &t2) {
-                             switch(axis) {
-                               case 0:
-                               default:
-                                 return t1.m_centroid_x < t2.m_centroid_x;
-                                 break;
-                               case 1:
-                                 return t1.m_centroid_y < t2.m_centroid_y;
-                                 break;
-                               case 2:
-                                 return t1.m_centroid_z < t2.m_centroid_z;
-                                 break;
-                             }
-                           });
-
-          return new Node(axis, buildTree(triangles, start, half),
-                          buildTree(triangles, half, end));
         }
       }
 
-      return nullptr;
+      int half = start + numberTriangles / 2;
+      if(split != -1) {
+        // make a leaf if traversing the children costs more than
+        // intersecting all the triangles
+        const float area = bounds.area();
+        if(numberTriangles <= MAX_LEAF_SIZE
+           && (area <= 0 || 1 + splitCost / area >= numberTriangles))
+          return;
+
+        half = std::partition(&triangles[start], &triangles[end - 1] + 1,
+                              [&binIndex, split](const Triangle &t) {
+                                return binIndex(t) <= split;
+                              })
+               - &triangles[0];
+      } else if(numberTriangles <= MAX_LEAF_SIZE) {
+        // all the centroids are equal
+        return;
+      }
+
+      const int leftId = nodeCount.fetch_add(2);
+      this->nodes[leftId].m_leftOrFirst = start;
+      this->nodes[leftId].numTriangles = half - start;
+      this->nodes[leftId + 1].m_leftOrFirst = half;
+      this->nodes[leftId + 1].numTriangles = end - half;
+      node.m_leftOrFirst = leftId;
+      node.numTriangles = 0;
+
+      if(half - start > TASK_SIZE) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp task firstprivate(leftId, depth) shared(triangles, nodeCount)
+#endif // TTK_ENABLE_OPENMP
+        this->buildTree(triangles, leftId, depth + 1, nodeCount);
+      } else {
+        this->buildTree(triangles, leftId, depth + 1, nodeCount);
+      }
+      this->buildTree(triangles, leftId + 1, depth + 1, nodeCount);
     }
+
     int buildTriangleList(std::vector<Triangle> &triangles,
                           const float *coords,
                           const IT *connectivityList,
-                          const size_t &nTriangles) {
+                          const size_t &nTriangles,
+                          const int threadNumber) {
       triangles.resize(nTriangles);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
       for(size_t ti = 0; ti < nTriangles; ti++) {
 
         const IT v1 = connectivityList[ti * 3 + 0] * 3;
         const IT v2 = connectivityList[ti * 3 + 1] * 3;
         const IT v3 = connectivityList[ti * 3 + 2] * 3;
 
-        const float &x1 = coords[v1 + 0];
-        const float &x2 = coords[v2 + 0];
-        const float &x3 = coords[v3 + 0];
-
-        const float &y1 = coords[v1 + 1];
-        const float &y2 = coords[v2 + 1];
-        const float &y3 = coords[v3 + 1];
-
-        const float &z1 = coords[v1 + 2];
-        const float &z2 = coords[v2 + 2];
-        const float &z3 = coords[v3 + 2];
-
-        const float pMin[3] = {std::min({x1, x2, x3}), std::min({y1, y2, y3}),
-                               std::min({z1, z2, z3})};
-        const float pMax[3] = {std::max({x1, x2, x3}), std::max({y1, y2, y3}),
-                               std::max({z1, z2, z3})};
-
-        triangles[ti].init(ti, findCentroid(x1, x2, x3),
-                           findCentroid(y1, y2, y3), findCentroid(z1, z2, z3),
-                           pMin, pMax);
+        auto &t = triangles[ti];
+        t.m_index = ti;
+        for(int i = 0; i < 3; i++) {
+          const float &c1 = coords[v1 + i];
+          const float &c2 = coords[v2 + i];
+          const float &c3 = coords[v3 + i];
+          t.m_min[i] = std::min({c1, c2, c3});
+          t.m_max[i] = std::max({c1, c2, c3});
+          t.m_centroid[i] = findCentroid(c1, c2, c3);
+        }
       }
 
       return 1;
     }
 
-    bool MollerTrumbore(Ray &ray,
-                        const IT v0,
-                        const IT v1,
-                        const IT v2,
-                        const float *vertexCoords) const {
-      constexpr float kEpsilon = 1e-8;
-
-      float v0v1[3], v0v2[3], pvec[3], tvec[3], qvec[3];
-      ttk::Geometry::subtractVectors(
-        &vertexCoords[v0], &vertexCoords[v1], v0v1);
-      ttk::Geometry::subtractVectors(
-        &vertexCoords[v0], &vertexCoords[v2], v0v2);
-      ttk::Geometry::crossProduct(ray.m_direction, v0v2, pvec);
-      float det = ttk::Geometry::dotProduct(v0v1, pvec);
-      if(det > -kEpsilon && det < kEpsilon)
-        return false;
-
-      float invDet = 1.0f / det;
-
-      ttk::Geometry::subtractVectors(&vertexCoords[v0], ray.m_origin, tvec);
-      float u = ttk::Geometry::dotProduct(tvec, pvec) * invDet;
-      if(u < 0.0 || u > 1.0)
-        return false;
-
-      ttk::Geometry::crossProduct(tvec, v0v1, qvec);
-      float v = ttk::Geometry::dotProduct(ray.m_direction, qvec) * invDet;
-      if(v < 0.0 || u + v > 1.0)
-        return false;
-
-      float t = ttk::Geometry::dotProduct(v0v2, qvec) * invDet;
-      ray.distance = t;
-      ray.u = u;
-      ray.v = v;
+    /**
+     * @brief Intersect a packet of rays with the triangles
+     *
+     * Moller-Trumbore test, only hits in front of the ray origins are
+     * reported. Nodes are visited as long as one of the rays may hit
+     * them, the child closest to the packet first.
+     */
+    template <int N>
+    void intersect(RayPacket<N> &packet) const {
+      float invDir[3][N];
+      for(int k = 0; k < N; k++) {
+        packet.distance[k] = std::numeric_limits<float>::max();
+        packet.triangleIndex[k] = -1;
+        for(int i = 0; i < 3; i++)
+          invDir[i][k] = 1.0f / packet.direction[i][k];
+      }
 
-      return true;
+      if(this->nodes.empty())
+        return;
+
+      int stack[MAX_DEPTH + 1];
+      int stackSize = 0;
+      int nodeId = 0;
+      if(nodeEntry(packet, invDir, this->nodes[0])
+         == std::numeric_limits<float>::max())
+        return;
+
+      while(true) {
+        const Node &node = this->nodes[nodeId];
+        if(node.numTriangles > 0) {
+          for(int i = 0; i < node.numTriangles; i++)
+            intersectTriangle(packet, node.m_leftOrFirst + i);
+        } else {
+          int near = node.m_leftOrFirst;
+          int far = near + 1;
+          float dNear = nodeEntry(packet, invDir, this->nodes[near]);
+          float dFar = nodeEntry(packet, invDir, this->nodes[far]);
+          if(dFar < dNear) {
+            std::swap(near, far);
+            std::swap(dNear, dFar);
+          }
+          if(dNear < std::numeric_limits<float>::max()) {
+            if(dFar < std::numeric_limits<float>::max())
+              stack[stackSize++] = far;
+            nodeId = near;
+            continue;
+          }
+        }
+        if(stackSize == 0)
+          break;
+        nodeId = stack[--stackSize];
+      }
     }
 
+    // single ray version (the triangles are stored in the hierarchy, the
+    // connectivity and coordinates are not used anymore)
     bool intersect(Ray &r,
-                   const IT *connectivityList,
-                   const float *vertexCoords,
+                   const IT * /*connectivityList*/,
+                   const float * /*vertexCoords*/,
                    int *triangleIndex,
                    float *distance) const {
-      bool wasHit = false;
-      float nearestTriangle = std::numeric_limits<float>::max();
-      std::stack<Node *> stack;
-      Node *node = &nodes[0];
-      if(!wasNodeHit(r, node)) {
-        return false;
+      RayPacket<1> packet;
+      for(int i = 0; i < 3; i++) {
+        packet.origin[i][0] = r.m_origin[i];
+        packet.direction[i][0] = r.m_direction[i];
       }
-      stack.push(node);
-      while(stack.size() != 0) {
-        node = stack.top();
-        stack.pop();
-        if(wasNodeHit(r, node)) {
-
-          if(node->numTriangles > 0) {
-
-            for(int i = 0; i < node->numTriangles; i++) {
-              bool hasHit = false;
-              int triIdx = node->indices[i];
-
-              IT v0 = connectivityList[triIdx * 3 + 0];
-              IT v1 = connectivityList[triIdx * 3 + 1];
-              IT v2 = connectivityList[triIdx * 3 + 2];
-              v0 *= 3;
-              v1 *= 3;
-              v2 *= 3;
-              hasHit = MollerTrumbore(r, v0, v1, v2, vertexCoords);
-              if(hasHit && r.distance < nearestTriangle) {
-                *triangleIndex = triIdx;
-                nearestTriangle = r.distance;
-                wasHit = true;
-                *distance = r.distance;
-              }
-            }
-          } else {
-
-            if(node->m_right != nullptr) {
-              stack.push(node->m_right);
-            }
-            if(node->m_left != nullptr) {
-              stack.push(node->m_left);
-            }
-          }
-        }
-      }
-      return wasHit;
-    }
-
-    bool wasNodeHit(const Ray &r, Node *n) const {
-      float tmin = (n->m_minX - r.m_origin[0]) / r.m_direction[0];
-      float tmax = (n->m_maxX - r.m_origin[0]) / r.m_direction[0];
-
-      if(tmin > tmax)
-        std::swap(tmin, tmax);
-
-      float tymin = (n->m_minY - r.m_origin[1]) / r.m_direction[1];
-      float tymax = (n->m_maxY - r.m_origin[1]) / r.m_direction[1];
-
-      if(tymin > tymax)
-        std::swap(tymin, tymax);
-
-      if((tmin > tymax) || (tymin > tmax))
+      this->intersect(packet);
+      if(packet.triangleIndex[0] == -1)
         return false;
 
-      if(tymin > tmin)
-        tmin = tymin;
-
-      if(tymax < tmax)
-        tmax = tymax;
-
-      float tzmin = (n->m_minZ - r.m_origin[2]) / r.m_direction[2];
-      float tzmax = (n->m_maxZ - r.m_origin[2]) / r.m_direction[2];
-
-      if(tzmin > tzmax)
-        std::swap(tzmin, tzmax);
-
-      if((tmin > tzmax) || (tzmin > tmax))
-        return false;
+      r.distance = packet.distance[0];
+      r.u = packet.u[0];
+      r.v = packet.v[0];
+      *triangleIndex = packet.triangleIndex[0];
+      *distance = packet.distance[0];
+      return true;
+    }
 
-      if(tzmin > tmin)
-        tmin = tzmin;
+  protected:
+    // Closest entry distance of the rays of a packet into a node (max float
+    // if no ray can hit a triangle of the node)
+    template <int N>
+    inline float nodeEntry(const RayPacket<N> &packet,
+                           const float invDir[3][N],
+                           const Node &node) const {
+      float entry = std::numeric_limits<float>::max();
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(min : entry)
+#endif // TTK_ENABLE_OPENMP
+      for(int k = 0; k < N; k++) {
+        float tmin = 0.0f;
+        float tmax = packet.distance[k];
+        for(int i = 0; i < 3; i++) {
+          const float t1 = (node.m_min[i] - packet.origin[i][k]) * invDir[i][k];
+          const float t2 = (node.m_max[i] - packet.origin[i][k]) * invDir[i][k];
+          tmin = std::max(tmin, std::min(t1, t2));
+          tmax = std::min(tmax, std::max(t1, t2));
+        }
+        entry = std::min(
+          entry, tmin <= tmax ? tmin : std::numeric_limits<float>::max());
+      }
+      return entry;
+    }
 
-      if(tzmax < tmax)
-        tmax = tzmax;
+    template <int N>
+    inline void intersectTriangle(RayPacket<N> &packet, const int i) const {
+      constexpr float kEpsilon = 1e-8;
 
-      return true;
+      const float *v0 = &this->triangleData[9 * i];
+      const float *v0v1 = v0 + 3;
+      const float *v0v2 = v0 + 6;
+      const int triIdx = this->triangleIds[i];
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd
+#endif // TTK_ENABLE_OPENMP
+      for(int k = 0; k < N; k++) {
+        const float dir[3]{packet.direction[0][k], packet.direction[1][k],
+                           packet.direction[2][k]};
+        const float tvec[3]{packet.origin[0][k] - v0[0],
+                            packet.origin[1][k] - v0[1],
+                            packet.origin[2][k] - v0[2]};
+        // inlined cross and dot products (vectorized over the rays)
+        const float pvec[3]{dir[1] * v0v2[2] - dir[2] * v0v2[1],
+                            dir[2] * v0v2[0] - dir[0] * v0v2[2],
+                            dir[0] * v0v2[1] - dir[1] * v0v2[0]};
+        const float qvec[3]{tvec[1] * v0v1[2] - tvec[2] * v0v1[1],
+                            tvec[2] * v0v1[0] - tvec[0] * v0v1[2],
+                            tvec[0] * v0v1[1] - tvec[1] * v0v1[0]};
+        const float det
+          = v0v1[0] * pvec[0] + v0v1[1] * pvec[1] + v0v1[2] * pvec[2];
+        const float invDet = 1.0f / det;
+
+        const float u
+          = (tvec[0] * pvec[0] + tvec[1] * pvec[1] + tvec[2] * pvec[2])
+            * invDet;
+        const float v
+          = (dir[0] * qvec[0] + dir[1] * qvec[1] + dir[2] * qvec[2]) * invDet;
+        const float t
+          = (v0v2[0] * qvec[0] + v0v2[1] * qvec[1] + v0v2[2] * qvec[2])
+            * invDet;
+
+        if((det <= -kEpsilon || det >= kEpsilon) && u >= 0.0f && u <= 1.0f
+           && v >= 0.0f && u + v <= 1.0f && t > 0.0f
+           && t < packet.distance[k]) {
+          packet.distance[k] = t;
+          packet.u[k] = u;
+          packet.v[k] = v;
+          packet.triangleIndex[k] = triIdx;
+        }
+      }
     }
 
   private:
-    Node *nodes;
+    std::vector<Node> nodes;
+    // triangles in leaf order: original index, first vertex and two edges
+    std::vector<int> triangleIds;
+    std::vector<float> triangleData;
+
     float findCentroid(const float &v1, const float &v2, const float &v3) {
       return (v1 + v2 + v3) / 3;
     }
@@ -3,7 +3,7 @@
 /// \authors Rosty Hnatyshyn <rostyslav.hnatyshyn@gmail.com>
 /// \date 10.11.2020
 ///
-/// \brief Data structure for a ray.
+/// \brief Data structure for a ray (and a packet of rays).
 
 #pragma once
 
@@ -23,4 +23,21 @@ namespace ttk {
     float u;
     float v;
   };
+
+  /**
+   * @brief Packet of N coherent rays traversed together (structure of
+   * arrays)
+   *
+   * The hit distance, barycentric coordinates and triangle index (-1 if
+   * no hit) are filled by BoundingVolumeHierarchy::intersect.
+   */
+  template <int N>
+  struct RayPacket {
+    float origin[3][N]{};
+    float direction[3][N]{};
+    float distance[N]{};
+    float u[N]{};
+    float v[N]{};
+    int triangleIndex[N]{};
+  };
 } // namespace ttk
\ No newline at end of file
@@ -5,7 +5,7 @@
 /// \date 10.11.2020
 ///
 /// \brief Native renderer that uses a bounding volume hierarchy for accelerated
-/// raycasting.
+/// raycasting. Rays of consecutive pixels are traced by packets.
 
 #pragma once
 
@@ -115,7 +115,29 @@ int ttk::CinemaImagingNative::renderImage(
                             camPos[2] - camRight[2] * camWidthWorldHalf
                               - camUpTrue[2] * camHeightWorldHalf};
 
-  float nan = std::numeric_limits<float>::quiet_NaN();
+  // rays of consecutive pixels of a row are traced together
+  constexpr int packetSize = 8;
+
+  // write the hits of a packet of rays into the output buffers
+  const auto storeHits = [&](const RayPacket<packetSize> &packet,
+                             size_t pixelIndex, const int nRays) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for(int k = 0; k < nRays; k++, pixelIndex++) {
+      const size_t bcIndex = 2 * pixelIndex;
+      if(packet.triangleIndex[k] != -1) {
+        depthBuffer[pixelIndex] = packet.distance[k];
+        primitiveIds[pixelIndex] = packet.triangleIndex[k];
+        barycentricCoordinates[bcIndex] = packet.u[k];
+        barycentricCoordinates[bcIndex + 1] = packet.v[k];
+      } else {
+        depthBuffer[pixelIndex] = nan;
+        primitiveIds[pixelIndex] = CinemaImaging::INVALID_ID;
+        barycentricCoordinates[bcIndex] = nan;
+        barycentricCoordinates[bcIndex + 1] = nan;
+      }
+    }
+  };
+
   if(orthographicProjection) {
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(this->threadNumber_)
@@ -123,45 +145,28 @@ int ttk::CinemaImagingNative::renderImage(
     for(int y = 0; y < resY; y++) {
       double v = ((double)y) * pixelHeightWorld;
 
-      size_t pixelIndex = y * resX;
-      size_t bcIndex = 2 * pixelIndex;
+      RayPacket<packetSize> packet;
 
-      for(int x = 0; x < resX; x++) {
-        double u = ((double)x) * pixelWidthWorld;
+      for(int x0 = 0; x0 < resX; x0 += packetSize) {
+        const int nRays = std::min(packetSize, resX - x0);
 
-        depthBuffer[pixelIndex] = nan;
-        primitiveIds[pixelIndex] = CinemaImaging::INVALID_ID;
-        barycentricCoordinates[bcIndex] = nan;
-        barycentricCoordinates[bcIndex + 1] = nan;
+        for(int k = 0; k < packetSize; k++) {
+          // pad the last packet of the row with its last ray
+          const int x = x0 + std::min(k, nRays - 1);
+          double u = ((double)x) * pixelWidthWorld;
+
+          // set origin
+          for(int i = 0; i < 3; i++)
+            packet.origin[i][k]
+              = camPosCorner[i] + u * camRight[i] + v * camUpTrue[i];
 
-        // set origin
-        float org_x = camPosCorner[0] + u * camRight[0] + v * camUpTrue[0];
-        float org_y = camPosCorner[1] + u * camRight[1] + v * camUpTrue[1];
-        float org_z = camPosCorner[2] + u * camRight[2] + v * camUpTrue[2];
-
-        float ray_origin[3] = {org_x, org_y, org_z};
-
-        // set dir
-        float dir_x = camDir[0];
-        float dir_y = camDir[1];
-        float dir_z = camDir[2];
-
-        float ray_dir[3] = {dir_x, dir_y, dir_z};
-
-        Ray ray(ray_dir, ray_origin);
-        bool wasHit = false;
-        int triIdx;
-        float distance;
-        wasHit = bvh.intersect(
-          ray, connectivityList, vertexCoords, &triIdx, &distance);
-        if(wasHit) {
-          depthBuffer[pixelIndex] = distance;
-          primitiveIds[pixelIndex] = triIdx;
-          barycentricCoordinates[bcIndex] = ray.u;
-          barycentricCoordinates[bcIndex + 1] = ray.v;
+          // set dir
+          for(int i = 0; i < 3; i++)
+            packet.direction[i][k] = camDir[i];
         }
-        pixelIndex++;
-        bcIndex += 2;
+
+        bvh.intersect(packet);
+        storeHits(packet, (size_t)y * resX + x0, nRays);
       }
     }
   } else {
@@ -172,44 +177,29 @@ int ttk::CinemaImagingNative::renderImage(
 #endif
     for(int y = 0; y < resY; y++) {
       double v = (y - resY * 0.5) * factor;
-      size_t pixelIndex = y * resX;
-      size_t bcIndex = 2 * pixelIndex;
 
-      for(int x = 0; x < resX; x++) {
-        double u = (x - resX * 0.5) * factor;
+      RayPacket<packetSize> packet;
 
-        depthBuffer[pixelIndex] = nan;
-        primitiveIds[pixelIndex] = CinemaImaging::INVALID_ID;
-        barycentricCoordinates[bcIndex] = nan;
-        barycentricCoordinates[bcIndex + 1] = nan;
+      for(int x0 = 0; x0 < resX; x0 += packetSize) {
+        const int nRays = std::min(packetSize, resX - x0);
+
+        for(int k = 0; k < packetSize; k++) {
+          // pad the last packet of the row with its last ray
+          const int x = x0 + std::min(k, nRays - 1);
+          double u = (x - resX * 0.5) * factor;
 
-        // set origin
-        float org_x = camPos[0];
-        float org_y = camPos[1];
-        float org_z = camPos[2];
-
-        float ray_origin[3] = {org_x, org_y, org_z};
-        // set dir
-        float dir_x = camDir[0] + u * camRight[0] + v * camUpTrue[0];
-        float dir_y = camDir[1] + u * camRight[1] + v * camUpTrue[1];
-        float dir_z = camDir[2] + u * camRight[2] + v * camUpTrue[2];
-
-        float ray_dir[3] = {dir_x, dir_y, dir_z};
-
-        Ray ray(ray_dir, ray_origin);
-        bool wasHit = false;
-        int triIdx;
-        float distance;
-        wasHit = bvh.intersect(
-          ray, connectivityList, vertexCoords, &triIdx, &distance);
-        if(wasHit) {
-          depthBuffer[pixelIndex] = distance;
-          primitiveIds[pixelIndex] = triIdx;
-          barycentricCoordinates[bcIndex] = ray.u;
-          barycentricCoordinates[bcIndex + 1] = ray.v;
+          // set origin
+          for(int i = 0; i < 3; i++)
+            packet.origin[i][k] = camPos[i];
+
+          // set dir
+          for(int i = 0; i < 3; i++)
+            packet.direction[i][k]
+              = camDir[i] + u * camRight[i] + v * camUpTrue[i];
         }
-        pixelIndex++;
-        bcIndex += 2;
+
+        bvh.intersect(packet);
+        storeHits(packet, (size_t)y * resX + x0, nRays);
       }
     }
   }
@@ -1,25 +1,467 @@
 #include <CinemaQuery.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #if TTK_ENABLE_SQLITE3
 #include <sqlite3.h>
 #endif
 
+namespace {
+
+  // ===========================================================================
+  // Tokenizer of the natively supported SQL subset
+  struct Token {
+    enum Type { IDENTIFIER, QUOTED_IDENTIFIER, NUMBER, STRING, SYMBOL, END };
+    Type type;
+    std::string text;
+  };
+
+  // returns false on any character outside of the supported subset
+  bool tokenize(const std::string &sql, std::vector<Token> &tokens) {
+    const size_t n = sql.size();
+    size_t i = 0;
+    while(i < n) {
+      const char c = sql[i];
+      if(std::isspace(static_cast<unsigned char>(c))) {
+        ++i;
+      } else if(c == '-' && i + 1 < n && sql[i + 1] == '-') {
+        // comment
+        while(i < n && sql[i] != '\n')
+          ++i;
+      } else if(std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+        const size_t start = i;
+        while(i < n
+              && (std::isalnum(static_cast<unsigned char>(sql[i]))
+                  || sql[i] == '_'))
+          ++i;
+        tokens.push_back({Token::IDENTIFIER, sql.substr(start, i - start)});
+      } else if(std::isdigit(static_cast<unsigned char>(c))
+                || (c == '.' && i + 1 < n
+                    && std::isdigit(static_cast<unsigned char>(sql[i + 1])))) {
+        const size_t start = i;
+        while(i < n && std::isdigit(static_cast<unsigned char>(sql[i])))
+          ++i;
+        if(i < n && sql[i] == '.') {
+          ++i;
+          while(i < n && std::isdigit(static_cast<unsigned char>(sql[i])))
+            ++i;
+        }
+        if(i < n && (sql[i] == 'e' || sql[i] == 'E')) {
+          ++i;
+          if(i < n && (sql[i] == '+' || sql[i] == '-'))
+            ++i;
+          if(i >= n || !std::isdigit(static_cast<unsigned char>(sql[i])))
+            return false;
+          while(i < n && std::isdigit(static_cast<unsigned char>(sql[i])))
+            ++i;
+        }
+        if(i < n
+           && (std::isalpha(static_cast<unsigned char>(sql[i]))
+               || sql[i] == '_'))
+          return false;
+        tokens.push_back({Token::NUMBER, sql.substr(start, i - start)});
+      } else if(c == '\'' || c == '"' || c == '`' || c == '[') {
+        // quoted string or identifier, doubled quotes are escaped quotes
+        const char close = c == '[' ? ']' : c;
+        std::string text;
+        ++i;
+        while(true) {
+          if(i >= n)
+            return false;
+          if(sql[i] == close) {
+            if(close != ']' && i + 1 < n && sql[i + 1] == close) {
+              text += close;
+              i += 2;
+              continue;
+            }
+            ++i;
+            break;
+          }
+          text += sql[i++];
+        }
+        tokens.push_back(
+          {c == '\'' ? Token::STRING : Token::QUOTED_IDENTIFIER, text});
+      } else {
+        const std::string two = sql.substr(i, 2);
+        if(two == "==" || two == "!=" || two == "<>" || two == "<="
+           || two == ">=") {
+          tokens.push_back({Token::SYMBOL, two});
+          i += 2;
+        } else if(std::strchr("*,=<>;-+", c) != nullptr) {
+          tokens.push_back({Token::SYMBOL, std::string(1, c)});
+          ++i;
+        } else {
+          return false;
+        }
+      }
+    }
+    tokens.push_back({Token::END, ""});
+    return true;
+  }
+
+  // ===========================================================================
+  // Parsed query
+  enum class Operator { EQ, NE, LT, LE, GT, GE };
+
+  struct Predicate {
+    size_t column;
+    Operator op;
+    double number;
+    std::string text;
+  };
+
+  struct NativeQuery {
+    size_t table{};
+    std::vector<size_t> columns{};
+    std::vector<std::string> names{};
+    std::vector<Predicate> predicates{};
+    int orderColumn{-1};
+    bool descending{false};
+    long long limit{-1};
+  };
+
+  class Parser {
+  public:
+    Parser(const std::vector<Token> &tokens,
+           const std::vector<ttk::CinemaTable> &tables)
+      : tokens_(tokens), tables_(tables) {
+    }
+
+    // returns false if the query is outside of the supported subset
+    bool parse(NativeQuery &query) {
+      if(!this->keyword("SELECT"))
+        return false;
+
+      // projection (resolved once the table is known)
+      bool selectAll = false;
+      std::vector<Token> projection;
+      if(this->symbol("*")) {
+        selectAll = true;
+      } else {
+        do {
+          if(!this->isIdentifier())
+            return false;
+          projection.emplace_back(this->tokens_[this->pos_++]);
+        } while(this->symbol(","));
+      }
+
+      if(!this->keyword("FROM") || !this->table(query.table))
+        return false;
+      const auto &table = this->tables_[query.table];
+
+      if(selectAll) {
+        for(size_t j = 0; j < table.getNumberOfColumns(); ++j) {
+          query.columns.emplace_back(j);
+          query.names.emplace_back(table.getColumn(j).name);
+        }
+      } else {
+        for(const auto &token : projection) {
+          const int j = table.getColumnId(token.text);
+          if(j < 0)
+            return false;
+          query.columns.emplace_back(j);
+          query.names.emplace_back(table.getColumn(j).name);
+        }
+      }
+
+      if(this->keyword("WHERE")) {
+        do {
+          if(!this->predicate(table, query.predicates))
+            return false;
+        } while(this->keyword("AND"));
+      }
+
+      if(this->keyword("ORDER")) {
+        size_t j{};
+        if(!this->keyword("BY") || !this->column(table, j))
+          return false;
+        query.orderColumn = j;
+        if(this->keyword("DESC"))
+          query.descending = true;
+        else
+          this->keyword("ASC");
+      }
+
+      if(this->keyword("LIMIT")) {
+        const auto &token = this->tokens_[this->pos_];
+        if(token.type != Token::NUMBER
+           || token.text.find_first_not_of("0123456789") != std::string::npos)
+          return false;
+        query.limit = std::strtoll(token.text.data(), nullptr, 10);
+        ++this->pos_;
+      }
+
+      this->symbol(";");
+      return this->tokens_[this->pos_].type == Token::END;
+    }
+
+  protected:
+    bool isIdentifier() const {
+      const auto type = this->tokens_[this->pos_].type;
+      return type == Token::IDENTIFIER || type == Token::QUOTED_IDENTIFIER;
+    }
+
+    bool keyword(const char *word) {
+      const auto &token = this->tokens_[this->pos_];
+      if(token.type != Token::IDENTIFIER
+         || token.text.size() != std::strlen(word))
+        return false;
+      for(size_t i = 0; i < token.text.size(); ++i)
+        if(std::toupper(static_cast<unsigned char>(token.text[i])) != word[i])
+          return false;
+      ++this->pos_;
+      return true;
+    }
+
+    bool symbol(const char *s) {
+      const auto &token = this->tokens_[this->pos_];
+      if(token.type != Token::SYMBOL || token.text != s)
+        return false;
+      ++this->pos_;
+      return true;
+    }
+
+    bool table(size_t &id) {
+      if(this->tokens_[this->pos_].type != Token::IDENTIFIER)
+        return false;
+      const auto &name = this->tokens_[this->pos_].text;
+      const std::string prefix = "inputtable";
+      if(name.size() <= prefix.size())
+        return false;
+      for(size_t i = 0; i < prefix.size(); ++i)
+        if(std::tolower(static_cast<unsigned char>(name[i])) != prefix[i])
+          return false;
+      const auto digits = name.substr(prefix.size());
+      if(digits.find_first_not_of("0123456789") != std::string::npos
+         || digits.size() > 9)
+        return false;
+      id = std::strtoul(digits.data(), nullptr, 10);
+      if(id >= this->tables_.size())
+        return false;
+      ++this->pos_;
+      return true;
+    }
+
+    bool column(const ttk::CinemaTable &table, size_t &id) {
+      if(!this->isIdentifier())
+        return false;
+      const int j = table.getColumnId(this->tokens_[this->pos_].text);
+      if(j < 0)
+        return false;
+      id = j;
+      ++this->pos_;
+      return true;
+    }
+
+    // literal of the same type as the column (no affinity conversions)
+    bool literal(const ttk::CinemaTable::Column &column, Predicate &p) {
+      if(column.isNumeric) {
+        bool negative = false;
+        if(this->symbol("-"))
+          negative = true;
+        else
+          this->symbol("+");
+        const auto &token = this->tokens_[this->pos_];
+        if(token.type != Token::NUMBER)
+          return false;
+        p.number = std::strtod(token.text.data(), nullptr);
+        if(negative)
+          p.number = -p.number;
+      } else {
+        const auto &token = this->tokens_[this->pos_];
+        if(token.type != Token::STRING)
+          return false;
+        p.text = token.text;
+      }
+      ++this->pos_;
+      return true;
+    }
+
+    bool predicate(const ttk::CinemaTable &table,
+                   std::vector<Predicate> &predicates) {
+      Predicate p{};
+      if(!this->column(table, p.column))
+        return false;
+      const auto &column = table.getColumn(p.column);
+
+      if(this->keyword("BETWEEN")) {
+        Predicate upper = p;
+        p.op = Operator::GE;
+        upper.op = Operator::LE;
+        if(!this->literal(column, p) || !this->keyword("AND")
+           || !this->literal(column, upper))
+          return false;
+        predicates.emplace_back(p);
+        predicates.emplace_back(upper);
+        return true;
+      }
+
+      if(this->symbol("=") || this->symbol("=="))
+        p.op = Operator::EQ;
+      else if(this->symbol("!=") || this->symbol("<>"))
+        p.op = Operator::NE;
+      else if(this->symbol("<"))
+        p.op = Operator::LT;
+      else if(this->symbol("<="))
+        p.op = Operator::LE;
+      else if(this->symbol(">"))
+        p.op = Operator::GT;
+      else if(this->symbol(">="))
+        p.op = Operator::GE;
+      else
+        return false;
+
+      if(!this->literal(column, p))
+        return false;
+      predicates.emplace_back(p);
+      return true;
+    }
+
+    const std::vector<Token> &tokens_;
+    const std::vector<ttk::CinemaTable> &tables_;
+    size_t pos_{0};
+  };
+
+  // ===========================================================================
+  // Evaluation
+
+  // sign of (value of the row - value of the predicate), NaN values
+  // come first as in the column orders
+  inline int compare(const ttk::CinemaTable::Column &column,
+                     const Predicate &p,
+                     const size_t row) {
+    if(column.isNumeric) {
+      const double v = column.values[row];
+      if(std::isnan(v)) {
+        return -1;
+      }
+      return v < p.number ? -1 : (p.number < v ? 1 : 0);
+    }
+    return column.compareText(row, p.text.data(), p.text.size());
+  }
+
+  inline bool matches(const ttk::CinemaTable::Column &column,
+                      const Predicate &p,
+                      const size_t row) {
+    // NaN values are stored as NULL by SQLite: no predicate holds
+    if(column.isNumeric && std::isnan(column.values[row])) {
+      return false;
+    }
+    const int cmp = compare(column, p, row);
+    switch(p.op) {
+      case Operator::EQ:
+        return cmp == 0;
+      case Operator::NE:
+        return cmp != 0;
+      case Operator::LT:
+        return cmp < 0;
+      case Operator::LE:
+        return cmp <= 0;
+      case Operator::GT:
+        return cmp > 0;
+      case Operator::GE:
+        return cmp >= 0;
+    }
+    return false;
+  }
+
+  // first position of the column order whose value is larger than (or
+  // equal to if orEqual) the predicate value
+  size_t bound(const ttk::CinemaTable::Column &column,
+               const size_t n,
+               const Predicate &p,
+               const bool orEqual) {
+    size_t lo = 0, hi = n;
+    while(lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      const int cmp = compare(column, p, column.order[mid]);
+      if(cmp < 0 || (!orEqual && cmp == 0))
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return lo;
+  }
+
+  // positions [begin, end) of the column order satisfying the predicate
+  void orderRange(const ttk::CinemaTable::Column &column,
+                  const size_t n,
+                  const Predicate &p,
+                  size_t &begin,
+                  size_t &end) {
+    begin = 0;
+    end = n;
+    if(column.isNumeric) {
+      // skip the NaN values, at the beginning of the order
+      size_t lo = 0, hi = n;
+      while(lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if(std::isnan(column.values[column.order[mid]]))
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      begin = lo;
+    }
+    switch(p.op) {
+      case Operator::EQ:
+        begin = std::max(begin, bound(column, n, p, true));
+        end = bound(column, n, p, false);
+        break;
+      case Operator::LT:
+        end = bound(column, n, p, true);
+        break;
+      case Operator::LE:
+        end = bound(column, n, p, false);
+        break;
+      case Operator::GT:
+        begin = std::max(begin, bound(column, n, p, false));
+        break;
+      case Operator::GE:
+        begin = std::max(begin, bound(column, n, p, true));
+        break;
+      case Operator::NE:
+        break;
+    }
+  }
+
+  // same output format as sqlite3_column_text for REAL values
+  void formatReal(const double value, std::string &out) {
+    char buffer[40];
+    const int length = std::snprintf(buffer, 32, "%.15g", value);
+    const char *exponent = std::strchr(buffer, 'e');
+    if(std::strpbrk(buffer, ".n") != nullptr) {
+      out.append(buffer, length);
+    } else if(exponent != nullptr) {
+      out.append(buffer, exponent - buffer);
+      out += ".0";
+      out += exponent;
+    } else {
+      out.append(buffer, length);
+      out += ".0";
+    }
+  }
+
+} // namespace
+
 ttk::CinemaQuery::CinemaQuery() {
   this->setDebugMsgPrefix("CinemaQuery");
 }
 ttk::CinemaQuery::~CinemaQuery() {
 }
 
-int ttk::CinemaQuery::execute(
-  const std::vector<std::string> &sqlTableDefinitions,
-  const std::vector<std::string> &sqlInsertStatements,
-  const std::string &sqlQuery,
-  std::stringstream &resultCSV,
-  int &csvNColumns,
-  int &csvNRows) const {
+int ttk::CinemaQuery::execute(const std::vector<CinemaTable> &tables,
+                              const std::string &sqlQuery,
+                              std::stringstream &resultCSV,
+                              int &csvNColumns,
+                              int &csvNRows) const {
 
-#if TTK_ENABLE_SQLITE3
   // print input
   {
     std::vector<std::string> sqlLines;
@@ -34,6 +476,183 @@ int ttk::CinemaQuery::execute(
     this->printMsg(ttk::debug::Separator::L1);
   }
 
+  const int status
+    = this->executeNative(tables, sqlQuery, resultCSV, csvNColumns, csvNRows);
+  if(status != -1)
+    return status;
+
+  this->printMsg("Statement not supported natively, using SQLite3",
+                 ttk::debug::Priority::DETAIL);
+  return this->executeSQLite(
+    tables, sqlQuery, resultCSV, csvNColumns, csvNRows);
+}
+
+int ttk::CinemaQuery::executeNative(const std::vector<CinemaTable> &tables,
+                                    const std::string &sqlQuery,
+                                    std::stringstream &resultCSV,
+                                    int &csvNColumns,
+                                    int &csvNRows) const {
+
+  NativeQuery query;
+  {
+    std::vector<Token> tokens;
+    if(!tokenize(sqlQuery, tokens))
+      return -1;
+    Parser parser(tokens, tables);
+    if(!parser.parse(query))
+      return -1;
+  }
+
+  this->printMsg("Querying table", 0, ttk::debug::LineMode::REPLACE);
+  Timer timer;
+
+  const auto &table = tables[query.table];
+  const size_t n = table.getNumberOfRows();
+  const size_t limit = query.limit < 0 ? n : query.limit;
+
+  // among the columns with a sort order, find the predicates that select
+  // the smallest range of the order
+  int rangeColumn = -1;
+  size_t rangeBegin = 0, rangeEnd = n;
+  for(const auto &p : query.predicates) {
+    const auto &column = table.getColumn(p.column);
+    if(column.order == nullptr || p.op == Operator::NE)
+      continue;
+    size_t begin = 0, end = n;
+    for(const auto &q : query.predicates) {
+      if(q.column == p.column && q.op != Operator::NE) {
+        size_t b{}, e{};
+        orderRange(column, n, q, b, e);
+        begin = std::max(begin, b);
+        end = std::min(end, e);
+      }
+    }
+    end = std::max(begin, end);
+    if(rangeColumn == -1 || end - begin < rangeEnd - rangeBegin) {
+      rangeColumn = p.column;
+      rangeBegin = begin;
+      rangeEnd = end;
+    }
+  }
+
+  // predicates that still have to be tested on every candidate
+  std::vector<const Predicate *> filters;
+  for(const auto &p : query.predicates) {
+    if((int)p.column != rangeColumn || p.op == Operator::NE)
+      filters.emplace_back(&p);
+  }
+  const auto accept = [&table, &filters](const size_t row) {
+    for(const auto p : filters)
+      if(!matches(table.getColumn(p->column), *p, row))
+        return false;
+    return true;
+  };
+
+  // candidate positions: a range of a column order or all the rows
+  const uint32_t *order = nullptr;
+  if(rangeColumn != -1) {
+    order = table.getColumn(rangeColumn).order;
+  } else if(query.orderColumn != -1) {
+    order = table.getColumn(query.orderColumn).order;
+  }
+
+  std::vector<uint32_t> rows;
+  if(order != nullptr
+     && (query.orderColumn == -1 || query.orderColumn == rangeColumn
+         || rangeColumn == -1)) {
+    if(query.orderColumn == -1) {
+      // back to the row order
+      for(size_t i = rangeBegin; i < rangeEnd; ++i)
+        if(accept(order[i]))
+          rows.emplace_back(order[i]);
+      std::sort(rows.begin(), rows.end());
+      if(rows.size() > limit)
+        rows.resize(limit);
+    } else if(!query.descending) {
+      // already sorted
+      for(size_t i = rangeBegin; i < rangeEnd && rows.size() < limit; ++i)
+        if(accept(order[i]))
+          rows.emplace_back(order[i]);
+    } else {
+      // reversed order, equal values stay in row order
+      const auto &column = table.getColumn(query.orderColumn);
+      size_t end = rangeEnd;
+      while(end > rangeBegin && rows.size() < limit) {
+        size_t begin = end - 1;
+        while(begin > rangeBegin
+              && column.compareRows(order[begin - 1], order[end - 1]) == 0)
+          --begin;
+        for(size_t i = begin; i < end && rows.size() < limit; ++i)
+          if(accept(order[i]))
+            rows.emplace_back(order[i]);
+        end = begin;
+      }
+    }
+  } else {
+    if(order != nullptr) {
+      for(size_t i = rangeBegin; i < rangeEnd; ++i)
+        if(accept(order[i]))
+          rows.emplace_back(order[i]);
+      std::sort(rows.begin(), rows.end());
+    } else {
+      for(size_t row = 0; row < n; ++row)
+        if(accept(row))
+          rows.emplace_back(row);
+    }
+    if(query.orderColumn != -1) {
+      const auto &column = table.getColumn(query.orderColumn);
+      const int sign = query.descending ? -1 : 1;
+      std::stable_sort(rows.begin(), rows.end(),
+                       [&column, sign](const uint32_t a, const uint32_t b) {
+                         return sign * column.compareRows(a, b) < 0;
+                       });
+    }
+    if(rows.size() > limit)
+      rows.resize(limit);
+  }
+
+  // write the CSV result
+  csvNColumns = query.columns.size();
+  if(csvNColumns < 1) {
+    this->printErr("Query result has no columns.");
+    return 0;
+  }
+  {
+    std::string line;
+    for(int j = 0; j < csvNColumns; ++j) {
+      line += (j > 0 ? "," : "") + query.names[j];
+    }
+    resultCSV << line << "\n";
+
+    for(const auto row : rows) {
+      line.clear();
+      for(int j = 0; j < csvNColumns; ++j) {
+        if(j > 0)
+          line += ',';
+        const auto &column = table.getColumn(query.columns[j]);
+        if(column.isNumeric)
+          formatReal(column.values[row], line);
+        else
+          line.append(column.getText(row), column.getTextLength(row));
+      }
+      line += '\n';
+      resultCSV << line;
+    }
+    csvNRows += rows.size();
+  }
+
+  this->printMsg("Querying table", 1, timer.getElapsedTime());
+
+  return 1;
+}
+
+int ttk::CinemaQuery::executeSQLite(const std::vector<CinemaTable> &tables,
+                                    const std::string &sqlQuery,
+                                    std::stringstream &resultCSV,
+                                    int &csvNColumns,
+                                    int &csvNRows) const {
+
+#if TTK_ENABLE_SQLITE3
   // SQLite Variables
   sqlite3 *db;
   char *zErrMsg = 0;
@@ -52,8 +671,27 @@ int ttk::CinemaQuery::execute(
       return 0;
     }
 
-    // Create table
-    for(auto &sqlTableDefinition : sqlTableDefinitions) {
+    for(size_t i = 0; i < tables.size(); i++) {
+      const auto &table = tables[i];
+      const size_t nc = table.getNumberOfColumns();
+      const size_t nr = table.getNumberOfRows();
+      const std::string tableName = "InputTable" + std::to_string(i);
+
+      // Create table
+      std::string sqlTableDefinition = "CREATE TABLE " + tableName + " (";
+      std::string sqlInsertStatement = "INSERT INTO " + tableName + " VALUES (";
+      for(size_t j = 0; j < nc; j++) {
+        const auto &column = table.getColumn(j);
+        std::string name;
+        for(const auto c : column.name)
+          name += c == '"' ? std::string{"\"\""} : std::string{c};
+        sqlTableDefinition += (j > 0 ? ",\"" : "\"") + name + "\" "
+                              + (column.isNumeric ? "REAL" : "TEXT");
+        sqlInsertStatement += j > 0 ? ",?" : "?";
+      }
+      sqlTableDefinition += ")";
+      sqlInsertStatement += ")";
+
       rc = sqlite3_exec(db, sqlTableDefinition.data(), nullptr, 0, &zErrMsg);
       if(rc != SQLITE_OK) {
         this->printErr("Create table: " + std::string{zErrMsg});
@@ -63,15 +701,37 @@ int ttk::CinemaQuery::execute(
 
         return 0;
       }
-    }
 
-    // Fill table
-    for(auto &sqlInsertStatement : sqlInsertStatements) {
-      rc = sqlite3_exec(db, sqlInsertStatement.data(), nullptr, 0, &zErrMsg);
+      // Fill table with a prepared statement in a single transaction
+      sqlite3_stmt *insertStatement;
+      rc = sqlite3_exec(db, "BEGIN TRANSACTION", nullptr, 0, nullptr);
+      if(rc == SQLITE_OK)
+        rc = sqlite3_prepare_v2(
+          db, sqlInsertStatement.data(), -1, &insertStatement, NULL);
       if(rc != SQLITE_OK) {
-        this->printErr("Insert values: " + std::string{zErrMsg});
+        this->printErr("Insert values: " + std::string{sqlite3_errmsg(db)});
+
+        sqlite3_close(db);
+        return 0;
+      }
+      for(size_t r = 0; r < nr && rc == SQLITE_OK; r++) {
+        for(size_t j = 0; j < nc; j++) {
+          const auto &column = table.getColumn(j);
+          if(column.isNumeric)
+            sqlite3_bind_double(insertStatement, j + 1, column.values[r]);
+          else
+            sqlite3_bind_text(insertStatement, j + 1, column.getText(r),
+                              column.getTextLength(r), SQLITE_STATIC);
+        }
+        rc = sqlite3_step(insertStatement);
+        rc = rc == SQLITE_DONE ? sqlite3_reset(insertStatement) : rc;
+      }
+      sqlite3_finalize(insertStatement);
+      if(rc == SQLITE_OK)
+        rc = sqlite3_exec(db, "COMMIT", nullptr, 0, nullptr);
+      if(rc != SQLITE_OK) {
+        this->printErr("Insert values: " + std::string{sqlite3_errmsg(db)});
 
-        sqlite3_free(zErrMsg);
         sqlite3_close(db);
         return 0;
       }
@@ -101,6 +761,7 @@ int ttk::CinemaQuery::execute(
       if(csvNColumns < 1) {
         this->printErr("Query result has no columns.");
 
+        sqlite3_finalize(sqlStatement);
         sqlite3_close(db);
         return 0;
       }
@@ -126,6 +787,7 @@ int ttk::CinemaQuery::execute(
       if(rc != SQLITE_DONE) {
         this->printErr("Fetching result: " + std::string{sqlite3_errmsg(db)});
 
+        sqlite3_finalize(sqlStatement);
         sqlite3_close(db);
         return 0;
       } else {
@@ -156,7 +818,7 @@ int ttk::CinemaQuery::execute(
   return 1;
 
 #else
-  this->printErr("This filter requires Sqlite3");
+  this->printErr("This query requires Sqlite3");
   return 0;
 #endif
 }
@@ -5,13 +5,27 @@
 ///
 /// \brief TTK %cinemaQuery processing package.
 ///
-/// %CinemaQuery is a TTK processing package that generates a temporary SQLite3
-/// Database to perform a SQL query which is returned as a CSV String
+/// %CinemaQuery is a TTK processing package that performs a SQL query on
+/// columnar tables (see ttk::CinemaTable) and returns the result as a CSV
+/// String.
+///
+/// Simple queries of the form
+///
+///   SELECT * | column, ... FROM InputTable<i>
+///   [WHERE column op value [AND ...]]
+///   [ORDER BY column [ASC | DESC]] [LIMIT n]
+///
+/// (op being one of =, ==, !=, <>, <, <=, >, >= or BETWEEN) are evaluated
+/// natively, using the column orders of the tables when available. Any
+/// other statement is run by a temporary SQLite3 database.
 
 #pragma once
 
 // base code includes
+#include <CinemaTable.h>
 #include <Debug.h>
+
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -21,14 +35,32 @@ namespace ttk {
     CinemaQuery();
     ~CinemaQuery();
 
-    /** Creates a temporary database based on a SQL table definition and
-     *  and table content to subsequentually return a query result.
+    /** Evaluates a SQL query on the tables InputTable0, InputTable1, ...
+     *  natively if possible, otherwise on a temporary SQLite3 database.
      */
-    int execute(const std::vector<std::string> &sqlTableDefinitions,
-                const std::vector<std::string> &sqlInsertStatements,
+    int execute(const std::vector<CinemaTable> &tables,
                 const std::string &sqlQuery,
                 std::stringstream &resultCSV,
                 int &csvNColumns,
                 int &csvNRows) const;
+
+  protected:
+    /** Evaluates the query without SQLite3. Returns -1 if the query is not
+     * supported by the native evaluator.
+     */
+    int executeNative(const std::vector<CinemaTable> &tables,
+                      const std::string &sqlQuery,
+                      std::stringstream &resultCSV,
+                      int &csvNColumns,
+                      int &csvNRows) const;
+
+    /** Creates a temporary database filled with the tables to
+     *  subsequentually return a query result.
+     */
+    int executeSQLite(const std::vector<CinemaTable> &tables,
+                      const std::string &sqlQuery,
+                      std::stringstream &resultCSV,
+                      int &csvNColumns,
+                      int &csvNRows) const;
   };
-} // namespace ttk
\ No newline at end of file
+} // namespace ttk
@@ -0,0 +1,356 @@
+#include <CinemaTable.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+  // index file layout: the header, then for every column its descriptor,
+  // its name and its data. Every block is padded to 8 bytes so that the
+  // mapped arrays are aligned.
+  const char indexMagic[8] = {'T', 'T', 'K', 'C', 'Q', 'I', 'D', 'X'};
+  const uint64_t indexVersion = 2;
+
+  inline size_t paddedSize(const size_t size) {
+    return (size + 7) & ~static_cast<size_t>(7);
+  }
+
+  void writeBlock(std::ofstream &stream, const void *data, const size_t size) {
+    const char padding[8] = {};
+    stream.write(static_cast<const char *>(data), size);
+    stream.write(padding, paddedSize(size) - size);
+  }
+
+  // sequential reader over the mapped file, with bounds checks
+  struct BlockReader {
+    const char *data;
+    size_t size;
+    size_t position;
+
+    const char *next(const size_t blockSize) {
+      const size_t padded = paddedSize(blockSize);
+      if(padded < blockSize || padded > this->size - this->position) {
+        return nullptr;
+      }
+      const char *block = this->data + this->position;
+      this->position += padded;
+      return block;
+    }
+
+    bool nextUInt(uint64_t &value) {
+      const char *block = this->next(sizeof(uint64_t));
+      if(block == nullptr) {
+        return false;
+      }
+      std::memcpy(&value, block, sizeof(uint64_t));
+      return true;
+    }
+  };
+
+} // namespace
+
+int ttk::CinemaTable::Column::compareText(const size_t row,
+                                          const char *str,
+                                          const size_t length) const {
+  const size_t rowLength = this->getTextLength(row);
+  const int cmp
+    = std::memcmp(this->getText(row), str, std::min(rowLength, length));
+  if(cmp != 0) {
+    return cmp;
+  }
+  return rowLength < length ? -1 : (rowLength > length ? 1 : 0);
+}
+
+int ttk::CinemaTable::Column::compareRows(const size_t row0,
+                                          const size_t row1) const {
+  if(this->isNumeric) {
+    const double v0 = this->values[row0];
+    const double v1 = this->values[row1];
+    return lessNumeric(v0, v1) ? -1 : (lessNumeric(v1, v0) ? 1 : 0);
+  }
+  return this->compareText(
+    row0, this->getText(row1), this->getTextLength(row1));
+}
+
+uint64_t ttk::CinemaTable::hashBytes(const void *data,
+                                     const size_t size,
+                                     const uint64_t seed) {
+  // 8 bytes at a time, mixed with the 64-bit finalizer of MurmurHash3
+  const auto mix = [](uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  };
+  const char *bytes = static_cast<const char *>(data);
+  uint64_t h = mix(seed ^ size);
+  size_t i = 0;
+  for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(uint64_t));
+    h = mix(h ^ word) + i;
+  }
+  uint64_t tail{};
+  if(i < size) {
+    std::memcpy(&tail, bytes + i, size - i);
+  }
+  return mix(h ^ tail);
+}
+
+int ttk::CinemaTable::getColumnId(const std::string &name) const {
+  for(size_t i = 0; i < this->columns_.size(); ++i) {
+    const auto &columnName = this->columns_[i].name;
+    if(columnName.size() == name.size()
+       && std::equal(name.begin(), name.end(), columnName.begin(),
+                     [](const char a, const char b) {
+                       return std::tolower(a) == std::tolower(b);
+                     })) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void ttk::CinemaTable::reset(const size_t nRows) {
+  this->nRows_ = nRows;
+  this->columns_.clear();
+  this->values_.clear();
+  this->textOffsets_.clear();
+  this->text_.clear();
+  this->orders_.clear();
+  this->file_.reset();
+  this->checksum_ = 0;
+}
+
+int ttk::CinemaTable::addNumericColumn(const std::string &name,
+                                       std::vector<double> &values) {
+  if(values.size() != this->nRows_) {
+    return -1;
+  }
+  // the data pointer of a vector survives moves
+  this->values_.emplace_back();
+  this->values_.back().swap(values);
+
+  Column column{};
+  column.name = name;
+  column.isNumeric = true;
+  column.values = this->values_.back().data();
+  this->columns_.emplace_back(column);
+  return 0;
+}
+
+int ttk::CinemaTable::addTextColumn(const std::string &name,
+                                    std::vector<char> &text,
+                                    std::vector<uint64_t> &offsets) {
+  if(offsets.size() != this->nRows_ + 1 || offsets.back() != text.size()) {
+    return -1;
+  }
+  this->text_.emplace_back();
+  this->text_.back().swap(text);
+  this->textOffsets_.emplace_back();
+  this->textOffsets_.back().swap(offsets);
+
+  Column column{};
+  column.name = name;
+  column.isNumeric = false;
+  column.text = this->text_.back().data();
+  column.textOffsets = this->textOffsets_.back().data();
+  this->columns_.emplace_back(column);
+  return 0;
+}
+
+void ttk::CinemaTable::selectColumns(const std::vector<size_t> &ids) {
+  std::vector<Column> columns;
+  columns.reserve(ids.size());
+  for(const auto id : ids) {
+    columns.emplace_back(this->columns_[id]);
+  }
+  this->columns_.swap(columns);
+}
+
+int ttk::CinemaTable::computeOrders(const int threadNumber) {
+  if(this->nRows_ > std::numeric_limits<uint32_t>::max()) {
+    return -1;
+  }
+
+  const size_t nColumns = this->columns_.size();
+  std::vector<std::vector<uint32_t>> orders(nColumns);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nColumns; ++i) {
+    const auto &column = this->columns_[i];
+    auto &order = orders[i];
+    order.resize(this->nRows_);
+    std::iota(order.begin(), order.end(), 0);
+    // stable: equal values stay in row order
+    if(column.isNumeric) {
+      const double *values = column.values;
+      std::stable_sort(order.begin(), order.end(),
+                       [values](const uint32_t a, const uint32_t b) {
+                         return Column::lessNumeric(values[a], values[b]);
+                       });
+    } else {
+      std::stable_sort(order.begin(), order.end(),
+                       [&column](const uint32_t a, const uint32_t b) {
+                         return column.compareRows(a, b) < 0;
+                       });
+    }
+  }
+
+  for(size_t i = 0; i < nColumns; ++i) {
+    this->orders_.emplace_back();
+    this->orders_.back().swap(orders[i]);
+    this->columns_[i].order = this->orders_.back().data();
+  }
+
+  return 0;
+}
+
+int ttk::CinemaTable::write(const std::string &fileName) const {
+  // written aside then renamed: concurrent readers never see a partial
+  // file
+  const std::string tmpFileName = fileName + ".tmp";
+  std::ofstream stream(tmpFileName, std::ios::out | std::ios::binary);
+  if(!stream) {
+    return -1;
+  }
+
+  const uint64_t header[5]
+    = {indexVersion, this->nRows_, this->columns_.size(),
+       this->source_.size(), this->checksum_};
+  writeBlock(stream, indexMagic, sizeof(indexMagic));
+  writeBlock(stream, header, sizeof(header));
+  writeBlock(stream, this->source_.data(), this->source_.size());
+
+  for(const auto &column : this->columns_) {
+    const uint64_t textSize
+      = column.isNumeric ? 0 : column.textOffsets[this->nRows_];
+    const uint64_t descriptor[4] = {column.isNumeric ? 0u : 1u,
+                                    column.name.size(), textSize,
+                                    column.order != nullptr ? 1u : 0u};
+    writeBlock(stream, descriptor, sizeof(descriptor));
+    writeBlock(stream, column.name.data(), column.name.size());
+    if(column.isNumeric) {
+      writeBlock(stream, column.values, this->nRows_ * sizeof(double));
+    } else {
+      writeBlock(
+        stream, column.textOffsets, (this->nRows_ + 1) * sizeof(uint64_t));
+      writeBlock(stream, column.text, textSize);
+    }
+    if(column.order != nullptr) {
+      writeBlock(stream, column.order, this->nRows_ * sizeof(uint32_t));
+    }
+  }
+
+  stream.close();
+#ifdef _WIN32
+  // std::rename does not replace an existing file on Windows
+  if(stream) {
+    std::remove(fileName.data());
+  }
+#endif // _WIN32
+  if(!stream || std::rename(tmpFileName.data(), fileName.data()) != 0) {
+    std::remove(tmpFileName.data());
+    return -2;
+  }
+
+  return 0;
+}
+
+int ttk::CinemaTable::read(const std::string &fileName) {
+  this->reset(0);
+
+  std::unique_ptr<MemoryMappedFile> file(new MemoryMappedFile());
+  if(file->open(fileName) != 0) {
+    return -1;
+  }
+
+  BlockReader reader{file->data(), file->size(), 0};
+  const char *magic = reader.next(sizeof(indexMagic));
+  if(magic == nullptr
+     || std::memcmp(magic, indexMagic, sizeof(indexMagic)) != 0) {
+    return -2;
+  }
+  uint64_t version{}, nRows{}, nColumns{}, sourceLength{}, checksum{};
+  if(!reader.nextUInt(version) || version != indexVersion
+     || !reader.nextUInt(nRows) || !reader.nextUInt(nColumns)
+     || !reader.nextUInt(sourceLength) || !reader.nextUInt(checksum)) {
+    return -3;
+  }
+  // row identifiers are stored on 32 bits, each column takes at least
+  // its descriptor
+  if(nRows > std::numeric_limits<uint32_t>::max()
+     || nColumns > reader.size / (4 * sizeof(uint64_t))) {
+    return -3;
+  }
+  const char *source = reader.next(sourceLength);
+  if(source == nullptr) {
+    return -4;
+  }
+
+  std::vector<Column> columns(nColumns);
+  for(auto &column : columns) {
+    uint64_t type{}, nameLength{}, textSize{}, hasOrder{};
+    if(!reader.nextUInt(type) || !reader.nextUInt(nameLength)
+       || !reader.nextUInt(textSize) || !reader.nextUInt(hasOrder)) {
+      return -5;
+    }
+    const char *name = reader.next(nameLength);
+    if(name == nullptr) {
+      return -5;
+    }
+    column.name = std::string(name, nameLength);
+    column.isNumeric = type == 0;
+    if(column.isNumeric) {
+      column.values = reinterpret_cast<const double *>(
+        reader.next(nRows * sizeof(double)));
+      if(column.values == nullptr) {
+        return -6;
+      }
+    } else {
+      column.textOffsets = reinterpret_cast<const uint64_t *>(
+        reader.next((nRows + 1) * sizeof(uint64_t)));
+      column.text = reader.next(textSize);
+      if(column.textOffsets == nullptr || column.text == nullptr
+         || column.textOffsets[0] != 0
+         || column.textOffsets[nRows] != textSize) {
+        return -6;
+      }
+      for(size_t i = 0; i < nRows; ++i) {
+        if(column.textOffsets[i] > column.textOffsets[i + 1]) {
+          return -6;
+        }
+      }
+    }
+    if(hasOrder != 0) {
+      column.order = reinterpret_cast<const uint32_t *>(
+        reader.next(nRows * sizeof(uint32_t)));
+      if(column.order == nullptr) {
+        return -7;
+      }
+      for(size_t i = 0; i < nRows; ++i) {
+        if(column.order[i] >= nRows) {
+          return -7;
+        }
+      }
+    }
+  }
+
+  this->nRows_ = nRows;
+  this->columns_.swap(columns);
+  this->source_ = std::string(source, sourceLength);
+  this->checksum_ = checksum;
+  this->file_ = std::move(file);
+
+  return 0;
+}
@@ -0,0 +1,192 @@
+/// \ingroup base
+/// \class ttk::CinemaTable
+/// \date October 2021.
+///
+/// \brief Columnar storage of a Cinema database table.
+///
+/// Every column is stored in a contiguous array: numeric columns as
+/// doubles, text columns as one character buffer with row offsets. Each
+/// column can also carry its sort order (row identifiers sorted by
+/// increasing value), which lets ttk::CinemaQuery answer range predicates
+/// and ORDER BY clauses with binary searches instead of full scans.
+///
+/// A table can be written to a binary index file and mapped back into
+/// memory (see ttk::MemoryMappedFile), in which case the columns directly
+/// point into the mapping and nothing is parsed or copied.
+///
+/// \sa ttk::CinemaQuery
+
+#pragma once
+
+#include <Os.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ttk {
+
+  class CinemaTable {
+
+  public:
+    struct Column {
+      std::string name{};
+      bool isNumeric{false};
+      /** values of numeric columns */
+      const double *values{nullptr};
+      /** characters of the i-th text value: text[textOffsets[i]] to
+       * text[textOffsets[i + 1] - 1] */
+      const uint64_t *textOffsets{nullptr};
+      const char *text{nullptr};
+      /** row identifiers sorted by increasing value (optional) */
+      const uint32_t *order{nullptr};
+
+      inline size_t getTextLength(const size_t row) const {
+        return this->textOffsets[row + 1] - this->textOffsets[row];
+      }
+
+      inline const char *getText(const size_t row) const {
+        return this->text + this->textOffsets[row];
+      }
+
+      /**
+       * @brief Compare the text value of a row to a string (binary
+       * collation, as in SQLite)
+       *
+       * @return a negative value, zero or a positive value if the row
+       * value is respectively smaller than, equal to or larger than @p str
+       */
+      int compareText(const size_t row, const char *str, size_t length) const;
+
+      /**
+       * @brief Order of the numeric values: NaN (NULL in SQLite) first,
+       * then increasing values
+       */
+      static inline bool lessNumeric(const double v0, const double v1) {
+        return std::isnan(v0) ? !std::isnan(v1) : v0 < v1;
+      }
+
+      /**
+       * @brief Compare the values of two rows
+       */
+      int compareRows(const size_t row0, const size_t row1) const;
+    };
+
+    CinemaTable() = default;
+    CinemaTable(CinemaTable &&) = default;
+    CinemaTable &operator=(CinemaTable &&) = default;
+
+    inline size_t getNumberOfRows() const {
+      return this->nRows_;
+    }
+
+    inline size_t getNumberOfColumns() const {
+      return this->columns_.size();
+    }
+
+    inline const Column &getColumn(const size_t i) const {
+      return this->columns_[i];
+    }
+
+    /**
+     * @brief Index of the column named @p name (case insensitive, as SQL
+     * identifiers), -1 if there is none
+     */
+    int getColumnId(const std::string &name) const;
+
+    /** Free-form description of the data the table was built from, stored
+     * in the index file to detect stale indices. */
+    inline const std::string &getSource() const {
+      return this->source_;
+    }
+
+    inline void setSource(const std::string &source) {
+      this->source_ = source;
+    }
+
+    /** Checksum of the content the table was built from (see hashBytes),
+     * stored in the index file to detect modified tables without
+     * comparing every value. */
+    inline uint64_t getChecksum() const {
+      return this->checksum_;
+    }
+
+    inline void setChecksum(const uint64_t checksum) {
+      this->checksum_ = checksum;
+    }
+
+    /**
+     * @brief 64-bit hash of a byte buffer, chained through @p seed
+     *
+     * Not cryptographic: only meant to detect modified content.
+     */
+    static uint64_t hashBytes(const void *data,
+                              const size_t size,
+                              const uint64_t seed = 0);
+
+    /**
+     * @brief Remove all the columns and set the number of rows
+     */
+    void reset(const size_t nRows);
+
+    /**
+     * @brief Append a numeric column (the values are moved into the table)
+     */
+    int addNumericColumn(const std::string &name, std::vector<double> &values);
+
+    /**
+     * @brief Append a text column (the buffers are moved into the table)
+     *
+     * @param offsets start of every value in @p text, plus the total length
+     */
+    int addTextColumn(const std::string &name,
+                      std::vector<char> &text,
+                      std::vector<uint64_t> &offsets);
+
+    /**
+     * @brief Only keep the listed columns (in this order)
+     */
+    void selectColumns(const std::vector<size_t> &ids);
+
+    /**
+     * @brief Compute the sort order of every column (numeric columns:
+     * see Column::lessNumeric)
+     */
+    int computeOrders(const int threadNumber = 1);
+
+    /**
+     * @brief Write the table and its column orders to an index file
+     *
+     * The file is written next to @p fileName, then renamed (replacing
+     * any previous index).
+     *
+     * @return 0 in case of success, a negative value otherwise
+     */
+    int write(const std::string &fileName) const;
+
+    /**
+     * @brief Map an index file written by write()
+     *
+     * @return 0 in case of success, a negative value otherwise
+     */
+    int read(const std::string &fileName);
+
+  protected:
+    size_t nRows_{0};
+    std::vector<Column> columns_{};
+    std::string source_{};
+    uint64_t checksum_{0};
+
+    // storage of the tables built in memory
+    std::vector<std::vector<double>> values_{};
+    std::vector<std::vector<uint64_t>> textOffsets_{};
+    std::vector<std::vector<char>> text_{};
+    std::vector<std::vector<uint32_t>> orders_{};
+
+    // storage of the tables read from an index file
+    std::unique_ptr<MemoryMappedFile> file_{};
+  };
+
+} // namespace ttk
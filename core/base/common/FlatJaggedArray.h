@@ -2,20 +2,93 @@
 
 #include <Debug.h>
 
+#include <memory>
+
 namespace ttk {
   /**
    * @brief Replacement for std::vector<std::vector<SimplexId>>
    *
    * Use this when instead of a std::vector<std::vector<SimplexId>>
    * when the data is set once and not modified afterwards.
+   *
+   * The array either owns its buffers or is a read-only view over
+   * external buffers (e.g. a memory-mapped triangulation file, see
+   * ExplicitTriangulation::readFromFile).
    */
   class FlatJaggedArray {
-    // flattened sub-vectors data
+    // flattened sub-vectors data (owning mode)
     std::vector<SimplexId> data_;
-    // offset for every sub-vector
+    // offset for every sub-vector (owning mode)
     std::vector<SimplexId> offsets_;
+    // pointers to the active buffers (owned vectors or external view)
+    const SimplexId *dataPtr_{};
+    const SimplexId *offsetsPtr_{};
+    size_t dataSize_{};
+    size_t offsetsSize_{};
+    // keeps the external buffers alive in view mode
+    std::shared_ptr<const void> viewOwner_{};
+
+    inline void bindOwnedBuffers() {
+      this->dataPtr_ = this->data_.data();
+      this->offsetsPtr_ = this->offsets_.data();
+      this->dataSize_ = this->data_.size();
+      this->offsetsSize_ = this->offsets_.size();
+      this->viewOwner_.reset();
+    }
 
   public:
+    FlatJaggedArray() = default;
+
+    FlatJaggedArray(const FlatJaggedArray &other) {
+      *this = other;
+    }
+
+    FlatJaggedArray(FlatJaggedArray &&other) noexcept {
+      *this = std::move(other);
+    }
+
+    FlatJaggedArray &operator=(const FlatJaggedArray &other) {
+      if(this == &other) {
+        return *this;
+      }
+      if(other.isView()) {
+        this->data_.clear();
+        this->offsets_.clear();
+        this->dataPtr_ = other.dataPtr_;
+        this->offsetsPtr_ = other.offsetsPtr_;
+        this->dataSize_ = other.dataSize_;
+        this->offsetsSize_ = other.offsetsSize_;
+        this->viewOwner_ = other.viewOwner_;
+      } else {
+        this->data_ = other.data_;
+        this->offsets_ = other.offsets_;
+        this->bindOwnedBuffers();
+      }
+      return *this;
+    }
+
+    FlatJaggedArray &operator=(FlatJaggedArray &&other) noexcept {
+      if(this == &other) {
+        return *this;
+      }
+      const bool otherIsView = other.isView();
+      this->data_ = std::move(other.data_);
+      this->offsets_ = std::move(other.offsets_);
+      if(otherIsView) {
+        this->dataPtr_ = other.dataPtr_;
+        this->offsetsPtr_ = other.offsetsPtr_;
+        this->dataSize_ = other.dataSize_;
+        this->offsetsSize_ = other.offsetsSize_;
+        this->viewOwner_ = std::move(other.viewOwner_);
+      } else {
+        this->bindOwnedBuffers();
+      }
+      other.data_.clear();
+      other.offsets_.clear();
+      other.bindOwnedBuffers();
+      return *this;
+    }
+
     // ############## //
     // Initialization //
     // ############## //
@@ -27,6 +100,45 @@ namespace ttk {
                         std::vector<SimplexId> &&offsets) {
       this->data_ = std::move(data);
       this->offsets_ = std::move(offsets);
+      this->bindOwnedBuffers();
+    }
+
+    /**
+     * @brief Use external buffers without copying them
+     *
+     * @param[in] data Flattened sub-vectors data
+     * @param[in] offsets Sub-vectors offsets (subvectorsNumber + 1 entries)
+     * @param[in] subvectorsNumber Number of sub-vectors
+     * @param[in] owner Keeps the external buffers alive (e.g. a
+     * MemoryMappedFile) as long as this array references them
+     */
+    inline void setDataView(const SimplexId *const data,
+                            const SimplexId *const offsets,
+                            const size_t subvectorsNumber,
+                            std::shared_ptr<const void> owner) {
+      this->data_.clear();
+      this->offsets_.clear();
+      this->dataPtr_ = data;
+      this->offsetsPtr_ = offsets;
+      this->offsetsSize_ = subvectorsNumber + 1;
+      this->dataSize_ = offsets[subvectorsNumber];
+      this->viewOwner_ = std::move(owner);
+    }
+
+    /**
+     * @brief Release the buffers (owned or viewed)
+     */
+    inline void clear() {
+      this->data_ = {};
+      this->offsets_ = {};
+      this->bindOwnedBuffers();
+    }
+
+    /**
+     * @brief If the array is a view over external buffers
+     */
+    inline bool isView() const {
+      return this->viewOwner_ != nullptr;
     }
 
     // ############################## //
@@ -38,11 +150,11 @@ namespace ttk {
      */
     inline SimplexId size(SimplexId id) const {
 #ifndef TTK_ENABLE_KAMIKAZE
-      if(id < 0 || id > (SimplexId)offsets_.size() - 1) {
+      if(id < 0 || id > (SimplexId)offsetsSize_ - 1) {
         return -1;
       }
 #endif
-      return this->offsets_[id + 1] - this->offsets_[id];
+      return this->offsetsPtr_[id + 1] - this->offsetsPtr_[id];
     }
 
     /**
@@ -50,11 +162,11 @@ namespace ttk {
      */
     inline SimplexId offset(SimplexId id) const {
 #ifndef TTK_ENABLE_KAMIKAZE
-      if(id < 0 || id > (SimplexId)offsets_.size()) {
+      if(id < 0 || id > (SimplexId)offsetsSize_) {
         return -1;
       }
 #endif
-      return this->offsets_[id];
+      return this->offsetsPtr_[id];
     }
 
     /**
@@ -62,14 +174,14 @@ namespace ttk {
      */
     inline SimplexId get(SimplexId id, SimplexId local) const {
 #ifndef TTK_ENABLE_KAMIKAZE
-      if(id < 0 || id > (SimplexId)offsets_.size() - 1) {
+      if(id < 0 || id > (SimplexId)offsetsSize_ - 1) {
         return -1;
       }
       if(local < 0 || local >= this->size(id)) {
         return -2;
       }
 #endif
-      return this->data_[this->offsets_[id] + local];
+      return this->dataPtr_[this->offsetsPtr_[id] + local];
     }
 
     /**
@@ -77,46 +189,55 @@ namespace ttk {
      */
     inline const SimplexId *get_ptr(SimplexId id, SimplexId local) const {
 #ifndef TTK_ENABLE_KAMIKAZE
-      if(id < 0 || id > (SimplexId)offsets_.size() - 1) {
+      if(id < 0 || id > (SimplexId)offsetsSize_ - 1) {
         return {};
       }
       if(local < 0 || local >= this->size(id)) {
         return {};
       }
 #endif
-      return &this->data_[this->offsets_[id] + local];
+      return &this->dataPtr_[this->offsetsPtr_[id] + local];
     }
 
     /**
      * @brief Returns a const pointer to the offset member
      */
     inline const SimplexId *offset_ptr() const {
-      return offsets_.data();
+      return offsetsPtr_;
+    }
+
+    /**
+     * @brief Returns a const pointer to the flattened data
+     */
+    inline const SimplexId *data_ptr() const {
+      return dataPtr_;
     }
 
     /**
      * @brief Returns the number of sub-vectors
      */
     inline size_t subvectorsNumber() const {
-      return this->offsets_.size() - 1;
+      return this->offsetsSize_ - 1;
     }
 
     /**
      * @brief Returns the size of the data_ member
      */
     inline size_t dataSize() const {
-      return this->data_.size();
+      return this->dataSize_;
     }
 
     /**
      * @brief If the underlying buffers are empty
      */
     inline bool empty() const {
-      return this->data_.empty() || this->offsets_.empty();
+      return this->dataSize_ == 0 || this->offsetsSize_ == 0;
     }
 
     /**
      * @brief Computes the memory footprint of the array
+     *
+     * Views over external buffers do not account for any memory.
      */
     inline std::size_t footprint() const {
       return (this->data_.size() + this->offsets_.size()) * sizeof(SimplexId);
@@ -146,6 +267,7 @@ namespace ttk {
           this->data_[this->offsets_[i] + j] = src[i][j];
         }
       }
+      this->bindOwnedBuffers();
     }
 
     /**
@@ -0,0 +1,193 @@
+/// \ingroup base
+/// \class ttk::FlatJaggedArrayCache
+/// \date October 2021.
+///
+/// \brief Thread-safe LRU cache of FlatJaggedArray blocks, bounded by a
+/// memory budget.
+///
+/// A relation (e.g. vertex stars) is split into blocks of consecutive
+/// simplices. Blocks are computed on first access with a user-provided
+/// builder, kept in the cache and evicted (least recently used first)
+/// when the cache footprint exceeds the memory budget.
+///
+/// The block builder is given on each access rather than stored in the
+/// cache, so that the cache never refers to its owner: a cache shared by
+/// copies of its owner stays valid.
+///
+/// Each thread keeps a handle on the last block it accessed: consecutive
+/// accesses to the same block do not take the lock. A block evicted from
+/// the cache stays alive while a thread handle refers to it, so up to one
+/// extra block per thread and per cache may exceed the budget.
+/// \sa AbstractTriangulation::preconditionVertexStars(const size_t)
+
+#pragma once
+
+#include <FlatJaggedArray.h>
+#include <OpenMPLock.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace ttk {
+
+  class FlatJaggedArrayCache {
+
+  public:
+    using Block = std::shared_ptr<const FlatJaggedArray>;
+
+    FlatJaggedArrayCache(const SimplexId blockSize, const size_t memoryBudget)
+      : blockSize_{blockSize}, memoryBudget_{memoryBudget}, id_{newId()} {
+    }
+
+    FlatJaggedArrayCache(const FlatJaggedArrayCache &) = delete;
+    FlatJaggedArrayCache &operator=(const FlatJaggedArrayCache &) = delete;
+
+    /**
+     * @brief Number of consecutive simplices per block
+     */
+    inline SimplexId blockSize() const {
+      return this->blockSize_;
+    }
+
+    /**
+     * @brief Get the block containing the given simplex (local
+     * identifier in the block: simplexId % blockSize())
+     *
+     * builder(blockId, block) computes the sub-vectors of the simplices
+     * of a block on a cache miss. The returned reference is valid until
+     * the next call from the same thread.
+     */
+    template <typename Builder>
+    inline const FlatJaggedArray &getBlockOf(const SimplexId simplexId,
+                                             const Builder &builder) {
+      const SimplexId blockId = simplexId / this->blockSize_;
+      auto &handle = threadHandle(this->id_);
+      if(handle.cacheId != this->id_ || handle.blockId != blockId) {
+        handle.block = this->get(blockId, builder);
+        handle.cacheId = this->id_;
+        handle.blockId = blockId;
+      }
+      return *handle.block;
+    }
+
+    /**
+     * @brief Get a block, computing it if not in the cache
+     */
+    template <typename Builder>
+    Block get(const SimplexId blockId, const Builder &builder) {
+
+      this->lock_.lock();
+      const auto it = this->blocks_.find(blockId);
+      if(it != this->blocks_.end()) {
+        // move to the front of the LRU list
+        this->lru_.splice(this->lru_.begin(), this->lru_, it->second.second);
+        const auto res = it->second.first;
+        this->lock_.unlock();
+        return res;
+      }
+      this->lock_.unlock();
+
+      // compute the block outside of the critical section (concurrent
+      // misses on the same block may compute it several times)
+      auto block = std::make_shared<FlatJaggedArray>();
+      builder(blockId, *block);
+
+      this->lock_.lock();
+      const auto res = this->insert(blockId, std::move(block));
+      this->lock_.unlock();
+
+      return res;
+    }
+
+    /**
+     * @brief Raise the memory budget to at least the given value (a cache
+     * shared by several requests honors the largest one)
+     */
+    inline void reserveBudget(const size_t memoryBudget) {
+      this->lock_.lock();
+      this->memoryBudget_ = std::max(this->memoryBudget_, memoryBudget);
+      this->lock_.unlock();
+    }
+
+    /**
+     * @brief Memory used by the cached blocks
+     */
+    inline size_t footprint() const {
+      return this->footprint_;
+    }
+
+    /**
+     * @brief Drop all the cached blocks
+     */
+    inline void clear() {
+      this->lock_.lock();
+      this->blocks_.clear();
+      this->lru_.clear();
+      this->footprint_ = 0;
+      // invalidate the thread handles
+      this->id_ = newId();
+      this->lock_.unlock();
+    }
+
+  protected:
+    // to be called with the lock held
+    Block insert(const SimplexId blockId, Block &&block) {
+      const auto it = this->blocks_.find(blockId);
+      if(it != this->blocks_.end()) {
+        // computed concurrently by another thread
+        return it->second.first;
+      }
+
+      this->footprint_ += block->footprint();
+      this->lru_.emplace_front(blockId);
+      this->blocks_.emplace(blockId, std::make_pair(block, this->lru_.begin()));
+
+      // evict the least recently used blocks (always keep the new one)
+      while(this->footprint_ > this->memoryBudget_ && this->lru_.size() > 1) {
+        const auto victim = this->blocks_.find(this->lru_.back());
+        this->footprint_ -= victim->second.first->footprint();
+        this->blocks_.erase(victim);
+        this->lru_.pop_back();
+      }
+
+      return block;
+    }
+
+    // last block accessed by a thread in a given cache
+    struct ThreadHandle {
+      size_t cacheId{};
+      SimplexId blockId{-1};
+      Block block{};
+    };
+
+    static inline size_t newId() {
+      static std::atomic<size_t> lastId{0};
+      return ++lastId;
+    }
+
+    static inline ThreadHandle &threadHandle(const size_t cacheId) {
+      // direct-mapped on the cache identifier (stars and neighbors
+      // caches of a triangulation get consecutive identifiers)
+      static thread_local std::array<ThreadHandle, 4> handles{};
+      return handles[cacheId % handles.size()];
+    }
+
+    const SimplexId blockSize_;
+    size_t memoryBudget_;
+    size_t id_;
+
+    // block id -> (block, position in the LRU list)
+    std::unordered_map<SimplexId,
+                       std::pair<Block, std::list<SimplexId>::iterator>>
+      blocks_{};
+    // most recently used blocks first
+    std::list<SimplexId> lru_{};
+    size_t footprint_{};
+    Lock lock_{};
+  };
+
+} // namespace ttk
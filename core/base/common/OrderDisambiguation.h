@@ -4,6 +4,11 @@
 #include <Debug.h>
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #if defined(__GNUC__) && !defined(__clang__)
@@ -12,6 +17,198 @@
 
 namespace ttk {
 
+  /**
+   * @brief Map an integer to an unsigned radix key with the same order
+   */
+  template <typename T>
+  inline typename std::enable_if<std::is_integral<T>::value,
+                                 typename std::make_unsigned<T>::type>::type
+    radixKey(const T value) {
+    using U = typename std::make_unsigned<T>::type;
+    const auto key = static_cast<U>(value);
+    // flip the sign bit of signed integers
+    return std::is_signed<T>::value
+             ? static_cast<U>(key ^ (U{1} << (8 * sizeof(U) - 1)))
+             : key;
+  }
+
+  /**
+   * @brief Map a float to an unsigned radix key with the same order
+   */
+  inline uint32_t radixKey(const float value) {
+    // -0.0 and +0.0 compare equal
+    const float v = value == 0.0f ? 0.0f : value;
+    uint32_t bits{};
+    std::memcpy(&bits, &v, sizeof(bits));
+    // negative: flip all bits, positive: flip the sign bit
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+  }
+
+  /**
+   * @brief Map a double to an unsigned radix key with the same order
+   */
+  inline uint64_t radixKey(const double value) {
+    const double v = value == 0.0 ? 0.0 : value;
+    uint64_t bits{};
+    std::memcpy(&bits, &v, sizeof(bits));
+    const uint64_t signBit{0x8000000000000000ull};
+    return (bits & signBit) ? ~bits : bits | signBit;
+  }
+
+  /**
+   * @brief Scratch buffers for sortVertices
+   *
+   * Can be reused between calls to avoid re-allocating the buffers,
+   * e.g. to precondition several scalar fields (time steps) defined on
+   * the same domain.
+   */
+  struct VertexSortBuffers {
+    std::vector<SimplexId> values{};
+    std::vector<SimplexId> valuesTmp{};
+    // radix keys (up to 64 bits)
+    std::vector<uint64_t> keys{};
+    std::vector<uint64_t> keysTmp{};
+    // radix keys of fields of up to 32 bits
+    std::vector<uint32_t> keys32{};
+    std::vector<uint32_t> keysTmp32{};
+  };
+
+  /**
+   * @brief Select the key buffers of VertexSortBuffers by key type
+   */
+  inline void getKeyBuffers(VertexSortBuffers &buffers,
+                            std::vector<uint32_t> *&keys,
+                            std::vector<uint32_t> *&keysTmp) {
+    keys = &buffers.keys32;
+    keysTmp = &buffers.keysTmp32;
+  }
+
+  inline void getKeyBuffers(VertexSortBuffers &buffers,
+                            std::vector<uint64_t> *&keys,
+                            std::vector<uint64_t> *&keysTmp) {
+    keys = &buffers.keys;
+    keysTmp = &buffers.keysTmp;
+  }
+
+  /**
+   * @brief Parallel & stable LSD radix sort of (key, value) pairs
+   *
+   * Keys are processed by 8-bits digits. Every thread scatters its own
+   * contiguous chunk of the input, passes over a digit shared by all
+   * keys are skipped.
+   *
+   * The sorted pairs end up in either buffer: the pointers are swapped
+   * after every scatter pass.
+   *
+   * @param[in] keyBytes number of significant bytes in the keys
+   * @param[in] n number of pairs
+   * @param[in,out] keys keys to sort
+   * @param[in,out] keysTmp scratch space of size @p n
+   * @param[in,out] values values to sort
+   * @param[in,out] valuesTmp scratch space of size @p n
+   * @param[in] nThreads number of parallel threads
+   */
+  template <typename KeyType>
+  void radixSortPairs(const size_t keyBytes,
+                      const size_t n,
+                      KeyType *&keys,
+                      KeyType *&keysTmp,
+                      SimplexId *&values,
+                      SimplexId *&valuesTmp,
+                      const int nThreads) {
+
+    const size_t nChunks = std::max(1, nThreads);
+    const size_t chunkSize = (n + nChunks - 1) / nChunks;
+    std::vector<std::array<size_t, 256>> histograms(nChunks);
+
+    for(size_t pass = 0; pass < keyBytes; ++pass) {
+      const size_t shift = 8 * pass;
+      const KeyType *const k = keys;
+      const SimplexId *const v = values;
+      KeyType *const kTmp = keysTmp;
+      SimplexId *const vTmp = valuesTmp;
+
+      // 1. per-chunk digit histograms
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t c = 0; c < nChunks; ++c) {
+        auto &hist = histograms[c];
+        hist.fill(0);
+        const size_t end = std::min(n, (c + 1) * chunkSize);
+        for(size_t i = c * chunkSize; i < end; ++i) {
+          hist[(k[i] >> shift) & 0xFF]++;
+        }
+      }
+
+      // 2. exclusive prefix sum in (digit, chunk) order
+      size_t sum{};
+      bool trivialPass{false};
+      for(size_t d = 0; d < 256; ++d) {
+        size_t digitCount{};
+        for(size_t c = 0; c < nChunks; ++c) {
+          const auto count = histograms[c][d];
+          histograms[c][d] = sum;
+          sum += count;
+          digitCount += count;
+        }
+        if(digitCount == n) {
+          // every key shares this digit: nothing to do
+          trivialPass = true;
+          break;
+        }
+      }
+      if(trivialPass) {
+        continue;
+      }
+
+      // 3. stable scatter
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t c = 0; c < nChunks; ++c) {
+        auto &hist = histograms[c];
+        const size_t end = std::min(n, (c + 1) * chunkSize);
+        for(size_t i = c * chunkSize; i < end; ++i) {
+          const auto pos = hist[(k[i] >> shift) & 0xFF]++;
+          kTmp[pos] = k[i];
+          vTmp[pos] = v[i];
+        }
+      }
+
+      std::swap(keys, keysTmp);
+      std::swap(values, valuesTmp);
+    }
+  }
+
+  /**
+   * @brief Parallel & stable LSD radix sort of (key, value) pairs
+   *
+   * @param[in] keyBytes number of significant bytes in the keys
+   * @param[in,out] buffers keys and values to sort (keys & values),
+   * scratch space (keysTmp & valuesTmp)
+   * @param[in] nThreads number of parallel threads
+   */
+  inline void radixSortPairs(const size_t keyBytes,
+                             VertexSortBuffers &buffers,
+                             const int nThreads) {
+
+    const size_t n = buffers.keys.size();
+    buffers.keysTmp.resize(n);
+    buffers.valuesTmp.resize(n);
+
+    uint64_t *keys = buffers.keys.data();
+    uint64_t *keysTmp = buffers.keysTmp.data();
+    SimplexId *values = buffers.values.data();
+    SimplexId *valuesTmp = buffers.valuesTmp.data();
+    radixSortPairs(keyBytes, n, keys, keysTmp, values, valuesTmp, nThreads);
+
+    if(keys != buffers.keys.data()) {
+      std::swap(buffers.keys, buffers.keysTmp);
+      std::swap(buffers.values, buffers.valuesTmp);
+    }
+  }
+
   /**
    * @brief Sort vertices according to scalars disambiguated by offsets
    *
@@ -19,57 +216,115 @@ namespace ttk {
    * @param[in] scalars array of size nVerts, main vertex comparator
    * @param[in] offsets array of size nVerts, disambiguate scalars on plateaux
    * @param[out] order array of size nVerts, computed order of vertices
+   * (also used as scratch space)
    * @param[in] nThreads number of parallel threads
+   * @param[in,out] buffers sort scratch space, 12 bytes per vertex for
+   * scalars and offsets of up to 32 bits, 20 bytes per vertex otherwise
+   * (with 32-bit SimplexId)
    */
   template <typename scalarType, typename idType>
   void sortVertices(const size_t nVerts,
                     const scalarType *const scalars,
                     const idType *const offsets,
                     SimplexId *const order,
-                    const int nThreads) {
+                    const int nThreads,
+                    VertexSortBuffers &buffers) {
 
-    // array of pre-sorted vertices
-    std::vector<SimplexId> sortedVertices(nVerts);
+    // the vertices are sorted with a stable radix sort: first on the
+    // offsets (if any, vertex ids otherwise), then on the scalars
+
+    // 32-bit keys if both fields fit, 64-bit keys otherwise
+    using KeyType = typename std::conditional<
+      sizeof(decltype(radixKey(std::declval<scalarType>()))) <= 4
+        && sizeof(decltype(radixKey(std::declval<idType>()))) <= 4,
+      uint32_t, uint64_t>::type;
+
+    std::vector<KeyType> *keysBuffer{}, *keysTmpBuffer{};
+    getKeyBuffers(buffers, keysBuffer, keysTmpBuffer);
+    keysBuffer->resize(nVerts);
+    keysTmpBuffer->resize(nVerts);
+    buffers.values.resize(nVerts);
+
+    // the order array is the scratch space of the vertex identifiers
+    KeyType *keys = keysBuffer->data();
+    KeyType *keysTmp = keysTmpBuffer->data();
+    SimplexId *sortedVertices = buffers.values.data();
+    SimplexId *sortedVerticesTmp = order;
 
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(nThreads)
 #endif // TTK_ENABLE_OPENMP
-    for(size_t i = 0; i < sortedVertices.size(); ++i) {
+    for(size_t i = 0; i < nVerts; ++i) {
       sortedVertices[i] = i;
     }
 
-#if defined(_GLIBCXX_PARALLEL_FEATURES_H) && defined(TTK_ENABLE_OPENMP)
-#define PSORT(NTHREADS)          \
-  omp_set_num_threads(NTHREADS); \
-  __gnu_parallel::sort
-#else
-#define PSORT(NTHREADS) std::sort
-#endif // _GLIBCXX_PARALLEL_FEATURES_H && TTK_ENABLE_OPENMP
-
     if(offsets != nullptr) {
-      PSORT(nThreads)
-      (sortedVertices.begin(), sortedVertices.end(),
-       [&](const SimplexId a, const SimplexId b) {
-         return (scalars[a] < scalars[b])
-                || (scalars[a] == scalars[b] && offsets[a] < offsets[b]);
-       });
-    } else {
-      PSORT(nThreads)
-      (sortedVertices.begin(), sortedVertices.end(),
-       [&](const SimplexId a, const SimplexId b) {
-         return (scalars[a] < scalars[b])
-                || (scalars[a] == scalars[b] && a < b);
-       });
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < nVerts; ++i) {
+        keys[i] = radixKey(offsets[i]);
+      }
+      radixSortPairs(sizeof(radixKey(offsets[0])), nVerts, keys, keysTmp,
+                     sortedVertices, sortedVerticesTmp, nThreads);
+    }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < nVerts; ++i) {
+      keys[i] = radixKey(scalars[sortedVertices[i]]);
     }
+    radixSortPairs(sizeof(radixKey(scalars[0])), nVerts, keys, keysTmp,
+                   sortedVertices, sortedVerticesTmp, nThreads);
 
+    // invert the permutation, through the vertex buffer if the sorted
+    // vertices ended up in the order array
+    SimplexId *const inverse
+      = sortedVertices == order ? sortedVerticesTmp : order;
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(nThreads)
 #endif // TTK_ENABLE_OPENMP
-    for(size_t i = 0; i < sortedVertices.size(); ++i) {
-      order[sortedVertices[i]] = i;
+    for(size_t i = 0; i < nVerts; ++i) {
+      inverse[sortedVertices[i]] = i;
+    }
+    if(inverse != order) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < nVerts; ++i) {
+        order[i] = inverse[i];
+      }
     }
   }
 
+  /**
+   * @brief Sort vertices according to scalars disambiguated by offsets
+   *
+   * @param[in] nVerts number of vertices
+   * @param[in] scalars array of size nVerts, main vertex comparator
+   * @param[in] offsets array of size nVerts, disambiguate scalars on plateaux
+   * @param[out] order array of size nVerts, computed order of vertices
+   * @param[in] nThreads number of parallel threads
+   */
+  template <typename scalarType, typename idType>
+  void sortVertices(const size_t nVerts,
+                    const scalarType *const scalars,
+                    const idType *const offsets,
+                    SimplexId *const order,
+                    const int nThreads) {
+    VertexSortBuffers buffers{};
+    sortVertices(nVerts, scalars, offsets, order, nThreads, buffers);
+  }
+
+#if defined(_GLIBCXX_PARALLEL_FEATURES_H) && defined(TTK_ENABLE_OPENMP)
+#define PSORT(NTHREADS)          \
+  omp_set_num_threads(NTHREADS); \
+  __gnu_parallel::sort
+#else
+#define PSORT(NTHREADS) std::sort
+#endif // _GLIBCXX_PARALLEL_FEATURES_H && TTK_ENABLE_OPENMP
+
   /**
    * @brief Precondition an order array to be consumed by the base layer API
    *
@@ -87,4 +342,50 @@ namespace ttk {
     ttk::sortVertices(
       nVerts, scalars, static_cast<int *>(nullptr), order, nThreads);
   }
+
+  /**
+   * @brief Precondition an order array, re-using the given sort buffers
+   *
+   * @param[in] nVerts number of vertices
+   * @param[in] scalars pointer to scalar field buffer of size @p nVerts
+   * @param[out] order pointer to pre-allocated order buffer of size @p nVerts
+   * @param[in,out] buffers sort scratch space, kept between calls
+   * @param[in] nThreads number of threads to be used
+   */
+  template <typename scalarType>
+  inline void preconditionOrderArray(const size_t nVerts,
+                                     const scalarType *const scalars,
+                                     SimplexId *const order,
+                                     VertexSortBuffers &buffers,
+                                     const int nThreads
+                                     = ttk::globalThreadNumber_) {
+    ttk::sortVertices(
+      nVerts, scalars, static_cast<int *>(nullptr), order, nThreads, buffers);
+  }
+
+  /**
+   * @brief Precondition the order arrays of several scalar fields
+   * defined on the same domain (e.g. the time steps of a time series)
+   *
+   * The sort scratch space is allocated once and shared between the
+   * fields.
+   *
+   * @param[in] nVerts number of vertices
+   * @param[in] scalars scalar field buffers of size @p nVerts
+   * @param[out] orders pre-allocated order buffers of size @p nVerts
+   * (one per scalar field)
+   * @param[in] nThreads number of threads to be used
+   */
+  template <typename scalarType>
+  inline void
+    preconditionOrderArrays(const size_t nVerts,
+                            const std::vector<const scalarType *> &scalars,
+                            const std::vector<SimplexId *> &orders,
+                            const int nThreads = ttk::globalThreadNumber_) {
+    VertexSortBuffers buffers{};
+    const auto nFields = std::min(scalars.size(), orders.size());
+    for(size_t i = 0; i < nFields; ++i) {
+      preconditionOrderArray(nVerts, scalars[i], orders[i], buffers, nThreads);
+    }
+  }
 } // namespace ttk
@@ -20,6 +20,8 @@
 #elif defined(__unix__) || defined(__APPLE__)
 
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -27,6 +29,7 @@
 #endif
 
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -63,6 +66,22 @@ namespace ttk {
     return 0;
   }
 
+  float OsCall::getMemoryPeakUsage() {
+#ifdef __linux__
+    std::ifstream procFile("/proc/self/status", std::ios::in);
+    std::string line;
+    while(std::getline(procFile, line)) {
+      if(line.compare(0, 6, "VmHWM:") == 0) {
+        std::stringstream stream(line.substr(6));
+        float peakUsage{};
+        stream >> peakUsage;
+        return peakUsage / 1024.0;
+      }
+    }
+#endif
+    return 0;
+  }
+
   int OsCall::getNumberOfCores() {
 #ifdef TTK_ENABLE_OPENMP
     return omp_get_num_procs();
@@ -234,4 +253,108 @@ namespace ttk {
     return std::remove(fileName.c_str());
   }
 
+  int MemoryMappedFile::open(const std::string &fileName) {
+
+    this->close();
+
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = ::open(fileName.c_str(), O_RDONLY);
+    if(fd == -1) {
+      return -1;
+    }
+    struct stat st {};
+    if(fstat(fd, &st) == -1 || st.st_size == 0) {
+      ::close(fd);
+      return -2;
+    }
+    void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping stays valid after the file descriptor is closed
+    ::close(fd);
+    if(addr == MAP_FAILED) {
+      return -3;
+    }
+    this->data_ = static_cast<char *>(addr);
+    this->size_ = st.st_size;
+#else
+    std::ifstream stream(fileName, std::ios::in | std::ios::binary);
+    if(!stream) {
+      return -1;
+    }
+    stream.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<size_t>(stream.tellg());
+    if(fileSize == 0) {
+      return -2;
+    }
+    stream.seekg(0, std::ios::beg);
+    this->buffer_.resize(fileSize);
+    stream.read(this->buffer_.data(), fileSize);
+    if(!stream) {
+      this->buffer_ = {};
+      return -3;
+    }
+    this->data_ = this->buffer_.data();
+    this->size_ = fileSize;
+#endif
+
+    return 0;
+  }
+
+  int MemoryMappedFile::create(const std::string &fileName,
+                               const size_t size) {
+
+    this->close();
+
+    if(size == 0) {
+      return -2;
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd == -1) {
+      return -1;
+    }
+    if(ftruncate(fd, static_cast<off_t>(size)) == -1) {
+      ::close(fd);
+      return -2;
+    }
+    void *addr
+      = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(addr == MAP_FAILED) {
+      return -3;
+    }
+    this->data_ = static_cast<char *>(addr);
+#else
+    std::ofstream stream(fileName, std::ios::out | std::ios::binary);
+    if(!stream) {
+      return -1;
+    }
+    this->buffer_.resize(size);
+    this->data_ = this->buffer_.data();
+    this->fileName_ = fileName;
+#endif
+    this->size_ = size;
+    this->writable_ = true;
+
+    return 0;
+  }
+
+  void MemoryMappedFile::close() {
+#if defined(__unix__) || defined(__APPLE__)
+    if(this->data_ != nullptr) {
+      munmap(this->data_, this->size_);
+    }
+#else
+    if(this->writable_ && !this->fileName_.empty()) {
+      std::ofstream stream(this->fileName_, std::ios::out | std::ios::binary);
+      stream.write(this->buffer_.data(), this->buffer_.size());
+    }
+    this->buffer_ = {};
+    this->fileName_ = {};
+#endif
+    this->data_ = nullptr;
+    this->size_ = 0;
+    this->writable_ = false;
+  }
+
 } // namespace ttk
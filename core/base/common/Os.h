@@ -68,6 +68,9 @@ namespace ttk {
 
     static float getMemoryInstantUsage();
 
+    /// Peak resident set size of the process, in MB (0 if unavailable)
+    static float getMemoryPeakUsage();
+
     static int getNumberOfCores();
 
     static double getTimeStamp();
@@ -153,6 +156,69 @@ namespace ttk {
 
     double start_;
   };
+
+  /**
+   * @brief Memory mapping of a whole file
+   *
+   * Pages are loaded on demand and shared between the processes mapping
+   * the same file. On platforms without mmap support, the file content
+   * is read into a heap buffer instead (written back to the file on
+   * close() for writable mappings).
+   */
+  class MemoryMappedFile {
+
+  public:
+    MemoryMappedFile() = default;
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    ~MemoryMappedFile() {
+      close();
+    }
+
+    /**
+     * @brief Map the given file
+     *
+     * @return 0 in case of success, a negative value otherwise
+     */
+    int open(const std::string &fileName);
+
+    /**
+     * @brief Create (or truncate) the given file to size bytes and map it
+     * for reading and writing
+     *
+     * @return 0 in case of success, a negative value otherwise
+     */
+    int create(const std::string &fileName, const size_t size);
+
+    void close();
+
+    inline const char *data() const {
+      return data_;
+    }
+
+    /// nullptr for read-only mappings
+    inline char *writableData() {
+      return writable_ ? data_ : nullptr;
+    }
+
+    inline size_t size() const {
+      return size_;
+    }
+
+    inline bool isMapped() const {
+      return data_ != nullptr;
+    }
+
+  protected:
+    char *data_{};
+    size_t size_{};
+    bool writable_{false};
+    // fallback buffer when memory mapping is not available
+    std::vector<char> buffer_{};
+    // file written back from buffer_ on close()
+    std::string fileName_{};
+  };
 } // namespace ttk
 
 #endif
@@ -0,0 +1,454 @@
+/// \ingroup base
+/// \class ttk::PersistenceDiagramColumns
+/// \date October 2021.
+///
+/// \brief Columnar (struct-of-arrays) persistence diagram, exchanged
+/// between the persistence diagram modules.
+///
+/// Every field of the pairs (vertex identifiers, critical types,
+/// persistence, pair type, birth, death and coordinates of both critical
+/// points) has its own contiguous column, so that the distance kernels
+/// only stream over the fields they need.
+///
+/// Columns are reference-counted buffers (ttk::DiagramColumn): copying a
+/// diagram shares its columns, which are copied on the first write. A
+/// column can also view external memory (e.g. a VTK data array) kept alive
+/// by an owner, and lend its buffer to VTK (see ttkPersistenceDiagramUtils),
+/// so that the VTK persistence diagrams are converted without copying the
+/// per-pair values.
+///
+/// fromTuples() / toTuples() convert from / to the legacy tuple
+/// representation (see ttk::DiagramTuple).
+///
+/// \sa ttk::BottleneckDistance
+/// \sa ttk::PersistenceDiagramDistanceMatrix
+/// \sa ttk::PersistenceDiagramClustering
+
+#pragma once
+
+#include <DataTypes.h>
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace ttk {
+
+  /**
+   * @brief Copy-on-write buffer of trivially copyable values
+   *
+   * The buffer is either owned (and shared between the copies of the
+   * column) or a read-only view over external memory. Non-const accesses
+   * first give the column its own buffer if it is shared or a view: take
+   * data() once before writing in parallel.
+   */
+  template <typename T>
+  class DiagramColumn {
+    // values (owned array or aliased external memory)
+    std::shared_ptr<T> data_{};
+    size_t size_{};
+    size_t capacity_{};
+    bool view_{false};
+
+    // give the column its own buffer of at least n elements
+    void detach(const size_t n) {
+      if(!this->view_ && this->data_.use_count() == 1
+         && this->capacity_ >= n) {
+        return;
+      }
+      if(n == 0 && this->size_ == 0) {
+        this->data_.reset();
+        this->capacity_ = 0;
+        this->view_ = false;
+        return;
+      }
+      const size_t capacity = std::max(n, this->size_);
+      std::shared_ptr<T> buffer(new T[capacity], std::default_delete<T[]>());
+      std::copy(this->data_.get(), this->data_.get() + this->size_,
+                buffer.get());
+      this->data_ = std::move(buffer);
+      this->capacity_ = capacity;
+      this->view_ = false;
+    }
+
+  public:
+    DiagramColumn() = default;
+
+    explicit DiagramColumn(const size_t n) {
+      this->resize(n);
+    }
+
+    /**
+     * @brief View @p n values at @p data, kept alive by @p owner
+     */
+    inline void setView(const T *const data,
+                        const size_t n,
+                        const std::shared_ptr<void> &owner) {
+      this->data_ = std::shared_ptr<T>(owner, const_cast<T *>(data));
+      this->size_ = n;
+      this->capacity_ = n;
+      this->view_ = true;
+    }
+
+    /**
+     * @brief Shared pointer to the values, to lend them without copy
+     *
+     * The borrower must not modify the values.
+     */
+    inline std::shared_ptr<T> getBuffer() const {
+      return this->data_;
+    }
+
+    inline bool isView() const {
+      return this->view_;
+    }
+
+    inline size_t size() const {
+      return this->size_;
+    }
+
+    inline bool empty() const {
+      return this->size_ == 0;
+    }
+
+    inline const T *data() const {
+      return this->data_.get();
+    }
+
+    inline T *data() {
+      this->detach(this->size_);
+      return this->data_.get();
+    }
+
+    inline const T &operator[](const size_t i) const {
+      return this->data_.get()[i];
+    }
+
+    inline T &operator[](const size_t i) {
+      return this->data()[i];
+    }
+
+    inline const T *begin() const {
+      return this->data();
+    }
+
+    inline const T *end() const {
+      return this->data() + this->size_;
+    }
+
+    /**
+     * @brief Give the column its own buffer if shared or a view
+     */
+    inline void detach() {
+      this->detach(this->size_);
+    }
+
+    inline void reserve(const size_t n) {
+      this->detach(std::max(n, this->size_));
+    }
+
+    /**
+     * @brief Resize the column, new values are value-initialized
+     */
+    void resize(const size_t n) {
+      if(n == this->size_) {
+        return;
+      }
+      if(n > this->size_) {
+        this->detach(n > this->capacity_ ? std::max(n, 2 * this->size_) : n);
+        std::fill(this->data_.get() + this->size_, this->data_.get() + n, T{});
+      } else {
+        this->detach(n);
+      }
+      this->size_ = n;
+    }
+
+    inline void push_back(const T value) {
+      this->detach(this->size_ < this->capacity_ ? this->size_ + 1
+                                                 : 2 * this->size_ + 1);
+      this->data_.get()[this->size_] = value;
+      this->size_++;
+    }
+
+    inline void clear() {
+      this->data_.reset();
+      this->size_ = 0;
+      this->capacity_ = 0;
+      this->view_ = false;
+    }
+
+    inline bool operator==(const DiagramColumn &other) const {
+      return this->size_ == other.size_
+             && std::equal(this->begin(), this->end(), other.begin());
+    }
+  };
+
+  template <typename dataType>
+  class PersistenceDiagramColumns {
+
+  public:
+    /** Vertex Id of low pair element */
+    DiagramColumn<SimplexId> birthVertex{};
+    /** Critical Type of low pair element */
+    DiagramColumn<CriticalType> birthType{};
+    /** Vertex Id of high pair element */
+    DiagramColumn<SimplexId> deathVertex{};
+    /** Critical Type of high pair element */
+    DiagramColumn<CriticalType> deathType{};
+    /** Pair persistence value */
+    DiagramColumn<dataType> persistence{};
+    /** Pair type */
+    DiagramColumn<SimplexId> pairType{};
+    /** Pair birth */
+    DiagramColumn<dataType> birth{};
+    /** Pair death */
+    DiagramColumn<dataType> death{};
+    /** Low pair element 3D coordinates */
+    DiagramColumn<float> birthX{}, birthY{}, birthZ{};
+    /** High pair element 3D coordinates */
+    DiagramColumn<float> deathX{}, deathY{}, deathZ{};
+
+    /** Pair classes, see getPairClasses() */
+    enum PairClass : unsigned char {
+      MIN_PAIR = 1,
+      SADDLE_PAIR = 2,
+      MAX_PAIR = 4,
+    };
+
+    inline size_t size() const {
+      return this->birth.size();
+    }
+
+    inline bool empty() const {
+      return this->birth.empty();
+    }
+
+    void resize(const size_t n) {
+      this->birthVertex.resize(n);
+      this->birthType.resize(n);
+      this->deathVertex.resize(n);
+      this->deathType.resize(n);
+      this->persistence.resize(n);
+      this->pairType.resize(n);
+      this->birth.resize(n);
+      this->death.resize(n);
+      this->birthX.resize(n);
+      this->birthY.resize(n);
+      this->birthZ.resize(n);
+      this->deathX.resize(n);
+      this->deathY.resize(n);
+      this->deathZ.resize(n);
+    }
+
+    inline void clear() {
+      *this = PersistenceDiagramColumns{};
+    }
+
+    /**
+     * @brief Own every column (copy the shared and viewed ones)
+     */
+    void detach() {
+      this->birthVertex.detach();
+      this->birthType.detach();
+      this->deathVertex.detach();
+      this->deathType.detach();
+      this->persistence.detach();
+      this->pairType.detach();
+      this->birth.detach();
+      this->death.detach();
+      this->birthX.detach();
+      this->birthY.detach();
+      this->birthZ.detach();
+      this->deathX.detach();
+      this->deathY.detach();
+      this->deathZ.detach();
+    }
+
+    /**
+     * @brief Copy the i-th pair of @p other at position @p j
+     */
+    inline void setPair(const size_t j,
+                        const PersistenceDiagramColumns &other,
+                        const size_t i) {
+      this->birthVertex[j] = other.birthVertex[i];
+      this->birthType[j] = other.birthType[i];
+      this->deathVertex[j] = other.deathVertex[i];
+      this->deathType[j] = other.deathType[i];
+      this->persistence[j] = other.persistence[i];
+      this->pairType[j] = other.pairType[i];
+      this->birth[j] = other.birth[i];
+      this->death[j] = other.death[i];
+      this->birthX[j] = other.birthX[i];
+      this->birthY[j] = other.birthY[i];
+      this->birthZ[j] = other.birthZ[i];
+      this->deathX[j] = other.deathX[i];
+      this->deathY[j] = other.deathY[i];
+      this->deathZ[j] = other.deathZ[i];
+    }
+
+    /**
+     * @brief Extract the pairs of @p other listed in @p ids (in order)
+     */
+    template <typename IdType>
+    void gather(const PersistenceDiagramColumns &other,
+                const std::vector<IdType> &ids) {
+      PersistenceDiagramColumns res{};
+      res.resize(ids.size());
+      gatherColumn(res.birthVertex, other.birthVertex, ids);
+      gatherColumn(res.birthType, other.birthType, ids);
+      gatherColumn(res.deathVertex, other.deathVertex, ids);
+      gatherColumn(res.deathType, other.deathType, ids);
+      gatherColumn(res.persistence, other.persistence, ids);
+      gatherColumn(res.pairType, other.pairType, ids);
+      gatherColumn(res.birth, other.birth, ids);
+      gatherColumn(res.death, other.death, ids);
+      gatherColumn(res.birthX, other.birthX, ids);
+      gatherColumn(res.birthY, other.birthY, ids);
+      gatherColumn(res.birthZ, other.birthZ, ids);
+      gatherColumn(res.deathX, other.deathX, ids);
+      gatherColumn(res.deathY, other.deathY, ids);
+      gatherColumn(res.deathZ, other.deathZ, ids);
+      *this = std::move(res);
+    }
+
+    /**
+     * @brief Classes of the pairs, bitwise OR of PairClass values
+     *
+     * A pair with a maximum is a MAX_PAIR, a pair with a minimum a
+     * MIN_PAIR (a minimum-maximum pair only is a MAX_PAIR) and a
+     * saddle-saddle pair a SADDLE_PAIR.
+     */
+    void getPairClasses(std::vector<unsigned char> &classes) const {
+      const size_t n = this->size();
+      classes.resize(n);
+      const CriticalType *const t1 = this->birthType.data();
+      const CriticalType *const t2 = this->deathType.data();
+      unsigned char *const res = classes.data();
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < n; ++i) {
+        const bool min1 = t1[i] == CriticalType::Local_minimum;
+        const bool max1 = t1[i] == CriticalType::Local_maximum;
+        const bool min2 = t2[i] == CriticalType::Local_minimum;
+        const bool max2 = t2[i] == CriticalType::Local_maximum;
+        const bool sad
+          = (t1[i] == CriticalType::Saddle1 && t2[i] == CriticalType::Saddle2)
+            || (t1[i] == CriticalType::Saddle2
+                && t2[i] == CriticalType::Saddle1);
+        const bool minMax = min1 && max2;
+        res[i] = static_cast<unsigned char>(
+          ((min1 || min2) && !minMax ? MIN_PAIR : 0)
+          | (sad && !minMax ? SADDLE_PAIR : 0) | (max1 || max2 ? MAX_PAIR : 0));
+      }
+    }
+
+    /**
+     * @brief Fill the columns from a vector of diagram tuples
+     *
+     * @p TupleType follows the ttk::DiagramTuple field order (vertex
+     * identifiers and critical types of both extrema, persistence, pair
+     * type, birth and its coordinates, death and its coordinates).
+     */
+    template <typename TupleType>
+    void fromTuples(const std::vector<TupleType> &diagram) {
+      const size_t n = diagram.size();
+      PersistenceDiagramColumns res{};
+      res.resize(n);
+      SimplexId *const v1 = res.birthVertex.data();
+      CriticalType *const t1 = res.birthType.data();
+      SimplexId *const v2 = res.deathVertex.data();
+      CriticalType *const t2 = res.deathType.data();
+      dataType *const pers = res.persistence.data();
+      SimplexId *const type = res.pairType.data();
+      dataType *const b = res.birth.data();
+      dataType *const d = res.death.data();
+      float *const bx = res.birthX.data();
+      float *const by = res.birthY.data();
+      float *const bz = res.birthZ.data();
+      float *const dx = res.deathX.data();
+      float *const dy = res.deathY.data();
+      float *const dz = res.deathZ.data();
+      for(size_t i = 0; i < n; ++i) {
+        const auto &t = diagram[i];
+        v1[i] = std::get<0>(t);
+        t1[i] = std::get<1>(t);
+        v2[i] = std::get<2>(t);
+        t2[i] = std::get<3>(t);
+        pers[i] = std::get<4>(t);
+        type[i] = std::get<5>(t);
+        b[i] = std::get<6>(t);
+        bx[i] = std::get<7>(t);
+        by[i] = std::get<8>(t);
+        bz[i] = std::get<9>(t);
+        d[i] = std::get<10>(t);
+        dx[i] = std::get<11>(t);
+        dy[i] = std::get<12>(t);
+        dz[i] = std::get<13>(t);
+      }
+      *this = std::move(res);
+    }
+
+    /**
+     * @brief Build the tuple representation of the i-th pair
+     */
+    template <typename TupleType>
+    inline TupleType getTuple(const size_t i) const {
+      TupleType t;
+      std::get<0>(t) = this->birthVertex[i];
+      std::get<1>(t) = this->birthType[i];
+      std::get<2>(t) = this->deathVertex[i];
+      std::get<3>(t) = this->deathType[i];
+      std::get<4>(t) = this->persistence[i];
+      std::get<5>(t) = this->pairType[i];
+      std::get<6>(t) = this->birth[i];
+      std::get<7>(t) = this->birthX[i];
+      std::get<8>(t) = this->birthY[i];
+      std::get<9>(t) = this->birthZ[i];
+      std::get<10>(t) = this->death[i];
+      std::get<11>(t) = this->deathX[i];
+      std::get<12>(t) = this->deathY[i];
+      std::get<13>(t) = this->deathZ[i];
+      return t;
+    }
+
+    /**
+     * @brief Convert the columns back to a vector of diagram tuples
+     */
+    template <typename TupleType>
+    void toTuples(std::vector<TupleType> &diagram) const {
+      diagram.resize(this->size());
+      for(size_t i = 0; i < this->size(); ++i) {
+        diagram[i] = this->getTuple<TupleType>(i);
+      }
+    }
+
+    bool operator==(const PersistenceDiagramColumns &other) const {
+      return this->birthVertex == other.birthVertex
+             && this->birthType == other.birthType
+             && this->deathVertex == other.deathVertex
+             && this->deathType == other.deathType
+             && this->persistence == other.persistence
+             && this->pairType == other.pairType && this->birth == other.birth
+             && this->death == other.death && this->birthX == other.birthX
+             && this->birthY == other.birthY && this->birthZ == other.birthZ
+             && this->deathX == other.deathX && this->deathY == other.deathY
+             && this->deathZ == other.deathZ;
+    }
+
+  private:
+    template <typename T, typename IdType>
+    static void gatherColumn(DiagramColumn<T> &dst,
+                             const DiagramColumn<T> &src,
+                             const std::vector<IdType> &ids) {
+      T *const out = dst.data();
+      const T *const in = src.data();
+      for(size_t j = 0; j < ids.size(); ++j) {
+        out[j] = in[ids[j]];
+      }
+    }
+  };
+
+} // namespace ttk
@@ -6,6 +6,14 @@
 /// \brief TTK processing package that computes the continuous scatterplot of
 /// bivariate volumetric data.
 ///
+/// The projected tetrahedra are splatted by a tiled rasterizer: the
+/// scatterplot is cut into square tiles and every thread accumulates
+/// into its own copy of the tiles it touches (allocated on first use).
+/// The thread tiles are summed into the output buffers at the end, so
+/// no synchronization is needed during the splatting. The output density
+/// and mask are single contiguous buffers of resolutionX x resolutionY
+/// values, the pixel (i, j) being stored at index i * resolutionY + j.
+///
 /// \b Related \b publication \n
 /// "Continuous Scatterplots" \n
 /// Sven Bachthaler, Daniel Weiskopf \n
@@ -16,7 +24,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <vector>
 
 // base code includes
 #include <Geometry.h>
@@ -67,12 +78,14 @@ namespace ttk {
       return 0;
     }
 
-    inline int setOutputDensity(std::vector<std::vector<double>> *density) {
+    /// Set the output density buffer (resolutionX x resolutionY values).
+    inline int setOutputDensity(double *density) {
       density_ = density;
       return 0;
     }
 
-    inline int setOutputMask(std::vector<std::vector<char>> *mask) {
+    /// Set the output mask buffer (resolutionX x resolutionY values).
+    inline int setOutputMask(char *mask) {
       validPointMask_ = mask;
       return 0;
     }
@@ -84,8 +97,8 @@ namespace ttk {
     SimplexId resolutions_[2];
     double *scalarMin_;
     double *scalarMax_;
-    std::vector<std::vector<double>> *density_;
-    std::vector<std::vector<char>> *validPointMask_;
+    double *density_;
+    char *validPointMask_;
   };
 } // namespace ttk
 
@@ -101,7 +114,7 @@ int ttk::ContinuousScatterPlot::execute(
     return -2;
   if(!triangulation)
     return -3;
-  if(!density_)
+  if(!density_ or !validPointMask_)
     return -4;
 
   if(triangulation->getNumberOfCells() <= 0) {
@@ -115,364 +128,434 @@ int ttk::ContinuousScatterPlot::execute(
   }
 #endif
 
+
   Timer t;
 
   // helpers:
   const SimplexId numberOfCells = triangulation->getNumberOfCells();
 
   // rendering helpers:
-  // constant ray direction (ortho)
-  const double d[3]{0, 0, -1};
   const double delta[2]{
     scalarMax_[0] - scalarMin_[0], scalarMax_[1] - scalarMin_[1]};
   const double sampling[2]{
     delta[0] / resolutions_[0], delta[1] / resolutions_[1]};
   const double epsilon{0.000001};
 
+  // tiling helpers:
+  const SimplexId tileSize{64};
+  const SimplexId tileNumber[2]{(resolutions_[0] + tileSize - 1) / tileSize,
+                                (resolutions_[1] + tileSize - 1) / tileSize};
+  const SimplexId numberOfTiles = tileNumber[0] * tileNumber[1];
+  // per-thread tiles, allocated on first touch
+  std::vector<std::vector<std::vector<double>>> threadDensity(threadNumber_);
+  std::vector<std::vector<std::vector<char>>> threadMask(threadNumber_);
+
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif
-  for(SimplexId cell = 0; cell < numberOfCells; ++cell) {
-    bool isDummy{};
-
-    // get tetrahedron info
-    SimplexId vertex[4];
-    double data[4][3];
-    float position[4][3];
-    double localScalarMin[2]{};
-    double localScalarMax[2]{};
-    // for each triangle
-    for(int k = 0; k < 4; ++k) {
-      // get indices
-      triangulation->getCellVertex(cell, k, vertex[k]);
-
-      // get scalars
-      data[k][0] = scalars1[vertex[k]];
-      data[k][1] = scalars2[vertex[k]];
-      data[k][2] = 0;
-
-      if(withDummyValue_
-         and (data[k][0] == dummyValue_ or data[k][1] == dummyValue_)) {
-        isDummy = true;
-        break;
-      }
+#pragma omp parallel num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  {
+#ifdef TTK_ENABLE_OPENMP
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif // TTK_ENABLE_OPENMP
+    auto &densityTiles = threadDensity[tid];
+    auto &maskTiles = threadMask[tid];
+    densityTiles.resize(numberOfTiles);
+    maskTiles.resize(numberOfTiles);
+
+    // splat of the current tetrahedron on a tile row (hits are 0 or 1,
+    // stored as doubles to keep the splat loop in a single vector type)
+    double weights[tileSize];
+    double hits[tileSize];
+
+    // static schedule: neighboring tetrahedra (hence tiles) per thread
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(static)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId cell = 0; cell < numberOfCells; ++cell) {
+      bool isDummy{};
+
+      // get tetrahedron info
+      SimplexId vertex[4];
+      double data[4][3];
+      float position[4][3];
+      double localScalarMin[2]{};
+      double localScalarMax[2]{};
+      // for each triangle
+      for(int k = 0; k < 4; ++k) {
+        // get indices
+        triangulation->getCellVertex(cell, k, vertex[k]);
+
+        // get scalars
+        data[k][0] = scalars1[vertex[k]];
+        data[k][1] = scalars2[vertex[k]];
+        data[k][2] = 0;
+
+        if(withDummyValue_
+           and (data[k][0] == dummyValue_ or data[k][1] == dummyValue_)) {
+          isDummy = true;
+          break;
+        }
 
-      // get local stats
-      if(!k or localScalarMin[0] > data[k][0])
-        localScalarMin[0] = data[k][0];
-      if(!k or localScalarMin[1] > data[k][1])
-        localScalarMin[1] = data[k][1];
-      if(!k or localScalarMax[0] < data[k][0])
-        localScalarMax[0] = data[k][0];
-      if(!k or localScalarMax[1] < data[k][1])
-        localScalarMax[1] = data[k][1];
+        // get local stats
+        if(!k or localScalarMin[0] > data[k][0])
+          localScalarMin[0] = data[k][0];
+        if(!k or localScalarMin[1] > data[k][1])
+          localScalarMin[1] = data[k][1];
+        if(!k or localScalarMax[0] < data[k][0])
+          localScalarMax[0] = data[k][0];
+        if(!k or localScalarMax[1] < data[k][1])
+          localScalarMax[1] = data[k][1];
 
-      // get positions
+        // get positions
 
-      triangulation->getVertexPoint(
-        vertex[k], position[k][0], position[k][1], position[k][2]);
-    }
-    if(isDummy)
-      continue;
-
-    // gradient:
-    double g0[3];
-    double g1[3];
-    {
-      double v12[3];
-      double v13[3];
-      double v14[3];
-      double s12[3];
-      double s13[3];
-      double s14[3];
-      for(int k = 0; k < 3; ++k) {
-        v12[k] = position[1][k] - position[0][k];
-        v13[k] = position[2][k] - position[0][k];
-        v14[k] = position[3][k] - position[0][k];
-
-        s12[k] = data[1][k] - data[0][k];
-        s13[k] = data[2][k] - data[0][k];
-        s14[k] = data[3][k] - data[0][k];
+        triangulation->getVertexPoint(
+          vertex[k], position[k][0], position[k][1], position[k][2]);
       }
+      if(isDummy)
+        continue;
 
-      double a[3];
-      double b[3];
-      double c[3];
-      Geometry::crossProduct(v13, v12, a);
-      Geometry::crossProduct(v12, v14, b);
-      Geometry::crossProduct(v14, v13, c);
-      double det = Geometry::dotProduct(v14, a);
-      if(det == 0.) {
+      // gradient:
+      double g0[3];
+      double g1[3];
+      {
+        double v12[3];
+        double v13[3];
+        double v14[3];
+        double s12[3];
+        double s13[3];
+        double s14[3];
         for(int k = 0; k < 3; ++k) {
-          g0[k] = 0.0;
-          g1[k] = 0.0;
+          v12[k] = position[1][k] - position[0][k];
+          v13[k] = position[2][k] - position[0][k];
+          v14[k] = position[3][k] - position[0][k];
+
+          s12[k] = data[1][k] - data[0][k];
+          s13[k] = data[2][k] - data[0][k];
+          s14[k] = data[3][k] - data[0][k];
         }
-      } else {
-        double invDet = 1.0 / det;
-        for(int k = 0; k < 3; ++k) {
-          g0[k] = (s14[0] * a[k] + s13[0] * b[k] + s12[0] * c[k]) * invDet;
-          g1[k] = (s14[1] * a[k] + s13[1] * b[k] + s12[1] * c[k]) * invDet;
+
+        double a[3];
+        double b[3];
+        double c[3];
+        Geometry::crossProduct(v13, v12, a);
+        Geometry::crossProduct(v12, v14, b);
+        Geometry::crossProduct(v14, v13, c);
+        double det = Geometry::dotProduct(v14, a);
+        if(det == 0.) {
+          for(int k = 0; k < 3; ++k) {
+            g0[k] = 0.0;
+            g1[k] = 0.0;
+          }
+        } else {
+          double invDet = 1.0 / det;
+          for(int k = 0; k < 3; ++k) {
+            g0[k] = (s14[0] * a[k] + s13[0] * b[k] + s12[0] * c[k]) * invDet;
+            g1[k] = (s14[1] * a[k] + s13[1] * b[k] + s12[1] * c[k]) * invDet;
+          }
         }
       }
-    }
 
-    // volume:
-    double volume;
-    bool isLimit{};
-    {
-      double cp[3];
-      Geometry::crossProduct(g0, g1, cp);
-      volume = Geometry::magnitude(cp);
-      if(volume == 0.)
-        isLimit = true;
-    }
+      // volume:
+      double volume;
+      bool isLimit{};
+      {
+        double cp[3];
+        Geometry::crossProduct(g0, g1, cp);
+        volume = Geometry::magnitude(cp);
+        if(volume == 0.)
+          isLimit = true;
+      }
 
-    // classification:
-    int index[4]{0, 1, 2, 3};
-    bool isInTriangle{};
-    if(Geometry::isPointInTriangle(data[0], data[1], data[2], data[3]))
-      isInTriangle = true;
-    else if(Geometry::isPointInTriangle(data[0], data[1], data[3], data[2])) {
-      isInTriangle = true;
-      index[0] = 0;
-      index[1] = 1;
-      index[2] = 3;
-      index[3] = 2;
-    } else if(Geometry::isPointInTriangle(data[0], data[2], data[3], data[1])) {
-      isInTriangle = true;
-      index[0] = 0;
-      index[1] = 2;
-      index[2] = 3;
-      index[3] = 1;
-    } else if(Geometry::isPointInTriangle(data[1], data[2], data[3], data[0])) {
-      isInTriangle = true;
-      index[0] = 1;
-      index[1] = 2;
-      index[2] = 3;
-      index[3] = 0;
-    }
+      // classification:
+      int index[4]{0, 1, 2, 3};
+      bool isInTriangle{};
+      if(Geometry::isPointInTriangle(data[0], data[1], data[2], data[3]))
+        isInTriangle = true;
+      else if(Geometry::isPointInTriangle(
+                data[0], data[1], data[3], data[2])) {
+        isInTriangle = true;
+        index[0] = 0;
+        index[1] = 1;
+        index[2] = 3;
+        index[3] = 2;
+      } else if(Geometry::isPointInTriangle(
+                  data[0], data[2], data[3], data[1])) {
+        isInTriangle = true;
+        index[0] = 0;
+        index[1] = 2;
+        index[2] = 3;
+        index[3] = 1;
+      } else if(Geometry::isPointInTriangle(
+                  data[1], data[2], data[3], data[0])) {
+        isInTriangle = true;
+        index[0] = 1;
+        index[1] = 2;
+        index[2] = 3;
+        index[3] = 0;
+      }
 
-    // projection:
-    double density{};
-    std::vector<std::vector<SimplexId>> triangles;
-    double imaginaryPosition[3]{};
-    std::vector<SimplexId> triangle(3);
-    // class 0
-    if(isInTriangle) {
-      // mass density
-      double massDensity{};
-      {
-        double A;
+      // projection:
+      double density{};
+      // projected triangles (apex, then the two other vertices)
+      int numberOfTriangles{};
+      const double *triangles[4][3];
+      double imaginaryPosition[3]{};
+      // class 0
+      if(isInTriangle) {
+        // mass density
+        double massDensity{};
+        {
+          double A;
+
+          Geometry::computeTriangleArea(
+            data[index[0]], data[index[1]], data[index[2]], A);
+          double invA = 1.0 / A;
+          if(A == 0.) {
+            invA = 0.0;
+            isLimit = true;
+          }
 
-        Geometry::computeTriangleArea(
-          data[index[0]], data[index[1]], data[index[2]], A);
-        double invA = 1.0 / A;
-        if(A == 0.) {
-          invA = 0.0;
-          isLimit = true;
-        }
+          double alpha, beta, gamma;
 
-        double alpha, beta, gamma;
+          Geometry::computeTriangleArea(
+            data[index[1]], data[index[2]], data[index[3]], alpha);
 
-        Geometry::computeTriangleArea(
-          data[index[1]], data[index[2]], data[index[3]], alpha);
+          Geometry::computeTriangleArea(
+            data[index[0]], data[index[2]], data[index[3]], beta);
 
-        Geometry::computeTriangleArea(
-          data[index[0]], data[index[2]], data[index[3]], beta);
+          Geometry::computeTriangleArea(
+            data[index[0]], data[index[1]], data[index[3]], gamma);
 
-        Geometry::computeTriangleArea(
-          data[index[0]], data[index[1]], data[index[3]], gamma);
+          alpha *= invA;
+          beta *= invA;
+          gamma *= invA;
 
-        alpha *= invA;
-        beta *= invA;
-        gamma *= invA;
+          double p0[3];
+          double p1[3];
+          for(int k = 0; k < 3; ++k) {
+            p0[k] = position[index[3]][k];
+
+            p1[k] = alpha * position[index[0]][k]
+                    + beta * position[index[1]][k]
+                    + gamma * position[index[2]][k];
+          }
+          massDensity = Geometry::distance(p0, p1);
+        }
+
+        if(isLimit)
+          density = std::numeric_limits<decltype(density)>::max();
+        else
+          density = massDensity / volume;
+
+        const int tris[3][3]{{index[3], index[0], index[1]},
+                             {index[3], index[0], index[2]},
+                             {index[3], index[1], index[2]}};
+        for(const auto &tr : tris) {
+          for(int k = 0; k < 3; ++k)
+            triangles[numberOfTriangles][k] = data[tr[k]];
+          ++numberOfTriangles;
+        }
+      }
+      // class 1
+      else {
+        double massDensity{};
+        double p[3]{0, 0, 0};
+        if(Geometry::computeSegmentIntersection(
+             data[0][0], data[0][1], data[1][0], data[1][1], data[2][0],
+             data[2][1], data[3][0], data[3][1], p[0], p[1])) {
+          index[0] = 0;
+          index[1] = 1;
+          index[2] = 2;
+          index[3] = 3;
+        } else if(Geometry::computeSegmentIntersection(
+                    data[0][0], data[0][1], data[2][0], data[2][1],
+                    data[1][0], data[1][1], data[3][0], data[3][1], p[0],
+                    p[1])) {
+          index[0] = 0;
+          index[1] = 2;
+          index[2] = 1;
+          index[3] = 3;
+        } else if(Geometry::computeSegmentIntersection(
+                    data[0][0], data[0][1], data[3][0], data[3][1],
+                    data[1][0], data[1][1], data[2][0], data[2][1], p[0],
+                    p[1])) {
+          index[0] = 0;
+          index[1] = 3;
+          index[2] = 1;
+          index[3] = 2;
+        }
+
+        double a = Geometry::distance(data[index[0]], p);
+        double b = Geometry::distance(data[index[0]], data[index[1]]);
+        double r0 = a / b;
+
+        a = Geometry::distance(data[index[2]], p);
+        b = Geometry::distance(data[index[2]], data[index[3]]);
+        double r1 = a / b;
 
         double p0[3];
         double p1[3];
         for(int k = 0; k < 3; ++k) {
-          p0[k] = position[index[3]][k];
 
-          p1[k] = alpha * position[index[0]][k] + beta * position[index[1]][k]
-                  + gamma * position[index[2]][k];
+          p0[k] = position[index[0]][k]
+                  + r0 * (position[index[1]][k] - position[index[0]][k]);
+
+          p1[k] = position[index[2]][k]
+                  + r1 * (position[index[3]][k] - position[index[2]][k]);
         }
         massDensity = Geometry::distance(p0, p1);
+
+        if(isLimit)
+          density = std::numeric_limits<decltype(density)>::max();
+        else
+          density = massDensity / volume;
+
+        imaginaryPosition[0] = p[0];
+        imaginaryPosition[1] = p[1];
+        imaginaryPosition[2] = 0;
+
+        // four triangles projection (around the new geometry)
+        const int tris[4][2]{{index[0], index[2]},
+                             {index[2], index[1]},
+                             {index[1], index[3]},
+                             {index[3], index[0]}};
+        for(const auto &tr : tris) {
+          triangles[numberOfTriangles][0] = imaginaryPosition;
+          triangles[numberOfTriangles][1] = data[tr[0]];
+          triangles[numberOfTriangles][2] = data[tr[1]];
+          ++numberOfTriangles;
+        }
       }
 
-      if(isLimit)
-        density = std::numeric_limits<decltype(density)>::max();
-      else
-        density = massDensity / volume;
-
-      triangle[0] = vertex[index[3]];
-      triangle[1] = vertex[index[0]];
-      triangle[2] = vertex[index[1]];
-      triangles.push_back(triangle);
-
-      triangle[0] = vertex[index[3]];
-      triangle[1] = vertex[index[0]];
-      triangle[2] = vertex[index[2]];
-      triangles.push_back(triangle);
-
-      triangle[0] = vertex[index[3]];
-      triangle[1] = vertex[index[1]];
-      triangle[2] = vertex[index[2]];
-      triangles.push_back(triangle);
-    }
-    // class 1
-    else {
-      double massDensity{};
-      double p[3]{0, 0, 0};
-      if(Geometry::computeSegmentIntersection(
-           data[0][0], data[0][1], data[1][0], data[1][1], data[2][0],
-           data[2][1], data[3][0], data[3][1], p[0], p[1])) {
-        index[0] = 0;
-        index[1] = 1;
-        index[2] = 2;
-        index[3] = 3;
-      } else if(Geometry::computeSegmentIntersection(
-                  data[0][0], data[0][1], data[2][0], data[2][1], data[1][0],
-                  data[1][1], data[3][0], data[3][1], p[0], p[1])) {
-        index[0] = 0;
-        index[1] = 2;
-        index[2] = 1;
-        index[3] = 3;
-      } else if(Geometry::computeSegmentIntersection(
-                  data[0][0], data[0][1], data[3][0], data[3][1], data[1][0],
-                  data[1][1], data[2][0], data[2][1], p[0], p[1])) {
-        index[0] = 0;
-        index[1] = 3;
-        index[2] = 1;
-        index[3] = 2;
+      // rendering:
+      // "Fast, Minimum Storage Ray/Triangle Intersection", Tomas Moller &
+      // Ben Trumbore, with the constant ray direction (0, 0, -1) of the
+      // orthographic projection folded into the 2D expressions below.
+      double origins[4][2];
+      double edges[4][2];
+      double normals[4][2];
+      double inverses[4];
+      int numberOfSplats{};
+      for(int k = 0; k < numberOfTriangles; ++k) {
+        const double *p0 = triangles[k][0];
+        const double e1[2]{
+          triangles[k][1][0] - p0[0], triangles[k][1][1] - p0[1]};
+        const double e2[2]{
+          triangles[k][2][0] - p0[0], triangles[k][2][1] - p0[1]};
+        // q = d x e2
+        const double q[2]{e2[1], -e2[0]};
+        const double a = e1[0] * q[0] + e1[1] * q[1];
+        if(a > -epsilon and a < epsilon)
+          continue;
+        origins[numberOfSplats][0] = p0[0];
+        origins[numberOfSplats][1] = p0[1];
+        edges[numberOfSplats][0] = e1[0];
+        edges[numberOfSplats][1] = e1[1];
+        normals[numberOfSplats][0] = q[0];
+        normals[numberOfSplats][1] = q[1];
+        inverses[numberOfSplats] = 1.0 / a;
+        ++numberOfSplats;
       }
 
-      double a = Geometry::distance(data[index[0]], p);
-      double b = Geometry::distance(data[index[0]], data[index[1]]);
-      double r0 = a / b;
+      const SimplexId minI = std::max<SimplexId>(
+        0, floor((localScalarMin[0] - scalarMin_[0]) / sampling[0]));
+      const SimplexId minJ = std::max<SimplexId>(
+        0, floor((localScalarMin[1] - scalarMin_[1]) / sampling[1]));
+      const SimplexId maxI = std::min<SimplexId>(
+        resolutions_[0],
+        ceil((localScalarMax[0] - scalarMin_[0]) / sampling[0]));
+      const SimplexId maxJ = std::min<SimplexId>(
+        resolutions_[1],
+        ceil((localScalarMax[1] - scalarMin_[1]) / sampling[1]));
 
-      a = Geometry::distance(data[index[2]], p);
-      b = Geometry::distance(data[index[2]], data[index[3]]);
-      double r1 = a / b;
+      for(SimplexId i = minI; i < maxI; ++i) {
+        // set ray origin (first coordinate)
+        const double ox = scalarMin_[0] + i * sampling[0];
+        const SimplexId tileI = i / tileSize;
+        const SimplexId rowOffset = (i - tileI * tileSize) * tileSize;
+
+        // row segments in the tiles
+        for(SimplexId j0 = minJ; j0 < maxJ;) {
+          const SimplexId tileJ = j0 / tileSize;
+          const SimplexId j1 = std::min(maxJ, (tileJ + 1) * tileSize);
+          const SimplexId n = j1 - j0;
+
+          for(SimplexId l = 0; l < n; ++l) {
+            weights[l] = 0.0;
+            hits[l] = 0.0;
+          }
 
-      double p0[3];
-      double p1[3];
-      for(int k = 0; k < 3; ++k) {
+          // every ray keeps the weight of the first triangle it hits
+          for(int k = 0; k < numberOfSplats; ++k) {
+            const double sx = ox - origins[k][0];
+            const double f = inverses[k];
+            const double q[2]{normals[k][0], normals[k][1]};
+            const double e1[2]{edges[k][0], edges[k][1]};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd
+#endif // TTK_ENABLE_OPENMP
+            for(SimplexId l = 0; l < n; ++l) {
+              const double oy = scalarMin_[1] + (j0 + l) * sampling[1];
+              const double sy = oy - origins[k][1];
+              const double u = f * (sx * q[0] + sy * q[1]);
+              const double v = f * -(sx * e1[1] - sy * e1[0]);
+              // (no short-circuit: branch-free for vectorization)
+              const bool hit = (hits[l] == 0.0) & (u >= 0.0) & (v >= 0.0)
+                               & ((u + v) <= 1.0);
+              weights[l] += hit ? (1.0 - u - v) * density : 0.0;
+              hits[l] += hit ? 1.0 : 0.0;
+            }
+          }
 
-        p0[k] = position[index[0]][k]
-                + r0 * (position[index[1]][k] - position[index[0]][k]);
+          // accumulate in the thread tile
+          const SimplexId tile = tileI * tileNumber[1] + tileJ;
+          if(densityTiles[tile].empty()) {
+            densityTiles[tile].resize(tileSize * tileSize, 0.0);
+            maskTiles[tile].resize(tileSize * tileSize, 0);
+          }
+          double *densityRow
+            = densityTiles[tile].data() + rowOffset + j0 - tileJ * tileSize;
+          char *maskRow
+            = maskTiles[tile].data() + rowOffset + j0 - tileJ * tileSize;
+          for(SimplexId l = 0; l < n; ++l) {
+            densityRow[l] += weights[l];
+            maskRow[l] |= (hits[l] != 0.0);
+          }
 
-        p1[k] = position[index[2]][k]
-                + r1 * (position[index[3]][k] - position[index[2]][k]);
+          j0 = j1;
+        }
       }
-      massDensity = Geometry::distance(p0, p1);
-
-      if(isLimit)
-        density = std::numeric_limits<decltype(density)>::max();
-      else
-        density = massDensity / volume;
-
-      imaginaryPosition[0] = p[0];
-      imaginaryPosition[1] = p[1];
-      imaginaryPosition[2] = 0;
-
-      // four triangles projection
-      triangle[0] = -1; // new geometry
-      triangle[1] = vertex[index[0]];
-      triangle[2] = vertex[index[2]];
-      triangles.push_back(triangle);
-
-      triangle[1] = vertex[index[2]];
-      triangle[2] = vertex[index[1]];
-      triangles.push_back(triangle);
-
-      triangle[1] = vertex[index[1]];
-      triangle[2] = vertex[index[3]];
-      triangles.push_back(triangle);
-
-      triangle[1] = vertex[index[3]];
-      triangle[2] = vertex[index[0]];
-      triangles.push_back(triangle);
     }
+  }
 
-    // rendering:
-    // "Fast, Minimum Storage Ray/Triangle Intersection", Tomas Moller & Ben
-    // Trumbore
-    {
-      const SimplexId minI
-        = floor((localScalarMin[0] - scalarMin_[0]) / sampling[0]);
-      const SimplexId minJ
-        = floor((localScalarMin[1] - scalarMin_[1]) / sampling[1]);
-      const SimplexId maxI
-        = ceil((localScalarMax[0] - scalarMin_[0]) / sampling[0]);
-      const SimplexId maxJ
-        = ceil((localScalarMax[1] - scalarMin_[1]) / sampling[1]);
-
-      for(SimplexId i = minI; i < maxI; ++i) {
-        for(SimplexId j = minJ; j < maxJ; ++j) {
-          // set ray origin
-          const double o[3]{scalarMin_[0] + i * sampling[0],
-                            scalarMin_[1] + j * sampling[1], 1};
-          for(unsigned int k = 0; k < triangles.size(); ++k) {
-            const auto &tr = triangles[k];
-
-            // get triangle info
-            double p0[3];
-            if(isInTriangle) {
-              p0[0] = scalars1[tr[0]];
-              p0[1] = scalars2[tr[0]];
-            } else {
-              p0[0] = imaginaryPosition[0];
-              p0[1] = imaginaryPosition[1];
-            }
-            p0[2] = 0;
-
-            const double p1[3]{
-              (double)scalars1[tr[1]], (double)scalars2[tr[1]], 0};
-            const double p2[3]{
-              (double)scalars1[tr[2]], (double)scalars2[tr[2]], 0};
-            const double e1[3]{p1[0] - p0[0], p1[1] - p0[1], 0};
-            const double e2[3]{p2[0] - p0[0], p2[1] - p0[1], 0};
-
-            double q[3];
-            Geometry::crossProduct(d, e2, q);
-            const double a = Geometry::dotProduct(e1, q);
-            if(a > -epsilon and a < epsilon)
-              continue;
-
-            const double f = 1.0 / a;
-            const double s[3]{o[0] - p0[0], o[1] - p0[1], 1};
-            const double u = f * Geometry::dotProduct(s, q);
-            if(u < 0.0)
-              continue;
-
-            double r[3];
-            Geometry::crossProduct(s, e1, r);
-            const double v = f * Geometry::dotProduct(d, r);
-            if(v < 0.0 or (u + v) > 1.0)
-              continue;
-
-              // triangle/ray intersection below
-#ifdef TTK_ENABLE_OPENMP
-#ifdef _WIN32
-#pragma omp atomic
-#else
-#pragma omp atomic update
-#endif
-#endif
-            (*density_)[i][j] += (1.0 - u - v) * density;
-
+  // reduction of the thread tiles into the output buffers
 #ifdef TTK_ENABLE_OPENMP
-#ifdef _WIN32
-#pragma omp atomic
-            (*validPointMask_)[i][j] += 1;
-#else
-#pragma omp atomic write
-            (*validPointMask_)[i][j] = 1;
-#endif
-#else
-            (*validPointMask_)[i][j] = 1;
-#endif
-            break;
-          }
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId tile = 0; tile < numberOfTiles; ++tile) {
+    const SimplexId tileI = tile / tileNumber[1];
+    const SimplexId tileJ = tile % tileNumber[1];
+    const SimplexId i0 = tileI * tileSize;
+    const SimplexId j0 = tileJ * tileSize;
+    const SimplexId n = std::min(tileSize, resolutions_[1] - j0);
+
+    for(SimplexId i = i0; i < std::min(i0 + tileSize, resolutions_[0]); ++i) {
+      double *densityRow = density_ + i * resolutions_[1] + j0;
+      char *maskRow = validPointMask_ + i * resolutions_[1] + j0;
+      const SimplexId rowOffset = (i - i0) * tileSize;
+
+      std::fill(densityRow, densityRow + n, 0.0);
+      std::fill(maskRow, maskRow + n, 0);
+      for(int thread = 0; thread < threadNumber_; ++thread) {
+        if(threadDensity[thread].empty() or threadDensity[thread][tile].empty())
+          continue;
+        const double *densityTile = threadDensity[thread][tile].data();
+        const char *maskTile = threadMask[thread][tile].data();
+        for(SimplexId l = 0; l < n; ++l) {
+          densityRow[l] += densityTile[rowOffset + l];
+          maskRow[l] |= maskTile[rowOffset + l];
         }
       }
     }
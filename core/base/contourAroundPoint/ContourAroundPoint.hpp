@@ -54,6 +54,9 @@ namespace ttk {
      * \param radius If all vertices lie on a shpere and the output is supposed
      *        to do so as well, pass the radius of the sphere here or -1 to have
      *        it computed. The default 0 signals that the data is not spherical.
+     * \param memoryBudget If non-zero, memory budget in bytes of the vertex
+     *        neighbors, computed by blocks on demand on explicit meshes (the
+     *        other relations are fully preconditioned).
      * \return 0 upon success, negative values otherwise.
      * \sa ttk::Triangulation
      */
@@ -61,7 +64,8 @@ namespace ttk {
     int setInputField(triangulationType *triangulation,
                       void *scalars,
                       double sizeFilter,
-                      double radius = 0.);
+                      double radius = 0.,
+                      std::size_t memoryBudget = 0);
 
     /**
      * Input the point data (e.g. from the wrapped algorithm).
@@ -207,7 +211,8 @@ template <class Triang>
 int ttk::ContourAroundPoint::setInputField(Triang *triangulation,
                                            void *scalars,
                                            double sizeFilter,
-                                           double radius) {
+                                           double radius,
+                                           std::size_t memoryBudget) {
 
   if(!triangulation)
     return -1;
@@ -232,7 +237,7 @@ int ttk::ContourAroundPoint::setInputField(Triang *triangulation,
   // for getVertexEdgeNumber, getVertexEdge
   triangulation->preconditionVertexEdges();
   // for getVertexNeighbor
-  triangulation->preconditionVertexNeighbors();
+  triangulation->preconditionVertexNeighbors(memoryBudget);
   // for getEdgeVertex
   triangulation->preconditionEdges();
   // for getEdgeTriangleNumber, getEdgeTriangle
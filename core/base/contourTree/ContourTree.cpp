@@ -209,14 +209,15 @@ int SubLevelSetTree::build() {
   if((minimumList_) && (maximumList_))
     return -6;
 
-  vector<UnionFind> seeds;
+  // one set per extremum, vertices point to the set of their extremum
+  UnionFindArena seeds;
   vector<vector<int>> seedSuperArcs;
-  vector<UnionFind *> vertexSeeds(vertexNumber_, (UnionFind *)NULL);
-  vector<UnionFind *> starSets;
+  vector<SimplexId> vertexSeeds(vertexNumber_, -1);
+  vector<SimplexId> starSets;
   vector<bool> visitedVertices(vertexNumber_, false);
 
   SimplexId vertexId = -1, nId = -1;
-  UnionFind *seed = NULL, *firstUf = NULL;
+  SimplexId seed = -1, firstUf = -1;
 
   const vector<int> *extremumList = NULL;
 
@@ -241,12 +242,12 @@ int SubLevelSetTree::build() {
     filtrationCtCmp>
     filtrationFront;
 
-  seeds.resize(extremumList->size());
+  seeds.reset(extremumList->size());
   seedSuperArcs.resize(seeds.size());
 
   for(int i = 0; i < (int)extremumList->size(); i++) {
     // link each minimum to a union find seed
-    vertexSeeds[(*extremumList)[i]] = &(seeds[i]);
+    vertexSeeds[(*extremumList)[i]] = i;
 
     // open an arc
     seedSuperArcs[i].push_back(openSuperArc(makeNode((*extremumList)[i])));
@@ -272,19 +273,19 @@ int SubLevelSetTree::build() {
     starSets.clear();
 
     merge = false;
-    firstUf = NULL;
+    firstUf = -1;
 
     SimplexId neighborNumber
       = triangulation_->getVertexNeighborNumber(vertexId);
     for(SimplexId i = 0; i < neighborNumber; i++) {
       triangulation_->getVertexNeighbor(vertexId, i, nId);
 
-      if(vertexSeeds[nId]) {
-        seed = vertexSeeds[nId]->find();
+      if(vertexSeeds[nId] != -1) {
+        seed = seeds.find(vertexSeeds[nId]);
         starSets.push_back(seed);
 
         // is it merging things?
-        if(!firstUf)
+        if(firstUf == -1)
           firstUf = seed;
         else if(seed != firstUf)
           merge = true;
@@ -303,9 +304,11 @@ int SubLevelSetTree::build() {
       }
     }
 
-    if(!vertexSeeds[vertexId]) {
+    if(vertexSeeds[vertexId] == -1) {
 
-      vertexSeeds[vertexId] = UnionFind::makeUnion(starSets);
+      for(size_t i = 0; i < starSets.size(); i++) {
+        vertexSeeds[vertexId] = seeds.merge(starSets[0], starSets[i]);
+      }
 
       int newNodeId = makeNode(vertexId);
 
@@ -313,7 +316,7 @@ int SubLevelSetTree::build() {
 
         vector<int> seedIds;
         for(int i = 0; i < (int)starSets.size(); i++) {
-          int seedId = starSets[i] - &(seeds[0]);
+          int seedId = starSets[i];
           bool found = false;
           for(int j = 0; j < (int)seedIds.size(); j++) {
             if(seedIds[j] == seedId) {
@@ -331,12 +334,12 @@ int SubLevelSetTree::build() {
           closeSuperArc(superArcId, newNodeId);
         }
 
-        int seedId = vertexSeeds[vertexId] - &(seeds[0]);
+        int seedId = vertexSeeds[vertexId];
         if(!filtrationFront.empty())
           seedSuperArcs[seedId].push_back(openSuperArc(newNodeId));
       } else if(starSets.size()) {
         // we're dealing with a degree-2 node
-        int seedId = starSets[0] - &(seeds[0]);
+        int seedId = starSets[0];
         int superArcId
           = seedSuperArcs[seedId][seedSuperArcs[seedId].size() - 1];
 
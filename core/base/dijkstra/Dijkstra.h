@@ -7,6 +7,7 @@
 #include <functional>
 #include <limits>
 #include <queue>
+#include <tuple>
 
 namespace ttk {
   namespace Dijkstra {
@@ -112,5 +113,252 @@ namespace ttk {
       return 0;
     }
 
+    /**
+     * @brief Compare two (distance, source index) labels
+     *
+     * @return true if the first label is strictly better (closer,
+     * or as close but to a source of lower index)
+     */
+    template <typename T>
+    inline bool isCloser(const T dist0,
+                         const SimplexId source0,
+                         const T dist1,
+                         const SimplexId source1) {
+      return dist0 < dist1 || (dist0 == dist1 && source0 < source1);
+    }
+
+    /**
+     * @brief Compute the shortest paths to the nearest of several sources
+     * in a single pass (multi-source Dijkstra)
+     *
+     * Every vertex is labelled with its distance to the nearest source
+     * and the index of this source (ties are broken with the lowest
+     * source index).
+     *
+     * @param[in] sources Source vertices
+     * @param[in] triangulation Access to neighbor vertices
+     * @param[out] outputDists Distances to the nearest source for every
+     * mesh vertex (infinity if not reachable)
+     * @param[out] outputSources Index in @p sources of the nearest source
+     * for every mesh vertex (-1 if not reachable)
+     *
+     * @return 0 in case of success
+     */
+    template <typename T,
+              typename triangulationType = ttk::AbstractTriangulation>
+    int multiSourceShortestPath(const std::vector<SimplexId> &sources,
+                                const triangulationType &triangulation,
+                                T *const outputDists,
+                                SimplexId *const outputSources) {
+
+      const SimplexId vertexNumber = triangulation.getNumberOfVertices();
+
+      std::fill(outputDists, outputDists + vertexNumber,
+                std::numeric_limits<T>::infinity());
+      std::fill(outputSources, outputSources + vertexNumber, -1);
+
+      // (distance, source index, vertex TTK id)
+      using pq_t = std::tuple<T, SimplexId, SimplexId>;
+
+      // a single priority queue for all the sources
+      std::priority_queue<pq_t, std::vector<pq_t>, std::greater<pq_t>> pq;
+
+      for(size_t i = 0; i < sources.size(); ++i) {
+        const auto source = sources[i];
+        if(source < 0 || source >= vertexNumber) {
+          return 1;
+        }
+        if(outputSources[source] == -1) {
+          outputDists[source] = T(0.0F);
+          outputSources[source] = i;
+          pq.emplace(T(0.0F), i, source);
+        }
+      }
+
+      while(!pq.empty()) {
+        const auto elem = pq.top();
+        pq.pop();
+        const auto vert = std::get<2>(elem);
+
+        // skip outdated queue entries
+        if(std::get<0>(elem) != outputDists[vert]
+           || std::get<1>(elem) != outputSources[vert]) {
+          continue;
+        }
+
+        std::array<float, 3> vCoords{};
+        triangulation.getVertexPoint(vert, vCoords[0], vCoords[1], vCoords[2]);
+
+        const auto nneigh = triangulation.getVertexNeighborNumber(vert);
+        for(SimplexId i = 0; i < nneigh; i++) {
+          SimplexId neigh{};
+          triangulation.getVertexNeighbor(vert, i, neigh);
+
+          std::array<float, 3> nCoords{};
+          triangulation.getVertexPoint(
+            neigh, nCoords[0], nCoords[1], nCoords[2]);
+          const T dist = outputDists[vert]
+                         + Geometry::distance(vCoords.data(), nCoords.data());
+
+          if(isCloser(dist, outputSources[vert], outputDists[neigh],
+                      outputSources[neigh])) {
+            outputDists[neigh] = dist;
+            outputSources[neigh] = outputSources[vert];
+            pq.emplace(dist, outputSources[vert], neigh);
+          }
+        }
+      }
+
+      return 0;
+    }
+
+    /**
+     * @brief Parallel multi-source shortest paths (delta-stepping)
+     *
+     * Same output as multiSourceShortestPath(). Vertices are processed
+     * by buckets of distance width @p delta: the neighbors of all the
+     * vertices of the current bucket are relaxed in parallel, until the
+     * bucket is empty.
+     *
+     * @param[in] sources Source vertices
+     * @param[in] triangulation Access to neighbor vertices
+     * @param[out] outputDists Distances to the nearest source for every
+     * mesh vertex (infinity if not reachable)
+     * @param[out] outputSources Index in @p sources of the nearest source
+     * for every mesh vertex (-1 if not reachable)
+     * @param[in] nThreads Number of threads
+     * @param[in] delta Bucket width (mean edge length if not positive)
+     *
+     * @return 0 in case of success
+     */
+    template <typename T,
+              typename triangulationType = ttk::AbstractTriangulation>
+    int deltaSteppingShortestPath(const std::vector<SimplexId> &sources,
+                                  const triangulationType &triangulation,
+                                  T *const outputDists,
+                                  SimplexId *const outputSources,
+                                  const int nThreads,
+                                  T delta = T(0.0F)) {
+
+      const SimplexId vertexNumber = triangulation.getNumberOfVertices();
+
+      std::fill(outputDists, outputDists + vertexNumber,
+                std::numeric_limits<T>::infinity());
+      std::fill(outputSources, outputSources + vertexNumber, -1);
+
+      const auto edgeLength = [&triangulation](const SimplexId a,
+                                               const SimplexId b) {
+        std::array<float, 3> pa{}, pb{};
+        triangulation.getVertexPoint(a, pa[0], pa[1], pa[2]);
+        triangulation.getVertexPoint(b, pb[0], pb[1], pb[2]);
+        return static_cast<T>(Geometry::distance(pa.data(), pb.data()));
+      };
+
+      if(delta <= T(0.0F)) {
+        // estimate the mean edge length on a vertex sample
+        const SimplexId step = std::max(vertexNumber / 1024, SimplexId{1});
+        T sum{};
+        SimplexId nEdges{};
+        for(SimplexId v = 0; v < vertexNumber; v += step) {
+          const auto nneigh = triangulation.getVertexNeighborNumber(v);
+          for(SimplexId i = 0; i < nneigh; i++) {
+            SimplexId neigh{};
+            triangulation.getVertexNeighbor(v, i, neigh);
+            sum += edgeLength(v, neigh);
+            nEdges++;
+          }
+        }
+        delta = (nEdges > 0 && sum > T(0.0F)) ? sum / nEdges : T(1.0F);
+      }
+
+      std::vector<std::vector<SimplexId>> buckets{};
+      const auto pushVertex = [&](const SimplexId v) {
+        const size_t b = outputDists[v] / delta;
+        if(b >= buckets.size()) {
+          buckets.resize(b + 1);
+        }
+        buckets[b].emplace_back(v);
+      };
+
+      for(size_t i = 0; i < sources.size(); ++i) {
+        const auto source = sources[i];
+        if(source < 0 || source >= vertexNumber) {
+          return 1;
+        }
+        if(outputSources[source] == -1) {
+          outputDists[source] = T(0.0F);
+          outputSources[source] = i;
+          pushVertex(source);
+        }
+      }
+
+      struct Request {
+        SimplexId vertex;
+        SimplexId source;
+        T dist;
+      };
+      std::vector<std::vector<Request>> requests(std::max(nThreads, 1));
+      std::vector<SimplexId> frontier{};
+      std::vector<bool> inFrontier(vertexNumber, false);
+
+      for(size_t b = 0; b < buckets.size(); ++b) {
+        while(!buckets[b].empty()) {
+
+          // remove duplicates & vertices moved to a lower bucket
+          frontier.clear();
+          for(const auto v : buckets[b]) {
+            const size_t vb = outputDists[v] / delta;
+            if(!inFrontier[v] && vb == b) {
+              inFrontier[v] = true;
+              frontier.emplace_back(v);
+            }
+          }
+          buckets[b].clear();
+          for(const auto v : frontier) {
+            inFrontier[v] = false;
+          }
+
+          // relax the neighbors of the frontier in parallel
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+          for(size_t i = 0; i < frontier.size(); ++i) {
+#ifdef TTK_ENABLE_OPENMP
+            const size_t tid = omp_get_thread_num();
+#else
+            const size_t tid = 0;
+#endif // TTK_ENABLE_OPENMP
+            const auto vert = frontier[i];
+            const auto nneigh = triangulation.getVertexNeighborNumber(vert);
+            for(SimplexId j = 0; j < nneigh; j++) {
+              SimplexId neigh{};
+              triangulation.getVertexNeighbor(vert, j, neigh);
+              const T dist = outputDists[vert] + edgeLength(vert, neigh);
+              if(isCloser(dist, outputSources[vert], outputDists[neigh],
+                          outputSources[neigh])) {
+                requests[tid].emplace_back(
+                  Request{neigh, outputSources[vert], dist});
+              }
+            }
+          }
+
+          // apply the relaxations (may refill the current bucket)
+          for(auto &threadRequests : requests) {
+            for(const auto &r : threadRequests) {
+              if(isCloser(r.dist, r.source, outputDists[r.vertex],
+                          outputSources[r.vertex])) {
+                outputDists[r.vertex] = r.dist;
+                outputSources[r.vertex] = r.source;
+                pushVertex(r.vertex);
+              }
+            }
+            threadRequests.clear();
+          }
+        }
+      }
+
+      return 0;
+    }
+
   } // namespace Dijkstra
 } // namespace ttk
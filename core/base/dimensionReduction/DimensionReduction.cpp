@@ -1,6 +1,10 @@
 #include <DimensionReduction.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <map>
+#include <random>
 
 #define VALUE_TO_STRING(x) #x
 #define VALUE(x) VALUE_TO_STRING(x)
@@ -38,6 +42,20 @@ DimensionReduction::DimensionReduction() {
 #endif
 }
 
+bool DimensionReduction::isNativeBackendUsed(const int method) const {
+  bool isSupported{false};
+  if(method == 2) // MDS
+    isSupported = mds_Metric;
+  else if(method == 3) // t-SNE
+    isSupported = tsne_Metric == "euclidean" || tsne_Metric == "precomputed";
+#ifdef TTK_ENABLE_SCIKIT_LEARN
+  // scikit-learn stays the default backend when available
+  return isSupported && UseNativeBackend;
+#else
+  return isSupported;
+#endif
+}
+
 bool DimensionReduction::isPythonFound() const {
 #ifdef TTK_ENABLE_SCIKIT_LEARN
   return true;
@@ -50,6 +68,9 @@ bool DimensionReduction::isPythonFound() const {
 }
 
 int DimensionReduction::execute() const {
+  if(this->isNativeBackendUsed(method_))
+    return this->executeNative();
+
 #ifdef TTK_ENABLE_SCIKIT_LEARN
 #ifndef TTK_ENABLE_KAMIKAZE
   if(majorVersion_ < '3')
@@ -360,7 +381,1081 @@ collect_garbage:
     Py_DECREF(i);
   return -1;
 
+#else
+  this->printErr("No native implementation for these parameters and "
+                 "scikit-learn support is disabled.");
+  return -1;
+#endif
+}
+
+namespace {
+  // squared dissimilarities between input rows: entries of a precomputed
+  // (distance) matrix or Euclidean distances between coordinate rows
+  class Dissimilarity {
+  public:
+    Dissimilarity(const double *const data,
+                  const SimplexId nRows,
+                  const SimplexId nColumns,
+                  const bool precomputed)
+      : data_{data}, nRows_{nRows}, nColumns_{nColumns},
+        precomputed_{precomputed} {
+    }
+
+    inline double squared(const SimplexId i, const SimplexId j) const {
+      if(precomputed_) {
+        const double d = data_[static_cast<size_t>(i) * nRows_ + j];
+        return d * d;
+      }
+      const double *const a = &data_[static_cast<size_t>(i) * nColumns_];
+      const double *const b = &data_[static_cast<size_t>(j) * nColumns_];
+      double res{};
+      for(SimplexId k = 0; k < nColumns_; ++k)
+        res += (a[k] - b[k]) * (a[k] - b[k]);
+      return res;
+    }
+
+    // t-SNE convention: squared Euclidean distances between coordinates,
+    // precomputed dissimilarities are used as given
+    inline double affinity(const SimplexId i, const SimplexId j) const {
+      if(precomputed_)
+        return data_[static_cast<size_t>(i) * nRows_ + j];
+      return this->squared(i, j);
+    }
+
+  private:
+    const double *const data_;
+    const SimplexId nRows_;
+    const SimplexId nColumns_;
+    const bool precomputed_;
+  };
+
+  // cyclic Jacobi eigensolver for small dense symmetric matrices (p x p,
+  // row-major), eigenvalues in decreasing order, eigenvectors column-wise
+  void symmetricEigen(std::vector<double> &a,
+                      const int p,
+                      std::vector<double> &values,
+                      std::vector<double> &vectors) {
+    std::vector<double> v(p * p, 0.0);
+    for(int i = 0; i < p; ++i)
+      v[i * p + i] = 1.0;
+
+    for(int sweep = 0; sweep < 64; ++sweep) {
+      double diag{}, off{};
+      for(int i = 0; i < p; ++i) {
+        diag += a[i * p + i] * a[i * p + i];
+        for(int j = i + 1; j < p; ++j)
+          off += a[i * p + j] * a[i * p + j];
+      }
+      if(off <= 1e-30 * diag || off == 0.0)
+        break;
+
+      for(int r = 0; r < p; ++r) {
+        for(int q = r + 1; q < p; ++q) {
+          const double arq = a[r * p + q];
+          if(arq == 0.0)
+            continue;
+          const double theta = (a[q * p + q] - a[r * p + r]) / (2.0 * arq);
+          const double t = (theta >= 0 ? 1.0 : -1.0)
+                           / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+          const double c = 1.0 / std::sqrt(t * t + 1.0);
+          const double s = t * c;
+          for(int k = 0; k < p; ++k) {
+            const double akr = a[k * p + r], akq = a[k * p + q];
+            a[k * p + r] = c * akr - s * akq;
+            a[k * p + q] = s * akr + c * akq;
+          }
+          for(int k = 0; k < p; ++k) {
+            const double ark = a[r * p + k], aqk = a[q * p + k];
+            a[r * p + k] = c * ark - s * aqk;
+            a[q * p + k] = s * ark + c * aqk;
+          }
+          for(int k = 0; k < p; ++k) {
+            const double vkr = v[k * p + r], vkq = v[k * p + q];
+            v[k * p + r] = c * vkr - s * vkq;
+            v[k * p + q] = s * vkr + c * vkq;
+          }
+        }
+      }
+    }
+
+    std::vector<int> order(p);
+    for(int i = 0; i < p; ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), [&a, p](const int i, const int j) {
+      return a[i * p + i] > a[j * p + j];
+    });
+
+    values.resize(p);
+    vectors.resize(p * p);
+    for(int c = 0; c < p; ++c) {
+      values[c] = a[order[c] * p + order[c]];
+      for(int k = 0; k < p; ++k)
+        vectors[k * p + c] = v[k * p + order[c]];
+    }
+  }
+
+  // modified Gram-Schmidt on the columns of a row-major (n x p) block,
+  // (numerically) dependent columns are replaced by random directions
+  void orthonormalize(std::vector<double> &y,
+                      const SimplexId n,
+                      const int p,
+                      std::mt19937 &rng,
+                      const int threadNumber) {
+    std::normal_distribution<double> normal{};
+
+    const auto columnNorm = [&](const int c) {
+      double sum{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) reduction(+ : sum)
+#endif // TTK_ENABLE_OPENMP
+      for(SimplexId i = 0; i < n; ++i)
+        sum += y[i * p + c] * y[i * p + c];
+      return std::sqrt(sum);
+    };
+
+    for(int c = 0; c < p; ++c) {
+      for(int attempt = 0; attempt < 4; ++attempt) {
+        const double norm0 = columnNorm(c);
+        // two passes for numerical orthogonality
+        for(int pass = 0; pass < 2; ++pass) {
+          for(int d = 0; d < c; ++d) {
+            double dot{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) reduction(+ : dot)
+#endif // TTK_ENABLE_OPENMP
+            for(SimplexId i = 0; i < n; ++i)
+              dot += y[i * p + c] * y[i * p + d];
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+            for(SimplexId i = 0; i < n; ++i)
+              y[i * p + c] -= dot * y[i * p + d];
+          }
+        }
+        const double norm = columnNorm(c);
+        if(norm > 0.0 && norm > 1e-10 * norm0) {
+          const double inv = 1.0 / norm;
+          for(SimplexId i = 0; i < n; ++i)
+            y[i * p + c] *= inv;
+          break;
+        }
+        for(SimplexId i = 0; i < n; ++i)
+          y[i * p + c] = normal(rng);
+      }
+    }
+  }
+
+  // subspace iteration with Rayleigh-Ritz projection for the k algebraically
+  // largest eigenpairs of a symmetric operator (Z = B * Y on row-major n x p
+  // blocks), eigenvectors are returned row-major (n x k)
+  //
+  // The iteration converges to the eigenvalues of largest magnitude: unless
+  // B is positive semi-definite, it is applied to B + shift * I, with shift
+  // bounding the magnitude of the negative eigenvalues
+  template <typename Operator>
+  int subspaceIteration(const Operator &apply,
+                        const SimplexId n,
+                        const int k,
+                        const int maxIteration,
+                        const bool semiDefinite,
+                        std::mt19937 &rng,
+                        std::vector<double> &eigenValues,
+                        std::vector<double> &eigenVectors,
+                        const int threadNumber) {
+
+    // a few extra vectors speed up the convergence of the k-th eigenpair
+    const int p = static_cast<int>(std::min<SimplexId>(n, k + 8));
+
+    std::normal_distribution<double> normal{};
+
+    double shift{};
+    if(!semiDefinite) {
+      // power iterations: estimate of the spectral radius of B (from below,
+      // hence the margin)
+      std::vector<double> v(n), bv(n);
+      for(auto &x : v)
+        x = normal(rng);
+      double radius{};
+      for(int iteration = 0; iteration < 20; ++iteration) {
+        double norm{};
+        for(const auto x : v)
+          norm += x * x;
+        norm = std::sqrt(norm);
+        if(norm == 0.0)
+          break;
+        for(auto &x : v)
+          x /= norm;
+        apply(v, bv, 1);
+        radius = 0.0;
+        for(const auto x : bv)
+          radius += x * x;
+        radius = std::sqrt(radius);
+        v.swap(bv);
+      }
+      shift = 1.1 * radius;
+    }
+    std::vector<double> y(static_cast<size_t>(n) * p), z(y.size());
+    for(auto &v : y)
+      v = normal(rng);
+    orthonormalize(y, n, p, rng, threadNumber);
+
+    std::vector<double> t(p * p), values, vectors, previous(p, 0.0);
+    int iteration = 0;
+    for(; iteration < std::max(1, maxIteration); ++iteration) {
+      apply(y, z, p);
+      if(shift != 0.0) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+        for(SimplexId i = 0; i < n * p; ++i)
+          z[i] += shift * y[i];
+      }
+
+      // Rayleigh quotient T = Y^T B Y
+      std::fill(t.begin(), t.end(), 0.0);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+      {
+        std::vector<double> local(p * p, 0.0);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for nowait
+#endif // TTK_ENABLE_OPENMP
+        for(SimplexId i = 0; i < n; ++i) {
+          for(int a = 0; a < p; ++a)
+            for(int b = 0; b < p; ++b)
+              local[a * p + b] += y[i * p + a] * z[i * p + b];
+        }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp critical
+#endif // TTK_ENABLE_OPENMP
+        for(int a = 0; a < p * p; ++a)
+          t[a] += local[a];
+      }
+      for(int a = 0; a < p; ++a)
+        for(int b = a + 1; b < p; ++b)
+          t[a * p + b] = t[b * p + a] = 0.5 * (t[a * p + b] + t[b * p + a]);
+
+      symmetricEigen(t, p, values, vectors);
+
+      // rotate B * Y onto the Ritz basis, sorted by decreasing Ritz values
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+      for(SimplexId i = 0; i < n; ++i) {
+        for(int c = 0; c < p; ++c) {
+          double sum{};
+          for(int d = 0; d < p; ++d)
+            sum += z[i * p + d] * vectors[d * p + c];
+          y[i * p + c] = sum;
+        }
+      }
+      orthonormalize(y, n, p, rng, threadNumber);
+
+      bool converged = iteration > 0;
+      const double scale = std::max(std::abs(values[0]), 1e-300);
+      for(int c = 0; c < k; ++c) {
+        if(std::abs(values[c] - previous[c]) > 1e-12 * scale)
+          converged = false;
+        previous[c] = values[c];
+      }
+      if(converged)
+        break;
+    }
+
+    eigenValues.assign(values.begin(), values.begin() + k);
+    for(auto &value : eigenValues)
+      value -= shift;
+    eigenVectors.resize(static_cast<size_t>(n) * k);
+    for(SimplexId i = 0; i < n; ++i)
+      for(int c = 0; c < k; ++c)
+        eigenVectors[i * k + c] = y[i * p + c];
+
+    return iteration;
+  }
+
+  // embedding coordinates from eigenpairs, with a deterministic sign per
+  // component (largest absolute entry positive)
+  void scaleEigenVectors(std::vector<double> &coordinates,
+                         const std::vector<double> &eigenValues,
+                         const SimplexId n,
+                         const int k) {
+    for(int c = 0; c < k; ++c) {
+      const double scale = std::sqrt(std::max(eigenValues[c], 0.0));
+      SimplexId arg = 0;
+      for(SimplexId i = 1; i < n; ++i)
+        if(std::abs(coordinates[i * k + c])
+           > std::abs(coordinates[arg * k + c]))
+          arg = i;
+      const double sign = coordinates[arg * k + c] < 0 ? -1.0 : 1.0;
+      for(SimplexId i = 0; i < n; ++i)
+        coordinates[i * k + c] *= sign * scale;
+    }
+  }
+
+} // namespace
+
+int DimensionReduction::computeClassicalMDS(std::vector<double> &coordinates,
+                                            const int nComponents,
+                                            const bool precomputed) const {
+  const SimplexId n = numberOfRows_;
+  const SimplexId m = numberOfColumns_;
+  const double *const matrix = static_cast<const double *>(matrix_);
+  const int threadNumber = threadNumber_;
+
+  std::mt19937 rng(randomState_ > 0 ? 0 : std::random_device{}());
+  std::vector<double> eigenValues;
+  int iterations{};
+
+  if(precomputed) {
+    // B * Y = -1/2 J D^2 J Y, with J the centering matrix; D^2 is read on
+    // the fly from the distance matrix
+    std::vector<double> centered{}, means{};
+    const auto apply = [&](const std::vector<double> &y, std::vector<double> &z,
+                           const int p) {
+      centered = y;
+      means.assign(p, 0.0);
+      for(SimplexId i = 0; i < n; ++i)
+        for(int c = 0; c < p; ++c)
+          means[c] += y[i * p + c] / n;
+      for(SimplexId i = 0; i < n; ++i)
+        for(int c = 0; c < p; ++c)
+          centered[i * p + c] -= means[c];
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+      {
+        std::vector<double> sum(p);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for
+#endif // TTK_ENABLE_OPENMP
+        for(SimplexId i = 0; i < n; ++i) {
+          const double *const row = &matrix[static_cast<size_t>(i) * n];
+          std::fill(sum.begin(), sum.end(), 0.0);
+          for(SimplexId j = 0; j < n; ++j) {
+            const double d2 = row[j] * row[j];
+            for(int c = 0; c < p; ++c)
+              sum[c] += d2 * centered[j * p + c];
+          }
+          for(int c = 0; c < p; ++c)
+            z[i * p + c] = -0.5 * sum[c];
+        }
+      }
+
+      means.assign(p, 0.0);
+      for(SimplexId i = 0; i < n; ++i)
+        for(int c = 0; c < p; ++c)
+          means[c] += z[i * p + c] / n;
+      for(SimplexId i = 0; i < n; ++i)
+        for(int c = 0; c < p; ++c)
+          z[i * p + c] -= means[c];
+    };
+    iterations
+      = subspaceIteration(apply, n, nComponents, mds_MaxIteration, false, rng,
+                          eigenValues, coordinates, threadNumber);
+  } else {
+    // for Euclidean distances, B = Xc * Xc^T with Xc the centered input
+    std::vector<double> xc(matrix, matrix + static_cast<size_t>(n) * m);
+    std::vector<double> means(m, 0.0);
+    for(SimplexId i = 0; i < n; ++i)
+      for(SimplexId c = 0; c < m; ++c)
+        means[c] += xc[i * m + c] / n;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < n; ++i)
+      for(SimplexId c = 0; c < m; ++c)
+        xc[i * m + c] -= means[c];
+
+    std::vector<double> w{};
+    const auto apply = [&](const std::vector<double> &y, std::vector<double> &z,
+                           const int p) {
+      // W = Xc^T * Y
+      w.assign(m * p, 0.0);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+      {
+        std::vector<double> local(m * p, 0.0);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for nowait
+#endif // TTK_ENABLE_OPENMP
+        for(SimplexId i = 0; i < n; ++i)
+          for(SimplexId a = 0; a < m; ++a)
+            for(int c = 0; c < p; ++c)
+              local[a * p + c] += xc[i * m + a] * y[i * p + c];
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp critical
+#endif // TTK_ENABLE_OPENMP
+        for(SimplexId a = 0; a < m * p; ++a)
+          w[a] += local[a];
+      }
+      // Z = Xc * W
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+      for(SimplexId i = 0; i < n; ++i) {
+        for(int c = 0; c < p; ++c) {
+          double sum{};
+          for(SimplexId a = 0; a < m; ++a)
+            sum += xc[i * m + a] * w[a * p + c];
+          z[i * p + c] = sum;
+        }
+      }
+    };
+    // Xc * Xc^T is positive semi-definite
+    iterations
+      = subspaceIteration(apply, n, nComponents, mds_MaxIteration, true, rng,
+                          eigenValues, coordinates, threadNumber);
+  }
+
+  scaleEigenVectors(coordinates, eigenValues, n, nComponents);
+
+  this->printMsg("Classical MDS converged in " + std::to_string(iterations)
+                   + " iteration(s)",
+                 debug::Priority::DETAIL);
+
+  return 0;
+}
+
+int DimensionReduction::computeLandmarkMDS(std::vector<double> &coordinates,
+                                           const int nComponents,
+                                           const SimplexId nLandmarks,
+                                           const bool precomputed) const {
+  const SimplexId n = numberOfRows_;
+  const SimplexId l = nLandmarks;
+  const int threadNumber = threadNumber_;
+  const Dissimilarity dissimilarity{static_cast<const double *>(matrix_), n,
+                                    numberOfColumns_, precomputed};
+
+  // 1. farthest-point sampling of the landmarks
+  std::vector<SimplexId> landmarks(l);
+  std::vector<double> minDistance(n, std::numeric_limits<double>::max());
+  landmarks[0] = 0;
+  for(SimplexId a = 1; a < l; ++a) {
+    const SimplexId last = landmarks[a - 1];
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < n; ++i)
+      minDistance[i]
+        = std::min(minDistance[i], dissimilarity.squared(i, last));
+    landmarks[a] = std::max_element(minDistance.begin(), minDistance.end())
+                   - minDistance.begin();
+  }
+
+  // 2. classical MDS on the double-centered landmark matrix
+  std::vector<double> b(l * l), columnMeans(l, 0.0);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < l; ++i)
+    for(SimplexId j = 0; j < l; ++j)
+      b[i * l + j] = dissimilarity.squared(landmarks[i], landmarks[j]);
+  double totalMean{};
+  for(SimplexId i = 0; i < l; ++i) {
+    for(SimplexId j = 0; j < l; ++j)
+      columnMeans[j] += b[i * l + j] / l;
+  }
+  for(SimplexId j = 0; j < l; ++j)
+    totalMean += columnMeans[j] / l;
+  // columnMeans is kept for the triangulation step
+  std::vector<double> bl(b);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < l; ++i)
+    for(SimplexId j = 0; j < l; ++j)
+      bl[i * l + j] = -0.5
+                      * (b[i * l + j] - columnMeans[i] - columnMeans[j]
+                         + totalMean);
+
+  const auto apply = [&](const std::vector<double> &y, std::vector<double> &z,
+                         const int p) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < l; ++i) {
+      for(int c = 0; c < p; ++c)
+        z[i * p + c] = 0.0;
+      for(SimplexId j = 0; j < l; ++j)
+        for(int c = 0; c < p; ++c)
+          z[i * p + c] += bl[i * l + j] * y[j * p + c];
+    }
+  };
+
+  std::mt19937 rng(randomState_ > 0 ? 0 : std::random_device{}());
+  std::vector<double> eigenValues, eigenVectors;
+  const int iterations
+    = subspaceIteration(apply, l, nComponents, mds_MaxIteration,
+                        !precomputed, rng, eigenValues, eigenVectors,
+                        threadNumber);
+  scaleEigenVectors(eigenVectors, eigenValues, l, nComponents);
+
+  // 3. distance-based triangulation: x = -1/2 L^# (delta - mean delta),
+  // with L^# the pseudo-inverse transpose of the landmark embedding
+  std::vector<double> pseudoInverse(l * nComponents, 0.0);
+  for(int c = 0; c < nComponents; ++c) {
+    if(eigenValues[c] <= 0.0)
+      continue;
+    for(SimplexId j = 0; j < l; ++j)
+      pseudoInverse[j * nComponents + c]
+        = eigenVectors[j * nComponents + c] / eigenValues[c];
+  }
+
+  coordinates.resize(static_cast<size_t>(n) * nComponents);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < n; ++i) {
+    double *const x = &coordinates[static_cast<size_t>(i) * nComponents];
+    std::fill(x, x + nComponents, 0.0);
+    for(SimplexId j = 0; j < l; ++j) {
+      const double delta
+        = dissimilarity.squared(i, landmarks[j]) - columnMeans[j];
+      for(int c = 0; c < nComponents; ++c)
+        x[c] -= 0.5 * pseudoInverse[j * nComponents + c] * delta;
+    }
+  }
+
+  this->printMsg("Landmark MDS (" + std::to_string(l)
+                   + " landmarks) converged in " + std::to_string(iterations)
+                   + " iteration(s)",
+                 debug::Priority::DETAIL);
+
+  return 0;
+}
+
+namespace {
+  // Barnes-Hut space-partitioning tree (quadtree, octree or binary tree) on
+  // the embedding coordinates, stored as a flat array of nodes
+  class BarnesHutTree {
+  public:
+    struct Node {
+      double centerOfMass[3];
+      double center[3];
+      double halfWidth;
+      SimplexId count;
+      SimplexId firstChild;
+      SimplexId point;
+    };
+
+    void build(const std::vector<double> &y, const SimplexId n, const int dim) {
+      dim_ = dim;
+      nChildren_ = 1 << dim;
+      nodes_.clear();
+      nodes_.reserve(static_cast<size_t>(n) * nChildren_ + 1);
+
+      double lower[3], upper[3];
+      for(int d = 0; d < dim; ++d) {
+        lower[d] = std::numeric_limits<double>::max();
+        upper[d] = std::numeric_limits<double>::lowest();
+      }
+      for(SimplexId i = 0; i < n; ++i) {
+        for(int d = 0; d < dim; ++d) {
+          lower[d] = std::min(lower[d], y[i * dim + d]);
+          upper[d] = std::max(upper[d], y[i * dim + d]);
+        }
+      }
+      Node root{};
+      double width{};
+      for(int d = 0; d < dim; ++d) {
+        root.center[d] = 0.5 * (lower[d] + upper[d]);
+        width = std::max(width, upper[d] - lower[d]);
+      }
+      root.halfWidth = 0.5 * width * (1.0 + 1e-5) + 1e-10;
+      root.firstChild = -1;
+      root.point = -1;
+      nodes_.emplace_back(root);
+      minHalfWidth_ = root.halfWidth * 1e-12;
+
+      for(SimplexId i = 0; i < n; ++i)
+        this->insert(&y[i * dim], i, y);
+    }
+
+    // repulsive force and sum of the unnormalized affinities for the point
+    // at position p (the point itself is excluded)
+    double repulsion(const double *const p,
+                     const double theta,
+                     double *const force,
+                     std::vector<SimplexId> &stack) const {
+      double sumQ{};
+      for(int d = 0; d < dim_; ++d)
+        force[d] = 0.0;
+      stack.clear();
+      stack.emplace_back(0);
+      while(!stack.empty()) {
+        const Node &node = nodes_[stack.back()];
+        stack.pop_back();
+        if(node.count == 0)
+          continue;
+        double diff[3], d2{};
+        for(int d = 0; d < dim_; ++d) {
+          diff[d] = p[d] - node.centerOfMass[d];
+          d2 += diff[d] * diff[d];
+        }
+        const bool leaf = node.firstChild == -1;
+        if(leaf && d2 == 0.0) {
+          // the point itself, and its duplicates
+          sumQ += node.count - 1;
+        } else if(leaf || 4.0 * node.halfWidth * node.halfWidth
+                            < theta * theta * d2) {
+          const double q = 1.0 / (1.0 + d2);
+          sumQ += node.count * q;
+          const double mult = node.count * q * q;
+          for(int d = 0; d < dim_; ++d)
+            force[d] += mult * diff[d];
+        } else {
+          for(int c = 0; c < nChildren_; ++c)
+            stack.emplace_back(node.firstChild + c);
+        }
+      }
+      return sumQ;
+    }
+
+  private:
+    inline int childIndex(const SimplexId node, const double *const p) const {
+      int index = 0;
+      for(int d = 0; d < dim_; ++d)
+        if(p[d] > nodes_[node].center[d])
+          index |= 1 << d;
+      return index;
+    }
+
+    inline void addMass(const SimplexId node, const double *const p) {
+      Node &n = nodes_[node];
+      const double w = 1.0 / (n.count + 1);
+      for(int d = 0; d < dim_; ++d)
+        n.centerOfMass[d] += (p[d] - n.centerOfMass[d]) * w;
+      n.count++;
+    }
+
+    void insert(const double *const p,
+                const SimplexId pointId,
+                const std::vector<double> &y) {
+      SimplexId node = 0;
+      while(true) {
+        if(nodes_[node].count == 0) {
+          for(int d = 0; d < dim_; ++d)
+            nodes_[node].centerOfMass[d] = p[d];
+          nodes_[node].count = 1;
+          nodes_[node].point = pointId;
+          return;
+        }
+        if(nodes_[node].firstChild == -1) {
+          const double *const q = &y[nodes_[node].point * dim_];
+          bool duplicate = nodes_[node].halfWidth < minHalfWidth_;
+          if(!duplicate) {
+            duplicate = true;
+            for(int d = 0; d < dim_; ++d)
+              duplicate = duplicate && p[d] == q[d];
+          }
+          if(duplicate) {
+            this->addMass(node, p);
+            return;
+          }
+          // split the leaf and move its content down
+          const SimplexId first = nodes_.size();
+          const double h = 0.5 * nodes_[node].halfWidth;
+          for(int c = 0; c < nChildren_; ++c) {
+            Node child{};
+            for(int d = 0; d < dim_; ++d)
+              child.center[d]
+                = nodes_[node].center[d] + ((c >> d) & 1 ? h : -h);
+            child.halfWidth = h;
+            child.firstChild = -1;
+            child.point = -1;
+            nodes_.emplace_back(child);
+          }
+          Node &moved = nodes_[first + this->childIndex(node, q)];
+          moved.count = nodes_[node].count;
+          moved.point = nodes_[node].point;
+          for(int d = 0; d < dim_; ++d)
+            moved.centerOfMass[d] = nodes_[node].centerOfMass[d];
+          nodes_[node].firstChild = first;
+          nodes_[node].point = -1;
+        }
+        this->addMass(node, p);
+        node = nodes_[node].firstChild + this->childIndex(node, p);
+      }
+    }
+
+    int dim_{};
+    int nChildren_{};
+    double minHalfWidth_{};
+    std::vector<Node> nodes_{};
+  };
+} // namespace
+
+int DimensionReduction::computeTSNE(std::vector<double> &coordinates,
+                                    const int nComponents) const {
+  const SimplexId n = numberOfRows_;
+  const int dim = nComponents;
+  const int threadNumber = threadNumber_;
+  const bool precomputed = tsne_Metric == "precomputed";
+  const Dissimilarity dissimilarity{
+    static_cast<const double *>(matrix_), n, numberOfColumns_, precomputed};
+
+  if(n < 2) {
+    this->printErr("t-SNE requires at least two rows");
+    return -1;
+  }
+
+  bool barnesHut = tsne_Method != "exact";
+  if(barnesHut && dim > 3) {
+    this->printWrn("Barnes-Hut t-SNE supports up to 3 components, "
+                   "using the exact method");
+    barnesHut = false;
+  }
+
+  // 1. conditional affinities on the k nearest neighbors, the bandwidth of
+  // each row matching the requested perplexity
+  const SimplexId k
+    = barnesHut ? std::min<SimplexId>(
+        n - 1, static_cast<SimplexId>(3.0 * tsne_Perplexity + 1.0))
+                : n - 1;
+  std::vector<SimplexId> neighbors(static_cast<size_t>(n) * k);
+  std::vector<double> conditional(neighbors.size());
+  const double desiredEntropy = std::log(tsne_Perplexity);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+  {
+    std::vector<std::pair<double, SimplexId>> candidates(n - 1);
+    std::vector<double> distances(k);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < n; ++i) {
+      SimplexId count = 0;
+      for(SimplexId j = 0; j < n; ++j)
+        if(j != i)
+          candidates[count++] = {dissimilarity.affinity(i, j), j};
+      if(k < n - 1)
+        std::nth_element(
+          candidates.begin(), candidates.begin() + k, candidates.end());
+
+      SimplexId *const nbr = &neighbors[static_cast<size_t>(i) * k];
+      double *const pi = &conditional[static_cast<size_t>(i) * k];
+      for(SimplexId j = 0; j < k; ++j) {
+        distances[j] = candidates[j].first;
+        nbr[j] = candidates[j].second;
+      }
+
+      // binary search on the precision (same scheme as scikit-learn)
+      double beta = 1.0;
+      double betaMin = -std::numeric_limits<double>::infinity();
+      double betaMax = std::numeric_limits<double>::infinity();
+      for(int step = 0; step < 100; ++step) {
+        double sumP{};
+        for(SimplexId j = 0; j < k; ++j) {
+          pi[j] = std::exp(-distances[j] * beta);
+          sumP += pi[j];
+        }
+        if(sumP == 0.0)
+          sumP = 1e-8;
+        double sumDP{};
+        for(SimplexId j = 0; j < k; ++j) {
+          pi[j] /= sumP;
+          sumDP += distances[j] * pi[j];
+        }
+        const double entropyDiff
+          = std::log(sumP) + beta * sumDP - desiredEntropy;
+        if(std::abs(entropyDiff) <= 1e-5)
+          break;
+        if(entropyDiff > 0) {
+          betaMin = beta;
+          beta = std::isinf(betaMax) ? beta * 2.0 : 0.5 * (beta + betaMax);
+        } else {
+          betaMax = beta;
+          beta = std::isinf(betaMin) ? beta * 0.5 : 0.5 * (beta + betaMin);
+        }
+      }
+    }
+  }
+
+  // 2. symmetrized joint probabilities P = (P_cond + P_cond^T) / sum, stored
+  // in a CSR layout
+  std::vector<SimplexId> offsets(n + 1, 0);
+  for(SimplexId i = 0; i < n; ++i) {
+    offsets[i + 1] += k;
+    for(SimplexId j = 0; j < k; ++j)
+      offsets[neighbors[i * k + j] + 1]++;
+  }
+  for(SimplexId i = 0; i < n; ++i)
+    offsets[i + 1] += offsets[i];
+  std::vector<std::pair<SimplexId, double>> entries(offsets[n]);
+  {
+    std::vector<SimplexId> cursor(offsets.begin(), offsets.end() - 1);
+    for(SimplexId i = 0; i < n; ++i) {
+      for(SimplexId j = 0; j < k; ++j) {
+        const SimplexId nbr = neighbors[i * k + j];
+        const double p = conditional[i * k + j];
+        entries[cursor[i]++] = {nbr, p};
+        entries[cursor[nbr]++] = {i, p};
+      }
+    }
+  }
+  std::vector<SimplexId> rowSize(n);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < n; ++i) {
+    const auto begin = entries.begin() + offsets[i];
+    const auto end = entries.begin() + offsets[i + 1];
+    std::sort(begin, end);
+    SimplexId size = 0;
+    for(auto it = begin; it != end; ++it) {
+      if(size > 0 && (begin + size - 1)->first == it->first)
+        (begin + size - 1)->second += it->second;
+      else
+        *(begin + size++) = *it;
+    }
+    rowSize[i] = size;
+  }
+  std::vector<SimplexId> pOffsets(n + 1, 0);
+  for(SimplexId i = 0; i < n; ++i)
+    pOffsets[i + 1] = pOffsets[i] + rowSize[i];
+  std::vector<SimplexId> pColumns(pOffsets[n]);
+  std::vector<double> pValues(pOffsets[n]);
+  double sumP{};
+  for(SimplexId i = 0; i < n; ++i) {
+    for(SimplexId j = 0; j < rowSize[i]; ++j) {
+      pColumns[pOffsets[i] + j] = entries[offsets[i] + j].first;
+      pValues[pOffsets[i] + j] = entries[offsets[i] + j].second;
+      sumP += entries[offsets[i] + j].second;
+    }
+  }
+  for(auto &p : pValues)
+    p = std::max(p / sumP, std::numeric_limits<double>::epsilon());
+  entries = {};
+  neighbors = {};
+  conditional = {};
+
+  // 3. initial embedding
+  coordinates.resize(static_cast<size_t>(n) * dim);
+  std::mt19937 rng(randomState_ > 0 ? 0 : std::random_device{}());
+  if(tsne_Init == "pca") {
+    this->computeClassicalMDS(coordinates, dim, precomputed);
+    double mean{}, variance{};
+    for(SimplexId i = 0; i < n; ++i)
+      mean += coordinates[i * dim] / n;
+    for(SimplexId i = 0; i < n; ++i)
+      variance += (coordinates[i * dim] - mean) * (coordinates[i * dim] - mean)
+                  / n;
+    const double scale = variance > 0 ? 1e-4 / std::sqrt(variance) : 1.0;
+    for(auto &c : coordinates)
+      c *= scale;
+  } else {
+    std::normal_distribution<double> normal{0.0, 1e-4};
+    for(auto &c : coordinates)
+      c = normal(rng);
+  }
+
+  // 4. gradient descent with momentum and gains
+  std::vector<double> &y = coordinates;
+  std::vector<double> gradient(y.size()), repulsive(y.size()), sumQ(n);
+  std::vector<double> update(y.size()), gains(y.size());
+  BarnesHutTree tree{};
+  const double theta = tsne_Angle;
+
+  // returns the KL divergence when requested
+  const auto computeGradient = [&](const double exaggeration,
+                                   const bool computeError) {
+    if(barnesHut)
+      tree.build(y, n, dim);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+    {
+      std::vector<SimplexId> stack{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+      for(SimplexId i = 0; i < n; ++i) {
+        const double *const yi = &y[i * dim];
+        double *const force = &repulsive[i * dim];
+        if(barnesHut) {
+          sumQ[i] = tree.repulsion(yi, theta, force, stack);
+        } else {
+          double sum{};
+          for(int d = 0; d < dim; ++d)
+            force[d] = 0.0;
+          for(SimplexId j = 0; j < n; ++j) {
+            if(j == i)
+              continue;
+            double d2{};
+            for(int d = 0; d < dim; ++d)
+              d2 += (yi[d] - y[j * dim + d]) * (yi[d] - y[j * dim + d]);
+            const double q = 1.0 / (1.0 + d2);
+            sum += q;
+            for(int d = 0; d < dim; ++d)
+              force[d] += q * q * (yi[d] - y[j * dim + d]);
+          }
+          sumQ[i] = sum;
+        }
+      }
+    }
+
+    double z{};
+    for(SimplexId i = 0; i < n; ++i)
+      z += sumQ[i];
+    z = std::max(z, std::numeric_limits<double>::min());
+
+    double error{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) reduction(+ : error)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < n; ++i) {
+      const double *const yi = &y[i * dim];
+      double *const g = &gradient[i * dim];
+      for(int d = 0; d < dim; ++d)
+        g[d] = 0.0;
+      for(SimplexId e = pOffsets[i]; e < pOffsets[i + 1]; ++e) {
+        const double *const yj = &y[pColumns[e] * dim];
+        double d2{};
+        for(int d = 0; d < dim; ++d)
+          d2 += (yi[d] - yj[d]) * (yi[d] - yj[d]);
+        const double q = 1.0 / (1.0 + d2);
+        const double mult = exaggeration * pValues[e] * q;
+        for(int d = 0; d < dim; ++d)
+          g[d] += mult * (yi[d] - yj[d]);
+        if(computeError)
+          error += pValues[e] * std::log(pValues[e] * z / q);
+      }
+      for(int d = 0; d < dim; ++d)
+        g[d] = 4.0 * (g[d] - repulsive[i * dim + d] / z);
+    }
+    return error;
+  };
+
+  const auto optimize = [&](const int iterationStart, const int nIterations,
+                            const double momentum, const double exaggeration,
+                            const int maxWithoutProgress) {
+    std::fill(update.begin(), update.end(), 0.0);
+    std::fill(gains.begin(), gains.end(), 1.0);
+    double bestError = std::numeric_limits<double>::max();
+    int bestIteration = iterationStart;
+    int it = iterationStart;
+    for(; it < nIterations; ++it) {
+      const bool check = (it + 1) % 50 == 0 || it == nIterations - 1;
+      const double error = computeGradient(exaggeration, check);
+
+      double gradientNorm{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) reduction(+ : gradientNorm)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t a = 0; a < y.size(); ++a) {
+        gradientNorm += gradient[a] * gradient[a];
+        if(update[a] * gradient[a] < 0.0)
+          gains[a] += 0.2;
+        else
+          gains[a] = std::max(gains[a] * 0.8, 0.01);
+        update[a] = momentum * update[a]
+                    - tsne_LearningRate * gains[a] * gradient[a];
+        y[a] += update[a];
+      }
+
+      if(check) {
+        this->printMsg("t-SNE iteration " + std::to_string(it + 1)
+                         + ", KL divergence: " + std::to_string(error),
+                       debug::Priority::VERBOSE);
+        if(error < bestError) {
+          bestError = error;
+          bestIteration = it;
+        } else if(it - bestIteration > maxWithoutProgress) {
+          break;
+        }
+        if(std::sqrt(gradientNorm) <= tsne_GradientThreshold)
+          break;
+      }
+    }
+    return std::min(it + 1, nIterations);
+  };
+
+  // early exaggeration phase, then the regular optimization
+  const int exploration = std::min(250, tsne_MaxIteration);
+  int iterations = optimize(0, exploration, 0.5, tsne_Exaggeration, 250);
+  iterations = optimize(iterations, tsne_MaxIteration, 0.8, 1.0,
+                        tsne_MaxIterationProgress);
+
+  this->printMsg("t-SNE stopped after " + std::to_string(iterations)
+                   + " iteration(s)",
+                 debug::Priority::DETAIL);
+
+  return 0;
+}
+
+int DimensionReduction::executeNative() const {
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(!matrix_ || !embedding_)
+    return -1;
+  if(numberOfRows_ <= 0 || numberOfColumns_ <= 0)
+    return -1;
 #endif
 
+  Timer t;
+
+  const SimplexId n = numberOfRows_;
+  const int numberOfComponents = std::max(2, numberOfComponents_);
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(n <= numberOfComponents) {
+    this->printErr("The input needs more rows than output components");
+    return -1;
+  }
+#endif
+
+  std::vector<double> coordinates{};
+  int status{};
+  std::string name{};
+  if(method_ == 2) {
+    const bool precomputed = mds_Dissimilarity == "precomputed";
+#ifndef TTK_ENABLE_KAMIKAZE
+    if(precomputed && numberOfRows_ != numberOfColumns_) {
+      this->printErr("A precomputed dissimilarity matrix must be square");
+      return -1;
+    }
+#endif
+    if(mds_NumberOfLandmarks > 0 && mds_NumberOfLandmarks < n) {
+      const SimplexId nLandmarks
+        = std::max<SimplexId>(mds_NumberOfLandmarks, numberOfComponents);
+      status = this->computeLandmarkMDS(
+        coordinates, numberOfComponents, nLandmarks, precomputed);
+      name = "landmark MDS";
+    } else {
+      status = this->computeClassicalMDS(
+        coordinates, numberOfComponents, precomputed);
+      name = "classical MDS";
+    }
+  } else if(method_ == 3) {
+#ifndef TTK_ENABLE_KAMIKAZE
+    if(tsne_Metric == "precomputed" && numberOfRows_ != numberOfColumns_) {
+      this->printErr("A precomputed dissimilarity matrix must be square");
+      return -1;
+    }
+#endif
+    status = this->computeTSNE(coordinates, numberOfComponents);
+    name = "t-SNE";
+  } else {
+    return -1;
+  }
+
+  if(status != 0)
+    return status;
+
+  embedding_->resize(numberOfComponents);
+  for(int c = 0; c < numberOfComponents; ++c) {
+    auto &component = (*embedding_)[c];
+    component.resize(n);
+    for(SimplexId i = 0; i < n; ++i)
+      component[i] = coordinates[i * numberOfComponents + c];
+  }
+
+  this->printMsg("Computed " + name + " (native)", 1.0, t.getElapsedTime(),
+                 this->threadNumber_);
+
   return 0;
 }
@@ -11,6 +11,16 @@
 /// \brief TTK VTK-filter that takes a matrix (vtkTable) as input and apply a
 /// dimension reduction algorithm from scikit-learn.
 ///
+/// Classical (Torgerson) MDS, landmark MDS and t-SNE (exact or Barnes-Hut)
+/// are also implemented natively with OpenMP and work directly on the input
+/// buffer (coordinates or dissimilarity matrix). They are always used for
+/// these methods in builds without scikit-learn support. Otherwise,
+/// scikit-learn remains the default to keep the existing outputs, and the
+/// native backend is used on request (see setUseNativeBackend). The other
+/// methods and the parameters the native backend does not support
+/// (non-metric MDS, t-SNE metrics other than euclidean or precomputed)
+/// require scikit-learn.
+///
 /// \sa ttk::Triangulation
 /// \sa ttkDimensionReduction.cpp %for a usage example.
 
@@ -63,7 +73,9 @@ namespace ttk {
                                 int MaxIteration,
                                 int Verbose,
                                 float Epsilon,
-                                bool Dissimilarity) {
+                                bool Dissimilarity,
+                                int NumberOfLandmarks = 0) {
+      mds_NumberOfLandmarks = NumberOfLandmarks;
       mds_Metric = Metric;
       mds_Init = Init;
       mds_MaxIteration = MaxIteration;
@@ -180,11 +192,49 @@ namespace ttk {
       return 0;
     }
 
+    inline int setUseNativeBackend(const bool useNativeBackend) {
+      UseNativeBackend = useNativeBackend;
+      return 0;
+    }
+
     bool isPythonFound() const;
 
+    /// Return true if the given method will be computed by the native
+    /// backend with the current parameters (no Python required): when it
+    /// is requested, or when scikit-learn support is disabled.
+    bool isNativeBackendUsed(const int method) const;
+
     int execute() const;
 
   protected:
+    /// Native backend dispatch, fills embedding_.
+    int executeNative() const;
+
+    /// Classical MDS: the leading eigenvectors of the double-centered
+    /// squared dissimilarities are extracted by subspace iteration, without
+    /// forming the centered matrix. \p coordinates is row-major
+    /// (numberOfRows_ x \p nComponents).
+    int computeClassicalMDS(std::vector<double> &coordinates,
+                            const int nComponents,
+                            const bool precomputed) const;
+
+    /// Landmark MDS (de Silva & Tenenbaum): classical MDS on \p nLandmarks
+    /// farthest-point samples, the other rows being placed by distance-based
+    /// triangulation. Only the numberOfRows_ x \p nLandmarks dissimilarities
+    /// are read.
+    int computeLandmarkMDS(std::vector<double> &coordinates,
+                           const int nComponents,
+                           const SimplexId nLandmarks,
+                           const bool precomputed) const;
+
+    /// t-SNE with sparse k-nearest-neighbor affinities and a Barnes-Hut
+    /// (up to 3 components) or exact repulsion.
+    int computeTSNE(std::vector<double> &coordinates,
+                    const int nComponents) const;
+
+    // native backend
+    bool UseNativeBackend{false};
+
     // se
     std::string se_Affinity{"nearest_neighbors"};
     float se_Gamma{1};
@@ -207,6 +257,7 @@ namespace ttk {
     int mds_Verbose{0};
     float mds_Epsilon{0};
     std::string mds_Dissimilarity{"euclidean"};
+    int mds_NumberOfLandmarks{0};
 
     // tsne
     float tsne_Perplexity{30};
@@ -27,12 +27,32 @@ void DiscreteGradient::initMemory(const AbstractTriangulation &triangulation) {
   dmt1Saddle2PL_.clear();
   dmt2Saddle2PL_.clear();
 
+  // bit-packed gradient on grids (bounded number of cofacets per cell)
+  const auto wrapper = dynamic_cast<const Triangulation *>(&triangulation);
+  if(wrapper != nullptr) {
+    usePackedGradient_ = wrapper->getType() != Triangulation::Type::EXPLICIT;
+  } else {
+    usePackedGradient_
+      = dynamic_cast<const ImplicitTriangulation *>(&triangulation) != nullptr
+        || dynamic_cast<const PeriodicImplicitTriangulation *>(&triangulation)
+             != nullptr;
+  }
+
   // clear & init gradient memory
-  for(int i = 0; i < dimensionality_; ++i) {
-    gradient_[2 * i].clear();
-    gradient_[2 * i].resize(numberOfCells[i], -1);
-    gradient_[2 * i + 1].clear();
-    gradient_[2 * i + 1].resize(numberOfCells[i + 1], -1);
+  for(auto &g : gradient_) {
+    g.clear();
+    g.shrink_to_fit();
+  }
+  packedGradient_.clear();
+  if(usePackedGradient_) {
+    for(int i = 0; i < numberOfDimensions; ++i) {
+      packedGradient_.resize(i, numberOfCells[i]);
+    }
+  } else {
+    for(int i = 0; i < dimensionality_; ++i) {
+      gradient_[2 * i].resize(numberOfCells[i], -1);
+      gradient_[2 * i + 1].resize(numberOfCells[i + 1], -1);
+    }
   }
 
   std::vector<std::vector<std::string>> rows{
@@ -44,6 +64,8 @@ void DiscreteGradient::initMemory(const AbstractTriangulation &triangulation) {
     rows.emplace_back(
       std::vector<std::string>{"#Tetras", std::to_string(numberOfCells[3])});
   }
+  rows.emplace_back(std::vector<std::string>{
+    "Gradient storage", usePackedGradient_ ? "packed" : "full"});
 
   this->printMsg(rows);
   this->printMsg("Initialized discrete gradient memory", 1.0,
@@ -115,7 +137,7 @@ CriticalType
 
 bool DiscreteGradient::isMinimum(const Cell &cell) const {
   if(cell.dim_ == 0) {
-    return (gradient_[0][cell.id_] == -1);
+    return isCellCritical(cell);
   }
 
   return false;
@@ -123,7 +145,7 @@ bool DiscreteGradient::isMinimum(const Cell &cell) const {
 
 bool DiscreteGradient::isSaddle1(const Cell &cell) const {
   if(cell.dim_ == 1) {
-    return (gradient_[1][cell.id_] == -1 and gradient_[2][cell.id_] == -1);
+    return isCellCritical(cell);
   }
 
   return false;
@@ -131,19 +153,16 @@ bool DiscreteGradient::isSaddle1(const Cell &cell) const {
 
 bool DiscreteGradient::isSaddle2(const Cell &cell) const {
   if(dimensionality_ == 3 and cell.dim_ == 2) {
-    return (gradient_[3][cell.id_] == -1 and gradient_[4][cell.id_] == -1);
+    return isCellCritical(cell);
   }
 
   return false;
 }
 
 bool DiscreteGradient::isMaximum(const Cell &cell) const {
-  if(dimensionality_ == 2 and cell.dim_ == 2) {
-    return (gradient_[3][cell.id_] == -1);
-  }
-
-  if(dimensionality_ == 3 and cell.dim_ == 3) {
-    return (gradient_[5][cell.id_] == -1);
+  if((dimensionality_ == 2 or dimensionality_ == 3)
+     and cell.dim_ == dimensionality_) {
+    return isCellCritical(cell);
   }
 
   return false;
@@ -151,6 +170,13 @@ bool DiscreteGradient::isMaximum(const Cell &cell) const {
 
 bool DiscreteGradient::isCellCritical(const int cellDim,
                                       const SimplexId cellId) const {
+  if(usePackedGradient_) {
+    if(cellDim < 0 || cellDim > dimensionality_) {
+      return false;
+    }
+    return packedGradient_.get(cellDim, cellId) == 0;
+  }
+
   if(dimensionality_ == 2) {
     switch(cellDim) {
       case 0:
@@ -293,12 +293,6 @@ namespace ttk {
       }
     };
 
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-    using gradIdType = char;
-#else
-    using gradIdType = SimplexId;
-#endif
-
     /**
      * @brief Discrete gradient struct
      *
@@ -310,7 +304,82 @@ namespace ttk {
      * 5: paired triangle id per tetra
      * -1 if critical or paired to a cell of another dimension
      */
-    using gradientType = std::array<std::vector<gradIdType>, 6>;
+    using gradientType = std::array<std::vector<SimplexId>, 6>;
+
+    /**
+     * @brief Bit-packed discrete gradient
+     *
+     * One 4-bit code per cell (two cells per byte), stored by cell
+     * dimension:
+     * 0 if critical,
+     * 1 + i if paired to its i-th facet,
+     * 1 + (number of facets) + j if paired to its j-th cofacet,
+     * where i and j are local indices in the triangulation facet and
+     * cofacet accessors.
+     *
+     * Only suitable for triangulations where the number of cofacets per
+     * cell is bounded (implicit & periodic grids: at most 14 edges per
+     * vertex).
+     */
+    class PackedGradient {
+    public:
+      /**
+       * @brief Maximal number of cofacets of a cell of dimension @p dim
+       */
+      static inline SimplexId maxCofacets(const int dim) {
+        return 15 - getNumberOfFacets(dim);
+      }
+
+      /**
+       * @brief Number of facets of a cell of dimension @p dim
+       */
+      static inline SimplexId getNumberOfFacets(const int dim) {
+        return dim == 0 ? 0 : dim + 1;
+      }
+
+      inline void clear() {
+        for(auto &codes : this->codes_) {
+          codes.clear();
+          codes.shrink_to_fit();
+        }
+      }
+
+      inline void resize(const int dim, const SimplexId nCells) {
+        this->codes_[dim].clear();
+        this->codes_[dim].resize((nCells + 1) / 2, 0);
+      }
+
+      inline uint8_t get(const int dim, const SimplexId id) const {
+        return (this->codes_[dim][id / 2] >> (4 * (id % 2))) & 0xF;
+      }
+
+      inline void set(const int dim, const SimplexId id, const uint8_t code) {
+        auto &byte = this->codes_[dim][id / 2];
+        const auto shift = 4 * (id % 2);
+        const uint8_t mask = ~(0xF << shift);
+        const uint8_t bits = code << shift;
+        // the other half-byte can be written concurrently
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+        byte &= mask;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+        byte |= bits;
+      }
+
+      inline size_t footprint() const {
+        size_t res{};
+        for(const auto &codes : this->codes_) {
+          res += codes.size();
+        }
+        return res;
+      }
+
+    private:
+      std::array<std::vector<uint8_t>, 4> codes_{};
+    };
 
     /**
      * Compute and manage a discrete gradient of a function on a triangulation.
@@ -691,6 +760,40 @@ in the gradient.
                             CellExt &beta,
                             const triangulationType &triangulation);
 
+      /**
+       * @brief Store a gradient pair (lower dimension cell first)
+       */
+      template <typename triangulationType>
+      inline void setGradientPair(const Cell &alpha,
+                                  const Cell &beta,
+                                  const triangulationType &triangulation);
+
+      /**
+       * @brief Number of cofacets of a cell (packed gradient local
+       * indices)
+       */
+      template <typename triangulationType>
+      inline SimplexId
+        getNumberOfCofacets(const Cell &cell,
+                            const triangulationType &triangulation) const;
+
+      /**
+       * @brief Get the i-th facet of a cell
+       */
+      template <typename triangulationType>
+      inline SimplexId getFacet(const Cell &cell,
+                                const SimplexId i,
+                                const triangulationType &triangulation) const;
+
+      /**
+       * @brief Get the i-th cofacet of a cell
+       */
+      template <typename triangulationType>
+      inline SimplexId
+        getCofacet(const Cell &cell,
+                   const SimplexId i,
+                   const triangulationType &triangulation) const;
+
       /**
        * Implements the ProcessLowerStars algorithm from "Theory and
        * Algorithms for Constructing Discrete Morse Complexes from
@@ -943,6 +1046,9 @@ gradient, false otherwise.
       int dimensionality_{-1};
       SimplexId numberOfVertices_{};
       gradientType gradient_{};
+      // used instead of gradient_ on implicit & periodic grids
+      PackedGradient packedGradient_{};
+      bool usePackedGradient_{false};
       std::vector<SimplexId> dmtMax2PL_{};
       std::vector<SimplexId> dmt1Saddle2PL_{};
       std::vector<SimplexId> dmt2Saddle2PL_{};
@@ -1917,65 +1917,112 @@ inline void
 template <typename triangulationType>
 inline void DiscreteGradient::pairCells(
   CellExt &alpha, CellExt &beta, const triangulationType &triangulation) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-  char localBId{0}, localAId{0};
-  SimplexId a{}, b{};
+  this->setGradientPair(alpha, beta, triangulation);
+  alpha.paired_ = true;
+  beta.paired_ = true;
+}
 
-  if(beta.dim_ == 1) {
+template <typename triangulationType>
+inline void
+  DiscreteGradient::setGradientPair(const Cell &alpha,
+                                    const Cell &beta,
+                                    const triangulationType &triangulation) {
 
-    for(SimplexId i = 0; i < 2; ++i) {
-      triangulation.getEdgeVertex(beta.id_, i, a);
-      if(a == alpha.id_) {
-        localAId = i;
-        break;
-      }
-    }
-    const auto nedges = triangulation.getVertexEdgeNumber(alpha.id_);
-    for(SimplexId i = 0; i < nedges; ++i) {
-      triangulation.getVertexEdge(alpha.id_, i, b);
-      if(b == beta.id_) {
-        localBId = i;
-      }
-    }
-  } else if(beta.dim_ == 2) {
-    for(SimplexId i = 0; i < 3; ++i) {
-      triangulation.getTriangleEdge(beta.id_, i, a);
-      if(a == alpha.id_) {
-        localAId = i;
-        break;
-      }
+  if(!usePackedGradient_) {
+    gradient_[2 * alpha.dim_][alpha.id_] = beta.id_;
+    gradient_[2 * alpha.dim_ + 1][beta.id_] = alpha.id_;
+    return;
+  }
+
+  // local index of alpha in the facets of beta
+  uint8_t betaCode{};
+  const auto nBetaFacets = PackedGradient::getNumberOfFacets(beta.dim_);
+  for(SimplexId i = 0; i < nBetaFacets; ++i) {
+    if(this->getFacet(beta, i, triangulation) == alpha.id_) {
+      betaCode = 1 + i;
+      break;
     }
-    const auto ntri = triangulation.getEdgeTriangleNumber(alpha.id_);
-    for(SimplexId i = 0; i < ntri; ++i) {
-      triangulation.getEdgeTriangle(alpha.id_, i, b);
-      if(b == beta.id_) {
-        localBId = i;
-      }
+  }
+  // local index of beta in the cofacets of alpha
+  uint8_t alphaCode{};
+  const auto nFacets = PackedGradient::getNumberOfFacets(alpha.dim_);
+  const auto nCofacets = this->getNumberOfCofacets(alpha, triangulation);
+  for(SimplexId i = 0; i < nCofacets; ++i) {
+    if(this->getCofacet(alpha, i, triangulation) == beta.id_) {
+      alphaCode = 1 + nFacets + i;
+      break;
     }
-  } else {
-    for(SimplexId i = 0; i < 4; ++i) {
-      triangulation.getCellTriangle(beta.id_, i, a);
-      if(a == alpha.id_) {
-        localAId = i;
-        break;
+  }
+
+  packedGradient_.set(alpha.dim_, alpha.id_, alphaCode);
+  packedGradient_.set(beta.dim_, beta.id_, betaCode);
+}
+
+template <typename triangulationType>
+inline SimplexId DiscreteGradient::getNumberOfCofacets(
+  const Cell &cell, const triangulationType &triangulation) const {
+  switch(cell.dim_) {
+    case 0:
+      return triangulation.getVertexEdgeNumber(cell.id_);
+    case 1:
+      return dimensionality_ == 2
+               ? triangulation.getEdgeStarNumber(cell.id_)
+               : triangulation.getEdgeTriangleNumber(cell.id_);
+    case 2:
+      return dimensionality_ == 3
+               ? triangulation.getTriangleStarNumber(cell.id_)
+               : 0;
+    default:
+      return 0;
+  }
+}
+
+template <typename triangulationType>
+inline SimplexId
+  DiscreteGradient::getFacet(const Cell &cell,
+                             const SimplexId i,
+                             const triangulationType &triangulation) const {
+  SimplexId id{-1};
+  switch(cell.dim_) {
+    case 1:
+      triangulation.getEdgeVertex(cell.id_, i, id);
+      break;
+    case 2:
+      if(dimensionality_ == 2) {
+        triangulation.getCellEdge(cell.id_, i, id);
+      } else {
+        triangulation.getTriangleEdge(cell.id_, i, id);
       }
-    }
-    const auto ntetra = triangulation.getTriangleStarNumber(alpha.id_);
-    for(SimplexId i = 0; i < ntetra; ++i) {
-      triangulation.getTriangleStar(alpha.id_, i, b);
-      if(b == beta.id_) {
-        localBId = i;
+      break;
+    case 3:
+      triangulation.getCellTriangle(cell.id_, i, id);
+      break;
+  }
+  return id;
+}
+
+template <typename triangulationType>
+inline SimplexId
+  DiscreteGradient::getCofacet(const Cell &cell,
+                               const SimplexId i,
+                               const triangulationType &triangulation) const {
+  SimplexId id{-1};
+  switch(cell.dim_) {
+    case 0:
+      triangulation.getVertexEdge(cell.id_, i, id);
+      break;
+    case 1:
+      if(dimensionality_ == 2) {
+        triangulation.getEdgeStar(cell.id_, i, id);
+      } else {
+        triangulation.getEdgeTriangle(cell.id_, i, id);
       }
-    }
+      break;
+    case 2:
+      triangulation.getTriangleStar(cell.id_, i, id);
+      break;
   }
-  gradient_[2 * alpha.dim_][alpha.id_] = localBId;
-  gradient_[2 * alpha.dim_ + 1][beta.id_] = localAId;
-#else
-  gradient_[2 * alpha.dim_][alpha.id_] = beta.id_;
-  gradient_[2 * alpha.dim_ + 1][beta.id_] = alpha.id_;
-#endif // TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-  alpha.paired_ = true;
-  beta.paired_ = true;
+  return id;
 }
 
 template <typename triangulationType>
@@ -2244,103 +2291,68 @@ SimplexId
     std::is_base_of<AbstractTriangulation, triangulationType>(),
     "triangulationType should be an AbstractTriangulation derivative");
 
-  SimplexId id{-1};
+  if(usePackedGradient_) {
+    if(cell.dim_ < 0 || cell.dim_ > dimensionality_) {
+      return -1;
+    }
+    const auto code = packedGradient_.get(cell.dim_, cell.id_);
+    const auto nFacets = PackedGradient::getNumberOfFacets(cell.dim_);
+    if(code == 0) {
+      return -1;
+    }
+    // vertices have no facets: isReverse is not relevant
+    if(isReverse && cell.dim_ > 0) {
+      return code <= nFacets ? this->getFacet(cell, code - 1, triangulation)
+                             : -1;
+    }
+    return code > nFacets
+             ? this->getCofacet(cell, code - 1 - nFacets, triangulation)
+             : -1;
+  }
+
   if(dimensionality_ == 2) {
     switch(cell.dim_) {
       case 0:
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-        triangulation.getVertexEdge(cell.id_, gradient_[0][cell.id_], id);
-#else
         return gradient_[0][cell.id_];
-#endif
-        break;
 
       case 1:
         if(isReverse) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-          triangulation.getEdgeVertex(cell.id_, gradient_[1][cell.id_], id);
-          return id;
-#else
           return gradient_[1][cell.id_];
-#endif
         }
-
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-        triangulation.getEdgeStar(cell.id_, gradient_[2][cell.id_], id);
-#else
         return gradient_[2][cell.id_];
-#endif
-        break;
 
       case 2:
         if(isReverse) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-          triangulation.getCellEdge(cell.id_, gradient_[3][cell.id_], id);
-          return id;
-#else
           return gradient_[3][cell.id_];
-#endif
         }
         break;
     }
   } else if(dimensionality_ == 3) {
     switch(cell.dim_) {
       case 0:
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-        triangulation.getVertexEdge(cell.id_, gradient_[0][cell.id_], id);
-#else
         return gradient_[0][cell.id_];
-#endif
-        break;
 
       case 1:
         if(isReverse) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-          triangulation.getEdgeVertex(cell.id_, gradient_[1][cell.id_], id);
-          return id;
-#else
           return gradient_[1][cell.id_];
-#endif
         }
-
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-        triangulation.getEdgeTriangle(cell.id_, gradient_[2][cell.id_], id);
-#else
         return gradient_[2][cell.id_];
-#endif
-        break;
 
       case 2:
         if(isReverse) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-          triangulation.getTriangleEdge(cell.id_, gradient_[3][cell.id_], id);
-          return id;
-#else
           return gradient_[3][cell.id_];
-#endif
         }
-
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-        triangulation.getTriangleStar(cell.id_, gradient_[4][cell.id_], id);
-#else
         return gradient_[4][cell.id_];
-#endif
-        break;
 
       case 3:
         if(isReverse) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-          triangulation.getCellTriangle(cell.id_, gradient_[5][cell.id_], id);
-          return id;
-#else
           return gradient_[5][cell.id_];
-#endif
         }
         break;
     }
   }
 
-  return id;
+  return -1;
 }
 
 template <typename triangulationType>
@@ -2887,27 +2899,8 @@ int DiscreteGradient::reverseAscendingPath(
       const SimplexId edgeId = vpath[i].id_;
       const SimplexId triangleId = vpath[i + 1].id_;
 
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      for(int k = 0; k < 3; ++k) {
-        SimplexId tmp;
-        triangulation.getCellEdge(triangleId, k, tmp);
-        if(tmp == edgeId) {
-          gradient_[3][triangleId] = k;
-          break;
-        }
-      }
-      for(int k = 0; k < triangulation.getEdgeStarNumber(edgeId); ++k) {
-        SimplexId tmp;
-        triangulation.getEdgeStar(edgeId, k, tmp);
-        if(tmp == triangleId) {
-          gradient_[2][edgeId] = k;
-          break;
-        }
-      }
-#else
-      gradient_[3][triangleId] = edgeId;
-      gradient_[2][edgeId] = triangleId;
-#endif
+      this->setGradientPair(
+        Cell{1, edgeId}, Cell{2, triangleId}, triangulation);
     }
   } else if(dimensionality_ == 3) {
     // assume that the first cell is a triangle
@@ -2916,27 +2909,8 @@ int DiscreteGradient::reverseAscendingPath(
       const SimplexId triangleId = vpath[i].id_;
       const SimplexId tetraId = vpath[i + 1].id_;
 
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      for(int k = 0; k < 4; ++k) {
-        SimplexId tmp;
-        triangulation.getCellTriangle(tetraId, k, tmp);
-        if(tmp == triangleId) {
-          gradient_[5][tetraId] = k;
-          break;
-        }
-      }
-      for(int k = 0; k < triangulation.getTriangleStarNumber(triangleId); ++k) {
-        SimplexId tmp;
-        triangulation.getTriangleStar(triangleId, k, tmp);
-        if(tmp == tetraId) {
-          gradient_[4][triangleId] = k;
-          break;
-        }
-      }
-#else
-      gradient_[5][tetraId] = triangleId;
-      gradient_[4][triangleId] = tetraId;
-#endif
+      this->setGradientPair(
+        Cell{2, triangleId}, Cell{3, tetraId}, triangulation);
     }
   }
 
@@ -2952,29 +2926,7 @@ int DiscreteGradient::reverseDescendingPath(
     const SimplexId edgeId = vpath[i].id_;
     const SimplexId vertId = vpath[i + 1].id_;
 
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-    const auto nneighs = triangulation.getVertexEdgeNumber();
-    for(int k = 0; k < nneighs; ++k) {
-      SimplexId tmp;
-      triangulation.getVertexEdge(vertId, k, tmp);
-      if(tmp == edgeId) {
-        gradient_[0][vertId] = k;
-        break;
-      }
-    }
-    const auto nverts = triangulation.getEdgeStarNumber(edgeId);
-    for(int k = 0; k < nverts; ++k) {
-      SimplexId tmp;
-      triangulation.getEdgeVertex(edgeId, k, tmp);
-      if(tmp == vertId) {
-        gradient_[1][edgeId] = k;
-        break;
-      }
-    }
-#else
-    gradient_[0][vertId] = edgeId;
-    gradient_[1][edgeId] = vertId;
-#endif
+    this->setGradientPair(Cell{0, vertId}, Cell{1, edgeId}, triangulation);
   }
 
   return 0;
@@ -2991,27 +2943,8 @@ int DiscreteGradient::reverseAscendingPathOnWall(
       const SimplexId edgeId = vpath[i].id_;
       const SimplexId triangleId = vpath[i + 1].id_;
 
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      for(int k = 0; k < 3; ++k) {
-        SimplexId tmp;
-        triangulation.getTriangleEdge(triangleId, k, tmp);
-        if(tmp == edgeId) {
-          gradient_[3][triangleId] = k;
-          break;
-        }
-      }
-      for(int k = 0; k < triangulation.getEdgeTriangleNumber(edgeId); ++k) {
-        SimplexId tmp;
-        triangulation.getEdgeTriangle(edgeId, k, tmp);
-        if(tmp == triangleId) {
-          gradient_[2][edgeId] = k;
-          break;
-        }
-      }
-#else
-      gradient_[3][triangleId] = edgeId;
-      gradient_[2][edgeId] = triangleId;
-#endif
+      this->setGradientPair(
+        Cell{1, edgeId}, Cell{2, triangleId}, triangulation);
     }
   }
 
@@ -3029,27 +2962,8 @@ int DiscreteGradient::reverseDescendingPathOnWall(
       const SimplexId triangleId = vpath[i].id_;
       const SimplexId edgeId = vpath[i + 1].id_;
 
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      for(int k = 0; k < 3; ++k) {
-        SimplexId tmp;
-        triangulation.getTriangleEdge(triangleId, k, tmp);
-        if(tmp == edgeId) {
-          gradient_[3][triangleId] = k;
-          break;
-        }
-      }
-      for(int k = 0; k < triangulation.getEdgeTriangleNumber(edgeId); ++k) {
-        SimplexId tmp;
-        triangulation.getEdgeTriangle(edgeId, k, tmp);
-        if(tmp == triangleId) {
-          gradient_[2][edgeId] = k;
-          break;
-        }
-      }
-#else
-      gradient_[2][edgeId] = triangleId;
-      gradient_[3][triangleId] = edgeId;
-#endif
+      this->setGradientPair(
+        Cell{1, edgeId}, Cell{2, triangleId}, triangulation);
     }
   }
 
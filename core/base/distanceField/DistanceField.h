@@ -101,34 +101,36 @@ int ttk::DistanceField::execute(const triangulationType *triangulation_) const {
   std::vector<SimplexId> sources(isSource.begin(), isSource.end());
   isSource.clear();
 
-  // prepare output
-  std::vector<std::vector<dataType>> scalars(sources.size());
+  if(sources.empty()) {
+    this->printWrn("No source");
+    return 0;
+  }
 
-  // @PETER This doesn't seem to very work efficient, there's multilple source
-  // shortest paths algorithms.
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif
-  for(size_t i = 0; i < sources.size(); ++i) {
-    int ret = Dijkstra::shortestPath<dataType>(
-      sources[i], *triangulation_, scalars[i]);
-    if(ret != 0) {
-      this->printErr(
-        "Algorithm not successful (error code:  " + std::to_string(ret) + ").");
-    }
+  // single pass over all the sources: the nearest source index is
+  // directly written in the segmentation
+  int ret{};
+  if(this->threadNumber_ > 1) {
+    ret = Dijkstra::deltaSteppingShortestPath<dataType>(
+      sources, *triangulation_, dist, seg, this->threadNumber_);
+  } else {
+    ret = Dijkstra::multiSourceShortestPath<dataType>(
+      sources, *triangulation_, dist, seg);
+  }
+  if(ret != 0) {
+    this->printErr(
+      "Algorithm not successful (error code:  " + std::to_string(ret) + ").");
+    return ret;
   }
 
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
 #endif
   for(SimplexId k = 0; k < vertexNumber_; ++k) {
-    for(size_t i = 0; i < sources.size(); ++i) {
-      if(i == 0 or dist[k] > scalars[i][k]) {
-        dist[k] = scalars[i][k];
-        origin[k] = sources[i];
-        seg[k] = i;
-      }
+    // vertices not reachable from any source are assigned to the first one
+    if(seg[k] == -1) {
+      seg[k] = 0;
     }
+    origin[k] = sources[seg[k]];
   }
 
   this->printMsg(
@@ -7,6 +7,10 @@
 
 using namespace ttk;
 
+// bounded-memory mode granularity
+const SimplexId ExplicitTriangulation::lazyBlockSize_ = 4096;
+const SimplexId ExplicitTriangulation::cellChunkSize_ = 1024;
+
 ExplicitTriangulation::ExplicitTriangulation() {
 
   setDebugMsgPrefix("ExplicitTriangulation");
@@ -22,6 +26,10 @@ int ExplicitTriangulation::clear() {
   cellNumber_ = 0;
   doublePrecision_ = false;
 
+  cellChunkRanges_.clear();
+  vertexNeighborCache_.reset();
+  vertexStarCache_.reset();
+
   printMsg("Triangulation cleared.", debug::Priority::DETAIL);
 
   return AbstractTriangulation::clear();
@@ -50,6 +58,20 @@ size_t ExplicitTriangulation::footprint(size_t size) const {
   size += printArrayFootprint(edgeLinkData_, "edgeLinkData_");
   size += printArrayFootprint(triangleLinkData_, "triangleLinkData_");
 
+  const auto printCacheFootprint
+    = [this](const FlatJaggedArrayCache *const cache, const std::string &name) {
+        if(cache == nullptr) {
+          return size_t{};
+        }
+        this->printMsg(name + std::string{": "}
+                       + std::to_string(cache->footprint()) + " bytes");
+        return cache->footprint();
+      };
+
+  size
+    += printCacheFootprint(vertexNeighborCache_.get(), "vertexNeighborCache_");
+  size += printCacheFootprint(vertexStarCache_.get(), "vertexStarCache_");
+
   return AbstractTriangulation::footprint(size);
 }
 
@@ -156,7 +178,7 @@ int ExplicitTriangulation::preconditionBoundaryVerticesInternal() {
   // create their star
   // look for singletons
   if(getDimensionality() == 1) {
-    preconditionVertexStarsInternal();
+    buildVertexStars();
     for(size_t i = 0; i < vertexStarData_.subvectorsNumber(); i++) {
       if(vertexStarData_.size(i) == 1) {
         boundaryVertices_[i] = true;
@@ -493,7 +515,7 @@ int ExplicitTriangulation::preconditionVertexLinksInternal() {
 
     if(getDimensionality() == 2) {
       preconditionEdgesInternal();
-      preconditionVertexStarsInternal();
+      buildVertexStars();
 
       ZeroSkeleton zeroSkeleton;
       zeroSkeleton.setWrapper(this);
@@ -501,7 +523,7 @@ int ExplicitTriangulation::preconditionVertexLinksInternal() {
         vertexStarData_, triangleEdgeList_, edgeList_, vertexLinkData_);
     } else if(getDimensionality() == 3) {
       preconditionTrianglesInternal();
-      preconditionVertexStarsInternal();
+      buildVertexStars();
 
       ZeroSkeleton zeroSkeleton;
       zeroSkeleton.setWrapper(this);
@@ -523,12 +545,45 @@ int ExplicitTriangulation::preconditionVertexNeighborsInternal() {
     return 1;
   }
 
+  return this->buildVertexNeighbors();
+}
+
+int ExplicitTriangulation::preconditionBoundedVertexNeighborsInternal(
+  const size_t memoryBudget) {
+
+  if(this->cellArray_ == nullptr || this->vertexNumber_ == 0) {
+    this->printErr("Empty dataset, precondition skipped");
+    return 1;
+  }
+
+  if((SimplexId)vertexNeighborData_.subvectorsNumber() == vertexNumber_) {
+    // already fully computed
+    return 0;
+  }
+
+  // computed by blocks of vertices on first access
+  if(this->vertexNeighborCache_ == nullptr) {
+    this->initCellChunkRanges();
+    this->vertexNeighborCache_ = std::make_shared<FlatJaggedArrayCache>(
+      lazyBlockSize_, memoryBudget);
+  } else {
+    this->vertexNeighborCache_->reserveBudget(memoryBudget);
+  }
+  return 0;
+}
+
+int ExplicitTriangulation::buildVertexNeighbors() {
+
   if((SimplexId)vertexNeighborData_.subvectorsNumber() != vertexNumber_) {
     ZeroSkeleton zeroSkeleton;
     zeroSkeleton.setWrapper(this);
-    return zeroSkeleton.buildVertexNeighbors(
+    const auto ret = zeroSkeleton.buildVertexNeighbors(
       vertexNumber_, *cellArray_, vertexNeighborData_, &edgeList_);
+    if(ret != 0) {
+      return ret;
+    }
   }
+  this->vertexNeighborCache_.reset();
   return 0;
 }
 
@@ -539,16 +594,170 @@ int ExplicitTriangulation::preconditionVertexStarsInternal() {
     return 1;
   }
 
+  return this->buildVertexStars();
+}
+
+int ExplicitTriangulation::preconditionBoundedVertexStarsInternal(
+  const size_t memoryBudget) {
+
+  if(this->cellArray_ == nullptr || this->vertexNumber_ == 0) {
+    this->printErr("Empty dataset, precondition skipped");
+    return 1;
+  }
+
+  if((SimplexId)vertexStarData_.subvectorsNumber() == vertexNumber_) {
+    // already fully computed
+    return 0;
+  }
+
+  // computed by blocks of vertices on first access
+  if(this->vertexStarCache_ == nullptr) {
+    this->initCellChunkRanges();
+    this->vertexStarCache_ = std::make_shared<FlatJaggedArrayCache>(
+      lazyBlockSize_, memoryBudget);
+  } else {
+    this->vertexStarCache_->reserveBudget(memoryBudget);
+  }
+  return 0;
+}
+
+int ExplicitTriangulation::buildVertexStars() {
+
   if((SimplexId)vertexStarData_.subvectorsNumber() != vertexNumber_) {
     ZeroSkeleton zeroSkeleton;
     zeroSkeleton.setWrapper(this);
-
-    return zeroSkeleton.buildVertexStars(
+    const auto ret = zeroSkeleton.buildVertexStars(
       vertexNumber_, *cellArray_, vertexStarData_);
+    if(ret != 0) {
+      return ret;
+    }
   }
+  this->vertexStarCache_.reset();
   return 0;
 }
 
+void ExplicitTriangulation::initCellChunkRanges() {
+
+  if(!this->cellChunkRanges_.empty()) {
+    return;
+  }
+
+  const SimplexId nChunks
+    = (this->cellNumber_ + cellChunkSize_ - 1) / cellChunkSize_;
+  this->cellChunkRanges_.resize(nChunks);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < nChunks; ++i) {
+    const SimplexId end
+      = std::min<SimplexId>((i + 1) * cellChunkSize_, this->cellNumber_);
+    std::array<SimplexId, 2> range{this->vertexNumber_, -1};
+    for(SimplexId cid = i * cellChunkSize_; cid < end; ++cid) {
+      const SimplexId nbVerts = this->cellArray_->getCellVertexNumber(cid);
+      for(SimplexId j = 0; j < nbVerts; ++j) {
+        const SimplexId v = this->cellArray_->getCellVertex(cid, j);
+        range[0] = std::min(range[0], v);
+        range[1] = std::max(range[1], v);
+      }
+    }
+    this->cellChunkRanges_[i] = range;
+  }
+}
+
+template <typename Func>
+void ExplicitTriangulation::forEachCellVertexInRange(const SimplexId first,
+                                                     const SimplexId last,
+                                                     const Func &func) const {
+  // only visit the chunks of cells spanning the vertex range: for
+  // meshes with some spatial coherence, this is a small subset
+  for(size_t i = 0; i < this->cellChunkRanges_.size(); ++i) {
+    const auto &range = this->cellChunkRanges_[i];
+    if(range[1] < first || range[0] >= last) {
+      continue;
+    }
+    const SimplexId end = std::min<SimplexId>(
+      (i + 1) * cellChunkSize_, this->cellNumber_);
+    for(SimplexId cid = i * cellChunkSize_; cid < end; ++cid) {
+      const SimplexId nbVerts = this->cellArray_->getCellVertexNumber(cid);
+      for(SimplexId j = 0; j < nbVerts; ++j) {
+        const SimplexId v = this->cellArray_->getCellVertex(cid, j);
+        if(v >= first && v < last) {
+          func(cid, v);
+        }
+      }
+    }
+  }
+}
+
+void ExplicitTriangulation::buildVertexStarsBlock(
+  const SimplexId blockId, FlatJaggedArray &stars) const {
+
+  const SimplexId first = blockId * lazyBlockSize_;
+  const SimplexId last
+    = std::min<SimplexId>(first + lazyBlockSize_, this->vertexNumber_);
+
+  std::vector<SimplexId> offsets(last - first + 1, 0);
+  std::vector<std::array<SimplexId, 2>> pairs{};
+
+  this->forEachCellVertexInRange(
+    first, last, [&](const SimplexId cid, const SimplexId v) {
+      pairs.push_back({v - first, cid});
+      offsets[v - first + 1]++;
+    });
+
+  for(size_t i = 1; i < offsets.size(); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+
+  // cells are visited in increasing order: stars are sorted, as in
+  // ZeroSkeleton::buildVertexStars
+  std::vector<SimplexId> data(pairs.size());
+  std::vector<SimplexId> cursor(offsets.begin(), offsets.end() - 1);
+  for(const auto &p : pairs) {
+    data[cursor[p[0]]++] = p[1];
+  }
+
+  stars.setData(std::move(data), std::move(offsets));
+}
+
+void ExplicitTriangulation::buildVertexNeighborsBlock(
+  const SimplexId blockId, FlatJaggedArray &neighbors) const {
+
+  const SimplexId first = blockId * lazyBlockSize_;
+  const SimplexId last
+    = std::min<SimplexId>(first + lazyBlockSize_, this->vertexNumber_);
+
+  std::vector<std::array<SimplexId, 2>> pairs{};
+
+  this->forEachCellVertexInRange(
+    first, last, [&](const SimplexId cid, const SimplexId v) {
+      const SimplexId nbVerts = this->cellArray_->getCellVertexNumber(cid);
+      for(SimplexId j = 0; j < nbVerts; ++j) {
+        const SimplexId u = this->cellArray_->getCellVertex(cid, j);
+        if(u != v) {
+          pairs.push_back({v - first, u});
+        }
+      }
+    });
+
+  // sorted & deduplicated, as in ZeroSkeleton::buildVertexNeighbors
+  std::sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+  std::vector<SimplexId> offsets(last - first + 1, 0);
+  std::vector<SimplexId> data(pairs.size());
+  for(size_t i = 0; i < pairs.size(); ++i) {
+    offsets[pairs[i][0] + 1]++;
+    data[i] = pairs[i][1];
+  }
+  for(size_t i = 1; i < offsets.size(); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+
+  neighbors.setData(std::move(data), std::move(offsets));
+}
+
 int ExplicitTriangulation::preconditionVertexTrianglesInternal() {
 
   if(this->cellArray_ == nullptr || this->vertexNumber_ == 0) {
@@ -582,12 +791,23 @@ void writeBinArray(std::ofstream &stream,
   stream.write(reinterpret_cast<const char *>(buff), size * sizeof(T));
 }
 
+using SectionList = std::vector<std::pair<const char *, uint64_t>>;
+
+template <typename T>
+void addSection(SectionList &sections, const std::vector<T> &arr) {
+  sections.emplace_back(
+    reinterpret_cast<const char *>(arr.data()), arr.size() * sizeof(T));
+}
+
 // initialize static member variables
 const char *ExplicitTriangulation::magicBytes_ = "TTKTriangulationFileFormat";
-const unsigned long ExplicitTriangulation::formatVersion_ = 1;
+const unsigned long ExplicitTriangulation::formatVersion_ = 2;
+const uint64_t ExplicitTriangulation::sectionAlignment_ = 64;
 
 int ExplicitTriangulation::writeToFile(std::ofstream &stream) const {
 
+  const auto start = stream.tellp();
+
   // 1. magic bytes (char *)
   stream.write(this->magicBytes_, std::strlen(this->magicBytes_));
   // 2. format version (unsigned long)
@@ -627,82 +847,113 @@ int ExplicitTriangulation::writeToFile(std::ofstream &stream) const {
   // only write buffers oustside this->cellArray_ (cellVertex, vertexCoords),
   // those ones will be provided by VTK
 
+  // list the sections to write (address and size in bytes), an empty
+  // section denotes a non-preconditioned array
+  SectionList buffers{};
+
   // fixed-size arrays (in AbstractTriangulation.h)
 
-#define WRITE_FIXED(ARRAY)                             \
-  if(ARRAY.empty()) {                                  \
-    writeBin(stream, char{0});                         \
-  } else {                                             \
-    writeBin(stream, char{1});                         \
-    writeBinArray(stream, ARRAY.data(), ARRAY.size()); \
-  }
-
-  // 8. edgeList (SimplexId array)
-  WRITE_FIXED(this->edgeList_);
-  // 9. triangleList (SimplexId array)
-  WRITE_FIXED(this->triangleList_);
-  // 10. triangleEdgeList (SimplexId array)
-  WRITE_FIXED(this->triangleEdgeList_);
-  // 11. tetraEdgeList (SimplexId array)
-  WRITE_FIXED(this->tetraEdgeList_);
-  // 12. tetraTriangleList (SimplexId array)
-  WRITE_FIXED(this->tetraTriangleList_);
+  // section 0. edgeList (SimplexId array)
+  addSection(buffers, this->edgeList_);
+  // section 1. triangleList (SimplexId array)
+  addSection(buffers, this->triangleList_);
+  // section 2. triangleEdgeList (SimplexId array)
+  addSection(buffers, this->triangleEdgeList_);
+  // section 3. tetraEdgeList (SimplexId array)
+  addSection(buffers, this->tetraEdgeList_);
+  // section 4. tetraTriangleList (SimplexId array)
+  addSection(buffers, this->tetraTriangleList_);
 
   // variable-size arrays (FlatJaggedArray in ExplicitTriangulation.h)
 
-#define WRITE_GUARD(ARRAY)     \
-  if(ARRAY.empty()) {          \
-    writeBin(stream, char{0}); \
-    return;                    \
-  } else {                     \
-    writeBin(stream, char{1}); \
-  }
-
-  const auto write_variable = [&stream](const FlatJaggedArray &arr) {
-    // empty array guard
-    WRITE_GUARD(arr);
-    writeBinArray(stream, arr.offset_ptr(), arr.subvectorsNumber() + 1);
-    writeBinArray(stream, arr.get_ptr(0, 0), arr.dataSize());
+  const auto add_variable = [&buffers](const FlatJaggedArray &arr) {
+    if(arr.empty()) {
+      buffers.emplace_back(nullptr, 0);
+      buffers.emplace_back(nullptr, 0);
+      return;
+    }
+    buffers.emplace_back(reinterpret_cast<const char *>(arr.offset_ptr()),
+                         (arr.subvectorsNumber() + 1) * sizeof(SimplexId));
+    buffers.emplace_back(reinterpret_cast<const char *>(arr.data_ptr()),
+                         arr.dataSize() * sizeof(SimplexId));
   };
 
-  // 13. vertexNeighbors (SimplexId array, offsets then data)
-  write_variable(this->vertexNeighborData_);
-  // 14. cellNeighbors (SimplexId array, offsets then data)
-  write_variable(this->cellNeighborData_);
-  // 15. vertexEdges (SimplexId array, offsets then data)
-  write_variable(this->vertexEdgeData_);
-  // 16. vertexTriangles (SimplexId array, offsets then data)
-  write_variable(this->vertexTriangleData_);
-  // 17. edgeTriangles (SimplexId array, offsets then data)
-  write_variable(this->edgeTriangleData_);
-  // 18. vertexStars (SimplexId array, offsets then data)
-  write_variable(this->vertexStarData_);
-  // 19. edgeStars (SimplexId array, offsets then data)
-  write_variable(this->edgeStarData_);
-  // 20. triangleStars (SimplexId array, offsets then data)
-  write_variable(this->triangleStarData_);
-  // 21. vertexLinks (SimplexId array, offsets then data)
-  write_variable(this->vertexLinkData_);
-  // 22. edgeLinks (SimplexId array, offsets then data)
-  write_variable(this->edgeLinkData_);
-  // 23. triangleLinks (SimplexId array, offsets then data)
-  write_variable(this->triangleLinkData_);
+  // sections 5-6. vertexNeighbors (SimplexId arrays, offsets then data)
+  add_variable(this->vertexNeighborData_);
+  // sections 7-8. cellNeighbors (SimplexId arrays, offsets then data)
+  add_variable(this->cellNeighborData_);
+  // sections 9-10. vertexEdges (SimplexId arrays, offsets then data)
+  add_variable(this->vertexEdgeData_);
+  // sections 11-12. vertexTriangles (SimplexId arrays, offsets then data)
+  add_variable(this->vertexTriangleData_);
+  // sections 13-14. edgeTriangles (SimplexId arrays, offsets then data)
+  add_variable(this->edgeTriangleData_);
+  // sections 15-16. vertexStars (SimplexId arrays, offsets then data)
+  add_variable(this->vertexStarData_);
+  // sections 17-18. edgeStars (SimplexId arrays, offsets then data)
+  add_variable(this->edgeStarData_);
+  // sections 19-20. triangleStars (SimplexId arrays, offsets then data)
+  add_variable(this->triangleStarData_);
+  // sections 21-22. vertexLinks (SimplexId arrays, offsets then data)
+  add_variable(this->vertexLinkData_);
+  // sections 23-24. edgeLinks (SimplexId arrays, offsets then data)
+  add_variable(this->edgeLinkData_);
+  // sections 25-26. triangleLinks (SimplexId arrays, offsets then data)
+  add_variable(this->triangleLinkData_);
+
+  // std::vector<bool> has no contiguous storage: convert to char arrays
+  std::array<std::vector<char>, 3> boolArrays{};
+  const auto add_bool
+    = [&buffers](const std::vector<bool> &arr, std::vector<char> &chars) {
+        chars.resize(arr.size());
+        for(size_t i = 0; i < arr.size(); ++i) {
+          chars[i] = static_cast<char>(arr[i]);
+        }
+        addSection(buffers, chars);
+      };
 
-  const auto write_bool = [&stream](const std::vector<bool> &arr) {
-    // empty array guard
-    WRITE_GUARD(arr);
-    for(size_t i = 0; i < arr.size(); ++i) {
-      const auto b = static_cast<char>(arr[i]);
-      writeBin(stream, b);
-    }
+  // section 27. boundary vertices (char array)
+  add_bool(this->boundaryVertices_, boolArrays[0]);
+  // section 28. boundary edges (char array)
+  add_bool(this->boundaryEdges_, boolArrays[1]);
+  // section 29. boundary triangles (char array)
+  add_bool(this->boundaryTriangles_, boolArrays[2]);
+
+  const auto align = [](const uint64_t pos) {
+    return (pos + sectionAlignment_ - 1) / sectionAlignment_
+           * sectionAlignment_;
   };
 
-  // 24. boundary vertices (bool array)
-  write_bool(this->boundaryVertices_);
-  // 25. boundary edges (bool array)
-  write_bool(this->boundaryEdges_);
-  // 26. boundary triangles (bool array)
-  write_bool(this->boundaryTriangles_);
+  // 8. number of sections (uint64_t)
+  const uint64_t nSections = buffers.size();
+  writeBin(stream, nSections);
+
+  // 9. sections table (offset from the beginning of the triangulation
+  // and size in bytes, both uint64_t)
+  std::vector<FileSection> table(nSections);
+  uint64_t pos = align(static_cast<uint64_t>(stream.tellp() - start)
+                       + nSections * sizeof(FileSection));
+  for(size_t i = 0; i < nSections; ++i) {
+    if(buffers[i].second == 0) {
+      table[i] = {0, 0};
+      continue;
+    }
+    table[i] = {pos, buffers[i].second};
+    pos = align(pos + buffers[i].second);
+  }
+  writeBinArray(stream, table.data(), table.size());
+
+  // 10. sections content, aligned on sectionAlignment_ bytes so they can
+  // be used in-place once memory-mapped
+  const std::vector<char> padding(sectionAlignment_, 0);
+  for(size_t i = 0; i < nSections; ++i) {
+    if(table[i].size == 0) {
+      continue;
+    }
+    const auto cur = static_cast<uint64_t>(stream.tellp() - start);
+    stream.write(padding.data(), table[i].offset - cur);
+    stream.write(buffers[i].first, buffers[i].second);
+  }
 
   return 0;
 }
@@ -717,8 +968,88 @@ void readBinArray(std::ifstream &stream, T *const res, const size_t size) {
   stream.read(reinterpret_cast<char *>(res), size * sizeof(T));
 }
 
+template <typename T>
+bool readSection(
+  std::vector<T> &arr,
+  const SimplexId nItems,
+  const ExplicitTriangulation::FileSection &sec,
+  const std::function<bool(const ExplicitTriangulation::FileSection &, char *)>
+    &copySection) {
+  if(sec.size == 0) {
+    // non-preconditioned array
+    return true;
+  }
+  if(sec.size != nItems * sizeof(T)) {
+    return false;
+  }
+  arr.resize(nItems);
+  return copySection(sec, reinterpret_cast<char *>(arr.data()));
+}
+
+namespace {
+
+  // number of sections bounded by the size of the remaining data
+  bool isValidSectionsNumber(const uint64_t nSections,
+                             const uint64_t remainingSize) {
+    using FileSection = ExplicitTriangulation::FileSection;
+    return nSections <= remainingSize / sizeof(FileSection);
+  }
+
+
+  // every section lies in the first dataSize bytes of the triangulation
+  bool areValidSections(
+    const std::vector<ExplicitTriangulation::FileSection> &table,
+    const uint64_t dataSize) {
+    for(const auto &sec : table) {
+      if(sec.size > dataSize || sec.offset > dataSize - sec.size) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // offsets of a FlatJaggedArray: start at 0, non-decreasing
+  bool areValidOffsets(const SimplexId *const offsets,
+                       const SimplexId nItems) {
+    if(offsets[0] != 0) {
+      return false;
+    }
+    for(SimplexId i = 0; i < nItems; ++i) {
+      if(offsets[i + 1] < offsets[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+} // namespace
+
+int ExplicitTriangulation::checkFileHeader(const int dim,
+                                           const SimplexId nVerts,
+                                           const SimplexId nTriangles,
+                                           const SimplexId nTetras) const {
+
+  if(dim != this->getDimensionality()) {
+    this->printErr("Incorrect dimension!");
+    return -1;
+  }
+  if(nVerts != this->getNumberOfVertices()) {
+    this->printErr("Incorrect number of vertices!");
+    return -1;
+  }
+  if((dim == 2 && nTriangles != this->getNumberOfCells())
+     || (dim == 3 && nTetras != this->getNumberOfCells())) {
+    this->printErr("Incorrect number of cells!");
+    return -1;
+  }
+
+  return 0;
+}
+
 int ExplicitTriangulation::readFromFile(std::ifstream &stream) {
 
+  const auto start = stream.tellg();
+
   // 1. magic bytes (char *)
   const auto magicBytesLen = std::strlen(this->magicBytes_);
   std::vector<char> mBytes(magicBytesLen + 1);
@@ -727,7 +1058,7 @@ int ExplicitTriangulation::readFromFile(std::ifstream &stream) {
   if(!hasMagicBytes) {
     this->printErr("Could not find magic bytes in input files!");
     this->printErr("Aborting...");
-    return 0;
+    return -1;
   }
   // 2. format version (unsigned long)
   unsigned long version{};
@@ -752,19 +1083,296 @@ int ExplicitTriangulation::readFromFile(std::ifstream &stream) {
   // 7. number of tetrahedron (SimplexId, 0 in 2D)
   readBin(stream, nTetras);
 
-  if(dim != this->getDimensionality()) {
-    this->printErr("Incorrect dimension!");
-    return 0;
+  if(this->checkFileHeader(dim, nVerts, nTriangles, nTetras) != 0) {
+    return -1;
   }
-  if(nVerts != this->getNumberOfVertices()) {
-    this->printErr("Incorrect number of vertices!");
-    return 0;
+
+  if(version < 2) {
+    return this->readFromFileV1(stream, nVerts, nEdges, nTriangles, nTetras);
   }
-  if((dim == 2 && nTriangles != this->getNumberOfCells())
-     || (dim == 3 && nTetras != this->getNumberOfCells())) {
-    this->printErr("Incorrect number of cells!");
-    return 0;
+
+  // 8. number of sections (uint64_t)
+  uint64_t nSections{};
+  readBin(stream, nSections);
+  if(!stream) {
+    this->printErr("Truncated file header!");
+    return -1;
+  }
+
+  // size of the triangulation data, to bound the sections
+  const auto tablePos = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  const auto dataSize = static_cast<uint64_t>(stream.tellg() - start);
+  stream.seekg(tablePos);
+  const auto headerSize = static_cast<uint64_t>(tablePos - start);
+  if(!isValidSectionsNumber(nSections, dataSize - headerSize)) {
+    this->printErr("Truncated sections table!");
+    return -1;
+  }
+
+  // 9. sections table
+  std::vector<FileSection> table(nSections);
+  readBinArray(stream, table.data(), table.size());
+  if(!stream) {
+    this->printErr("Truncated sections table!");
+    return -1;
+  }
+  if(!areValidSections(table, dataSize)) {
+    this->printErr("Invalid section in sections table!");
+    return -1;
+  }
+
+  // 10. sections content
+  const auto copySection = [&stream, start](const FileSection &sec, char *dst) {
+    stream.seekg(start + static_cast<std::streamoff>(sec.offset));
+    stream.read(dst, sec.size);
+    return stream.good();
+  };
+
+  return this->readSections(table, nEdges, nTriangles, copySection, nullptr);
+}
+
+int ExplicitTriangulation::readFromFile(const std::string &fileName,
+                                        const bool memoryMap) {
+
+  if(!memoryMap) {
+    std::ifstream stream(fileName, std::ios::in | std::ios::binary);
+    if(!stream) {
+      this->printErr("Could not open file `" + fileName + "'");
+      return -1;
+    }
+    return this->readFromFile(stream);
+  }
+
+  auto mapping = std::make_shared<MemoryMappedFile>();
+  if(mapping->open(fileName) != 0) {
+    this->printErr("Could not map file `" + fileName + "'");
+    return -1;
+  }
+
+  const char *const base = mapping->data();
+  uint64_t pos{};
+
+  // bounds-checked read of a header field
+  const auto readField = [&mapping, base, &pos](void *const dst,
+                                                const uint64_t size) {
+    if(pos + size > mapping->size()) {
+      return false;
+    }
+    std::memcpy(dst, base + pos, size);
+    pos += size;
+    return true;
+  };
+
+  // 1. magic bytes (char *)
+  const auto magicBytesLen = std::strlen(this->magicBytes_);
+  std::vector<char> mBytes(magicBytesLen + 1);
+  // 2. format version (unsigned long)
+  unsigned long version{};
+  if(!readField(mBytes.data(), magicBytesLen)
+     || std::strcmp(mBytes.data(), this->magicBytes_) != 0
+     || !readField(&version, sizeof(version))) {
+    this->printErr("Could not find magic bytes in input files!");
+    this->printErr("Aborting...");
+    return -1;
+  }
+
+  if(version < 2) {
+    // no aligned sections in older files: stream them instead
+    this->printWrn("File format version (" + std::to_string(version)
+                   + ") cannot be memory-mapped, reading it instead");
+    mapping.reset();
+    return this->readFromFile(fileName, false);
+  }
+  if(version != this->formatVersion_) {
+    this->printWrn("File format version (" + std::to_string(version)
+                   + ") and software version ("
+                   + std::to_string(this->formatVersion_) + ") are different!");
+  }
+
+  int dim{};
+  SimplexId nVerts{}, nEdges{}, nTriangles{}, nTetras{};
+  uint64_t nSections{};
+
+  // 3.-7. dimensionality & number of simplices, 8. number of sections
+  if(!readField(&dim, sizeof(dim)) || !readField(&nVerts, sizeof(nVerts))
+     || !readField(&nEdges, sizeof(nEdges))
+     || !readField(&nTriangles, sizeof(nTriangles))
+     || !readField(&nTetras, sizeof(nTetras))
+     || !readField(&nSections, sizeof(nSections))) {
+    this->printErr("Truncated file header!");
+    return -1;
+  }
+
+  if(this->checkFileHeader(dim, nVerts, nTriangles, nTetras) != 0) {
+    return -1;
+  }
+
+  // 9. sections table
+  if(!isValidSectionsNumber(nSections, mapping->size() - pos)) {
+    this->printErr("Truncated sections table!");
+    return -1;
   }
+  std::vector<FileSection> table(nSections);
+  if(!readField(table.data(), nSections * sizeof(FileSection))) {
+    this->printErr("Truncated sections table!");
+    return -1;
+  }
+  if(!areValidSections(table, mapping->size())) {
+    this->printErr("Invalid section in sections table!");
+    return -1;
+  }
+  for(const auto &sec : table) {
+    if(sec.offset % sectionAlignment_ != 0) {
+      this->printErr("Invalid section in sections table!");
+      return -1;
+    }
+  }
+
+  // 10. sections content (directly used as variable-size arrays storage)
+  const auto copySection = [base](const FileSection &sec, char *dst) {
+    std::memcpy(dst, base + sec.offset, sec.size);
+    return true;
+  };
+
+  return this->readSections(
+    table, nEdges, nTriangles, copySection, std::move(mapping));
+}
+
+int ExplicitTriangulation::readSections(
+  const std::vector<FileSection> &table,
+  const SimplexId nEdges,
+  const SimplexId nTriangles,
+  const std::function<bool(const FileSection &, char *)> &copySection,
+  std::shared_ptr<const MemoryMappedFile> mapping) {
+
+  // sections layout of format version 2 (see writeToFile)
+  static const size_t nSections = 30;
+  if(table.size() != nSections) {
+    this->printErr("Unexpected number of sections ("
+                   + std::to_string(table.size()) + ")!");
+    return -1;
+  }
+
+  const SimplexId nVerts = this->getNumberOfVertices();
+  const SimplexId nCells = this->getNumberOfCells();
+  const SimplexId nTetras = this->getDimensionality() == 3 ? nCells : 0;
+  size_t curr{5};
+  bool valid{true};
+
+  // fixed-size arrays (in AbstractTriangulation.h)
+
+  // section 0. edgeList (SimplexId array)
+  valid &= readSection(this->edgeList_, nEdges, table[0], copySection);
+  // section 1. triangleList (SimplexId array)
+  valid &= readSection(this->triangleList_, nTriangles, table[1], copySection);
+  // section 2. triangleEdgeList (SimplexId array)
+  valid
+    &= readSection(this->triangleEdgeList_, nTriangles, table[2], copySection);
+  // section 3. tetraEdgeList (SimplexId array)
+  valid &= readSection(this->tetraEdgeList_, nTetras, table[3], copySection);
+  // section 4. tetraTriangleList (SimplexId array)
+  valid
+    &= readSection(this->tetraTriangleList_, nTetras, table[4], copySection);
+
+  // variable-size arrays (FlatJaggedArrays in ExplicitTriangulation.h)
+
+  const auto read_variable = [&](FlatJaggedArray &arr, const SimplexId nItems) {
+    const auto &offSec = table[curr++];
+    const auto &dataSec = table[curr++];
+    if(offSec.size == 0) {
+      return;
+    }
+    if(offSec.size != (nItems + 1) * sizeof(SimplexId)) {
+      valid = false;
+      return;
+    }
+    if(mapping != nullptr) {
+      // zero-copy: point into the mapped file
+      const auto base = mapping->data();
+      const auto offsets
+        = reinterpret_cast<const SimplexId *>(base + offSec.offset);
+      const auto data
+        = reinterpret_cast<const SimplexId *>(base + dataSec.offset);
+      if(!areValidOffsets(offsets, nItems)
+         || dataSec.size != offsets[nItems] * sizeof(SimplexId)) {
+        valid = false;
+        return;
+      }
+      arr.setDataView(data, offsets, nItems, mapping);
+      return;
+    }
+    std::vector<SimplexId> offsets(nItems + 1), data{};
+    valid &= copySection(offSec, reinterpret_cast<char *>(offsets.data()));
+    if(!valid || !areValidOffsets(offsets.data(), nItems)
+       || dataSec.size != offsets.back() * sizeof(SimplexId)) {
+      valid = false;
+      return;
+    }
+    data.resize(offsets.back());
+    valid &= copySection(dataSec, reinterpret_cast<char *>(data.data()));
+    arr.setData(std::move(data), std::move(offsets));
+  };
+
+  // sections 5-6. vertexNeighbors (SimplexId arrays, offsets then data)
+  read_variable(this->vertexNeighborData_, nVerts);
+  // sections 7-8. cellNeighbors (SimplexId arrays, offsets then data)
+  read_variable(this->cellNeighborData_, nCells);
+  // sections 9-10. vertexEdges (SimplexId arrays, offsets then data)
+  read_variable(this->vertexEdgeData_, nVerts);
+  // sections 11-12. vertexTriangles (SimplexId arrays, offsets then data)
+  read_variable(this->vertexTriangleData_, nVerts);
+  // sections 13-14. edgeTriangles (SimplexId arrays, offsets then data)
+  read_variable(this->edgeTriangleData_, nEdges);
+  // sections 15-16. vertexStars (SimplexId arrays, offsets then data)
+  read_variable(this->vertexStarData_, nVerts);
+  // sections 17-18. edgeStars (SimplexId arrays, offsets then data)
+  read_variable(this->edgeStarData_, nEdges);
+  // sections 19-20. triangleStars (SimplexId arrays, offsets then data)
+  read_variable(this->triangleStarData_, nTriangles);
+  // sections 21-22. vertexLinks (SimplexId arrays, offsets then data)
+  read_variable(this->vertexLinkData_, nVerts);
+  // sections 23-24. edgeLinks (SimplexId arrays, offsets then data)
+  read_variable(this->edgeLinkData_, nEdges);
+  // sections 25-26. triangleLinks (SimplexId arrays, offsets then data)
+  read_variable(this->triangleLinkData_, nTriangles);
+
+  const auto read_bool = [&](std::vector<bool> &arr, const SimplexId nItems) {
+    const auto &sec = table[curr++];
+    if(sec.size == 0) {
+      return;
+    }
+    std::vector<char> chars{};
+    if(!readSection(chars, nItems, sec, copySection)) {
+      valid = false;
+      return;
+    }
+    arr.resize(nItems);
+    for(SimplexId i = 0; i < nItems; ++i) {
+      arr[i] = static_cast<bool>(chars[i]);
+    }
+  };
+
+  // section 27. boundary vertices (char array)
+  read_bool(this->boundaryVertices_, nVerts);
+  // section 28. boundary edges (char array)
+  read_bool(this->boundaryEdges_, nEdges);
+  // section 29. boundary triangles (char array)
+  read_bool(this->boundaryTriangles_, nTriangles);
+
+  if(!valid) {
+    this->printErr("Corrupted triangulation file!");
+    return -1;
+  }
+
+  return 0;
+}
+
+int ExplicitTriangulation::readFromFileV1(std::ifstream &stream,
+                                          const SimplexId nVerts,
+                                          const SimplexId nEdges,
+                                          const SimplexId nTriangles,
+                                          const SimplexId nTetras) {
 
   // fixed-size arrays (in AbstractTriangulation.h)
 
@@ -13,7 +13,11 @@
 #include <AbstractTriangulation.h>
 #include <CellArray.h>
 #include <FlatJaggedArray.h>
+#include <FlatJaggedArrayCache.h>
+#include <Os.h>
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 
 namespace ttk {
@@ -382,17 +386,31 @@ namespace ttk {
       const int &localNeighborId,
       SimplexId &neighborId) const override {
 
+      if(vertexNeighborCache_ != nullptr) {
+        const auto &block = vertexNeighborCache_->getBlockOf(
+          vertexId, NeighborBuilder{this});
+        neighborId = block.get(
+          vertexId % vertexNeighborCache_->blockSize(), localNeighborId);
+        return 0;
+      }
       neighborId = vertexNeighborData_.get(vertexId, localNeighborId);
       return 0;
     }
 
     inline SimplexId TTK_TRIANGULATION_INTERNAL(getVertexNeighborNumber)(
       const SimplexId &vertexId) const override {
+      if(vertexNeighborCache_ != nullptr) {
+        const auto &block = vertexNeighborCache_->getBlockOf(
+          vertexId, NeighborBuilder{this});
+        return block.size(vertexId % vertexNeighborCache_->blockSize());
+      }
       return vertexNeighborData_.size(vertexId);
     }
 
     inline const std::vector<std::vector<SimplexId>> *
       TTK_TRIANGULATION_INTERNAL(getVertexNeighbors)() override {
+      // the whole list is requested: bounded memory is not possible
+      this->buildVertexNeighbors();
       vertexNeighborData_.copyTo(vertexNeighborList_);
       return &vertexNeighborList_;
     }
@@ -421,17 +439,31 @@ namespace ttk {
       const SimplexId &vertexId,
       const int &localStarId,
       SimplexId &starId) const override {
+      if(vertexStarCache_ != nullptr) {
+        const auto &block = vertexStarCache_->getBlockOf(
+          vertexId, StarBuilder{this});
+        starId
+          = block.get(vertexId % vertexStarCache_->blockSize(), localStarId);
+        return 0;
+      }
       starId = vertexStarData_.get(vertexId, localStarId);
       return 0;
     }
 
     inline SimplexId TTK_TRIANGULATION_INTERNAL(getVertexStarNumber)(
       const SimplexId &vertexId) const override {
+      if(vertexStarCache_ != nullptr) {
+        const auto &block = vertexStarCache_->getBlockOf(
+          vertexId, StarBuilder{this});
+        return block.size(vertexId % vertexStarCache_->blockSize());
+      }
       return vertexStarData_.size(vertexId);
     }
 
     inline const std::vector<std::vector<SimplexId>> *
       TTK_TRIANGULATION_INTERNAL(getVertexStars)() override {
+      // the whole list is requested: bounded memory is not possible
+      this->buildVertexStars();
       vertexStarData_.copyTo(vertexStarList_);
       return &vertexStarList_;
     }
@@ -507,7 +539,11 @@ namespace ttk {
     int preconditionVertexEdgesInternal() override;
     int preconditionVertexLinksInternal() override;
     int preconditionVertexNeighborsInternal() override;
+    int preconditionBoundedVertexNeighborsInternal(
+      const size_t memoryBudget) override;
     int preconditionVertexStarsInternal() override;
+    int preconditionBoundedVertexStarsInternal(
+      const size_t memoryBudget) override;
     int preconditionVertexTrianglesInternal() override;
 
 #ifdef TTK_CELL_ARRAY_NEW
@@ -600,10 +636,21 @@ namespace ttk {
       return 0;
     }
 
+    /**
+     * @brief Position (from the beginning of the triangulation) and size
+     * in bytes of an array in the binary file format
+     */
+    struct FileSection {
+      uint64_t offset;
+      uint64_t size;
+    };
+
     /**
      * @brief Write internal state to disk
      *
-     * Use a custom binary format for fast loading
+     * Use a custom binary format for fast loading: a header, a table
+     * of sections then every preconditioned array in its own section,
+     * aligned so that it can be used in-place once memory-mapped.
      */
     int writeToFile(std::ofstream &stream) const;
     /**
@@ -612,8 +659,65 @@ namespace ttk {
      * Use a custom binary format for fast loading
      */
     int readFromFile(std::ifstream &stream);
+    /**
+     * @brief Read from disk into internal state
+     *
+     * If @p memoryMap is true, the file is memory-mapped and the
+     * variable-size arrays (stars, links, neighbors...) directly point
+     * into the mapping instead of being copied: loading is near-instant
+     * and pages are shared between processes reading the same file.
+     * Older file format versions are silently read through a stream.
+     */
+    int readFromFile(const std::string &fileName, const bool memoryMap);
 
   private:
+    // build the whole relation (also releases the bounded-memory caches)
+    int buildVertexNeighbors();
+    int buildVertexStars();
+    // bounded-memory mode: build the relations for a block of vertices
+    void buildVertexNeighborsBlock(const SimplexId blockId,
+                                   FlatJaggedArray &neighbors) const;
+    void buildVertexStarsBlock(const SimplexId blockId,
+                               FlatJaggedArray &stars) const;
+    // block builders given to the caches on access
+    struct NeighborBuilder {
+      const ExplicitTriangulation *triangulation;
+      inline void operator()(const SimplexId blockId,
+                             FlatJaggedArray &neighbors) const {
+        triangulation->buildVertexNeighborsBlock(blockId, neighbors);
+      }
+    };
+    struct StarBuilder {
+      const ExplicitTriangulation *triangulation;
+      inline void operator()(const SimplexId blockId,
+                             FlatJaggedArray &stars) const {
+        triangulation->buildVertexStarsBlock(blockId, stars);
+      }
+    };
+    // call func(cellId, vertexId) for every vertex of every cell whose
+    // vertex is in [first, last)
+    template <typename Func>
+    void forEachCellVertexInRange(const SimplexId first,
+                                  const SimplexId last,
+                                  const Func &func) const;
+    void initCellChunkRanges();
+
+    int checkFileHeader(const int dim,
+                        const SimplexId nVerts,
+                        const SimplexId nTriangles,
+                        const SimplexId nTetras) const;
+    int readFromFileV1(std::ifstream &stream,
+                       const SimplexId nVerts,
+                       const SimplexId nEdges,
+                       const SimplexId nTriangles,
+                       const SimplexId nTetras);
+    int readSections(
+      const std::vector<FileSection> &table,
+      const SimplexId nEdges,
+      const SimplexId nTriangles,
+      const std::function<bool(const FileSection &, char *)> &copySection,
+      std::shared_ptr<const MemoryMappedFile> mapping);
+
     bool doublePrecision_;
     SimplexId cellNumber_, vertexNumber_;
     const void *pointSet_;
@@ -632,10 +736,23 @@ namespace ttk {
     FlatJaggedArray edgeLinkData_{};
     FlatJaggedArray triangleLinkData_{};
 
+    // vertex neighbors and stars preconditioned within a memory budget
+    // (see AbstractTriangulation::preconditionVertexStars(const size_t))
+    // number of vertices per cached block
+    static const SimplexId lazyBlockSize_;
+    // number of consecutive cells per chunk in cellChunkRanges_
+    static const SimplexId cellChunkSize_;
+    // vertex id range spanned by each chunk of consecutive cells
+    std::vector<std::array<SimplexId, 2>> cellChunkRanges_{};
+    std::shared_ptr<FlatJaggedArrayCache> vertexNeighborCache_{};
+    std::shared_ptr<FlatJaggedArrayCache> vertexStarCache_{};
+
     // Char array that identifies the file format.
     static const char *magicBytes_;
     // Current version of the file format. To be incremented at every
     // breaking change to keep backward compatibility.
     static const unsigned long formatVersion_;
+    // Alignment (in bytes) of the file sections
+    static const uint64_t sectionAlignment_;
   };
 } // namespace ttk
@@ -0,0 +1,291 @@
+/// \ingroup base
+//
+/// \class ttk::ftm::PairingHeap
+/// \date October 2021.
+///
+///\brief TTK pairing heap used for the propagations of the merge trees.
+///
+/// Vertices are keyed on the order array (offsets) of the input scalar
+/// field, stored in the nodes so that comparisons do not need to read the
+/// order array again. Insertion and meld are O(1), removal of the minimum
+/// is O(log n) amortized.
+///
+/// Nodes are allocated by chunks owned by the heap. When two heaps are
+/// melded, the chunks of the absorbed heap are transferred as well, with
+/// its free nodes: node addresses are stable for the whole life of the
+/// heap and no node is lost.
+
+#ifndef FTMPAIRINGHEAP_H
+#define FTMPAIRINGHEAP_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "FTMDataTypes.h"
+
+namespace ttk {
+  namespace ftm {
+
+    class PairingHeap {
+    private:
+      struct Node {
+        SimplexId key;
+        SimplexId vertex;
+        Node *child;
+        Node *sibling;
+      };
+
+      static const std::size_t minChunkSize = 16;
+      static const std::size_t maxChunkSize = 16384;
+
+      // order array and direction of the propagation
+      const SimplexId *const *offsets_;
+      SimplexId keyMask_;
+
+      Node *root_{};
+      Node *freeList_{};
+      // remaining part of the current chunk
+      Node *nextNode_{};
+      Node *endNode_{};
+      // remaining parts of the chunks of the melded heaps
+      std::vector<std::pair<Node *, Node *>> spareRanges_{};
+      std::size_t chunkSize_{minChunkSize};
+      std::vector<std::unique_ptr<Node[]>> chunks_{};
+
+    public:
+      /// offsets is the address of the order array pointer, read on
+      /// insertion. If higherFirst is true, the heap pops the vertex of
+      /// highest offset first, else the one of lowest offset.
+      PairingHeap(const SimplexId *const *offsets, const bool higherFirst)
+        : offsets_(offsets), keyMask_(higherFirst ? ~SimplexId(0) : 0) {
+      }
+
+      PairingHeap(const PairingHeap &other)
+        : offsets_(other.offsets_), keyMask_(other.keyMask_) {
+        copyFrom(other);
+      }
+
+      PairingHeap(PairingHeap &&other) noexcept
+        : offsets_(other.offsets_), keyMask_(other.keyMask_),
+          root_(other.root_), freeList_(other.freeList_),
+          nextNode_(other.nextNode_), endNode_(other.endNode_),
+          spareRanges_(std::move(other.spareRanges_)),
+          chunkSize_(other.chunkSize_), chunks_(std::move(other.chunks_)) {
+        other.reset();
+      }
+
+      PairingHeap &operator=(const PairingHeap &other) {
+        if(this != &other) {
+          clear();
+          offsets_ = other.offsets_;
+          keyMask_ = other.keyMask_;
+          copyFrom(other);
+        }
+        return *this;
+      }
+
+      PairingHeap &operator=(PairingHeap &&other) noexcept {
+        if(this != &other) {
+          offsets_ = other.offsets_;
+          keyMask_ = other.keyMask_;
+          root_ = other.root_;
+          freeList_ = other.freeList_;
+          nextNode_ = other.nextNode_;
+          endNode_ = other.endNode_;
+          spareRanges_ = std::move(other.spareRanges_);
+          chunkSize_ = other.chunkSize_;
+          chunks_ = std::move(other.chunks_);
+          other.reset();
+        }
+        return *this;
+      }
+
+      inline bool empty(void) const {
+        return root_ == nullptr;
+      }
+
+      inline SimplexId top(void) const {
+        return root_->vertex;
+      }
+
+      inline void emplace(const SimplexId v) {
+        Node *node = allocate();
+        node->key = (*offsets_)[v] ^ keyMask_;
+        node->vertex = v;
+        node->child = nullptr;
+        node->sibling = nullptr;
+        root_ = root_ ? link(root_, node) : node;
+      }
+
+      inline void pop(void) {
+        Node *oldRoot = root_;
+        root_ = combineSiblings(oldRoot->child);
+        oldRoot->sibling = freeList_;
+        freeList_ = oldRoot;
+      }
+
+      /// Meld other in this heap, other is left empty
+      void merge(PairingHeap &other) {
+        if(this == &other) {
+          return;
+        }
+        if(other.root_) {
+          root_ = root_ ? link(root_, other.root_) : other.root_;
+        }
+
+        // keep the free nodes of other: its free list is appended to ours
+        // and the remaining parts of its chunks are kept for allocate(),
+        // without touching their (possibly not yet mapped) memory
+        if(other.freeList_) {
+          Node *last = other.freeList_;
+          while(last->sibling) {
+            last = last->sibling;
+          }
+          last->sibling = freeList_;
+          freeList_ = other.freeList_;
+        }
+        if(other.nextNode_ != other.endNode_) {
+          spareRanges_.emplace_back(other.nextNode_, other.endNode_);
+        }
+        spareRanges_.insert(spareRanges_.end(), other.spareRanges_.begin(),
+                            other.spareRanges_.end());
+        if(other.chunkSize_ > chunkSize_) {
+          chunkSize_ = other.chunkSize_;
+        }
+
+        for(auto &chunk : other.chunks_) {
+          chunks_.emplace_back(std::move(chunk));
+        }
+        other.reset();
+      }
+
+      /// Remove all the vertices and release the memory
+      void clear(void) {
+        reset();
+        chunkSize_ = minChunkSize;
+      }
+
+      // DEBUG ONLY
+      bool find(const SimplexId v) const {
+        std::vector<const Node *> stack;
+        if(root_) {
+          stack.emplace_back(root_);
+        }
+        while(!stack.empty()) {
+          const Node *node = stack.back();
+          stack.pop_back();
+          if(node->vertex == v) {
+            return true;
+          }
+          for(const Node *c = node->child; c != nullptr; c = c->sibling) {
+            stack.emplace_back(c);
+          }
+        }
+        return false;
+      }
+
+    private:
+      void reset(void) {
+        root_ = nullptr;
+        freeList_ = nullptr;
+        nextNode_ = nullptr;
+        endNode_ = nullptr;
+        spareRanges_.clear();
+        chunks_.clear();
+      }
+
+      void copyFrom(const PairingHeap &other) {
+        std::vector<const Node *> stack;
+        if(other.root_) {
+          stack.emplace_back(other.root_);
+        }
+        while(!stack.empty()) {
+          const Node *node = stack.back();
+          stack.pop_back();
+          Node *copy = allocate();
+          copy->key = node->key;
+          copy->vertex = node->vertex;
+          copy->child = nullptr;
+          copy->sibling = nullptr;
+          root_ = root_ ? link(root_, copy) : copy;
+          for(const Node *c = node->child; c != nullptr; c = c->sibling) {
+            stack.emplace_back(c);
+          }
+        }
+      }
+
+      inline Node *allocate(void) {
+        if(freeList_) {
+          Node *node = freeList_;
+          freeList_ = node->sibling;
+          return node;
+        }
+        if(nextNode_ == endNode_ && !spareRanges_.empty()) {
+          nextNode_ = spareRanges_.back().first;
+          endNode_ = spareRanges_.back().second;
+          spareRanges_.pop_back();
+        }
+        if(nextNode_ == endNode_) {
+          chunks_.emplace_back(new Node[chunkSize_]);
+          nextNode_ = chunks_.back().get();
+          endNode_ = nextNode_ + chunkSize_;
+          if(chunkSize_ < maxChunkSize) {
+            chunkSize_ *= 2;
+          }
+        }
+        return nextNode_++;
+      }
+
+      // a and b are roots without siblings
+      static inline Node *link(Node *a, Node *b) {
+        if(b->key < a->key) {
+          std::swap(a, b);
+        }
+        b->sibling = a->child;
+        a->child = b;
+        return a;
+      }
+
+      // two-pass pairing of the children of a removed root
+      static Node *combineSiblings(Node *first) {
+        if(!first) {
+          return nullptr;
+        }
+
+        // left to right: link pairs, stacked in reverse order
+        Node *pairs = nullptr;
+        while(first) {
+          Node *a = first;
+          Node *b = a->sibling;
+          if(!b) {
+            a->sibling = pairs;
+            pairs = a;
+            break;
+          }
+          first = b->sibling;
+          a->sibling = nullptr;
+          b->sibling = nullptr;
+          Node *m = link(a, b);
+          m->sibling = pairs;
+          pairs = m;
+        }
+
+        // right to left: accumulate the pairs in a single tree
+        Node *res = pairs;
+        pairs = pairs->sibling;
+        res->sibling = nullptr;
+        while(pairs) {
+          Node *next = pairs->sibling;
+          pairs->sibling = nullptr;
+          res = link(res, pairs);
+          pairs = next;
+        }
+        return res;
+      }
+    };
+
+  } // namespace ftm
+} // namespace ttk
+
+#endif /* end of include guard: FTMPAIRINGHEAP_H */
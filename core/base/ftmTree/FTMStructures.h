@@ -14,7 +14,11 @@
 #include <memory>
 #include <vector>
 
+#ifdef TTK_ENABLE_FTM_TREE_FIBONACCI_HEAP
 #include <boost/heap/fibonacci_heap.hpp>
+#else
+#include "FTMPairingHeap.h"
+#endif
 
 #include "FTMAtomicVector.h"
 #include "FTMDataTypes.h"
@@ -67,6 +71,7 @@ namespace ttk {
 
     struct CurrentState {
       SimplexId vertex;
+#ifdef TTK_ENABLE_FTM_TREE_FIBONACCI_HEAP
       boost::heap::fibonacci_heap<SimplexId, boost::heap::compare<VertCompFN>>
         propagation;
 
@@ -78,6 +83,19 @@ namespace ttk {
         : vertex(nullVertex), propagation(vertComp) {
         // will need to use setStartVert before use
       }
+#else
+      // keyed on the order array, pops the lowest vertex in the tree order
+      PairingHeap propagation;
+
+      CurrentState(SimplexId startVert, const Scalars *scalars, bool isST)
+        : vertex(startVert), propagation(&scalars->offsets, isST) {
+      }
+
+      CurrentState(const Scalars *scalars, bool isST)
+        : vertex(nullVertex), propagation(&scalars->offsets, isST) {
+        // will need to use setStartVert before use
+      }
+#endif
 
       void setStartVert(const SimplexId v) {
         vertex = v;
@@ -104,8 +122,12 @@ namespace ttk {
 
       // DEBUG ONLY
       bool find(SimplexId v) {
+#ifdef TTK_ENABLE_FTM_TREE_FIBONACCI_HEAP
         return std::find(propagation.begin(), propagation.end(), v)
                != propagation.end();
+#else
+        return propagation.find(v);
+#endif
       }
     };
 
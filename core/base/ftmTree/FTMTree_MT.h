@@ -211,8 +211,13 @@ namespace ttk {
 
       void initVectStates(const SimplexId nbLeaves) {
         if(!mt_data_.states) {
+#ifdef TTK_ENABLE_FTM_TREE_FIBONACCI_HEAP
           mt_data_.states
             = new FTMAtomicVector<CurrentState>(nbLeaves, comp_.vertHigher);
+#else
+          mt_data_.states = new FTMAtomicVector<CurrentState>(
+            nbLeaves, CurrentState{scalars_, isST()});
+#endif
         }
         mt_data_.states->clear();
         mt_data_.states->reserve(nbLeaves);
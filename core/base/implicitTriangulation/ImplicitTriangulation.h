@@ -6,7 +6,12 @@
 /// \brief ImplicitTriangulation is a class that provides time and memory
 /// efficient traversal methods on triangulations of piecewise linear
 /// manifolds represented by regular grids.
+///
+/// ImplicitTriangulation2D and ImplicitTriangulation3D specialize the most
+/// frequent queries for grids of a known dimension.
+///
 /// \sa Triangulation
+/// \sa ImplicitTriangulationDim
 
 #pragma once
 
@@ -14,16 +19,17 @@
 
 // base code includes
 #include <AbstractTriangulation.h>
+#include <ImplicitGridStencil.h>
 
 namespace ttk {
 
-  class ImplicitTriangulation final : public AbstractTriangulation {
+  class ImplicitTriangulation : public AbstractTriangulation {
 
   public:
     ImplicitTriangulation();
     ~ImplicitTriangulation();
 
-    int getGridDimensions(std::vector<int> &dimensions) override {
+    int getGridDimensions(std::vector<int> &dimensions) final {
 
       dimensions.resize(3);
       dimensions[0] = dimensions_[0];
@@ -33,38 +39,43 @@ namespace ttk {
       return 0;
     }
 
+    /// Number of vertices along each axis (const access)
+    inline std::array<SimplexId, 3> getGridDimensions() const {
+      return {dimensions_[0], dimensions_[1], dimensions_[2]};
+    }
+
     int getCellEdgeInternal(const SimplexId &cellId,
                             const int &id,
-                            SimplexId &edgeId) const override;
+                            SimplexId &edgeId) const final;
 
-    SimplexId getCellEdgeNumberInternal(const SimplexId &cellId) const override;
+    SimplexId getCellEdgeNumberInternal(const SimplexId &cellId) const final;
 
-    const std::vector<std::vector<SimplexId>> *getCellEdgesInternal() override;
+    const std::vector<std::vector<SimplexId>> *getCellEdgesInternal() final;
 
     int TTK_TRIANGULATION_INTERNAL(getCellNeighbor)(
       const SimplexId &cellId,
       const int &localNeighborId,
-      SimplexId &neighborId) const override;
+      SimplexId &neighborId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getCellNeighborNumber)(
-      const SimplexId &cellId) const override;
+      const SimplexId &cellId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getCellNeighbors)() override;
+      TTK_TRIANGULATION_INTERNAL(getCellNeighbors)() final;
 
     int getCellTriangleInternal(const SimplexId &cellId,
                                 const int &id,
-                                SimplexId &triangleId) const override;
+                                SimplexId &triangleId) const final;
 
     SimplexId getCellTriangleNumberInternal(
-      const SimplexId & /*cellId*/) const override {
+      const SimplexId & /*cellId*/) const final {
       // NOTE: the output is always 4 here. let's keep the function in there
       // in case of further generalization to CW-complexes
       return 4;
     };
 
     const std::vector<std::vector<SimplexId>> *
-      getCellTrianglesInternal() override;
+      getCellTrianglesInternal() final;
 
     int TTK_TRIANGULATION_INTERNAL(getCellVertex)(
       const SimplexId &cellId,
@@ -81,55 +92,55 @@ namespace ttk {
     int
       TTK_TRIANGULATION_INTERNAL(getEdgeLink)(const SimplexId &edgeId,
                                               const int &localLinkId,
-                                              SimplexId &linkId) const override;
+                                              SimplexId &linkId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getEdgeLinkNumber)(
-      const SimplexId &edgeId) const override;
+      const SimplexId &edgeId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getEdgeLinks)() override;
+      TTK_TRIANGULATION_INTERNAL(getEdgeLinks)() final;
 
     int
       TTK_TRIANGULATION_INTERNAL(getEdgeStar)(const SimplexId &edgeId,
                                               const int &localStarId,
-                                              SimplexId &starId) const override;
+                                              SimplexId &starId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getEdgeStarNumber)(
-      const SimplexId &edgeId) const override;
+      const SimplexId &edgeId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getEdgeStars)() override;
+      TTK_TRIANGULATION_INTERNAL(getEdgeStars)() final;
 
     int getEdgeTriangleInternal(const SimplexId &edgeId,
                                 const int &id,
-                                SimplexId &triangleId) const override;
+                                SimplexId &triangleId) const final;
 
     SimplexId
-      getEdgeTriangleNumberInternal(const SimplexId &edgeId) const override;
+      getEdgeTriangleNumberInternal(const SimplexId &edgeId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      getEdgeTrianglesInternal() override;
+      getEdgeTrianglesInternal() final;
 
     int getEdgeVertexInternal(const SimplexId &edgeId,
                               const int &localVertexId,
-                              SimplexId &vertexId) const override;
+                              SimplexId &vertexId) const final;
 
     const std::vector<std::array<SimplexId, 2>> *
-      TTK_TRIANGULATION_INTERNAL(getEdges)() override;
+      TTK_TRIANGULATION_INTERNAL(getEdges)() final;
 
-    SimplexId TTK_TRIANGULATION_INTERNAL(getNumberOfCells)() const override {
+    SimplexId TTK_TRIANGULATION_INTERNAL(getNumberOfCells)() const final {
       return cellNumber_;
     };
 
-    SimplexId getNumberOfEdgesInternal() const override {
+    SimplexId getNumberOfEdgesInternal() const final {
       return edgeNumber_;
     };
 
-    SimplexId getNumberOfTrianglesInternal() const override {
+    SimplexId getNumberOfTrianglesInternal() const final {
       return triangleNumber_;
     };
 
-    SimplexId TTK_TRIANGULATION_INTERNAL(getNumberOfVertices)() const override {
+    SimplexId TTK_TRIANGULATION_INTERNAL(getNumberOfVertices)() const final {
       return vertexNumber_;
     };
 
@@ -160,17 +171,17 @@ namespace ttk {
 
     int getTriangleEdgeInternal(const SimplexId &triangleId,
                                 const int &id,
-                                SimplexId &edgeId) const override;
+                                SimplexId &edgeId) const final;
 
     SimplexId getTriangleEdgeNumberInternal(
-      const SimplexId & /*triangleId*/) const override {
+      const SimplexId & /*triangleId*/) const final {
       // NOTE: the output is always 3 here. let's keep the function in there
       // in case of further generalization to CW-complexes
       return 3;
     }
 
     const std::vector<std::vector<SimplexId>> *
-      getTriangleEdgesInternal() override;
+      getTriangleEdgesInternal() final;
 
     int getTriangleEdgesInternal(
       std::vector<std::vector<SimplexId>> &edges) const;
@@ -178,13 +189,13 @@ namespace ttk {
     int TTK_TRIANGULATION_INTERNAL(getTriangleLink)(
       const SimplexId &triangleId,
       const int &localLinkId,
-      SimplexId &linkId) const override;
+      SimplexId &linkId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getTriangleLinkNumber)(
-      const SimplexId &triangleId) const override;
+      const SimplexId &triangleId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getTriangleLinks)() override;
+      TTK_TRIANGULATION_INTERNAL(getTriangleLinks)() final;
 
     int getTriangleNeighbor(const SimplexId &triangleId,
                             const int &localNeighborId,
@@ -197,41 +208,41 @@ namespace ttk {
     int TTK_TRIANGULATION_INTERNAL(getTriangleStar)(
       const SimplexId &triangleId,
       const int &localStarId,
-      SimplexId &starId) const override;
+      SimplexId &starId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getTriangleStarNumber)(
-      const SimplexId &triangleId) const override;
+      const SimplexId &triangleId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getTriangleStars)() override;
+      TTK_TRIANGULATION_INTERNAL(getTriangleStars)() final;
 
     int getTriangleVertexInternal(const SimplexId &triangleId,
                                   const int &localVertexId,
-                                  SimplexId &vertexId) const override;
+                                  SimplexId &vertexId) const final;
 
     const std::vector<std::array<SimplexId, 3>> *
-      TTK_TRIANGULATION_INTERNAL(getTriangles)() override;
+      TTK_TRIANGULATION_INTERNAL(getTriangles)() final;
 
     int getVertexEdgeInternal(const SimplexId &vertexId,
                               const int &id,
-                              SimplexId &edgeId) const override;
+                              SimplexId &edgeId) const final;
 
     SimplexId
-      getVertexEdgeNumberInternal(const SimplexId &vertexId) const override;
+      getVertexEdgeNumberInternal(const SimplexId &vertexId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      getVertexEdgesInternal() override;
+      getVertexEdgesInternal() final;
 
     int TTK_TRIANGULATION_INTERNAL(getVertexLink)(
       const SimplexId &vertexId,
       const int &localLinkId,
-      SimplexId &linkId) const override;
+      SimplexId &linkId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getVertexLinkNumber)(
-      const SimplexId &vertexId) const override;
+      const SimplexId &vertexId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getVertexLinks)() override;
+      TTK_TRIANGULATION_INTERNAL(getVertexLinks)() final;
 
     int TTK_TRIANGULATION_INTERNAL(getVertexNeighbor)(
       const SimplexId &vertexId,
@@ -246,7 +257,7 @@ namespace ttk {
         return -1;
 #endif // !TTK_ENABLE_KAMIKAZE
 
-      switch(vertexPositions_[vertexId]) {
+      switch(this->getVertexPosition(vertexId)) {
         case VertexPosition::CENTER_3D:
           return 14;
         case VertexPosition::FRONT_FACE_3D:
@@ -301,43 +312,43 @@ namespace ttk {
     }
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getVertexNeighbors)() override;
+      TTK_TRIANGULATION_INTERNAL(getVertexNeighbors)() final;
 
     int TTK_TRIANGULATION_INTERNAL(getVertexPoint)(const SimplexId &vertexId,
                                                    float &x,
                                                    float &y,
-                                                   float &z) const override;
+                                                   float &z) const final;
 
     int TTK_TRIANGULATION_INTERNAL(getVertexStar)(
       const SimplexId &vertexId,
       const int &localStarId,
-      SimplexId &starId) const override;
+      SimplexId &starId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getVertexStarNumber)(
-      const SimplexId &vertexId) const override;
+      const SimplexId &vertexId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getVertexStars)() override;
+      TTK_TRIANGULATION_INTERNAL(getVertexStars)() final;
 
     int getVertexTriangleInternal(const SimplexId &vertexId,
                                   const int &id,
-                                  SimplexId &triangleId) const override;
+                                  SimplexId &triangleId) const final;
 
     SimplexId
-      getVertexTriangleNumberInternal(const SimplexId &vertexId) const override;
+      getVertexTriangleNumberInternal(const SimplexId &vertexId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      getVertexTrianglesInternal() override;
+      getVertexTrianglesInternal() final;
 
     bool TTK_TRIANGULATION_INTERNAL(isEdgeOnBoundary)(
-      const SimplexId &edgeId) const override;
+      const SimplexId &edgeId) const final;
 
-    inline bool isEmpty() const override {
+    inline bool isEmpty() const final {
       return !vertexNumber_;
     };
 
     bool TTK_TRIANGULATION_INTERNAL(isTriangleOnBoundary)(
-      const SimplexId &triangleId) const override;
+      const SimplexId &triangleId) const final;
 
     bool TTK_TRIANGULATION_INTERNAL(isVertexOnBoundary)(
       const SimplexId &vertexId) const override;
@@ -352,10 +363,30 @@ namespace ttk {
                      const SimplexId &yDim,
                      const SimplexId &zDim);
 
+    /// Enable or disable the per-simplex lookup tables (positions on the
+    /// grid and grid coordinates of the vertices, edges, triangles and
+    /// tetrahedra). Without them, this information is derived from the
+    /// simplex identifiers on every query: preconditioning then allocates
+    /// nothing, at the price of a few integer divisions per query.
+    /// Enabled by default, unless TTK is configured with
+    /// TTK_ENABLE_IMPLICIT_LOOKUP_TABLES=OFF.
+    ///
+    /// On a 128^3 grid (one thread, see
+    /// standalone/ImplicitTriangulationBenchmark), disabling the tables
+    /// saves about 490 MB and 0.7 s of preconditioning, while vertex
+    /// neighbor queries become up to 2.7 times slower, edge queries about
+    /// 2 times slower and triangle and cell queries up to 1.7 times
+    /// slower.
+    void setLookupTables(const bool useLookupTables);
+
+    inline bool getLookupTables() const {
+      return useLookupTables_;
+    }
+
     int preconditionVerticesInternal();
-    int preconditionVertexNeighborsInternal() override;
-    int preconditionEdgesInternal() override;
-    int preconditionTrianglesInternal() override;
+    int preconditionVertexNeighborsInternal() final;
+    int preconditionEdgesInternal() final;
+    int preconditionTrianglesInternal() final;
     int preconditionTetrahedronsInternal();
 
     inline int preconditionCellsInternal() {
@@ -594,6 +625,46 @@ namespace ttk {
     // for every tetrahedron, its coordinates on the grid
     std::vector<std::array<SimplexId, 3>> tetrahedronCoords_{};
 
+    // store the positions and coordinates above (or derive them on the fly)
+#ifdef TTK_DISABLE_IMPLICIT_LOOKUP_TABLES
+    bool useLookupTables_{false};
+#else
+    bool useLookupTables_{true};
+#endif // TTK_DISABLE_IMPLICIT_LOOKUP_TABLES
+
+    // position and grid coordinates of the simplices, read from the lookup
+    // tables or derived from the simplex identifiers
+    inline VertexPosition getVertexPosition(const SimplexId vertexId) const;
+    inline VertexPosition getVertexPosition(const SimplexId vertexId,
+                                            std::array<SimplexId, 3> &p) const;
+    inline std::array<SimplexId, 3>
+      getVertexCoords(const SimplexId vertexId) const;
+    inline EdgePosition getEdgePosition(const SimplexId edgeId) const;
+    inline EdgePosition getEdgePosition(const SimplexId edgeId,
+                                        std::array<SimplexId, 3> &p) const;
+    inline TrianglePosition
+      getTrianglePosition(const SimplexId triangleId,
+                          std::array<SimplexId, 3> &p) const;
+    inline std::array<SimplexId, 3>
+      getTriangleCoords(const SimplexId triangleId) const;
+    inline std::array<SimplexId, 3>
+      getTetrahedronCoords(const SimplexId tetId) const;
+
+    // class of a grid coordinate, in the order of the position names:
+    // inside (n), on the first layer (0) or on the last layer (N)
+    static inline int coordinateClass(const SimplexId x,
+                                      const SimplexId last) {
+      return (x == 0) + 2 * (x >= last);
+    }
+
+    // classification of the simplices from their identifiers
+    inline VertexPosition computeVertexPosition(const SimplexId vertexId,
+                                                SimplexId p[3]) const;
+    inline EdgePosition computeEdgePosition(const SimplexId edgeId,
+                                            SimplexId p[3]) const;
+    inline TrianglePosition computeTrianglePosition(const SimplexId triangleId,
+                                                    SimplexId p[3]) const;
+
     int dimensionality_; //
     float origin_[3]; //
     float spacing_[3]; //
@@ -1542,6 +1613,236 @@ inline void
   p[2] = tetrahedron / tetshift_[1];
 }
 
+inline ttk::ImplicitTriangulation::VertexPosition
+  ttk::ImplicitTriangulation::computeVertexPosition(const SimplexId vertexId,
+                                                    SimplexId p[3]) const {
+  using VP = VertexPosition;
+
+  if(dimensionality_ == 3) {
+    // indexed by the classes of x, y and z
+    static const VP positions[27] = {
+      VP::CENTER_3D,
+      VP::FRONT_FACE_3D,
+      VP::BACK_FACE_3D,
+      VP::TOP_FACE_3D,
+      VP::TOP_FRONT_EDGE_3D,
+      VP::TOP_BACK_EDGE_3D,
+      VP::BOTTOM_FACE_3D,
+      VP::BOTTOM_FRONT_EDGE_3D,
+      VP::BOTTOM_BACK_EDGE_3D,
+      VP::LEFT_FACE_3D,
+      VP::LEFT_FRONT_EDGE_3D,
+      VP::LEFT_BACK_EDGE_3D,
+      VP::TOP_LEFT_EDGE_3D,
+      VP::TOP_LEFT_FRONT_CORNER_3D,
+      VP::TOP_LEFT_BACK_CORNER_3D,
+      VP::BOTTOM_LEFT_EDGE_3D,
+      VP::BOTTOM_LEFT_FRONT_CORNER_3D,
+      VP::BOTTOM_LEFT_BACK_CORNER_3D,
+      VP::RIGHT_FACE_3D,
+      VP::RIGHT_FRONT_EDGE_3D,
+      VP::RIGHT_BACK_EDGE_3D,
+      VP::TOP_RIGHT_EDGE_3D,
+      VP::TOP_RIGHT_FRONT_CORNER_3D,
+      VP::TOP_RIGHT_BACK_CORNER_3D,
+      VP::BOTTOM_RIGHT_EDGE_3D,
+      VP::BOTTOM_RIGHT_FRONT_CORNER_3D,
+      VP::BOTTOM_RIGHT_BACK_CORNER_3D,
+    };
+    vertexToPosition(vertexId, p);
+    return positions[9 * coordinateClass(p[0], nbvoxels_[0])
+                     + 3 * coordinateClass(p[1], nbvoxels_[1])
+                     + coordinateClass(p[2], nbvoxels_[2])];
+
+  } else if(dimensionality_ == 2) {
+    // indexed by the classes of x and y
+    static const VP positions[9] = {
+      VP::CENTER_2D,
+      VP::TOP_EDGE_2D,
+      VP::BOTTOM_EDGE_2D,
+      VP::LEFT_EDGE_2D,
+      VP::TOP_LEFT_CORNER_2D,
+      VP::BOTTOM_LEFT_CORNER_2D,
+      VP::RIGHT_EDGE_2D,
+      VP::TOP_RIGHT_CORNER_2D,
+      VP::BOTTOM_RIGHT_CORNER_2D,
+    };
+    vertexToPosition2d(vertexId, p);
+    return positions[3 * coordinateClass(p[0], nbvoxels_[Di_])
+                     + coordinateClass(p[1], nbvoxels_[Dj_])];
+  }
+
+  if(vertexId == vertexNumber_ - 1)
+    return VP::RIGHT_CORNER_1D;
+  if(vertexId == 0)
+    return VP::LEFT_CORNER_1D;
+  return VP::CENTER_1D;
+}
+
+inline ttk::ImplicitTriangulation::EdgePosition
+  ttk::ImplicitTriangulation::computeEdgePosition(const SimplexId edgeId,
+                                                  SimplexId p[3]) const {
+  // position of the given class offset in a group of edge positions
+  const auto shift = [](const EdgePosition first, const int offset) {
+    return static_cast<EdgePosition>(static_cast<int>(first) + offset);
+  };
+
+  if(dimensionality_ == 3) {
+    int k = 0;
+    while(k < 6 && edgeId >= esetshift_[k])
+      ++k;
+    edgeToPosition(edgeId, k, p);
+    const int cx = coordinateClass(p[0], nbvoxels_[0]);
+    const int cy = coordinateClass(p[1], nbvoxels_[1]);
+    const int cz = coordinateClass(p[2], nbvoxels_[2]);
+    switch(k) {
+      case 0:
+        return shift(EdgePosition::L_xnn_3D, 3 * cy + cz);
+      case 1:
+        return shift(EdgePosition::H_nyn_3D, 3 * cx + cz);
+      case 2:
+        return shift(EdgePosition::P_nnz_3D, 3 * cx + cy);
+      case 3:
+        return shift(EdgePosition::D1_xyn_3D, cz);
+      case 4:
+        return shift(EdgePosition::D2_nyz_3D, cx);
+      case 5:
+        return shift(EdgePosition::D3_xnz_3D, cy);
+      default:
+        return EdgePosition::D4_3D;
+    }
+
+  } else if(dimensionality_ == 2) {
+    int k = 0;
+    while(k < 2 && edgeId >= esetshift_[k])
+      ++k;
+    edgeToPosition2d(edgeId, k, p);
+    switch(k) {
+      case 0:
+        return shift(
+          EdgePosition::L_xn_2D, coordinateClass(p[1], nbvoxels_[Dj_]));
+      case 1:
+        return shift(
+          EdgePosition::H_ny_2D, coordinateClass(p[0], nbvoxels_[Di_]));
+      default:
+        return EdgePosition::D1_2D;
+    }
+  }
+
+  if(edgeId == edgeNumber_ - 1)
+    return EdgePosition::LAST_EDGE_1D;
+  if(edgeId == 0)
+    return EdgePosition::FIRST_EDGE_1D;
+  return EdgePosition::CENTER_1D;
+}
+
+inline ttk::ImplicitTriangulation::TrianglePosition
+  ttk::ImplicitTriangulation::computeTrianglePosition(
+    const SimplexId triangleId, SimplexId p[3]) const {
+  if(dimensionality_ == 3) {
+    // indexed by the triangle set
+    static const TrianglePosition positions[6] = {
+      TrianglePosition::F_3D,  TrianglePosition::H_3D,
+      TrianglePosition::C_3D,  TrianglePosition::D1_3D,
+      TrianglePosition::D2_3D, TrianglePosition::D3_3D,
+    };
+    int k = 0;
+    while(k < 5 && triangleId >= tsetshift_[k])
+      ++k;
+    triangleToPosition(triangleId, k, p);
+    return positions[k];
+  }
+
+  triangleToPosition2d(triangleId, p);
+  return triangleId % 2 == 0 ? TrianglePosition::TOP_2D
+                             : TrianglePosition::BOTTOM_2D;
+}
+
+inline ttk::ImplicitTriangulation::VertexPosition
+  ttk::ImplicitTriangulation::getVertexPosition(
+    const SimplexId vertexId) const {
+  if(useLookupTables_) {
+    return vertexPositions_[vertexId];
+  }
+  SimplexId p[3]{};
+  return this->computeVertexPosition(vertexId, p);
+}
+
+inline ttk::ImplicitTriangulation::VertexPosition
+  ttk::ImplicitTriangulation::getVertexPosition(
+    const SimplexId vertexId, std::array<SimplexId, 3> &p) const {
+  if(useLookupTables_) {
+    p = vertexCoords_[vertexId];
+    return vertexPositions_[vertexId];
+  }
+  return this->computeVertexPosition(vertexId, p.data());
+}
+
+inline std::array<ttk::SimplexId, 3>
+  ttk::ImplicitTriangulation::getVertexCoords(const SimplexId vertexId) const {
+  if(useLookupTables_) {
+    return vertexCoords_[vertexId];
+  }
+  std::array<SimplexId, 3> p{};
+  if(dimensionality_ == 3) {
+    vertexToPosition(vertexId, p.data());
+  } else if(dimensionality_ == 2) {
+    vertexToPosition2d(vertexId, p.data());
+  }
+  return p;
+}
+
+inline ttk::ImplicitTriangulation::EdgePosition
+  ttk::ImplicitTriangulation::getEdgePosition(const SimplexId edgeId) const {
+  if(useLookupTables_) {
+    return edgePositions_[edgeId];
+  }
+  SimplexId p[3]{};
+  return this->computeEdgePosition(edgeId, p);
+}
+
+inline ttk::ImplicitTriangulation::EdgePosition
+  ttk::ImplicitTriangulation::getEdgePosition(
+    const SimplexId edgeId, std::array<SimplexId, 3> &p) const {
+  if(useLookupTables_) {
+    p = edgeCoords_[edgeId];
+    return edgePositions_[edgeId];
+  }
+  return this->computeEdgePosition(edgeId, p.data());
+}
+
+inline ttk::ImplicitTriangulation::TrianglePosition
+  ttk::ImplicitTriangulation::getTrianglePosition(
+    const SimplexId triangleId, std::array<SimplexId, 3> &p) const {
+  if(useLookupTables_) {
+    p = triangleCoords_[triangleId];
+    return trianglePositions_[triangleId];
+  }
+  return this->computeTrianglePosition(triangleId, p.data());
+}
+
+inline std::array<ttk::SimplexId, 3>
+  ttk::ImplicitTriangulation::getTriangleCoords(
+    const SimplexId triangleId) const {
+  if(useLookupTables_) {
+    return triangleCoords_[triangleId];
+  }
+  std::array<SimplexId, 3> p{};
+  this->computeTrianglePosition(triangleId, p.data());
+  return p;
+}
+
+inline std::array<ttk::SimplexId, 3>
+  ttk::ImplicitTriangulation::getTetrahedronCoords(
+    const SimplexId tetId) const {
+  if(useLookupTables_) {
+    return tetrahedronCoords_[tetId];
+  }
+  std::array<SimplexId, 3> p{};
+  tetrahedronToPosition(tetId, p.data());
+  return p;
+}
+
 inline ttk::SimplexId
   ttk::ImplicitTriangulation::getVertexEdgeA(const SimplexId p[3],
                                              const int id) const {
@@ -7203,3 +7504,122 @@ inline ttk::SimplexId ttk::ImplicitTriangulation::getTetrahedronNeighborBDGH(
   }
   return -1;
 }
+
+namespace ttk {
+
+  /**
+   * @brief Implicit triangulation of a 2D or 3D grid, specialized on the
+   * grid dimension.
+   *
+   * The vertex neighbors, cell vertices and boundary vertices are given by
+   * the compile-time stencils of ttk::ImplicitGridStencil: the vertices
+   * inside the grid skip the classification of their position, and the
+   * dimension tests of ImplicitTriangulation vanish. The other queries are
+   * the ones of ImplicitTriangulation.
+   */
+  template <size_t dim>
+  class ImplicitTriangulationDim final : public ImplicitTriangulation {
+
+    static_assert(dim == 2 || dim == 3, "only 2D and 3D grids");
+
+    using Stencil = ImplicitGridStencil<dim>;
+
+  public:
+    SimplexId TTK_TRIANGULATION_INTERNAL(getCellVertexNumber)(
+      const SimplexId & /*cellId*/) const override {
+      return dim + 1;
+    }
+
+    int TTK_TRIANGULATION_INTERNAL(getCellVertex)(
+      const SimplexId &cellId,
+      const int &localVertexId,
+      SimplexId &vertexId) const override {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+      if(cellId < 0 or cellId >= cellNumber_)
+        return -1;
+      if(localVertexId < 0 or localVertexId > static_cast<int>(dim))
+        return -2;
+#endif // !TTK_ENABLE_KAMIKAZE
+
+      const auto p = dim == 3 ? this->getTetrahedronCoords(cellId)
+                              : this->getTriangleCoords(cellId);
+      const int type = cellId % Stencil::cellsPerVoxel;
+      const int corner = Stencil::cellVertices()[type][localVertexId];
+
+      // first vertex of the voxel, plus the offset of the corner
+      vertexId = (dim == 3 ? p[0] : p[0] / 2) + p[1] * vshift_[0]
+                 + (corner & 1) + ((corner >> 1) & 1) * vshift_[0];
+      if(dim == 3) {
+        vertexId += (p[2] + (corner >> 2)) * vshift_[1];
+      }
+      return 0;
+    }
+
+    int TTK_TRIANGULATION_INTERNAL(getDimensionality)() const override {
+      return dim;
+    }
+
+    SimplexId TTK_TRIANGULATION_INTERNAL(getVertexNeighborNumber)(
+      const SimplexId &vertexId) const override {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+      if(vertexId < 0 or vertexId >= vertexNumber_)
+        return -1;
+#endif // !TTK_ENABLE_KAMIKAZE
+
+      if(this->isVertexInside(vertexId)) {
+        return Stencil::vertexNeighborNumber;
+      }
+      return ImplicitTriangulation::TTK_TRIANGULATION_INTERNAL(
+        getVertexNeighborNumber)(vertexId);
+    }
+
+    int TTK_TRIANGULATION_INTERNAL(getVertexNeighbor)(
+      const SimplexId &vertexId,
+      const int &localNeighborId,
+      SimplexId &neighborId) const override {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+      if(vertexId < 0 or vertexId >= vertexNumber_)
+        return -1;
+#endif // !TTK_ENABLE_KAMIKAZE
+
+      if(this->isVertexInside(vertexId)) {
+#ifndef TTK_ENABLE_KAMIKAZE
+        if(localNeighborId < 0
+           or localNeighborId >= Stencil::vertexNeighborNumber)
+          return -1;
+#endif // !TTK_ENABLE_KAMIKAZE
+        neighborId = vertexId
+                     + (dim == 3 ? vertexNeighborABCDEFGH_[localNeighborId]
+                                 : vertexNeighbor2dABCD_[localNeighborId]);
+        return 0;
+      }
+      return ImplicitTriangulation::TTK_TRIANGULATION_INTERNAL(
+        getVertexNeighbor)(vertexId, localNeighborId, neighborId);
+    }
+
+    bool TTK_TRIANGULATION_INTERNAL(isVertexOnBoundary)(
+      const SimplexId &vertexId) const override {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+      if(vertexId < 0 or vertexId >= vertexNumber_)
+        return false;
+#endif // !TTK_ENABLE_KAMIKAZE
+
+      return !this->isVertexInside(vertexId);
+    }
+
+  protected:
+    inline bool isVertexInside(const SimplexId vertexId) const {
+      return this->getVertexPosition(vertexId)
+             == (dim == 3 ? VertexPosition::CENTER_3D
+                          : VertexPosition::CENTER_2D);
+    }
+  };
+
+  using ImplicitTriangulation2D = ImplicitTriangulationDim<2>;
+  using ImplicitTriangulation3D = ImplicitTriangulationDim<3>;
+
+} // namespace ttk
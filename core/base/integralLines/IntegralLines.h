@@ -9,15 +9,20 @@
 /// Given a list of sources, the package produces forward or backward integral
 /// lines along the edges of the input triangulation.
 ///
+/// The seeds are traced in parallel and the trajectories are returned as a
+/// single FlatJaggedArray (one sub-vector of vertex identifiers per seed).
+///
 /// \sa ttkIntegralLines.cpp %for a usage example.
 
 #pragma once
 
 // base code includes
+#include <FlatJaggedArray.h>
 #include <Geometry.h>
 #include <Triangulation.h>
 
 // std includes
+#include <array>
 #include <limits>
 #include <unordered_set>
 
@@ -51,10 +56,45 @@ namespace ttk {
              / getDistance<triangulationType>(triangulation, a, b);
     }
 
+    /**
+     * @brief Get the next vertex along the integral line (steepest
+     * neighbor in the current direction), -1 if @p v is an extremum
+     */
+    template <typename dataType, class triangulationType>
+    inline SimplexId getNextVertex(const triangulationType *triangulation,
+                                   const SimplexId v,
+                                   dataType *scalars) const {
+      const auto offsets = inputOffsets_;
+      SimplexId vnext{-1};
+      float fnext = std::numeric_limits<float>::min();
+      SimplexId neighborNumber = triangulation->getVertexNeighborNumber(v);
+      for(SimplexId k = 0; k < neighborNumber; ++k) {
+        SimplexId n;
+        triangulation->getVertexNeighbor(v, k, n);
+
+        if((direction_ == static_cast<int>(Direction::Forward))
+           xor (offsets[n] < offsets[v])) {
+          const float f = getGradient<dataType, triangulationType>(
+            triangulation, v, n, scalars);
+          if(f > fnext) {
+            vnext = n;
+            fnext = f;
+          }
+        }
+      }
+      return vnext;
+    }
+
     template <typename dataType,
               class triangulationType = ttk::AbstractTriangulation>
     int execute(const triangulationType *) const;
 
+    /**
+     * @brief Compute the integral lines, stopping a trajectory at the
+     * first vertex for which @p cmp returns true
+     *
+     * @pre @p cmp is called concurrently from several threads
+     */
     template <typename dataType,
               class Compare,
               class triangulationType = ttk::AbstractTriangulation>
@@ -72,9 +112,13 @@ namespace ttk {
       direction_ = direction;
     }
 
-    int preconditionTriangulation(
-      ttk::AbstractTriangulation *triangulation) const {
-      return triangulation->preconditionVertexNeighbors();
+    /**
+     * @brief Precondition the vertex neighbors, within \p memoryBudget
+     * bytes if non-zero (computed by blocks on demand on explicit meshes)
+     */
+    int preconditionTriangulation(ttk::AbstractTriangulation *triangulation,
+                                  const size_t memoryBudget = 0) const {
+      return triangulation->preconditionVertexNeighbors(memoryBudget);
     }
 
     inline void setInputScalarField(void *data) {
@@ -97,11 +141,20 @@ namespace ttk {
       vertexIdentifierScalarField_ = data;
     }
 
-    inline void
-      setOutputTrajectories(std::vector<std::vector<SimplexId>> *trajectories) {
+    inline void setOutputTrajectories(FlatJaggedArray *const trajectories) {
       outputTrajectories_ = trajectories;
     }
 
+    /**
+     * @brief Reuse the already traced steps: the next vertex of every
+     * visited vertex is cached, so trajectories joining a traced path
+     * follow it without evaluating the gradient again (one SimplexId
+     * per domain vertex)
+     */
+    inline void setMergeTrajectories(const bool merge) {
+      mergeTrajectories_ = merge;
+    }
+
   protected:
     SimplexId vertexNumber_;
     SimplexId seedNumber_;
@@ -109,77 +162,23 @@ namespace ttk {
     void *inputScalarField_;
     const SimplexId *inputOffsets_;
     SimplexId *vertexIdentifierScalarField_;
-    std::vector<std::vector<SimplexId>> *outputTrajectories_;
+    FlatJaggedArray *outputTrajectories_;
+    bool mergeTrajectories_{false};
   };
 } // namespace ttk
 
 template <typename dataType, class triangulationType>
 int ttk::IntegralLines::execute(const triangulationType *triangulation) const {
-  const auto offsets = inputOffsets_;
-  SimplexId *identifiers = vertexIdentifierScalarField_;
-  dataType *scalars = static_cast<dataType *>(inputScalarField_);
-  std::vector<std::vector<SimplexId>> *trajectories = outputTrajectories_;
-
-  Timer t;
-
-  // get the seeds
-  std::unordered_set<SimplexId> isSeed;
-  for(SimplexId k = 0; k < seedNumber_; ++k)
-    isSeed.insert(identifiers[k]);
-  std::vector<SimplexId> seeds(isSeed.begin(), isSeed.end());
-  isSeed.clear();
-
-  trajectories->resize(seeds.size());
-  for(SimplexId i = 0; i < (SimplexId)seeds.size(); ++i) {
-    SimplexId v{seeds[i]};
-    (*trajectories)[i].push_back(v);
-
-    bool isMax{};
-    while(!isMax) {
-      SimplexId vnext{-1};
-      float fnext = std::numeric_limits<float>::min();
-      SimplexId neighborNumber = triangulation->getVertexNeighborNumber(v);
-      for(SimplexId k = 0; k < neighborNumber; ++k) {
-        SimplexId n;
-        triangulation->getVertexNeighbor(v, k, n);
-
-        if((direction_ == static_cast<int>(Direction::Forward))
-           xor (offsets[n] < offsets[v])) {
-          const float f = getGradient<dataType, triangulationType>(
-            triangulation, v, n, scalars);
-          if(f > fnext) {
-            vnext = n;
-            fnext = f;
-          }
-        }
-      }
-
-      if(vnext == -1)
-        isMax = true;
-      else {
-        v = vnext;
-        (*trajectories)[i].push_back(v);
-      }
-    }
-  }
-
-  {
-    std::stringstream msg;
-    msg << "Processed " << vertexNumber_ << " points";
-    this->printMsg(msg.str(), 1, t.getElapsedTime(), 1);
-  }
-
-  return 0;
+  return this->execute<dataType>(
+    [](const SimplexId) { return false; }, triangulation);
 }
 
 template <typename dataType, class Compare, class triangulationType>
 int ttk::IntegralLines::execute(Compare cmp,
                                 const triangulationType *triangulation) const {
-  const auto offsets = inputOffsets_;
-  SimplexId *identifiers
-    = static_cast<SimplexId *>(vertexIdentifierScalarField_);
+  SimplexId *identifiers = vertexIdentifierScalarField_;
   dataType *scalars = static_cast<dataType *>(inputScalarField_);
-  std::vector<std::vector<SimplexId>> *trajectories = outputTrajectories_;
+  FlatJaggedArray *trajectories = outputTrajectories_;
 
   Timer t;
 
@@ -190,47 +189,88 @@ int ttk::IntegralLines::execute(Compare cmp,
   std::vector<SimplexId> seeds(isSeed.begin(), isSeed.end());
   isSeed.clear();
 
-  trajectories->resize(seeds.size());
-  for(SimplexId i = 0; i < (SimplexId)seeds.size(); ++i) {
-    SimplexId v{seeds[i]};
-    (*trajectories)[i].push_back(v);
+  const SimplexId seedNumber = seeds.size();
 
-    bool isMax{};
-    while(!isMax) {
-      SimplexId vnext{-1};
-      float fnext = std::numeric_limits<float>::min();
-      SimplexId neighborNumber = triangulation->getVertexNeighborNumber(v);
-      for(SimplexId k = 0; k < neighborNumber; ++k) {
-        SimplexId n;
-        triangulation->getVertexNeighbor(v, k, n);
+  // next vertex of every already visited vertex (-2 if not visited)
+  std::vector<SimplexId> nextVertex{};
+  if(mergeTrajectories_) {
+    nextVertex.resize(vertexNumber_, -2);
+  }
 
-        if((direction_ == static_cast<int>(Direction::Forward))
-           xor (offsets[n] < offsets[v])) {
-          const float f
-            = getGradient<dataType, triangulationType>(v, n, scalars);
-          if(f > fnext) {
-            vnext = n;
-            fnext = f;
-          }
+  // per-thread trajectory arenas
+  std::vector<std::vector<SimplexId>> arenas(std::max(threadNumber_, 1));
+  // for every seed: arena, position in arena, trajectory size
+  std::vector<std::array<SimplexId, 3>> locations(seedNumber);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 16)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < seedNumber; ++i) {
+#ifdef TTK_ENABLE_OPENMP
+    const SimplexId tid = omp_get_thread_num();
+#else
+    const SimplexId tid = 0;
+#endif // TTK_ENABLE_OPENMP
+    auto &arena = arenas[tid];
+    const SimplexId begin = arena.size();
+
+    SimplexId v{seeds[i]};
+    arena.emplace_back(v);
+
+    while(true) {
+      SimplexId vnext{-2};
+      if(mergeTrajectories_) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic read
+#endif // TTK_ENABLE_OPENMP
+        vnext = nextVertex[v];
+      }
+      if(vnext == -2) {
+        vnext = this->getNextVertex<dataType, triangulationType>(
+          triangulation, v, scalars);
+        if(mergeTrajectories_) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic write
+#endif // TTK_ENABLE_OPENMP
+          nextVertex[v] = vnext;
         }
       }
 
-      if(vnext == -1)
-        isMax = true;
-      else {
-        v = vnext;
-        (*trajectories)[i].push_back(v);
-
-        if(cmp(v))
-          isMax = true;
+      if(vnext == -1) {
+        break;
+      }
+      v = vnext;
+      arena.emplace_back(v);
+      if(cmp(v)) {
+        break;
       }
     }
+
+    locations[i] = {tid, begin, static_cast<SimplexId>(arena.size()) - begin};
+  }
+
+  // flatten the arenas into the output
+  std::vector<SimplexId> offsets(seedNumber + 1);
+  for(SimplexId i = 0; i < seedNumber; ++i) {
+    offsets[i + 1] = offsets[i] + locations[i][2];
+  }
+  std::vector<SimplexId> data(offsets.back());
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < seedNumber; ++i) {
+    const auto &loc = locations[i];
+    const auto src = arenas[loc[0]].begin() + loc[1];
+    std::copy(src, src + loc[2], data.begin() + offsets[i]);
   }
 
+  trajectories->setData(std::move(data), std::move(offsets));
+
   {
     std::stringstream msg;
     msg << "Processed " << vertexNumber_ << " points";
-    this->printMsg(msg.str(), 1, t.getElapsedTime(), 1);
+    this->printMsg(msg.str(), 1, t.getElapsedTime(), threadNumber_);
   }
 
   return 0;
@@ -446,17 +446,8 @@ char ttk::JacobiSet::getCriticalType(const SimplexId &edgeId,
   }
 
   // let's check the connectivity now
-  std::vector<UnionFind> lowerSeeds(lowerNeighbors.size());
-  std::vector<UnionFind *> lowerList(lowerNeighbors.size());
-  std::vector<UnionFind> upperSeeds(upperNeighbors.size());
-  std::vector<UnionFind *> upperList(upperNeighbors.size());
-
-  for(SimplexId i = 0; i < (SimplexId)lowerSeeds.size(); i++) {
-    lowerList[i] = &(lowerSeeds[i]);
-  }
-  for(SimplexId i = 0; i < (SimplexId)upperSeeds.size(); i++) {
-    upperList[i] = &(upperSeeds[i]);
-  }
+  SmallUnionFind<> lowerSets(lowerNeighbors.size());
+  SmallUnionFind<> upperSets(upperNeighbors.size());
 
   for(SimplexId i = 0; i < starNumber; i++) {
 
@@ -491,11 +482,11 @@ char ttk::JacobiSet::getCriticalType(const SimplexId &edgeId,
             }
 
             std::vector<SimplexId> *neighbors = &lowerNeighbors;
-            std::vector<UnionFind *> *seeds = &lowerList;
+            SmallUnionFind<> *sets = &lowerSets;
 
             if(!lower0) {
               neighbors = &upperNeighbors;
-              seeds = &upperList;
+              sets = &upperSets;
             }
 
             if(lower0 == lower1) {
@@ -511,9 +502,7 @@ char ttk::JacobiSet::getCriticalType(const SimplexId &edgeId,
               }
 
               if((lowerId0 != -1) && (lowerId1 != -1)) {
-                (*seeds)[lowerId0] = UnionFind::makeUnion(
-                  (*seeds)[lowerId0], (*seeds)[lowerId1]);
-                (*seeds)[lowerId1] = (*seeds)[lowerId0];
+                sets->merge(lowerId0, lowerId1);
               }
             }
 
@@ -524,22 +513,8 @@ char ttk::JacobiSet::getCriticalType(const SimplexId &edgeId,
     }
   }
 
-  // update the UF if necessary
-  for(SimplexId i = 0; i < (SimplexId)lowerList.size(); i++)
-    lowerList[i] = lowerList[i]->find();
-  for(SimplexId i = 0; i < (SimplexId)upperList.size(); i++)
-    upperList[i] = upperList[i]->find();
-
-  std::vector<UnionFind *>::iterator it;
-  sort(lowerList.begin(), lowerList.end());
-  it = unique(lowerList.begin(), lowerList.end());
-  lowerList.resize(distance(lowerList.begin(), it));
-
-  sort(upperList.begin(), upperList.end());
-  it = unique(upperList.begin(), upperList.end());
-  upperList.resize(distance(upperList.begin(), it));
-
-  if((upperList.size() == 1) && (lowerList.size() == 1))
+  if((upperSets.getNumberOfSets() == 1)
+     && (lowerSets.getNumberOfSets() == 1))
     return -2;
 
   return 1;
@@ -5,6 +5,17 @@
 ///
 /// \brief TTK KD-Tree
 ///
+/// The tree is stored in flat arrays indexed by node (structure of
+/// arrays): coordinates, weights, subtree minimal weights, children and
+/// parent. It is built in place on a permutation of the input points.
+///
+/// Nodes are identified by their index. The correspondance map returned
+/// by the build functions gives the node of each input point.
+///
+/// Weight increases are applied lazily: the subtree minimal weights,
+/// used to prune the nearest-neighbor queries, stay valid lower bounds
+/// and are updated in batches (see flushWeights()).
+///
 
 #pragma once
 
@@ -18,16 +29,13 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <memory>
 
 namespace ttk {
   template <typename dataType>
   class KDTree : public Debug {
 
   protected:
-    // Boolean indicating if the current node is a left node of its parent
-    bool is_left_;
-    // Indicates according to which coordinate the tree splits its elements
-    int coords_number_{0};
     // Power used for the computation of distances. p=2 yields euclidean
     // distance
     int p_{2};
@@ -35,34 +43,38 @@ namespace ttk {
     // for the computation of nearest neighbours
     bool include_weights_{false};
 
-  public:
-    using KDTreeRoot = std::unique_ptr<KDTree>;
-    using KDTreeMap = std::vector<KDTree *>;
-
-    KDTreeRoot left_{}; // Lower half for the coordinate specified
-    KDTreeRoot right_{}; // Higher half
-    KDTree *parent_{};
-    // ID of the object saved here. The whole object is not kept in the KDTree
-    // Users should keep track of them in a table for instance
-    int id_{};
-    std::vector<dataType> coordinates_{};
-    std::vector<dataType> coords_min_{};
-    std::vector<dataType> coords_max_{};
-    int level_{};
+    int dimension_{};
+    int weight_number_{};
+    int root_{-1};
+    // Number of pending weight increases triggering a flush
+    size_t weight_batch_size_{32};
 
-    std::vector<dataType> weight_{};
+    // node -> input point id
+    std::vector<int> ids_{};
+    // node -> coordinates (dimension_ per node)
+    std::vector<dataType> coordinates_{};
+    // node -> depth (the split axis is level % dimension_)
+    std::vector<int> levels_{};
+    std::vector<int> parents_{};
+    std::vector<int> left_{};
+    std::vector<int> right_{};
+    // weight index * size() + node -> weight
+    std::vector<dataType> weights_{};
     std::vector<dataType> min_subweights_{};
+    // nodes whose subtree minimal weight is to be updated, per weight index
+    std::vector<std::vector<int>> pending_{};
+    std::vector<char> is_pending_{};
+
+  public:
+    using KDTreeRoot = std::unique_ptr<KDTree>;
+    // input point id -> node
+    using KDTreeMap = std::vector<int>;
 
     KDTree() = default;
     KDTree(bool include_weights, int p)
       : p_{p}, include_weights_{include_weights} {
     }
 
-    KDTree(KDTree *father, int coords_number, bool is_left)
-      : is_left_{is_left}, coords_number_{coords_number},
-        include_weights_{father->include_weights_}, parent_{father} {
-    }
-
     KDTreeMap build(dataType *coordinates,
                     const int &ptNumber,
                     const int &dimension,
@@ -73,64 +85,92 @@ namespace ttk {
                     std::vector<std::vector<dataType>> &weights,
                     const int weight_number = 1);
 
-    void buildRecursive(dataType *coordinates,
-                        std::vector<int> indexes,
-                        const int &ptNumber,
-                        const int &dimension,
-                        KDTree<dataType> *parent,
-                        KDTreeMap &correspondance_map,
-                        std::vector<std::vector<dataType>> &weights,
-                        const int weight_number = 1);
-    void buildRecursive(dataType *coordinates,
-                        std::vector<int> indexes,
-                        const int &ptNumber,
-                        const int &dimension,
-                        KDTree<dataType> *parent,
-                        KDTreeMap &correspondance_map,
-                        const int weight_number = 1);
-
-    void updateWeight(dataType new_weight, const int weight_index = 0);
-    void updateMinSubweight(const int weight_index = 0);
+    void updateWeight(const int node,
+                      const dataType new_weight,
+                      const int weight_index = 0);
+    void flushWeights(const int weight_index = 0);
     void getKClosest(const unsigned int k,
                      const std::vector<dataType> &coordinates,
-                     KDTreeMap &neighbours,
+                     std::vector<int> &neighbours,
                      std::vector<dataType> &costs,
-                     const int weight_index = 0);
-    void recursiveGetKClosest(const unsigned int k,
-                              const std::vector<dataType> &coordinates,
-                              KDTreeMap &neighbours,
-                              std::vector<dataType> &costs,
-                              const int weight_index = 0);
+                     const int weight_index = 0) const;
 
-    dataType cost(const std::vector<dataType> &coordinates);
-    dataType distanceToBox(const KDTree<dataType> &subtree,
-                           const std::vector<dataType> &coordinates);
-    std::vector<dataType> getCoordinates();
-    dataType getWeight(const int weight_index = 0);
-    dataType getMinSubWeight(const int weight_index = 0);
+    dataType cost(const int node,
+                  const std::vector<dataType> &coordinates) const;
 
-    bool isLeaf();
-    bool isRoot();
+    inline void setWeightBatchSize(const size_t size) {
+      weight_batch_size_ = std::max(size, size_t{1});
+    }
+    inline int size() const {
+      return ids_.size();
+    }
+    inline int getId(const int node) const {
+      return ids_[node];
+    }
+    inline const dataType *getCoordinates(const int node) const {
+      return &coordinates_[static_cast<size_t>(dimension_) * node];
+    }
+    inline dataType getWeight(const int node,
+                              const int weight_index = 0) const {
+      return weights_[this->weightIndex(node, weight_index)];
+    }
+    inline dataType getMinSubWeight(const int node,
+                                    const int weight_index = 0) const {
+      return min_subweights_[this->weightIndex(node, weight_index)];
+    }
+    inline bool isLeaf(const int node) const {
+      return left_[node] == -1 && right_[node] == -1;
+    }
+    inline bool isRoot(const int node) const {
+      return parents_[node] == -1;
+    }
 
     template <typename type>
     inline static type abs(const type var) {
       return (var > 0) ? var : -var;
     }
-  };
 
-  template <typename dataType>
-  std::vector<dataType> KDTree<dataType>::getCoordinates() {
-    return coordinates_;
-  }
+  protected:
+    inline size_t weightIndex(const int node, const int weight_index) const {
+      return static_cast<size_t>(weight_index) * ids_.size() + node;
+    }
 
-  template <typename dataType>
-  dataType KDTree<dataType>::getWeight(const int weight_index) {
-    return weight_[weight_index];
-  }
+    void buildStructure(dataType *coordinates,
+                        const int ptNumber,
+                        const int dimension,
+                        const int weight_number,
+                        KDTreeMap &correspondance_map);
+    int buildRecursive(const dataType *coordinates,
+                       int *const points,
+                       const int begin,
+                       const int end,
+                       const int level,
+                       const int parent);
+    dataType initMinSubweights(const int node, const int weight_index);
+    bool updateMinSubweight(const int node, const int weight_index);
+    void recursiveGetKClosest(const int node,
+                              const unsigned int k,
+                              const std::vector<dataType> &coordinates,
+                              std::vector<dataType> &box_min,
+                              std::vector<dataType> &box_max,
+                              std::vector<int> &neighbours,
+                              std::vector<dataType> &costs,
+                              const int weight_index) const;
+    dataType distanceToBox(const std::vector<dataType> &box_min,
+                           const std::vector<dataType> &box_max,
+                           const std::vector<dataType> &coordinates) const;
+  };
 
   template <typename dataType>
-  dataType KDTree<dataType>::getMinSubWeight(const int weight_index) {
-    return min_subweights_[weight_index];
+  typename KDTree<dataType>::KDTreeMap
+    KDTree<dataType>::build(dataType *data,
+                            const int &ptNumber,
+                            const int &dimension,
+                            const int weight_number) {
+    KDTreeMap correspondance_map{};
+    this->buildStructure(
+      data, ptNumber, dimension, weight_number, correspondance_map);
+    return correspondance_map;
   }
 
   template <typename dataType>
@@ -138,288 +178,314 @@ namespace ttk {
     KDTree<dataType>::build(dataType *data,
                             const int &ptNumber,
                             const int &dimension,
+                            std::vector<std::vector<dataType>> &weights,
                             const int weight_number) {
-    KDTreeMap correspondance_map(ptNumber);
-    // First, perform a argsort on the data
-    // initialize original index locations
-    for(int axis = 0; axis < dimension; axis++) {
-      coords_min_.push_back(std::numeric_limits<dataType>::lowest());
-      coords_max_.push_back(std::numeric_limits<dataType>::max());
-    }
-    std::vector<int> idx(ptNumber);
-    for(int i = 0; i < ptNumber; i++) {
-      idx[i] = i;
-    }
-    // sort indexes based on comparing values in coordinates
-    sort(idx.begin(), idx.end(), [&](int i1, int i2) {
-      return data[dimension * i1 + coords_number_]
-             < data[dimension * i2 + coords_number_];
-    });
-    int median_loc = (int)(ptNumber - 1) / 2;
-    int median_idx = idx[median_loc];
-    correspondance_map[median_idx] = this;
-
-    for(int axis = 0; axis < dimension; axis++) {
-      coordinates_.push_back(data[dimension * median_idx + axis]);
-    }
+    KDTreeMap correspondance_map{};
+    this->buildStructure(
+      data, ptNumber, dimension, weight_number, correspondance_map);
+
     for(int w = 0; w < weight_number; w++) {
-      weight_.push_back(0);
-      min_subweights_.push_back(0);
-    }
-    id_ = median_idx;
-    parent_ = nullptr;
-    level_ = 0;
-
-    if(idx.size() > 2) {
-      // Build left leaf
-      std::vector<int> idx_left(median_loc);
-      for(int i = 0; i < median_loc; i++) {
-        idx_left[i] = idx[i];
+      for(int node = 0; node < ptNumber; node++) {
+        weights_[this->weightIndex(node, w)] = weights[w][ids_[node]];
       }
-
-      this->left_ = std::unique_ptr<KDTree>(
-        new KDTree(this, (coords_number_ + 1) % dimension, true));
-      this->left_->buildRecursive(data, idx_left, ptNumber, dimension, this,
-                                  correspondance_map, weight_number);
-    }
-
-    if(idx.size() > 1) {
-      // Build right leaf
-      std::vector<int> idx_right(ptNumber - median_loc - 1);
-      for(int i = 0; i < ptNumber - median_loc - 1; i++) {
-        idx_right[i] = idx[i + median_loc + 1];
+      if(root_ != -1) {
+        this->initMinSubweights(root_, w);
       }
-      this->right_ = std::unique_ptr<KDTree>(
-        new KDTree(this, (coords_number_ + 1) % dimension, false));
-      this->right_->buildRecursive(data, idx_right, ptNumber, dimension, this,
-                                   correspondance_map, weight_number);
     }
 
     return correspondance_map;
   }
 
   template <typename dataType>
-  void KDTree<dataType>::buildRecursive(dataType *data,
-                                        std::vector<int> idx_side,
-                                        const int &ptNumber,
-                                        const int &dimension,
-                                        KDTree<dataType> *parent,
-                                        KDTreeMap &correspondance_map,
-                                        const int weight_number) {
-
-    // First, perform a argsort on the data
-    sort(idx_side.begin(), idx_side.end(), [&](int i1, int i2) {
-      return data[dimension * i1 + coords_number_]
-             < data[dimension * i2 + coords_number_];
-    });
-    int median_loc = (int)(idx_side.size() - 1) / 2;
-    int median_idx = idx_side[median_loc];
-    correspondance_map[median_idx] = this;
-
-    for(int axis = 0; axis < dimension; axis++) {
-      coordinates_.push_back(data[dimension * median_idx + axis]);
+  void KDTree<dataType>::buildStructure(dataType *data,
+                                        const int ptNumber,
+                                        const int dimension,
+                                        const int weight_number,
+                                        KDTreeMap &correspondance_map) {
+    const size_t n = std::max(ptNumber, 0);
+    dimension_ = dimension;
+    weight_number_ = weight_number;
+    ids_.resize(n);
+    levels_.resize(n);
+    parents_.resize(n);
+    left_.resize(n);
+    right_.resize(n);
+
+    // the permutation of the input points is sorted in place, the median
+    // of every range being the node of the range
+    for(size_t i = 0; i < n; i++) {
+      ids_[i] = i;
     }
-    for(int w = 0; w < weight_number; w++) {
-      weight_.push_back(0);
-      min_subweights_.push_back(0);
-    }
-    id_ = median_idx;
-    parent_ = parent;
-    level_ = parent->level_ + 1;
-
-    // Create bounding box
-    for(int axis = 0; axis < dimension; axis++) {
-      coords_min_.push_back(parent_->coords_min_[axis]);
-      coords_max_.push_back(parent_->coords_max_[axis]);
+    root_ = this->buildRecursive(data, ids_.data(), 0, n, 0, -1);
+
+    correspondance_map.resize(n);
+    coordinates_.resize(n * dimension);
+    for(size_t node = 0; node < n; node++) {
+      correspondance_map[ids_[node]] = node;
+      for(int axis = 0; axis < dimension; axis++) {
+        coordinates_[node * dimension + axis]
+          = data[static_cast<size_t>(dimension) * ids_[node] + axis];
+      }
     }
-    if(is_left_ && !this->isRoot()) {
-      coords_max_[parent_->coords_number_]
-        = parent_->coordinates_[parent_->coords_number_];
-    } else if(!is_left_ && !this->isRoot()) {
-      coords_min_[parent_->coords_number_]
-        = parent_->coordinates_[parent_->coords_number_];
+
+    weights_.assign(n * weight_number, 0);
+    min_subweights_.assign(n * weight_number, 0);
+    pending_.assign(weight_number, {});
+    is_pending_.assign(n * weight_number, 0);
+  }
+
+  template <typename dataType>
+  int KDTree<dataType>::buildRecursive(const dataType *data,
+                                       int *const points,
+                                       const int begin,
+                                       const int end,
+                                       const int level,
+                                       const int parent) {
+    if(begin >= end) {
+      return -1;
     }
 
-    if(idx_side.size() > 2) {
-      // Build left leaf
-      std::vector<int> idx_left(median_loc);
-      for(int i = 0; i < median_loc; i++) {
-        idx_left[i] = idx_side[i];
-      }
+    // median along the split axis
+    const int axis = level % dimension_;
+    const int median = begin + (end - begin - 1) / 2;
+    std::nth_element(
+      points + begin, points + median, points + end, [&](int i1, int i2) {
+        return data[dimension_ * i1 + axis] < data[dimension_ * i2 + axis];
+      });
+
+    levels_[median] = level;
+    parents_[median] = parent;
+    left_[median]
+      = this->buildRecursive(data, points, begin, median, level + 1, median);
+    right_[median]
+      = this->buildRecursive(data, points, median + 1, end, level + 1, median);
+
+    return median;
+  }
 
-      this->left_ = std::unique_ptr<KDTree>(
-        new KDTree(this, (coords_number_ + 1) % dimension, true));
-      this->left_->buildRecursive(data, idx_left, ptNumber, dimension, this,
-                                  correspondance_map, weight_number);
+  template <typename dataType>
+  dataType KDTree<dataType>::initMinSubweights(const int node,
+                                               const int weight_index) {
+    dataType res = weights_[this->weightIndex(node, weight_index)];
+    if(left_[node] != -1) {
+      res = std::min(res, this->initMinSubweights(left_[node], weight_index));
+    }
+    if(right_[node] != -1) {
+      res = std::min(res, this->initMinSubweights(right_[node], weight_index));
     }
+    min_subweights_[this->weightIndex(node, weight_index)] = res;
+    return res;
+  }
 
-    if(idx_side.size() > 1) {
-      // Build right leaf
-      std::vector<int> idx_right(idx_side.size() - median_loc - 1);
-      for(unsigned int i = 0; i < idx_side.size() - median_loc - 1; i++) {
-        idx_right[i] = idx_side[i + median_loc + 1];
+  template <typename dataType>
+  void KDTree<dataType>::updateWeight(const int node,
+                                      const dataType new_weight,
+                                      const int weight_index) {
+    auto &weight = weights_[this->weightIndex(node, weight_index)];
+    const bool increase = new_weight >= weight;
+    weight = new_weight;
+
+    if(increase) {
+      // the subtree minimal weights of the ancestors are still lower
+      // bounds: defer their update
+      auto &is_pending = is_pending_[this->weightIndex(node, weight_index)];
+      if(!is_pending) {
+        is_pending = 1;
+        pending_[weight_index].emplace_back(node);
       }
-      this->right_ = std::unique_ptr<KDTree>(
-        new KDTree(this, (coords_number_ + 1) % dimension, false));
-      this->right_->buildRecursive(data, idx_right, ptNumber, dimension, this,
-                                   correspondance_map, weight_number);
+      if(pending_[weight_index].size() >= weight_batch_size_) {
+        this->flushWeights(weight_index);
+      }
+      return;
+    }
+
+    int current = node;
+    while(current != -1 && this->updateMinSubweight(current, weight_index)) {
+      current = parents_[current];
     }
-    return;
   }
 
   template <typename dataType>
-  void KDTree<dataType>::updateWeight(dataType new_weight,
-                                      const int weight_index) {
-    weight_[weight_index] = new_weight;
-    updateMinSubweight(weight_index);
+  void KDTree<dataType>::flushWeights(const int weight_index) {
+    auto &pending = pending_[weight_index];
+
+    // deepest nodes first: the children are updated before their parent,
+    // shared ancestors are updated once
+    const auto deeper
+      = [this](const int a, const int b) { return levels_[a] < levels_[b]; };
+    std::make_heap(pending.begin(), pending.end(), deeper);
+
+    while(!pending.empty()) {
+      std::pop_heap(pending.begin(), pending.end(), deeper);
+      const int node = pending.back();
+      pending.pop_back();
+      is_pending_[this->weightIndex(node, weight_index)] = 0;
+
+      const int parent = parents_[node];
+      if(this->updateMinSubweight(node, weight_index) && parent != -1) {
+        auto &is_pending = is_pending_[this->weightIndex(parent, weight_index)];
+        if(!is_pending) {
+          is_pending = 1;
+          pending.emplace_back(parent);
+          std::push_heap(pending.begin(), pending.end(), deeper);
+        }
+      }
+    }
   }
 
   template <typename dataType>
-  void KDTree<dataType>::updateMinSubweight(const int weight_index) {
-    dataType new_min_subweight;
-    if(this->isLeaf()) {
-      new_min_subweight = weight_[weight_index];
-    } else if(!left_) {
+  bool KDTree<dataType>::updateMinSubweight(const int node,
+                                            const int weight_index) {
+    dataType new_min_subweight
+      = weights_[this->weightIndex(node, weight_index)];
+    if(left_[node] != -1) {
       new_min_subweight = std::min(
-        right_->min_subweights_[weight_index], weight_[weight_index]);
-    } else if(!right_) {
-      new_min_subweight
-        = std::min(left_->min_subweights_[weight_index], weight_[weight_index]);
-    } else {
-      new_min_subweight
-        = std::min(std::min(left_->min_subweights_[weight_index],
-                            right_->min_subweights_[weight_index]),
-                   weight_[weight_index]);
+        new_min_subweight,
+        min_subweights_[this->weightIndex(left_[node], weight_index)]);
+    }
+    if(right_[node] != -1) {
+      new_min_subweight = std::min(
+        new_min_subweight,
+        min_subweights_[this->weightIndex(right_[node], weight_index)]);
     }
 
-    if(new_min_subweight != min_subweights_[weight_index]) {
-      min_subweights_[weight_index] = new_min_subweight;
-      if(!this->isRoot()) {
-        parent_->updateMinSubweight(weight_index);
-      }
+    auto &min_subweight
+      = min_subweights_[this->weightIndex(node, weight_index)];
+    if(new_min_subweight != min_subweight) {
+      min_subweight = new_min_subweight;
+      return true;
     }
+    return false;
   }
 
   template <typename dataType>
   void KDTree<dataType>::getKClosest(const unsigned int k,
                                      const std::vector<dataType> &coordinates,
-                                     KDTreeMap &neighbours,
+                                     std::vector<int> &neighbours,
                                      std::vector<dataType> &costs,
-                                     const int weight_index) {
+                                     const int weight_index) const {
     /// Puts the k closest points to the given coordinates in the "neighbours"
     /// vector along with their costs in the "costs" vector The output is not
     /// sorted, if you are interested in the k nearest neighbours in the order,
     /// will need to sort them according to their cost.
-    if(this->isLeaf()) {
-      dataType cost = this->cost(coordinates);
-      cost += weight_[weight_index];
-      neighbours.push_back(this);
-      costs.push_back(cost);
-    } else {
-      this->recursiveGetKClosest(
-        k, coordinates, neighbours, costs, weight_index);
+    if(root_ == -1) {
+      return;
     }
-    // TODO sort neighbours and costs !
-    return;
+    // bounding box of the current subtree
+    std::vector<dataType> box_min(
+      dimension_, std::numeric_limits<dataType>::lowest());
+    std::vector<dataType> box_max(
+      dimension_, std::numeric_limits<dataType>::max());
+    this->recursiveGetKClosest(root_, k, coordinates, box_min, box_max,
+                               neighbours, costs, weight_index);
   }
 
   template <typename dataType>
   void KDTree<dataType>::recursiveGetKClosest(
+    const int node,
     const unsigned int k,
     const std::vector<dataType> &coordinates,
-    KDTreeMap &neighbours,
+    std::vector<dataType> &box_min,
+    std::vector<dataType> &box_max,
+    std::vector<int> &neighbours,
     std::vector<dataType> &costs,
-    const int weight_index) {
+    const int weight_index) const {
     // 1- Look wether or not to include the current point in the nearest
     // neighbours
-    dataType cost = this->cost(coordinates);
-    cost += weight_[weight_index];
+    const dataType cost = this->cost(node, coordinates)
+                          + weights_[this->weightIndex(node, weight_index)];
 
     if(costs.size() < k) {
-      neighbours.push_back(this);
+      neighbours.push_back(node);
       costs.push_back(cost);
     } else {
       // 1.1- Find the most costly amongst neighbours
-      std::vector<int> idx(k);
-      for(unsigned int i = 0; i < k; i++) {
-        idx[i] = i;
-      }
-      int idx_max_cost = *std::max_element(
-        idx.begin(), idx.end(),
-        [&costs](int &a, int &b) { return costs[a] < costs[b]; });
-      dataType max_cost = costs[idx_max_cost];
-
-      // 1.2- If the current KDTree is less costly, put it in the neighbours and
+      const auto max_cost = std::max_element(costs.begin(), costs.end());
+      // 1.2- If the current node is less costly, put it in the neighbours and
       // update costs.
-      if(cost < max_cost) {
-        costs[idx_max_cost] = cost;
-        neighbours[idx_max_cost] = this;
+      if(cost < *max_cost) {
+        neighbours[max_cost - costs.begin()] = node;
+        *max_cost = cost;
       }
     }
 
-    // 2- Recursively visit KDTrees that are worth it
-    if(left_) {
-      dataType max_cost = *std::max_element(costs.begin(), costs.end());
-      dataType &min_subweight = left_->min_subweights_[weight_index];
-      dataType d_min = this->distanceToBox(*left_, coordinates);
-      if(costs.size() < k || d_min + min_subweight < max_cost) {
-        // 2.2- It is possible that there exists a point in this subtree that is
-        // less costly than max_cost
-        left_->recursiveGetKClosest(
-          k, coordinates, neighbours, costs, weight_index);
+    // 2- Recursively visit the subtrees that are worth it, the most
+    // promising one first (the box of a child is the box of the node split
+    // at the node coordinate)
+    const int axis = levels_[node] % dimension_;
+    const dataType split = this->getCoordinates(node)[axis];
+    const int left = left_[node];
+    const int right = right_[node];
+
+    // lower bound of the costs in a subtree
+    const auto lowerBound = [&](const int child, dataType &bound) {
+      dataType &side = child == left ? box_max[axis] : box_min[axis];
+      const dataType prev = side;
+      side = split;
+      const dataType d_min = this->distanceToBox(box_min, box_max, coordinates);
+      side = prev;
+      bound = d_min + min_subweights_[this->weightIndex(child, weight_index)];
+    };
+    const auto visit = [&](const int child, const dataType bound) {
+      if(costs.size() >= k
+         && !(bound < *std::max_element(costs.begin(), costs.end()))) {
+        return;
       }
+      dataType &side = child == left ? box_max[axis] : box_min[axis];
+      const dataType prev = side;
+      side = split;
+      this->recursiveGetKClosest(child, k, coordinates, box_min, box_max,
+                                 neighbours, costs, weight_index);
+      side = prev;
+    };
+
+    dataType left_bound{}, right_bound{};
+    if(left != -1) {
+      lowerBound(left, left_bound);
     }
-
-    if(right_) {
-      dataType max_cost = *std::max_element(costs.begin(), costs.end());
-      dataType &min_subweight = right_->min_subweights_[weight_index];
-      dataType d_min = this->distanceToBox(*right_, coordinates);
-      if(costs.size() < k || d_min + min_subweight < max_cost) {
-        // 2.2- It is possible that there exists a point in this subtree that is
-        // less costly than max_cost
-        right_->recursiveGetKClosest(
-          k, coordinates, neighbours, costs, weight_index);
+    if(right != -1) {
+      lowerBound(right, right_bound);
+    }
+    if(left != -1 && right != -1 && right_bound < left_bound) {
+      visit(right, right_bound);
+      visit(left, left_bound);
+    } else {
+      if(left != -1) {
+        visit(left, left_bound);
+      }
+      if(right != -1) {
+        visit(right, right_bound);
       }
     }
-    return;
   }
 
   template <typename dataType>
-  dataType KDTree<dataType>::cost(const std::vector<dataType> &coordinates) {
+  dataType
+    KDTree<dataType>::cost(const int node,
+                           const std::vector<dataType> &coordinates) const {
+    const dataType *const point = this->getCoordinates(node);
     dataType cost = 0;
     for(size_t i = 0; i < coordinates.size(); i++) {
-      cost += Geometry::pow(abs(coordinates[i] - coordinates_[i]), p_);
+      cost += Geometry::pow(abs(coordinates[i] - point[i]), p_);
     }
     return cost;
   }
 
   template <typename dataType>
-  dataType
-    KDTree<dataType>::distanceToBox(const KDTree<dataType> &subtree,
-                                    const std::vector<dataType> &coordinates) {
+  dataType KDTree<dataType>::distanceToBox(
+    const std::vector<dataType> &box_min,
+    const std::vector<dataType> &box_max,
+    const std::vector<dataType> &coordinates) const {
     dataType d_min = 0;
     for(size_t axis = 0; axis < coordinates.size(); axis++) {
-      if(subtree.coords_min_[axis] > coordinates[axis]) {
-        d_min
-          += Geometry::pow(subtree.coords_min_[axis] - coordinates[axis], p_);
-      } else if(subtree.coords_max_[axis] < coordinates[axis]) {
-        d_min
-          += Geometry::pow(coordinates[axis] - subtree.coords_max_[axis], p_);
+      if(box_min[axis] > coordinates[axis]) {
+        d_min += Geometry::pow(box_min[axis] - coordinates[axis], p_);
+      } else if(box_max[axis] < coordinates[axis]) {
+        d_min += Geometry::pow(coordinates[axis] - box_max[axis], p_);
       }
     }
     return d_min;
   }
-
-  template <typename dataType>
-  bool KDTree<dataType>::isLeaf() {
-    return left_ == nullptr && right_ == nullptr;
-  }
-
-  template <typename dataType>
-  bool KDTree<dataType>::isRoot() {
-    return parent_ == nullptr;
-  }
 } // namespace ttk
-#include <buildWeights.h>
 
 #endif
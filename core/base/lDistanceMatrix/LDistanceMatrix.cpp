@@ -1,5 +1,29 @@
 #include <LDistanceMatrix.h>
 
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+
 ttk::LDistanceMatrix::LDistanceMatrix() {
   this->setDebugMsgPrefix("LDistanceMatrix");
 }
+
+int ttk::LDistanceMatrix::getDistanceExponent(int &n) const {
+  n = 0;
+  if(this->DistanceType == "inf") {
+    return 0;
+  }
+
+  const char *const str = this->DistanceType.c_str();
+  char *end{};
+  errno = 0;
+  const long val = std::strtol(str, &end, 10);
+  if(end == str || *end != '\0' || errno == ERANGE || val < 1
+     || val > std::numeric_limits<int>::max()) {
+    this->printErr("Invalid distance type " + this->DistanceType);
+    return -1;
+  }
+
+  n = static_cast<int>(val);
+  return 0;
+}
@@ -2,12 +2,24 @@
 /// \class ttk::LDistanceMatrix
 /// \author Pierre Guillou <pierre.guillou@lip6.fr>
 /// \date May 2020
+///
+/// \brief Computes the matrix of the Lp distances between several
+/// scalar fields defined on the same number of points.
+///
+/// The matrix is computed by tiles: the point ranges of a tile of input
+/// fields are kept in cache while all the pairs of the tile are processed,
+/// tile pairs being distributed over threads. The result is written
+/// contiguously (row-major, symmetric).
+///
+/// \sa LDistance
 
 #pragma once
 
+#include <Geometry.h>
 #include <LDistance.h>
 #include <Wrapper.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -20,55 +32,222 @@ namespace ttk {
       DistanceType = val;
     }
 
+    /**
+     * @brief Compute the distance matrix
+     *
+     * @param[out] distMatrix (symmetric) matrix of size inputs.size() *
+     * inputs.size(), contiguous, allocated by the caller
+     * @param[in] inputs scalar fields, of size nPoints each
+     * @return 0 in case of success
+     */
+    template <typename T>
+    int execute(double *const distMatrix,
+                const std::vector<void *> &inputs,
+                const size_t nPoints) const;
+
     template <typename T>
     std::vector<std::vector<double>> execute(const std::vector<void *> &inputs,
                                              const size_t nPoints) const;
 
   protected:
+    /**
+     * @brief Parse DistanceType
+     *
+     * @param[out] n distance exponent, 0 for Linf
+     * @return 0 in case of success
+     */
+    int getDistanceExponent(int &n) const;
+
+    /**
+     * @brief Partial distance (before the final root) between two
+     * point ranges
+     *
+     * @param[in] n distance exponent (0 for Linf)
+     */
+    template <typename T>
+    static inline double partialDistance(const T *const a,
+                                         const T *const b,
+                                         const size_t size,
+                                         const int n);
+
     std::string DistanceType{};
+
+    // number of inputs per tile
+    size_t TileSize{16};
+    // number of points per chunk
+    size_t ChunkSize{4096};
   };
 } // namespace ttk
 
 template <typename T>
-std::vector<std::vector<double>>
-  ttk::LDistanceMatrix::execute(const std::vector<void *> &inputs,
-                                const size_t nPoints) const {
+inline double ttk::LDistanceMatrix::partialDistance(const T *const a,
+                                                    const T *const b,
+                                                    const size_t size,
+                                                    const int n) {
+  double res{};
 
-  const auto nInputs = inputs.size();
-  std::vector<std::vector<double>> distMatrix(nInputs);
+  // specialized loops for the common distances, vectorized by the
+  // compiler
+  if(n == 0) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(max : res)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t k = 0; k < size; ++k) {
+      const double diff = LDistance::abs_diff<T>(a[k], b[k]);
+      res = std::max(res, diff);
+    }
+  } else if(n == 1) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(+ : res)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t k = 0; k < size; ++k) {
+      res += LDistance::abs_diff<T>(a[k], b[k]);
+    }
+  } else if(n == 2) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(+ : res)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t k = 0; k < size; ++k) {
+      const double diff = static_cast<double>(a[k]) - b[k];
+      res += diff * diff;
+    }
+  } else {
+    for(size_t k = 0; k < size; ++k) {
+      const double diff = LDistance::abs_diff<T>(a[k], b[k]);
+      res += Geometry::pow(diff, n);
+    }
+  }
 
-  LDistance worker{};
-  worker.setThreadNumber(this->threadNumber_);
+  return res;
+}
 
-  // compute matrix upper triangle
-  // (some parallelism inside the LDistance computation)
-  for(size_t i = 0; i < nInputs; ++i) {
-    auto &distCol = distMatrix[i];
-    distCol.resize(nInputs);
-    // get pointer to scalar field of input i
-    const auto inputDataPtr1{static_cast<T *>(inputs[i])};
-    for(size_t j = i + 1; j < nInputs; ++j) {
-      // get pointer to scalar field of input jc
-      const auto inputDataPtr2{static_cast<T *>(inputs[j])};
-      // empty output
-      T *outputPtr{};
-      // call execute
-      worker.execute(
-        inputDataPtr1, inputDataPtr2, outputPtr, this->DistanceType, nPoints);
-      // store result
-      distMatrix[i][j] = worker.getResult();
+template <typename T>
+int ttk::LDistanceMatrix::execute(double *const distMatrix,
+                                  const std::vector<void *> &inputs,
+                                  const size_t nPoints) const {
+
+  Timer tm{};
+
+  const size_t nInputs = inputs.size();
+
+  // distance exponent, 0 for Linf
+  int n{};
+  if(this->getDistanceExponent(n) != 0) {
+    return -1;
+  }
+
+  if(nInputs == 0) {
+    return 0;
+  }
+
+  // tiles of inputs: every pair of tiles is a task
+  const size_t tileSize = std::max(this->TileSize, size_t{1});
+  const size_t chunkSize = std::max(this->ChunkSize, size_t{1});
+  const size_t nTiles = (nInputs + tileSize - 1) / tileSize;
+  const size_t nChunks = std::max((nPoints + chunkSize - 1) / chunkSize,
+                                  size_t{1});
+  std::vector<std::pair<size_t, size_t>> tilePairs{};
+  tilePairs.reserve(nTiles * (nTiles + 1) / 2);
+  for(size_t i = 0; i < nTiles; ++i) {
+    for(size_t j = i; j < nTiles; ++j) {
+      tilePairs.emplace_back(i, j);
+    }
+  }
+
+  // few tiles (small ensembles): also split the point range to keep
+  // the threads busy
+  const size_t nParts = std::min(
+    nChunks,
+    std::max((4 * static_cast<size_t>(this->threadNumber_) + tilePairs.size()
+              - 1)
+               / tilePairs.size(),
+             size_t{1}));
+  const size_t nMat = nInputs * nInputs;
+  // partial results of the extra parts (the first one goes in distMatrix)
+  std::vector<double> partials((nParts - 1) * nMat);
+
+  const size_t nTasks = tilePairs.size() * nParts;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t t = 0; t < nTasks; ++t) {
+    const auto &tp = tilePairs[t / nParts];
+    const size_t part = t % nParts;
+    const auto res = [&](const size_t i, const size_t j) -> double & {
+      return part == 0 ? distMatrix[i * nInputs + j]
+                       : partials[(part - 1) * nMat + i * nInputs + j];
+    };
+
+    const size_t iBeg = tp.first * tileSize;
+    const size_t iEnd = std::min(iBeg + tileSize, nInputs);
+    const size_t jBeg = tp.second * tileSize;
+    const size_t jEnd = std::min(jBeg + tileSize, nInputs);
+    const size_t cBeg = part * nChunks / nParts;
+    const size_t cEnd = (part + 1) * nChunks / nParts;
+
+    for(size_t i = iBeg; i < iEnd; ++i) {
+      for(size_t j = std::max(jBeg, i + 1); j < jEnd; ++j) {
+        res(i, j) = 0.0;
+      }
+    }
+
+    // the chunks of the tile inputs stay in cache for all the pairs
+    for(size_t c = cBeg; c < cEnd; ++c) {
+      const size_t pBeg = c * chunkSize;
+      const size_t size = std::min(pBeg + chunkSize, nPoints) - pBeg;
+      for(size_t i = iBeg; i < iEnd; ++i) {
+        const auto a = static_cast<const T *>(inputs[i]) + pBeg;
+        for(size_t j = std::max(jBeg, i + 1); j < jEnd; ++j) {
+          const auto b = static_cast<const T *>(inputs[j]) + pBeg;
+          const double d = partialDistance(a, b, size, n);
+          auto &r = res(i, j);
+          r = n == 0 ? std::max(r, d) : r + d;
+        }
+      }
     }
   }
 
-  // distance matrix is symmetric
+  // merge the parts, take the root and fill the lower triangle
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_)
 #endif // TTK_ENABLE_OPENMP
   for(size_t i = 0; i < nInputs; ++i) {
+    distMatrix[i * nInputs + i] = 0.0;
     for(size_t j = i + 1; j < nInputs; ++j) {
-      distMatrix[j][i] = distMatrix[i][j];
+      auto &r = distMatrix[i * nInputs + j];
+      for(size_t p = 1; p < nParts; ++p) {
+        const auto d = partials[(p - 1) * nMat + i * nInputs + j];
+        r = n == 0 ? std::max(r, d) : r + d;
+      }
+      if(n > 1) {
+        r = Geometry::pow(r, 1.0 / static_cast<double>(n));
+      }
+      distMatrix[j * nInputs + i] = r;
     }
   }
 
+  this->printMsg("Computed " + std::to_string(nInputs * (nInputs - 1) / 2)
+                   + " distances",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
+
+template <typename T>
+std::vector<std::vector<double>>
+  ttk::LDistanceMatrix::execute(const std::vector<void *> &inputs,
+                                const size_t nPoints) const {
+
+  const auto nInputs = inputs.size();
+  std::vector<double> values(nInputs * nInputs);
+  this->execute<T>(values.data(), inputs, nPoints);
+
+  std::vector<std::vector<double>> distMatrix(nInputs);
+  for(size_t i = 0; i < nInputs; ++i) {
+    distMatrix[i].assign(values.begin() + i * nInputs,
+                         values.begin() + (i + 1) * nInputs);
+  }
+
   return distMatrix;
 }
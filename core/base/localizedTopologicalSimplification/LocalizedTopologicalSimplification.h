@@ -61,9 +61,11 @@ namespace ttk {
       };
       ~LocalizedTopologicalSimplification(){};
 
-      int preconditionTriangulation(
-        ttk::AbstractTriangulation *triangulation) const {
-        return triangulation->preconditionVertexNeighbors();
+      /// Precondition the vertex neighbors, within \p memoryBudget bytes
+      /// if non-zero (computed by blocks on demand on explicit meshes)
+      int preconditionTriangulation(ttk::AbstractTriangulation *triangulation,
+                                    const size_t memoryBudget = 0) const {
+        return triangulation->preconditionVertexNeighbors(memoryBudget);
       };
 
       /// This method allocates all temporary memory required for LTS
@@ -245,12 +245,7 @@ int ttk::ManifoldCheck::vertexManifoldCheck(
     }
   }
 
-  std::vector<UnionFind> seeds(linkNeighbors.size());
-  std::vector<UnionFind *> seedList(linkNeighbors.size());
-
-  for(SimplexId i = 0; i < (SimplexId)seeds.size(); i++) {
-    seedList[i] = &(seeds[i]);
-  }
+  SmallUnionFind<> linkSets(linkNeighbors.size());
 
   for(SimplexId i = 0; i < linkSize; i++) {
 
@@ -278,8 +273,7 @@ int ttk::ManifoldCheck::vertexManifoldCheck(
         }
       }
 
-      seedList[uf0] = UnionFind::makeUnion(seedList[uf0], seedList[uf1]);
-      seedList[uf1] = seedList[uf0];
+      linkSets.merge(uf0, uf1);
     }
 
     if(triangulation->getDimensionality() == 3) {
@@ -307,26 +301,12 @@ int ttk::ManifoldCheck::vertexManifoldCheck(
         }
       }
 
-      seedList[uf0] = UnionFind::makeUnion(seedList[uf0], seedList[uf1]);
-      seedList[uf0] = UnionFind::makeUnion(seedList[uf0], seedList[uf2]);
-      seedList[uf1] = seedList[uf0];
-      seedList[uf2] = seedList[uf0];
+      linkSets.merge(uf0, uf1);
+      linkSets.merge(uf0, uf2);
     }
   }
 
-  // let's remove duplicates now
-
-  // update the UF if necessary
-  for(SimplexId i = 0; i < (SimplexId)seedList.size(); i++) {
-    seedList[i] = seedList[i]->find();
-  }
-
-  std::vector<UnionFind *>::iterator it;
-  sort(seedList.begin(), seedList.end());
-  it = unique(seedList.begin(), seedList.end());
-  seedList.resize(distance(seedList.begin(), it));
-
-  return (SimplexId)seedList.size();
+  return linkSets.getNumberOfSets();
 }
 
 template <class triangulationType>
@@ -370,12 +350,7 @@ int ttk::ManifoldCheck::edgeManifoldCheck(
       linkNeighbors.push_back(neighborId);
   }
 
-  std::vector<UnionFind> seeds(linkNeighbors.size());
-  std::vector<UnionFind *> seedList(linkNeighbors.size());
-
-  for(SimplexId i = 0; i < (SimplexId)seeds.size(); i++) {
-    seedList[i] = &(seeds[i]);
-  }
+  SmallUnionFind<> linkSets(linkNeighbors.size());
 
   for(SimplexId i = 0; i < linkSize; i++) {
 
@@ -402,21 +377,8 @@ int ttk::ManifoldCheck::edgeManifoldCheck(
       }
     }
 
-    seedList[uf0] = UnionFind::makeUnion(seedList[uf0], seedList[uf1]);
-    seedList[uf1] = seedList[uf0];
-  }
-
-  // let's remove duplicates now
-
-  // update the UF if necessary
-  for(SimplexId i = 0; i < (SimplexId)seedList.size(); i++) {
-    seedList[i] = seedList[i]->find();
+    linkSets.merge(uf0, uf1);
   }
 
-  std::vector<UnionFind *>::iterator it;
-  sort(seedList.begin(), seedList.end());
-  it = unique(seedList.begin(), seedList.end());
-  seedList.resize(distance(seedList.begin(), it));
-
-  return (SimplexId)seedList.size();
+  return linkSets.getNumberOfSets();
 }
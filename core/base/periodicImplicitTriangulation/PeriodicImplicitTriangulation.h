@@ -8,6 +8,7 @@
 ///
 /// \sa ttk::Triangulation
 /// \sa ttk::Triangulation::setPeriodicBoundaryConditions
+/// \sa ttk::PeriodicImplicitTriangulationDim
 ///
 
 #ifndef _PERIODICIMPLICITTRIANGULATION_H
@@ -15,12 +16,13 @@
 
 // base code includes
 #include <AbstractTriangulation.h>
+#include <ImplicitGridStencil.h>
 
 #include <array>
 
 namespace ttk {
 
-  class PeriodicImplicitTriangulation final : public AbstractTriangulation {
+  class PeriodicImplicitTriangulation : public AbstractTriangulation {
 
   public:
     PeriodicImplicitTriangulation();
@@ -28,36 +30,36 @@ namespace ttk {
 
     int getCellEdgeInternal(const SimplexId &cellId,
                             const int &id,
-                            SimplexId &edgeId) const override;
+                            SimplexId &edgeId) const final;
 
-    SimplexId getCellEdgeNumberInternal(const SimplexId &cellId) const override;
+    SimplexId getCellEdgeNumberInternal(const SimplexId &cellId) const final;
 
-    const std::vector<std::vector<SimplexId>> *getCellEdgesInternal() override;
+    const std::vector<std::vector<SimplexId>> *getCellEdgesInternal() final;
 
     int TTK_TRIANGULATION_INTERNAL(getCellNeighbor)(
       const SimplexId &cellId,
       const int &localNeighborId,
-      SimplexId &neighborId) const override;
+      SimplexId &neighborId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getCellNeighborNumber)(
-      const SimplexId &cellId) const override;
+      const SimplexId &cellId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getCellNeighbors)() override;
+      TTK_TRIANGULATION_INTERNAL(getCellNeighbors)() final;
 
     int getCellTriangleInternal(const SimplexId &cellId,
                                 const int &id,
-                                SimplexId &triangleId) const override;
+                                SimplexId &triangleId) const final;
 
     SimplexId
-      getCellTriangleNumberInternal(const SimplexId &cellId) const override {
+      getCellTriangleNumberInternal(const SimplexId &cellId) const final {
       // NOTE: the output is always 4 here. let's keep the function in there
       // in case of further generalization to CW-complexes
       return 4;
     };
 
     const std::vector<std::vector<SimplexId>> *
-      getCellTrianglesInternal() override;
+      getCellTrianglesInternal() final;
 
     int TTK_TRIANGULATION_INTERNAL(getCellVertex)(
       const SimplexId &cellId,
@@ -74,55 +76,55 @@ namespace ttk {
     int
       TTK_TRIANGULATION_INTERNAL(getEdgeLink)(const SimplexId &edgeId,
                                               const int &localLinkId,
-                                              SimplexId &linkId) const override;
+                                              SimplexId &linkId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getEdgeLinkNumber)(
-      const SimplexId &edgeId) const override;
+      const SimplexId &edgeId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getEdgeLinks)() override;
+      TTK_TRIANGULATION_INTERNAL(getEdgeLinks)() final;
 
     int
       TTK_TRIANGULATION_INTERNAL(getEdgeStar)(const SimplexId &edgeId,
                                               const int &localStarId,
-                                              SimplexId &starId) const override;
+                                              SimplexId &starId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getEdgeStarNumber)(
-      const SimplexId &edgeId) const override;
+      const SimplexId &edgeId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getEdgeStars)() override;
+      TTK_TRIANGULATION_INTERNAL(getEdgeStars)() final;
 
     int getEdgeTriangleInternal(const SimplexId &edgeId,
                                 const int &id,
-                                SimplexId &triangleId) const override;
+                                SimplexId &triangleId) const final;
 
     SimplexId
-      getEdgeTriangleNumberInternal(const SimplexId &edgeId) const override;
+      getEdgeTriangleNumberInternal(const SimplexId &edgeId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      getEdgeTrianglesInternal() override;
+      getEdgeTrianglesInternal() final;
 
     int getEdgeVertexInternal(const SimplexId &edgeId,
                               const int &localVertexId,
-                              SimplexId &vertexId) const override;
+                              SimplexId &vertexId) const final;
 
     const std::vector<std::array<SimplexId, 2>> *
-      TTK_TRIANGULATION_INTERNAL(getEdges)() override;
+      TTK_TRIANGULATION_INTERNAL(getEdges)() final;
 
-    SimplexId TTK_TRIANGULATION_INTERNAL(getNumberOfCells)() const override {
+    SimplexId TTK_TRIANGULATION_INTERNAL(getNumberOfCells)() const final {
       return cellNumber_;
     };
 
-    SimplexId getNumberOfEdgesInternal() const override {
+    SimplexId getNumberOfEdgesInternal() const final {
       return edgeNumber_;
     };
 
-    SimplexId getNumberOfTrianglesInternal() const override {
+    SimplexId getNumberOfTrianglesInternal() const final {
       return triangleNumber_;
     };
 
-    SimplexId TTK_TRIANGULATION_INTERNAL(getNumberOfVertices)() const override {
+    SimplexId TTK_TRIANGULATION_INTERNAL(getNumberOfVertices)() const final {
       return vertexNumber_;
     };
 
@@ -153,17 +155,17 @@ namespace ttk {
 
     int getTriangleEdgeInternal(const SimplexId &triangleId,
                                 const int &id,
-                                SimplexId &edgeId) const override;
+                                SimplexId &edgeId) const final;
 
     SimplexId getTriangleEdgeNumberInternal(
-      const SimplexId &triangleId) const override {
+      const SimplexId &triangleId) const final {
       // NOTE: the output is always 3 here. let's keep the function in there
       // in case of further generalization to CW-complexes
       return 3;
     }
 
     const std::vector<std::vector<SimplexId>> *
-      getTriangleEdgesInternal() override;
+      getTriangleEdgesInternal() final;
 
     int getTriangleEdgesInternal(
       std::vector<std::vector<SimplexId>> &edges) const;
@@ -171,13 +173,13 @@ namespace ttk {
     int TTK_TRIANGULATION_INTERNAL(getTriangleLink)(
       const SimplexId &triangleId,
       const int &localLinkId,
-      SimplexId &linkId) const override;
+      SimplexId &linkId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getTriangleLinkNumber)(
-      const SimplexId &triangleId) const override;
+      const SimplexId &triangleId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getTriangleLinks)() override;
+      TTK_TRIANGULATION_INTERNAL(getTriangleLinks)() final;
 
     int getTriangleNeighbor(const SimplexId &triangleId,
                             const int &localNeighborId,
@@ -190,41 +192,41 @@ namespace ttk {
     int TTK_TRIANGULATION_INTERNAL(getTriangleStar)(
       const SimplexId &triangleId,
       const int &localStarId,
-      SimplexId &starId) const override;
+      SimplexId &starId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getTriangleStarNumber)(
-      const SimplexId &triangleId) const override;
+      const SimplexId &triangleId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getTriangleStars)() override;
+      TTK_TRIANGULATION_INTERNAL(getTriangleStars)() final;
 
     int getTriangleVertexInternal(const SimplexId &triangleId,
                                   const int &localVertexId,
-                                  SimplexId &vertexId) const override;
+                                  SimplexId &vertexId) const final;
 
     const std::vector<std::array<SimplexId, 3>> *
-      TTK_TRIANGULATION_INTERNAL(getTriangles)() override;
+      TTK_TRIANGULATION_INTERNAL(getTriangles)() final;
 
     int getVertexEdgeInternal(const SimplexId &vertexId,
                               const int &id,
-                              SimplexId &edgeId) const override;
+                              SimplexId &edgeId) const final;
 
     SimplexId
-      getVertexEdgeNumberInternal(const SimplexId &vertexId) const override;
+      getVertexEdgeNumberInternal(const SimplexId &vertexId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      getVertexEdgesInternal() override;
+      getVertexEdgesInternal() final;
 
     int TTK_TRIANGULATION_INTERNAL(getVertexLink)(
       const SimplexId &vertexId,
       const int &localLinkId,
-      SimplexId &linkId) const override;
+      SimplexId &linkId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getVertexLinkNumber)(
-      const SimplexId &vertexId) const override;
+      const SimplexId &vertexId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getVertexLinks)() override;
+      TTK_TRIANGULATION_INTERNAL(getVertexLinks)() final;
 
     int TTK_TRIANGULATION_INTERNAL(getVertexNeighbor)(
       const SimplexId &vertexId,
@@ -235,43 +237,43 @@ namespace ttk {
       const SimplexId &vertexId) const override;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getVertexNeighbors)() override;
+      TTK_TRIANGULATION_INTERNAL(getVertexNeighbors)() final;
 
     int TTK_TRIANGULATION_INTERNAL(getVertexPoint)(const SimplexId &vertexId,
                                                    float &x,
                                                    float &y,
-                                                   float &z) const override;
+                                                   float &z) const final;
 
     int TTK_TRIANGULATION_INTERNAL(getVertexStar)(
       const SimplexId &vertexId,
       const int &localStarId,
-      SimplexId &starId) const override;
+      SimplexId &starId) const final;
 
     SimplexId TTK_TRIANGULATION_INTERNAL(getVertexStarNumber)(
-      const SimplexId &vertexId) const override;
+      const SimplexId &vertexId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      TTK_TRIANGULATION_INTERNAL(getVertexStars)() override;
+      TTK_TRIANGULATION_INTERNAL(getVertexStars)() final;
 
     int getVertexTriangleInternal(const SimplexId &vertexId,
                                   const int &id,
-                                  SimplexId &triangleId) const override;
+                                  SimplexId &triangleId) const final;
 
     SimplexId
-      getVertexTriangleNumberInternal(const SimplexId &vertexId) const override;
+      getVertexTriangleNumberInternal(const SimplexId &vertexId) const final;
 
     const std::vector<std::vector<SimplexId>> *
-      getVertexTrianglesInternal() override;
+      getVertexTrianglesInternal() final;
 
     bool TTK_TRIANGULATION_INTERNAL(isEdgeOnBoundary)(
-      const SimplexId &edgeId) const override;
+      const SimplexId &edgeId) const final;
 
-    inline bool isEmpty() const override {
+    inline bool isEmpty() const final {
       return !vertexNumber_;
     };
 
     bool TTK_TRIANGULATION_INTERNAL(isTriangleOnBoundary)(
-      const SimplexId &triangleId) const override;
+      const SimplexId &triangleId) const final;
 
     bool TTK_TRIANGULATION_INTERNAL(isVertexOnBoundary)(
       const SimplexId &vertexId) const override;
@@ -287,8 +289,8 @@ namespace ttk {
                      const int &zDim);
 
     int preconditionVerticesInternal();
-    int preconditionEdgesInternal() override;
-    int preconditionTrianglesInternal() override;
+    int preconditionEdgesInternal() final;
+    int preconditionTrianglesInternal() final;
     int preconditionTetrahedronsInternal();
 
     inline int preconditionCellsInternal() {
@@ -3369,4 +3371,122 @@ inline ttk::SimplexId
   return -1;
 }
 
+namespace ttk {
+
+  /**
+   * @brief Periodic implicit triangulation of a 2D or 3D grid, specialized
+   * on the grid dimension.
+   *
+   * All the vertices have the same neighborhood: the vertex neighbors and
+   * the cell vertices are given by the compile-time stencils of
+   * ttk::ImplicitGridStencil, wrapped around the grid without branches.
+   * The other queries are the ones of PeriodicImplicitTriangulation.
+   */
+  template <size_t dim>
+  class PeriodicImplicitTriangulationDim final
+    : public PeriodicImplicitTriangulation {
+
+    static_assert(dim == 2 || dim == 3, "only 2D and 3D grids");
+
+    using Stencil = ImplicitGridStencil<dim>;
+
+  public:
+    SimplexId TTK_TRIANGULATION_INTERNAL(getCellVertexNumber)(
+      const SimplexId & /*cellId*/) const override {
+      return dim + 1;
+    }
+
+    int TTK_TRIANGULATION_INTERNAL(getCellVertex)(
+      const SimplexId &cellId,
+      const int &localVertexId,
+      SimplexId &vertexId) const override {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+      if(cellId < 0 or cellId >= cellNumber_)
+        return -1;
+      if(localVertexId < 0 or localVertexId > static_cast<int>(dim))
+        return -2;
+#endif // !TTK_ENABLE_KAMIKAZE
+
+      const auto &p
+        = dim == 3 ? tetrahedronCoords_[cellId] : triangleCoords_[cellId];
+      const int type = cellId % Stencil::cellsPerVoxel;
+      const int corner = Stencil::cellVertices()[type][localVertexId];
+
+      // first vertex of the voxel, plus the wrapped offset of the corner
+      const SimplexId x = dim == 3 ? p[0] : p[0] / 2;
+      vertexId = x + p[1] * vshift_[0];
+      vertexId += this->wrappedOffset(0, x, corner & 1);
+      vertexId += this->wrappedOffset(1, p[1], (corner >> 1) & 1);
+      if(dim == 3) {
+        vertexId += p[2] * vshift_[1];
+        vertexId += this->wrappedOffset(2, p[2], corner >> 2);
+      }
+      return 0;
+    }
+
+    int TTK_TRIANGULATION_INTERNAL(getDimensionality)() const override {
+      return dim;
+    }
+
+    SimplexId TTK_TRIANGULATION_INTERNAL(getVertexNeighborNumber)(
+      const SimplexId &vertexId) const override {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+      if(vertexId < 0 or vertexId >= vertexNumber_)
+        return -1;
+#endif // !TTK_ENABLE_KAMIKAZE
+
+      return Stencil::vertexNeighborNumber;
+    }
+
+    int TTK_TRIANGULATION_INTERNAL(getVertexNeighbor)(
+      const SimplexId &vertexId,
+      const int &localNeighborId,
+      SimplexId &neighborId) const override {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+      if(vertexId < 0 or vertexId >= vertexNumber_)
+        return -1;
+      if(localNeighborId < 0
+         or localNeighborId >= Stencil::vertexNeighborNumber)
+        return -1;
+#endif // !TTK_ENABLE_KAMIKAZE
+
+      const auto &p = vertexCoords_[vertexId];
+      const auto &offset = Stencil::vertexNeighbors()[localNeighborId];
+
+      neighborId = vertexId;
+      for(size_t i = 0; i < dim; ++i) {
+        neighborId += this->wrappedOffset(i, p[i], offset[i]);
+      }
+      return 0;
+    }
+
+    bool TTK_TRIANGULATION_INTERNAL(isVertexOnBoundary)(
+      const SimplexId & /*vertexId*/) const override {
+      return false;
+    }
+
+  protected:
+    /// Identifier offset of a move of @p offset (-1, 0 or 1) along the
+    /// @p axis-th grid axis from the coordinate @p x, wrapping around the
+    /// grid.
+    inline SimplexId wrappedOffset(const size_t axis,
+                                   const SimplexId x,
+                                   const int offset) const {
+      const SimplexId last
+        = dim == 3 ? nbvoxels_[axis] : nbvoxels_[axis == 0 ? Di_ : Dj_];
+      const SimplexId shift = axis == 0 ? 1 : vshift_[axis - 1];
+      const SimplexId c = x + offset;
+      return offset * shift + (c < 0) * wrap_[axis]
+             - (c > last) * wrap_[axis];
+    }
+  };
+
+  using PeriodicImplicitTriangulation2D = PeriodicImplicitTriangulationDim<2>;
+  using PeriodicImplicitTriangulation3D = PeriodicImplicitTriangulationDim<3>;
+
+} // namespace ttk
+
 #endif // _PERIODICIMPLICITTRIANGULATION_H
@@ -46,6 +46,7 @@
 // base code includes
 #include <DiscreteGradient.h>
 #include <FTMTreePP.h>
+#include <PersistenceDiagramColumns.h>
 #include <ProgressiveTopology.h>
 #include <Triangulation.h>
 
@@ -139,6 +140,22 @@ namespace ttk {
     template <class triangulationType>
     void checkProgressivityRequirement(const triangulationType *triangulation);
 
+    /**
+     * @brief Columnar version of a diagram computed by execute()
+     *
+     * Birth and death are the scalar values of the pair vertices, the
+     * coordinates their positions in the triangulation. The pair types
+     * follow the VTK output convention: -1 for the first pair, then 0
+     * (minimum-saddle), 1 (saddle-saddle) or the cell dimension minus one
+     * (saddle-maximum). One more pair is reserved for the diagonal of the
+     * VTK output.
+     */
+    template <typename scalarType, class triangulationType>
+    void getDiagramColumns(PersistenceDiagramColumns<double> &columns,
+                           const std::vector<PersistencePair> &CTDiagram,
+                           const scalarType *inputScalars,
+                           const triangulationType *triangulation) const;
+
     inline void
       preconditionTriangulation(AbstractTriangulation *triangulation) {
       if(triangulation) {
@@ -209,6 +226,58 @@ int ttk::PersistenceDiagram::computeCTPersistenceDiagram(
   return 0;
 }
 
+template <typename scalarType, class triangulationType>
+void ttk::PersistenceDiagram::getDiagramColumns(
+  PersistenceDiagramColumns<double> &columns,
+  const std::vector<PersistencePair> &CTDiagram,
+  const scalarType *inputScalars,
+  const triangulationType *triangulation) const {
+
+  const size_t nPairs = CTDiagram.size();
+  const SimplexId maxIndex = triangulation->getCellVertexNumber(0) - 2;
+
+  columns.clear();
+  for(auto column : {&columns.persistence, &columns.birth, &columns.death}) {
+    column->reserve(nPairs + 1);
+  }
+  columns.resize(nPairs);
+
+  // raw pointers: the columns are not shared while being filled
+  SimplexId *const v1 = columns.birthVertex.data();
+  CriticalType *const t1 = columns.birthType.data();
+  SimplexId *const v2 = columns.deathVertex.data();
+  CriticalType *const t2 = columns.deathType.data();
+  double *const pers = columns.persistence.data();
+  SimplexId *const type = columns.pairType.data();
+  double *const birth = columns.birth.data();
+  double *const death = columns.death.data();
+  float *const bx = columns.birthX.data();
+  float *const by = columns.birthY.data();
+  float *const bz = columns.birthZ.data();
+  float *const dx = columns.deathX.data();
+  float *const dy = columns.deathY.data();
+  float *const dz = columns.deathZ.data();
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nPairs; ++i) {
+    const auto &pair = CTDiagram[i];
+    v1[i] = pair.birth;
+    t1[i] = pair.birthType;
+    v2[i] = pair.death;
+    t2[i] = pair.deathType;
+    pers[i] = pair.persistence;
+    type[i] = i == 0                ? -1
+              : pair.pairType == 2 ? maxIndex
+                                   : pair.pairType;
+    birth[i] = inputScalars[pair.birth];
+    death[i] = inputScalars[pair.death];
+    triangulation->getVertexPoint(pair.birth, bx[i], by[i], bz[i]);
+    triangulation->getVertexPoint(pair.death, dx[i], dy[i], dz[i]);
+  }
+}
+
 template <typename scalarType, class triangulationType>
 int ttk::PersistenceDiagram::execute(std::vector<PersistencePair> &CTDiagram,
                                      const scalarType *inputScalars,
@@ -361,7 +430,8 @@ template <class triangulationType>
 void ttk::PersistenceDiagram::checkProgressivityRequirement(
   const triangulationType *triangulation) {
   if(BackEnd == BACKEND::PROGRESSIVE_TOPOLOGY) {
-    if(!std::is_same<triangulationType, ttk::ImplicitTriangulation>::value) {
+    if(!std::is_base_of<ttk::ImplicitTriangulation,
+                        triangulationType>::value) {
 
       printWrn("Explicit triangulation detected.");
       printWrn("Defaulting to the FTM backend.");
@@ -52,8 +52,8 @@ namespace ttk {
 
     KDTree<dataType> default_kdt_{};
     KDTree<dataType> &kdt_{default_kdt_};
-    std::vector<KDTree<dataType> *> default_correspondance_kdt_map_{};
-    std::vector<KDTree<dataType> *> &correspondance_kdt_map_{
+    typename KDTree<dataType>::KDTreeMap default_correspondance_kdt_map_{};
+    typename KDTree<dataType>::KDTreeMap &correspondance_kdt_map_{
       default_correspondance_kdt_map_};
 
     PersistenceDiagramAuction(int wasserstein,
@@ -73,7 +73,7 @@ namespace ttk {
       double lambda,
       double delta_lim,
       KDTree<dataType> &kdt,
-      std::vector<KDTree<dataType> *> &correspondance_kdt_map,
+      typename KDTree<dataType>::KDTreeMap &correspondance_kdt_map,
       dataType epsilon = {},
       dataType initial_diag_price = {},
       bool use_kdTree = true)
@@ -449,7 +449,8 @@ namespace ttk {
       int wasserstein,
       dataType epsilon,
       double geometricalFactor,
-      std::vector<KDTree<dataType> *> &correspondance_kdt_map,
+      KDTree<dataType> *kdt,
+      const typename KDTree<dataType>::KDTreeMap &correspondance_kdt_map,
       std::priority_queue<std::pair<int, dataType>,
                           std::vector<std::pair<int, dataType>>,
                           Compare<dataType>> &diagonal_queue,
@@ -662,7 +663,8 @@ namespace ttk {
     int wasserstein,
     dataType epsilon,
     double geometricalFactor,
-    std::vector<KDTree<dataType> *> &correspondance_kdt_map,
+    KDTree<dataType> *kdt,
+    const typename KDTree<dataType>::KDTreeMap &correspondance_kdt_map,
     std::priority_queue<std::pair<int, dataType>,
                         std::vector<std::pair<int, dataType>>,
                         Compare<dataType>> &diagonal_queue,
@@ -771,8 +773,8 @@ namespace ttk {
     if(is_twin) {
       // std::cout << "got here 5" << std::endl;
       // Update weight in KDTree if the closest good is in it
-      correspondance_kdt_map[best_good->id_]->updateWeight(
-        new_price, kdt_index);
+      kdt->updateWeight(
+        correspondance_kdt_map[best_good->id_], new_price, kdt_index);
       if(non_empty_goods) {
         diagonal_queue.push(best_pair);
       }
@@ -796,7 +798,7 @@ namespace ttk {
                                       KDTree<dataType> *kdt,
                                       const int kdt_index) {
     /// Runs bidding of a non-diagonal bidder
-    std::vector<KDTree<dataType> *> neighbours;
+    std::vector<int> neighbours;
     std::vector<dataType> costs;
 
     std::vector<dataType> coordinates;
@@ -812,7 +814,7 @@ namespace ttk {
     kdt->getKClosest(2, coordinates, neighbours, costs, kdt_index);
     // std::cout<<"got to 2"<<std::endl;
     dataType best_val, second_val;
-    KDTree<dataType> *closest_kdt;
+    int closest_kdt;
     Good<dataType> *best_good{};
     if(costs.size() == 2) {
       // std::cout<<"got to 735"<<std::endl;
@@ -823,7 +825,7 @@ namespace ttk {
            [&costs](int &a, int &b) { return costs[a] < costs[b]; });
 
       closest_kdt = neighbours[idx[0]];
-      best_good = &(goods->get(closest_kdt->id_));
+      best_good = &(goods->get(kdt->getId(closest_kdt)));
       // Value is defined as the opposite of cost (each bidder aims at
       // maximizing it)
       best_val = -costs[idx[0]];
@@ -832,7 +834,7 @@ namespace ttk {
       // std::cout<<"got to 748"<<std::endl;
       // If the kdtree contains only one point
       closest_kdt = neighbours[0];
-      best_good = &(goods->get(closest_kdt->id_));
+      best_good = &(goods->get(kdt->getId(closest_kdt)));
       best_val = -costs[0];
       second_val = best_val;
     }
@@ -873,7 +875,7 @@ namespace ttk {
     best_good->assign(this->position_in_auction_, new_price);
     // Update the price in the KDTree
     if(!twin_chosen) {
-      closest_kdt->updateWeight(new_price, kdt_index);
+      kdt->updateWeight(closest_kdt, new_price, kdt_index);
     }
     return idx_reassigned;
   }
@@ -30,7 +30,7 @@ void ttk::PersistenceDiagramAuction<dataType>::runAuctionRound(
       if(use_kdt_) {
         idx_reassigned = b.runDiagonalKDTBidding(
           &all_goods, twin_good, wasserstein_, epsilon, geometricalFactor_,
-          correspondance_kdt_map_, diagonal_queue_, kdt_index);
+          &kdt_, correspondance_kdt_map_, diagonal_queue_, kdt_index);
       } else {
         idx_reassigned
           = b.runDiagonalBidding(&all_goods, twin_good, wasserstein_, epsilon,
@@ -61,6 +61,10 @@ void ttk::PersistenceDiagramAuction<dataType>::runAuctionRound(
       unassignedBidders_.push(idx_reassigned);
     }
   }
+  if(use_kdt_) {
+    // apply the pending price updates to the kd-tree
+    kdt_.flushWeights(kdt_index);
+  }
 }
 
 template <typename dataType>
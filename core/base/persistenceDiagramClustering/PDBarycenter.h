@@ -22,6 +22,7 @@
 #include <limits>
 //
 #include <PersistenceDiagramBarycenter.h>
+#include <PersistenceDiagramColumns.h>
 
 using namespace std;
 using namespace ttk;
@@ -73,22 +74,23 @@ namespace ttk {
                                  typename KDTree<dataType>::KDTreeMap>;
     KDTreePair getKDTree() const;
 
-    void runMatching(dataType *total_cost,
-                     dataType epsilon,
-                     std::vector<int> sizes,
-                     KDTree<dataType> &kdt,
-                     std::vector<KDTree<dataType> *> &correspondance_kdt_map,
-                     std::vector<dataType> *min_diag_price,
-                     std::vector<dataType> *min_price,
-                     std::vector<std::vector<matchingTuple>> *all_matchings,
-                     bool use_kdt,
-                     int compute_only_distance);
+    void runMatching(
+      dataType *total_cost,
+      dataType epsilon,
+      std::vector<int> sizes,
+      KDTree<dataType> &kdt,
+      typename KDTree<dataType>::KDTreeMap &correspondance_kdt_map,
+      std::vector<dataType> *min_diag_price,
+      std::vector<dataType> *min_price,
+      std::vector<std::vector<matchingTuple>> *all_matchings,
+      bool use_kdt,
+      int compute_only_distance);
 
     void runMatchingAuction(
       dataType *total_cost,
       std::vector<int> sizes,
       KDTree<dataType> &kdt,
-      std::vector<KDTree<dataType> *> &correspondance_kdt_map,
+      typename KDTree<dataType>::KDTreeMap &correspondance_kdt_map,
       std::vector<dataType> *min_diag_price,
       std::vector<std::vector<matchingTuple>> *all_matchings,
       bool use_kdt);
@@ -134,7 +136,8 @@ namespace ttk {
       }
     }
 
-    inline int setDiagrams(std::vector<std::vector<diagramTuple>> *data) {
+    inline int
+      setDiagrams(std::vector<PersistenceDiagramColumns<dataType>> *data) {
       inputDiagrams_ = data;
       return 0;
     }
@@ -246,7 +249,7 @@ namespace ttk {
     bool use_progressive_;
     double time_limit_;
     double epsilon_min_;
-    std::vector<std::vector<diagramTuple>> *inputDiagrams_;
+    std::vector<PersistenceDiagramColumns<dataType>> *inputDiagrams_;
 
     int points_added_;
     int points_deleted_;
@@ -50,7 +50,7 @@ void PDBarycenter<dataType>::runMatching(
   dataType epsilon,
   std::vector<int> sizes,
   KDTree<dataType> &kdt,
-  std::vector<KDTree<dataType> *> &correspondance_kdt_map,
+  typename KDTree<dataType>::KDTreeMap &correspondance_kdt_map,
   std::vector<dataType> *min_diag_price,
   std::vector<dataType> *min_price,
   std::vector<std::vector<matchingTuple>> *all_matchings,
@@ -130,7 +130,7 @@ void PDBarycenter<dataType>::runMatchingAuction(
   dataType *total_cost,
   std::vector<int> sizes,
   KDTree<dataType> &kdt,
-  std::vector<KDTree<dataType> *> &correspondance_kdt_map,
+  typename KDTree<dataType>::KDTreeMap &correspondance_kdt_map,
   std::vector<dataType> *min_diag_price,
   std::vector<std::vector<matchingTuple>> *all_matchings,
   bool use_kdt) {
@@ -422,12 +422,13 @@ template <typename dataType>
 void PDBarycenter<dataType>::setBidderDiagrams() {
 
   for(int i = 0; i < numberOfInputs_; i++) {
-    std::vector<diagramTuple> *CTDiagram = &((*inputDiagrams_)[i]);
+    const auto &CTDiagram = (*inputDiagrams_)[i];
 
     BidderDiagram<dataType> bidders;
-    for(unsigned int j = 0; j < CTDiagram->size(); j++) {
+    for(unsigned int j = 0; j < CTDiagram.size(); j++) {
       // Add bidder to bidders
-      Bidder<dataType> b((*CTDiagram)[j], j, lambda_);
+      auto t = CTDiagram.template getTuple<diagramTuple>(j);
+      Bidder<dataType> b(t, j, lambda_);
 
       b.setPositionInAuction(bidders.size());
       bidders.addBidder(b);
@@ -599,7 +600,7 @@ template <typename dataType>
 void PDBarycenter<dataType>::setInitialBarycenter(dataType min_persistence) {
   int size = 0;
   int random_idx;
-  std::vector<diagramTuple> *CTDiagram;
+  const PersistenceDiagramColumns<dataType> *CTDiagram;
   int iter = 0;
   while(size == 0) {
     random_idx
@@ -611,7 +612,8 @@ void PDBarycenter<dataType>::setInitialBarycenter(dataType min_persistence) {
       int count = 0;
       for(unsigned int j = 0; j < CTDiagram->size(); j++) {
         // Add bidder to bidders
-        Good<dataType> g = Good<dataType>((*CTDiagram)[j], count, lambda_);
+        auto t = CTDiagram->template getTuple<diagramTuple>(j);
+        Good<dataType> g = Good<dataType>(t, count, lambda_);
         if(g.getPersistence() >= min_persistence) {
           goods.addGood(g);
           count++;
@@ -832,7 +834,7 @@ std::vector<std::vector<matchingTuple>>
     n_iterations += 1;
 
     std::pair<std::unique_ptr<KDTree<dataType>>,
-              std::vector<KDTree<dataType> *>>
+              typename KDTree<dataType>::KDTreeMap>
       pair;
     bool use_kdt = false;
     // If the barycenter is empty, do not compute the kdt (or it will crash :/)
@@ -23,6 +23,7 @@
 #include <limits>
 
 #include <PDBarycenter.h>
+#include <PersistenceDiagramColumns.h>
 
 using namespace std;
 using namespace ttk;
@@ -139,9 +140,10 @@ namespace ttk {
       do_sad_ = original_dos[1];
       do_max_ = original_dos[2];
     }
-    inline int setDiagrams(std::vector<std::vector<diagramTuple>> *data_min,
-                           std::vector<std::vector<diagramTuple>> *data_saddle,
-                           std::vector<std::vector<diagramTuple>> *data_max) {
+    inline int
+      setDiagrams(std::vector<PersistenceDiagramColumns<dataType>> *data_min,
+                  std::vector<PersistenceDiagramColumns<dataType>> *data_saddle,
+                  std::vector<PersistenceDiagramColumns<dataType>> *data_max) {
       inputDiagramsMin_ = data_min;
       inputDiagramsSaddle_ = data_saddle;
       inputDiagramsMax_ = data_max;
@@ -303,9 +305,9 @@ namespace ttk {
     std::vector<std::vector<int>> current_bidder_ids_min_;
     std::vector<std::vector<int>> current_bidder_ids_sad_;
     std::vector<std::vector<int>> current_bidder_ids_max_;
-    std::vector<std::vector<diagramTuple>> *inputDiagramsMin_;
-    std::vector<std::vector<diagramTuple>> *inputDiagramsSaddle_;
-    std::vector<std::vector<diagramTuple>> *inputDiagramsMax_;
+    std::vector<PersistenceDiagramColumns<dataType>> *inputDiagramsMin_;
+    std::vector<PersistenceDiagramColumns<dataType>> *inputDiagramsSaddle_;
+    std::vector<PersistenceDiagramColumns<dataType>> *inputDiagramsMax_;
 
     std::array<bool, 3> original_dos;
 
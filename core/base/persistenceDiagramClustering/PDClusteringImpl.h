@@ -738,39 +738,21 @@ vector<vector<int>> PDClustering<dataType>::get_centroids_sizes() {
 template <typename dataType>
 dataType PDClustering<dataType>::getMostPersistent(int type) {
   dataType max_persistence = 0;
-  // std::cout << "type = " << type << std::endl;
-  if(do_min_ && (type == -1 || type == 0)) {
-    for(unsigned int i = 0; i < bidder_diagrams_min_.size(); ++i) {
-      for(int j = 0; j < bidder_diagrams_min_[i].size(); ++j) {
-        Bidder<dataType> b = bidder_diagrams_min_[i].get(j);
-        dataType persistence = b.getPersistence();
-        if(persistence > max_persistence) {
-          max_persistence = persistence;
-        }
-      }
+  const std::array<bool, 3> dos{do_min_, do_sad_, do_max_};
+  const std::array<std::vector<PersistenceDiagramColumns<dataType>> *, 3>
+    diagrams{inputDiagramsMin_, inputDiagramsSaddle_, inputDiagramsMax_};
+  for(int t = 0; t < 3; ++t) {
+    if(!dos[t] || (type != -1 && type != t)) {
+      continue;
     }
-  }
-
-  if(do_sad_ && (type == -1 || type == 1)) {
-    for(unsigned int i = 0; i < bidder_diagrams_saddle_.size(); ++i) {
-      for(int j = 0; j < bidder_diagrams_saddle_[i].size(); ++j) {
-        Bidder<dataType> b = bidder_diagrams_saddle_[i].get(j);
-        dataType persistence = b.getPersistence();
-        if(persistence > max_persistence) {
-          max_persistence = persistence;
-        }
-      }
-    }
-  }
-
-  if(do_max_ && (type == -1 || type == 2)) {
-    for(unsigned int i = 0; i < bidder_diagrams_max_.size(); ++i) {
-      for(int j = 0; j < bidder_diagrams_max_[i].size(); ++j) {
-        Bidder<dataType> b = bidder_diagrams_max_[i].get(j);
-        dataType persistence = b.getPersistence();
-        if(persistence > max_persistence) {
-          max_persistence = persistence;
-        }
+    for(const auto &diag : *diagrams[t]) {
+      const dataType *const birth = diag.birth.data();
+      const dataType *const death = diag.death.data();
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(max : max_persistence)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t j = 0; j < diag.size(); ++j) {
+        max_persistence = std::max(death[j] - birth[j], max_persistence);
       }
     }
   }
@@ -781,40 +763,22 @@ template <typename dataType>
 dataType PDClustering<dataType>::getLessPersistent(int type) {
   // type == -1 : query the min of all the types of diagrams.
   // type = 0 : min,  1 : sad,   2 : max
-  // std::cout << "type = " << type << std::endl;
   dataType min_persistence = std::numeric_limits<dataType>::max();
-  if(do_min_ && (type == -1 || type == 0)) {
-    for(unsigned int i = 0; i < bidder_diagrams_min_.size(); ++i) {
-      for(int j = 0; j < bidder_diagrams_min_[i].size(); ++j) {
-        Bidder<dataType> b = bidder_diagrams_min_[i].get(j);
-        dataType persistence = b.getPersistence();
-        if(persistence < min_persistence) {
-          min_persistence = persistence;
-        }
-      }
-    }
-  }
-
-  if(do_sad_ && (type == -1 || type == 1)) {
-    for(unsigned int i = 0; i < bidder_diagrams_saddle_.size(); ++i) {
-      for(int j = 0; j < bidder_diagrams_saddle_[i].size(); ++j) {
-        Bidder<dataType> b = bidder_diagrams_saddle_[i].get(j);
-        dataType persistence = b.getPersistence();
-        if(persistence < min_persistence) {
-          min_persistence = persistence;
-        }
-      }
+  const std::array<bool, 3> dos{do_min_, do_sad_, do_max_};
+  const std::array<std::vector<PersistenceDiagramColumns<dataType>> *, 3>
+    diagrams{inputDiagramsMin_, inputDiagramsSaddle_, inputDiagramsMax_};
+  for(int t = 0; t < 3; ++t) {
+    if(!dos[t] || (type != -1 && type != t)) {
+      continue;
     }
-  }
-
-  if(do_max_ && (type == -1 || type == 2)) {
-    for(unsigned int i = 0; i < bidder_diagrams_max_.size(); ++i) {
-      for(int j = 0; j < bidder_diagrams_max_[i].size(); ++j) {
-        Bidder<dataType> b = bidder_diagrams_max_[i].get(j);
-        dataType persistence = b.getPersistence();
-        if(persistence < min_persistence) {
-          min_persistence = persistence;
-        }
+    for(const auto &diag : *diagrams[t]) {
+      const dataType *const birth = diag.birth.data();
+      const dataType *const death = diag.death.data();
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(min : min_persistence)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t j = 0; j < diag.size(); ++j) {
+        min_persistence = std::min(death[j] - birth[j], min_persistence);
       }
     }
   }
@@ -2264,11 +2228,12 @@ template <typename dataType>
 void PDClustering<dataType>::setBidderDiagrams() {
   for(int i = 0; i < numberOfInputs_; i++) {
     if(do_min_) {
-      std::vector<diagramTuple> *CTDiagram = &((*inputDiagramsMin_)[i]);
+      const auto &CTDiagram = (*inputDiagramsMin_)[i];
       BidderDiagram<dataType> bidders;
-      for(unsigned int j = 0; j < CTDiagram->size(); j++) {
+      for(unsigned int j = 0; j < CTDiagram.size(); j++) {
         // Add bidder to bidders
-        Bidder<dataType> b((*CTDiagram)[j], j, lambda_);
+        auto t = CTDiagram.template getTuple<diagramTuple>(j);
+        Bidder<dataType> b(t, j, lambda_);
 
         b.setPositionInAuction(bidders.size());
         bidders.addBidder(b);
@@ -2287,12 +2252,13 @@ void PDClustering<dataType>::setBidderDiagrams() {
     }
 
     if(do_sad_) {
-      std::vector<diagramTuple> *CTDiagram = &((*inputDiagramsSaddle_)[i]);
+      const auto &CTDiagram = (*inputDiagramsSaddle_)[i];
 
       BidderDiagram<dataType> bidders;
-      for(unsigned int j = 0; j < CTDiagram->size(); j++) {
+      for(unsigned int j = 0; j < CTDiagram.size(); j++) {
         // Add bidder to bidders
-        Bidder<dataType> b((*CTDiagram)[j], j, lambda_);
+        auto t = CTDiagram.template getTuple<diagramTuple>(j);
+        Bidder<dataType> b(t, j, lambda_);
 
         b.setPositionInAuction(bidders.size());
         bidders.addBidder(b);
@@ -2311,12 +2277,13 @@ void PDClustering<dataType>::setBidderDiagrams() {
     }
 
     if(do_max_) {
-      std::vector<diagramTuple> *CTDiagram = &((*inputDiagramsMax_)[i]);
+      const auto &CTDiagram = (*inputDiagramsMax_)[i];
 
       BidderDiagram<dataType> bidders;
-      for(unsigned int j = 0; j < CTDiagram->size(); j++) {
+      for(unsigned int j = 0; j < CTDiagram.size(); j++) {
         // Add bidder to bidders
-        Bidder<dataType> b((*CTDiagram)[j], j, lambda_);
+        auto t = CTDiagram.template getTuple<diagramTuple>(j);
+        Bidder<dataType> b(t, j, lambda_);
 
         b.setPositionInAuction(bidders.size());
         bidders.addBidder(b);
@@ -2413,9 +2380,11 @@ std::vector<dataType> PDClustering<dataType>::enrichCurrentBidderDiagrams(
   if(do_min_) {
     for(int i = 0; i < numberOfInputs_; i++) {
       std::vector<dataType> persistences;
-      for(int j = 0; j < bidder_diagrams_min_[i].size(); j++) {
-        Bidder<dataType> b = bidder_diagrams_min_[i].get(j);
-        dataType persistence = b.getPersistence();
+      const auto &diag = (*inputDiagramsMin_)[i];
+      const dataType *const birth = diag.birth.data();
+      const dataType *const death = diag.death.data();
+      for(size_t j = 0; j < diag.size(); j++) {
+        const dataType persistence = death[j] - birth[j];
         if(persistence >= min_persistence[0]
            && persistence <= previous_min_persistence[0]) {
           candidates_to_be_added_min[i].push_back(j);
@@ -2452,9 +2421,11 @@ std::vector<dataType> PDClustering<dataType>::enrichCurrentBidderDiagrams(
   if(do_sad_) {
     for(int i = 0; i < numberOfInputs_; i++) {
       std::vector<dataType> persistences;
-      for(int j = 0; j < bidder_diagrams_saddle_[i].size(); j++) {
-        Bidder<dataType> b = bidder_diagrams_saddle_[i].get(j);
-        dataType persistence = b.getPersistence();
+      const auto &diag = (*inputDiagramsSaddle_)[i];
+      const dataType *const birth = diag.birth.data();
+      const dataType *const death = diag.death.data();
+      for(size_t j = 0; j < diag.size(); j++) {
+        const dataType persistence = death[j] - birth[j];
         if(persistence >= min_persistence[1]
            && persistence <= previous_min_persistence[1]) {
           candidates_to_be_added_sad[i].push_back(j);
@@ -2490,9 +2461,11 @@ std::vector<dataType> PDClustering<dataType>::enrichCurrentBidderDiagrams(
   if(do_max_) {
     for(int i = 0; i < numberOfInputs_; i++) {
       std::vector<dataType> persistences;
-      for(int j = 0; j < bidder_diagrams_max_[i].size(); j++) {
-        Bidder<dataType> b = bidder_diagrams_max_[i].get(j);
-        dataType persistence = b.getPersistence();
+      const auto &diag = (*inputDiagramsMax_)[i];
+      const dataType *const birth = diag.birth.data();
+      const dataType *const death = diag.death.data();
+      for(size_t j = 0; j < diag.size(); j++) {
+        const dataType persistence = death[j] - birth[j];
         if(persistence >= min_persistence[2]
            && persistence <= previous_min_persistence[2]) {
           candidates_to_be_added_max[i].push_back(j);
@@ -40,6 +40,7 @@
 #include <limits>
 //
 #include <PDBarycenter.h>
+#include <PersistenceDiagramColumns.h>
 
 using namespace std;
 using namespace ttk;
@@ -66,7 +67,7 @@ namespace ttk {
     ~PersistenceDiagramBarycenter(){};
 
     void execute(
-      std::vector<std::vector<diagramTuple>> &intermediateDiagrams,
+      const std::vector<PersistenceDiagramColumns<dataType>> &inputDiagrams,
       std::vector<diagramTuple> &barycenter,
       std::vector<std::vector<std::vector<matchingTuple>>> &all_matchings);
 
@@ -166,7 +167,7 @@ namespace ttk {
 
   template <typename dataType>
   void PersistenceDiagramBarycenter<dataType>::execute(
-    std::vector<std::vector<diagramTuple>> &intermediateDiagrams,
+    const std::vector<PersistenceDiagramColumns<dataType>> &inputDiagrams,
     std::vector<diagramTuple> &barycenter,
     std::vector<std::vector<std::vector<matchingTuple>>> &all_matchings) {
 
@@ -175,9 +176,10 @@ namespace ttk {
       printMsg("Computing Barycenter of " + std::to_string(numberOfInputs_)
                + " diagrams.");
 
-      std::vector<std::vector<diagramTuple>> data_min(numberOfInputs_);
-      std::vector<std::vector<diagramTuple>> data_sad(numberOfInputs_);
-      std::vector<std::vector<diagramTuple>> data_max(numberOfInputs_);
+      using Columns = PersistenceDiagramColumns<dataType>;
+      std::vector<Columns> data_min(numberOfInputs_);
+      std::vector<Columns> data_sad(numberOfInputs_);
+      std::vector<Columns> data_max(numberOfInputs_);
 
       std::vector<std::vector<int>> data_min_idx(numberOfInputs_);
       std::vector<std::vector<int>> data_sad_idx(numberOfInputs_);
@@ -188,42 +190,31 @@ namespace ttk {
       bool do_max = false;
 
       // Create diagrams for min, saddle and max persistence pairs
+      std::vector<unsigned char> classes{};
       for(int i = 0; i < numberOfInputs_; i++) {
-        std::vector<diagramTuple> &CTDiagram = intermediateDiagrams[i];
+        const Columns &CTDiagram = inputDiagrams[i];
+        const dataType *const pers = CTDiagram.persistence.data();
 
+        CTDiagram.getPairClasses(classes);
         for(size_t j = 0; j < CTDiagram.size(); ++j) {
-          diagramTuple t = CTDiagram[j];
-
-          BNodeType nt1 = std::get<1>(t);
-          BNodeType nt2 = std::get<3>(t);
-
-          dataType dt = std::get<4>(t);
-          // if (abs<dataType>(dt) < zeroThresh) continue;
-          if(dt > 0) {
-            if(nt1 == BLocalMin && nt2 == BLocalMax) {
-              data_max[i].push_back(t);
+          if(pers[j] > 0) {
+            if(classes[j] & Columns::MAX_PAIR) {
               data_max_idx[i].push_back(j);
-              do_max = true;
-            } else {
-              if(nt1 == BLocalMax || nt2 == BLocalMax) {
-                data_max[i].push_back(t);
-                data_max_idx[i].push_back(j);
-                do_max = true;
-              }
-              if(nt1 == BLocalMin || nt2 == BLocalMin) {
-                data_min[i].push_back(t);
-                data_min_idx[i].push_back(j);
-                do_min = true;
-              }
-              if((nt1 == BSaddle1 && nt2 == BSaddle2)
-                 || (nt1 == BSaddle2 && nt2 == BSaddle1)) {
-                data_sad[i].push_back(t);
-                data_sad_idx[i].push_back(j);
-                do_sad = true;
-              }
+            }
+            if(classes[j] & Columns::MIN_PAIR) {
+              data_min_idx[i].push_back(j);
+            }
+            if(classes[j] & Columns::SADDLE_PAIR) {
+              data_sad_idx[i].push_back(j);
             }
           }
         }
+        do_min = do_min || !data_min_idx[i].empty();
+        do_sad = do_sad || !data_sad_idx[i].empty();
+        do_max = do_max || !data_max_idx[i].empty();
+        data_min[i].gather(CTDiagram, data_min_idx[i]);
+        data_sad[i].gather(CTDiagram, data_sad_idx[i]);
+        data_max[i].gather(CTDiagram, data_max_idx[i]);
       }
 
       std::vector<diagramTuple> barycenter_min;
@@ -406,20 +397,19 @@ namespace ttk {
       }
 
       for(unsigned i = 0; i < all_matchings[0].size(); i++) {
-        std::vector<diagramTuple> &CTDiagram = intermediateDiagrams[i];
+        const Columns &CTDiagram = inputDiagrams[i];
         for(unsigned j = 0; j < all_matchings[0][i].size(); j++) {
           matchingTuple t = all_matchings[0][i][j];
           int bidder_id = std::get<0>(t);
           int bary_id = std::get<1>(t);
 
-          diagramTuple &bidder = CTDiagram[bidder_id];
           number_of_matchings_for_point[bary_id] += 1;
-          cords_x1[bary_id] += std::get<7>(bidder);
-          cords_y1[bary_id] += std::get<8>(bidder);
-          cords_z1[bary_id] += std::get<9>(bidder);
-          cords_x2[bary_id] += std::get<11>(bidder);
-          cords_y2[bary_id] += std::get<12>(bidder);
-          cords_z2[bary_id] += std::get<13>(bidder);
+          cords_x1[bary_id] += CTDiagram.birthX[bidder_id];
+          cords_y1[bary_id] += CTDiagram.birthY[bidder_id];
+          cords_z1[bary_id] += CTDiagram.birthZ[bidder_id];
+          cords_x2[bary_id] += CTDiagram.deathX[bidder_id];
+          cords_y2[bary_id] += CTDiagram.deathY[bidder_id];
+          cords_z2[bary_id] += CTDiagram.deathZ[bidder_id];
         }
       }
 
@@ -44,6 +44,7 @@
 // #include <limits>
 //
 #include <PDClustering.h>
+#include <PersistenceDiagramColumns.h>
 //
 
 using namespace std;
@@ -62,7 +63,7 @@ namespace ttk {
 
     template <class dataType>
     std::vector<int> execute(
-      std::vector<std::vector<diagramTuple>> &intermediateDiagrams,
+      const std::vector<PersistenceDiagramColumns<dataType>> &inputDiagrams,
       std::vector<std::vector<diagramTuple>> &centroids,
       std::vector<std::vector<std::vector<matchingTuple>>> &all_matchings);
 
@@ -110,20 +111,21 @@ namespace ttk {
 
   template <class dataType>
   std::vector<int> PersistenceDiagramClustering::execute(
-    std::vector<std::vector<diagramTuple>> &intermediateDiagrams,
+    const std::vector<PersistenceDiagramColumns<dataType>> &inputDiagrams,
     std::vector<std::vector<diagramTuple>> &final_centroids,
     std::vector<std::vector<std::vector<matchingTuple>>> &all_matchings) {
 
-    const int numberOfInputs_ = intermediateDiagrams.size();
+    const int numberOfInputs_ = inputDiagrams.size();
     Timer tm;
     {
       printMsg("Clustering " + std::to_string(numberOfInputs_) + " diagrams in "
                + std::to_string(NumberOfClusters) + " cluster(s).");
     }
 
-    std::vector<std::vector<diagramTuple>> data_min(numberOfInputs_);
-    std::vector<std::vector<diagramTuple>> data_sad(numberOfInputs_);
-    std::vector<std::vector<diagramTuple>> data_max(numberOfInputs_);
+    using Columns = PersistenceDiagramColumns<dataType>;
+    std::vector<Columns> data_min(numberOfInputs_);
+    std::vector<Columns> data_sad(numberOfInputs_);
+    std::vector<Columns> data_max(numberOfInputs_);
 
     std::vector<std::vector<int>> data_min_idx(numberOfInputs_);
     std::vector<std::vector<int>> data_sad_idx(numberOfInputs_);
@@ -136,42 +138,31 @@ namespace ttk {
     bool do_max = false;
 
     // Create diagrams for min, saddle and max persistence pairs
+    std::vector<unsigned char> classes{};
     for(int i = 0; i < numberOfInputs_; i++) {
-      std::vector<diagramTuple> &CTDiagram = intermediateDiagrams[i];
+      const Columns &CTDiagram = inputDiagrams[i];
+      const dataType *const pers = CTDiagram.persistence.data();
 
+      CTDiagram.getPairClasses(classes);
       for(size_t j = 0; j < CTDiagram.size(); ++j) {
-        diagramTuple t = CTDiagram[j];
-
-        BNodeType nt1 = std::get<1>(t);
-        BNodeType nt2 = std::get<3>(t);
-
-        dataType dt = std::get<4>(t);
-        // if (abs<dataType>(dt) < zeroThresh) continue;
-        if(dt > 0) {
-          if(nt1 == BLocalMin && nt2 == BLocalMax) {
-            data_max[i].push_back(t);
+        if(pers[j] > 0) {
+          if(classes[j] & Columns::MAX_PAIR) {
             data_max_idx[i].push_back(j);
-            do_max = true;
-          } else {
-            if(nt1 == BLocalMax || nt2 == BLocalMax) {
-              data_max[i].push_back(t);
-              data_max_idx[i].push_back(j);
-              do_max = true;
-            }
-            if(nt1 == BLocalMin || nt2 == BLocalMin) {
-              data_min[i].push_back(t);
-              data_min_idx[i].push_back(j);
-              do_min = true;
-            }
-            if((nt1 == BSaddle1 && nt2 == BSaddle2)
-               || (nt1 == BSaddle2 && nt2 == BSaddle1)) {
-              data_sad[i].push_back(t);
-              data_sad_idx[i].push_back(j);
-              do_sad = true;
-            }
+          }
+          if(classes[j] & Columns::MIN_PAIR) {
+            data_min_idx[i].push_back(j);
+          }
+          if(classes[j] & Columns::SADDLE_PAIR) {
+            data_sad_idx[i].push_back(j);
           }
         }
       }
+      do_min = do_min || !data_min_idx[i].empty();
+      do_sad = do_sad || !data_sad_idx[i].empty();
+      do_max = do_max || !data_max_idx[i].empty();
+      data_min[i].gather(CTDiagram, data_min_idx[i]);
+      data_sad[i].gather(CTDiagram, data_sad_idx[i]);
+      data_max[i].gather(CTDiagram, data_max_idx[i]);
     }
 
     {
@@ -1,12 +1,26 @@
 #include <algorithm>
 
+#include <Geometry.h>
 #include <PersistenceDiagramDistanceMatrix.h>
 
 using namespace ttk;
 
 std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
   const std::vector<Diagram> &intermediateDiagrams,
-  const std::array<size_t, 2> &nInputs) const {
+  const std::array<size_t, 2> &nInputs,
+  const std::vector<std::vector<double>> &previousMatrix) const {
+
+  std::vector<DiagramColumns> diagrams(intermediateDiagrams.size());
+  for(size_t i = 0; i < diagrams.size(); ++i) {
+    diagrams[i].fromTuples(intermediateDiagrams[i]);
+  }
+  return this->execute(diagrams, nInputs, previousMatrix);
+}
+
+std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
+  const std::vector<DiagramColumns> &intermediateDiagrams,
+  const std::array<size_t, 2> &nInputs,
+  const std::vector<std::vector<double>> &previousMatrix) const {
 
   Timer tm{};
 
@@ -22,9 +36,12 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
     this->printMsg("Processing only SAD-MAX pairs");
   }
 
-  std::vector<Diagram> inputDiagramsMin(nDiags);
-  std::vector<Diagram> inputDiagramsSad(nDiags);
-  std::vector<Diagram> inputDiagramsMax(nDiags);
+  std::vector<DiagramColumns> inputDiagramsMin(nDiags);
+  std::vector<DiagramColumns> inputDiagramsSad(nDiags);
+  std::vector<DiagramColumns> inputDiagramsMax(nDiags);
+  std::vector<DiagramColumns> currentDiagramsMin{};
+  std::vector<DiagramColumns> currentDiagramsSad{};
+  std::vector<DiagramColumns> currentDiagramsMax{};
 
   std::vector<BidderDiagram<double>> bidder_diagrams_min{};
   std::vector<BidderDiagram<double>> bidder_diagrams_sad{};
@@ -38,38 +55,49 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
 
   // Create diagrams for min, saddle and max persistence pairs
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
+#pragma omp parallel num_threads(threadNumber_)
 #endif // TTK_ENABLE_OPENMP
-  for(size_t i = 0; i < nDiags; i++) {
-    const Diagram &CTDiagram = intermediateDiagrams[i];
-
-    for(size_t j = 0; j < CTDiagram.size(); ++j) {
-      const DiagramTuple &t = CTDiagram[j];
-      const ttk::CriticalType nt1 = std::get<1>(t);
-      const ttk::CriticalType nt2 = std::get<3>(t);
-      const double pers = std::get<4>(t);
-      maxDiagPersistence[i] = std::max(pers, maxDiagPersistence[i]);
-
-      if(pers > 0) {
-        if(nt1 == CriticalType::Local_minimum
-           && nt2 == CriticalType::Local_maximum) {
-          inputDiagramsMax[i].emplace_back(t);
-        } else {
-          if(nt1 == CriticalType::Local_maximum
-             || nt2 == CriticalType::Local_maximum) {
-            inputDiagramsMax[i].emplace_back(t);
+  {
+    std::vector<unsigned char> classes{};
+    std::vector<int> minIds{}, sadIds{}, maxIds{};
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < nDiags; i++) {
+      const DiagramColumns &CTDiagram = intermediateDiagrams[i];
+      const size_t n = CTDiagram.size();
+      const double *const pers = CTDiagram.persistence.data();
+
+      double maxPersistence{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(max : maxPersistence)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t j = 0; j < n; ++j) {
+        maxPersistence = std::max(pers[j], maxPersistence);
+      }
+      maxDiagPersistence[i] = maxPersistence;
+
+      CTDiagram.getPairClasses(classes);
+      minIds.clear();
+      sadIds.clear();
+      maxIds.clear();
+      for(size_t j = 0; j < n; ++j) {
+        if(pers[j] > 0) {
+          if(classes[j] & DiagramColumns::MAX_PAIR) {
+            maxIds.emplace_back(j);
           }
-          if(nt1 == CriticalType::Local_minimum
-             || nt2 == CriticalType::Local_minimum) {
-            inputDiagramsMin[i].emplace_back(t);
+          if(classes[j] & DiagramColumns::MIN_PAIR) {
+            minIds.emplace_back(j);
           }
-          if((nt1 == CriticalType::Saddle1 && nt2 == CriticalType::Saddle2)
-             || (nt1 == CriticalType::Saddle2
-                 && nt2 == CriticalType::Saddle1)) {
-            inputDiagramsSad[i].emplace_back(t);
+          if(classes[j] & DiagramColumns::SADDLE_PAIR) {
+            sadIds.emplace_back(j);
           }
         }
       }
+      inputDiagramsMin[i].gather(CTDiagram, minIds);
+      inputDiagramsSad[i].gather(CTDiagram, sadIds);
+      inputDiagramsMax[i].gather(CTDiagram, maxIds);
     }
   }
 
@@ -111,26 +139,81 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
       break;
   }
 
+  // check that the previous distance matrix can be reused
+  const std::vector<std::vector<double>> noPreviousMatrix{};
+  bool reusePrevious = !previousMatrix.empty();
+  if(reusePrevious) {
+    const auto nPrev = previousMatrix.size();
+    for(const auto &row : previousMatrix) {
+      reusePrevious = reusePrevious && row.size() == nPrev;
+    }
+    if(nInputs[1] != 0 || nPrev > nInputs[0] || !reusePrevious) {
+      this->printWrn("Previous distance matrix does not match the input");
+      reusePrevious = false;
+    } else if(this->Constraint == ConstraintType::NUMBER_PAIRS) {
+      // the selected pairs depend on every diagram
+      this->printWrn("Cannot reuse the previous distance matrix with a "
+                     "constraint on the number of pairs");
+      reusePrevious = false;
+    } else if(this->Constraint
+              == ConstraintType::RELATIVE_PERSISTENCE_GLOBAL) {
+      // the selected pairs of the previous diagrams only remain the same if
+      // the global maximal persistence did not change
+      const auto prevMax = *std::max_element(
+        maxDiagPersistence.begin(), maxDiagPersistence.begin() + nPrev);
+      const auto newMax = *std::max_element(
+        maxDiagPersistence.begin(), maxDiagPersistence.end());
+      reusePrevious = prevMax == newMax;
+    }
+    if(reusePrevious) {
+      this->printMsg("Reusing the distances between the first "
+                     + std::to_string(nPrev) + " diagrams");
+    }
+  }
+  const auto &previous = reusePrevious ? previousMatrix : noPreviousMatrix;
+
+  const auto computeDistMat
+    = [&](const std::vector<BidderDiagram<double>> &diags_min,
+          const std::vector<BidderDiagram<double>> &diags_sad,
+          const std::vector<BidderDiagram<double>> &diags_max,
+          const std::vector<DiagramColumns> &columns_min,
+          const std::vector<DiagramColumns> &columns_sad,
+          const std::vector<DiagramColumns> &columns_max,
+          std::vector<std::vector<double>> &distanceMatrix) {
+        if(this->NumberOfNearestNeighbors > 0) {
+          getDiagramsKNNDistMat(nInputs, distanceMatrix, diags_min, diags_sad,
+                                diags_max, columns_min, columns_sad,
+                                columns_max, previous);
+        } else {
+          getDiagramsDistMat(nInputs, distanceMatrix, diags_min, diags_sad,
+                             diags_max, previous);
+        }
+      };
+
   std::vector<std::vector<double>> distMat{};
   if(this->Constraint == ConstraintType::FULL_DIAGRAMS) {
-    getDiagramsDistMat(nInputs, distMat, bidder_diagrams_min,
-                       bidder_diagrams_sad, bidder_diagrams_max);
+    computeDistMat(bidder_diagrams_min, bidder_diagrams_sad,
+                   bidder_diagrams_max, inputDiagramsMin, inputDiagramsSad,
+                   inputDiagramsMax, distMat);
   } else {
     if(this->do_min_) {
-      enrichCurrentBidderDiagrams(
-        bidder_diagrams_min, current_bidder_diagrams_min, maxDiagPersistence);
+      enrichCurrentBidderDiagrams(bidder_diagrams_min, inputDiagramsMin,
+                                  current_bidder_diagrams_min,
+                                  currentDiagramsMin, maxDiagPersistence);
     }
     if(this->do_sad_) {
-      enrichCurrentBidderDiagrams(
-        bidder_diagrams_sad, current_bidder_diagrams_sad, maxDiagPersistence);
+      enrichCurrentBidderDiagrams(bidder_diagrams_sad, inputDiagramsSad,
+                                  current_bidder_diagrams_sad,
+                                  currentDiagramsSad, maxDiagPersistence);
     }
     if(this->do_max_) {
-      enrichCurrentBidderDiagrams(
-        bidder_diagrams_max, current_bidder_diagrams_max, maxDiagPersistence);
+      enrichCurrentBidderDiagrams(bidder_diagrams_max, inputDiagramsMax,
+                                  current_bidder_diagrams_max,
+                                  currentDiagramsMax, maxDiagPersistence);
     }
-    getDiagramsDistMat(nInputs, distMat, current_bidder_diagrams_min,
-                       current_bidder_diagrams_sad,
-                       current_bidder_diagrams_max);
+    computeDistMat(current_bidder_diagrams_min, current_bidder_diagrams_sad,
+                   current_bidder_diagrams_max, currentDiagramsMin,
+                   currentDiagramsSad, currentDiagramsMax, distMat);
   }
 
   this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
@@ -139,16 +222,18 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
 }
 
 double PersistenceDiagramDistanceMatrix::getMostPersistent(
-  const std::vector<BidderDiagram<double>> &bidder_diags) const {
+  const std::vector<DiagramColumns> &diags) const {
 
   double max_persistence = 0;
 
-  for(unsigned int i = 0; i < bidder_diags.size(); ++i) {
-    for(int j = 0; j < bidder_diags[i].size(); ++j) {
-      const double persistence = bidder_diags[i].get(j).getPersistence();
-      if(persistence > max_persistence) {
-        max_persistence = persistence;
-      }
+  for(const auto &diag : diags) {
+    const double *const birth = diag.birth.data();
+    const double *const death = diag.death.data();
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(max : max_persistence)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t j = 0; j < diag.size(); ++j) {
+      max_persistence = std::max(death[j] - birth[j], max_persistence);
     }
   }
 
@@ -178,9 +263,11 @@ void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
   std::vector<std::vector<double>> &distanceMatrix,
   const std::vector<BidderDiagram<double>> &diags_min,
   const std::vector<BidderDiagram<double>> &diags_sad,
-  const std::vector<BidderDiagram<double>> &diags_max) const {
+  const std::vector<BidderDiagram<double>> &diags_max,
+  const std::vector<std::vector<double>> &previousMatrix) const {
 
   distanceMatrix.resize(nInputs[0]);
+  const size_t nPrev = previousMatrix.size();
 
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for schedule(dynamic) num_threads(this->threadNumber_)
@@ -216,9 +303,11 @@ void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
     };
 
     if(nInputs[1] == 0) {
-      // square matrix: only compute the upper triangle (i < j < nInputs[0])
+      // square matrix: only compute the upper triangle (i < j < nInputs[0]),
+      // distances between previous diagrams are copied
       for(size_t j = i + 1; j < nInputs[0]; ++j) {
-        distanceMatrix[i][j] = getDist(i, j);
+        distanceMatrix[i][j]
+          = j < nPrev ? previousMatrix[i][j] : getDist(i, j);
       }
     } else {
       // rectangular matrix: compute the whole line/column (0 <= j < nInputs[1])
@@ -238,20 +327,377 @@ void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
   }
 }
 
+bool PersistenceDiagramDistanceMatrix::useDistanceBounds() const {
+  // the bounds hold for the Wasserstein distances between diagrams,
+  // without geometrical lifting (Alpha == 1)
+  return this->Wasserstein >= 1 && this->Alpha == 1.0;
+}
+
+void PersistenceDiagramDistanceMatrix::setDiagramBounds(
+  const std::vector<DiagramColumns> &diags,
+  std::vector<DiagramBounds> &bounds) const {
+
+  bounds.resize(diags.size());
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  {
+    std::vector<double> persistence{};
+    std::vector<int> order{};
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < diags.size(); ++i) {
+      const auto &diag = diags[i];
+      const size_t n = diag.size();
+      const double *const birth = diag.birth.data();
+      const double *const death = diag.death.data();
+      auto &b = bounds[i];
+
+      persistence.resize(n);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd
+#endif // TTK_ENABLE_OPENMP
+      for(size_t j = 0; j < n; ++j) {
+        persistence[j] = death[j] - birth[j];
+      }
+      order.resize(n);
+      for(size_t j = 0; j < n; ++j) {
+        order[j] = j;
+      }
+      std::sort(
+        order.begin(), order.end(), [&persistence](const int u, const int v) {
+          return persistence[u] > persistence[v];
+        });
+
+      b.persistence.resize(n);
+      b.birth.resize(n);
+      b.death.resize(n);
+      for(size_t j = 0; j < n; ++j) {
+        b.persistence[j] = persistence[order[j]];
+        b.birth[j] = birth[order[j]];
+        b.death[j] = death[order[j]];
+      }
+
+      const double *const sorted = b.persistence.data();
+      double diagonalCost{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(+ : diagonalCost)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t j = 0; j < n; ++j) {
+        diagonalCost += 2 * Geometry::pow(sorted[j] / 2, Wasserstein);
+      }
+      b.diagonalNorm = Geometry::pow(diagonalCost, 1.0 / Wasserstein);
+    }
+  }
+}
+
+double PersistenceDiagramDistanceMatrix::getNormLowerBound(
+  const DiagramBounds &B1, const DiagramBounds &B2) const {
+  // triangle inequality with the empty diagram
+  return Geometry::pow(
+    std::abs(B1.diagonalNorm - B2.diagonalNorm), this->Wasserstein);
+}
+
+double PersistenceDiagramDistanceMatrix::getSortedLowerBound(
+  const DiagramBounds &B1, const DiagramBounds &B2) const {
+  // the matching cost of two pairs is bounded below by the cost of matching
+  // their persistences in 1D (up to a 2^(1-p) factor), the optimal 1D
+  // matching being the sorted one (diagonal matches are zero persistences)
+  const int w = this->Wasserstein;
+  const size_t n1 = B1.persistence.size();
+  const size_t n2 = B2.persistence.size();
+  const size_t n = std::min(n1, n2);
+  const double *const p1 = B1.persistence.data();
+  const double *const p2 = B2.persistence.data();
+  // the pairs of the largest diagram matched to the diagonal
+  const double *const tail = n1 > n2 ? p1 : p2;
+  const size_t nTail = std::max(n1, n2);
+
+  double cost{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(+ : cost)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < n; ++i) {
+    cost += Geometry::pow(std::abs(p1[i] - p2[i]), w);
+  }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(+ : cost)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = n; i < nTail; ++i) {
+    cost += Geometry::pow(std::abs(tail[i]), w);
+  }
+  return cost * Geometry::pow(2.0, 1 - w);
+}
+
+double PersistenceDiagramDistanceMatrix::getUpperBound(
+  const DiagramBounds &B1, const DiagramBounds &B2) const {
+  // cost of the partial matching of the pairs with the same persistence
+  // rank, each pair being matched only if cheaper than projecting both on
+  // the diagonal
+  const int w = this->Wasserstein;
+  const size_t n1 = B1.persistence.size();
+  const size_t n2 = B2.persistence.size();
+  const size_t n = std::min(n1, n2);
+  const double *const p1 = B1.persistence.data();
+  const double *const p2 = B2.persistence.data();
+  const double *const b1 = B1.birth.data();
+  const double *const b2 = B2.birth.data();
+  const double *const d1 = B1.death.data();
+  const double *const d2 = B2.death.data();
+  const double *const tail = n1 > n2 ? p1 : p2;
+  const size_t nTail = std::max(n1, n2);
+
+  double cost{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(+ : cost)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < n; ++i) {
+    const double matched = Geometry::pow(std::abs(b1[i] - b2[i]), w)
+                           + Geometry::pow(std::abs(d1[i] - d2[i]), w);
+    const double diagonal = 2 * Geometry::pow(p1[i] / 2, w)
+                            + 2 * Geometry::pow(p2[i] / 2, w);
+    cost += std::min(matched, diagonal);
+  }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(+ : cost)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = n; i < nTail; ++i) {
+    cost += 2 * Geometry::pow(tail[i] / 2, w);
+  }
+  return cost;
+}
+
+void PersistenceDiagramDistanceMatrix::getDiagramsKNNDistMat(
+  const std::array<size_t, 2> &nInputs,
+  std::vector<std::vector<double>> &distanceMatrix,
+  const std::vector<BidderDiagram<double>> &diags_min,
+  const std::vector<BidderDiagram<double>> &diags_sad,
+  const std::vector<BidderDiagram<double>> &diags_max,
+  const std::vector<DiagramColumns> &columns_min,
+  const std::vector<DiagramColumns> &columns_sad,
+  const std::vector<DiagramColumns> &columns_max,
+  const std::vector<std::vector<double>> &previousMatrix) const {
+
+  const bool square = nInputs[1] == 0;
+  const size_t nRows = nInputs[0];
+  const size_t nCols = square ? nInputs[0] : nInputs[1];
+  // index of the first column diagram
+  const size_t offset = square ? 0 : nInputs[0];
+  const size_t nPrev = previousMatrix.size();
+  const size_t k = std::min(static_cast<size_t>(this->NumberOfNearestNeighbors),
+                            square ? nCols - 1 : nCols);
+  const auto inf = std::numeric_limits<double>::infinity();
+
+  distanceMatrix.assign(nRows, std::vector<double>(nCols, inf));
+
+  const bool useBounds = this->useDistanceBounds();
+  if(!useBounds) {
+    this->printWrn("Distance bounds need Alpha = 1 and a finite p: "
+                   "computing all the distances");
+  }
+
+  std::vector<DiagramBounds> bounds_min{}, bounds_sad{}, bounds_max{};
+  if(useBounds) {
+    if(this->do_min_) {
+      setDiagramBounds(columns_min, bounds_min);
+    }
+    if(this->do_sad_) {
+      setDiagramBounds(columns_sad, bounds_sad);
+    }
+    if(this->do_max_) {
+      setDiagramBounds(columns_max, bounds_max);
+    }
+  }
+
+  // sum the per-type bounds over the selected pair types
+  const auto lowerBound
+    = [&](const size_t a, const size_t b, const bool sorted) {
+        double res{};
+        const auto addBound = [&](const std::vector<DiagramBounds> &bounds) {
+          const double norm = this->getNormLowerBound(bounds[a], bounds[b]);
+          res += sorted ? std::max(norm, this->getSortedLowerBound(
+                                           bounds[a], bounds[b]))
+                        : norm;
+        };
+        if(this->do_min_) {
+          addBound(bounds_min);
+        }
+        if(this->do_sad_) {
+          addBound(bounds_sad);
+        }
+        if(this->do_max_) {
+          addBound(bounds_max);
+        }
+        return res;
+      };
+  const auto upperBound = [&](const size_t a, const size_t b) {
+    double res{};
+    if(this->do_min_) {
+      res += this->getUpperBound(bounds_min[a], bounds_min[b]);
+    }
+    if(this->do_sad_) {
+      res += this->getUpperBound(bounds_sad[a], bounds_sad[b]);
+    }
+    if(this->do_max_) {
+      res += this->getUpperBound(bounds_max[a], bounds_max[b]);
+    }
+    return res;
+  };
+
+  // (a, b) and (b, a) are computed in the same order to get the same value
+  const auto getDist = [&](size_t a, size_t b) -> double {
+    if(a > b) {
+      std::swap(a, b);
+    }
+    double distance{};
+    if(this->do_min_) {
+      distance += computeDistance(diags_min[a], diags_min[b]);
+    }
+    if(this->do_sad_) {
+      distance += computeDistance(diags_sad[a], diags_sad[b]);
+    }
+    if(this->do_max_) {
+      distance += computeDistance(diags_max[a], diags_max[b]);
+    }
+    return distance;
+  };
+
+  // an auction distance may exceed the optimal matching cost (hence the
+  // upper bounds) by this factor
+  const double slack
+    = Geometry::pow(1.0 + this->DeltaLim, this->Wasserstein) * (1.0 + 1e-9);
+
+  size_t nComputed{};
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber_) reduction(+ : nComputed)
+#endif // TTK_ENABLE_OPENMP
+  {
+    std::vector<double> lower(nCols);
+    std::vector<size_t> candidates{};
+    std::vector<double> upper{};
+    // max-heap of the k smallest distances of the current row
+    std::vector<double> best{};
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < nRows; ++i) {
+      auto &row = distanceMatrix[i];
+      if(square) {
+        row[i] = 0.0;
+      }
+      if(k == 0) {
+        continue;
+      }
+
+      // candidates sorted by (cheap) lower bound
+      candidates.clear();
+      for(size_t j = 0; j < nCols; ++j) {
+        if(!square || j != i) {
+          candidates.emplace_back(j);
+          lower[j] = useBounds ? lowerBound(i, j + offset, false) : 0.0;
+        }
+      }
+      std::sort(candidates.begin(), candidates.end(),
+                [&lower](const size_t a, const size_t b) {
+                  return lower[a] < lower[b] || (lower[a] == lower[b] && a < b);
+                });
+
+      // any k candidates bound the k-th smallest distance: use the smallest
+      // upper bounds among the most promising ones
+      double threshold = inf;
+      if(useBounds) {
+        const auto nProbes = std::min(candidates.size(), 2 * k);
+        upper.resize(nProbes);
+        for(size_t j = 0; j < nProbes; ++j) {
+          upper[j] = upperBound(i, candidates[j] + offset);
+        }
+        std::nth_element(upper.begin(), upper.begin() + k - 1, upper.end());
+        threshold = upper[k - 1] * slack;
+      }
+
+      best.clear();
+      for(const auto j : candidates) {
+        const double bound
+          = best.size() == k ? std::min(threshold, best.front()) : threshold;
+        if(lower[j] > bound) {
+          break; // the next candidates have larger lower bounds
+        }
+        if(useBounds && lowerBound(i, j + offset, true) > bound) {
+          continue;
+        }
+        // reuse a distance from the previous matrix or from row j
+        double distance{inf};
+        if(square && i < nPrev && j < nPrev) {
+          distance = previousMatrix[i][j];
+        }
+        if(square && distance == inf) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic read
+#endif // TTK_ENABLE_OPENMP
+          distance = distanceMatrix[j][i];
+        }
+        if(distance == inf) {
+          distance = getDist(i, j + offset);
+          nComputed++;
+          if(square) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic write
+#endif // TTK_ENABLE_OPENMP
+            distanceMatrix[j][i] = distance;
+          }
+        }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic write
+#endif // TTK_ENABLE_OPENMP
+        row[j] = distance;
+        best.emplace_back(distance);
+        std::push_heap(best.begin(), best.end());
+        if(best.size() > k) {
+          std::pop_heap(best.begin(), best.end());
+          best.pop_back();
+        }
+      }
+    }
+  }
+
+  if(square) {
+    // entries computed for row i or row j complete the symmetric matrix
+    for(size_t i = 0; i < nRows; ++i) {
+      for(size_t j = i + 1; j < nRows; ++j) {
+        const auto d = std::min(distanceMatrix[i][j], distanceMatrix[j][i]);
+        distanceMatrix[i][j] = d;
+        distanceMatrix[j][i] = d;
+      }
+    }
+  }
+
+  const auto nPairs = square ? nRows * (nRows - 1) / 2 : nRows * nCols;
+  this->printMsg("Computed " + std::to_string(nComputed) + " distances out of "
+                   + std::to_string(nPairs) + " for the "
+                   + std::to_string(k) + " nearest neighbors",
+                 debug::Priority::DETAIL);
+}
+
 void PersistenceDiagramDistanceMatrix::setBidderDiagrams(
   const size_t nInputs,
-  std::vector<Diagram> &inputDiagrams,
+  const std::vector<DiagramColumns> &inputDiagrams,
   std::vector<BidderDiagram<double>> &bidder_diags) const {
 
   bidder_diags.resize(nInputs);
 
   for(size_t i = 0; i < nInputs; i++) {
-    auto &diag = inputDiagrams[i];
+    const auto &diag = inputDiagrams[i];
     auto &bidders = bidder_diags[i];
 
     for(size_t j = 0; j < diag.size(); j++) {
       // Add bidder to bidders
-      Bidder<double> b(diag[j], j, this->Lambda);
+      auto t = diag.getTuple<DiagramTuple>(j);
+      Bidder<double> b(t, j, this->Lambda);
       b.setPositionInAuction(bidders.size());
       bidders.addBidder(b);
       if(b.isDiagonal() || b.x_ == b.y_) {
@@ -264,7 +710,9 @@ void PersistenceDiagramDistanceMatrix::setBidderDiagrams(
 
 void PersistenceDiagramDistanceMatrix::enrichCurrentBidderDiagrams(
   const std::vector<BidderDiagram<double>> &bidder_diags,
+  const std::vector<DiagramColumns> &diags,
   std::vector<BidderDiagram<double>> &current_bidder_diags,
+  std::vector<DiagramColumns> &current_diags,
   const std::vector<double> &maxDiagPersistence) const {
 
   current_bidder_diags.resize(bidder_diags.size());
@@ -272,34 +720,48 @@ void PersistenceDiagramDistanceMatrix::enrichCurrentBidderDiagrams(
   const auto maxPersistence
     = *std::max_element(maxDiagPersistence.begin(), maxDiagPersistence.end());
 
+  // pairs of the current diagrams
+  std::vector<std::vector<int>> selected(nInputs);
+  const auto addPair = [&](const size_t i, const int j) {
+    auto b = bidder_diags[i].get(j);
+    b.id_ = current_bidder_diags[i].size();
+    b.setPositionInAuction(current_bidder_diags[i].size());
+    current_bidder_diags[i].addBidder(b);
+    selected[i].emplace_back(j);
+  };
+  const auto setCurrentDiagrams = [&]() {
+    current_diags.resize(nInputs);
+    for(size_t i = 0; i < nInputs; ++i) {
+      current_diags[i].gather(diags[i], selected[i]);
+    }
+  };
+
   if(this->Constraint == ConstraintType::ABSOLUTE_PERSISTENCE
      || this->Constraint == ConstraintType::RELATIVE_PERSISTENCE_PER_DIAG
      || this->Constraint == ConstraintType::RELATIVE_PERSISTENCE_GLOBAL) {
     for(size_t i = 0; i < nInputs; ++i) {
-      for(int j = 0; j < bidder_diags[i].size(); ++j) {
-        auto b = bidder_diags[i].get(j);
-
-        if( // filter out pairs below absolute persistence threshold
-          (this->Constraint == ConstraintType::ABSOLUTE_PERSISTENCE
-           && b.getPersistence() > this->MinPersistence)
-          || // filter out pairs below persistence threshold relative to
-          // the most persistent pair *of each diagrams*
-          (this->Constraint == ConstraintType::RELATIVE_PERSISTENCE_PER_DIAG
-           && b.getPersistence() > this->MinPersistence * maxDiagPersistence[i])
-          || // filter out pairs below persistence threshold relative to the
-             // most persistence pair *in all diagrams*
-          (this->Constraint == ConstraintType::RELATIVE_PERSISTENCE_GLOBAL
-           && b.getPersistence() > this->MinPersistence * maxPersistence)) {
-          b.id_ = current_bidder_diags[i].size();
-          b.setPositionInAuction(current_bidder_diags[i].size());
-          current_bidder_diags[i].addBidder(b);
+      // filter out pairs below absolute persistence threshold, below
+      // persistence threshold relative to the most persistent pair *of
+      // each diagrams* or *in all diagrams*
+      const double threshold
+        = this->Constraint == ConstraintType::ABSOLUTE_PERSISTENCE
+            ? this->MinPersistence
+          : this->Constraint == ConstraintType::RELATIVE_PERSISTENCE_PER_DIAG
+            ? this->MinPersistence * maxDiagPersistence[i]
+            : this->MinPersistence * maxPersistence;
+      const double *const birth = diags[i].birth.data();
+      const double *const death = diags[i].death.data();
+      for(size_t j = 0; j < diags[i].size(); ++j) {
+        if(death[j] - birth[j] > threshold) {
+          addPair(i, j);
         }
       }
     }
+    setCurrentDiagrams();
     return;
   }
 
-  const double prev_min_persistence = 2.0 * getMostPersistent(bidder_diags);
+  const double prev_min_persistence = 2.0 * getMostPersistent(diags);
   double new_min_persistence = 0.0;
 
   // 1. Get size of the largest current diagram, deduce the maximal number
@@ -318,9 +780,10 @@ void PersistenceDiagramDistanceMatrix::enrichCurrentBidderDiagrams(
   for(size_t i = 0; i < nInputs; i++) {
     double local_min_persistence = std::numeric_limits<double>::min();
     std::vector<double> persistences;
-    for(int j = 0; j < bidder_diags[i].size(); j++) {
-      Bidder<double> b = bidder_diags[i].get(j);
-      double persistence = b.getPersistence();
+    const double *const birth = diags[i].birth.data();
+    const double *const death = diags[i].death.data();
+    for(size_t j = 0; j < diags[i].size(); j++) {
+      const double persistence = death[j] - birth[j];
       if(persistence >= 0.0 && persistence <= prev_min_persistence) {
         candidates_to_be_added[i].emplace_back(j);
         idx[i].emplace_back(idx[i].size());
@@ -350,14 +813,11 @@ void PersistenceDiagramDistanceMatrix::enrichCurrentBidderDiagrams(
     // 3. Add the points to the current diagrams
     const auto s = candidates_to_be_added[i].size();
     for(size_t j = 0; j < std::min(max_points_to_add, s); j++) {
-      Bidder<double> b
-        = bidder_diags[i].get(candidates_to_be_added[i][idx[i][j]]);
-      const double persistence = b.getPersistence();
+      const double persistence = persistences[idx[i][j]];
       if(persistence >= new_min_persistence) {
-        b.id_ = current_bidder_diags[i].size();
-        b.setPositionInAuction(current_bidder_diags[i].size());
-        current_bidder_diags[i].addBidder(b);
+        addPair(i, candidates_to_be_added[i][idx[i][j]]);
       }
     }
   }
+  setCurrentDiagrams();
 }
@@ -10,6 +10,14 @@
 /// Proc. of IEEE VIS 2019.\n
 /// IEEE Transactions on Visualization and Computer Graphics, 2019.
 ///
+/// When a number of nearest neighbors is set, only the distances to the k
+/// nearest diagrams of every row are computed: cheap lower bounds
+/// (total persistence difference, persistence-sorted 1D matching) and upper
+/// bounds (persistence-sorted partial matching) prune the other auction
+/// computations. A square distance matrix computed on a prefix of the input
+/// diagrams can also be passed to only compute the rows of the appended
+/// diagrams.
+///
 /// \sa PersistenceDiagramClustering
 
 #pragma once
@@ -18,6 +26,7 @@
 #include <limits>
 
 #include <PersistenceDiagramAuction.h>
+#include <PersistenceDiagramColumns.h>
 #include <Wrapper.h>
 
 namespace ttk {
@@ -51,6 +60,7 @@ namespace ttk {
     float>;
 
   using Diagram = std::vector<DiagramTuple>;
+  using DiagramColumns = PersistenceDiagramColumns<double>;
 
   class PersistenceDiagramDistanceMatrix : virtual public Debug {
 
@@ -59,9 +69,24 @@ namespace ttk {
       this->setDebugMsgPrefix("PersistenceDiagramDistanceMatrix");
     }
 
+    /// Compute the distance matrix between the input diagrams.
+    ///
+    /// \p previousMatrix optionally holds the square distance matrix of the
+    /// first previousMatrix.size() diagrams, computed with the same
+    /// parameters: only the distances involving the other diagrams are then
+    /// computed (square matrices only).
+    std::vector<std::vector<double>>
+      execute(const std::vector<DiagramColumns> &intermediateDiagrams,
+              const std::array<size_t, 2> &nInputs,
+              const std::vector<std::vector<double>> &previousMatrix
+              = {}) const;
+
+    /// Tuple diagrams, converted to columns.
     std::vector<std::vector<double>>
       execute(const std::vector<Diagram> &intermediateDiagrams,
-              const std::array<size_t, 2> &nInputs) const;
+              const std::array<size_t, 2> &nInputs,
+              const std::vector<std::vector<double>> &previousMatrix
+              = {}) const;
 
     inline void setWasserstein(const int data) {
       Wasserstein = data;
@@ -86,6 +111,12 @@ namespace ttk {
     inline void setMinPersistence(const double data) {
       MinPersistence = data;
     }
+    /// Only compute the distances to the k nearest diagrams of each row
+    /// (0: compute the whole matrix). The other entries are set to
+    /// infinity.
+    inline void setNumberOfNearestNeighbors(const int data) {
+      NumberOfNearestNeighbors = data;
+    }
     inline void setConstraint(const int data) {
       if(data == 0) {
         this->Constraint = ConstraintType::FULL_DIAGRAMS;
@@ -101,8 +132,17 @@ namespace ttk {
     }
 
   protected:
-    double getMostPersistent(
-      const std::vector<BidderDiagram<double>> &bidder_diags) const;
+    /// Per-diagram data for the distance bounds
+    struct DiagramBounds {
+      /// persistence, birth and death of the pairs, by decreasing
+      /// persistence
+      std::vector<double> persistence{}, birth{}, death{};
+      /// distance to the empty diagram (p-th root of the cost of matching
+      /// every pair to the diagonal)
+      double diagonalNorm{};
+    };
+
+    double getMostPersistent(const std::vector<DiagramColumns> &diags) const;
     double computeDistance(const BidderDiagram<double> &D1,
                            const BidderDiagram<double> &D2) const;
     void getDiagramsDistMat(
@@ -110,14 +150,38 @@ namespace ttk {
       std::vector<std::vector<double>> &distanceMatrix,
       const std::vector<BidderDiagram<double>> &diags_min,
       const std::vector<BidderDiagram<double>> &diags_sad,
-      const std::vector<BidderDiagram<double>> &diags_max) const;
+      const std::vector<BidderDiagram<double>> &diags_max,
+      const std::vector<std::vector<double>> &previousMatrix) const;
+    void getDiagramsKNNDistMat(
+      const std::array<size_t, 2> &nInputs,
+      std::vector<std::vector<double>> &distanceMatrix,
+      const std::vector<BidderDiagram<double>> &diags_min,
+      const std::vector<BidderDiagram<double>> &diags_sad,
+      const std::vector<BidderDiagram<double>> &diags_max,
+      const std::vector<DiagramColumns> &columns_min,
+      const std::vector<DiagramColumns> &columns_sad,
+      const std::vector<DiagramColumns> &columns_max,
+      const std::vector<std::vector<double>> &previousMatrix) const;
+    bool useDistanceBounds() const;
+    void setDiagramBounds(const std::vector<DiagramColumns> &diags,
+                          std::vector<DiagramBounds> &bounds) const;
+    double getNormLowerBound(const DiagramBounds &B1,
+                             const DiagramBounds &B2) const;
+    double getSortedLowerBound(const DiagramBounds &B1,
+                               const DiagramBounds &B2) const;
+    double getUpperBound(const DiagramBounds &B1,
+                         const DiagramBounds &B2) const;
     void
       setBidderDiagrams(const size_t nInputs,
-                        std::vector<Diagram> &inputDiagrams,
+                        const std::vector<DiagramColumns> &inputDiagrams,
                         std::vector<BidderDiagram<double>> &bidder_diags) const;
+    /// Select the pairs of the current diagrams (bidders and columns)
+    /// according to the constraint.
     void enrichCurrentBidderDiagrams(
       const std::vector<BidderDiagram<double>> &bidder_diags,
+      const std::vector<DiagramColumns> &diags,
       std::vector<BidderDiagram<double>> &current_bidder_diags,
+      std::vector<DiagramColumns> &current_diags,
       const std::vector<double> &maxDiagPersistence) const;
 
     int Wasserstein{2};
@@ -131,6 +195,7 @@ namespace ttk {
     double Lambda;
     size_t MaxNumberOfPairs{20};
     double MinPersistence{0.1};
+    int NumberOfNearestNeighbors{0};
     bool do_min_{true}, do_sad_{true}, do_max_{true};
 
     enum class ConstraintType {
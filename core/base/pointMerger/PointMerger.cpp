@@ -0,0 +1,5 @@
+#include <PointMerger.h>
+
+ttk::PointMerger::PointMerger() {
+  this->setDebugMsgPrefix("PointMerger");
+}
@@ -0,0 +1,332 @@
+/// \ingroup base
+/// \class ttk::PointMerger
+/// \date October 2021.
+///
+/// \brief Merge the points of a point set closer than a distance threshold.
+///
+/// Groups of points are the connected components of the graph linking
+/// the points closer than the threshold. Close points are found on a
+/// uniform grid of cells at least as large as the threshold: the points
+/// are sorted by the Morton code of their cell and only the points of
+/// neighboring cells are compared. Groups are tracked with a
+/// ttk::ConcurrentUnionFind, each group being represented by its smallest
+/// point.
+///
+/// \sa ttkPointMerger
+
+#pragma once
+
+#include <Debug.h>
+#include <Geometry.h>
+#include <OrderDisambiguation.h>
+#include <UnionFind.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace ttk {
+
+  class PointMerger : virtual public Debug {
+
+  public:
+    PointMerger();
+
+    /**
+     * @brief Merge the candidate points closer than the threshold
+     *
+     * @param[in] coords point coordinates (3 per point)
+     * @param[in] nPoints number of points
+     * @param[in] candidates points that can be merged, by increasing
+     * identifier
+     * @param[in] threshold distance threshold
+     * @param[out] old2new input point -> merged point
+     * @param[out] new2old merged point -> representative input point
+     * @param[out] mergeCount merged point -> number of input points in its
+     * group (0 if not merged)
+     * @param[out] minMergeDistance merged point -> minimal distance
+     * between the representative and the other points of the group (-1 if
+     * not merged)
+     * @param[out] maxMergeDistance merged point -> maximal distance
+     * @return 0 in case of success
+     */
+    template <typename T>
+    int mergePoints(const T *const coords,
+                    const SimplexId nPoints,
+                    const std::vector<SimplexId> &candidates,
+                    const double threshold,
+                    std::vector<SimplexId> &old2new,
+                    std::vector<SimplexId> &new2old,
+                    std::vector<SimplexId> &mergeCount,
+                    std::vector<double> &minMergeDistance,
+                    std::vector<double> &maxMergeDistance) const;
+
+  protected:
+    /**
+     * @brief Compute the groups of close candidates (candidate -> smallest
+     * candidate of its group)
+     */
+    template <typename T>
+    void computeGroups(const T *const coords,
+                       const std::vector<SimplexId> &candidates,
+                       const double threshold,
+                       std::vector<SimplexId> &groups) const;
+
+    /**
+     * @brief Interleave the bits of three 21-bit cell coordinates
+     */
+    static inline uint64_t mortonCode(const uint64_t x,
+                                      const uint64_t y,
+                                      const uint64_t z) {
+      const auto spread = [](uint64_t v) {
+        v &= 0x1FFFFF;
+        v = (v | v << 32) & 0x1F00000000FFFF;
+        v = (v | v << 16) & 0x1F0000FF0000FF;
+        v = (v | v << 8) & 0x100F00F00F00F00F;
+        v = (v | v << 4) & 0x10C30C30C30C30C3;
+        v = (v | v << 2) & 0x1249249249249249;
+        return v;
+      };
+      return spread(x) | spread(y) << 1 | spread(z) << 2;
+    }
+  };
+
+} // namespace ttk
+
+template <typename T>
+void ttk::PointMerger::computeGroups(const T *const coords,
+                                     const std::vector<SimplexId> &candidates,
+                                     const double threshold,
+                                     std::vector<SimplexId> &groups) const {
+
+  const SimplexId n = candidates.size();
+  const auto point = [&](const SimplexId i) {
+    const auto p = &coords[3 * static_cast<size_t>(candidates[i])];
+    return std::array<double, 3>{static_cast<double>(p[0]),
+                                 static_cast<double>(p[1]),
+                                 static_cast<double>(p[2])};
+  };
+
+  // 1. bounding box of the candidates
+  double x0{std::numeric_limits<double>::max()}, y0{x0}, z0{x0};
+  double x1{std::numeric_limits<double>::lowest()}, y1{x1}, z1{x1};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) \
+  reduction(min : x0, y0, z0) reduction(max : x1, y1, z1)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < n; i++) {
+    const auto p = point(i);
+    x0 = std::min(x0, p[0]);
+    y0 = std::min(y0, p[1]);
+    z0 = std::min(z0, p[2]);
+    x1 = std::max(x1, p[0]);
+    y1 = std::max(y1, p[1]);
+    z1 = std::max(z1, p[2]);
+  }
+
+  // 2. cells at least as large as the threshold, and small enough to
+  // have 21-bit coordinates
+  const double maxExtent = std::max({x1 - x0, y1 - y0, z1 - z0});
+  const double cellSize = std::max(threshold, maxExtent / ((1 << 21) - 2));
+  const auto cellCoords = [&](const std::array<double, 3> &p) {
+    return std::array<uint64_t, 3>{
+      static_cast<uint64_t>((p[0] - x0) / cellSize),
+      static_cast<uint64_t>((p[1] - y0) / cellSize),
+      static_cast<uint64_t>((p[2] - z0) / cellSize)};
+  };
+
+  // 3. sort the candidates by cell
+  VertexSortBuffers buffers{};
+  buffers.keys.resize(n);
+  buffers.values.resize(n);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < n; i++) {
+    const auto c = cellCoords(point(i));
+    buffers.keys[i] = mortonCode(c[0], c[1], c[2]);
+    buffers.values[i] = i;
+  }
+  radixSortPairs(sizeof(uint64_t), buffers, threadNumber_);
+  const auto &keys = buffers.keys;
+  const auto &sorted = buffers.values;
+
+  // non-empty cells: key and range in the sorted candidates
+  std::vector<uint64_t> cellKeys{};
+  std::vector<SimplexId> cellBegin{};
+  for(SimplexId i = 0; i < n; i++) {
+    if(i == 0 || keys[i] != keys[i - 1]) {
+      cellKeys.emplace_back(keys[i]);
+      cellBegin.emplace_back(i);
+    }
+  }
+  cellBegin.emplace_back(n);
+  const SimplexId nCells = cellKeys.size();
+
+  // 4. compare the points of every cell with the points of the same cell
+  // and of the 13 neighboring cells in the positive half-space (each pair
+  // of cells is processed once)
+  std::vector<std::array<int, 3>> stencil{};
+  for(int dz = 0; dz <= 1; dz++) {
+    for(int dy = -1; dy <= 1; dy++) {
+      for(int dx = -1; dx <= 1; dx++) {
+        if(dz > 0 || dy > 0 || (dy == 0 && dx > 0)) {
+          stencil.push_back({dx, dy, dz});
+        }
+      }
+    }
+  }
+
+  // lock-free, the root of a set is its smallest element
+  ConcurrentUnionFind sets(n);
+
+  const auto mergeIfClose = [&](const SimplexId i, const SimplexId j) {
+    const auto p0 = point(i);
+    const auto p1 = point(j);
+    if(Geometry::distance(p0.data(), p1.data()) < threshold) {
+      sets.merge(i, j);
+    }
+  };
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId c = 0; c < nCells; c++) {
+    const SimplexId begin = cellBegin[c];
+    const SimplexId end = cellBegin[c + 1];
+    for(SimplexId i = begin; i < end; i++) {
+      for(SimplexId j = i + 1; j < end; j++) {
+        mergeIfClose(sorted[i], sorted[j]);
+      }
+    }
+
+    const auto cc = cellCoords(point(sorted[begin]));
+    for(const auto &s : stencil) {
+      if((s[0] < 0 && cc[0] == 0) || (s[1] < 0 && cc[1] == 0)) {
+        continue;
+      }
+      const auto key = mortonCode(cc[0] + s[0], cc[1] + s[1], cc[2] + s[2]);
+      const auto it = std::lower_bound(cellKeys.begin(), cellKeys.end(), key);
+      if(it == cellKeys.end() || *it != key) {
+        continue;
+      }
+      const SimplexId nc = it - cellKeys.begin();
+      for(SimplexId i = begin; i < end; i++) {
+        for(SimplexId j = cellBegin[nc]; j < cellBegin[nc + 1]; j++) {
+          mergeIfClose(sorted[i], sorted[j]);
+        }
+      }
+    }
+  }
+
+  groups.resize(n);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < n; i++) {
+    groups[i] = sets.find(i);
+  }
+}
+
+template <typename T>
+int ttk::PointMerger::mergePoints(const T *const coords,
+                                  const SimplexId nPoints,
+                                  const std::vector<SimplexId> &candidates,
+                                  const double threshold,
+                                  std::vector<SimplexId> &old2new,
+                                  std::vector<SimplexId> &new2old,
+                                  std::vector<SimplexId> &mergeCount,
+                                  std::vector<double> &minMergeDistance,
+                                  std::vector<double> &maxMergeDistance) const {
+
+  Timer tm{};
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(coords == nullptr && nPoints > 0) {
+    this->printErr("Invalid input coordinates");
+    return -1;
+  }
+#endif // TTK_ENABLE_KAMIKAZE
+
+  this->printMsg("Computing pointwise distances with "
+                   + std::to_string(candidates.size()) + " candidates",
+                 debug::Priority::DETAIL);
+
+  // candidate -> smallest candidate of its group
+  std::vector<SimplexId> groups{};
+  if(threshold > 0) {
+    this->computeGroups(coords, candidates, threshold, groups);
+  } else {
+    groups.resize(candidates.size());
+    for(size_t i = 0; i < groups.size(); i++) {
+      groups[i] = i;
+    }
+  }
+
+  // input point -> representative input point
+  std::vector<SimplexId> mergeMap(nPoints);
+  std::vector<double> distances(candidates.size());
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < nPoints; i++) {
+    mergeMap[i] = i;
+  }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < candidates.size(); i++) {
+    const auto v = candidates[i];
+    const auto rep = candidates[groups[i]];
+    mergeMap[v] = rep;
+    if(v != rep) {
+      std::array<double, 3> p0{}, p1{};
+      for(int j = 0; j < 3; j++) {
+        p0[j] = coords[3 * static_cast<size_t>(v) + j];
+        p1[j] = coords[3 * static_cast<size_t>(rep) + j];
+      }
+      distances[i] = Geometry::distance(p0.data(), p1.data());
+    }
+  }
+
+  // merged points
+  old2new.resize(nPoints);
+  new2old.clear();
+  for(SimplexId i = 0; i < nPoints; i++) {
+    if(mergeMap[i] == i) {
+      old2new[i] = new2old.size();
+      new2old.emplace_back(i);
+    } else {
+      // representatives have smaller identifiers
+      old2new[i] = old2new[mergeMap[i]];
+    }
+  }
+
+  const size_t nNew = new2old.size();
+  mergeCount.assign(nNew, 0);
+  minMergeDistance.assign(nNew, -1);
+  maxMergeDistance.assign(nNew, -1);
+  for(size_t i = 0; i < candidates.size(); i++) {
+    const auto v = candidates[i];
+    const auto rep = candidates[groups[i]];
+    if(v == rep) {
+      continue;
+    }
+    const auto id = old2new[rep];
+    // representative counted with its first merged point
+    mergeCount[id] += mergeCount[id] == 0 ? 2 : 1;
+    if(minMergeDistance[id] == -1 || distances[i] < minMergeDistance[id]) {
+      minMergeDistance[id] = distances[i];
+    }
+    if(maxMergeDistance[id] == -1 || distances[i] > maxMergeDistance[id]) {
+      maxMergeDistance[id] = distances[i];
+    }
+  }
+
+  this->printMsg("Merged " + std::to_string(nPoints) + " points into "
+                   + std::to_string(nNew),
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
@@ -1,3 +1,4 @@
+#include <ImplicitGridStencil.h>
 #include <ScalarFieldCriticalPoints.h>
 
 ttk::ScalarFieldCriticalPoints::ScalarFieldCriticalPoints() {
@@ -90,14 +91,8 @@ char ttk::ScalarFieldCriticalPoints::getCriticalType(
   // now enumerate the connected components of the lower and upper links
   // NOTE: a breadth first search might be faster than a UF
   // if so, one would need the one-skeleton data structure, not the edge list
-  std::vector<UnionFind> lowerSeeds(lowerCount);
-  std::vector<UnionFind> upperSeeds(upperCount);
-  std::vector<UnionFind *> lowerList(lowerCount);
-  std::vector<UnionFind *> upperList(upperCount);
-  for(SimplexId i = 0; i < (SimplexId)lowerList.size(); i++)
-    lowerList[i] = &(lowerSeeds[i]);
-  for(SimplexId i = 0; i < (SimplexId)upperList.size(); i++)
-    upperList[i] = &(upperSeeds[i]);
+  SmallUnionFind<> lowerSets(lowerCount);
+  SmallUnionFind<> upperSets(upperCount);
 
   for(SimplexId i = 0; i < (SimplexId)vertexLink.size(); i++) {
 
@@ -114,9 +109,7 @@ char ttk::ScalarFieldCriticalPoints::getCriticalType(
       std::map<SimplexId, SimplexId>::iterator n1It
         = global2LowerLink.find(neighborId1);
 
-      lowerList[n0It->second] = UnionFind::makeUnion(
-        lowerList[n0It->second], lowerList[n1It->second]);
-      lowerList[n1It->second] = lowerList[n0It->second];
+      lowerSets.merge(n0It->second, n1It->second);
     }
 
     // process the upper link
@@ -129,42 +122,27 @@ char ttk::ScalarFieldCriticalPoints::getCriticalType(
       std::map<SimplexId, SimplexId>::iterator n1It
         = global2UpperLink.find(neighborId1);
 
-      upperList[n0It->second] = UnionFind::makeUnion(
-        upperList[n0It->second], upperList[n1It->second]);
-      upperList[n1It->second] = upperList[n0It->second];
+      upperSets.merge(n0It->second, n1It->second);
     }
   }
 
-  // let's remove duplicates
-  std::vector<UnionFind *>::iterator it;
-  // update the UFs if necessary
-  for(SimplexId i = 0; i < (SimplexId)lowerList.size(); i++)
-    lowerList[i] = lowerList[i]->find();
-  for(SimplexId i = 0; i < (SimplexId)upperList.size(); i++)
-    upperList[i] = upperList[i]->find();
-
-  sort(lowerList.begin(), lowerList.end());
-  it = unique(lowerList.begin(), lowerList.end());
-  lowerList.resize(distance(lowerList.begin(), it));
-
-  sort(upperList.begin(), upperList.end());
-  it = unique(upperList.begin(), upperList.end());
-  upperList.resize(distance(upperList.begin(), it));
+  const SimplexId lowerComponentNumber = lowerSets.getNumberOfSets();
+  const SimplexId upperComponentNumber = upperSets.getNumberOfSets();
 
   if(debugLevel_ >= (int)(debug::Priority::VERBOSE)) {
     printMsg("Vertex #" + std::to_string(vertexId)
-               + ": lowerLink-#CC=" + std::to_string(lowerList.size())
-               + " upperLink-#CC=" + std::to_string(upperList.size()),
+               + ": lowerLink-#CC=" + std::to_string(lowerComponentNumber)
+               + " upperLink-#CC=" + std::to_string(upperComponentNumber),
              debug::Priority::VERBOSE);
   }
 
-  if((lowerList.size() == 1) && (upperList.size() == 1))
+  if((lowerComponentNumber == 1) && (upperComponentNumber == 1))
     // regular point
     return (char)(CriticalType::Regular);
   else {
     // saddles
     if(dimension_ == 2) {
-      if((lowerList.size() > 2) || (upperList.size() > 2)) {
+      if((lowerComponentNumber > 2) || (upperComponentNumber > 2)) {
         // monkey saddle
         return (char)(CriticalType::Degenerate);
       } else {
@@ -176,9 +154,9 @@ char ttk::ScalarFieldCriticalPoints::getCriticalType(
         // boundary from interior vertices
       }
     } else if(dimension_ == 3) {
-      if((lowerList.size() == 2) && (upperList.size() == 1)) {
+      if((lowerComponentNumber == 2) && (upperComponentNumber == 1)) {
         return (char)(CriticalType::Saddle1);
-      } else if((lowerList.size() == 1) && (upperList.size() == 2)) {
+      } else if((lowerComponentNumber == 1) && (upperComponentNumber == 2)) {
         return (char)(CriticalType::Saddle2);
       } else {
         // monkey saddle
@@ -192,6 +170,279 @@ char ttk::ScalarFieldCriticalPoints::getCriticalType(
   return (char)(CriticalType::Regular);
 }
 
+char ttk::ScalarFieldCriticalPoints::getCriticalTypeFromValences(
+  const int dimension,
+  const SimplexId downValence,
+  const SimplexId upValence) {
+
+  if(downValence == 0 && upValence == 1) {
+    return (char)(CriticalType::Local_minimum);
+  } else if(downValence == 1 && upValence == 0) {
+    return (char)(CriticalType::Local_maximum);
+  } else if(downValence == 1 && upValence == 1) {
+    // regular point
+    return (char)(CriticalType::Regular);
+  } else {
+    // saddles
+    if(dimension == 2) {
+      if((downValence == 2 && upValence == 1)
+         || (downValence == 1 && upValence == 2)
+         || (downValence == 2 && upValence == 2)) {
+        // regular saddle
+        return (char)(CriticalType::Saddle1);
+      } else {
+        // monkey saddle, saddle + extremum
+        return (char)(CriticalType::Degenerate);
+        // NOTE: you may have multi-saddles on the boundary in that
+        // configuration
+        // to make this computation 100% correct, one would need to
+        // disambiguate boundary from interior vertices
+      }
+    } else if(dimension == 3) {
+      if(downValence == 2 && upValence == 1) {
+        return (char)(CriticalType::Saddle1);
+      } else if(downValence == 1 && upValence == 2) {
+        return (char)(CriticalType::Saddle2);
+      } else {
+        // monkey saddle, saddle + extremum
+        return (char)(CriticalType::Degenerate);
+        // NOTE: we may have a similar effect in 3D (TODO)
+      }
+    }
+  }
+
+  // -2: regular points
+  return (char)(CriticalType::Regular);
+}
+
+template <size_t dim>
+void ttk::ScalarFieldCriticalPoints::getGridVertexLink(
+  const std::array<int, dim> &position,
+  int &neighborMask,
+  std::vector<std::pair<int, int>> &linkEdges) {
+
+  using Stencil = ImplicitGridStencil<dim>;
+  const auto &neighbors = Stencil::vertexNeighbors();
+
+  neighborMask = 0;
+  for(size_t i = 0; i < neighbors.size(); i++) {
+    bool isInside = true;
+    for(size_t j = 0; j < dim; j++) {
+      isInside &= neighbors[i][j] * position[j] <= 0;
+    }
+    neighborMask |= isInside << i;
+  }
+
+  // link edges, from the cells of the (up to 2^dim) voxels around the
+  // vertex
+  linkEdges.clear();
+  for(int voxel = 0; voxel < (1 << dim); voxel++) {
+    // the voxel spans [-1, 0] (bit j set) or [0, 1] along axis j
+    bool isInside = true;
+    for(size_t j = 0; j < dim; j++) {
+      isInside &= position[j] != (((voxel >> j) & 1) ? -1 : 1);
+    }
+    if(!isInside) {
+      continue;
+    }
+    for(const auto &cell : Stencil::cellVertices()) {
+      // stencil ids of the cell vertices (-1 for the vertex itself)
+      std::array<int, dim + 1> ids{};
+      bool isInStar = false;
+      for(size_t i = 0; i < dim + 1; i++) {
+        std::array<int, dim> p{};
+        for(size_t j = 0; j < dim; j++) {
+          p[j] = ((cell[i] >> j) & 1) - ((voxel >> j) & 1);
+        }
+        if(p == std::array<int, dim>{}) {
+          ids[i] = -1;
+          isInStar = true;
+        } else {
+          ids[i] = std::find(neighbors.begin(), neighbors.end(), p)
+                   - neighbors.begin();
+        }
+      }
+      if(!isInStar) {
+        continue;
+      }
+      for(size_t i = 0; i < dim + 1; i++) {
+        for(size_t j = i + 1; j < dim + 1; j++) {
+          if(ids[i] != -1 && ids[j] != -1) {
+            linkEdges.emplace_back(ids[i], ids[j]);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <size_t dim>
+char ttk::ScalarFieldCriticalPoints::getGridCriticalType(
+  const int lowerMask,
+  const int neighborMask,
+  const std::vector<std::pair<int, int>> &linkEdges) {
+
+  constexpr int neighborNumber = ImplicitGridStencil<dim>::vertexNeighborNumber;
+
+  // connect the link edges with both vertices lower or upper
+  SmallUnionFind<neighborNumber> sets(neighborNumber);
+  for(const auto &e : linkEdges) {
+    if(((lowerMask >> e.first) & 1) == ((lowerMask >> e.second) & 1)) {
+      sets.merge(e.first, e.second);
+    }
+  }
+
+  SimplexId downValence = 0, upValence = 0;
+  for(int i = 0; i < neighborNumber; i++) {
+    if(((neighborMask >> i) & 1) && sets.find(i) == i) {
+      if((lowerMask >> i) & 1) {
+        downValence++;
+      } else {
+        upValence++;
+      }
+    }
+  }
+
+  return getCriticalTypeFromValences(dim, downValence, upValence);
+}
+
+template <size_t dim>
+std::vector<char>
+  ttk::ScalarFieldCriticalPoints::computeGridCriticalTypeTable() {
+
+  int neighborMask{};
+  std::vector<std::pair<int, int>> linkEdges;
+  getGridVertexLink<dim>({}, neighborMask, linkEdges);
+
+  std::vector<char> types(neighborMask + 1);
+  for(size_t i = 0; i < types.size(); i++) {
+    types[i] = getGridCriticalType<dim>(i, neighborMask, linkEdges);
+  }
+
+  return types;
+}
+
+const std::vector<char> &
+  ttk::ScalarFieldCriticalPoints::getGridCriticalTypeTable(
+    const int dimension) {
+
+  // computed on first use
+  static const std::vector<char> types2D = computeGridCriticalTypeTable<2>();
+  static const std::vector<char> types3D = computeGridCriticalTypeTable<3>();
+
+  return dimension == 2 ? types2D : types3D;
+}
+
+void ttk::ScalarFieldCriticalPoints::computeGridCriticalTypes(
+  const SimplexId *const offsets,
+  const std::array<SimplexId, 3> &dimensions,
+  std::vector<char> &vertexTypes) const {
+
+  if(dimensions[2] > 1) {
+    this->computeGridCriticalTypes<3>(offsets, dimensions, vertexTypes);
+  } else {
+    this->computeGridCriticalTypes<2>(offsets, dimensions, vertexTypes);
+  }
+}
+
+template <size_t dim>
+void ttk::ScalarFieldCriticalPoints::computeGridCriticalTypes(
+  const SimplexId *const offsets,
+  const std::array<SimplexId, 3> &dimensions,
+  std::vector<char> &vertexTypes) const {
+
+  constexpr int neighborNumber = ImplicitGridStencil<dim>::vertexNeighborNumber;
+  const char *const types = getGridCriticalTypeTable(dim).data();
+
+  // vertex id shifts of the stencil neighbors
+  const auto &neighbors = ImplicitGridStencil<dim>::vertexNeighbors();
+  const SimplexId strides[3]
+    = {1, dimensions[0], dimensions[0] * dimensions[1]};
+  std::array<SimplexId, neighborNumber> shifts{};
+  for(int i = 0; i < neighborNumber; i++) {
+    for(size_t j = 0; j < dim; j++) {
+      shifts[i] += neighbors[i][j] * strides[j];
+    }
+  }
+
+  // links of the boundary vertices, indexed by their position along each
+  // axis (see getGridVertexLink())
+  constexpr int positionNumber = dim == 3 ? 27 : 9;
+  std::array<int, positionNumber> neighborMasks{};
+  std::array<std::vector<std::pair<int, int>>, positionNumber> linkEdges{};
+  for(int i = 0; i < positionNumber; i++) {
+    std::array<int, dim> position{};
+    for(size_t j = 0, k = i; j < dim; j++, k /= 3) {
+      position[j] = k % 3 - 1;
+    }
+    getGridVertexLink<dim>(position, neighborMasks[i], linkEdges[i]);
+  }
+
+  // position along an axis of n vertices
+  const auto axisPosition = [](const SimplexId x, const SimplexId n) {
+    return x == 0 ? 0 : (x == n - 1 ? 2 : 1);
+  };
+
+  const SimplexId rowLength = dimensions[0];
+  const SimplexId rowNumber = dimensions[1] * dimensions[2];
+  // the masks of a row are computed by blocks, with vectorized comparisons
+  constexpr SimplexId blockSize = 256;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId r = 0; r < rowNumber; r++) {
+    const SimplexId begin = r * rowLength;
+    const SimplexId end = begin + rowLength - 1;
+    const int rowPosition
+      = 3 * axisPosition(r % dimensions[1], dimensions[1])
+        + 9 * (dim == 3 ? axisPosition(r / dimensions[1], dimensions[2]) : 0);
+
+    // boundary vertices
+    const auto classifyBoundary = [&](const SimplexId v) {
+      const int position = rowPosition + axisPosition(v - begin, rowLength);
+      const int neighborMask = neighborMasks[position];
+      int lowerMask = 0;
+      for(int k = 0; k < neighborNumber; k++) {
+        if(((neighborMask >> k) & 1) && offsets[v + shifts[k]] < offsets[v]) {
+          lowerMask |= 1 << k;
+        }
+      }
+      vertexTypes[v] = getGridCriticalType<dim>(
+        lowerMask, neighborMask, linkEdges[position]);
+    };
+
+    if(rowPosition != 3 + (dim == 3 ? 9 : 0) || rowLength < 3) {
+      for(SimplexId v = begin; v <= end; v++) {
+        classifyBoundary(v);
+      }
+      continue;
+    }
+    classifyBoundary(begin);
+    classifyBoundary(end);
+
+    // interior vertices
+    std::array<uint16_t, blockSize> masks;
+    for(SimplexId i = begin + 1; i < end; i += blockSize) {
+      const SimplexId *const block = offsets + i;
+      const SimplexId n = std::min(blockSize, end - i);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd
+#endif // TTK_ENABLE_OPENMP
+      for(SimplexId j = 0; j < n; j++) {
+        int mask = 0;
+        for(int k = 0; k < neighborNumber; k++) {
+          mask |= (block[j + shifts[k]] < block[j]) << k;
+        }
+        masks[j] = mask;
+      }
+      for(SimplexId j = 0; j < n; j++) {
+        vertexTypes[i + j] = types[masks[j]];
+      }
+    }
+  }
+}
+
 void ttk::ScalarFieldCriticalPoints::displayStats() {
 
   SimplexId minimumNumber = 0, maximumNumber = 0, saddleNumber = 0,
@@ -23,10 +23,17 @@
 /// Jules Vidal, Pierre Guillou, Julien Tierny\n
 /// IEEE Transactions on Visualization and Computer Graphics, 2021
 ///
+/// On implicit triangulations, the generic backend does not query the
+/// triangulation: the interior vertices of the grid, which all share the
+/// same link, are classified with a lookup table indexed by the mask of
+/// their lower neighbors, and the boundary vertices with the precomputed
+/// link of their boundary configuration.
+///
 /// \sa ttkScalarFieldCriticalPoints.cpp %for a usage example.
 
 #pragma once
 
+#include <array>
 #include <map>
 
 // base code includes
@@ -86,6 +93,18 @@ namespace ttk {
                          const std::vector<std::pair<SimplexId, SimplexId>>
                            &vertexLinkEdgeList) const;
 
+    /// Critical type of a vertex from the number of connected components
+    /// of its lower and upper links.
+    static char getCriticalTypeFromValences(const int dimension,
+                                            const SimplexId downValence,
+                                            const SimplexId upValence);
+
+    /// Critical types of the interior vertices of 2D or 3D implicit grids,
+    /// indexed by the mask of their lower neighbors (bit i set if the i-th
+    /// neighbor of ImplicitGridStencil::vertexNeighbors() is lower).
+    static const std::vector<char> &
+      getGridCriticalTypeTable(const int dimension);
+
     inline void setDomainDimension(const int &dimension) {
       dimension_ = dimension;
     }
@@ -128,6 +147,55 @@ namespace ttk {
     void displayStats();
 
   protected:
+    /// Classifies the vertices of a 2D or 3D implicit grid, of dimensions
+    /// the number of vertices along its non-flat axes.
+    void computeGridCriticalTypes(const SimplexId *const offsets,
+                                  const std::array<SimplexId, 3> &dimensions,
+                                  std::vector<char> &vertexTypes) const;
+
+    template <size_t dim>
+    void computeGridCriticalTypes(const SimplexId *const offsets,
+                                  const std::array<SimplexId, 3> &dimensions,
+                                  std::vector<char> &vertexTypes) const;
+
+    /// Link of a vertex of a 2D or 3D implicit grid, given its position
+    /// along each axis (-1: first vertex, 1: last vertex, 0: inside): mask
+    /// of the stencil neighbors inside the grid and edges between them.
+    template <size_t dim>
+    static void getGridVertexLink(const std::array<int, dim> &position,
+                                  int &neighborMask,
+                                  std::vector<std::pair<int, int>> &linkEdges);
+
+    /// Critical type of a grid vertex from the mask of its lower neighbors.
+    template <size_t dim>
+    static char
+      getGridCriticalType(const int lowerMask,
+                          const int neighborMask,
+                          const std::vector<std::pair<int, int>> &linkEdges);
+
+    template <size_t dim>
+    static std::vector<char> computeGridCriticalTypeTable();
+
+    /// Fills the number of vertices along the non-flat axes of implicit
+    /// grids (returns false for other triangulations or 1D grids).
+    static inline bool
+      getImplicitGridDimensions(const ImplicitTriangulation *triangulation,
+                                std::array<SimplexId, 3> &dimensions) {
+      int dimensionality = 0;
+      dimensions = {1, 1, 1};
+      for(const auto n : triangulation->getGridDimensions()) {
+        if(n > 1) {
+          dimensions[dimensionality++] = n;
+        }
+      }
+      return dimensionality >= 2;
+    }
+
+    static inline bool getImplicitGridDimensions(const void *,
+                                                 std::array<SimplexId, 3> &) {
+      return false;
+    }
+
     int dimension_{};
     SimplexId vertexNumber_{};
     const std::vector<std::vector<std::pair<SimplexId, SimplexId>>>
@@ -217,7 +285,12 @@ int ttk::ScalarFieldCriticalPoints::executeLegacy(
 
   std::vector<char> vertexTypes(vertexNumber_);
 
-  if(triangulation) {
+  std::array<SimplexId, 3> gridDimensions{};
+
+  if(triangulation
+     && getImplicitGridDimensions(triangulation, gridDimensions)) {
+    computeGridCriticalTypes(offsets, gridDimensions, vertexTypes);
+  } else if(triangulation) {
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
 #endif
@@ -357,17 +430,8 @@ std::pair<ttk::SimplexId, ttk::SimplexId>
   }
 
   // now do the actual work
-  std::vector<UnionFind> lowerSeeds(lowerNeighbors.size());
-  std::vector<UnionFind *> lowerList(lowerNeighbors.size());
-  std::vector<UnionFind> upperSeeds(upperNeighbors.size());
-  std::vector<UnionFind *> upperList(upperNeighbors.size());
-
-  for(SimplexId i = 0; i < (SimplexId)lowerSeeds.size(); i++) {
-    lowerList[i] = &(lowerSeeds[i]);
-  }
-  for(SimplexId i = 0; i < (SimplexId)upperSeeds.size(); i++) {
-    upperList[i] = &(upperSeeds[i]);
-  }
+  SmallUnionFind<> lowerSets(lowerNeighbors.size());
+  SmallUnionFind<> upperSets(upperNeighbors.size());
 
   SimplexId vertexStarSize = triangulation->getVertexStarNumber(vertexId);
 
@@ -396,11 +460,11 @@ std::pair<ttk::SimplexId, ttk::SimplexId>
             bool lower1 = offsets[neighborId1] < offsets[vertexId];
 
             std::vector<SimplexId> *neighbors = &lowerNeighbors;
-            std::vector<UnionFind *> *seeds = &lowerList;
+            SmallUnionFind<> *sets = &lowerSets;
 
             if(!lower0) {
               neighbors = &upperNeighbors;
-              seeds = &upperList;
+              sets = &upperSets;
             }
 
             if(lower0 == lower1) {
@@ -415,9 +479,7 @@ std::pair<ttk::SimplexId, ttk::SimplexId>
                 }
               }
               if((lowerId0 != -1) && (lowerId1 != -1)) {
-                (*seeds)[lowerId0] = UnionFind::makeUnion(
-                  (*seeds)[lowerId0], (*seeds)[lowerId1]);
-                (*seeds)[lowerId1] = (*seeds)[lowerId0];
+                sets->merge(lowerId0, lowerId1);
               }
             }
           }
@@ -426,31 +488,17 @@ std::pair<ttk::SimplexId, ttk::SimplexId>
     }
   }
 
-  // let's remove duplicates now
-
-  // update the UF if necessary
-  for(SimplexId i = 0; i < (SimplexId)lowerList.size(); i++)
-    lowerList[i] = lowerList[i]->find();
-  for(SimplexId i = 0; i < (SimplexId)upperList.size(); i++)
-    upperList[i] = upperList[i]->find();
-
-  std::vector<UnionFind *>::iterator it;
-  std::sort(lowerList.begin(), lowerList.end());
-  it = unique(lowerList.begin(), lowerList.end());
-  lowerList.resize(distance(lowerList.begin(), it));
-
-  std::sort(upperList.begin(), upperList.end());
-  it = unique(upperList.begin(), upperList.end());
-  upperList.resize(distance(upperList.begin(), it));
+  const SimplexId lowerComponentNumber = lowerSets.getNumberOfSets();
+  const SimplexId upperComponentNumber = upperSets.getNumberOfSets();
 
   if(debugLevel_ >= (int)(debug::Priority::VERBOSE)) {
     printMsg("Vertex #" + std::to_string(vertexId)
-               + ": lowerLink-#CC=" + std::to_string(lowerList.size())
-               + " upperLink-#CC=" + std::to_string(upperList.size()),
+               + ": lowerLink-#CC=" + std::to_string(lowerComponentNumber)
+               + " upperLink-#CC=" + std::to_string(upperComponentNumber),
              debug::Priority::VERBOSE);
   }
 
-  return std::make_pair(lowerList.size(), upperList.size());
+  return std::make_pair(lowerComponentNumber, upperComponentNumber);
 }
 
 template <class triangulationType>
@@ -463,51 +511,15 @@ char ttk::ScalarFieldCriticalPoints::getCriticalType(
   std::tie(downValence, upValence)
     = getNumberOfLowerUpperComponents(vertexId, offsets, triangulation);
 
-  if(downValence == 0 && upValence == 1) {
-    return (char)(CriticalType::Local_minimum);
-  } else if(downValence == 1 && upValence == 0) {
-    return (char)(CriticalType::Local_maximum);
-  } else if(downValence == 1 && upValence == 1) {
-    // regular point
-    return (char)(CriticalType::Regular);
-  } else {
-    // saddles
-    if(dimension_ == 2) {
-      if((downValence == 2 && upValence == 1)
-         || (downValence == 1 && upValence == 2)
-         || (downValence == 2 && upValence == 2)) {
-        // regular saddle
-        return (char)(CriticalType::Saddle1);
-      } else {
-        // monkey saddle, saddle + extremum
-        return (char)(CriticalType::Degenerate);
-        // NOTE: you may have multi-saddles on the boundary in that
-        // configuration
-        // to make this computation 100% correct, one would need to
-        // disambiguate boundary from interior vertices
-      }
-    } else if(dimension_ == 3) {
-      if(downValence == 2 && upValence == 1) {
-        return (char)(CriticalType::Saddle1);
-      } else if(downValence == 1 && upValence == 2) {
-        return (char)(CriticalType::Saddle2);
-      } else {
-        // monkey saddle, saddle + extremum
-        return (char)(CriticalType::Degenerate);
-        // NOTE: we may have a similar effect in 3D (TODO)
-      }
-    }
-  }
-
-  // -2: regular points
-  return (char)(CriticalType::Regular);
+  return getCriticalTypeFromValences(dimension_, downValence, upValence);
 }
 
 template <class triangulationType>
 void ttk::ScalarFieldCriticalPoints::checkProgressivityRequirement(
   const triangulationType *triangulation) {
   if(BackEnd == BACKEND::PROGRESSIVE_TOPOLOGY) {
-    if(!std::is_same<triangulationType, ttk::ImplicitTriangulation>::value) {
+    if(!std::is_base_of<ttk::ImplicitTriangulation,
+                        triangulationType>::value) {
 
       printWrn("Explicit triangulation detected.");
       printWrn("Defaulting to the generic backend.");
@@ -9,6 +9,11 @@
 /// smooths an input scalar field by averaging the scalar values on the link
 /// of each vertex.
 ///
+/// The vertex neighbors are extracted once: in a CSR graph with vertices
+/// renumbered in reverse Cuthill-McKee order for generic triangulations, or
+/// as a constant stencil for the interior vertices of implicit grids. The
+/// iterations then run on two ping-pong buffers.
+///
 /// \param dataType Data type of the input scalar field (char, float,
 /// etc.).
 ///
@@ -17,8 +22,13 @@
 #pragma once
 
 // base code includes
+#include <FlatJaggedArray.h>
 #include <Triangulation.h>
 
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
 namespace ttk {
 
   class ScalarFieldSmoother : virtual public Debug {
@@ -61,6 +71,79 @@ namespace ttk {
                const int &numberOfIterations) const;
 
   protected:
+    /**
+     * @brief Average the values of the neighbors of a vertex
+     *
+     * @param[in] nComp compile-time number of components (0: use
+     * dimensionNumber_)
+     * @param[in] neighbor functor returning the k-th neighbor of @p v
+     */
+    template <typename dataType, int nComp, typename neighborFunc>
+    inline void averageNeighbors(const dataType *const in,
+                                 dataType *const out,
+                                 const SimplexId v,
+                                 const SimplexId neighborNumber,
+                                 const neighborFunc &neighbor) const;
+
+    /**
+     * @brief Run the smoothing iterations on two ping-pong buffers
+     *
+     * @param[in] kernel functor smoothing one vertex from a buffer
+     * into the other one
+     * @return buffer holding the result (@p first or @p second)
+     */
+    template <typename dataType, typename kernelType>
+    dataType *pingPong(const SimplexId vertexNumber,
+                       const int numberOfIterations,
+                       const char *const mask,
+                       dataType *const first,
+                       dataType *const second,
+                       const kernelType &kernel,
+                       Timer &t) const;
+
+    /**
+     * @brief Compute a reverse Cuthill-McKee vertex ordering
+     *
+     * @param[out] order new vertex id -> old vertex id
+     */
+    template <class triangulationType>
+    void reverseCuthillMcKee(const triangulationType *triangulation,
+                             std::vector<SimplexId> &order) const;
+
+    /**
+     * @brief Select the smoothing path on the triangulation type
+     *
+     * The implicit grids (including their specializations on the grid
+     * dimension) use the constant stencil path, the other triangulations
+     * the CSR graph path.
+     */
+    template <class dataType, int nComp, class triangulationType>
+    int smoothComponents(const triangulationType *triangulation,
+                         const int numberOfIterations,
+                         Timer &t) const {
+      return this->smoothComponents<dataType, nComp>(
+        triangulation, numberOfIterations, t,
+        std::is_base_of<ImplicitTriangulation, triangulationType>{});
+    }
+
+    /**
+     * @brief Generic path: renumbered CSR neighbor graph
+     */
+    template <class dataType, int nComp, class triangulationType>
+    int smoothComponents(const triangulationType *triangulation,
+                         const int numberOfIterations,
+                         Timer &t,
+                         std::false_type isImplicitGrid) const;
+
+    /**
+     * @brief Implicit grids: constant stencil on interior vertices
+     */
+    template <class dataType, int nComp, class triangulationType>
+    int smoothComponents(const triangulationType *triangulation,
+                         const int numberOfIterations,
+                         Timer &t,
+                         std::true_type isImplicitGrid) const;
+
     int dimensionNumber_{1};
     void *inputData_{nullptr}, *outputData_{nullptr};
     char *mask_{nullptr};
@@ -88,21 +171,85 @@ int ttk::ScalarFieldSmoother::smooth(const triangulationType *triangulation,
 
   SimplexId vertexNumber = triangulation->getNumberOfVertices();
 
-  std::vector<dataType> tmpData(vertexNumber * dimensionNumber_, 0);
+  printMsg("Smoothing " + std::to_string(vertexNumber) + " vertices", 0, 0,
+           threadNumber_, ttk::debug::LineMode::REPLACE);
 
-  dataType *outputData = (dataType *)outputData_;
-  dataType *inputData = (dataType *)inputData_;
+  // compile-time number of components for the most common cases
+  switch(dimensionNumber_) {
+    case 1:
+      this->smoothComponents<dataType, 1>(triangulation, numberOfIterations, t);
+      break;
+    case 2:
+      this->smoothComponents<dataType, 2>(triangulation, numberOfIterations, t);
+      break;
+    case 3:
+      this->smoothComponents<dataType, 3>(triangulation, numberOfIterations, t);
+      break;
+    case 4:
+      this->smoothComponents<dataType, 4>(triangulation, numberOfIterations, t);
+      break;
+    default:
+      this->smoothComponents<dataType, 0>(triangulation, numberOfIterations, t);
+      break;
+  }
 
-  // init the output
-  for(SimplexId i = 0; i < vertexNumber; i++) {
-    for(int j = 0; j < dimensionNumber_; j++) {
-      outputData[dimensionNumber_ * i + j]
-        = inputData[dimensionNumber_ * i + j];
+  printMsg("Smoothed " + std::to_string(vertexNumber) + " vertices", 1,
+           t.getElapsedTime(), threadNumber_);
+
+  return 0;
+}
+
+template <typename dataType, int nComp, typename neighborFunc>
+inline void ttk::ScalarFieldSmoother::averageNeighbors(
+  const dataType *const in,
+  dataType *const out,
+  const SimplexId v,
+  const SimplexId neighborNumber,
+  const neighborFunc &neighbor) const {
+
+  if(nComp > 0) {
+    // fixed-size accumulator, unrolled & vectorized by the compiler
+    std::array<dataType, (nComp > 0 ? nComp : 1)> acc{};
+    for(SimplexId k = 0; k < neighborNumber; k++) {
+      const dataType *const src = in + static_cast<size_t>(nComp) * neighbor(k);
+      for(int j = 0; j < nComp; j++) {
+        acc[j] += src[j];
+      }
     }
+    dataType *const dst = out + static_cast<size_t>(nComp) * v;
+    for(int j = 0; j < nComp; j++) {
+      dst[j] = acc[j];
+      dst[j] /= ((double)neighborNumber);
+    }
+    return;
   }
 
-  printMsg("Smoothing " + std::to_string(vertexNumber) + " vertices", 0, 0,
-           threadNumber_, ttk::debug::LineMode::REPLACE);
+  const size_t nc = dimensionNumber_;
+  dataType *const dst = out + nc * v;
+  std::fill(dst, dst + nc, 0);
+  for(SimplexId k = 0; k < neighborNumber; k++) {
+    const dataType *const src = in + nc * neighbor(k);
+    for(size_t j = 0; j < nc; j++) {
+      dst[j] += src[j];
+    }
+  }
+  for(size_t j = 0; j < nc; j++) {
+    dst[j] /= ((double)neighborNumber);
+  }
+}
+
+template <typename dataType, typename kernelType>
+dataType *ttk::ScalarFieldSmoother::pingPong(const SimplexId vertexNumber,
+                                             const int numberOfIterations,
+                                             const char *const mask,
+                                             dataType *const first,
+                                             dataType *const second,
+                                             const kernelType &kernel,
+                                             Timer &t) const {
+
+  const size_t nc = dimensionNumber_;
+  dataType *cur = first;
+  dataType *next = second;
 
   int timeBuckets = 10;
   if(numberOfIterations < timeBuckets)
@@ -111,39 +258,16 @@ int ttk::ScalarFieldSmoother::smooth(const triangulationType *triangulation,
   for(int it = 0; it < numberOfIterations; it++) {
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
-#endif
+#endif // TTK_ENABLE_OPENMP
     for(SimplexId i = 0; i < vertexNumber; i++) {
-
-      // avoid to process masked vertices
-      if(mask_ != nullptr && mask_[i] == 0)
-        continue;
-
-      for(int j = 0; j < dimensionNumber_; j++) {
-        tmpData[dimensionNumber_ * i + j] = 0;
-
-        SimplexId neighborNumber = triangulation->getVertexNeighborNumber(i);
-        for(SimplexId k = 0; k < neighborNumber; k++) {
-          SimplexId neighborId = -1;
-          triangulation->getVertexNeighbor(i, k, neighborId);
-          tmpData[dimensionNumber_ * i + j]
-            += outputData[dimensionNumber_ * (neighborId) + j];
-        }
-        tmpData[dimensionNumber_ * i + j] /= ((double)neighborNumber);
-      }
-    }
-
-    if(numberOfIterations) {
-      // assign the tmpData back to the output
-      for(SimplexId i = 0; i < vertexNumber; i++) {
-        for(int j = 0; j < dimensionNumber_; j++) {
-          // only set value for unmasked points
-          if(mask_ == nullptr || mask_[i] != 0) {
-            outputData[dimensionNumber_ * i + j]
-              = tmpData[dimensionNumber_ * i + j];
-          }
-        }
+      if(mask != nullptr && mask[i] == 0) {
+        // masked vertices keep their value
+        std::copy(cur + nc * i, cur + nc * (i + 1), next + nc * i);
+      } else {
+        kernel(i, cur, next);
       }
     }
+    std::swap(cur, next);
 
     if(debugLevel_ >= (int)(debug::Priority::INFO)) {
       if(!(it % ((numberOfIterations) / timeBuckets))) {
@@ -154,8 +278,211 @@ int ttk::ScalarFieldSmoother::smooth(const triangulationType *triangulation,
     }
   }
 
-  printMsg("Smoothed " + std::to_string(vertexNumber) + " vertices", 1,
-           t.getElapsedTime(), threadNumber_);
+  return cur;
+}
+
+template <class triangulationType>
+void ttk::ScalarFieldSmoother::reverseCuthillMcKee(
+  const triangulationType *triangulation, std::vector<SimplexId> &order) const {
+
+  const SimplexId vertexNumber = triangulation->getNumberOfVertices();
+  order.clear();
+  order.reserve(vertexNumber);
+
+  std::vector<bool> visited(vertexNumber, false);
+  std::vector<std::pair<SimplexId, SimplexId>> neighbors{};
+
+  // breadth-first traversal of every connected component, neighbors
+  // visited by increasing degree
+  for(SimplexId root = 0; root < vertexNumber; root++) {
+    if(visited[root]) {
+      continue;
+    }
+    visited[root] = true;
+    size_t head = order.size();
+    order.emplace_back(root);
+    while(head < order.size()) {
+      const SimplexId v = order[head++];
+      neighbors.clear();
+      const SimplexId neighborNumber
+        = triangulation->getVertexNeighborNumber(v);
+      for(SimplexId k = 0; k < neighborNumber; k++) {
+        SimplexId n{-1};
+        triangulation->getVertexNeighbor(v, k, n);
+        if(!visited[n]) {
+          visited[n] = true;
+          neighbors.emplace_back(triangulation->getVertexNeighborNumber(n), n);
+        }
+      }
+      std::sort(neighbors.begin(), neighbors.end());
+      for(const auto &n : neighbors) {
+        order.emplace_back(n.second);
+      }
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+}
+
+template <class dataType, int nComp, class triangulationType>
+int ttk::ScalarFieldSmoother::smoothComponents(
+  const triangulationType *triangulation,
+  const int numberOfIterations,
+  Timer &t,
+  std::false_type) const {
+
+  const SimplexId vertexNumber = triangulation->getNumberOfVertices();
+  const size_t nc = dimensionNumber_;
+  dataType *outputData = (dataType *)outputData_;
+  dataType *inputData = (dataType *)inputData_;
+
+  // renumber the vertices for memory locality
+  std::vector<SimplexId> newToOld{};
+  this->reverseCuthillMcKee(triangulation, newToOld);
+  std::vector<SimplexId> oldToNew(vertexNumber);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber; i++) {
+    oldToNew[newToOld[i]] = i;
+  }
+
+  // extract the neighbor graph (new identifiers)
+  std::vector<SimplexId> offsets(vertexNumber + 1);
+  for(SimplexId i = 0; i < vertexNumber; i++) {
+    offsets[i + 1]
+      = offsets[i] + triangulation->getVertexNeighborNumber(newToOld[i]);
+  }
+  std::vector<SimplexId> neighbors(offsets.back());
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber; i++) {
+    for(SimplexId k = 0; k < offsets[i + 1] - offsets[i]; k++) {
+      SimplexId n{-1};
+      triangulation->getVertexNeighbor(newToOld[i], k, n);
+      neighbors[offsets[i] + k] = oldToNew[n];
+    }
+  }
+  FlatJaggedArray graph{};
+  graph.setData(std::move(neighbors), std::move(offsets));
+
+  // renumbered input & mask
+  std::vector<dataType> first(nc * vertexNumber), second(nc * vertexNumber);
+  std::vector<char> mask{};
+  if(mask_ != nullptr) {
+    mask.resize(vertexNumber);
+  }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber; i++) {
+    const auto src = inputData + nc * newToOld[i];
+    std::copy(src, src + nc, &first[nc * i]);
+    if(mask_ != nullptr) {
+      mask[i] = mask_[newToOld[i]];
+    }
+  }
+
+  const auto kernel
+    = [this, &graph](const SimplexId v, const dataType *in, dataType *out) {
+        const SimplexId *const n = graph.get_ptr(v, 0);
+        this->averageNeighbors<dataType, nComp>(
+          in, out, v, graph.size(v), [n](const SimplexId k) { return n[k]; });
+      };
+
+  const dataType *res
+    = this->pingPong(vertexNumber, numberOfIterations,
+                     mask_ != nullptr ? mask.data() : nullptr, first.data(),
+                     second.data(), kernel, t);
+
+  // back to the input numbering
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber; i++) {
+    std::copy(res + nc * i, res + nc * (i + 1), outputData + nc * newToOld[i]);
+  }
+
+  return 0;
+}
+
+template <class dataType, int nComp, class triangulationType>
+int ttk::ScalarFieldSmoother::smoothComponents(
+  const triangulationType *triangulation,
+  const int numberOfIterations,
+  Timer &t,
+  std::true_type) const {
+
+  const SimplexId vertexNumber = triangulation->getNumberOfVertices();
+  const size_t nc = dimensionNumber_;
+  dataType *outputData = (dataType *)outputData_;
+  dataType *inputData = (dataType *)inputData_;
+
+  // interior vertices share the same neighbor offsets: get them on the
+  // first interior vertex (coordinates 1 along every non-flat axis)
+  const auto dims = triangulation->getGridDimensions();
+  bool hasInterior{true};
+  SimplexId ref{};
+  for(int i = 2; i >= 0; i--) {
+    hasInterior = hasInterior && (dims[i] == 1 || dims[i] > 2);
+    ref = ref * dims[i] + (dims[i] > 1 ? 1 : 0);
+  }
+  std::vector<SimplexId> stencil{};
+  if(hasInterior) {
+    stencil.resize(triangulation->getVertexNeighborNumber(ref));
+    for(size_t k = 0; k < stencil.size(); k++) {
+      triangulation->getVertexNeighbor(ref, k, stencil[k]);
+      stencil[k] -= ref;
+    }
+  }
+  const SimplexId stencilSize = stencil.size();
+  const SimplexId *const offsets = stencil.data();
+  this->printMsg("Constant stencil of " + std::to_string(stencilSize)
+                   + " neighbors on the interior vertices",
+                 debug::Priority::DETAIL);
+
+  // ping-pong buffers: output & temporary
+  std::copy(inputData, inputData + nc * vertexNumber, outputData);
+  std::vector<dataType> tmpData(nc * vertexNumber);
+
+  const auto isInterior = [&dims](const SimplexId c, const int axis) {
+    return dims[axis] == 1 || (c > 0 && c < dims[axis] - 1);
+  };
+
+  const auto kernel = [&](const SimplexId v, const dataType *in,
+                          dataType *out) {
+    const SimplexId x = v % dims[0];
+    const SimplexId y = (v / dims[0]) % dims[1];
+    const SimplexId z = v / (dims[0] * dims[1]);
+    if(hasInterior && isInterior(x, 0) && isInterior(y, 1)
+       && isInterior(z, 2)) {
+      this->averageNeighbors<dataType, nComp>(
+        in, out, v, stencilSize,
+        [v, offsets](const SimplexId k) { return v + offsets[k]; });
+    } else {
+      this->averageNeighbors<dataType, nComp>(
+        in, out, v, triangulation->getVertexNeighborNumber(v),
+        [v, triangulation](const SimplexId k) {
+          SimplexId n{-1};
+          triangulation->getVertexNeighbor(v, k, n);
+          return n;
+        });
+    }
+  };
+
+  const dataType *res = this->pingPong(vertexNumber, numberOfIterations, mask_,
+                                       outputData, tmpData.data(), kernel, t);
+
+  if(res != outputData) {
+    // odd number of iterations
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < vertexNumber; i++) {
+      std::copy(res + nc * i, res + nc * (i + 1), outputData + nc * i);
+    }
+  }
 
   return 0;
 }
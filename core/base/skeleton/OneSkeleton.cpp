@@ -1,5 +1,6 @@
 #include <OneSkeleton.h>
-#include <boost/container/small_vector.hpp>
+
+#include <algorithm>
 
 using namespace std;
 using namespace ttk;
@@ -146,11 +147,12 @@ int OneSkeleton::buildEdgeList(
     return -1;
   }
 
-  printMsg("Building edges", 0, 0, 1, ttk::debug::LineMode::REPLACE);
+  printMsg("Building edges", 0, 0, threadNumber_,
+           ttk::debug::LineMode::REPLACE);
 
   const SimplexId cellNumber = cellArray.getNbCells();
 
-  // we will nee cellEdgeList to compute edgeStars
+  // we will need cellEdgeList to compute edgeStars
   std::vector<std::array<SimplexId, n>> defaultCellEdgeList{};
   if(edgeStars != nullptr && cellEdgeList == nullptr) {
     cellEdgeList = &defaultCellEdgeList;
@@ -160,96 +162,188 @@ int OneSkeleton::buildEdgeList(
     cellEdgeList->resize(cellNumber);
   }
 
-  struct EdgeData {
-    // the id of the edge higher vertex
-    SimplexId highVert{};
-    // the edge id
-    SimplexId id{};
-    EdgeData(SimplexId hv, SimplexId i) : highVert{hv}, id{i} {
-    }
-  };
-
-  using boost::container::small_vector;
-  // for each vertex, a vector of EdgeData
-  std::vector<small_vector<EdgeData, 8>> edgeTable(vertexNumber);
+  // Every edge is owned by its lowest vertex. The cell edges are
+  // bucketed by owner vertex with a counting sort (one parallel pass
+  // over the cells to count them, one to scatter their highest
+  // vertices), then every bucket is sorted and deduplicated. Edge
+  // identifiers follow the lexicographic order of the edge vertices:
+  // they do not depend on the number of threads.
+  //
+  // Once the vertices of a cell are sorted, its j-th vertex owns the
+  // edges towards the next ones: a single atomic operation per owner
+  // vertex reserves them in the bucket.
+
+  // sorted vertices of a cell (at most a tetrahedron)
+  const auto getSortedCellVertices
+    = [&cellArray](const SimplexId cid, std::array<SimplexId, 4> &verts) {
+        const SimplexId nbVertsInCell = cellArray.getCellVertexNumber(cid);
+        for(SimplexId j = 0; j < nbVertsInCell; j++) {
+          verts[j] = cellArray.getCellVertex(cid, j);
+        }
+        std::sort(verts.begin(), verts.begin() + nbVertsInCell);
+        return nbVertsInCell;
+      };
 
-  const int timeBuckets = std::min<ttk::SimplexId>(10, cellNumber);
-  SimplexId edgeCount{};
+  // number of cell edges per owner vertex, then bucket offsets
+  std::vector<SimplexId> bucketOffsets(vertexNumber + 1, 0);
 
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
   for(SimplexId cid = 0; cid < cellNumber; cid++) {
+    std::array<SimplexId, 4> verts{};
+    const SimplexId nbVertsInCell = getSortedCellVertices(cid, verts);
+    for(SimplexId j = 0; j <= nbVertsInCell - 2; j++) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+      bucketOffsets[verts[j] + 1] += nbVertsInCell - 1 - j;
+    }
+  }
 
-    const SimplexId nbVertsInCell = cellArray.getCellVertexNumber(cid);
-    // id of edge in cell
-    SimplexId ecid{};
+  // compute partial sum of number of cell edges per owner vertex
+  for(size_t i = 1; i < bucketOffsets.size(); ++i) {
+    bucketOffsets[i] += bucketOffsets[i - 1];
+  }
 
-    // tet case: {0-1}, {0-2}, {0-3}, {1-2}, {1-3}, {2-3}
-    for(SimplexId j = 0; j <= nbVertsInCell - 2; j++) {
-      for(SimplexId k = j + 1; k <= nbVertsInCell - 1; k++) {
-        // edge processing
-        SimplexId v0 = cellArray.getCellVertex(cid, j);
-        SimplexId v1 = cellArray.getCellVertex(cid, k);
-        if(v0 > v1) {
-          std::swap(v0, v1);
-        }
-        auto &vec = edgeTable[v0];
-        const auto pos
-          = std::find_if(vec.begin(), vec.end(),
-                         [&](const EdgeData &a) { return a.highVert == v1; });
-        if(pos == vec.end()) {
-          // not found in edgeTable: new edge
-          vec.emplace_back(EdgeData{v1, edgeCount});
-          if(cellEdgeList != nullptr) {
-            (*cellEdgeList)[cid][ecid] = edgeCount;
-          }
-          edgeCount++;
-        } else {
-          // found an existing edge
-          if(cellEdgeList != nullptr) {
-            (*cellEdgeList)[cid][ecid] = pos->id;
-          }
+  // highest vertex of every cell edge, bucketed by owner vertex
+  std::vector<SimplexId> buckets(bucketOffsets.back());
+
+  {
+    // number of cell edges processed per owner vertex
+    std::vector<SimplexId> bucketIds(vertexNumber, 0);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId cid = 0; cid < cellNumber; cid++) {
+      std::array<SimplexId, 4> verts{};
+      const SimplexId nbVertsInCell = getSortedCellVertices(cid, verts);
+      for(SimplexId j = 0; j <= nbVertsInCell - 2; j++) {
+        const auto v0 = verts[j];
+        SimplexId pos{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif // TTK_ENABLE_OPENMP
+        {
+          pos = bucketIds[v0];
+          bucketIds[v0] += nbVertsInCell - 1 - j;
         }
-        ecid++;
+        std::copy(verts.begin() + j + 1, verts.begin() + nbVertsInCell,
+                  buckets.begin() + bucketOffsets[v0] + pos);
       }
     }
-    if(debugLevel_ >= (int)(debug::Priority::INFO)) {
-      if(!(cid % ((cellNumber) / timeBuckets)))
-        printMsg("Building edges", (cid / (float)cellNumber),
-                 t.getElapsedTime(), 1, debug::LineMode::REPLACE);
+  }
+
+  printMsg("Building edges", 0.25, t.getElapsedTime(), threadNumber_,
+           debug::LineMode::REPLACE);
+
+  // sort every bucket and count its distinct elements
+  std::vector<SimplexId> edgeOffsets(vertexNumber + 1, 0);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 4096)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber; ++i) {
+    const auto begin = buckets.begin() + bucketOffsets[i];
+    const auto end = buckets.begin() + bucketOffsets[i + 1];
+    std::sort(begin, end);
+    for(auto it = begin; it != end; ++it) {
+      if(it == begin || *it != *(it - 1)) {
+        edgeOffsets[i + 1]++;
+      }
     }
   }
 
-  // allocate & fill edgeList in parallel
+  // compute partial sum of number of edges per owner vertex
+  for(size_t i = 1; i < edgeOffsets.size(); ++i) {
+    edgeOffsets[i] += edgeOffsets[i - 1];
+  }
+  const SimplexId edgeCount = edgeOffsets.back();
+
+  // deduplicate every bucket: its first elements are then the highest
+  // vertices of the edges owned by the bucket vertex (the number of
+  // duplicates of an edge is the size of its star)
+  std::vector<SimplexId> starOffsets{};
+  if(cellEdgeList != nullptr && edgeStars != nullptr) {
+    starOffsets.resize(edgeCount + 1);
+  }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 4096)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber; ++i) {
+    const auto begin = buckets.begin() + bucketOffsets[i];
+    const auto end = buckets.begin() + bucketOffsets[i + 1];
+    auto last = begin;
+    for(auto it = begin; it != end; ++it) {
+      if(last == begin || *it != *(last - 1)) {
+        *last = *it;
+        ++last;
+      }
+      if(!starOffsets.empty()) {
+        // one more cell in the star of the current edge
+        starOffsets[edgeOffsets[i] + (last - begin)]++;
+      }
+    }
+  }
+
+  printMsg("Building edges", 0.5, t.getElapsedTime(), threadNumber_,
+           debug::LineMode::REPLACE);
+
+  // fill the output buffers in parallel
 
   if(edgeList != nullptr) {
     edgeList->resize(edgeCount);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < vertexNumber; ++i) {
+      for(SimplexId j = edgeOffsets[i]; j < edgeOffsets[i + 1]; ++j) {
+        (*edgeList)[j] = {i, buckets[bucketOffsets[i] + j - edgeOffsets[i]]};
+      }
+    }
   }
 
+  if(cellEdgeList != nullptr) {
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(this->threadNumber_)
+#pragma omp parallel for num_threads(threadNumber_)
 #endif // TTK_ENABLE_OPENMP
-  for(SimplexId i = 0; i < vertexNumber; ++i) {
-    const auto &etable = edgeTable[i];
-    for(const auto &data : etable) {
-      if(edgeList != nullptr) {
-        (*edgeList)[data.id] = {i, data.highVert};
+    for(SimplexId cid = 0; cid < cellNumber; cid++) {
+      const SimplexId nbVertsInCell = cellArray.getCellVertexNumber(cid);
+      SimplexId ecid{};
+      for(SimplexId j = 0; j <= nbVertsInCell - 2; j++) {
+        for(SimplexId k = j + 1; k <= nbVertsInCell - 1; k++) {
+          SimplexId v0 = cellArray.getCellVertex(cid, j);
+          SimplexId v1 = cellArray.getCellVertex(cid, k);
+          if(v0 > v1) {
+            std::swap(v0, v1);
+          }
+          // binary search in the deduplicated bucket of v0
+          const auto begin = buckets.begin() + bucketOffsets[v0];
+          const auto end = begin + (edgeOffsets[v0 + 1] - edgeOffsets[v0]);
+          (*cellEdgeList)[cid][ecid]
+            = edgeOffsets[v0] + (std::lower_bound(begin, end, v1) - begin);
+          ecid++;
+        }
       }
     }
   }
 
+  // release the buckets before allocating the edge stars
+  buckets = std::vector<SimplexId>{};
+
+  printMsg("Building edges", 0.75, t.getElapsedTime(), threadNumber_,
+           debug::LineMode::REPLACE);
+
   // return cellEdgeList to get edgeStars
 
   if(cellEdgeList != nullptr && edgeStars != nullptr) {
-    std::vector<SimplexId> offsets(edgeCount + 1);
+    auto &offsets = starOffsets;
     // number of cells processed per edge
     std::vector<SimplexId> starIds(edgeCount);
 
-    // store number of cells per edge
-    for(const auto &ce : *cellEdgeList) {
-      for(const auto eid : ce) {
-        offsets[eid + 1]++;
-      }
-    }
-
     // compute partial sum of number of cells per edge
     for(size_t i = 1; i < offsets.size(); ++i) {
       offsets[i] += offsets[i - 1];
@@ -258,25 +352,35 @@ int OneSkeleton::buildEdgeList(
     // allocate flat edge stars vector
     std::vector<SimplexId> edgeSt(offsets.back());
 
-    // fill flat neighbors vector using offsets and neighbors count vectors
-    for(size_t i = 0; i < cellEdgeList->size(); ++i) {
-      const auto &ce{(*cellEdgeList)[i]};
-      for(const auto eid : ce) {
-        edgeSt[offsets[eid] + starIds[eid]] = i;
-        starIds[eid]++;
+    // fill flat edge stars vector using offsets and star count vectors
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId cid = 0; cid < cellNumber; ++cid) {
+      for(const auto eid : (*cellEdgeList)[cid]) {
+        SimplexId pos{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif // TTK_ENABLE_OPENMP
+        pos = starIds[eid]++;
+        edgeSt[offsets[eid] + pos] = cid;
       }
     }
 
+    // sort the stars to be independent from the threads scheduling
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 4096)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < edgeCount; ++i) {
+      std::sort(edgeSt.begin() + offsets[i], edgeSt.begin() + offsets[i + 1]);
+    }
+
     // fill FlatJaggedArray struct
     edgeStars->setData(std::move(edgeSt), std::move(offsets));
   }
 
-  printMsg(
-    "Built " + to_string(edgeCount) + " edges", 1, t.getElapsedTime(), 1);
-
-  // ethaneDiolMedium.vtu, 70Mtets, hal9000 (12coresHT)
-  // 1 thread: 10.4979 s
-  // 24 threads: 12.3994 s [not efficient in parallel]
+  printMsg("Built " + to_string(edgeCount) + " edges", 1, t.getElapsedTime(),
+           threadNumber_);
 
   return 0;
 }
@@ -73,7 +73,8 @@ namespace ttk {
     /// \param cellArray Cell container allowing to retrieve the vertices ids
     /// of each cell.
     /// \param edgeList Optional output edge list (each entry is an
-    /// ordered std::array of vertex identifiers).
+    /// ordered std::array of vertex identifiers, entries being sorted in
+    /// lexicographic order).
     /// \param edgeStars Optional output for edge cell adjacency (for
     /// each edge, a list of adjacent cells)
     /// \param cellEdgeList Optional output for cell edges: per cell,
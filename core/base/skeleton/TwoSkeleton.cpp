@@ -298,98 +298,194 @@ int TwoSkeleton::buildTriangleList(
     cellTriangleList->resize(cellNumber, {-1, -1, -1, -1});
   }
 
-  struct TriangleData {
-    // the two higher vertices id of the triangle
-    std::array<SimplexId, 2> highVerts{};
-    // the triangle id
-    SimplexId id{-1};
-    TriangleData(std::array<SimplexId, 2> hVerts, SimplexId i)
-      : highVerts{hVerts}, id{i} {
+  // Same scheme as OneSkeleton::buildEdgeList: every triangle is owned
+  // by its lowest vertex, the cell triangles are bucketed by owner
+  // vertex with a counting sort, then every bucket is sorted and
+  // deduplicated. Triangle identifiers follow the lexicographic order
+  // of the triangle vertices. Once the vertices of a tetrahedron are
+  // sorted, the first one owns three of its faces and the second one
+  // owns the last face.
+
+  // a tetra cell has 4 faces: (sorted) vertices of face j of cell cid
+  const auto getCellTriangle = [&cellArray](const SimplexId cid,
+                                            const size_t j) {
+    std::array<SimplexId, 3> triangle{};
+    for(size_t k = 0; k < 3; k++) {
+      // TODO: ASSUME Regular Mesh Here!
+      triangle[k] = cellArray.getCellVertex(cid, (j + k) % 4);
     }
+    std::sort(triangle.begin(), triangle.end());
+    return triangle;
+  };
+  // sorted vertices of a tetra cell
+  const auto getSortedCellVertices = [&cellArray](const SimplexId cid) {
+    std::array<SimplexId, 4> verts{};
+    for(size_t k = 0; k < 4; k++) {
+      verts[k] = cellArray.getCellVertex(cid, k);
+    }
+    std::sort(verts.begin(), verts.end());
+    return verts;
   };
 
-  using boost::container::small_vector;
-  // for each vertex, a vector of TriangleData
-  std::vector<small_vector<TriangleData, 8>> triangleTable(vertexNumber);
+  // number of cell triangles per owner vertex, then bucket offsets
+  std::vector<SimplexId> bucketOffsets(vertexNumber + 1, 0);
 
-  SimplexId nTriangles{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId cid = 0; cid < cellNumber; cid++) {
+    const auto verts = getSortedCellVertices(cid);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+    bucketOffsets[verts[0] + 1] += 3;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+    bucketOffsets[verts[1] + 1]++;
+  }
+
+  // compute partial sum of number of cell triangles per owner vertex
+  for(size_t i = 1; i < bucketOffsets.size(); ++i) {
+    bucketOffsets[i] += bucketOffsets[i - 1];
+  }
+
+  // two highest vertices of every cell triangle, bucketed by owner vertex
+  std::vector<std::array<SimplexId, 2>> buckets(bucketOffsets.back());
+
+  {
+    // number of cell triangles processed per owner vertex
+    std::vector<SimplexId> bucketIds(vertexNumber, 0);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId cid = 0; cid < cellNumber; cid++) {
+      const auto verts = getSortedCellVertices(cid);
+      SimplexId pos0{}, pos1{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif // TTK_ENABLE_OPENMP
+      {
+        pos0 = bucketIds[verts[0]];
+        bucketIds[verts[0]] += 3;
+      }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif // TTK_ENABLE_OPENMP
+      pos1 = bucketIds[verts[1]]++;
+      const auto bucket0 = buckets.begin() + bucketOffsets[verts[0]] + pos0;
+      bucket0[0] = {verts[1], verts[2]};
+      bucket0[1] = {verts[1], verts[3]};
+      bucket0[2] = {verts[2], verts[3]};
+      buckets[bucketOffsets[verts[1]] + pos1] = {verts[2], verts[3]};
+    }
+  }
 
-  printMsg("Building triangles", 0.25, t.getElapsedTime(), 1,
+  printMsg("Building triangles", 0.25, t.getElapsedTime(), threadNumber_,
            debug::LineMode::REPLACE);
 
-  for(SimplexId cid = 0; cid < cellNumber; cid++) {
-    // a tetra cell has 4 faces
-    for(size_t j = 0; j < 4; j++) {
-      std::array<SimplexId, 3> triangle{};
-      for(size_t k = 0; k < 3; k++) {
-        // TODO: ASSUME Regular Mesh Here!
-        triangle[k] = cellArray.getCellVertex(cid, (j + k) % 4);
+  // sort every bucket and count its distinct elements
+  std::vector<SimplexId> triangleOffsets(vertexNumber + 1, 0);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 4096)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber; ++i) {
+    const auto begin = buckets.begin() + bucketOffsets[i];
+    const auto end = buckets.begin() + bucketOffsets[i + 1];
+    std::sort(begin, end);
+    for(auto it = begin; it != end; ++it) {
+      if(it == begin || *it != *(it - 1)) {
+        triangleOffsets[i + 1]++;
       }
-      std::sort(triangle.begin(), triangle.end());
-      auto &ttable = triangleTable[triangle[0]];
-
-      // check if current triangle already registered in triangleTable
-      // via another tetra in its star
-      bool found{false};
-      for(auto &d : ttable) {
-        if(d.highVerts[0] == triangle[1] && d.highVerts[1] == triangle[2]) {
-          found = true;
-          if(cellTriangleList != nullptr) {
-            (*cellTriangleList)[cid][j] = d.id;
-          }
-          break;
-        }
+    }
+  }
+
+  // compute partial sum of number of triangles per owner vertex
+  for(size_t i = 1; i < triangleOffsets.size(); ++i) {
+    triangleOffsets[i] += triangleOffsets[i - 1];
+  }
+  const SimplexId nTriangles = triangleOffsets.back();
+
+  // deduplicate every bucket: its first elements are then the highest
+  // vertices of the triangles owned by the bucket vertex (the number of
+  // duplicates of a triangle is the size of its star)
+  std::vector<SimplexId> starOffsets{};
+  if(cellTriangleList != nullptr && triangleStars != nullptr) {
+    starOffsets.resize(nTriangles + 1);
+  }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 4096)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber; ++i) {
+    const auto begin = buckets.begin() + bucketOffsets[i];
+    const auto end = buckets.begin() + bucketOffsets[i + 1];
+    auto last = begin;
+    for(auto it = begin; it != end; ++it) {
+      if(last == begin || *it != *(last - 1)) {
+        *last = *it;
+        ++last;
       }
-      if(!found) {
-        // new triangle added
-        ttable.emplace_back(
-          TriangleData{{triangle[1], triangle[2]}, nTriangles});
-        if(cellTriangleList != nullptr) {
-          (*cellTriangleList)[cid][j] = nTriangles;
-        }
-        nTriangles++;
+      if(!starOffsets.empty()) {
+        // one more cell in the star of the current triangle
+        starOffsets[triangleOffsets[i] + (last - begin)]++;
       }
     }
   }
 
-  printMsg(
-    "Building triangles", 0.5, t.getElapsedTime(), 1, debug::LineMode::REPLACE);
+  printMsg("Building triangles", 0.5, t.getElapsedTime(), threadNumber_,
+           debug::LineMode::REPLACE);
+
+  // fill the output buffers in parallel
 
-  // resize vectors to the correct size
   if(triangleList) {
     triangleList->resize(nTriangles);
-  }
 
-  // fill data buffers in parallel
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < vertexNumber; ++i) {
+      for(SimplexId j = triangleOffsets[i]; j < triangleOffsets[i + 1]; ++j) {
+        const auto &highVerts
+          = buckets[bucketOffsets[i] + j - triangleOffsets[i]];
+        (*triangleList)[j] = {i, highVerts[0], highVerts[1]};
+      }
+    }
+  }
 
+  if(cellTriangleList) {
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(this->threadNumber_)
+#pragma omp parallel for num_threads(threadNumber_)
 #endif // TTK_ENABLE_OPENMP
-  for(SimplexId i = 0; i < vertexNumber; ++i) {
-    const auto &ttable = triangleTable[i];
-    for(const auto &data : ttable) {
-      if(triangleList != nullptr) {
-        (*triangleList)[data.id] = {i, data.highVerts[0], data.highVerts[1]};
+    for(SimplexId cid = 0; cid < cellNumber; cid++) {
+      for(size_t j = 0; j < 4; j++) {
+        const auto triangle = getCellTriangle(cid, j);
+        const auto v0 = triangle[0];
+        const std::array<SimplexId, 2> highVerts{triangle[1], triangle[2]};
+        // binary search in the deduplicated bucket of v0
+        const auto begin = buckets.begin() + bucketOffsets[v0];
+        const auto end
+          = begin + (triangleOffsets[v0 + 1] - triangleOffsets[v0]);
+        (*cellTriangleList)[cid][j]
+          = triangleOffsets[v0]
+            + (std::lower_bound(begin, end, highVerts) - begin);
       }
     }
   }
 
-  printMsg("Building triangles", 0.75, t.getElapsedTime(), 1,
+  // release the buckets before allocating the triangle stars
+  buckets = std::vector<std::array<SimplexId, 2>>{};
+
+  printMsg("Building triangles", 0.75, t.getElapsedTime(), threadNumber_,
            debug::LineMode::REPLACE);
 
   if(cellTriangleList != nullptr && triangleStars != nullptr) {
-    std::vector<SimplexId> offsets(nTriangles + 1);
-    // number of cells processed per vertex
+    auto &offsets = starOffsets;
+    // number of cells processed per triangle
     std::vector<SimplexId> starIds(nTriangles);
 
-    // store number of cells per triangle
-    for(const auto &c : *cellTriangleList) {
-      offsets[c[0] + 1]++;
-      offsets[c[1] + 1]++;
-      offsets[c[2] + 1]++;
-      offsets[c[3] + 1]++;
-    }
-
     // compute partial sum of number of cells per triangle
     for(size_t i = 1; i < offsets.size(); ++i) {
       offsets[i] += offsets[i - 1];
@@ -398,32 +494,37 @@ int TwoSkeleton::buildTriangleList(
     // allocate flat triangle stars vector
     std::vector<SimplexId> triangleSt(offsets.back());
 
-    // fill flat neighbors vector using offsets and neighbors count vectors
-    for(size_t i = 0; i < cellTriangleList->size(); ++i) {
-      const auto &ct{(*cellTriangleList)[i]};
-      triangleSt[offsets[ct[0]] + starIds[ct[0]]] = i;
-      starIds[ct[0]]++;
-      triangleSt[offsets[ct[1]] + starIds[ct[1]]] = i;
-      starIds[ct[1]]++;
-      triangleSt[offsets[ct[2]] + starIds[ct[2]]] = i;
-      starIds[ct[2]]++;
-      triangleSt[offsets[ct[3]] + starIds[ct[3]]] = i;
-      starIds[ct[3]]++;
+    // fill flat triangle stars vector using offsets and star count vectors
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId cid = 0; cid < cellNumber; ++cid) {
+      for(const auto tid : (*cellTriangleList)[cid]) {
+        SimplexId pos{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif // TTK_ENABLE_OPENMP
+        pos = starIds[tid]++;
+        triangleSt[offsets[tid] + pos] = cid;
+      }
+    }
+
+    // sort the stars to be independent from the threads scheduling
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 4096)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < nTriangles; ++i) {
+      std::sort(triangleSt.begin() + offsets[i],
+                triangleSt.begin() + offsets[i + 1]);
     }
 
     // fill FlatJaggedArray struct
     triangleStars->setData(std::move(triangleSt), std::move(offsets));
   }
 
-  printMsg(
-    "Built " + to_string(nTriangles) + " triangles", 1, t.getElapsedTime(), 1);
-  // ethaneDiolMedium.vtu, 70Mtets, hal9000 (12coresHT)// 1 thread: 58.5631 s//
-  // 24 threads: 87.5816 s (~) ethaneDiol.vtu, 8.7Mtets, vger (2coresHT) - no
-  // tet adj// 1 thread: 5.7427 s// 4 threads: 9.14764 s (~)
-  // ethaneDiol.vtu, 8.7Mtets, vger (2coresHT) - tet adjacency// 1
-  // thread: 8.59854 s// 4 threads: 15.837 s
-  // (~) ethaneDiol.vtu, 8.7Mtets, vger (2coresHT) - tet adjacency only// 1
-  // thread: 6.85897 s// 4 threads: 14.78 s (~)
+  printMsg("Built " + to_string(nTriangles) + " triangles", 1,
+           t.getElapsedTime(), threadNumber_);
+
   return 0;
 }
 
@@ -117,7 +117,8 @@ namespace ttk {
     /// \param cellArray Cell container allowing to retrieve the vertices ids
     /// of each cell.
     /// \param triangleList Optional output triangle list (each entry is the
-    /// ordered std::vector of the vertex identifiers of the entry's triangle).
+    /// ordered std::vector of the vertex identifiers of the entry's triangle,
+    /// entries being sorted in lexicographic order).
     /// \param triangleStars Optional output for triangle tet-adjacency (for
     /// each triangle, list of its adjacent tetrahedra).
     /// \return Returns 0 upon success, negative values otherwise.
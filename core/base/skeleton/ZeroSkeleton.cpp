@@ -1,6 +1,8 @@
 #include <OneSkeleton.h>
 #include <ZeroSkeleton.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace ttk;
 
@@ -197,11 +199,24 @@ int ZeroSkeleton::buildVertexNeighbors(
 
   Timer t;
 
-  printMsg("Building vertex neighbors", 0, 0, 1, ttk::debug::LineMode::REPLACE);
+  printMsg("Building vertex neighbors", 0, 0, threadNumber_,
+           ttk::debug::LineMode::REPLACE);
+
+  const SimplexId edgeNumber = localEdgeList->size();
 
   // store number of neighbors per vertex
-  for(const auto &e : *localEdgeList) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < edgeNumber; ++i) {
+    const auto &e = (*localEdgeList)[i];
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
     offsets[e[0] + 1]++;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
     offsets[e[1] + 1]++;
   }
 
@@ -214,23 +229,38 @@ int ZeroSkeleton::buildVertexNeighbors(
   std::vector<SimplexId> neighbors(offsets.back());
 
   // fill flat neighbors vector using offsets and neighbors count vectors
-  for(const auto &e : *localEdgeList) {
-    neighbors[offsets[e[0]] + neighborsId[e[0]]] = e[1];
-    neighborsId[e[0]]++;
-    neighbors[offsets[e[1]] + neighborsId[e[1]]] = e[0];
-    neighborsId[e[1]]++;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < edgeNumber; ++i) {
+    const auto &e = (*localEdgeList)[i];
+    SimplexId pos0{}, pos1{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif // TTK_ENABLE_OPENMP
+    pos0 = neighborsId[e[0]]++;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif // TTK_ENABLE_OPENMP
+    pos1 = neighborsId[e[1]]++;
+    neighbors[offsets[e[0]] + pos0] = e[1];
+    neighbors[offsets[e[1]] + pos1] = e[0];
+  }
+
+  // sort the neighbors to be independent from the threads scheduling
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 4096)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber; ++i) {
+    std::sort(
+      neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]);
   }
 
   // fill FlatJaggedArray struct
   vertexNeighbors.setData(std::move(neighbors), std::move(offsets));
 
   printMsg("Built " + std::to_string(vertexNumber) + " vertex neighbors", 1,
-           t.getElapsedTime(), 1);
-
-  // ethaneDiolMedium.vtu, 70Mtets, hal9000 (12coresHT)
-  // (only merging step, after edge list creation)
-  // 1 thread: 9.16 s
-  // 24 threads: 13.21 s [not efficient in parallel]
+           t.getElapsedTime(), threadNumber_);
 
   return 0;
 }
@@ -241,7 +271,8 @@ int ZeroSkeleton::buildVertexStars(const SimplexId &vertexNumber,
 
   Timer t;
 
-  printMsg("Building vertex stars", 0, 0, 1, ttk::debug::LineMode::REPLACE);
+  printMsg("Building vertex stars", 0, 0, threadNumber_,
+           ttk::debug::LineMode::REPLACE);
 
   std::vector<SimplexId> offsets(vertexNumber + 1);
   // number of cells processed per vertex
@@ -250,9 +281,15 @@ int ZeroSkeleton::buildVertexStars(const SimplexId &vertexNumber,
   const auto cellNumber = cellArray.getNbCells();
 
   // store number of stars per vertex
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
   for(SimplexId i = 0; i < cellNumber; ++i) {
     const auto nbVertCell = cellArray.getCellVertexNumber(i);
     for(SimplexId j = 0; j < nbVertCell; ++j) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
       offsets[cellArray.getCellVertex(i, j) + 1]++;
     }
   }
@@ -266,20 +303,35 @@ int ZeroSkeleton::buildVertexStars(const SimplexId &vertexNumber,
   std::vector<SimplexId> data(offsets.back());
 
   // fill flat data vector using offsets and edges count vectors
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
   for(SimplexId i = 0; i < cellNumber; ++i) {
     const auto nbVertCell = cellArray.getCellVertexNumber(i);
     for(SimplexId j = 0; j < nbVertCell; ++j) {
       const auto v = cellArray.getCellVertex(i, j);
-      data[offsets[v] + cellIds[v]] = i;
-      cellIds[v]++;
+      SimplexId pos{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif // TTK_ENABLE_OPENMP
+      pos = cellIds[v]++;
+      data[offsets[v] + pos] = i;
     }
   }
 
+  // sort the stars to be independent from the threads scheduling
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 4096)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber; ++i) {
+    std::sort(data.begin() + offsets[i], data.begin() + offsets[i + 1]);
+  }
+
   // fill FlatJaggedArray struct
   vertexStars.setData(std::move(data), std::move(offsets));
 
   printMsg("Built " + std::to_string(vertexNumber) + " vertex stars", 1,
-           t.getElapsedTime(), 1);
+           t.getElapsedTime(), threadNumber_);
 
   if(debugLevel_ >= static_cast<int>(debug::Priority::VERBOSE)) {
     for(size_t i = 0; i < vertexStars.subvectorsNumber(); i++) {
@@ -292,9 +344,5 @@ int ZeroSkeleton::buildVertexStars(const SimplexId &vertexNumber,
     }
   }
 
-  // ethaneDiol.vtu, 8.7Mtets, hal9000 (12coresHT)
-  // 1 thread: 0.53 s
-  // 24 threads: 7.99 s
-
   return 0;
 }
@@ -28,7 +28,7 @@ namespace ttk {
               typename triangulationType = ttk::AbstractTriangulation>
     int performDiagramComputation(
       int fieldNumber,
-      std::vector<std::vector<diagramTuple>> &persistenceDiagrams,
+      std::vector<PersistenceDiagramColumns<double>> &persistenceDiagrams,
       const triangulationType *triangulation);
 
     /// Pass a pointer to an input array representing a scalarfield.
@@ -84,7 +84,7 @@ namespace ttk {
 template <typename dataType, typename triangulationType>
 int ttk::TrackingFromFields::performDiagramComputation(
   int fieldNumber,
-  std::vector<std::vector<diagramTuple>> &persistenceDiagrams,
+  std::vector<PersistenceDiagramColumns<double>> &persistenceDiagrams,
   const triangulationType *triangulation) {
 
 #ifdef TTK_ENABLE_OPENMP
@@ -105,26 +105,10 @@ int ttk::TrackingFromFields::performDiagramComputation(
     persistenceDiagram.execute<dataType, triangulationType>(
       CTDiagram, (dataType *)(inputData_[i]), inputOffsets_[i], triangulation);
 
-    // Copy diagram into augmented diagram.
-    persistenceDiagrams[i] = std::vector<diagramTuple>(CTDiagram.size());
-
-    for(int j = 0; j < (int)CTDiagram.size(); ++j) {
-      float p[3];
-      float q[3];
-      auto currentTuple = CTDiagram[j];
-      const int a = currentTuple.birth;
-      const int b = currentTuple.death;
-      triangulation->getVertexPoint(a, p[0], p[1], p[2]);
-      triangulation->getVertexPoint(b, q[0], q[1], q[2]);
-      const double sa = ((double *)inputData_[i])[a];
-      const double sb = ((double *)inputData_[i])[b];
-      diagramTuple dt = std::make_tuple(
-        currentTuple.birth, currentTuple.birthType, currentTuple.death,
-        currentTuple.deathType, currentTuple.persistence, currentTuple.pairType,
-        sa, p[0], p[1], p[2], sb, q[0], q[1], q[2]);
-
-      persistenceDiagrams[i][j] = dt;
-    }
+    // Columns with the pair values and positions.
+    persistenceDiagram.getDiagramColumns(
+      persistenceDiagrams[i], CTDiagram,
+      static_cast<const dataType *>(inputData_[i]), triangulation);
   }
 
   return 0;
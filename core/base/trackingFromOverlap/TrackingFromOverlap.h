@@ -21,10 +21,12 @@
 #pragma once
 
 #include <Debug.h>
+#include <OrderDisambiguation.h>
 #include <algorithm>
 #include <boost/variant.hpp>
-#include <map>
-#include <unordered_map>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 using topologyType = unsigned char;
 using idType = long long int;
@@ -61,42 +63,72 @@ struct Node {
 using Edges = std::vector<idType>; // [index0, index1, overlap, branch,...]
 using Nodes = std::vector<Node>;
 
-struct CoordinateComparator {
-  const float *coordinates;
-
-  CoordinateComparator(const float *coords) : coordinates(coords){};
-
-  inline bool operator()(const size_t &i, const size_t &j) {
-    size_t ic = i * 3;
-    size_t jc = j * 3;
-    return coordinates[ic] == coordinates[jc]
-             ? coordinates[ic + 1] == coordinates[jc + 1]
-                 ? coordinates[ic + 2] < coordinates[jc + 2]
-                 : coordinates[ic + 1] < coordinates[jc + 1]
-             : coordinates[ic] < coordinates[jc];
-  }
-};
-
 namespace ttk {
   class TrackingFromOverlap : virtual public Debug {
   public:
+    // Labeled point set prepared for the overlap computation: labels are
+    // remapped to dense indices and points are sorted by coordinates (on
+    // demand). A prepared point set can be reused for all the overlaps it is
+    // involved in (previous and next timestep, parent and child level).
+    struct LabeledPointSet {
+      size_t nPoints{};
+      size_t nLabels{};
+      // dense label index of every point
+      std::vector<SimplexId> labelIndices{};
+      // point ids sorted by x, y, and then z coordinate
+      std::vector<SimplexId> sortedPoints{};
+    };
+
     TrackingFromOverlap() {
       this->setDebugMsgPrefix("TrackingFromOverlap");
     };
     ~TrackingFromOverlap(){};
 
+    // Compares the coordinates of two points: 0 if equal, <0 if p0 is in
+    // front of p1 (x, y, and then z), >0 otherwise
+    static inline int compareCoordinates(const float *p0, const float *p1) {
+      return p0[0] == p1[0]  ? p0[1] == p1[1]  ? p0[2] == p1[2]  ? 0
+                                                 : p0[2] < p1[2] ? -1
+                                                                 : 1
+                               : p0[1] < p1[1] ? -1
+                                               : 1
+             : p0[0] < p1[0] ? -1
+                             : 1;
+    }
+
     // This function sorts points based on their x, y, and then z coordinate
+    // (parallel radix sort)
     int sortCoordinates(const float *pointCoordinates,
                         const size_t nPoints,
-                        std::vector<size_t> &sortedIndicies) const {
+                        std::vector<SimplexId> &sortedIndicies) const {
       printMsg("Sorting coordinates ... ", debug::Priority::PERFORMANCE);
       Timer t;
 
-      sortedIndicies.resize(nPoints);
-      for(size_t i = 0; i < nPoints; i++)
-        sortedIndicies[i] = i;
-      CoordinateComparator c = CoordinateComparator(pointCoordinates);
-      sort(sortedIndicies.begin(), sortedIndicies.end(), c);
+      VertexSortBuffers buffers{};
+      buffers.keys.resize(nPoints);
+      buffers.values.resize(nPoints);
+
+      // (y, z) first, then x: the radix sort is stable
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < nPoints; i++) {
+        buffers.keys[i]
+          = (static_cast<uint64_t>(radixKey(pointCoordinates[3 * i + 1])) << 32)
+            | radixKey(pointCoordinates[3 * i + 2]);
+        buffers.values[i] = i;
+      }
+      radixSortPairs(sizeof(uint64_t), buffers, this->threadNumber_);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < nPoints; i++) {
+        buffers.keys[i] = radixKey(pointCoordinates[3 * buffers.values[i]]);
+      }
+      radixSortPairs(sizeof(uint32_t), buffers, this->threadNumber_);
+
+      sortedIndicies = std::move(buffers.values);
 
       std::stringstream msg;
       msg << "done (" << t.getElapsedTime() << " s).";
@@ -112,7 +144,12 @@ namespace ttk {
 
       size_t nT = timeNodesMap.size();
 
-      // Compute max pred and succ
+      // Compute max pred and succ (each pair of timesteps only writes the
+      // successors of its first nodes and the predecessors of its second
+      // ones)
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
       for(size_t t = 1; t < nT; t++) {
         auto &nodes0 = timeNodesMap[t - 1];
         auto &nodes1 = timeNodesMap[t];
@@ -137,26 +174,46 @@ namespace ttk {
         }
       }
 
-      // Label first nodes of branches
-      idType branchCounter = 0;
+      // Label first nodes of branches: nodes without predecessor first, then
+      // nodes that are not the max successor of their max predecessor, both
+      // in timestep order
+      std::vector<idType> branchOffsets(2 * nT + 1, 0);
 
-      for(size_t t = 0; t < nT; t++)
-        for(auto &n : timeNodesMap[t])
-          n.branchID = n.maxPredID == -1 ? branchCounter++ : -1;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t t = 0; t < nT; t++) {
+        const auto &nodes1 = timeNodesMap[t];
+        for(size_t i = 0; i < nodes1.size(); i++) {
+          const auto &n1 = nodes1[i];
+          if(n1.maxPredID == -1)
+            branchOffsets[t + 1]++;
+          else if(((idType)i) != timeNodesMap[t - 1][n1.maxPredID].maxSuccID)
+            branchOffsets[nT + t + 1]++;
+        }
+      }
+      for(size_t t = 0; t < 2 * nT; t++)
+        branchOffsets[t + 1] += branchOffsets[t];
 
-      for(size_t t = 1; t < nT; t++) {
-        auto &nodes0 = timeNodesMap[t - 1];
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t t = 0; t < nT; t++) {
         auto &nodes1 = timeNodesMap[t];
-
+        idType firstCounter = branchOffsets[t];
+        idType splitCounter = branchOffsets[nT + t];
         for(size_t i = 0; i < nodes1.size(); i++) {
           auto &n1 = nodes1[i];
-          if(n1.maxPredID != -1
-             && ((idType)i) != nodes0[n1.maxPredID].maxSuccID)
-            n1.branchID = branchCounter++;
+          if(n1.maxPredID == -1)
+            n1.branchID = firstCounter++;
+          else if(((idType)i) != timeNodesMap[t - 1][n1.maxPredID].maxSuccID)
+            n1.branchID = splitCounter++;
+          else
+            n1.branchID = -1;
         }
       }
 
-      // Propagate branch labels
+      // Propagate branch labels (sequential over time, parallel over edges)
       for(size_t t = 1; t < nT; t++) {
         auto &nodes0 = timeNodesMap[t - 1];
         auto &nodes1 = timeNodesMap[t];
@@ -164,18 +221,25 @@ namespace ttk {
 
         size_t nE = edges.size();
 
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
         for(size_t i = 0; i < nE; i += 4) {
           auto n0Index = edges[i];
           auto n1Index = edges[i + 1];
           auto &n0 = nodes0[n0Index];
           auto &n1 = nodes1[n1Index];
 
-          if(n1.branchID == -1 && n0Index == n1.maxPredID)
+          // only one edge matches the max predecessor of n1
+          if(n0Index == n1.maxPredID && n1.branchID == -1)
             n1.branchID = n0.branchID;
         }
       }
 
       // Label edges
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
       for(size_t t = 1; t < nT; t++) {
         auto &nodes0 = timeNodesMap[t - 1];
         auto &nodes1 = timeNodesMap[t];
@@ -202,12 +266,14 @@ namespace ttk {
       return 1;
     }
 
-    // This function sorts all unique lables of a point set and then maps these
-    // lables to their respective index in the sorted list
+    // This function sorts the points of a point set by label: sortedPoints
+    // holds the point ids grouped by label (labels in ascending order), and
+    // labelOffsets the start of each group (size: number of labels + 1)
     template <typename labelType>
-    int computeLabelIndexMap(const labelType *pointLabels,
-                             const size_t nPoints,
-                             std::map<labelType, size_t> &labelIndexMap) const;
+    int sortLabels(const labelType *pointLabels,
+                   const size_t nPoints,
+                   std::vector<SimplexId> &sortedPoints,
+                   std::vector<size_t> &labelOffsets) const;
 
     // This function computes all nodes and their properties based on a labeled
     // point set
@@ -217,6 +283,22 @@ namespace ttk {
                      const size_t nPoints,
                      Nodes &nodes) const;
 
+    // This function maps the labels of a point set to dense indices
+    template <typename labelType>
+    int preparePointSet(const labelType *pointLabels,
+                        const size_t nPoints,
+                        LabeledPointSet &pointSet) const;
+
+    // This function computes the overlap between two prepared point sets
+    // (points are sorted by coordinates on demand, unless both point sets
+    // share the same coordinates)
+    int computeOverlap(const float *pointCoordinates0,
+                       const float *pointCoordinates1,
+                       LabeledPointSet &pointSet0,
+                       LabeledPointSet &pointSet1,
+
+                       Edges &edges) const;
+
     // This function computes the overlap between two labeled point sets
     template <typename labelType>
     int computeOverlap(const float *pointCoordinates0,
@@ -233,18 +315,64 @@ namespace ttk {
 } // namespace ttk
 
 // =============================================================================
-// Compute LabelIndexMap
+// Sort Labels
 // =============================================================================
 template <typename labelType>
-int ttk::TrackingFromOverlap::computeLabelIndexMap(
+int ttk::TrackingFromOverlap::sortLabels(
   const labelType *pointLabels,
   const size_t nPoints,
-  std::map<labelType, size_t> &labelIndexMap) const {
-  for(size_t i = 0; i < nPoints; i++)
-    labelIndexMap[pointLabels[i]] = 0;
-  size_t i = 0;
-  for(auto &it : labelIndexMap)
-    it.second = i++;
+  std::vector<SimplexId> &sortedPoints,
+  std::vector<size_t> &labelOffsets) const {
+
+  VertexSortBuffers buffers{};
+  buffers.keys.resize(nPoints);
+  buffers.values.resize(nPoints);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nPoints; i++) {
+    buffers.keys[i] = radixKey(pointLabels[i]);
+    buffers.values[i] = i;
+  }
+  radixSortPairs(
+    sizeof(radixKey(labelType{})), buffers, this->threadNumber_);
+
+  // label groups: count the group starts per chunk, then fill the offsets
+  const auto &keys = buffers.keys;
+  const size_t nChunks = std::max(this->threadNumber_, 1);
+  std::vector<size_t> chunkOffsets(nChunks + 1, 0);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t c = 0; c < nChunks; c++) {
+    for(size_t i = c * nPoints / nChunks; i < (c + 1) * nPoints / nChunks;
+        i++) {
+      if(i == 0 || keys[i] != keys[i - 1])
+        chunkOffsets[c + 1]++;
+    }
+  }
+  for(size_t c = 0; c < nChunks; c++)
+    chunkOffsets[c + 1] += chunkOffsets[c];
+
+  labelOffsets.resize(chunkOffsets[nChunks] + 1);
+  labelOffsets.back() = nPoints;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t c = 0; c < nChunks; c++) {
+    size_t label = chunkOffsets[c];
+    for(size_t i = c * nPoints / nChunks; i < (c + 1) * nPoints / nChunks;
+        i++) {
+      if(i == 0 || keys[i] != keys[i - 1])
+        labelOffsets[label++] = i;
+    }
+  }
+
+  sortedPoints = std::move(buffers.values);
+
   return 1;
 }
 
@@ -260,28 +388,34 @@ int ttk::TrackingFromOverlap::computeNodes(const float *pointCoordinates,
 
   Timer t;
 
-  std::map<labelType, size_t> labelIndexMap;
-  this->computeLabelIndexMap(pointLabels, nPoints, labelIndexMap);
+  std::vector<SimplexId> sortedPoints;
+  std::vector<size_t> labelOffsets;
+  this->sortLabels(pointLabels, nPoints, sortedPoints, labelOffsets);
 
-  size_t nNodes = labelIndexMap.size();
+  size_t nNodes = labelOffsets.size() - 1;
 
   nodes.resize(nNodes);
-  for(size_t i = 0, q = 0; i < nPoints; i++) {
-    labelType label = pointLabels[i];
-    Node &n = nodes[labelIndexMap[label]];
-    n.label = label;
-    n.size++;
-    n.x += pointCoordinates[q++];
-    n.y += pointCoordinates[q++];
-    n.z += pointCoordinates[q++];
-  }
 
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
   for(size_t i = 0; i < nNodes; i++) {
     Node &n = nodes[i];
-    float size = (float)n.size;
-    n.x /= size;
-    n.y /= size;
-    n.z /= size;
+    n.label = pointLabels[sortedPoints[labelOffsets[i]]];
+
+    double x{}, y{}, z{};
+    for(size_t j = labelOffsets[i]; j < labelOffsets[i + 1]; j++) {
+      const size_t q = 3 * static_cast<size_t>(sortedPoints[j]);
+      x += pointCoordinates[q];
+      y += pointCoordinates[q + 1];
+      z += pointCoordinates[q + 2];
+    }
+
+    const size_t size = labelOffsets[i + 1] - labelOffsets[i];
+    n.size = size;
+    n.x = x / size;
+    n.y = y / size;
+    n.z = z / size;
   }
 
   // Print Status
@@ -295,32 +429,73 @@ int ttk::TrackingFromOverlap::computeNodes(const float *pointCoordinates,
 }
 
 // =============================================================================
-// Track Nodes
+// Prepare Point Set
 // =============================================================================
 template <typename labelType>
-int ttk::TrackingFromOverlap::computeOverlap(const float *pointCoordinates0,
-                                             const float *pointCoordinates1,
-                                             const labelType *pointLabels0,
-                                             const labelType *pointLabels1,
-                                             const size_t nPoints0,
-                                             const size_t nPoints1,
+int ttk::TrackingFromOverlap::preparePointSet(
+  const labelType *pointLabels,
+  const size_t nPoints,
+  LabeledPointSet &pointSet) const {
+
+  std::vector<SimplexId> sortedPoints;
+  std::vector<size_t> labelOffsets;
+  this->sortLabels(pointLabels, nPoints, sortedPoints, labelOffsets);
+
+  pointSet.nPoints = nPoints;
+  pointSet.nLabels = labelOffsets.size() - 1;
+  pointSet.labelIndices.resize(nPoints);
+  pointSet.sortedPoints.clear();
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < pointSet.nLabels; i++) {
+    for(size_t j = labelOffsets[i]; j < labelOffsets[i + 1]; j++) {
+      pointSet.labelIndices[sortedPoints[j]] = i;
+    }
+  }
+
+  return 1;
+}
+
+// =============================================================================
+// Track Nodes
+// =============================================================================
+inline int ttk::TrackingFromOverlap::computeOverlap(
+  const float *pointCoordinates0,
+  const float *pointCoordinates1,
+  LabeledPointSet &pointSet0,
+  LabeledPointSet &pointSet1,
+
+  Edges &edges) const {
+
+  const size_t nPoints0 = pointSet0.nPoints;
+  const size_t nPoints1 = pointSet1.nPoints;
 
-                                             Edges &edges) const {
   // -------------------------------------------------------------------------
-  // Compute labelIndexMaps
+  // Check if both point sets share the same coordinates
   // -------------------------------------------------------------------------
-  std::map<labelType, size_t> labelIndexMap0;
-  std::map<labelType, size_t> labelIndexMap1;
-  this->computeLabelIndexMap<labelType>(pointLabels0, nPoints0, labelIndexMap0);
-  this->computeLabelIndexMap<labelType>(pointLabels1, nPoints1, labelIndexMap1);
+  bool aligned = nPoints0 == nPoints1;
+  if(aligned && pointCoordinates0 != pointCoordinates1) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for reduction(&& : aligned) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < 3 * nPoints0; i++) {
+      aligned = aligned && pointCoordinates0[i] == pointCoordinates1[i];
+    }
+  }
 
   // -------------------------------------------------------------------------
   // Sort coordinates
   // -------------------------------------------------------------------------
-  std::vector<size_t> sortedIndicies0;
-  std::vector<size_t> sortedIndicies1;
-  this->sortCoordinates(pointCoordinates0, nPoints0, sortedIndicies0);
-  this->sortCoordinates(pointCoordinates1, nPoints1, sortedIndicies1);
+  if(!aligned) {
+    if(pointSet0.sortedPoints.size() != nPoints0)
+      this->sortCoordinates(
+        pointCoordinates0, nPoints0, pointSet0.sortedPoints);
+    if(pointSet1.sortedPoints.size() != nPoints1)
+      this->sortCoordinates(
+        pointCoordinates1, nPoints1, pointSet1.sortedPoints);
+  }
 
   // -------------------------------------------------------------------------
   // Track Nodes
@@ -328,97 +503,131 @@ int ttk::TrackingFromOverlap::computeOverlap(const float *pointCoordinates0,
   printMsg("Tracking .............. ", debug::Priority::PERFORMANCE);
   Timer t;
 
-  /* Function that determines configuration of point p0 and p1:
-      0: p0Coords = p1Coords
-     >0: p0Coords < p1Coords
-     <0: p0Coords > p1Coords
-  */
-  auto compare = [&](size_t p0, size_t p1) {
-    size_t p0CoordIndex = p0 * 3;
-    size_t p1CoordIndex = p1 * 3;
-
-    float p0_X = pointCoordinates0[p0CoordIndex++];
-    float p0_Y = pointCoordinates0[p0CoordIndex++];
-    float p0_Z = pointCoordinates0[p0CoordIndex];
-
-    float p1_X = pointCoordinates1[p1CoordIndex++];
-    float p1_Y = pointCoordinates1[p1CoordIndex++];
-    float p1_Z = pointCoordinates1[p1CoordIndex];
-
-    return p0_X == p1_X  ? p0_Y == p1_Y  ? p0_Z == p1_Z  ? 0
-                                           : p0_Z < p1_Z ? -1
-                                                         : 1
-                           : p0_Y < p1_Y ? -1
-                                         : 1
-           : p0_X < p1_X ? -1
-                         : 1;
-  };
-
-  size_t i = 0; // iterator for 0
-  size_t j = 0; // iterator for 1
-
-  size_t nEdges = 0;
-  std::unordered_map<size_t, std::unordered_map<size_t, size_t>> edgesMap;
-  // Iterate over both point sets synchronously using comparison function
-  while(i < nPoints0 && j < nPoints1) {
-    size_t pointIndex0 = sortedIndicies0[i];
-    size_t pointIndex1 = sortedIndicies1[j];
-
-    // Determine point configuration
-    int c = compare(pointIndex0, pointIndex1);
-
-    if(c == 0) { // Points have same coordinates -> track
-      labelType label0 = pointLabels0[pointIndex0];
-      labelType label1 = pointLabels1[pointIndex1];
-
-      size_t &nodeIndex0 = labelIndexMap0[label0];
-      size_t &nodeIndex1 = labelIndexMap1[label1];
+  const auto &labelIndices0 = pointSet0.labelIndices;
+  const auto &labelIndices1 = pointSet1.labelIndices;
+  const auto &sorted0 = pointSet0.sortedPoints;
+  const auto &sorted1 = pointSet1.sortedPoints;
+  const uint64_t nLabels1 = pointSet1.nLabels;
+
+  // Every chunk of points counts its overlaps in a sparse list of
+  // (label0 * nLabels1 + label1, overlap) pairs; consecutive points usually
+  // share the same pair of labels
+  using OverlapCounter = std::vector<std::pair<uint64_t, size_t>>;
+  const size_t nChunks = 4 * std::max(this->threadNumber_, 1);
+  std::vector<OverlapCounter> chunkOverlaps(nChunks);
+
+  // Chunk boundaries in both point sets. In the sorted case, points with
+  // equal coordinates are never split across chunks to match them in the
+  // same order as a sequential sweep.
+  std::vector<size_t> bounds0(nChunks + 1, nPoints0);
+  std::vector<size_t> bounds1(nChunks + 1, nPoints1);
+  for(size_t c = 0; c < nChunks; c++) {
+    size_t b = std::max(c * nPoints0 / nChunks, c > 0 ? bounds0[c - 1] : 0);
+    if(aligned) {
+      bounds0[c] = bounds1[c] = b;
+      continue;
+    }
+    while(b > 0 && b < nPoints0
+          && compareCoordinates(&pointCoordinates0[3 * sorted0[b - 1]],
+                                &pointCoordinates0[3 * sorted0[b]])
+               == 0)
+      b++;
+    bounds0[c] = b;
+    bounds1[c]
+      = b == 0 ? 0
+        : b == nPoints0
+          ? nPoints1
+          : std::lower_bound(sorted1.begin(), sorted1.end(), sorted0[b],
+                             [&](const SimplexId p1, const SimplexId p0) {
+                               return compareCoordinates(
+                                        &pointCoordinates1[3 * p1],
+                                        &pointCoordinates0[3 * p0])
+                                      < 0;
+                             })
+              - sorted1.begin();
+  }
 
-      // Find edge and increase overlap counter
-      auto edges0 = edgesMap.find(nodeIndex0); // Edges from label0 to nodes1
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t c = 0; c < nChunks; c++) {
+    auto &overlaps = chunkOverlaps[c];
+
+    const auto addOverlap = [&](const SimplexId p0, const SimplexId p1) {
+      const uint64_t key = labelIndices0[p0] * nLabels1 + labelIndices1[p1];
+      if(!overlaps.empty() && overlaps.back().first == key)
+        overlaps.back().second++;
+      else
+        overlaps.emplace_back(key, 1);
+    };
 
-      // If map does not exist then create it
-      if(edges0 == edgesMap.end()) {
-        edgesMap[nodeIndex0] = std::unordered_map<size_t, size_t>();
-        edges0 = edgesMap.find(nodeIndex0);
+    if(aligned) {
+      for(size_t i = bounds0[c]; i < bounds0[c + 1]; i++)
+        addOverlap(i, i);
+    } else {
+      size_t i = bounds0[c]; // iterator for 0
+      size_t j = bounds1[c]; // iterator for 1
+      // Iterate over both point sets synchronously using comparison function
+      while(i < bounds0[c + 1] && j < bounds1[c + 1]) {
+        const SimplexId pointIndex0 = sorted0[i];
+        const SimplexId pointIndex1 = sorted1[j];
+
+        int cmp = compareCoordinates(&pointCoordinates0[3 * pointIndex0],
+                                     &pointCoordinates1[3 * pointIndex1]);
+
+        if(cmp == 0) { // Points have same coordinates -> track
+          addOverlap(pointIndex0, pointIndex1);
+          i++;
+          j++;
+        } else if(cmp > 0) { // p1 in front of p0 -> let p1 catch up
+          j++;
+        } else { // p0 in front of p1 -> let p0 catch up
+          i++;
+        }
       }
+    }
 
-      // Find edge label0 -> label1
-      auto edge = edges0->second.find(nodeIndex1);
-
-      // If edge does not exist then create it
-      if(edge == edges0->second.end()) {
-        edges0->second[nodeIndex1] = 0;
-        edge = edges0->second.find(nodeIndex1);
-        nEdges++;
-      }
+    // merge the overlaps of identical label pairs
+    std::sort(overlaps.begin(), overlaps.end());
+    size_t q = 0;
+    for(size_t k = 0; k < overlaps.size(); k++) {
+      if(q > 0 && overlaps[q - 1].first == overlaps[k].first)
+        overlaps[q - 1].second += overlaps[k].second;
+      else
+        overlaps[q++] = overlaps[k];
+    }
+    overlaps.resize(q);
+  }
 
-      // Increase overlap
-      edge->second++;
+  // merge the chunk counters by key
+  OverlapCounter overlaps;
+  for(auto &chunk : chunkOverlaps) {
+    overlaps.insert(overlaps.end(), chunk.begin(), chunk.end());
+    OverlapCounter().swap(chunk);
+  }
+  std::sort(overlaps.begin(), overlaps.end());
 
-      i++;
-      j++;
-    } else if(c > 0) { // p0 in front of p1 -> let p1 catch up
-      j++;
-    } else { // p1 in front of p0 -> let p0 catch up
-      i++;
-    }
+  size_t nEdges = 0;
+  for(size_t k = 0; k < overlaps.size(); k++) {
+    if(nEdges > 0 && overlaps[nEdges - 1].first == overlaps[k].first)
+      overlaps[nEdges - 1].second += overlaps[k].second;
+    else
+      overlaps[nEdges++] = overlaps[k];
   }
 
   // -------------------------------------------------------------------------
   // Pack Output
   // -------------------------------------------------------------------------
-  {
-    edges.resize(nEdges * 4);
-    size_t q = 0;
-    for(auto &it0 : edgesMap) {
-      for(auto &it1 : it0.second) {
-        edges[q++] = it0.first;
-        edges[q++] = it1.first;
-        edges[q++] = it1.second;
-        edges[q++] = -1;
-      }
-    }
+  edges.resize(nEdges * 4);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t k = 0; k < nEdges; k++) {
+    edges[4 * k] = overlaps[k].first / nLabels1;
+    edges[4 * k + 1] = overlaps[k].first % nLabels1;
+    edges[4 * k + 2] = overlaps[k].second;
+    edges[4 * k + 3] = -1;
   }
 
   // Print Status
@@ -430,3 +639,20 @@ int ttk::TrackingFromOverlap::computeOverlap(const float *pointCoordinates0,
 
   return 0;
 }
+
+template <typename labelType>
+int ttk::TrackingFromOverlap::computeOverlap(const float *pointCoordinates0,
+                                             const float *pointCoordinates1,
+                                             const labelType *pointLabels0,
+                                             const labelType *pointLabels1,
+                                             const size_t nPoints0,
+                                             const size_t nPoints1,
+
+                                             Edges &edges) const {
+  LabeledPointSet pointSet0{}, pointSet1{};
+  this->preparePointSet(pointLabels0, nPoints0, pointSet0);
+  this->preparePointSet(pointLabels1, nPoints1, pointSet1);
+
+  return this->computeOverlap(
+    pointCoordinates0, pointCoordinates1, pointSet0, pointSet1, edges);
+}
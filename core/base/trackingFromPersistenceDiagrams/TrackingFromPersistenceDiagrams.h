@@ -25,7 +25,8 @@ namespace ttk {
     template <typename dataType>
     int performSingleMatching(
       int i,
-      std::vector<std::vector<diagramTuple>> &inputPersistenceDiagrams,
+      std::vector<PersistenceDiagramColumns<dataType>>
+        &inputPersistenceDiagrams,
       std::vector<std::vector<matchingTuple>> &outputMatchings,
       const std::string &algorithm,
       const std::string &wasserstein,
@@ -41,7 +42,8 @@ namespace ttk {
     template <typename dataType>
     int performMatchings(
       int numInputs,
-      std::vector<std::vector<diagramTuple>> &inputPersistenceDiagrams,
+      std::vector<PersistenceDiagramColumns<dataType>>
+        &inputPersistenceDiagrams,
       std::vector<std::vector<matchingTuple>> &outputMatchings,
       const std::string &algorithm,
       const std::string &wasserstein,
@@ -55,15 +57,25 @@ namespace ttk {
       double pe);
 
     template <typename dataType>
-    int performTracking(std::vector<std::vector<diagramTuple>> &allDiagrams,
-                        std::vector<std::vector<matchingTuple>> &allMatchings,
-                        std::vector<trackingTuple> &trackings);
+    int performTracking(
+      std::vector<PersistenceDiagramColumns<dataType>> &allDiagrams,
+      std::vector<std::vector<matchingTuple>> &allMatchings,
+      std::vector<trackingTuple> &trackings);
 
     template <typename dataType>
-    int performPostProcess(std::vector<std::vector<diagramTuple>> &allDiagrams,
-                           std::vector<trackingTuple> &trackings,
-                           std::vector<std::set<int>> &trackingTupleToMerged,
-                           double postProcThresh);
+    int performPostProcess(
+      std::vector<PersistenceDiagramColumns<dataType>> &allDiagrams,
+      std::vector<trackingTuple> &trackings,
+      std::vector<std::set<int>> &trackingTupleToMerged,
+      double postProcThresh);
+
+    /// Position of the extremum of the i-th pair of a diagram (its maximum
+    /// if any). Returns false for saddle-saddle pairs.
+    template <typename dataType>
+    static bool getExtremumPoint(const PersistenceDiagramColumns<dataType> &d,
+                                 int i,
+                                 bool &isMax,
+                                 double p[3]);
 
     /// Pass a pointer to an input array representing a scalarfield.
     /// The array is expected to be correctly allocated. idx in
@@ -118,7 +130,7 @@ int ttk::TrackingFromPersistenceDiagrams::execute() {
 template <typename dataType>
 int ttk::TrackingFromPersistenceDiagrams::performSingleMatching(
   int i,
-  std::vector<std::vector<diagramTuple>> &inputPersistenceDiagrams,
+  std::vector<PersistenceDiagramColumns<dataType>> &inputPersistenceDiagrams,
   std::vector<std::vector<matchingTuple>> &outputMatchings,
   const std::string &algorithm,
   const std::string &wasserstein,
@@ -141,10 +153,9 @@ int ttk::TrackingFromPersistenceDiagrams::performSingleMatching(
   bottleneckDistance_.setAlgorithm(algorithm);
   bottleneckDistance_.setWasserstein(wasserstein);
 
-  bottleneckDistance_.setCTDiagram1(&inputPersistenceDiagrams[i]);
-  bottleneckDistance_.setCTDiagram2(&inputPersistenceDiagrams[i + 1]);
-  bottleneckDistance_.setOutputMatchings(&outputMatchings[i]);
-  bottleneckDistance_.execute<dataType>(false);
+  bottleneckDistance_.execute<dataType>(inputPersistenceDiagrams[i],
+                                        inputPersistenceDiagrams[i + 1],
+                                        outputMatchings[i], false);
 
   return 0;
 }
@@ -152,7 +163,7 @@ int ttk::TrackingFromPersistenceDiagrams::performSingleMatching(
 template <typename dataType>
 int ttk::TrackingFromPersistenceDiagrams::performMatchings(
   int numInputs,
-  std::vector<std::vector<diagramTuple>> &inputPersistenceDiagrams,
+  std::vector<PersistenceDiagramColumns<dataType>> &inputPersistenceDiagrams,
   std::vector<std::vector<matchingTuple>> &outputMatchings,
   const std::string &algorithm,
   const std::string &wasserstein,
@@ -185,7 +196,7 @@ int ttk::TrackingFromPersistenceDiagrams::performMatchings(
 
 template <typename dataType>
 int ttk::TrackingFromPersistenceDiagrams::performTracking(
-  std::vector<std::vector<diagramTuple>> &allDiagrams,
+  std::vector<PersistenceDiagramColumns<dataType>> &allDiagrams,
   std::vector<std::vector<matchingTuple>> &allMatchings,
   std::vector<trackingTuple> &trackings) {
   auto numPersistenceDiagramsInput = (int)allDiagrams.size();
@@ -273,9 +284,33 @@ int ttk::TrackingFromPersistenceDiagrams::performTracking(
   return 0;
 }
 
+template <typename dataType>
+bool ttk::TrackingFromPersistenceDiagrams::getExtremumPoint(
+  const PersistenceDiagramColumns<dataType> &d,
+  const int i,
+  bool &isMax,
+  double p[3]) {
+  const BNodeType t1 = d.birthType[i];
+  const BNodeType t2 = d.deathType[i];
+  isMax = t1 == BLocalMax || t2 == BLocalMax;
+  const bool isMin = !isMax && (t1 == BLocalMin || t2 == BLocalMin);
+  if(isMax) {
+    p[0] = d.deathX[i];
+    p[1] = d.deathY[i];
+    p[2] = d.deathZ[i];
+  } else if(isMin) {
+    p[0] = d.birthX[i];
+    p[1] = d.birthY[i];
+    p[2] = d.birthZ[i];
+  } else {
+    p[0] = p[1] = p[2] = 0;
+  }
+  return isMax || isMin;
+}
+
 template <typename dataType>
 int ttk::TrackingFromPersistenceDiagrams::performPostProcess(
-  std::vector<std::vector<diagramTuple>> &allDiagrams,
+  std::vector<PersistenceDiagramColumns<dataType>> &allDiagrams,
   std::vector<trackingTuple> &trackings,
   std::vector<std::set<int>> &trackingTupleToMerged,
   double postProcThresh) {
@@ -289,47 +324,16 @@ int ttk::TrackingFromPersistenceDiagrams::performPostProcess(
     if(endK < 0)
       endK = numPersistenceDiagramsInput - 1;
     std::vector<BIdVertex> chainK = std::get<2>(tk);
-    std::vector<diagramTuple> &diagramStartK = allDiagrams[startK];
-    std::vector<diagramTuple> &diagramEndK = allDiagrams[endK];
 
     auto n1 = (int)chainK.at(0);
     auto n2 = (int)chainK.at(chainK.size() - 1);
-    diagramTuple &tuple1 = diagramStartK[n1];
-    diagramTuple &tuple2 = diagramEndK[n2];
-
-    double x1, y1, z1, x2, y2, z2;
-
-    BNodeType point1Type1 = std::get<1>(tuple1);
-    BNodeType point1Type2 = std::get<3>(tuple1);
-    bool t11Min = point1Type1 == BLocalMin;
-    bool t11Max = point1Type1 == BLocalMax;
-    bool t12Min = point1Type2 == BLocalMin;
-    bool t12Max = point1Type2 == BLocalMax;
-    // bool bothEx1 = t11Ex && t12Ex;
-    bool t1Max = t11Max || t12Max;
-    bool t1Min = !t1Max && (t11Min || t12Min);
-
-    x1 = t1Max ? std::get<11>(tuple1) : t1Min ? std::get<7>(tuple1) : 0;
-    y1 = t1Max ? std::get<12>(tuple1) : t1Min ? std::get<8>(tuple1) : 0;
-    z1 = t1Max ? std::get<13>(tuple1) : t1Min ? std::get<9>(tuple1) : 0;
-
-    BNodeType point2Type1 = std::get<1>(tuple2);
-    BNodeType point2Type2 = std::get<3>(tuple2);
-    bool t21Min = point2Type1 == BLocalMin;
-    bool t21Max = point2Type1 == BLocalMax;
-    bool t22Min = point2Type2 == BLocalMin;
-    bool t22Max = point2Type2 == BLocalMax;
-    // bool bothEx2 = t21Ex && t22Ex;
-    bool t2Max = t21Max || t22Max;
-    bool t2Min = !t2Max && (t21Min || t22Min);
-
-    // if (bothEx2) {
-    x2 = t2Max ? std::get<11>(tuple2) : t2Min ? std::get<7>(tuple2) : 0;
-    y2 = t2Max ? std::get<12>(tuple2) : t2Min ? std::get<8>(tuple2) : 0;
-    z2 = t2Max ? std::get<13>(tuple2) : t2Min ? std::get<9>(tuple2) : 0;
-    // }
-    // if (!bothEx1 && !bothEx2)
-    //  continue;
+
+    double p1[3], p2[3];
+    bool t1Max{}, t2Max{};
+    const bool t1Ex = getExtremumPoint(allDiagrams[startK], n1, t1Max, p1);
+    const bool t2Ex = getExtremumPoint(allDiagrams[endK], n2, t2Max, p2);
+    const bool t1Min = t1Ex && !t1Max;
+    const bool t2Min = t2Ex && !t2Max;
 
     // Saddle-saddle matching not supported.
     if(!t1Min && !t2Min && !t1Max && !t2Max)
@@ -354,31 +358,16 @@ int ttk::TrackingFromPersistenceDiagrams::performPostProcess(
 
         /// Check proximity.
         auto n3 = (int)chainM[c];
-        std::vector<diagramTuple> &diagramM = allDiagrams[startM + c];
-        diagramTuple &tuple3 = diagramM[n3];
-        double x3, y3, z3;
-        BNodeType point3Type1 = std::get<1>(tuple3);
-        BNodeType point3Type2 = std::get<3>(tuple3);
-        bool t31Min = point3Type1 == BLocalMin;
-        bool t31Max = point3Type1 == BLocalMax;
-        bool t32Min = point3Type2 == BLocalMin;
-        bool t32Max = point3Type2 == BLocalMax;
-        // bool bothEx3 = t31Ex && t32Ex;
-        // if (!bothEx3)
-        //  continue;
-        bool t3Max = t31Max || t32Max;
-        bool t3Min = !t3Max && (t31Min || t32Min);
-
-        x3 = t3Max ? std::get<11>(tuple3) : t3Min ? std::get<7>(tuple3) : 0;
-        y3 = t3Max ? std::get<12>(tuple3) : t3Min ? std::get<8>(tuple3) : 0;
-        z3 = t3Max ? std::get<13>(tuple3) : t3Min ? std::get<9>(tuple3) : 0;
+        double p3[3];
+        bool t3Max{};
+        const bool t3Ex
+          = getExtremumPoint(allDiagrams[startM + c], n3, t3Max, p3);
+        const bool t3Min = t3Ex && !t3Max;
 
         double dist = 0;
         bool hasMatched = false;
         if(doMatch1 && ((t3Max && t1Max) || (t3Min && t1Min))) {
-          double dist13
-            = sqrt(Geometry::pow(x1 - x3, 2) + Geometry::pow(y1 - y3, 2)
-                   + Geometry::pow(z1 - z3, 2));
+          double dist13 = Geometry::distance(p1, p3);
           dist = dist13;
           if(dist13 >= postProcThresh)
             continue;
@@ -386,9 +375,7 @@ int ttk::TrackingFromPersistenceDiagrams::performPostProcess(
         }
 
         if(doMatch2 && ((t3Max && t2Max) || (t3Min && t2Min))) {
-          double dist23
-            = sqrt(Geometry::pow(x2 - x3, 2) + Geometry::pow(y2 - y3, 2)
-                   + Geometry::pow(z2 - z3, 2));
+          double dist23 = Geometry::distance(p2, p3);
           dist = dist23;
           if(dist23 >= postProcThresh)
             continue;
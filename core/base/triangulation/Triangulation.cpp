@@ -14,37 +14,35 @@ Triangulation::Triangulation(const Triangulation &rhs)
   : AbstractTriangulation(rhs), abstractTriangulation_{nullptr},
     explicitTriangulation_{rhs.explicitTriangulation_},
     implicitTriangulation_{rhs.implicitTriangulation_},
-    periodicImplicitTriangulation_{rhs.periodicImplicitTriangulation_} {
+    implicitTriangulation2D_{rhs.implicitTriangulation2D_},
+    implicitTriangulation3D_{rhs.implicitTriangulation3D_},
+    periodicImplicitTriangulation_{rhs.periodicImplicitTriangulation_},
+    periodicImplicitTriangulation2D_{rhs.periodicImplicitTriangulation2D_},
+    periodicImplicitTriangulation3D_{rhs.periodicImplicitTriangulation3D_} {
 
   gridDimensions_ = rhs.gridDimensions_;
   hasPeriodicBoundaries_ = rhs.hasPeriodicBoundaries_;
 
-  if(rhs.abstractTriangulation_ == &rhs.explicitTriangulation_) {
-    abstractTriangulation_ = &explicitTriangulation_;
-  } else if(rhs.abstractTriangulation_ == &rhs.implicitTriangulation_) {
-    abstractTriangulation_ = &implicitTriangulation_;
-  } else if(rhs.abstractTriangulation_ == &rhs.periodicImplicitTriangulation_) {
-    abstractTriangulation_ = &periodicImplicitTriangulation_;
-  }
+  this->setActiveTriangulation(rhs);
 }
 
 Triangulation::Triangulation(Triangulation &&rhs) noexcept
   : AbstractTriangulation(std::move(rhs)), abstractTriangulation_{nullptr},
     explicitTriangulation_{std::move(rhs.explicitTriangulation_)},
     implicitTriangulation_{std::move(rhs.implicitTriangulation_)},
+    implicitTriangulation2D_{std::move(rhs.implicitTriangulation2D_)},
+    implicitTriangulation3D_{std::move(rhs.implicitTriangulation3D_)},
     periodicImplicitTriangulation_{
-      std::move(rhs.periodicImplicitTriangulation_)} {
+      std::move(rhs.periodicImplicitTriangulation_)},
+    periodicImplicitTriangulation2D_{
+      std::move(rhs.periodicImplicitTriangulation2D_)},
+    periodicImplicitTriangulation3D_{
+      std::move(rhs.periodicImplicitTriangulation3D_)} {
 
   gridDimensions_ = std::move(rhs.gridDimensions_);
   hasPeriodicBoundaries_ = rhs.hasPeriodicBoundaries_;
 
-  if(rhs.abstractTriangulation_ == &rhs.explicitTriangulation_) {
-    abstractTriangulation_ = &explicitTriangulation_;
-  } else if(rhs.abstractTriangulation_ == &rhs.implicitTriangulation_) {
-    abstractTriangulation_ = &implicitTriangulation_;
-  } else if(rhs.abstractTriangulation_ == &rhs.periodicImplicitTriangulation_) {
-    abstractTriangulation_ = &periodicImplicitTriangulation_;
-  }
+  this->setActiveTriangulation(rhs);
 }
 
 Triangulation &Triangulation::operator=(const Triangulation &rhs) {
@@ -54,17 +52,14 @@ Triangulation &Triangulation::operator=(const Triangulation &rhs) {
     abstractTriangulation_ = nullptr;
     explicitTriangulation_ = rhs.explicitTriangulation_;
     implicitTriangulation_ = rhs.implicitTriangulation_;
+    implicitTriangulation2D_ = rhs.implicitTriangulation2D_;
+    implicitTriangulation3D_ = rhs.implicitTriangulation3D_;
     periodicImplicitTriangulation_ = rhs.periodicImplicitTriangulation_;
+    periodicImplicitTriangulation2D_ = rhs.periodicImplicitTriangulation2D_;
+    periodicImplicitTriangulation3D_ = rhs.periodicImplicitTriangulation3D_;
     hasPeriodicBoundaries_ = rhs.hasPeriodicBoundaries_;
 
-    if(rhs.abstractTriangulation_ == &rhs.explicitTriangulation_) {
-      abstractTriangulation_ = &explicitTriangulation_;
-    } else if(rhs.abstractTriangulation_ == &rhs.implicitTriangulation_) {
-      abstractTriangulation_ = &implicitTriangulation_;
-    } else if(rhs.abstractTriangulation_
-              == &rhs.periodicImplicitTriangulation_) {
-      abstractTriangulation_ = &periodicImplicitTriangulation_;
-    }
+    this->setActiveTriangulation(rhs);
   }
   return *this;
 }
@@ -76,20 +71,32 @@ Triangulation &Triangulation::operator=(Triangulation &&rhs) noexcept {
     abstractTriangulation_ = nullptr;
     explicitTriangulation_ = std::move(rhs.explicitTriangulation_);
     implicitTriangulation_ = std::move(rhs.implicitTriangulation_);
+    implicitTriangulation2D_ = std::move(rhs.implicitTriangulation2D_);
+    implicitTriangulation3D_ = std::move(rhs.implicitTriangulation3D_);
     periodicImplicitTriangulation_
       = std::move(rhs.periodicImplicitTriangulation_);
+    periodicImplicitTriangulation2D_
+      = std::move(rhs.periodicImplicitTriangulation2D_);
+    periodicImplicitTriangulation3D_
+      = std::move(rhs.periodicImplicitTriangulation3D_);
     hasPeriodicBoundaries_ = std::move(rhs.hasPeriodicBoundaries_);
 
-    if(rhs.abstractTriangulation_ == &rhs.explicitTriangulation_) {
-      abstractTriangulation_ = &explicitTriangulation_;
-    } else if(rhs.abstractTriangulation_ == &rhs.implicitTriangulation_) {
-      abstractTriangulation_ = &implicitTriangulation_;
-    } else if(rhs.abstractTriangulation_
-              == &rhs.periodicImplicitTriangulation_) {
-      abstractTriangulation_ = &periodicImplicitTriangulation_;
-    }
+    this->setActiveTriangulation(rhs);
   }
   return *this;
 }
 
 Triangulation::~Triangulation() = default;
+
+void Triangulation::setActiveTriangulation(const Triangulation &rhs) {
+  // the grid dimensions and the boundary conditions are already copied
+  if(rhs.abstractTriangulation_ == nullptr) {
+    abstractTriangulation_ = nullptr;
+  } else if(rhs.abstractTriangulation_ == &rhs.explicitTriangulation_) {
+    abstractTriangulation_ = &explicitTriangulation_;
+  } else if(hasPeriodicBoundaries_) {
+    abstractTriangulation_ = this->getPeriodicImplicitTriangulation();
+  } else {
+    abstractTriangulation_ = this->getImplicitTriangulation();
+  }
+}
@@ -55,7 +55,19 @@ namespace ttk {
     Triangulation &operator=(Triangulation &&) noexcept;
     ~Triangulation();
 
-    enum class Type { EXPLICIT, IMPLICIT, PERIODIC };
+    /// Internal representations of the triangulation. Implicit
+    /// triangulations of 2D and 3D grids are specialized on the grid
+    /// dimension (IMPLICIT and PERIODIC then refer to lower-dimensional
+    /// grids).
+    enum class Type {
+      EXPLICIT,
+      IMPLICIT,
+      IMPLICIT_2D,
+      IMPLICIT_3D,
+      PERIODIC,
+      PERIODIC_2D,
+      PERIODIC_3D
+    };
 
     /// Reset the triangulation data-structures.
     /// \return Returns 0 upon success, negative values otherwise.
@@ -1217,7 +1229,7 @@ namespace ttk {
     }
 
     /// Get the type of internal representation for the triangulation
-    /// (explicit, implicit, periodic).
+    /// (explicit, implicit, periodic, specialized on the grid dimension).
     ///
     /// \return Returns the current type of the triangulation.
     /// \sa setPeriodicBoundaryConditions()
@@ -1226,6 +1238,14 @@ namespace ttk {
         return Triangulation::Type::EXPLICIT;
       else if(abstractTriangulation_ == &implicitTriangulation_)
         return Triangulation::Type::IMPLICIT;
+      else if(abstractTriangulation_ == &implicitTriangulation2D_)
+        return Triangulation::Type::IMPLICIT_2D;
+      else if(abstractTriangulation_ == &implicitTriangulation3D_)
+        return Triangulation::Type::IMPLICIT_3D;
+      else if(abstractTriangulation_ == &periodicImplicitTriangulation2D_)
+        return Triangulation::Type::PERIODIC_2D;
+      else if(abstractTriangulation_ == &periodicImplicitTriangulation3D_)
+        return Triangulation::Type::PERIODIC_3D;
       else
         return Triangulation::Type::PERIODIC;
     }
@@ -2218,6 +2238,25 @@ namespace ttk {
       return abstractTriangulation_->preconditionVertexNeighbors();
     }
 
+    /// Pre-process the vertex neighbors within a memory budget.
+    ///
+    /// Explicit triangulations then compute the vertex neighbors by
+    /// blocks of vertices on first access and evict the least recently
+    /// used blocks once the budget is exceeded (implicit triangulations
+    /// do not store them). The budget only applies to this request.
+    ///
+    /// \param memoryBudget Memory budget in bytes (0: no bound).
+    /// \return Returns 0 upon success, negative values otherwise.
+    /// \sa AbstractTriangulation::preconditionVertexNeighbors(const size_t)
+    inline int preconditionVertexNeighbors(const size_t memoryBudget) {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+      if(isEmptyCheck())
+        return -1;
+#endif
+      return abstractTriangulation_->preconditionVertexNeighbors(memoryBudget);
+    }
+
     /// Pre-process the vertex stars.
     ///
     /// This function should ONLY be called as a pre-condition to the
@@ -2245,6 +2284,25 @@ namespace ttk {
       return abstractTriangulation_->preconditionVertexStars();
     }
 
+    /// Pre-process the vertex stars within a memory budget.
+    ///
+    /// Explicit triangulations then compute the vertex stars by
+    /// blocks of vertices on first access and evict the least recently
+    /// used blocks once the budget is exceeded (implicit triangulations
+    /// do not store them). The budget only applies to this request.
+    ///
+    /// \param memoryBudget Memory budget in bytes (0: no bound).
+    /// \return Returns 0 upon success, negative values otherwise.
+    /// \sa AbstractTriangulation::preconditionVertexStars(const size_t)
+    inline int preconditionVertexStars(const size_t memoryBudget) {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+      if(isEmptyCheck())
+        return -1;
+#endif
+      return abstractTriangulation_->preconditionVertexStars(memoryBudget);
+    }
+
     /// Pre-process the vertex triangles.
     ///
     /// This function should ONLY be called as a pre-condition to the
@@ -2275,7 +2333,11 @@ namespace ttk {
     inline int setDebugLevel(const int &debugLevel) {
       explicitTriangulation_.setDebugLevel(debugLevel);
       implicitTriangulation_.setDebugLevel(debugLevel);
+      implicitTriangulation2D_.setDebugLevel(debugLevel);
+      implicitTriangulation3D_.setDebugLevel(debugLevel);
       periodicImplicitTriangulation_.setDebugLevel(debugLevel);
+      periodicImplicitTriangulation2D_.setDebugLevel(debugLevel);
+      periodicImplicitTriangulation3D_.setDebugLevel(debugLevel);
       debugLevel_ = debugLevel;
       return 0;
     }
@@ -2370,23 +2432,42 @@ namespace ttk {
       gridDimensions_[1] = yDim;
       gridDimensions_[2] = zDim;
 
-      int retPeriodic = periodicImplicitTriangulation_.setInputGrid(
-        xOrigin, yOrigin, zOrigin, xSpacing, ySpacing, zSpacing, xDim, yDim,
-        zDim);
-      int ret = implicitTriangulation_.setInputGrid(xOrigin, yOrigin, zOrigin,
-                                                    xSpacing, ySpacing,
-                                                    zSpacing, xDim, yDim, zDim);
+      // only the triangulations specialized on the grid dimension are set
+      const auto periodic = this->getPeriodicImplicitTriangulation();
+      const auto implicit = this->getImplicitTriangulation();
+
+      int retPeriodic
+        = periodic->setInputGrid(xOrigin, yOrigin, zOrigin, xSpacing, ySpacing,
+                                 zSpacing, xDim, yDim, zDim);
+      int ret = implicit->setInputGrid(xOrigin, yOrigin, zOrigin, xSpacing,
+                                       ySpacing, zSpacing, xDim, yDim, zDim);
 
       if(hasPeriodicBoundaries_) {
-        abstractTriangulation_ = &periodicImplicitTriangulation_;
+        abstractTriangulation_ = periodic;
         return retPeriodic;
       } else {
-        abstractTriangulation_ = &implicitTriangulation_;
+        abstractTriangulation_ = implicit;
         return ret;
       }
       return 0;
     }
 
+    /// Enable or disable the per-simplex lookup tables of the implicit
+    /// triangulation (enabled by default, see the
+    /// TTK_ENABLE_IMPLICIT_LOOKUP_TABLES CMake option). Without them, the
+    /// position and the grid coordinates of a simplex are computed on each
+    /// query, which trades some query speed for a memory footprint
+    /// independent of the grid size: vertex neighbor queries are up to 2.7
+    /// times slower.
+    ///
+    /// \param useLookupTables Use the lookup tables (default: true).
+    /// \sa ImplicitTriangulation::setLookupTables()
+    inline void setImplicitLookupTables(const bool useLookupTables) {
+      implicitTriangulation_.setLookupTables(useLookupTables);
+      implicitTriangulation2D_.setLookupTables(useLookupTables);
+      implicitTriangulation3D_.setLookupTables(useLookupTables);
+    }
+
     /// Set the input grid to use period boundary conditions.
     ///
     /// \param usePeriodicBoundaries If this set to true then a triangulation
@@ -2394,15 +2475,16 @@ namespace ttk {
     inline void
       setPeriodicBoundaryConditions(const bool &usePeriodicBoundaries) {
 
-      if((abstractTriangulation_ == &implicitTriangulation_)
-         || (abstractTriangulation_ == &periodicImplicitTriangulation_)) {
+      if((abstractTriangulation_ == this->getImplicitTriangulation())
+         || (abstractTriangulation_
+             == this->getPeriodicImplicitTriangulation())) {
         if(usePeriodicBoundaries == hasPeriodicBoundaries_) {
           return;
         }
         if(usePeriodicBoundaries) {
-          abstractTriangulation_ = &periodicImplicitTriangulation_;
+          abstractTriangulation_ = this->getPeriodicImplicitTriangulation();
         } else {
-          abstractTriangulation_ = &implicitTriangulation_;
+          abstractTriangulation_ = this->getImplicitTriangulation();
         }
 
         // reset hasPreconditioned boolean
@@ -2442,7 +2524,11 @@ namespace ttk {
     inline int setThreadNumber(const ThreadId threadNumber) {
       explicitTriangulation_.setThreadNumber(threadNumber);
       implicitTriangulation_.setThreadNumber(threadNumber);
+      implicitTriangulation2D_.setThreadNumber(threadNumber);
+      implicitTriangulation3D_.setThreadNumber(threadNumber);
       periodicImplicitTriangulation_.setThreadNumber(threadNumber);
+      periodicImplicitTriangulation2D_.setThreadNumber(threadNumber);
+      periodicImplicitTriangulation3D_.setThreadNumber(threadNumber);
       threadNumber_ = threadNumber;
       return 0;
     }
@@ -2452,7 +2538,11 @@ namespace ttk {
     inline int setWrapper(const Wrapper *wrapper) {
       explicitTriangulation_.setWrapper(wrapper);
       implicitTriangulation_.setWrapper(wrapper);
+      implicitTriangulation2D_.setWrapper(wrapper);
+      implicitTriangulation3D_.setWrapper(wrapper);
       periodicImplicitTriangulation_.setWrapper(wrapper);
+      periodicImplicitTriangulation2D_.setWrapper(wrapper);
+      periodicImplicitTriangulation3D_.setWrapper(wrapper);
       return 0;
     }
 
@@ -2465,10 +2555,52 @@ namespace ttk {
       return false;
     }
 
+    /// Number of grid dimensions with more than one vertex.
+    inline int getGridDimensionality() const {
+      if(gridDimensions_[0] < 1 || gridDimensions_[1] < 1
+         || gridDimensions_[2] < 1)
+        return -1;
+      return (gridDimensions_[0] > 1) + (gridDimensions_[1] > 1)
+             + (gridDimensions_[2] > 1);
+    }
+
+    /// Implicit triangulation matching the dimension of the current grid.
+    inline ImplicitTriangulation *getImplicitTriangulation() {
+      switch(this->getGridDimensionality()) {
+        case 3:
+          return &implicitTriangulation3D_;
+        case 2:
+          return &implicitTriangulation2D_;
+        default:
+          return &implicitTriangulation_;
+      }
+    }
+
+    /// Periodic implicit triangulation matching the dimension of the
+    /// current grid.
+    inline PeriodicImplicitTriangulation *getPeriodicImplicitTriangulation() {
+      switch(this->getGridDimensionality()) {
+        case 3:
+          return &periodicImplicitTriangulation3D_;
+        case 2:
+          return &periodicImplicitTriangulation2D_;
+        default:
+          return &periodicImplicitTriangulation_;
+      }
+    }
+
+    /// Point to the member matching the active triangulation of @p rhs
+    /// (used by the copy and move operators).
+    void setActiveTriangulation(const Triangulation &rhs);
+
     AbstractTriangulation *abstractTriangulation_;
     ExplicitTriangulation explicitTriangulation_;
     ImplicitTriangulation implicitTriangulation_;
+    ImplicitTriangulation2D implicitTriangulation2D_;
+    ImplicitTriangulation3D implicitTriangulation3D_;
     PeriodicImplicitTriangulation periodicImplicitTriangulation_;
+    PeriodicImplicitTriangulation2D periodicImplicitTriangulation2D_;
+    PeriodicImplicitTriangulation3D periodicImplicitTriangulation3D_;
   };
 } // namespace ttk
 
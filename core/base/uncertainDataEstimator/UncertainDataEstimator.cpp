@@ -4,44 +4,117 @@ ttk::UncertainDataEstimator::UncertainDataEstimator() {
   this->setDebugMsgPrefix("UncertainDataEstimator");
 }
 
-void ttk::PDFHistograms::getVertexHistogram(
-  const ttk::SimplexId vertexId, std::vector<double> &histogram) const {
+int ttk::UncertainDataEstimator::startStreaming() {
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(!vertexNumber_)
+    return -2;
+  if(!outputMeanField_)
+    return -7;
+  if(withHistogramRange_ && !(histogramRange_[0] < histogramRange_[1])) {
+    this->printErr("Empty histogram range.");
+    return -9;
+  }
+#endif
 
-  histogram.resize(numberOfBins_);
-  if(vertexId < numberOfVertices_) {
+  numberOfMembers_ = 0;
+  histogramPass_ = false;
+  // as in the batch mode, the histograms need both bounds
+  computeHistograms_ = BinCount > 0 && ComputeLowerBound && ComputeUpperBound;
+
+  histograms_.setThreadNumber(threadNumber_);
+  histograms_.setDebugLevel(debugLevel_);
+  histograms_.reset();
+  histograms_.setNumberOfVertices(vertexNumber_);
+  histograms_.setNumberOfBins(BinCount);
+  if(computeHistograms_ && singlePass_ && !withHistogramRange_) {
+    this->printWrn("Single pass without histogram range: no histograms.");
+    computeHistograms_ = false;
+  }
+  if(withHistogramRange_) {
+    histograms_.setRange(histogramRange_[0], histogramRange_[1]);
+  }
+
+  return 0;
+}
+
+int ttk::UncertainDataEstimator::startHistogramPass() {
+  if(!needsHistogramPass())
+    return 0;
+
+  histogramPass_ = true;
+  if(!(range_[0] < range_[1])) {
+    this->printWrn("Constant ensemble: no histograms.");
+    computeHistograms_ = false;
+    return 0;
+  }
+  histograms_.reset();
+  histograms_.setRange(range_[0], range_[1]);
+
+  return 0;
+}
+
+int ttk::UncertainDataEstimator::endStreaming() {
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(!numberOfMembers_)
+    return -1;
+  if(this->needsHistogramPass()) {
+    this->printErr("Missing histogram pass.");
+    return -8;
+  }
+#endif
+
+  // Mean field
+  double *outputMeanField = static_cast<double *>(outputMeanField_);
+  const double numberOfMembers = static_cast<double>(numberOfMembers_);
 #ifdef TTK_ENABLE_OPENMP
-#ifdef _WIN32
 #pragma omp parallel for num_threads(threadNumber_)
-#else
-#pragma omp parallel for num_threads(threadNumber_) \
-  schedule(static, numberOfBins_ / threadNumber_)
-#endif
-#endif
-    for(int i = 0; i < (int)numberOfBins_; i++) {
-      if((SimplexId)probability_[i].size() == numberOfVertices_) {
-        histogram[i] = probability_[i][vertexId];
-      } else {
-        histogram[i] = 0.0;
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId v = 0; v < vertexNumber_; v++) {
+    outputMeanField[v] /= numberOfMembers;
+  }
+
+  // Histograms
+  if(computeHistograms_) {
+    histograms_.normalize();
+    for(int b = 0; b < BinCount; b++) {
+      binValues_[b] = histograms_.getBinValue(b);
+      if(outputProbability_[b]) {
+        histograms_.getBinField(b, outputProbability_[b]);
       }
     }
-  } else {
-    fill(histogram.begin(), histogram.end(), 0.0);
   }
+
+  return 0;
 }
 
-void ttk::PDFHistograms::normalize() {
-  const double normalization = 1.0 / static_cast<double>(numberOfInputs_);
+void ttk::PDFHistograms::getBinField(const int binId, double *field) const {
+  if(binId >= numberOfBins_ || numberOfInputs_ == 0) {
+    std::fill(field, field + numberOfVertices_, 0.0);
+    return;
+  }
 #ifdef TTK_ENABLE_OPENMP
-#ifdef _WIN32
 #pragma omp parallel for num_threads(threadNumber_)
-#else
-#pragma omp parallel for num_threads(threadNumber_) collapse(2) \
-  schedule(static, (numberOfBins_ * numberOfVertices_) / threadNumber_)
-#endif
-#endif
-  for(int i = 0; i < numberOfBins_; i++) {
-    for(SimplexId j = 0; j < numberOfVertices_; j++) {
-      probability_[i][j] *= normalization;
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < numberOfVertices_; i++) {
+    field[i] = this->getCount(i, binId) * normalization_;
+  }
+}
+
+void ttk::PDFHistograms::getVertexHistogram(
+  const ttk::SimplexId vertexId, std::vector<double> &histogram) const {
+
+  histogram.resize(numberOfBins_);
+  if(vertexId < numberOfVertices_ && numberOfInputs_ > 0) {
+    // the bins of a vertex are contiguous
+    for(int i = 0; i < numberOfBins_; i++) {
+      histogram[i] = this->getCount(vertexId, i) * normalization_;
     }
+  } else {
+    fill(histogram.begin(), histogram.end(), 0.0);
   }
 }
+
+void ttk::PDFHistograms::normalize() {
+  // the counters are kept, the normalization is applied on read
+  normalization_ = 1.0 / static_cast<double>(numberOfInputs_);
+}
@@ -7,6 +7,12 @@
 /// (represented by a list of scalar fields) and which computes various
 /// vertexwise statistics (PDF estimation, bounds, moments, etc.)
 ///
+/// The ensemble members can either be registered all at once (see
+/// setInputDataPointer() and execute()) or streamed one at a time, for
+/// ensembles that do not fit in memory (see startStreaming()). Both modes
+/// produce the same outputs: execute() streams over the registered
+/// members.
+///
 /// \sa ttkUncertainDataEstimator.cpp %for a usage example.
 
 #pragma once
@@ -14,6 +20,11 @@
 // base code includes
 #include <Wrapper.h>
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 namespace ttk {
 
   template <class dataType>
@@ -108,6 +119,12 @@ namespace ttk {
     std::vector<dataType> lowerBound_{};
   };
 
+  /**
+   * Per-vertex histograms of an ensemble, evaluated one realization at a
+   * time. The bin counts are stored in one flat vertex-major buffer (the
+   * bins of a vertex are contiguous) of 16-bit counters, widened to 32
+   * bits when the number of realizations requires it.
+   */
   class PDFHistograms : virtual public Debug {
   public:
     template <class dataType>
@@ -125,32 +142,40 @@ namespace ttk {
 #endif
       if(numberOfInputs_ == 0) {
         /* Initialize */
-        probability_.resize(numberOfBins_);
+        binValue_.resize(numberOfBins_);
         double dx
           = (rangeMax_ - rangeMin_) / static_cast<double>(numberOfBins_);
         for(size_t i = 0; i < static_cast<size_t>(numberOfBins_); i++) {
-          probability_[i].resize(numberOfVertices_);
           binValue_[i] = rangeMin_ + (dx / 2.0) + (static_cast<double>(i) * dx);
         }
+        counts16_.assign(
+          static_cast<size_t>(numberOfBins_) * numberOfVertices_, 0);
+        std::vector<uint32_t>().swap(counts32_);
+      } else if(numberOfInputs_ == std::numeric_limits<uint16_t>::max()
+                && counts32_.empty()) {
+        /* 16-bit counters could overflow: widen them */
+        counts32_.assign(counts16_.begin(), counts16_.end());
+        std::vector<uint16_t>().swap(counts16_);
       }
       /* Add input datas */
-      for(SimplexId i = 0; i < numberOfVertices_; i++) {
-        int bin
-          = static_cast<int>(floor((inputData[i] - rangeMin_) * numberOfBins_
-                                   / (rangeMax_ - rangeMin_)));
-        bin = (bin == numberOfBins_) ? numberOfBins_ - 1 : bin;
-        probability_[bin][i] += 1.0;
+      if(counts32_.empty()) {
+        this->addRealization(inputData, counts16_.data());
+      } else {
+        this->addRealization(inputData, counts32_.data());
       }
       numberOfInputs_++;
       return 0;
     }
 
-    inline double *getBinFieldPointer(const int binId) {
-      if(binId < numberOfBins_) {
-        return probability_[binId].data();
-      } else {
-        return nullptr;
+    /// Fill @p field with the values of bin @p binId for every vertex
+    /// (counts, or probabilities after normalize()).
+    void getBinField(const int binId, double *field) const;
+
+    inline double getBinValue(const int binId) const {
+      if(binId < static_cast<int>(binValue_.size())) {
+        return binValue_[binId];
       }
+      return 0.0;
     }
 
     void getVertexHistogram(const SimplexId vertexId,
@@ -158,6 +183,14 @@ namespace ttk {
 
     void normalize();
 
+    /// Forget the realizations evaluated so far.
+    inline void reset() {
+      numberOfInputs_ = 0;
+      normalization_ = 1.0;
+      std::vector<uint16_t>().swap(counts16_);
+      std::vector<uint32_t>().swap(counts32_);
+    }
+
     inline void setNumberOfBins(const int number) {
       numberOfBins_ = number;
     }
@@ -172,8 +205,32 @@ namespace ttk {
     }
 
   protected:
+    template <class dataType, typename counterType>
+    void addRealization(const dataType *inputData, counterType *counts) const {
+      const size_t numberOfBins = numberOfBins_;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+      for(SimplexId i = 0; i < numberOfVertices_; i++) {
+        int bin
+          = static_cast<int>(floor((inputData[i] - rangeMin_) * numberOfBins_
+                                   / (rangeMax_ - rangeMin_)));
+        bin = (bin >= numberOfBins_) ? numberOfBins_ - 1 : bin;
+        bin = (bin < 0) ? 0 : bin;
+        counts[i * numberOfBins + bin]++;
+      }
+    }
+
+    inline double getCount(const SimplexId vertexId, const int binId) const {
+      const size_t i = static_cast<size_t>(vertexId) * numberOfBins_ + binId;
+      return counts32_.empty() ? counts16_[i] : counts32_[i];
+    }
+
     std::vector<double> binValue_{};
-    std::vector<std::vector<double>> probability_{};
+    // vertex-major bin counts (only one of them is allocated)
+    std::vector<uint16_t> counts16_{};
+    std::vector<uint32_t> counts32_{};
+    double normalization_{1.0};
     int numberOfBins_{0};
     int numberOfInputs_{0};
     SimplexId numberOfVertices_{0};
@@ -191,6 +248,67 @@ namespace ttk {
     template <class dataType>
     int execute();
 
+    /// Start streaming the ensemble members. The outputs, the number of
+    /// vertices and the number of bins must be set beforehand. The
+    /// members are then processed one at a time:
+    /// \code
+    /// startStreaming();
+    /// for(each member)
+    ///   processMember<dataType>(member);
+    /// if(needsHistogramPass()) {
+    ///   startHistogramPass();
+    ///   for(each member)
+    ///     processMember<dataType>(member);
+    /// }
+    /// endStreaming();
+    /// \endcode
+    /// The histograms need a second pass over the members, unless their
+    /// range is set in advance (see setHistogramRange()).
+    /// \return Returns 0 upon success, negative values otherwise.
+    int startStreaming();
+
+    /// Update the bounds, the mean and the histograms with a member.
+    /// \param member Pointer to the member scalar field.
+    /// \return Returns 0 upon success, negative values otherwise.
+    template <class dataType>
+    int processMember(const dataType *member);
+
+    /// Are the histograms waiting for a second pass over the members?
+    inline bool needsHistogramPass() const {
+      return computeHistograms_ && !withHistogramRange_ && !histogramPass_;
+    }
+
+    /// Start the second pass, once the range of the ensemble is known.
+    /// \return Returns 0 upon success, negative values otherwise.
+    int startHistogramPass();
+
+    /// Write the mean field and the histograms into the outputs.
+    /// \return Returns 0 upon success, negative values otherwise.
+    int endStreaming();
+
+    /// Process the members in a single pass, for instance when they are
+    /// streamed by a ttkForEach loop. The histograms are then computed only
+    /// if their range is set in advance (see setHistogramRange()).
+    inline void setSinglePass(const bool singlePass) {
+      singlePass_ = singlePass;
+    }
+
+    /// Are the histograms computed by the current streaming?
+    inline bool hasHistograms() const {
+      return computeHistograms_;
+    }
+
+    /// Set the range of the histograms in advance (values outside the
+    /// range are counted in the first or last bin), so that streaming
+    /// needs a single pass over the members.
+    inline void setHistogramRange(const bool withHistogramRange,
+                                  const double min,
+                                  const double max) {
+      withHistogramRange_ = withHistogramRange;
+      histogramRange_[0] = min;
+      histogramRange_[1] = max;
+    }
+
     /// Pass a pointer to an input array representing a scalarfield.
     /// The array is expected to be correctly allocated. idx in
     /// [0,numberOfInputs_[ \param idx Index of the input scalar field. \param
@@ -287,133 +405,120 @@ namespace ttk {
     void *outputUpperBoundField_{};
     std::vector<double *> outputProbability_{};
     void *outputMeanField_{};
+
+    // streaming state
+    int numberOfMembers_{0};
+    bool computeHistograms_{false};
+    bool histogramPass_{false};
+    bool withHistogramRange_{false};
+    bool singlePass_{false};
+    double histogramRange_[2]{};
+    // range of the ensemble
+    double range_[2]{};
+    PDFHistograms histograms_{};
   };
 } // namespace ttk
 
 template <class dataType>
-int ttk::UncertainDataEstimator::execute() {
-
-  Timer t;
+int ttk::UncertainDataEstimator::processMember(const dataType *member) {
 
-  // Check the consistency of the variables
 #ifndef TTK_ENABLE_KAMIKAZE
-  if(!numberOfInputs_)
+  if(!member)
     return -1;
-  if(!vertexNumber_)
-    return -2;
-
-  for(int i = 0; i < numberOfInputs_; i++) {
-    if(!inputData_[i])
-      return -4;
-  }
-  if(!outputLowerBoundField_)
-    return -5;
-  if(!outputUpperBoundField_)
-    return -6;
 #endif
 
-  SimplexId count = 0;
+  // Second pass: histograms only
+  if(histogramPass_) {
+    return computeHistograms_ ? histograms_.evaluateRealization(member) : 0;
+  }
 
   // Pointers type casting
   dataType *outputLowerBoundField = (dataType *)outputLowerBoundField_;
   dataType *outputUpperBoundField = (dataType *)outputUpperBoundField_;
-  dataType **inputData = (dataType **)inputData_.data();
   double *outputMeanField = static_cast<double *>(outputMeanField_);
 
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif
-  for(SimplexId v = 0; v < (SimplexId)vertexNumber_; v++) {
-
-    // Avoid any processing if the abort signal is sent
-    if((!wrapper_) || ((wrapper_) && (!wrapper_->needsToAbort()))) {
-
-      // For the lower bound scalar field
-      if(ComputeLowerBound) {
-        // Initialisation : values of the first input
-        outputLowerBoundField[v] = inputData[0][v];
-        // Loop over the inputs
-        for(int inp = 1; inp < numberOfInputs_; inp++) {
-          // Minimum value
-          if(ComputeLowerBound)
-            if(inputData[inp][v] < outputLowerBoundField[v])
-              outputLowerBoundField[v] = inputData[inp][v];
-        }
-      }
-
-      // For the upper bound scalar field
-      if(ComputeUpperBound) {
-        // Initialisation : values of the first input
-        outputUpperBoundField[v] = inputData[0][v];
-        // Loop over the inputs
-        for(int inp = 1; inp < numberOfInputs_; inp++) {
-          // Maximum value
-          if(ComputeUpperBound)
-            if(inputData[inp][v] > outputUpperBoundField[v])
-              outputUpperBoundField[v] = inputData[inp][v];
-        }
-      }
+  const bool first = (numberOfMembers_ == 0);
+  double memberMin = std::numeric_limits<double>::max();
+  double memberMax = std::numeric_limits<double>::lowest();
 
-      // Update the progress bar of the wrapping code -- to adapt
-      if(debugLevel_ > static_cast<int>(debug::Priority::DETAIL)) {
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp critical
-#endif
-        {
-          if((wrapper_) && (!(count % ((vertexNumber_) / 10)))) {
-            wrapper_->updateProgress((count + 1.0) / vertexNumber_);
-          }
+#pragma omp parallel for num_threads(threadNumber_) \
+  reduction(min : memberMin) reduction(max : memberMax)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId v = 0; v < vertexNumber_; v++) {
+    const dataType value = member[v];
 
-          count++;
-        }
-      }
+    // Bounds (initialized with the first member)
+    if(ComputeLowerBound) {
+      if(first || value < outputLowerBoundField[v])
+        outputLowerBoundField[v] = value;
     }
+    if(ComputeUpperBound) {
+      if(first || value > outputUpperBoundField[v])
+        outputUpperBoundField[v] = value;
+    }
+
+    // Mean field (sum until endStreaming())
+    if(first)
+      outputMeanField[v] = static_cast<double>(value);
+    else
+      outputMeanField[v] += static_cast<double>(value);
+
+    memberMin = std::min(memberMin, static_cast<double>(value));
+    memberMax = std::max(memberMax, static_cast<double>(value));
   }
 
-  // Histogram
-  if(ComputeUpperBound && ComputeLowerBound) {
-    // Range
-    double range[2];
-    range[0] = outputLowerBoundField[0];
-    range[1] = outputUpperBoundField[0];
+  if(first || memberMin < range_[0])
+    range_[0] = memberMin;
+  if(first || memberMax > range_[1])
+    range_[1] = memberMax;
+  numberOfMembers_++;
 
-    for(SimplexId v = 0; v < vertexNumber_; v++) {
-      if(outputLowerBoundField[v] < range[0])
-        range[0] = outputLowerBoundField[v];
-      if(outputUpperBoundField[v] > range[1])
-        range[1] = outputUpperBoundField[v];
-    }
+  // Histograms, if their range is known
+  if(computeHistograms_ && withHistogramRange_) {
+    return histograms_.evaluateRealization(member);
+  }
 
-    // Interval between bins
-    double dx = (range[1] - range[0]) / (double)BinCount;
+  return 0;
+}
 
-    // Bin values
-    for(int b = 0; b < BinCount; b++) {
-      binValues_[b] = range[0] + (dx / 2.0) + (double)b * dx;
-    }
+template <class dataType>
+int ttk::UncertainDataEstimator::execute() {
 
-    int idx;
-    double increment = 1.0 / (double)numberOfInputs_;
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for private(idx) num_threads(threadNumber_)
-#endif
-    for(SimplexId v = 0; v < vertexNumber_; v++) {
-      for(int i = 0; i < numberOfInputs_; i++) {
-        idx = (int)floor((inputData[i][v] - range[0]) * BinCount
-                         / (range[1] - range[0]));
-        idx = (idx == BinCount) ? BinCount - 1 : idx;
-        outputProbability_[idx][v] += increment;
-      }
-    }
+  Timer t;
+
+  // Check the consistency of the variables
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(!numberOfInputs_)
+    return -1;
+  if(!vertexNumber_)
+    return -2;
+
+  for(int i = 0; i < numberOfInputs_; i++) {
+    if(!inputData_[i])
+      return -4;
   }
+  if(!outputLowerBoundField_)
+    return -5;
+  if(!outputUpperBoundField_)
+    return -6;
+#endif
 
-  // Mean field
-  for(SimplexId v = 0; v < vertexNumber_; v++) {
-    double sum = 0.0;
-    for(int i = 0; i < numberOfInputs_; i++) {
-      sum += static_cast<double>(inputData[i][v]);
+  int status = this->startStreaming();
+  for(int i = 0; i < numberOfInputs_ && !status; i++) {
+    status = this->processMember(static_cast<dataType *>(inputData_[i]));
+  }
+  if(!status && this->needsHistogramPass()) {
+    status = this->startHistogramPass();
+    for(int i = 0; i < numberOfInputs_ && !status; i++) {
+      status = this->processMember(static_cast<dataType *>(inputData_[i]));
     }
-    outputMeanField[v] = sum / static_cast<double>(numberOfInputs_);
+  }
+  if(!status) {
+    status = this->endStreaming();
+  }
+  if(status) {
+    return status;
   }
 
   this->printMsg(std::vector<std::vector<std::string>>{
@@ -4,12 +4,20 @@
 /// \date July 2011.
 ///
 /// \brief Union Find implementation for connectivity tracking.
+///
+/// ttk::UnionFind is a pointer-linked set, one object per element. The
+/// index-based ttk::UnionFindArena, ttk::SmallUnionFind and
+/// ttk::ConcurrentUnionFind store the whole forest in flat arrays and should
+/// be preferred for new code.
 
 #pragma once
 
 #include <Debug.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 
 namespace ttk {
@@ -106,4 +114,215 @@ namespace ttk {
     }
   }
 
+  namespace uf {
+
+    /// Returns the root of \p x, halving the path on the way.
+    inline SimplexId find(SimplexId *const parent, SimplexId x) {
+      while(parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+      }
+      return x;
+    }
+
+    /// Merges the sets of \p x and \p y by rank and returns the root of the
+    /// result. \p setNumber is decremented if two sets were merged.
+    inline SimplexId merge(SimplexId *const parent,
+                           uint8_t *const rank,
+                           SimplexId &setNumber,
+                           SimplexId x,
+                           SimplexId y) {
+      x = find(parent, x);
+      y = find(parent, y);
+      if(x == y) {
+        return x;
+      }
+      if(rank[x] < rank[y]) {
+        std::swap(x, y);
+      } else if(rank[x] == rank[y]) {
+        rank[x]++;
+      }
+      parent[y] = x;
+      setNumber--;
+      return x;
+    }
+
+  } // namespace uf
+
+  /**
+   * @brief Index-based disjoint sets over the elements [0, size).
+   *
+   * The forest is stored in two flat arrays (one parent index and one rank
+   * byte per element), which replaces the per-element ttk::UnionFind
+   * objects.
+   */
+  class UnionFindArena {
+  public:
+    UnionFindArena(const SimplexId size = 0) {
+      this->reset(size);
+    }
+
+    /// Puts every element of [0, size) in its own set.
+    inline void reset(const SimplexId size) {
+      parent_.resize(size);
+      rank_.assign(size, 0);
+      for(SimplexId i = 0; i < size; i++) {
+        parent_[i] = i;
+      }
+      setNumber_ = size;
+    }
+
+    inline SimplexId find(const SimplexId x) {
+      return uf::find(parent_.data(), x);
+    }
+
+    /// Returns the root of the merged set.
+    inline SimplexId merge(const SimplexId x, const SimplexId y) {
+      return uf::merge(parent_.data(), rank_.data(), setNumber_, x, y);
+    }
+
+    inline SimplexId getNumberOfSets() const {
+      return setNumber_;
+    }
+
+    inline SimplexId size() const {
+      return parent_.size();
+    }
+
+  protected:
+    std::vector<SimplexId> parent_{};
+    std::vector<uint8_t> rank_{};
+    SimplexId setNumber_{};
+  };
+
+  /**
+   * @brief ttk::UnionFindArena variant that keeps up to N elements on the
+   * stack.
+   *
+   * Meant for the small and short-lived sets of the per-vertex link queries,
+   * which then do not allocate.
+   */
+  template <size_t N = 32>
+  class SmallUnionFind {
+  public:
+    SmallUnionFind(const SimplexId size = 0) {
+      this->reset(size);
+    }
+
+    SmallUnionFind(const SmallUnionFind &) = delete;
+    SmallUnionFind &operator=(const SmallUnionFind &) = delete;
+
+    /// Puts every element of [0, size) in its own set.
+    inline void reset(const SimplexId size) {
+      if(static_cast<size_t>(size) <= N) {
+        parent_ = parentBuffer_.data();
+        rank_ = rankBuffer_.data();
+      } else {
+        parentHeap_.resize(size);
+        rankHeap_.resize(size);
+        parent_ = parentHeap_.data();
+        rank_ = rankHeap_.data();
+      }
+      for(SimplexId i = 0; i < size; i++) {
+        parent_[i] = i;
+        rank_[i] = 0;
+      }
+      size_ = size;
+      setNumber_ = size;
+    }
+
+    inline SimplexId find(const SimplexId x) {
+      return uf::find(parent_, x);
+    }
+
+    /// Returns the root of the merged set.
+    inline SimplexId merge(const SimplexId x, const SimplexId y) {
+      return uf::merge(parent_, rank_, setNumber_, x, y);
+    }
+
+    inline SimplexId getNumberOfSets() const {
+      return setNumber_;
+    }
+
+    inline SimplexId size() const {
+      return size_;
+    }
+
+  protected:
+    std::array<SimplexId, N> parentBuffer_;
+    std::array<uint8_t, N> rankBuffer_;
+    std::vector<SimplexId> parentHeap_{};
+    std::vector<uint8_t> rankHeap_{};
+    SimplexId *parent_{};
+    uint8_t *rank_{};
+    SimplexId size_{}, setNumber_{};
+  };
+
+  /**
+   * @brief Lock-free disjoint sets over the elements [0, size).
+   *
+   * find() and merge() can be called concurrently. The root of a set is its
+   * smallest element, so the result does not depend on the order of the
+   * merges.
+   */
+  class ConcurrentUnionFind {
+  public:
+    ConcurrentUnionFind(const SimplexId size = 0) {
+      this->reset(size);
+    }
+
+    /// Puts every element of [0, size) in its own set (not thread-safe).
+    inline void reset(const SimplexId size) {
+      // std::atomic is not movable, build a new array
+      std::vector<std::atomic<SimplexId>> parent(size);
+      for(SimplexId i = 0; i < size; i++) {
+        parent[i].store(i, std::memory_order_relaxed);
+      }
+      parent_.swap(parent);
+    }
+
+    inline SimplexId find(SimplexId x) {
+      while(true) {
+        SimplexId parent = parent_[x].load();
+        if(parent == x) {
+          return x;
+        }
+        // path halving
+        const SimplexId grandParent = parent_[parent].load();
+        if(grandParent != parent) {
+          parent_[x].compare_exchange_weak(parent, grandParent);
+        }
+        x = grandParent;
+      }
+    }
+
+    /// Returns the root of the merged set (which may be outdated as soon as
+    /// other threads merge it further).
+    inline SimplexId merge(SimplexId x, SimplexId y) {
+      while(true) {
+        x = this->find(x);
+        y = this->find(y);
+        if(x == y) {
+          return x;
+        }
+        if(x < y) {
+          std::swap(x, y);
+        }
+        // link the largest root under the smallest one (fails if x is no
+        // longer a root)
+        SimplexId expected = x;
+        if(parent_[x].compare_exchange_strong(expected, y)) {
+          return y;
+        }
+      }
+    }
+
+    inline SimplexId size() const {
+      return parent_.size();
+    }
+
+  protected:
+    std::vector<std::atomic<SimplexId>> parent_{};
+  };
+
 } // namespace ttk
@@ -53,14 +53,44 @@ using ttkSimplexIdTypeArray = vtkIntArray;
     switch(dataType) { vtkTemplateMacro((call)); };      \
   }; break;
 
-#define ttkVtkTemplateMacro(dataType, triangulationType, call)            \
+// The triangulations specialized on the grid dimension are dispatched as
+// their generic base class (see ttkTemplateMacro).
+#define ttkVtkTemplateMacro(dataType, triangulationType, call)              \
+  switch(triangulationType) {                                               \
+    ttkVtkTemplateMacroCase(dataType, ttk::Triangulation::Type::EXPLICIT,   \
+                            ttk::ExplicitTriangulation, call);              \
+    case ttk::Triangulation::Type::IMPLICIT_2D:                             \
+    case ttk::Triangulation::Type::IMPLICIT_3D:                             \
+      ttkVtkTemplateMacroCase(dataType, ttk::Triangulation::Type::IMPLICIT, \
+                              ttk::ImplicitTriangulation, call);            \
+    case ttk::Triangulation::Type::PERIODIC_2D:                             \
+    case ttk::Triangulation::Type::PERIODIC_3D:                             \
+      ttkVtkTemplateMacroCase(dataType, ttk::Triangulation::Type::PERIODIC, \
+                              ttk::PeriodicImplicitTriangulation, call);    \
+  }
+
+// Same as ttkVtkTemplateMacro, with the triangulations specialized on the
+// grid dimension (see ttkGridTemplateMacro).
+#define ttkVtkGridTemplateMacro(dataType, triangulationType, call)        \
   switch(triangulationType) {                                             \
     ttkVtkTemplateMacroCase(dataType, ttk::Triangulation::Type::EXPLICIT, \
                             ttk::ExplicitTriangulation, call);            \
     ttkVtkTemplateMacroCase(dataType, ttk::Triangulation::Type::IMPLICIT, \
                             ttk::ImplicitTriangulation, call);            \
+    ttkVtkTemplateMacroCase(dataType,                                     \
+                            ttk::Triangulation::Type::IMPLICIT_2D,        \
+                            ttk::ImplicitTriangulation2D, call);          \
+    ttkVtkTemplateMacroCase(dataType,                                     \
+                            ttk::Triangulation::Type::IMPLICIT_3D,        \
+                            ttk::ImplicitTriangulation3D, call);          \
     ttkVtkTemplateMacroCase(dataType, ttk::Triangulation::Type::PERIODIC, \
                             ttk::PeriodicImplicitTriangulation, call);    \
+    ttkVtkTemplateMacroCase(dataType,                                     \
+                            ttk::Triangulation::Type::PERIODIC_2D,        \
+                            ttk::PeriodicImplicitTriangulation2D, call);  \
+    ttkVtkTemplateMacroCase(dataType,                                     \
+                            ttk::Triangulation::Type::PERIODIC_3D,        \
+                            ttk::PeriodicImplicitTriangulation3D, call);  \
   }
 
 #define ttkTemplate2IdMacro(call)                                           \
@@ -1,6 +1,8 @@
 #include <ttkUtils.h>
 
 #include <limits>
+#include <map>
+#include <mutex>
 #include <vtkStringArray.h>
 
 #include <vtkAbstractArray.h>
@@ -10,6 +12,26 @@
 #include <vtkPoints.h>
 #include <vtkSmartPointer.h>
 
+namespace {
+  // owners of the buffers shared with VTK arrays, one entry per array
+  std::mutex ownersMutex{};
+  std::multimap<void *, std::shared_ptr<void>> owners{};
+
+  // free function of the arrays: drops the reference of one array
+  void releaseOwner(void *data) {
+    std::shared_ptr<void> owner{};
+    {
+      std::lock_guard<std::mutex> lock(ownersMutex);
+      const auto it = owners.find(data);
+      if(it != owners.end()) {
+        owner = std::move(it->second);
+        owners.erase(it);
+      }
+    }
+    // the owner may be released here, outside of the lock
+  }
+} // namespace
+
 int ttkUtils::replaceVariable(const std::string &iString,
                               vtkFieldData *fieldData,
                               std::string &oString,
@@ -271,6 +293,21 @@ void ttkUtils::SetVoidArray(vtkDataArray *array,
   }
 };
 
+void ttkUtils::SetVoidArray(vtkDataArray *array,
+                            void *data,
+                            vtkIdType size,
+                            std::shared_ptr<void> owner) {
+  {
+    std::lock_guard<std::mutex> lock(ownersMutex);
+    owners.emplace(data, std::move(owner));
+  }
+  // all the entries of a given buffer hold the same owner: any one can be
+  // dropped when an array frees it
+  array->SetVoidArray(
+    data, size, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(releaseOwner);
+}
+
 [[deprecated]] void ttkUtils::FillCellArrayFromSingle(vtkIdType const *cells,
                                                       vtkIdType ncells,
                                                       vtkCellArray *cellArray) {
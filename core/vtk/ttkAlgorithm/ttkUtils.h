@@ -10,6 +10,7 @@
 // VTK Module
 #include <ttkAlgorithmModule.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -68,6 +69,13 @@ public:
   static void
     SetVoidArray(vtkDataArray *array, void *data, vtkIdType size, int save);
 
+  // Use data without copy, owner being kept alive until the array
+  // releases its buffer (data may be shared by several arrays)
+  static void SetVoidArray(vtkDataArray *array,
+                           void *data,
+                           vtkIdType size,
+                           std::shared_ptr<void> owner);
+
   // Fill Cell array using a pointer with the old memory layout
   // DEPRECTAED
   static void FillCellArrayFromSingle(vtkIdType const *cells,
@@ -84,6 +84,9 @@ int ttkArrayPreconditioning::RequestData(vtkInformation *request,
     }
   }
 
+  // sort scratch space shared by all the selected arrays
+  ttk::VertexSortBuffers sortBuffers{};
+
   for(auto scalarArray : scalarArrays) {
     vtkNew<ttkSimplexIdTypeArray> orderArray{};
     orderArray->SetName(this->GetOrderArrayName(scalarArray).data());
@@ -91,11 +94,10 @@ int ttkArrayPreconditioning::RequestData(vtkInformation *request,
     orderArray->SetNumberOfTuples(nVertices);
 
     switch(scalarArray->GetDataType()) {
-      vtkTemplateMacro(ttk::sortVertices(
+      vtkTemplateMacro(ttk::preconditionOrderArray(
         nVertices, static_cast<VTK_TT *>(ttkUtils::GetVoidPointer(scalarArray)),
-        static_cast<int *>(nullptr),
         static_cast<ttk::SimplexId *>(ttkUtils::GetVoidPointer(orderArray)),
-        this->threadNumber_));
+        sortBuffers, this->threadNumber_));
     }
 
     output->GetPointData()->AddArray(orderArray);
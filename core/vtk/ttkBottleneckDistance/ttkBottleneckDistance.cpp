@@ -1,5 +1,6 @@
 #include "ttkBottleneckDistance.h"
 #include <ttkMacros.h>
+#include <ttkPersistenceDiagramUtils.h>
 #include <ttkUtils.h>
 
 // VTK includes
@@ -15,10 +16,58 @@
 #include <vtkUnstructuredGrid.h>
 
 // Misc.
+#include <algorithm>
+#include <array>
 #include <cstdlib>
 #include <ctime>
+#include <numeric>
 #include <random>
 
+namespace {
+  using Diagram = ttk::PersistenceDiagramColumns<double>;
+
+  // pairs sorted by increasing birth, order[i] being the index in diagram
+  // of the i-th sorted pair
+  void sortByBirth(const Diagram &diagram,
+                   Diagram &sorted,
+                   std::vector<int> &order) {
+    order.resize(diagram.size());
+    std::iota(order.begin(), order.end(), 0);
+    const double *const birth = diagram.birth.data();
+    std::stable_sort(
+      order.begin(), order.end(),
+      [birth](const int a, const int b) { return birth[a] < birth[b]; });
+    sorted.gather(diagram, order);
+  }
+
+  // end of the matching line on the i-th pair: its extremum, the middle of
+  // the pair for saddle-saddle pairs
+  void getMatchedPoint(const Diagram &diagram,
+                       const int i,
+                       const bool is2D,
+                       double p[3]) {
+    const BNodeType t1 = diagram.birthType[i];
+    const BNodeType t2 = diagram.deathType[i];
+    bool t1Max = t1 == BLocalMin || t1 == BLocalMax;
+    bool t2Max = t2 == BLocalMin || t2 == BLocalMax;
+    if(is2D) { // Quickchage for highlighting 2D matching
+      if(t1 != BLocalMax && t2 != BLocalMax) {
+        t1Max = t1 != BLocalMin;
+        t2Max = t2 != BLocalMin;
+      }
+    }
+    const std::array<float, 3> birth{
+      diagram.birthX[i], diagram.birthY[i], diagram.birthZ[i]};
+    const std::array<float, 3> death{
+      diagram.deathX[i], diagram.deathY[i], diagram.deathZ[i]};
+    for(int c = 0; c < 3; ++c) {
+      p[c] = t2Max   ? death[c]
+             : t1Max ? birth[c]
+                     : (birth[c] + death[c]) / 2;
+    }
+  }
+} // namespace
+
 vtkStandardNewMacro(ttkBottleneckDistance);
 
 ttkBottleneckDistance::ttkBottleneckDistance() {
@@ -44,60 +93,32 @@ int ttkBottleneckDistance::FillOutputPortInformation(int port,
   return 0;
 }
 
-template <typename dataType>
 int ttkBottleneckDistance::generatePersistenceDiagram(
-  std::vector<diagramTuple> &diagram, const int size) {
+  ttk::PersistenceDiagramColumns<double> &diagram, const int size) {
   // srand(time(NULL));
   int vertexId1 = 1;
   int vertexId2 = 2;
 
-  // diagram.resize(size);
-  // diagram.push_back(std::make_tuple(
-  //    0, BLocalMin,
-  //    1, BLocalMax,
-  //    1.0,
-  //    2,
-  //    0.0, 0.0001, 0.0001, 0.0,
-  //    1.0, 0.0001, 1.0, 0.0
-  //));
-
-  std::default_random_engine generator1(1998985);
-  std::default_random_engine generator2(8584584);
-  std::uniform_real_distribution<> dis1(0.0, 1.0);
-  std::uniform_real_distribution<> dis2(0.0, 1.0);
+  Diagram generated{};
+  generated.resize(std::max(size - 1, 0));
 
   for(int i = 1; i < size; ++i) {
     int r0 = 2; // (rand() % 3);
     float r1
       = 0.001f + static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-    // (float) dis1(generator1); // static_cast <float> (rand()) / static_cast
-    // <float> (RAND_MAX);
     float r2
       = 0.001f + static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-    // (float) dis2(generator2); // static_cast <float> (rand()) / static_cast
-    // <float> (RAND_MAX); r2 *= 0.1f;
 
     // BLocalMin BSaddle1 BSaddle2 BLocalMax
     int pairType = r0; // (0/min, 1/saddle, 2/max)
     BNodeType nodeType1; //
     BNodeType nodeType2; //
     switch(pairType) {
-      // case 0:
-      //   nodeType1 = BLocalMin;
-      //   nodeType2 = BSaddle1;
-      //   break;
-      // case 1:
-      //   nodeType1 = BSaddle1;
-      //   nodeType2 = BSaddle2;
-      //   break;
       case 2:
       default:
         nodeType1 = BSaddle2;
         nodeType2 = BLocalMax;
         break;
-        // default:
-        //   nodeType1 = (BNodeType) -1;
-        //   nodeType2 = (BNodeType) -1;
     }
 
     float x1 = 0.5f * r1;
@@ -108,160 +129,75 @@ int ttkBottleneckDistance::generatePersistenceDiagram(
     float y2 = x1 + 0.5f * r2; // x1 + rand(0.5)
     float z2 = 0.f; // 0
 
-    auto value1 = (dataType)x1;
-    auto value2 = (dataType)y2;
-
-    dataType persistence = y2 - x1;
-
-    diagram.push_back(std::make_tuple(vertexId1, nodeType1, vertexId2,
-                                      nodeType2, persistence, pairType, value1,
-                                      x1, y1, z1, value2, x2, y2, z2));
+    const size_t j = i - 1;
+    generated.birthVertex[j] = vertexId1;
+    generated.birthType[j] = nodeType1;
+    generated.deathVertex[j] = vertexId2;
+    generated.deathType[j] = nodeType2;
+    generated.persistence[j] = y2 - x1;
+    generated.pairType[j] = pairType;
+    generated.birth[j] = x1;
+    generated.birthX[j] = x1;
+    generated.birthY[j] = y1;
+    generated.birthZ[j] = z1;
+    generated.death[j] = y2;
+    generated.deathX[j] = x2;
+    generated.deathY[j] = y2;
+    generated.deathZ[j] = z2;
 
     vertexId1++;
     vertexId2++;
   }
 
-  sort(diagram.begin(), diagram.end(),
-       [](const diagramTuple &a, const diagramTuple &b) -> bool {
-         return std::get<6>(a) < std::get<6>(b);
-       });
+  std::vector<int> order{};
+  sortByBirth(generated, diagram, order);
 
   return 1;
 }
 
-// Warn: this is duplicated in ttkTrackingFromPersistenceDiagrams
-template <typename dataType>
 int ttkBottleneckDistance::getPersistenceDiagram(
-  std::vector<diagramTuple> &diagram,
+  ttk::PersistenceDiagramColumns<double> &diagram,
   vtkUnstructuredGrid *const CTPersistenceDiagram_,
   const double spacing,
   const int diagramNumber) {
 
   auto pointData = CTPersistenceDiagram_->GetPointData();
-  auto cellData = CTPersistenceDiagram_->GetCellData();
-
-  if(pointData == nullptr || cellData == nullptr) {
+  if(pointData == nullptr) {
     return -1;
   }
 
-  auto vertexIdentifierScalars = ttkSimplexIdTypeArray::SafeDownCast(
-    pointData->GetArray(ttk::VertexScalarFieldName));
-
-  auto nodeTypeScalars
-    = vtkIntArray::SafeDownCast(pointData->GetArray("CriticalType"));
-
-  auto pairIdentifierScalars
-    = ttkSimplexIdTypeArray::SafeDownCast(cellData->GetArray("PairIdentifier"));
-
-  auto extremumIndexScalars
-    = vtkIntArray::SafeDownCast(cellData->GetArray("PairType"));
-
-  auto persistenceScalars
-    = vtkDoubleArray::SafeDownCast(cellData->GetArray("Persistence"));
-
-  auto birthScalars
-    = vtkDoubleArray::SafeDownCast(pointData->GetArray("Birth"));
-
-  auto deathScalars
-    = vtkDoubleArray::SafeDownCast(pointData->GetArray("Death"));
-
-  vtkPoints *points = CTPersistenceDiagram_->GetPoints();
-  if(!pairIdentifierScalars)
-    return -2;
-
-  auto pairingsSize = (int)pairIdentifierScalars->GetNumberOfTuples();
-
-  // Continuous indexing (no gap in indices)
-  for(int pairIndex = 0; pairIndex < pairingsSize; ++pairIndex) {
-    const float indexOfPair = pairIndex;
-    if(*pairIdentifierScalars->GetTuple(pairIndex) != -1) // except diagonal
-      pairIdentifierScalars->SetTuple(pairIndex, &indexOfPair);
-  }
-
-  float s{0.0};
-
+  auto birthScalars = pointData->GetArray(ttk::PersistenceBirthName);
+  auto deathScalars = pointData->GetArray(ttk::PersistenceDeathName);
   if(!deathScalars != !birthScalars)
     return -2;
   bool is2D = !deathScalars && !birthScalars;
   bool is3D = !is2D;
   if(Is3D && !is3D)
     Is3D = false;
-  if(!Is3D && diagramNumber == 1)
-    s = (float)spacing;
-
-  if(pairingsSize < 1 || !vertexIdentifierScalars || !nodeTypeScalars
-     || !persistenceScalars || !extremumIndexScalars || !points)
-    return -2;
 
-  diagram.resize((unsigned long)pairingsSize);
-  int nbNonCompact = 0;
-
-  for(int i = 0; i < pairingsSize; ++i) {
-
-    int vertexId1 = vertexIdentifierScalars->GetValue(2 * i);
-    int vertexId2 = vertexIdentifierScalars->GetValue(2 * i + 1);
-    int nodeType1 = nodeTypeScalars->GetValue(2 * i);
-    int nodeType2 = nodeTypeScalars->GetValue(2 * i + 1);
-
-    int pairIdentifier = pairIdentifierScalars->GetValue(i);
-    int pairType = extremumIndexScalars->GetValue(i);
-    double persistence = persistenceScalars->GetValue(i);
-
-    int index1 = 2 * i;
-    double *coords1 = points->GetPoint(index1);
-    auto x1 = (float)coords1[0];
-    auto y1 = (float)coords1[1];
-    auto z1 = (float)coords1[2];
-
-    int index2 = index1 + 1;
-    double *coords2 = points->GetPoint(index2);
-    auto x2 = (float)coords2[0];
-    auto y2 = (float)coords2[1];
-    auto z2 = (float)coords2[2];
-
-    dataType value1 = (!birthScalars) ? (dataType)x1
-                                      : (dataType)birthScalars->GetValue(2 * i);
-    dataType value2 = (!deathScalars)
-                        ? (dataType)y2
-                        : (dataType)deathScalars->GetValue(2 * i + 1);
-
-    if(pairIdentifier != -1 && pairIdentifier < pairingsSize)
-      diagram.at(pairIdentifier)
-        = std::make_tuple(vertexId1, (BNodeType)nodeType1, vertexId2,
-                          (BNodeType)nodeType2, (dataType)persistence, pairType,
-                          value1, x1, y1, z1 + s, value2, x2, y2, z2 + s);
-
-    if(pairIdentifier >= pairingsSize) {
-      nbNonCompact++;
-      if(nbNonCompact == 0) {
-        std::stringstream msg;
-        msg << "Diagram pair identifiers "
-            << "must be compact (not exceed the diagram size). " << std::endl;
-        this->printWrn(msg.str());
-      }
-    }
+  // the pairs of the diagrams in the birth-death plane are matched with
+  // their plane coordinates
+  const int status = VTUToDiagram(diagram, CTPersistenceDiagram_, *this, true);
+  if(status != 0) {
+    return status;
   }
 
-  if(nbNonCompact > 0) {
-    std::stringstream msg;
-    msg << "Missed " << nbNonCompact << " pairs due to non-compactness."
-        << std::endl;
-    this->printWrn(msg.str());
+  if(!Is3D && diagramNumber == 1) {
+    const float s = spacing;
+    float *const birthZ = diagram.birthZ.data();
+    float *const deathZ = diagram.deathZ.data();
+    for(size_t i = 0; i < diagram.size(); ++i) {
+      birthZ[i] += s;
+      deathZ[i] += s;
+    }
   }
 
-  sort(diagram.begin(), diagram.end(),
-       [](const diagramTuple &a, const diagramTuple &b) -> bool {
-         return std::get<6>(a) < std::get<6>(b);
-       });
-
   return 1;
 }
 
-// Warn: this is duplicated in ttkTrackingFromPersistenceDiagrams
-template <typename dataType>
 int ttkBottleneckDistance::augmentPersistenceDiagrams(
-  const std::vector<diagramTuple> &diagram1,
-  const std::vector<diagramTuple> &diagram2,
+  const ttk::PersistenceDiagramColumns<double> &diagram1,
+  const ttk::PersistenceDiagramColumns<double> &diagram2,
   const std::vector<matchingTuple> &matchings,
   vtkUnstructuredGrid *const CTPersistenceDiagram1,
   vtkUnstructuredGrid *const CTPersistenceDiagram2) {
@@ -355,14 +291,11 @@ int ttkBottleneckDistance::translateSecondDiagram(
   return 1;
 }
 
-template <typename dataType>
 int ttkBottleneckDistance::getMatchingMesh(
   vtkUnstructuredGrid *const outputCT3,
-  const std::vector<diagramTuple> &diagram1,
-  const std::vector<diagramTuple> &diagram2,
+  const ttk::PersistenceDiagramColumns<double> &diagram1,
+  const ttk::PersistenceDiagramColumns<double> &diagram2,
   const std::vector<matchingTuple> &matchings,
-  const bool useGeometricSpacing,
-  const double spacing,
   const bool is2D) {
 
   vtkNew<vtkPoints> points{};
@@ -386,67 +319,17 @@ int ttkBottleneckDistance::getMatchingMesh(
       auto n1 = (int)std::get<0>(t);
       auto n2 = (int)std::get<1>(t);
 
-      diagramTuple tuple1 = diagram1.at(n1);
-      diagramTuple tuple2 = diagram2.at(n2);
-
-      double x1, y1, z1, x2, y2, z2;
-
-      bool linkMiddles = false;
-      if(linkMiddles) {
-        x1 = (std::get<7>(tuple1) + std::get<11>(tuple1)) / 2;
-        y1 = (std::get<8>(tuple1) + std::get<12>(tuple1)) / 2;
-        z1 = (std::get<9>(tuple1) + std::get<13>(tuple1)) / 2;
-      } else {
-        BNodeType t11 = std::get<1>(tuple1);
-        BNodeType t12 = std::get<3>(tuple1);
-        bool t11Max = t11 == BLocalMin || t11 == BLocalMax;
-        bool t12Max = t12 == BLocalMin || t12 == BLocalMax;
-        if(is2D) { // Quickchage for highlighting 2D matching
-          if(t11 != BLocalMax && t12 != BLocalMax) {
-            t11Max = t11 != BLocalMin;
-            t12Max = t12 != BLocalMin;
-          }
-        }
-        x1 = t12Max   ? std::get<11>(tuple1)
-             : t11Max ? std::get<7>(tuple1)
-                      : (std::get<7>(tuple1) + std::get<11>(tuple1)) / 2;
-        y1 = t12Max   ? std::get<12>(tuple1)
-             : t11Max ? std::get<8>(tuple1)
-                      : (std::get<8>(tuple1) + std::get<12>(tuple1)) / 2;
-        z1 = t12Max   ? std::get<13>(tuple1)
-             : t11Max ? std::get<9>(tuple1)
-                      : (std::get<9>(tuple1) + std::get<13>(tuple1)) / 2;
-      }
-      points->InsertNextPoint(x1, y1, z1);
-
-      if(linkMiddles) {
-        x2 = (std::get<7>(tuple2) + std::get<11>(tuple2)) / 2;
-        y2 = (std::get<8>(tuple2) + std::get<12>(tuple2)) / 2;
-        z2 = (std::get<9>(tuple2) + std::get<13>(tuple2)) / 2;
-        if(useGeometricSpacing)
-          z2 += spacing;
-      } else {
-        BNodeType t21 = std::get<1>(tuple2);
-        BNodeType t22 = std::get<3>(tuple2);
-        bool t21Max = t21 == BLocalMin || t21 == BLocalMax;
-        bool t22Max = t22 == BLocalMin || t22 == BLocalMax;
-        if(is2D) { // Quickchage for highlighting 2D matching
-          if(t21 != BLocalMax && t22 != BLocalMax) {
-            t21Max = t21 != BLocalMin;
-            t22Max = t22 != BLocalMin;
-          }
-        }
-        x2 = t22Max   ? std::get<11>(tuple2)
-             : t21Max ? std::get<7>(tuple2)
-                      : (std::get<7>(tuple2) + std::get<11>(tuple2)) / 2;
-        y2 = t22Max   ? std::get<12>(tuple2)
-             : t21Max ? std::get<8>(tuple2)
-                      : (std::get<8>(tuple2) + std::get<12>(tuple2)) / 2;
-        z2 = t22Max   ? std::get<13>(tuple2)
-             : t21Max ? std::get<9>(tuple2)
-                      : (std::get<9>(tuple2) + std::get<13>(tuple2)) / 2;
+      if(n1 < 0 || n1 >= static_cast<int>(diagram1.size()) || n2 < 0
+         || n2 >= static_cast<int>(diagram2.size())) {
+        this->printErr("Matching out of the diagrams");
+        return -1;
       }
-      points->InsertNextPoint(x2, y2, z2);
+
+      double p1[3], p2[3];
+      getMatchedPoint(diagram1, n1, is2D, p1);
+      getMatchedPoint(diagram2, n2, is2D, p2);
+      points->InsertNextPoint(p1);
+      points->InsertNextPoint(p2);
 
       ids[0] = 2 * i;
       ids[1] = 2 * i + 1;
@@ -470,15 +353,15 @@ int ttkBottleneckDistance::getMatchingMesh(
 int ttkBottleneckDistance::doBenchmark() {
   using dataType = double;
 
-  std::vector<diagramTuple> CTDiagram1;
-  std::vector<diagramTuple> CTDiagram2;
+  ttk::PersistenceDiagramColumns<dataType> CTDiagram1{};
+  ttk::PersistenceDiagramColumns<dataType> CTDiagram2{};
 
   int benchmarkSize = BenchmarkSize;
   int status = 0;
-  status = generatePersistenceDiagram<double>(CTDiagram1, benchmarkSize);
+  status = generatePersistenceDiagram(CTDiagram1, benchmarkSize);
   if(status < 0)
     return status;
-  status = generatePersistenceDiagram<double>(CTDiagram2, 4 * benchmarkSize);
+  status = generatePersistenceDiagram(CTDiagram2, 4 * benchmarkSize);
   if(status < 0)
     return status;
 
@@ -488,11 +371,10 @@ int ttkBottleneckDistance::doBenchmark() {
   this->setPZ(PZ);
   this->setPE(PE);
   this->setPS(PS);
-  this->setCTDiagram1(&CTDiagram1);
-  this->setCTDiagram2(&CTDiagram2);
 
   std::string wassersteinMetric = WassersteinMetric;
   this->setWasserstein(wassersteinMetric);
+  this->setBottleneckEpsilon(BottleneckEpsilon);
   std::string algorithm = DistanceAlgorithm;
   this->setAlgorithm(algorithm);
   int pvAlgorithm = PVAlgorithm;
@@ -500,12 +382,12 @@ int ttkBottleneckDistance::doBenchmark() {
   // this->setThreadNumber(thread);
 
   // Empty matchings.
-  auto matchings = new std::vector<diagramTuple>();
-  this->setOutputMatchings(matchings);
+  std::vector<matchingTuple> matchings{};
 
   // Exec.
   bool usePersistenceMetric = UsePersistenceMetric;
-  status = this->execute<dataType>(usePersistenceMetric);
+  status = this->execute<dataType>(
+    CTDiagram1, CTDiagram2, matchings, usePersistenceMetric);
 
   return status;
 }
@@ -542,27 +424,25 @@ int ttkBottleneckDistance::RequestData(vtkInformation * /*request*/,
     return 0;
   }
 
-  int dataType1 = CTPersistenceDiagram1->GetCellData()
-                    ->GetArray("Persistence")
-                    ->GetDataType();
-  int dataType2 = CTPersistenceDiagram2->GetCellData()
-                    ->GetArray("Persistence")
-                    ->GetDataType();
-  if(dataType1 != dataType2) {
+  auto persistence1
+    = CTPersistenceDiagram1->GetCellData()->GetArray(ttk::PersistenceName);
+  auto persistence2
+    = CTPersistenceDiagram2->GetCellData()->GetArray(ttk::PersistenceName);
+  if(!persistence1 || !persistence2) {
+    this->printErr("Missing Persistence array");
+    return 0;
+  }
+  if(persistence1->GetDataType() != persistence2->GetDataType()) {
     this->printErr("Persistence array data type should be the same");
     return 0;
   }
 
-  auto birthScalars1 = vtkDoubleArray::SafeDownCast(
-    CTPersistenceDiagram1->GetPointData()->GetArray("Birth"));
-  auto deathScalars1 = vtkDoubleArray::SafeDownCast(
-    CTPersistenceDiagram1->GetPointData()->GetArray("Death"));
-  auto birthScalars2 = vtkDoubleArray::SafeDownCast(
-    CTPersistenceDiagram2->GetPointData()->GetArray("Birth"));
-  auto deathScalars2 = vtkDoubleArray::SafeDownCast(
-    CTPersistenceDiagram2->GetPointData()->GetArray("Death"));
-  bool is2D1 = !deathScalars1 && !birthScalars1;
-  bool is2D2 = !deathScalars2 && !birthScalars2;
+  auto pointData1 = CTPersistenceDiagram1->GetPointData();
+  auto pointData2 = CTPersistenceDiagram2->GetPointData();
+  bool is2D1 = !pointData1->GetArray(ttk::PersistenceDeathName)
+               && !pointData1->GetArray(ttk::PersistenceBirthName);
+  bool is2D2 = !pointData2->GetArray(ttk::PersistenceDeathName)
+               && !pointData2->GetArray(ttk::PersistenceBirthName);
   if(is2D1 != is2D2) {
     this->printErr("Diagrams should not be embedded");
     return 0;
@@ -572,49 +452,60 @@ int ttkBottleneckDistance::RequestData(vtkInformation * /*request*/,
   // Call package
   int status = 0;
 
-  //  switch (dataType1) {
-  //    vtkTemplateMacro(({
-  // TODO template my methods
-  std::vector<diagramTuple> CTDiagram1;
-  std::vector<diagramTuple> CTDiagram2;
+  // pairs in the cell order of the inputs
+  ttk::PersistenceDiagramColumns<dataType> CTDiagram1{};
+  ttk::PersistenceDiagramColumns<dataType> CTDiagram2{};
 
-  status = getPersistenceDiagram<dataType>(
-    CTDiagram1, CTPersistenceDiagram1, Spacing, 0);
+  status = getPersistenceDiagram(CTDiagram1, CTPersistenceDiagram1, Spacing, 0);
   if(status < 0) {
     this->printErr("Could not extract diagram from first input data-set");
     return 0;
   }
 
-  status = getPersistenceDiagram<dataType>(
-    CTDiagram2, CTPersistenceDiagram2, Spacing, 1);
+  status = getPersistenceDiagram(CTDiagram2, CTPersistenceDiagram2, Spacing, 1);
   if(status < 0) {
     this->printErr("Could not extract diagram from second input data-set");
     return 0;
   }
 
-  this->setCTDiagram1(&CTDiagram1);
-  this->setCTDiagram2(&CTDiagram2);
+  // the base layer expects pairs sorted by birth
+  ttk::PersistenceDiagramColumns<dataType> sortedDiagram1{};
+  ttk::PersistenceDiagramColumns<dataType> sortedDiagram2{};
+  std::vector<int> order1{}, order2{};
+  sortByBirth(CTDiagram1, sortedDiagram1, order1);
+  sortByBirth(CTDiagram2, sortedDiagram2, order2);
 
   this->setWasserstein(WassersteinMetric);
+  this->setBottleneckEpsilon(BottleneckEpsilon);
   this->setAlgorithm(DistanceAlgorithm);
   this->setPVAlgorithm(PVAlgorithm);
 
   // Empty matchings.
   std::vector<matchingTuple> matchings;
-  this->setOutputMatchings(&matchings);
 
   // Exec.
-  status = this->execute<dataType>(UsePersistenceMetric);
+  status = this->execute<dataType>(
+    sortedDiagram1, sortedDiagram2, matchings, UsePersistenceMetric);
   if(status != 0) {
     this->printErr("Base layer failed with error status "
                    + std::to_string(status));
     return 0;
   }
 
+  // back to the cell order
+  for(auto &t : matchings) {
+    if(std::get<0>(t) >= 0) {
+      std::get<0>(t) = order1[std::get<0>(t)];
+    }
+    if(std::get<1>(t) >= 0) {
+      std::get<1>(t) = order2[std::get<1>(t)];
+    }
+  }
+
   // Apply results to outputs 0 and 1.
-  status = augmentPersistenceDiagrams<dataType>(
-    CTDiagram1, CTDiagram2, matchings, CTPersistenceDiagram1,
-    CTPersistenceDiagram2);
+  status = augmentPersistenceDiagrams(CTDiagram1, CTDiagram2, matchings,
+                                      CTPersistenceDiagram1,
+                                      CTPersistenceDiagram2);
   if(status != 1) {
     this->printErr("Could not augment diagrams");
     return 0;
@@ -623,8 +514,7 @@ int ttkBottleneckDistance::RequestData(vtkInformation * /*request*/,
   // Apply results to output 2.
   if(UseOutputMatching) {
     status
-      = getMatchingMesh<dataType>(outputCT3, CTDiagram1, CTDiagram2, matchings,
-                                  UseGeometricSpacing, Spacing, is2D);
+      = getMatchingMesh(outputCT3, CTDiagram1, CTDiagram2, matchings, is2D);
 
     if(status != 1) {
       this->printErr("Could not compute matchings");
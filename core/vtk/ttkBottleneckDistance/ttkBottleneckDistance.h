@@ -68,6 +68,9 @@ public:
   vtkSetMacro(WassersteinMetric, const std::string &);
   vtkGetMacro(WassersteinMetric, std::string);
 
+  vtkSetMacro(BottleneckEpsilon, double);
+  vtkGetMacro(BottleneckEpsilon, double);
+
   vtkSetMacro(DistanceAlgorithm, const std::string &);
   vtkGetMacro(DistanceAlgorithm, std::string);
 
@@ -90,21 +93,18 @@ public:
                   vtkInformationVector **inputVector,
                   vtkInformationVector *outputVector) override;
 
-  // Warn: this is duplicated in ttkTrackingFromPersistenceDiagrams
-  template <typename dataType>
-  int getPersistenceDiagram(std::vector<diagramTuple> &diagram,
+  int getPersistenceDiagram(ttk::PersistenceDiagramColumns<double> &diagram,
                             vtkUnstructuredGrid *const CTPersistenceDiagram_,
                             double spacing,
                             int diagramNumber);
 
-  template <typename dataType>
-  int generatePersistenceDiagram(std::vector<diagramTuple> &diagram, int size);
+  int
+    generatePersistenceDiagram(ttk::PersistenceDiagramColumns<double> &diagram,
+                               int size);
 
-  // Warn: this is duplicated in ttkTrackingFromPersistenceDiagrams
-  template <typename dataType>
   int augmentPersistenceDiagrams(
-    const std::vector<diagramTuple> &diagram1,
-    const std::vector<diagramTuple> &diagram2,
+    const ttk::PersistenceDiagramColumns<double> &diagram1,
+    const ttk::PersistenceDiagramColumns<double> &diagram2,
     const std::vector<matchingTuple> &matchings,
     vtkUnstructuredGrid *const CTPersistenceDiagram1_,
     vtkUnstructuredGrid *const CTPersistenceDiagram2_);
@@ -112,13 +112,10 @@ public:
   template <typename dataType>
   int translateSecondDiagram(vtkUnstructuredGrid *outputCT2, double &spacing);
 
-  template <typename dataType>
   int getMatchingMesh(vtkUnstructuredGrid *const outputCT3,
-                      const std::vector<diagramTuple> &diagram1,
-                      const std::vector<diagramTuple> &diagram2,
+                      const ttk::PersistenceDiagramColumns<double> &diagram1,
+                      const ttk::PersistenceDiagramColumns<double> &diagram2,
                       const std::vector<matchingTuple> &matchings,
-                      bool useGeometricSpacing,
-                      double spacing,
                       bool is2D);
 
   int doBenchmark();
@@ -141,6 +138,7 @@ private:
   double PS{1.0};
   std::string DistanceAlgorithm{};
   std::string WassersteinMetric{"2"};
+  double BottleneckEpsilon{0.0};
   bool UsePersistenceMetric{false};
   bool UseGeometricSpacing{false};
   int PVAlgorithm{-1};
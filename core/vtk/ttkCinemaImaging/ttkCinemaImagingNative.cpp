@@ -62,9 +62,10 @@ int ttk::ttkCinemaImagingNative::RenderVTKObject(
   ttk::Timer test;
   BoundingVolumeHierarchy<vtkIdType> bvh(
     static_cast<float *>(ttkUtils::GetVoidPointer(inputObject->GetPoints())),
-    inputObjectConnectivityList, inputObjectCells->GetNumberOfCells());
+    inputObjectConnectivityList, inputObjectCells->GetNumberOfCells(),
+    this->threadNumber_);
 
-  this->printMsg("BVH", 1, test.getElapsedTime(), 1);
+  this->printMsg("BVH", 1, test.getElapsedTime(), this->threadNumber_);
 
   for(int i = 0; i < nSamplingPositions; i++) {
 
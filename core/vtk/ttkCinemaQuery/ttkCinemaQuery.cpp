@@ -2,11 +2,13 @@
 
 #include <vtkInformation.h>
 
+#include <vtkDataArray.h>
 #include <vtkDelimitedTextReader.h>
 #include <vtkFieldData.h>
 #include <vtkInformationVector.h>
 #include <vtkObjectFactory.h>
 #include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
 #include <vtkTable.h>
 
 #include <ttkUtils.h>
@@ -19,6 +21,77 @@
 
 vtkStandardNewMacro(ttkCinemaQuery);
 
+namespace {
+
+  // copy the columns of a VTK table
+  void toCinemaTable(vtkTable *inTable, ttk::CinemaTable &table) {
+    const size_t nc = inTable->GetNumberOfColumns();
+    const size_t nr = inTable->GetNumberOfRows();
+    table.reset(nr);
+
+    for(size_t j = 0; j < nc; ++j) {
+      auto c = inTable->GetColumn(j);
+      auto dataArray = vtkDataArray::SafeDownCast(c);
+      if(c->IsNumeric() && dataArray) {
+        std::vector<double> values(nr);
+        for(size_t r = 0; r < nr; ++r) {
+          values[r] = dataArray->GetComponent(r, 0);
+        }
+        table.addNumericColumn(c->GetName(), values);
+      } else {
+        auto stringArray = vtkStringArray::SafeDownCast(c);
+        std::vector<char> text;
+        std::vector<uint64_t> offsets(1, 0);
+        offsets.reserve(nr + 1);
+        for(size_t r = 0; r < nr; ++r) {
+          const auto value = stringArray ? stringArray->GetValue(r)
+                                         : c->GetVariantValue(r).ToString();
+          text.insert(text.end(), value.begin(), value.end());
+          offsets.emplace_back(text.size());
+        }
+        table.addTextColumn(c->GetName(), text, offsets);
+      }
+    }
+  }
+
+  // checksum of the layout and of every value of a VTK table, stored in
+  // the index when it is built: the source description of the index only
+  // identifies the file the table was read from, while downstream filters
+  // may have modified the table since. Numeric columns are hashed through
+  // their raw buffers, which is much cheaper than reading every value.
+  uint64_t tableChecksum(vtkTable *inTable) {
+    const uint64_t nc = inTable->GetNumberOfColumns();
+    const uint64_t nr = inTable->GetNumberOfRows();
+    uint64_t h = ttk::CinemaTable::hashBytes(&nc, sizeof(nc), nr);
+
+    for(size_t j = 0; j < nc; ++j) {
+      auto c = inTable->GetColumn(j);
+      const std::string name = c->GetName() ? c->GetName() : "";
+      const int type = c->GetDataType();
+      h = ttk::CinemaTable::hashBytes(name.data(), name.size(), h);
+      h = ttk::CinemaTable::hashBytes(&type, sizeof(type), h);
+
+      auto dataArray = vtkDataArray::SafeDownCast(c);
+      if(c->IsNumeric() && dataArray && type != VTK_BIT) {
+        h = ttk::CinemaTable::hashBytes(
+          ttkUtils::GetVoidPointer(dataArray),
+          nr * dataArray->GetNumberOfComponents()
+            * dataArray->GetDataTypeSize(),
+          h);
+      } else {
+        auto stringArray = vtkStringArray::SafeDownCast(c);
+        for(size_t r = 0; r < nr; ++r) {
+          const auto value = stringArray ? stringArray->GetValue(r)
+                                         : c->GetVariantValue(r).ToString();
+          h = ttk::CinemaTable::hashBytes(value.data(), value.size(), h);
+        }
+      }
+    }
+    return h;
+  }
+
+} // namespace
+
 ttkCinemaQuery::ttkCinemaQuery() {
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(1);
@@ -61,19 +134,16 @@ int ttkCinemaQuery::RequestData(vtkInformation *request,
 
   auto firstTable = inTables[0];
 
-  std::vector<std::string> sqlTableDefinitions;
-  std::vector<std::string> sqlInsertStatements;
+  std::vector<ttk::CinemaTable> tables(nTables);
   {
     ttk::Timer conversionTimer;
-    this->printMsg("Converting input VTK tables to SQL tables", 0,
+    this->printMsg("Converting input VTK tables to columnar tables", 0,
                    ttk::debug::LineMode::REPLACE);
 
     for(int i = 0; i < nTables; i++) {
       auto inTable = inTables[i];
 
       size_t nc = inTable->GetNumberOfColumns();
-      size_t nr = inTable->GetNumberOfRows();
-      std::vector<bool> isNumeric(nc);
 
       // select all input columns whose name is NOT matching the regexp
       std::vector<size_t> includeColumns{};
@@ -90,61 +160,41 @@ int ttkCinemaQuery::RequestData(vtkInformation *request,
       }
 
       // -----------------------------------------------------------------------
-      // Table Definition
-      std::string sqlTableDefinition
-        = "CREATE TABLE InputTable" + std::to_string(i) + " (";
-      bool firstCol{true};
-      for(const auto j : includeColumns) {
-        auto c = inTable->GetColumn(j);
-        isNumeric[j] = c->IsNumeric();
-        sqlTableDefinition += (firstCol ? "" : ",") + std::string(c->GetName())
-                              + " " + (isNumeric[j] ? "REAL" : "TEXT");
-        if(firstCol) {
-          firstCol = false;
-        }
+      // Cinema database index (see ttkCinemaReader)
+      auto indexInfo = vtkStringArray::SafeDownCast(
+        inTable->GetFieldData()->GetAbstractArray("_ttk_CinemaIndex"));
+      std::string indexPath{}, indexSource{};
+      if(indexInfo && indexInfo->GetNumberOfValues() == 2) {
+        indexPath = indexInfo->GetValue(0);
+        indexSource = indexInfo->GetValue(1);
       }
-      sqlTableDefinition += ")";
-      sqlTableDefinitions.emplace_back(sqlTableDefinition);
 
-      // -----------------------------------------------------------------------
-      // Insert Statements
-      size_t q = 0;
-      while(q < nr) {
-        std::string sqlInsertStatement
-          = "INSERT INTO InputTable" + std::to_string(i) + " VALUES ";
-        for(size_t j = 0; j < 500 && q < nr; j++) {
-          if(j > 0)
-            sqlInsertStatement += ",";
-
-          sqlInsertStatement += "(";
-          firstCol = true;
-          for(const auto k : includeColumns) {
-            sqlInsertStatement += (firstCol ? "" : ",");
-            if(firstCol) {
-              firstCol = false;
-            }
-            if(isNumeric[k]) {
-              const auto var = inTable->GetValue(q, k);
-              if(var.IsChar() || var.IsSignedChar()) {
-                // convert char/signed char to int to get its value
-                // instead of its char representation
-                sqlInsertStatement += std::to_string(var.ToInt());
-              } else {
-                sqlInsertStatement += var.ToString();
-              }
-            } else {
-              sqlInsertStatement
-                += "'" + inTable->GetValue(q, k).ToString() + "'";
-            }
+      const uint64_t checksum
+        = indexPath.empty() ? 0 : tableChecksum(inTable);
+
+      if(indexPath.empty() || tables[i].read(indexPath) != 0
+         || tables[i].getSource() != indexSource
+         || tables[i].getChecksum() != checksum) {
+
+        // -------------------------------------------------------------------
+        // Column Conversion
+        toCinemaTable(inTable, tables[i]);
+
+        if(!indexPath.empty()) {
+          // persistent index for the next queries
+          tables[i].computeOrders(this->threadNumber_);
+          tables[i].setSource(indexSource);
+          tables[i].setChecksum(checksum);
+          if(tables[i].write(indexPath) != 0) {
+            this->printWrn("Could not write index file '" + indexPath + "'");
           }
-          sqlInsertStatement += ")";
-          q++;
         }
-        sqlInsertStatements.emplace_back(sqlInsertStatement);
       }
+
+      tables[i].selectColumns(includeColumns);
     }
 
-    this->printMsg("Converting input VTK tables to SQL tables", 1,
+    this->printMsg("Converting input VTK tables to columnar tables", 1,
                    conversionTimer.getElapsedTime());
   }
 
@@ -167,9 +217,8 @@ int ttkCinemaQuery::RequestData(vtkInformation *request,
   int csvNColumns = 0;
   int csvNRows = 0;
 
-  int status
-    = this->execute(sqlTableDefinitions, sqlInsertStatements, finalQueryString,
-                    csvResult, csvNColumns, csvNRows);
+  int status = this->execute(
+    tables, finalQueryString, csvResult, csvNColumns, csvNRows);
 
   // ===========================================================================
   // Process Result
@@ -204,6 +253,9 @@ int ttkCinemaQuery::RequestData(vtkInformation *request,
       size_t n = inFD->GetNumberOfArrays();
       for(size_t i = 0; i < n; i++) {
         auto iArray = inFD->GetAbstractArray(i);
+        // the index of the input table does not describe the result
+        if(std::string{iArray->GetName()} == "_ttk_CinemaIndex")
+          continue;
         if(!outFD->GetAbstractArray(iArray->GetName())) {
           outFD->AddArray(iArray);
         }
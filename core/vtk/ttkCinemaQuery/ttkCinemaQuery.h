@@ -6,8 +6,14 @@
 /// \brief TTK VTK-filter that uses a SQL statement to select a subset of a
 /// vtkTable.
 ///
-/// This filter creates a temporary SQLite3 database from the input table,
-/// performs a SQL query, and then returns the result as a vtkTable.
+/// This filter converts the input tables to columnar tables, performs a SQL
+/// query, and then returns the result as a vtkTable. Simple selections
+/// (WHERE equality and range predicates, ORDER BY, LIMIT) are evaluated
+/// natively, other statements on a temporary SQLite3 database.
+///
+/// Tables read by ttkCinemaReader are not converted: their columnar index
+/// is stored next to the data.csv file of the database at the first query
+/// and memory-mapped by the following ones.
 ///
 /// VTK wrapping code for the @CinemaQuery package.
 ///
@@ -11,6 +11,8 @@
 
 #include <ttkUtils.h>
 
+#include <sys/stat.h>
+
 vtkStandardNewMacro(ttkCinemaReader);
 
 ttkCinemaReader::ttkCinemaReader() {
@@ -102,6 +104,23 @@ int ttkCinemaReader::RequestData(vtkInformation *request,
     this->printMsg("Reading CSV file", 1, timer.getElapsedTime());
   }
 
+  // location of the columnar index used by ttkCinemaQuery, and description
+  // of the table content to detect stale indices
+  {
+    const auto csvPath = this->GetDatabasePath() + "/data.csv";
+    struct stat csvStat {};
+    if(stat(csvPath.data(), &csvStat) == 0) {
+      auto indexInfo = vtkSmartPointer<vtkStringArray>::New();
+      indexInfo->SetName("_ttk_CinemaIndex");
+      indexInfo->SetNumberOfValues(2);
+      indexInfo->SetValue(0, csvPath + ".ttkindex");
+      indexInfo->SetValue(1, csvPath + "\n" + this->GetFilePathColumnNames()
+                               + "\n" + std::to_string(csvStat.st_size)
+                               + "\n" + std::to_string(csvStat.st_mtime));
+      outTable->GetFieldData()->AddArray(indexInfo);
+    }
+  }
+
   // print stats
   this->printMsg(ttk::debug::Separator::L2);
   this->printMsg(
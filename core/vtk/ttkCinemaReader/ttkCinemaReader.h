@@ -10,6 +10,9 @@
 ///
 /// \param Output content of the data.csv file of the database in form of a
 /// vtkTable
+///
+/// The output field data also locates the columnar index of the database
+/// (data.csv.ttkindex), which is built and used by ttkCinemaQuery.
 
 #pragma once
 
@@ -90,8 +90,10 @@ bool Class::preprocessFld(vtkDataSet *dataset) {
 
   const double radius = ui_spherical ? -1. : 0.;
 
+  // explicit meshes: compute the vertex neighbors by blocks, on demand
   const auto errorCode = this->setInputField(
-    triangulation, ttkUtils::GetVoidPointer(scalars), ui_sizeFilter, radius);
+    triangulation, ttkUtils::GetVoidPointer(scalars), ui_sizeFilter, radius,
+    static_cast<std::size_t>(ui_memoryBudget) * 1024 * 1024);
   if(errorCode < 0) {
     printErr("super->setInputField failed with code "
              + std::to_string(errorCode));
@@ -44,6 +44,7 @@ public:
   vtkSetMacro(ui_extension, double) vtkGetMacro(ui_extension, double);
   vtkSetMacro(ui_sizeFilter, double) vtkGetMacro(ui_sizeFilter, double);
   vtkSetMacro(ui_spherical, bool) vtkGetMacro(ui_spherical, bool);
+  vtkSetMacro(ui_memoryBudget, int) vtkGetMacro(ui_memoryBudget, int);
 
   // for the standalone (maybe unify with the above sometime)
   void SetRegionExtension(double val) {
@@ -55,6 +56,9 @@ public:
   void SetSpherical(bool val) {
     ui_spherical = val;
   }
+  void SetMemoryBudget(int val) {
+    ui_memoryBudget = val;
+  }
 
 protected:
   ttkContourAroundPoint() {
@@ -119,6 +123,8 @@ private:
   double ui_sizeFilter;
   // name of the scalar variable of the input field
   bool ui_spherical;
+  // memory budget of the vertex neighbors, in MB (0: unbounded)
+  int ui_memoryBudget = 0;
 
   ttk::Triangulation::Type _triangTypeCode; // triangulation->getType()
   int _scalarTypeCode; // VTK type of the scalars defined on the input field
@@ -2,6 +2,7 @@
 #include <ttkUtils.h>
 
 #include <vtkDoubleArray.h>
+#include <vtkFieldData.h>
 #include <vtkInformation.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
@@ -55,7 +56,7 @@ int ttkDimensionReduction::RequestData(vtkInformation *request,
     }
   }
 
-  if(this->isPythonFound()) {
+  if(this->isNativeBackendUsed(this->Method) || this->isPythonFound()) {
     const SimplexId numberOfRows = input->GetNumberOfRows();
     const SimplexId numberOfColumns = ScalarFields.size();
 
@@ -72,15 +73,49 @@ int ttkDimensionReduction::RequestData(vtkInformation *request,
     std::vector<vtkAbstractArray *> arrays;
     for(const auto &s : ScalarFields)
       arrays.push_back(input->GetColumnByName(s.data()));
-    for(SimplexId i = 0; i < numberOfRows; ++i) {
-      for(auto arr : arrays)
-        inputData.push_back(arr->GetVariantValue(i).ToDouble());
+
+    // ttkLDistanceMatrix output: if all its columns are selected, in
+    // order, they are the rows of the (symmetric) matrix, read in place
+    auto matrix = vtkDoubleArray::SafeDownCast(
+      input->GetFieldData()->GetArray("DistanceMatrix"));
+    if(matrix != nullptr
+       && (numberOfRows != numberOfColumns
+           || matrix->GetNumberOfComponents() != numberOfColumns
+           || matrix->GetNumberOfTuples() != numberOfRows)) {
+      matrix = nullptr;
+    }
+    for(SimplexId j = 0; j < numberOfColumns && matrix != nullptr; ++j) {
+      const auto arr = vtkDoubleArray::SafeDownCast(arrays[j]);
+      if(arr == nullptr || arr->GetNumberOfComponents() != 1
+         || arr->GetPointer(0) != matrix->GetPointer(j * numberOfColumns)) {
+        matrix = nullptr;
+      }
+    }
+
+    // other double columns are read through their raw pointer
+    if(matrix == nullptr) {
+      inputData.resize(numberOfRows * numberOfColumns);
+    }
+    for(SimplexId j = 0; j < numberOfColumns && matrix == nullptr; ++j) {
+      const auto arr = vtkDoubleArray::SafeDownCast(arrays[j]);
+      if(arr != nullptr && arr->GetNumberOfComponents() == 1) {
+        const double *const values = arr->GetPointer(0);
+        for(SimplexId i = 0; i < numberOfRows; ++i) {
+          inputData[i * numberOfColumns + j] = values[i];
+        }
+      } else {
+        for(SimplexId i = 0; i < numberOfRows; ++i) {
+          inputData[i * numberOfColumns + j]
+            = arrays[j]->GetVariantValue(i).ToDouble();
+        }
+      }
     }
 
     outputData_.clear();
 
     this->setInputMatrixDimensions(numberOfRows, numberOfColumns);
-    this->setInputMatrix(inputData.data());
+    this->setInputMatrix(matrix != nullptr ? matrix->GetPointer(0)
+                                           : inputData.data());
     this->setInputMethod(Method);
     this->setInputNumberOfComponents(NumberOfComponents);
     this->setInputNumberOfNeighbors(NumberOfNeighbors);
@@ -66,12 +66,16 @@ public:
   vtkSetMacro(KeepAllDataArrays, bool);
   vtkGetMacro(KeepAllDataArrays, bool);
 
-  // SE && MDS
+  vtkSetMacro(UseNativeBackend, bool);
+  vtkGetMacro(UseNativeBackend, bool);
+
+  // SE, MDS && t-SNE
   void SetInputIsADistanceMatrix(const bool b) {
     this->InputIsADistanceMatrix = b;
     if(b) {
       this->mds_Dissimilarity = "precomputed";
       this->se_Affinity = "precomputed";
+      this->tsne_Metric = "precomputed";
     }
     Modified();
   }
@@ -128,6 +132,9 @@ public:
   vtkSetMacro(mds_Epsilon, float);
   vtkGetMacro(mds_Epsilon, float);
 
+  vtkSetMacro(mds_NumberOfLandmarks, int);
+  vtkGetMacro(mds_NumberOfLandmarks, int);
+
   // TSNE
   vtkSetMacro(tsne_Perplexity, float);
   vtkGetMacro(tsne_Perplexity, float);
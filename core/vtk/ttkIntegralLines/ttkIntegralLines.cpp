@@ -2,10 +2,12 @@
 #include <ttkMacros.h>
 #include <ttkUtils.h>
 
+#include <vtkCellArray.h>
 #include <vtkDataObject.h>
 #include <vtkDataSet.h>
 #include <vtkDoubleArray.h>
 #include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkInformation.h>
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
@@ -15,6 +17,23 @@
 using namespace std;
 using namespace ttk;
 
+namespace {
+  // value of the input scalar field at every trajectory vertex
+  template <typename T>
+  void copyAlongTrajectories(const T *const values,
+                             const ttk::SimplexId *const vertices,
+                             const ttk::SimplexId nPoints,
+                             double *const output,
+                             const int threadNumber) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+    for(ttk::SimplexId i = 0; i < nPoints; ++i) {
+      output[i] = static_cast<double>(values[vertices[i]]);
+    }
+  }
+} // namespace
+
 vtkStandardNewMacro(ttkIntegralLines)
 
   ttkIntegralLines::ttkIntegralLines() {
@@ -43,7 +62,7 @@ int ttkIntegralLines::FillOutputPortInformation(int port,
 
 int ttkIntegralLines::getTrajectories(vtkDataSet *input,
                                       ttk::Triangulation *triangulation,
-                                      vector<vector<SimplexId>> &trajectories,
+                                      const ttk::FlatJaggedArray &trajectories,
                                       vtkUnstructuredGrid *output) {
   vtkSmartPointer<vtkUnstructuredGrid> ug
     = vtkSmartPointer<vtkUnstructuredGrid>::New();
@@ -52,6 +71,17 @@ int ttkIntegralLines::getTrajectories(vtkDataSet *input,
   dist->SetNumberOfComponents(1);
   dist->SetName("DistanceFromSeed");
 
+  // one output point per trajectory vertex, one line per trajectory edge
+  const SimplexId nTrajectories = trajectories.subvectorsNumber();
+  const SimplexId nPoints = trajectories.dataSize();
+  SimplexId nCells{};
+  for(SimplexId i = 0; i < nTrajectories; ++i) {
+    nCells += std::max(trajectories.size(i) - 1, SimplexId{0});
+  }
+
+  pts->SetNumberOfPoints(nPoints);
+  dist->SetNumberOfTuples(nPoints);
+
   // here, copy the original scalars
   int numberOfArrays = input->GetPointData()->GetNumberOfArrays();
 
@@ -68,46 +98,72 @@ int ttkIntegralLines::getTrajectories(vtkDataSet *input,
     inputScalars[k] = vtkSmartPointer<vtkDoubleArray>::New();
     inputScalars[k]->SetNumberOfComponents(1);
     inputScalars[k]->SetName(scalarArrays[k]->GetName());
+    inputScalars[k]->SetNumberOfTuples(nPoints);
   }
 
-  float p0[3];
-  float p1[3];
-  vtkIdType ids[2];
-  for(SimplexId i = 0; i < (SimplexId)trajectories.size(); ++i) {
-    if(trajectories[i].size()) {
-      SimplexId vertex = trajectories[i][0];
-      // init
-      triangulation->getVertexPoint(vertex, p0[0], p0[1], p0[2]);
-      ids[0] = pts->InsertNextPoint(p0);
-      // distanceScalars
-      float distanceFromSeed{};
-      dist->InsertNextTuple1(distanceFromSeed);
-      // inputScalars
-      for(unsigned int k = 0; k < scalarArrays.size(); ++k)
-        inputScalars[k]->InsertNextTuple1(scalarArrays[k]->GetTuple1(vertex));
-
-      for(SimplexId j = 1; j < (SimplexId)trajectories[i].size(); ++j) {
-        vertex = trajectories[i][j];
-        triangulation->getVertexPoint(vertex, p1[0], p1[1], p1[2]);
-        ids[1] = pts->InsertNextPoint(p1);
+  vtkNew<vtkIdTypeArray> offsets{}, connectivity{};
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(nCells + 1);
+  connectivity->SetNumberOfComponents(1);
+  connectivity->SetNumberOfTuples(2 * nCells);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < nTrajectories; ++i) {
+    const SimplexId begin = trajectories.offset(i);
+    const SimplexId size = trajectories.size(i);
+    // every trajectory holds at least its seed: the previous ones
+    // have (begin - i) lines
+    const SimplexId firstCell = begin - i;
+
+    float p0[3]{};
+    float p1[3]{};
+    float distanceFromSeed{};
+    for(SimplexId j = 0; j < size; ++j) {
+      const SimplexId vertex = trajectories.get(i, j);
+      const SimplexId pointId = begin + j;
+      triangulation->getVertexPoint(vertex, p1[0], p1[1], p1[2]);
+      pts->SetPoint(pointId, p1);
+      if(j > 0) {
         // distanceScalars
         distanceFromSeed += Geometry::distance(p0, p1, 3);
-        dist->InsertNextTuple1(distanceFromSeed);
-        // inputScalars
-        for(unsigned int k = 0; k < scalarArrays.size(); ++k)
-          inputScalars[k]->InsertNextTuple1(scalarArrays[k]->GetTuple1(vertex));
-
-        ug->InsertNextCell(VTK_LINE, 2, ids);
-
-        // iteration
-        ids[0] = ids[1];
-        p0[0] = p1[0];
-        p0[1] = p1[1];
-        p0[2] = p1[2];
+        const SimplexId cellId = firstCell + j - 1;
+        offsets->SetTuple1(cellId, 2 * cellId);
+        connectivity->SetTuple1(2 * cellId, pointId - 1);
+        connectivity->SetTuple1(2 * cellId + 1, pointId);
       }
+      dist->SetTuple1(pointId, distanceFromSeed);
+
+      // iteration
+      p0[0] = p1[0];
+      p0[1] = p1[1];
+      p0[2] = p1[2];
+    }
+  }
+  offsets->SetTuple1(nCells, 2 * nCells);
+
+  // inputScalars: typed reads, vtkDataArray::GetTuple1() is not thread-safe
+  for(unsigned int k = 0; k < scalarArrays.size(); ++k) {
+    switch(scalarArrays[k]->GetDataType()) {
+      vtkTemplateMacro(copyAlongTrajectories(
+        ttkUtils::GetPointer<VTK_TT>(scalarArrays[k]), trajectories.data_ptr(),
+        nPoints, ttkUtils::GetPointer<double>(inputScalars[k]),
+        this->threadNumber_));
+      default:
+        // bit arrays have no typed pointer: sequential generic reads
+        for(SimplexId i = 0; i < nPoints; ++i) {
+          inputScalars[k]->SetTuple1(
+            i, scalarArrays[k]->GetTuple1(trajectories.data_ptr()[i]));
+        }
+        break;
     }
   }
+
+  vtkNew<vtkCellArray> cells{};
+  cells->SetData(offsets, connectivity);
   ug->SetPoints(pts);
+  ug->SetCells(VTK_LINE, cells);
   ug->GetPointData()->AddArray(dist);
   for(unsigned int k = 0; k < scalarArrays.size(); ++k)
     ug->GetPointData()->AddArray(inputScalars[k]);
@@ -172,11 +228,12 @@ int ttkIntegralLines::RequestData(vtkInformation *request,
   }
 #endif
 
-  vector<vector<SimplexId>> trajectories;
+  ttk::FlatJaggedArray trajectories;
 
   this->setVertexNumber(numberOfPointsInDomain);
   this->setSeedNumber(numberOfPointsInSeeds);
   this->setDirection(Direction);
+  this->setMergeTrajectories(MergeTrajectories);
   this->setInputScalarField(inputScalars->GetVoidPointer(0));
   this->setInputOffsets(
     static_cast<SimplexId *>(inputOffsets->GetVoidPointer(0)));
@@ -184,12 +241,15 @@ int ttkIntegralLines::RequestData(vtkInformation *request,
   this->setVertexIdentifierScalarField(inputIdentifiers);
   this->setOutputTrajectories(&trajectories);
 
-  this->preconditionTriangulation(triangulation);
+  // explicit meshes: compute the vertex neighbors by blocks, on demand
+  this->preconditionTriangulation(
+    triangulation, static_cast<size_t>(MemoryBudget) * 1024 * 1024);
 
   int status = 0;
-  ttkVtkTemplateMacro(inputScalars->GetDataType(), triangulation->getType(),
-                      (status = this->execute<VTK_TT, TTK_TT>(
-                         static_cast<TTK_TT *>(triangulation->getData()))));
+  ttkVtkGridTemplateMacro(
+    inputScalars->GetDataType(), triangulation->getType(),
+    (status = this->execute<VTK_TT, TTK_TT>(
+       static_cast<TTK_TT *>(triangulation->getData()))));
 #ifndef TTK_ENABLE_KAMIKAZE
   // something wrong in baseCode
   if(status) {
@@ -78,6 +78,12 @@ public:
   vtkGetMacro(Direction, int);
   vtkSetMacro(Direction, int);
 
+  vtkSetMacro(MergeTrajectories, bool);
+  vtkGetMacro(MergeTrajectories, bool);
+
+  vtkSetMacro(MemoryBudget, int);
+  vtkGetMacro(MemoryBudget, int);
+
   vtkSetMacro(ForceInputVertexScalarField, bool);
   vtkGetMacro(ForceInputVertexScalarField, bool);
 
@@ -86,7 +92,7 @@ public:
 
   int getTrajectories(vtkDataSet *input,
                       ttk::Triangulation *triangulation,
-                      std::vector<std::vector<ttk::SimplexId>> &trajectories,
+                      const ttk::FlatJaggedArray &trajectories,
                       vtkUnstructuredGrid *output);
 
 protected:
@@ -101,6 +107,8 @@ protected:
 
 private:
   int Direction{0};
+  bool MergeTrajectories{false};
+  int MemoryBudget{0};
   bool ForceInputVertexScalarField{false};
   bool ForceInputOffsetScalarField{false};
 };
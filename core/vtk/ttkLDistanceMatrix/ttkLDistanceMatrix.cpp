@@ -4,6 +4,7 @@
 #include <vtkDataArray.h>
 #include <vtkDataSet.h>
 #include <vtkDoubleArray.h>
+#include <vtkFieldData.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
 #include <vtkMultiBlockDataSet.h>
@@ -12,6 +13,7 @@
 #include <vtkPointData.h>
 #include <vtkTable.h>
 
+#include <memory>
 #include <set>
 
 vtkStandardNewMacro(ttkLDistanceMatrix);
@@ -53,6 +55,11 @@ int ttkLDistanceMatrix::RequestData(vtkInformation * /*request*/,
 
   const size_t nInputs{blocks->GetNumberOfBlocks()};
 
+  if(nInputs == 0) {
+    this->printErr("No input block");
+    return 0;
+  }
+
   // Get input data
   std::vector<vtkDataSet *> inputData(nInputs);
 
@@ -79,8 +86,6 @@ int ttkLDistanceMatrix::RequestData(vtkInformation * /*request*/,
   // Get output
   auto DistTable = vtkTable::GetData(outputVector);
 
-  std::vector<std::vector<double>> distMatrix{};
-
   std::vector<void *> inputPtrs(nInputs);
   for(size_t i = 0; i < nInputs; ++i) {
     inputPtrs[i]
@@ -91,10 +96,6 @@ int ttkLDistanceMatrix::RequestData(vtkInformation * /*request*/,
   const auto dataType = firstField->GetDataType();
   const size_t nPoints = firstField->GetNumberOfTuples();
 
-  switch(dataType) {
-    vtkTemplateMacro(distMatrix = this->execute<VTK_TT>(inputPtrs, nPoints));
-  }
-
   // zero-padd column name to keep Row Data columns ordered
   const auto zeroPad
     = [](std::string &colName, const size_t numberCols, const size_t colIdx) {
@@ -104,20 +105,52 @@ int ttkLDistanceMatrix::RequestData(vtkInformation * /*request*/,
         colName.append(zer).append(cur);
       };
 
-  // copy distance matrix to output
+  // the whole matrix in one buffer, released with the last array using it
+  const size_t nValues = nInputs * nInputs;
+  double *distMatrix{};
+  std::shared_ptr<void> owner{};
+  if(this->MatrixFile.empty()) {
+    const auto values = std::make_shared<std::vector<double>>(nValues);
+    distMatrix = values->data();
+    owner = values;
+  } else {
+    const auto mapping = std::make_shared<ttk::MemoryMappedFile>();
+    if(mapping->create(this->MatrixFile, nValues * sizeof(double)) != 0) {
+      this->printErr("Could not map file " + this->MatrixFile);
+      return 0;
+    }
+    distMatrix = reinterpret_cast<double *>(mapping->writableData());
+    owner = mapping;
+  }
+
+  int status{};
+  switch(dataType) {
+    vtkTemplateMacro(status
+                     = this->execute<VTK_TT>(distMatrix, inputPtrs, nPoints));
+  }
+  if(status != 0) {
+    return 0;
+  }
+
+  // the matrix is symmetric: the output columns are its rows
   for(size_t i = 0; i < nInputs; ++i) {
     std::string name{"Dataset"};
-    zeroPad(name, distMatrix.size(), i);
+    zeroPad(name, nInputs, i);
 
     vtkNew<vtkDoubleArray> col{};
-    col->SetNumberOfTuples(nInputs);
+    ttkUtils::SetVoidArray(col, distMatrix + i * nInputs, nInputs, owner);
     col->SetName(name.c_str());
-    for(size_t j = 0; j < nInputs; ++j) {
-      col->SetTuple1(j, distMatrix[i][j]);
-    }
     DistTable->AddColumn(col);
   }
 
+  // the whole matrix, one tuple per row, e.g. read in place by
+  // ttkDimensionReduction
+  vtkNew<vtkDoubleArray> matrix{};
+  matrix->SetNumberOfComponents(nInputs);
+  ttkUtils::SetVoidArray(matrix, distMatrix, nValues, owner);
+  matrix->SetName("DistanceMatrix");
+  DistTable->GetFieldData()->AddArray(matrix);
+
   // aggregate input field data
   vtkNew<vtkFieldData> fd{};
   fd->CopyStructure(inputData[0]->GetFieldData());
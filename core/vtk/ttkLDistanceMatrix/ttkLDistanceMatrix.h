@@ -6,6 +6,10 @@
 /// \brief Computes a distance matrix using LDistance between several
 /// input datasets with the same number of points
 ///
+/// The matrix is stored once, in a contiguous buffer: the output columns
+/// and the "DistanceMatrix" field data array (one tuple per row) share it
+/// without copy. It can be backed by a memory mapped file (MatrixFile).
+///
 /// \sa LDistanceMatrix
 
 #pragma once
@@ -29,6 +33,9 @@ public:
   vtkSetMacro(DistanceType, const std::string &);
   vtkGetMacro(DistanceType, std::string);
 
+  vtkSetMacro(MatrixFile, const std::string &);
+  vtkGetMacro(MatrixFile, std::string);
+
 protected:
   ttkLDistanceMatrix();
   ~ttkLDistanceMatrix() override = default;
@@ -39,4 +46,7 @@ protected:
   int RequestData(vtkInformation *request,
                   vtkInformationVector **inputVector,
                   vtkInformationVector *outputVector) override;
+
+  // if not empty, the matrix is written in this file, mapped in memory
+  std::string MatrixFile{};
 };
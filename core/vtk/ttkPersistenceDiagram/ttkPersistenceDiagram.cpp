@@ -1,15 +1,10 @@
-#include <vtkCellData.h>
 #include <vtkDataSet.h>
-#include <vtkDoubleArray.h>
-#include <vtkFloatArray.h>
-#include <vtkIdTypeArray.h>
 #include <vtkInformation.h>
-#include <vtkNew.h>
 #include <vtkPointData.h>
-#include <vtkSmartPointer.h>
 
 #include <ttkMacros.h>
 #include <ttkPersistenceDiagram.h>
+#include <ttkPersistenceDiagramUtils.h>
 #include <ttkUtils.h>
 
 vtkStandardNewMacro(ttkPersistenceDiagram);
@@ -37,176 +32,6 @@ int ttkPersistenceDiagram::FillOutputPortInformation(int port,
   return 0;
 }
 
-template <typename scalarType, typename triangulationType>
-int ttkPersistenceDiagram::setPersistenceDiagram(
-  vtkUnstructuredGrid *outputCTPersistenceDiagram,
-  const std::vector<ttk::PersistencePair> &diagram,
-  vtkDataArray *inputScalarsArray,
-  const scalarType *const inputScalars,
-  const triangulationType *triangulation) const {
-
-  if(diagram.empty()) {
-    return 1;
-  }
-
-  vtkNew<vtkUnstructuredGrid> persistenceDiagram{};
-
-  // point data arrays
-
-  vtkNew<ttkSimplexIdTypeArray> vertexIdentifierScalars{};
-  vertexIdentifierScalars->SetNumberOfComponents(1);
-  vertexIdentifierScalars->SetName(ttk::VertexScalarFieldName);
-  vertexIdentifierScalars->SetNumberOfTuples(2 * diagram.size());
-
-  vtkNew<vtkIntArray> nodeTypeScalars{};
-  nodeTypeScalars->SetNumberOfComponents(1);
-  nodeTypeScalars->SetName(ttk::PersistenceCriticalTypeName);
-  nodeTypeScalars->SetNumberOfTuples(2 * diagram.size());
-
-  vtkNew<vtkFloatArray> coordsScalars{};
-  vtkSmartPointer<vtkDataArray> birthScalars{inputScalarsArray->NewInstance()};
-  vtkSmartPointer<vtkDataArray> deathScalars{inputScalarsArray->NewInstance()};
-
-  if(this->ShowInsideDomain) {
-    birthScalars->SetNumberOfComponents(1);
-    birthScalars->SetName(ttk::PersistenceBirthName);
-    birthScalars->SetNumberOfTuples(2 * diagram.size());
-
-    deathScalars->SetNumberOfComponents(1);
-    deathScalars->SetName(ttk::PersistenceDeathName);
-    deathScalars->SetNumberOfTuples(2 * diagram.size());
-  } else {
-    coordsScalars->SetNumberOfComponents(3);
-    coordsScalars->SetName(ttk::PersistenceCoordinatesName);
-    coordsScalars->SetNumberOfTuples(2 * diagram.size());
-  }
-
-  // cell data arrays
-
-  vtkNew<ttkSimplexIdTypeArray> pairIdentifierScalars{};
-  pairIdentifierScalars->SetNumberOfComponents(1);
-  pairIdentifierScalars->SetName(ttk::PersistencePairIdentifierName);
-  pairIdentifierScalars->SetNumberOfTuples(diagram.size());
-
-  vtkNew<vtkDoubleArray> persistenceScalars{};
-  persistenceScalars->SetNumberOfComponents(1);
-  persistenceScalars->SetName(ttk::PersistenceName);
-  persistenceScalars->SetNumberOfTuples(diagram.size());
-
-  vtkNew<vtkIntArray> extremumIndexScalars{};
-  extremumIndexScalars->SetNumberOfComponents(1);
-  extremumIndexScalars->SetName(ttk::PersistencePairTypeName);
-  extremumIndexScalars->SetNumberOfTuples(diagram.size());
-
-  const ttk::SimplexId minIndex = 0;
-  const ttk::SimplexId saddleSaddleIndex = 1;
-  const ttk::SimplexId maxIndex = triangulation->getCellVertexNumber(0) - 2;
-
-  vtkNew<vtkPoints> points{};
-  points->SetNumberOfPoints(2 * diagram.size());
-  vtkNew<vtkIdTypeArray> offsets{}, connectivity{};
-  offsets->SetNumberOfComponents(1);
-  offsets->SetNumberOfTuples(diagram.size() + 1);
-  connectivity->SetNumberOfComponents(1);
-  connectivity->SetNumberOfTuples(2 * diagram.size());
-
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(this->threadNumber_)
-#endif // TTK_ENABLE_OPENMP
-  for(size_t i = 0; i < diagram.size(); ++i) {
-    const auto a = diagram[i].birth;
-    const auto b = diagram[i].death;
-    const auto ta = diagram[i].birthType;
-    const auto tb = diagram[i].deathType;
-    // inputScalarsArray->GetTuple is not thread safe...
-    const auto sa = inputScalars[a];
-    const auto sb = inputScalars[b];
-
-    if(this->ShowInsideDomain) {
-      std::array<float, 3> coords{};
-      triangulation->getVertexPoint(a, coords[0], coords[1], coords[2]);
-      points->SetPoint(2 * i, coords[0], coords[1], coords[2]);
-      triangulation->getVertexPoint(b, coords[0], coords[1], coords[2]);
-      points->SetPoint(2 * i + 1, coords[0], coords[1], coords[2]);
-    } else {
-      points->SetPoint(2 * i, sa, sa, 0);
-      points->SetPoint(2 * i + 1, sa, sb, 0);
-    }
-    connectivity->SetTuple1(2 * i, 2 * i);
-    connectivity->SetTuple1(2 * i + 1, 2 * i + 1);
-    offsets->SetTuple1(i, 2 * i);
-
-    // point data
-    vertexIdentifierScalars->SetTuple1(2 * i, a);
-    vertexIdentifierScalars->SetTuple1(2 * i + 1, b);
-    nodeTypeScalars->SetTuple1(2 * i, static_cast<ttk::SimplexId>(ta));
-    nodeTypeScalars->SetTuple1(2 * i + 1, static_cast<ttk::SimplexId>(tb));
-
-    if(this->ShowInsideDomain) {
-      birthScalars->SetTuple1(2 * i, sa);
-      birthScalars->SetTuple1(2 * i + 1, sa);
-      deathScalars->SetTuple1(2 * i, sa);
-      deathScalars->SetTuple1(2 * i + 1, sb);
-    } else {
-      std::array<float, 3> coords{};
-      triangulation->getVertexPoint(a, coords[0], coords[1], coords[2]);
-      coordsScalars->SetTuple3(2 * i, coords[0], coords[1], coords[2]);
-      triangulation->getVertexPoint(b, coords[0], coords[1], coords[2]);
-      coordsScalars->SetTuple3(2 * i + 1, coords[0], coords[1], coords[2]);
-    }
-
-    // cell data
-    pairIdentifierScalars->SetTuple1(i, i);
-    persistenceScalars->SetTuple1(i, diagram[i].persistence);
-    if(i == 0) {
-      extremumIndexScalars->SetTuple1(i, -1);
-    } else {
-      const auto type = diagram[i].pairType;
-      if(type == 0) {
-        extremumIndexScalars->SetTuple1(i, minIndex);
-      } else if(type == 1) {
-        extremumIndexScalars->SetTuple1(i, saddleSaddleIndex);
-      } else if(type == 2) {
-        extremumIndexScalars->SetTuple1(i, maxIndex);
-      }
-    }
-  }
-  offsets->SetTuple1(diagram.size(), connectivity->GetNumberOfTuples());
-
-  vtkNew<vtkCellArray> cells{};
-  cells->SetData(offsets, connectivity);
-  persistenceDiagram->SetPoints(points);
-  persistenceDiagram->SetCells(VTK_LINE, cells);
-
-  if(!this->ShowInsideDomain) {
-    // add diagonal (first point -> last birth/penultimate point)
-    std::array<vtkIdType, 2> diag{0, 2 * (cells->GetNumberOfCells() - 1)};
-    persistenceDiagram->InsertNextCell(VTK_LINE, 2, diag.data());
-    pairIdentifierScalars->InsertTuple1(diagram.size(), -1);
-    extremumIndexScalars->InsertTuple1(diagram.size(), -1);
-    // persistence of min-max pair
-    const auto maxPersistence = diagram[0].persistence;
-    persistenceScalars->InsertTuple1(diagram.size(), 2 * maxPersistence);
-  }
-
-  // add data arrays
-  persistenceDiagram->GetPointData()->AddArray(vertexIdentifierScalars);
-  persistenceDiagram->GetPointData()->AddArray(nodeTypeScalars);
-  if(this->ShowInsideDomain) {
-    persistenceDiagram->GetPointData()->AddArray(birthScalars);
-    persistenceDiagram->GetPointData()->AddArray(deathScalars);
-  } else {
-    persistenceDiagram->GetPointData()->AddArray(coordsScalars);
-  }
-  persistenceDiagram->GetCellData()->AddArray(pairIdentifierScalars);
-  persistenceDiagram->GetCellData()->AddArray(extremumIndexScalars);
-  persistenceDiagram->GetCellData()->AddArray(persistenceScalars);
-
-  outputCTPersistenceDiagram->ShallowCopy(persistenceDiagram);
-
-  return 0;
-}
-
 template <typename scalarType, typename triangulationType>
 int ttkPersistenceDiagram::dispatch(
   vtkUnstructuredGrid *outputCTPersistenceDiagram,
@@ -227,8 +52,14 @@ int ttkPersistenceDiagram::dispatch(
     return 0;
   }
 
-  setPersistenceDiagram(outputCTPersistenceDiagram, CTDiagram,
-                        inputScalarsArray, inputScalars, triangulation);
+  if(CTDiagram.empty()) {
+    return 1;
+  }
+
+  ttk::PersistenceDiagramColumns<double> diagram{};
+  this->getDiagramColumns(diagram, CTDiagram, inputScalars, triangulation);
+  DiagramToVTU(outputCTPersistenceDiagram, std::move(diagram),
+               inputScalarsArray, this->ShowInsideDomain, *this);
 
   return 1;
 }
@@ -275,7 +106,7 @@ int ttkPersistenceDiagram::RequestData(vtkInformation *request,
 #endif
 
   int status{};
-  ttkVtkTemplateMacro(
+  ttkVtkGridTemplateMacro(
     inputScalars->GetDataType(), triangulation->getType(),
     status = this->dispatch(
       outputCTPersistenceDiagram, inputScalars,
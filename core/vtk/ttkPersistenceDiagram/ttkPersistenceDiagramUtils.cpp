@@ -0,0 +1,375 @@
+#include <ttkMacros.h>
+#include <ttkPersistenceDiagramUtils.h>
+#include <ttkUtils.h>
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <array>
+#include <type_traits>
+
+namespace {
+
+  // out[k] = component c of the tuple (stride * ids[k] + shift) of array,
+  // for any array type
+  template <typename T>
+  void readValues(T *const out,
+                  vtkDataArray *const array,
+                  const std::vector<ttk::SimplexId> &ids,
+                  const int stride,
+                  const int shift,
+                  const int c = 0) {
+    // critical types are read through an integer
+    using V = typename std::conditional<std::is_enum<T>::value, int, T>::type;
+    const int nc = array->GetNumberOfComponents();
+    const size_t n = ids.size();
+    switch(array->GetDataType()) {
+      vtkTemplateMacro({
+        const auto in = ttkUtils::GetPointer<VTK_TT>(array);
+        if(in != nullptr) {
+          for(size_t k = 0; k < n; ++k) {
+            const auto tuple = static_cast<vtkIdType>(stride) * ids[k] + shift;
+            out[k] = static_cast<T>(static_cast<V>(in[tuple * nc + c]));
+          }
+          return;
+        }
+      });
+    }
+    for(size_t k = 0; k < n; ++k) {
+      const auto tuple = static_cast<vtkIdType>(stride) * ids[k] + shift;
+      out[k] = static_cast<T>(static_cast<V>(array->GetComponent(tuple, c)));
+    }
+  }
+
+  // view of a double cell array if the pairs are its first tuples,
+  // gathered copy otherwise
+  void readCellColumn(ttk::DiagramColumn<double> &column,
+                      vtkDataArray *const array,
+                      const std::vector<ttk::SimplexId> &ids,
+                      const bool contiguous) {
+    const auto values = vtkDoubleArray::FastDownCast(array);
+    if(contiguous && values != nullptr && values->GetNumberOfComponents() == 1
+       && !ids.empty()) {
+      // the array is kept alive as long as the column views it
+      values->Register(nullptr);
+      const std::shared_ptr<void> owner(values, [](void *const a) {
+        static_cast<vtkDoubleArray *>(a)->UnRegister(nullptr);
+      });
+      column.setView(values->GetPointer(0), ids.size(), owner);
+      return;
+    }
+    column.clear();
+    column.resize(ids.size());
+    readValues(column.data(), array, ids, 1, 0);
+  }
+
+  // double cell array using the buffer of a column
+  vtkSmartPointer<vtkDoubleArray> exportCellColumn(
+    ttk::DiagramColumn<double> &column, const char *const name) {
+    auto array = vtkSmartPointer<vtkDoubleArray>::New();
+    array->SetName(name);
+    array->SetNumberOfComponents(1);
+    // non-const data() gives the column its own buffer
+    double *const data = column.data();
+    ttkUtils::SetVoidArray(array, data, column.size(), column.getBuffer());
+    return array;
+  }
+
+} // namespace
+
+int VTUToDiagram(ttk::PersistenceDiagramColumns<double> &diagram,
+                 vtkUnstructuredGrid *vtu,
+                 const ttk::Debug &dbg,
+                 const bool pointCoordinates) {
+
+  const auto pd = vtu->GetPointData();
+  const auto cd = vtu->GetCellData();
+  const auto points = vtu->GetPoints();
+
+  if(pd == nullptr || cd == nullptr || points == nullptr) {
+    dbg.printErr("Missing Diagram PointData, CellData or Points");
+    return -1;
+  }
+
+  const auto vertexIdentifierScalars = pd->GetArray(ttk::VertexScalarFieldName);
+  const auto nodeTypeScalars = pd->GetArray(ttk::PersistenceCriticalTypeName);
+  const auto pairIdentifierScalars
+    = cd->GetArray(ttk::PersistencePairIdentifierName);
+  const auto extremumIndexScalars = cd->GetArray(ttk::PersistencePairTypeName);
+  const auto persistenceScalars = cd->GetArray(ttk::PersistenceName);
+  const auto cellBirthScalars = cd->GetArray(ttk::PersistenceBirthName);
+  const auto cellDeathScalars = cd->GetArray(ttk::PersistenceDeathName);
+  const auto birthScalars = pd->GetArray(ttk::PersistenceBirthName);
+  const auto deathScalars = pd->GetArray(ttk::PersistenceDeathName);
+  const auto critCoordinates = pd->GetArray(ttk::PersistenceCoordinatesName);
+
+  const bool embed = birthScalars != nullptr && deathScalars != nullptr;
+
+  if(vertexIdentifierScalars == nullptr || nodeTypeScalars == nullptr
+     || pairIdentifierScalars == nullptr || extremumIndexScalars == nullptr
+     || persistenceScalars == nullptr) {
+    dbg.printErr("Missing Persistence Diagram data array");
+    return -2;
+  }
+  if(!embed && !pointCoordinates
+     && (critCoordinates == nullptr
+         || critCoordinates->GetNumberOfComponents() != 3)) {
+    dbg.printErr("Malformed Persistence Diagram");
+    return -3;
+  }
+
+  // cells of the pairs (skip the diagonal)
+  const auto nCells = pairIdentifierScalars->GetNumberOfTuples();
+  std::vector<ttk::SimplexId> ids{};
+  ids.reserve(nCells);
+  for(vtkIdType i = 0; i < nCells; ++i) {
+    if(pairIdentifierScalars->GetComponent(i, 0) != -1) {
+      ids.emplace_back(i);
+    }
+  }
+  const size_t nPairs = ids.size();
+
+  if(nPairs < 1) {
+    dbg.printErr("Empty Persistence Diagram");
+    return -4;
+  }
+  if(2 * (ids.back() + 1) > vtu->GetNumberOfPoints()
+     || 2 * (ids.back() + 1) > vertexIdentifierScalars->GetNumberOfTuples()
+     || 2 * (ids.back() + 1) > nodeTypeScalars->GetNumberOfTuples()
+     || ids.back() >= persistenceScalars->GetNumberOfTuples()
+     || ids.back() >= extremumIndexScalars->GetNumberOfTuples()) {
+    dbg.printErr("Persistence Diagram arrays are too short");
+    return -5;
+  }
+
+  // the pairs are the first cells (the diagonal is the last one)
+  const bool contiguous = static_cast<size_t>(ids.back()) == nPairs - 1;
+
+  ttk::PersistenceDiagramColumns<double> res{};
+  res.birthVertex.resize(nPairs);
+  res.birthType.resize(nPairs);
+  res.deathVertex.resize(nPairs);
+  res.deathType.resize(nPairs);
+  res.pairType.resize(nPairs);
+  readValues(res.birthVertex.data(), vertexIdentifierScalars, ids, 2, 0);
+  readValues(res.deathVertex.data(), vertexIdentifierScalars, ids, 2, 1);
+  readValues(res.birthType.data(), nodeTypeScalars, ids, 2, 0);
+  readValues(res.deathType.data(), nodeTypeScalars, ids, 2, 1);
+  readValues(res.pairType.data(), extremumIndexScalars, ids, 1, 0);
+
+  readCellColumn(res.persistence, persistenceScalars, ids, contiguous);
+
+  if(cellBirthScalars != nullptr && cellDeathScalars != nullptr
+     && ids.back() < cellBirthScalars->GetNumberOfTuples()
+     && ids.back() < cellDeathScalars->GetNumberOfTuples()) {
+    readCellColumn(res.birth, cellBirthScalars, ids, contiguous);
+    readCellColumn(res.death, cellDeathScalars, ids, contiguous);
+  } else {
+    // diagrams written without the cell arrays
+    res.birth.resize(nPairs);
+    res.death.resize(nPairs);
+    if(embed) {
+      readValues(res.birth.data(), birthScalars, ids, 2, 0);
+      readValues(res.death.data(), deathScalars, ids, 2, 1);
+    } else {
+      readValues(res.birth.data(), points->GetData(), ids, 2, 0, 0);
+      readValues(res.death.data(), points->GetData(), ids, 2, 1, 1);
+    }
+  }
+
+  // critical point coordinates
+  vtkDataArray *const coords
+    = embed || pointCoordinates ? points->GetData() : critCoordinates;
+  std::array<ttk::DiagramColumn<float> *, 3> birthCoords{
+    &res.birthX, &res.birthY, &res.birthZ};
+  std::array<ttk::DiagramColumn<float> *, 3> deathCoords{
+    &res.deathX, &res.deathY, &res.deathZ};
+  for(int c = 0; c < 3; ++c) {
+    birthCoords[c]->resize(nPairs);
+    deathCoords[c]->resize(nPairs);
+    readValues(birthCoords[c]->data(), coords, ids, 2, 0, c);
+    readValues(deathCoords[c]->data(), coords, ids, 2, 1, c);
+  }
+
+  diagram = std::move(res);
+
+  return 0;
+}
+
+int DiagramToVTU(vtkUnstructuredGrid *vtu,
+                 ttk::PersistenceDiagramColumns<double> diagram,
+                 vtkDataArray *scalars,
+                 const bool embedded,
+                 const ttk::Debug &dbg) {
+
+  const auto nPairs = static_cast<ttk::SimplexId>(diagram.size());
+  if(nPairs == 0) {
+    dbg.printWrn("Empty Persistence Diagram");
+    return 0;
+  }
+
+  vtkNew<vtkUnstructuredGrid> persistenceDiagram{};
+
+  // point data arrays
+
+  vtkNew<ttkSimplexIdTypeArray> vertexIdentifierScalars{};
+  vertexIdentifierScalars->SetNumberOfComponents(1);
+  vertexIdentifierScalars->SetName(ttk::VertexScalarFieldName);
+  vertexIdentifierScalars->SetNumberOfTuples(2 * nPairs);
+
+  vtkNew<vtkIntArray> nodeTypeScalars{};
+  nodeTypeScalars->SetNumberOfComponents(1);
+  nodeTypeScalars->SetName(ttk::PersistenceCriticalTypeName);
+  nodeTypeScalars->SetNumberOfTuples(2 * nPairs);
+
+  vtkNew<vtkFloatArray> coordsScalars{};
+  vtkSmartPointer<vtkDataArray> birthScalars{}, deathScalars{};
+
+  if(embedded) {
+    birthScalars = vtkSmartPointer<vtkDataArray>::Take(
+      scalars != nullptr ? scalars->NewInstance() : vtkDoubleArray::New());
+    deathScalars = vtkSmartPointer<vtkDataArray>::Take(
+      scalars != nullptr ? scalars->NewInstance() : vtkDoubleArray::New());
+
+    birthScalars->SetNumberOfComponents(1);
+    birthScalars->SetName(ttk::PersistenceBirthName);
+    birthScalars->SetNumberOfTuples(2 * nPairs);
+
+    deathScalars->SetNumberOfComponents(1);
+    deathScalars->SetName(ttk::PersistenceDeathName);
+    deathScalars->SetNumberOfTuples(2 * nPairs);
+  } else {
+    coordsScalars->SetNumberOfComponents(3);
+    coordsScalars->SetName(ttk::PersistenceCoordinatesName);
+    coordsScalars->SetNumberOfTuples(2 * nPairs);
+  }
+
+  // cell data arrays (Persistence, Birth and Death are set below)
+
+  vtkNew<ttkSimplexIdTypeArray> pairIdentifierScalars{};
+  pairIdentifierScalars->SetNumberOfComponents(1);
+  pairIdentifierScalars->SetName(ttk::PersistencePairIdentifierName);
+  pairIdentifierScalars->SetNumberOfTuples(nPairs);
+
+  vtkNew<vtkIntArray> extremumIndexScalars{};
+  extremumIndexScalars->SetNumberOfComponents(1);
+  extremumIndexScalars->SetName(ttk::PersistencePairTypeName);
+  extremumIndexScalars->SetNumberOfTuples(nPairs);
+
+  vtkNew<vtkFloatArray> pointsData{};
+  pointsData->SetNumberOfComponents(3);
+  pointsData->SetNumberOfTuples(2 * nPairs);
+  vtkNew<vtkIdTypeArray> offsets{}, connectivity{};
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(nPairs + 1);
+  connectivity->SetNumberOfComponents(1);
+  connectivity->SetNumberOfTuples(2 * nPairs);
+
+  const auto &pairs = diagram;
+  float *const pointsPtr = ttkUtils::GetPointer<float>(pointsData);
+  float *const coordsPtr
+    = embedded ? nullptr : ttkUtils::GetPointer<float>(coordsScalars);
+  auto *const offsetsPtr = ttkUtils::GetPointer<vtkIdType>(offsets);
+  auto *const connectivityPtr = ttkUtils::GetPointer<vtkIdType>(connectivity);
+  auto *const vertexIdsPtr
+    = ttkUtils::GetPointer<ttk::SimplexId>(vertexIdentifierScalars);
+  int *const nodeTypesPtr = ttkUtils::GetPointer<int>(nodeTypeScalars);
+  auto *const pairIdsPtr
+    = ttkUtils::GetPointer<ttk::SimplexId>(pairIdentifierScalars);
+  int *const pairTypesPtr = ttkUtils::GetPointer<int>(extremumIndexScalars);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(dbg.getThreadNumber())
+#endif // TTK_ENABLE_OPENMP
+  for(ttk::SimplexId i = 0; i < nPairs; ++i) {
+    const std::array<float, 3> birthCoords{
+      pairs.birthX[i], pairs.birthY[i], pairs.birthZ[i]};
+    const std::array<float, 3> deathCoords{
+      pairs.deathX[i], pairs.deathY[i], pairs.deathZ[i]};
+    const auto sa = pairs.birth[i];
+    const auto sb = pairs.death[i];
+
+    if(embedded) {
+      std::copy(birthCoords.begin(), birthCoords.end(), &pointsPtr[6 * i]);
+      std::copy(deathCoords.begin(), deathCoords.end(), &pointsPtr[6 * i + 3]);
+      birthScalars->SetTuple1(2 * i, sa);
+      birthScalars->SetTuple1(2 * i + 1, sa);
+      deathScalars->SetTuple1(2 * i, sa);
+      deathScalars->SetTuple1(2 * i + 1, sb);
+    } else {
+      const std::array<float, 6> planeCoords{
+        static_cast<float>(sa), static_cast<float>(sa), 0.0f,
+        static_cast<float>(sa), static_cast<float>(sb), 0.0f};
+      std::copy(planeCoords.begin(), planeCoords.end(), &pointsPtr[6 * i]);
+      std::copy(birthCoords.begin(), birthCoords.end(), &coordsPtr[6 * i]);
+      std::copy(deathCoords.begin(), deathCoords.end(), &coordsPtr[6 * i + 3]);
+    }
+    connectivityPtr[2 * i] = 2 * i;
+    connectivityPtr[2 * i + 1] = 2 * i + 1;
+    offsetsPtr[i] = 2 * i;
+
+    // point data
+    vertexIdsPtr[2 * i] = pairs.birthVertex[i];
+    vertexIdsPtr[2 * i + 1] = pairs.deathVertex[i];
+    nodeTypesPtr[2 * i] = static_cast<int>(pairs.birthType[i]);
+    nodeTypesPtr[2 * i + 1] = static_cast<int>(pairs.deathType[i]);
+
+    // cell data
+    pairIdsPtr[i] = i;
+    pairTypesPtr[i] = pairs.pairType[i];
+  }
+  offsetsPtr[nPairs] = 2 * nPairs;
+
+  vtkNew<vtkPoints> points{};
+  points->SetData(pointsData);
+  vtkNew<vtkCellArray> cells{};
+  cells->SetData(offsets, connectivity);
+  persistenceDiagram->SetPoints(points);
+  persistenceDiagram->SetCells(VTK_LINE, cells);
+
+  if(!embedded) {
+    // add diagonal (first point -> last birth/penultimate point)
+    std::array<vtkIdType, 2> diag{0, 2 * (nPairs - 1)};
+    persistenceDiagram->InsertNextCell(VTK_LINE, 2, diag.data());
+    pairIdentifierScalars->InsertTuple1(nPairs, -1);
+    extremumIndexScalars->InsertTuple1(nPairs, -1);
+    // persistence of min-max pair
+    const auto maxPersistence = pairs.persistence[0];
+    const auto firstBirth = pairs.birth[0];
+    const auto lastBirth = pairs.birth[nPairs - 1];
+    diagram.persistence.push_back(2 * maxPersistence);
+    diagram.birth.push_back(firstBirth);
+    diagram.death.push_back(lastBirth);
+  }
+
+  // add data arrays
+  persistenceDiagram->GetPointData()->AddArray(vertexIdentifierScalars);
+  persistenceDiagram->GetPointData()->AddArray(nodeTypeScalars);
+  if(embedded) {
+    persistenceDiagram->GetPointData()->AddArray(birthScalars);
+    persistenceDiagram->GetPointData()->AddArray(deathScalars);
+  } else {
+    persistenceDiagram->GetPointData()->AddArray(coordsScalars);
+  }
+  persistenceDiagram->GetCellData()->AddArray(pairIdentifierScalars);
+  persistenceDiagram->GetCellData()->AddArray(extremumIndexScalars);
+  persistenceDiagram->GetCellData()->AddArray(
+    exportCellColumn(diagram.persistence, ttk::PersistenceName));
+  persistenceDiagram->GetCellData()->AddArray(
+    exportCellColumn(diagram.birth, ttk::PersistenceBirthName));
+  persistenceDiagram->GetCellData()->AddArray(
+    exportCellColumn(diagram.death, ttk::PersistenceDeathName));
+
+  vtu->ShallowCopy(persistenceDiagram);
+
+  return 0;
+}
@@ -0,0 +1,72 @@
+/// \ingroup vtk
+/// \file ttkPersistenceDiagramUtils.h
+/// \date October 2021.
+///
+/// \brief Conversions between the VTK persistence diagrams and
+/// ttk::PersistenceDiagramColumns.
+///
+/// A VTK persistence diagram holds one line cell per pair, cell i joining
+/// the points 2i (birth) and 2i + 1 (death), and possibly a diagonal cell
+/// (PairIdentifier -1). Besides the PairIdentifier, PairType and
+/// Persistence cell arrays, DiagramToVTU() writes the birth and death
+/// values of the pairs as Birth and Death cell arrays: the Persistence,
+/// Birth and Death arrays share the buffers of the columns, and
+/// VTUToDiagram() reads them back as views, without copy.
+///
+/// \sa ttk::PersistenceDiagramColumns
+/// \sa ttkPersistenceDiagram
+
+#pragma once
+
+#include <ttkPersistenceDiagramModule.h>
+
+#include <PersistenceDiagramColumns.h>
+
+class vtkDataArray;
+class vtkUnstructuredGrid;
+
+namespace ttk {
+  class Debug;
+}
+
+/**
+ * @brief Read a VTK persistence diagram
+ *
+ * The pairs are the cells whose PairIdentifier is not -1, in the cell
+ * order. The input is not modified: when these cells come first, the
+ * persistence, birth and death columns are views of the cell arrays,
+ * kept alive by the columns.
+ *
+ * The critical point coordinates are read from the Coordinates point array
+ * of the diagrams that are not embedded in the domain, unless
+ * @p pointCoordinates is set (point positions).
+ *
+ * @return 0 on success, a negative value on malformed diagrams
+ */
+TTKPERSISTENCEDIAGRAM_EXPORT int
+  VTUToDiagram(ttk::PersistenceDiagramColumns<double> &diagram,
+               vtkUnstructuredGrid *vtu,
+               const ttk::Debug &dbg,
+               bool pointCoordinates = false);
+
+/**
+ * @brief Write a persistence diagram as a VTK unstructured grid
+ *
+ * If @p embedded, the pairs are drawn between their critical points, with
+ * Birth and Death point arrays of the same type as @p scalars (double if
+ * null). Otherwise they are drawn in the birth-death plane, the critical
+ * points coordinates being stored in a Coordinates point array, and a
+ * diagonal cell is appended.
+ *
+ * The Persistence, Birth and Death cell arrays use the buffers of the
+ * columns (the diagonal is appended in place if they have the capacity):
+ * move the columns in to avoid any copy.
+ *
+ * @return 0 on success
+ */
+TTKPERSISTENCEDIAGRAM_EXPORT int
+  DiagramToVTU(vtkUnstructuredGrid *vtu,
+               ttk::PersistenceDiagramColumns<double> diagram,
+               vtkDataArray *scalars,
+               bool embedded,
+               const ttk::Debug &dbg);
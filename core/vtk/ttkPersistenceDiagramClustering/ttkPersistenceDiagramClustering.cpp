@@ -1,5 +1,6 @@
 #include <ttkMacros.h>
 #include <ttkPersistenceDiagramClustering.h>
+#include <ttkPersistenceDiagramUtils.h>
 #include <ttkUtils.h>
 #include <vtkCellData.h>
 #include <vtkDataArray.h>
@@ -93,8 +94,25 @@ int ttkPersistenceDiagramClustering::RequestData(
     std::vector<double> max_persistences(numInputs);
 
     for(int i = 0; i < numInputs; i++) {
-      this->VTUToDiagram(this->intermediateDiagrams_[i], input[i]);
-      max_persistences[i] = std::get<4>(intermediateDiagrams_[i][0]);
+      auto &diagram = this->intermediateDiagrams_[i];
+      if(VTUToDiagram(diagram, input[i], *this) != 0) {
+        this->printErr("Could not read Persistence Diagram "
+                       + std::to_string(i));
+        return 0;
+      }
+      // the global min-max pair comes first
+      diagram.birthType[0] = CriticalType::Local_minimum;
+      diagram.deathType[0] = CriticalType::Local_maximum;
+      if(this->NumberOfClusters != 1) {
+        // duplicate the global min-max pair into two: one min-saddle pair and
+        // one saddle-max pair, stored at the diagram end
+        const size_t n = diagram.size();
+        diagram.resize(n + 1);
+        diagram.setPair(n, diagram, 0);
+        diagram.deathType[0] = CriticalType::Saddle1;
+        diagram.birthType[n] = CriticalType::Saddle1;
+      }
+      max_persistences[i] = diagram.persistence[0];
     }
 
     this->max_dimension_total_
@@ -200,147 +218,6 @@ int ttkPersistenceDiagramClustering::RequestData(
   return 1;
 }
 
-void ttkPersistenceDiagramClustering::VTUToDiagram(
-  diagramType &diagram, vtkUnstructuredGrid *vtu) const {
-
-  const auto pd = vtu->GetPointData();
-  const auto cd = vtu->GetCellData();
-
-  if(pd == nullptr) {
-    this->printErr("VTU diagram with NULL Point Data");
-    return;
-  }
-  if(cd == nullptr) {
-    this->printErr("VTU diagram with NULL Cell Data");
-    return;
-  }
-
-  // cell data
-  const auto pairId = vtkIntArray::SafeDownCast(cd->GetArray("PairIdentifier"));
-  const auto pairType = vtkIntArray::SafeDownCast(cd->GetArray("PairType"));
-  const auto pairPers
-    = vtkDoubleArray::SafeDownCast(cd->GetArray("Persistence"));
-
-  // point data
-  const auto vertexId
-    = vtkIntArray::SafeDownCast(pd->GetArray(ttk::VertexScalarFieldName));
-  const auto critType = vtkIntArray::SafeDownCast(pd->GetArray("CriticalType"));
-  const auto birthScalars = vtkDoubleArray::SafeDownCast(pd->GetArray("Birth"));
-  const auto deathScalars = vtkDoubleArray::SafeDownCast(pd->GetArray("Death"));
-  const auto coords = vtkFloatArray::SafeDownCast(pd->GetArray("Coordinates"));
-
-  const auto points = vtu->GetPoints();
-
-  const bool embed = birthScalars != nullptr && deathScalars != nullptr;
-
-  if(!embed && coords == nullptr) {
-    this->printErr("Missing coordinates array on non-embedded diagram");
-    return;
-  }
-
-  int nPairs = pairId->GetNumberOfTuples();
-
-  // compact pairIds in [0, nPairs - 1] (diagonal excepted)
-  for(int i = 0; i < nPairs; i++) {
-    if(pairId->GetTuple1(i) != -1) {
-      pairId->SetTuple1(i, i);
-    }
-  }
-
-  // skip diagram diagonal if present (assuming it's the last pair in the
-  // diagram)
-  if(pairId->GetTuple1(nPairs - 1) == -1)
-    nPairs -= 1;
-
-  if(nPairs < 1 || vertexId == nullptr || pairId == nullptr
-     || critType == nullptr || pairPers == nullptr || pairType == nullptr
-     || points == nullptr) {
-    this->printErr("Either no pairs in diagram or some array is NULL");
-    return;
-  }
-
-  if(NumberOfClusters == 1) {
-    diagram.resize(nPairs);
-  } else {
-    diagram.resize(nPairs + 1);
-  }
-
-  // count the number of pairs whose index is >= nPairs
-  int nbNonCompact = 0;
-
-  // skip diagonal cell (corresponding points already dealt with)
-  for(int i = 0; i < nPairs; ++i) {
-
-    const int v0 = vertexId->GetValue(2 * i);
-    const int v1 = vertexId->GetValue(2 * i + 1);
-    const int ct0 = critType->GetValue(2 * i);
-    const int ct1 = critType->GetValue(2 * i + 1);
-
-    const int pId = pairId->GetValue(i);
-    const int pType = pairType->GetValue(i);
-    const double pers = pairPers->GetValue(i);
-
-    std::array<double, 3> coordsBirth{}, coordsDeath{};
-    double birth, death;
-
-    if(embed) {
-      points->GetPoint(2 * i + 0, coordsBirth.data());
-      points->GetPoint(2 * i + 1, coordsDeath.data());
-      birth = birthScalars->GetValue(2 * i + 0);
-      death = deathScalars->GetValue(2 * i + 1);
-    } else {
-      coords->GetTuple(2 * i + 0, coordsBirth.data());
-      coords->GetTuple(2 * i + 1, coordsDeath.data());
-      birth = points->GetPoint(2 * i + 0)[0];
-      death = points->GetPoint(2 * i + 1)[1];
-    }
-
-    if(pId != -1 && pId < nPairs) {
-
-      if(pId == 0) {
-        // deal with the global min-max pair separately
-        // (what do we do with other infinite pairs?)
-
-        if(NumberOfClusters == 1) {
-          diagram[0] = std::make_tuple(
-            v0, CriticalType::Local_minimum, v1, CriticalType::Local_maximum,
-            pers, pType, birth, coordsBirth[0], coordsBirth[1], coordsBirth[2],
-            death, coordsDeath[0], coordsDeath[1], coordsDeath[2]);
-        } else {
-          // duplicate the global min-max pair into two: one min-saddle pair and
-          // one saddle-max pair
-          diagram[0] = std::make_tuple(
-            v0, CriticalType::Local_minimum, v1, CriticalType::Saddle1, pers,
-            pType, birth, coordsBirth[0], coordsBirth[1], coordsBirth[2], death,
-            coordsDeath[0], coordsDeath[1], coordsDeath[2]);
-          // store the saddle max pair at the vector end
-          diagram[nPairs] = std::make_tuple(
-            v0, CriticalType::Saddle1, v1, CriticalType::Local_maximum, pers,
-            pType, birth, coordsBirth[0], coordsBirth[1], coordsBirth[2], death,
-            coordsDeath[0], coordsDeath[1], coordsDeath[2]);
-        }
-
-      } else {
-        // all other pairs
-        diagram[pId] = std::make_tuple(
-          v0, static_cast<CriticalType>(ct0), v1,
-          static_cast<CriticalType>(ct1), pers, pType, birth, coordsBirth[0],
-          coordsBirth[1], coordsBirth[2], death, coordsDeath[0], coordsDeath[1],
-          coordsDeath[2]);
-      }
-    }
-
-    if(pId >= nPairs) {
-      nbNonCompact++;
-    }
-  }
-
-  if(nbNonCompact > 0) {
-    this->printWrn("Missed " + std::to_string(nbNonCompact)
-                   + " pairs due to non-compactness.");
-  }
-}
-
 void ttkPersistenceDiagramClustering::diagramToVTU(
   vtkUnstructuredGrid *output,
   const diagramType &diagram,
@@ -579,7 +456,7 @@ void ttkPersistenceDiagramClustering::outputCentroids(
 void ttkPersistenceDiagramClustering::outputMatchings(
   vtkMultiBlockDataSet *output,
   const size_t nClusters,
-  const std::vector<diagramType> &diags,
+  const std::vector<ttk::PersistenceDiagramColumns<double>> &diags,
   const std::vector<std::vector<std::vector<matchingType>>>
     &matchingsPerCluster,
   const std::vector<diagramType> &centroids,
@@ -674,9 +551,9 @@ void ttkPersistenceDiagramClustering::outputMatchings(
       }
 
       const auto &p0{centroids[cid][goodId]};
-      const auto &p1{diag[bidderId]};
       std::array<double, 3> coords0{std::get<6>(p0), std::get<10>(p0), 0};
-      std::array<double, 3> coords1{std::get<6>(p1), std::get<10>(p1), 0};
+      std::array<double, 3> coords1{
+        diag.birth[bidderId], diag.death[bidderId], 0};
 
       if(dm == DISPLAY::STARS && spacing > 0) {
         const auto angle = 2.0 * M_PI * static_cast<double>(diagIdInClust[i])
@@ -705,7 +582,7 @@ void ttkPersistenceDiagramClustering::outputMatchings(
       diagIdVerts->SetTuple1(2 * j + 1, i);
       pointId->SetTuple1(2 * j + 0, goodId);
       pointId->SetTuple1(2 * j + 1, bidderId);
-      pairType->SetTuple1(j, std::get<5>(p1));
+      pairType->SetTuple1(j, diag.pairType[bidderId]);
     }
 
     output->SetBlock(i, matchingsGrid);
@@ -163,18 +163,18 @@ protected:
                        const DISPLAY dm,
                        const double spacing,
                        const double max_persistence) const;
-  void outputMatchings(vtkMultiBlockDataSet *output,
-                       const size_t nClusters,
-                       const std::vector<diagramType> &diags,
-                       const std::vector<std::vector<std::vector<matchingType>>>
-                         &matchingsPerCluster,
-                       const std::vector<diagramType> &centroids,
-                       const std::vector<int> &inv_clustering,
-                       const ttkPersistenceDiagramClustering::DISPLAY dm,
-                       const double spacing,
-                       const double max_persistence) const;
+  void outputMatchings(
+    vtkMultiBlockDataSet *output,
+    const size_t nClusters,
+    const std::vector<ttk::PersistenceDiagramColumns<double>> &diags,
+    const std::vector<std::vector<std::vector<matchingType>>>
+      &matchingsPerCluster,
+    const std::vector<diagramType> &centroids,
+    const std::vector<int> &inv_clustering,
+    const ttkPersistenceDiagramClustering::DISPLAY dm,
+    const double spacing,
+    const double max_persistence) const;
 
-  void VTUToDiagram(diagramType &diagram, vtkUnstructuredGrid *vtu) const;
   void diagramToVTU(vtkUnstructuredGrid *output,
                     const diagramType &diagram,
                     const int cid,
@@ -185,7 +185,7 @@ protected:
                   vtkInformationVector *outputVector) override;
 
 private:
-  std::vector<diagramType> intermediateDiagrams_{};
+  std::vector<ttk::PersistenceDiagramColumns<double>> intermediateDiagrams_{};
   std::vector<std::vector<std::vector<matchingType>>> all_matchings_{};
   std::vector<diagramType> final_centroids_{};
   std::vector<int> inv_clustering_{};
@@ -1,18 +1,13 @@
 #include <ttkPersistenceDiagramDistanceMatrix.h>
+#include <ttkPersistenceDiagramUtils.h>
 
-#include <vtkCellData.h>
-#include <vtkCharArray.h>
-#include <vtkDataArray.h>
-#include <vtkDataSet.h>
 #include <vtkDoubleArray.h>
-#include <vtkFiltersCoreModule.h>
-#include <vtkFloatArray.h>
-#include <vtkIntArray.h>
+#include <vtkFieldData.h>
 #include <vtkMultiBlockDataSet.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
-#include <vtkPointData.h>
 #include <vtkTable.h>
+#include <vtkUnstructuredGrid.h>
 
 vtkStandardNewMacro(ttkPersistenceDiagramDistanceMatrix);
 
@@ -86,7 +81,7 @@ int ttkPersistenceDiagramDistanceMatrix::RequestData(
   // Set output
   auto diagramsDistTable = vtkTable::GetData(outputVector);
 
-  std::vector<ttk::Diagram> intermediateDiagrams(nDiags);
+  std::vector<ttk::DiagramColumns> intermediateDiagrams(nDiags);
 
   double max_dimension_total = 0.0;
   for(int i = 0; i < nDiags; i++) {
@@ -101,7 +96,29 @@ int ttkPersistenceDiagramDistanceMatrix::RequestData(
     }
   }
 
-  const auto diagramsDistMat = this->execute(intermediateDiagrams, nInputs);
+  // reuse the last distance matrix if the previous diagrams are a prefix of
+  // the current ones
+  bool reusePrevious = this->IncrementalUpdate && nInputs[1] == 0
+                       && this->previousMTime_ == this->GetMTime()
+                       && !this->previousDiagrams_.empty()
+                       && this->previousDiagrams_.size() <= nInputs[0];
+  for(size_t i = 0; reusePrevious && i < this->previousDiagrams_.size(); ++i) {
+    reusePrevious = this->previousDiagrams_[i] == intermediateDiagrams[i];
+  }
+
+  const std::vector<std::vector<double>> noPreviousDistMat{};
+  const auto diagramsDistMat = this->execute(
+    intermediateDiagrams, nInputs,
+    reusePrevious ? this->previousDistMat_ : noPreviousDistMat);
+
+  if(this->IncrementalUpdate && nInputs[1] == 0) {
+    this->previousDiagrams_ = intermediateDiagrams;
+    this->previousDistMat_ = diagramsDistMat;
+    this->previousMTime_ = this->GetMTime();
+  } else {
+    this->previousDiagrams_.clear();
+    this->previousDistMat_.clear();
+  }
 
   // zero-padd column name to keep Row Data columns ordered
   const auto zeroPad
@@ -145,129 +162,22 @@ int ttkPersistenceDiagramDistanceMatrix::RequestData(
 }
 
 double ttkPersistenceDiagramDistanceMatrix::getPersistenceDiagram(
-  ttk::Diagram &diagram, vtkUnstructuredGrid *CTPersistenceDiagram_) {
-
-  const auto pd = CTPersistenceDiagram_->GetPointData();
-  const auto cd = CTPersistenceDiagram_->GetCellData();
-  const auto points = CTPersistenceDiagram_->GetPoints();
-
-  if(pd == nullptr || cd == nullptr || points == nullptr) {
-    this->printErr("Missing Diagram PointData, CellData or Points");
-    return -1.0;
-  }
-
-  const auto vertexIdentifierScalars
-    = vtkIntArray::SafeDownCast(pd->GetArray(ttk::VertexScalarFieldName));
-  const auto nodeTypeScalars
-    = vtkIntArray::SafeDownCast(pd->GetArray("CriticalType"));
-  const auto pairIdentifierScalars
-    = vtkIntArray::SafeDownCast(cd->GetArray("PairIdentifier"));
-  const auto extremumIndexScalars
-    = vtkIntArray::SafeDownCast(cd->GetArray("PairType"));
-  const auto persistenceScalars
-    = vtkDoubleArray::SafeDownCast(cd->GetArray("Persistence"));
-  const auto birthScalars = vtkDoubleArray::SafeDownCast(pd->GetArray("Birth"));
-  const auto deathScalars = vtkDoubleArray::SafeDownCast(pd->GetArray("Death"));
-  const auto critCoordinates
-    = vtkFloatArray::SafeDownCast(pd->GetArray("Coordinates"));
-
-  const bool embed = birthScalars != nullptr && deathScalars != nullptr;
-
-  if(!embed && critCoordinates == nullptr) {
-    this->printErr("Malformed Persistence Diagram");
-    return -2.0;
-  }
-
-  int pairingsSize = (int)pairIdentifierScalars->GetNumberOfTuples();
-  // FIX : no more missed pairs
-  for(int pair_index = 0; pair_index < pairingsSize; pair_index++) {
-    const float index_of_pair = pair_index;
-    if(*pairIdentifierScalars->GetTuple(pair_index) != -1)
-      pairIdentifierScalars->SetTuple(pair_index, &index_of_pair);
-  }
-
-  // If diagram has the diagonal (we assume it is last)
-  if(*pairIdentifierScalars->GetTuple(pairingsSize - 1) == -1)
-    pairingsSize -= 1;
-
-  if(pairingsSize < 1 || !vertexIdentifierScalars || !pairIdentifierScalars
-     || !nodeTypeScalars || !persistenceScalars || !extremumIndexScalars
-     || !points) {
-    this->printErr("Missing Persistence Diagram data array");
-    return -3.0;
-  }
-
-  diagram.resize(pairingsSize + 1);
-  int nbNonCompact = 0;
-  double max_dimension = 0;
-
-  // skip diagonal cell (corresponding points already dealt with)
-  for(int i = 0; i < pairingsSize; ++i) {
-
-    int vertexId1 = vertexIdentifierScalars->GetValue(2 * i);
-    int vertexId2 = vertexIdentifierScalars->GetValue(2 * i + 1);
-    int nodeType1 = nodeTypeScalars->GetValue(2 * i);
-    int nodeType2 = nodeTypeScalars->GetValue(2 * i + 1);
-
-    int pairIdentifier = pairIdentifierScalars->GetValue(i);
-    int pairType = extremumIndexScalars->GetValue(i);
-    double persistence = persistenceScalars->GetValue(i);
-
-    std::array<double, 3> coordsBirth{}, coordsDeath{};
-
-    const auto i0 = 2 * i;
-    const auto i1 = 2 * i + 1;
-
-    double birth, death;
-
-    if(embed) {
-      points->GetPoint(i0, coordsBirth.data());
-      points->GetPoint(i1, coordsDeath.data());
-      birth = birthScalars->GetValue(i0);
-      death = deathScalars->GetValue(i1);
-    } else {
-      critCoordinates->GetTuple(i0, coordsBirth.data());
-      critCoordinates->GetTuple(i1, coordsDeath.data());
-      birth = points->GetPoint(i0)[0];
-      death = points->GetPoint(i1)[1];
-    }
-
-    if(pairIdentifier != -1 && pairIdentifier < pairingsSize) {
-      if(pairIdentifier == 0) {
-        max_dimension = persistence;
-
-        diagram[0] = std::make_tuple(
-          vertexId1, ttk::CriticalType::Local_minimum, vertexId2,
-          ttk::CriticalType::Saddle1, persistence, pairType, birth,
-          coordsBirth[0], coordsBirth[1], coordsBirth[2], death, coordsDeath[0],
-          coordsDeath[1], coordsDeath[2]);
-        diagram[pairingsSize] = std::make_tuple(
-          vertexId1, ttk::CriticalType::Saddle1, vertexId2,
-          ttk::CriticalType::Local_maximum, persistence, pairType, birth,
-          coordsBirth[0], coordsBirth[1], coordsBirth[2], death, coordsDeath[0],
-          coordsDeath[1], coordsDeath[2]);
-
-      } else {
-        diagram[pairIdentifier] = std::make_tuple(
-          vertexId1, (BNodeType)nodeType1, vertexId2, (BNodeType)nodeType2,
-          persistence, pairType, birth, coordsBirth[0], coordsBirth[1],
-          coordsBirth[2], death, coordsDeath[0], coordsDeath[1],
-          coordsDeath[2]);
-      }
-    }
-    if(pairIdentifier >= pairingsSize) {
-      nbNonCompact++;
-      if(nbNonCompact == 0) {
-        this->printWrn("Diagram pair identifiers must be compact (not exceed "
-                       "the diagram size).");
-      }
-    }
-  }
+  ttk::DiagramColumns &diagram, vtkUnstructuredGrid *CTPersistenceDiagram_) {
 
-  if(nbNonCompact > 0) {
-    this->printWrn("Missed " + std::to_string(nbNonCompact)
-                   + " pairs due to non-compactness.");
+  const int ret = VTUToDiagram(diagram, CTPersistenceDiagram_, *this);
+  if(ret != 0) {
+    return ret;
   }
 
-  return max_dimension;
+  // the global min-max pair (the first one) is compared as a min-saddle
+  // pair and as a saddle-max pair
+  const size_t n = diagram.size();
+  diagram.resize(n + 1);
+  diagram.setPair(n, diagram, 0);
+  diagram.birthType[0] = ttk::CriticalType::Local_minimum;
+  diagram.deathType[0] = ttk::CriticalType::Saddle1;
+  diagram.birthType[n] = ttk::CriticalType::Saddle1;
+  diagram.deathType[n] = ttk::CriticalType::Local_maximum;
+
+  return diagram.persistence[0];
 }
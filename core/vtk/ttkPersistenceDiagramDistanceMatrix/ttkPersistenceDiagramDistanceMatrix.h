@@ -13,6 +13,11 @@
 /// Proc. of IEEE VIS 2019.\n
 /// IEEE Transactions on Visualization and Computer Graphics, 2019.
 ///
+/// With IncrementalUpdate enabled, the last square distance matrix is kept
+/// and, if the new input diagrams start with the previous ones (e.g. a new
+/// time step appended to a time series), only the rows of the appended
+/// diagrams are computed.
+///
 /// \sa PersistenceDiagramDistanceMatrix
 
 #pragma once
@@ -122,11 +127,17 @@ public:
   vtkSetMacro(MinPersistence, double);
   vtkGetMacro(MinPersistence, double);
 
+  vtkSetMacro(NumberOfNearestNeighbors, int);
+  vtkGetMacro(NumberOfNearestNeighbors, int);
+
+  vtkSetMacro(IncrementalUpdate, bool);
+  vtkGetMacro(IncrementalUpdate, bool);
+
 protected:
   ttkPersistenceDiagramDistanceMatrix();
   ~ttkPersistenceDiagramDistanceMatrix() override = default;
 
-  double getPersistenceDiagram(ttk::Diagram &diagram,
+  double getPersistenceDiagram(ttk::DiagramColumns &diagram,
                                vtkUnstructuredGrid *CTPersistenceDiagram_);
 
   int FillInputPortInformation(int port, vtkInformation *info) override;
@@ -135,4 +146,13 @@ protected:
   int RequestData(vtkInformation *request,
                   vtkInformationVector **inputVector,
                   vtkInformationVector *outputVector) override;
+
+private:
+  bool IncrementalUpdate{false};
+
+  // diagrams and distance matrix of the last execution, with the filter
+  // modification time at that point (parameters changes invalidate them)
+  std::vector<ttk::DiagramColumns> previousDiagrams_{};
+  std::vector<std::vector<double>> previousDistMat_{};
+  vtkMTimeType previousMTime_{};
 };
@@ -8,10 +8,11 @@
 #include <vtkPointData.h>
 #include <vtkUnstructuredGrid.h>
 
-#include <Geometry.h>
 #include <Triangulation.h>
 #include <ttkPointMerger.h>
+#include <ttkUtils.h>
 
+#include <algorithm>
 #include <array>
 
 vtkStandardNewMacro(ttkPointMerger);
@@ -73,88 +74,22 @@ int ttkPointMerger::RequestData(vtkInformation *request,
       candidateVertices[i] = i;
   }
 
-  std::vector<std::vector<SimplexId>> closePoints(vertexNumber);
-
-  this->printMsg("Computing pointwise distances with "
-                 + std::to_string(candidateVertices.size()) + " candidates");
-
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif
-  for(SimplexId i = 0; i < (SimplexId)candidateVertices.size(); i++) {
-    double distance = -1;
-    std::array<double, 3> p0{};
-
-    SimplexId vertexId0 = candidateVertices[i];
-
-    input->GetPoint(vertexId0, p0.data());
-    for(SimplexId j = 0; j < (SimplexId)candidateVertices.size(); j++) {
-      if(i != j) {
-        std::array<double, 3> p1{};
-        SimplexId vertexId1 = candidateVertices[j];
-        input->GetPoint(vertexId1, p1.data());
-        distance = ttk::Geometry::distance(p0.data(), p1.data());
-        if(distance < DistanceThreshold) {
-          closePoints[vertexId0].push_back(vertexId1);
-        }
-      }
-    }
-  }
-
-  this->printMsg("Merging points...");
-
-  std::vector<double> minMergeDistance(vertexNumber, -1);
-  std::vector<double> maxMergeDistance(vertexNumber, -1);
-  std::vector<SimplexId> mergeCount(vertexNumber, 0);
-  std::vector<SimplexId> mergeMap(vertexNumber, -1);
-
-  for(SimplexId i = 0; i < vertexNumber; i++) {
-    if(closePoints[i].size()) {
-
-      SimplexId targetVertexId = i;
-      do {
-        SimplexId nextTargetVertexId = targetVertexId;
-        for(SimplexId j = 0; j < (SimplexId)closePoints[targetVertexId].size();
-            j++) {
-          if(closePoints[targetVertexId][j] < nextTargetVertexId)
-            nextTargetVertexId = closePoints[targetVertexId][j];
-        }
-        targetVertexId = nextTargetVertexId;
-        mergeMap[i] = targetVertexId;
-      } while(mergeMap[targetVertexId] != targetVertexId);
-      mergeCount[targetVertexId]++;
-
-      if(i != targetVertexId) {
-        std::array<double, 3> p0{}, p1{};
-        input->GetPoint(i, p0.data());
-        input->GetPoint(targetVertexId, p1.data());
-        double distance = ttk::Geometry::distance(p0.data(), p1.data());
-        if((minMergeDistance[targetVertexId] == -1)
-           || (distance < minMergeDistance[targetVertexId])) {
-          minMergeDistance[targetVertexId] = distance;
-        }
-        if((maxMergeDistance[targetVertexId] == -1)
-           || (distance > maxMergeDistance[targetVertexId])) {
-          maxMergeDistance[targetVertexId] = distance;
-        }
-      }
-    } else {
-      mergeMap[i] = i;
-    }
+  std::vector<SimplexId> old2new{}, new2old{}, mergeCount{};
+  std::vector<double> minMergeDistance{}, maxMergeDistance{};
+
+  auto points = input->GetPoints();
+  int status{-1};
+  switch(points->GetDataType()) {
+    vtkTemplateMacro(status = this->mergePoints(
+                       static_cast<VTK_TT *>(ttkUtils::GetVoidPointer(points)),
+                       vertexNumber, candidateVertices, DistanceThreshold,
+                       old2new, new2old, mergeCount, minMergeDistance,
+                       maxMergeDistance));
   }
-
-  SimplexId vertexIdGen = 0;
-  std::vector<SimplexId> old2new(vertexNumber, 0);
-  std::vector<SimplexId> new2old;
-  for(SimplexId i = 0; i < vertexNumber; i++) {
-    if(mergeMap[i] == i) {
-      old2new[i] = vertexIdGen;
-      vertexIdGen++;
-      new2old.push_back(i);
-    } else {
-      old2new[i] = old2new[mergeMap[i]];
-    }
+  if(status != 0) {
+    return 0;
   }
+  const SimplexId vertexIdGen = new2old.size();
 
   // now create the output
   vtkNew<vtkPoints> pointSet{};
@@ -189,9 +124,9 @@ int ttkPointMerger::RequestData(vtkInformation *request,
     input->GetPoint(new2old[i], p.data());
     pointSet->SetPoint(i, p.data());
 
-    mergeCountArray->SetTuple1(i, mergeCount[new2old[i]]);
-    minDistanceArray->SetTuple1(i, minMergeDistance[new2old[i]]);
-    maxDistanceArray->SetTuple1(i, maxMergeDistance[new2old[i]]);
+    mergeCountArray->SetTuple1(i, mergeCount[i]);
+    minDistanceArray->SetTuple1(i, minMergeDistance[i]);
+    maxDistanceArray->SetTuple1(i, maxMergeDistance[i]);
 
     for(size_t j = 0; j < pointData.size(); j++) {
       std::vector<double> data(pointData[j]->GetNumberOfComponents());
@@ -218,26 +153,23 @@ int ttkPointMerger::RequestData(vtkInformation *request,
       input->GetCellData()->GetArray(i)->GetNumberOfComponents());
   }
 
+  vtkNew<vtkGenericCell> c{};
+  vtkNew<vtkIdList> idList{};
+  std::vector<SimplexId> newVertexIds;
+  std::vector<double> data;
+
   for(SimplexId i = 0; i < input->GetNumberOfCells(); i++) {
-    vtkNew<vtkGenericCell> c{};
     input->GetCell(i, c);
 
-    std::vector<SimplexId> newVertexIds;
+    newVertexIds.clear();
     for(int j = 0; j < c->GetNumberOfPoints(); j++) {
       SimplexId vertexId = old2new[c->GetPointId(j)];
-      bool isIn = false;
-      for(SimplexId k = 0; k < (SimplexId)newVertexIds.size(); k++) {
-        if(newVertexIds[k] == vertexId) {
-          isIn = true;
-          break;
-        }
-      }
-      if(!isIn) {
+      if(std::find(newVertexIds.begin(), newVertexIds.end(), vertexId)
+         == newVertexIds.end()) {
         newVertexIds.push_back(vertexId);
       }
     }
 
-    vtkNew<vtkIdList> idList{};
     idList->SetNumberOfIds(newVertexIds.size());
     for(size_t j = 0; j < newVertexIds.size(); j++) {
       idList->SetId(j, newVertexIds[j]);
@@ -256,8 +188,7 @@ int ttkPointMerger::RequestData(vtkInformation *request,
     if(c->GetCellDimension() == 3) {
       if(newVertexIds.size() == 4) {
         cellId = output->InsertNextCell(VTK_TETRA, idList);
-      }
-      if(newVertexIds.size() == 8) {
+      } else if(newVertexIds.size() == 8) {
         cellId = output->InsertNextCell(VTK_HEXAHEDRON, idList);
       } else {
         this->printWrn("Ill-defined cell type for cell #" + std::to_string(i)
@@ -269,7 +200,7 @@ int ttkPointMerger::RequestData(vtkInformation *request,
     if(cellId != -1) {
       // insert the cell data
       for(size_t j = 0; j < cellData.size(); j++) {
-        std::vector<double> data(cellData[j]->GetNumberOfComponents());
+        data.resize(cellData[j]->GetNumberOfComponents());
         input->GetCellData()->GetArray(j)->GetTuple(i, data.data());
         cellData[j]->InsertNextTuple(data.data());
       }
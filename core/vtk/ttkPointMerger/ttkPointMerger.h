@@ -8,6 +8,8 @@
 /// This filter merges the points of a mesh whose distance is lower than a user
 /// defined threshold.
 ///
+/// \sa ttk::PointMerger
+///
 /// \param Input Input data set (vtkDataSet)
 /// \param Output Output data set (vtkDataSet)
 ///
@@ -23,9 +25,11 @@
 #include <ttkPointMergerModule.h>
 
 // ttk code includes
+#include <PointMerger.h>
 #include <ttkAlgorithm.h>
 
-class TTKPOINTMERGER_EXPORT ttkPointMerger : public ttkAlgorithm {
+class TTKPOINTMERGER_EXPORT ttkPointMerger : public ttkAlgorithm,
+                                             protected ttk::PointMerger {
 public:
   static ttkPointMerger *New();
   vtkTypeMacro(ttkPointMerger, ttkAlgorithm);
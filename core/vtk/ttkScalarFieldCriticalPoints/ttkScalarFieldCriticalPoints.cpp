@@ -84,7 +84,7 @@ int ttkScalarFieldCriticalPoints::RequestData(
             {"  Offset Array", offsetField ? offsetField->GetName() : "None"}});
 
   int status = 0;
-  ttkTemplateMacro(
+  ttkGridTemplateMacro(
     triangulation->getType(),
     (status = this->execute(
        static_cast<SimplexId *>(ttkUtils::GetVoidPointer(offsetField)),
@@ -96,7 +96,7 @@ int ttkScalarFieldSmoother::RequestData(vtkInformation *request,
   this->setMaskDataPointer(inputMaskPtr);
 
   // calling the smoothing package
-  ttkVtkTemplateMacro(
+  ttkVtkGridTemplateMacro(
     inputScalarField->GetDataType(), triangulation->getType(),
     (this->smooth<VTK_TT, TTK_TT>(
       (TTK_TT *)triangulation->getData(), NumberOfIterations)));
@@ -80,7 +80,9 @@ int ttkTopologicalSimplificationByPersistence::RequestData(
   auto triangulation = ttkAlgorithm::GetTriangulation(inputDataSet);
   if(!triangulation)
     return 0;
-  this->preconditionTriangulation(triangulation);
+  // explicit meshes: compute the vertex neighbors by blocks, on demand
+  this->preconditionTriangulation(
+    triangulation, static_cast<size_t>(this->MemoryBudget) * 1024 * 1024);
 
   double persistenceThreshold = this->PersistenceThreshold;
   if(!this->ThresholdIsAbsolute) {
@@ -66,6 +66,7 @@ private:
   bool ThresholdIsAbsolute{true};
   bool ComputePerturbation{false};
   PAIR_TYPE PairType{PAIR_TYPE::EXTREMUM_SADDLE};
+  int MemoryBudget{0};
 
 public:
   vtkSetMacro(PersistenceThreshold, double);
@@ -76,6 +77,8 @@ public:
   vtkGetMacro(ComputePerturbation, bool);
   ttkSetEnumMacro(PairType, PAIR_TYPE);
   vtkGetEnumMacro(PairType, PAIR_TYPE);
+  vtkSetMacro(MemoryBudget, int);
+  vtkGetMacro(MemoryBudget, int);
 
   static ttkTopologicalSimplificationByPersistence *New();
   vtkTypeMacro(ttkTopologicalSimplificationByPersistence, ttkAlgorithm);
@@ -44,8 +44,8 @@ int ttkTrackingFromFields::trackWithPersistenceMatching(
   using trackingTuple = ttk::trackingTuple;
 
   // 1. get persistence diagrams.
-  std::vector<std::vector<diagramTuple>> persistenceDiagrams(
-    fieldNumber, std::vector<diagramTuple>());
+  std::vector<ttk::PersistenceDiagramColumns<double>> persistenceDiagrams(
+    fieldNumber);
 
   this->performDiagramComputation<dataType, triangulationType>(
     (int)fieldNumber, persistenceDiagrams, triangulation);
@@ -63,7 +63,7 @@ int ttkTrackingFromFields::trackWithPersistenceMatching(
 
   ttk::TrackingFromPersistenceDiagrams tfp{};
   tfp.setThreadNumber(this->threadNumber_);
-  tfp.performMatchings<dataType>(
+  tfp.performMatchings<double>(
     (int)fieldNumber, persistenceDiagrams, outputMatchings,
     algorithm, // Not from paraview, from enclosing tracking plugin
     wasserstein, tolerance, is3D,
@@ -92,21 +92,21 @@ int ttkTrackingFromFields::trackWithPersistenceMatching(
 
   // (+ vertex id)
   std::vector<trackingTuple> trackingsBase;
-  tfp.performTracking<dataType>(
+  tfp.performTracking<double>(
     persistenceDiagrams, outputMatchings, trackingsBase);
 
   std::vector<std::set<int>> trackingTupleToMerged(
     trackingsBase.size(), std::set<int>());
 
   if(DoPostProc) {
-    tfp.performPostProcess<dataType>(persistenceDiagrams, trackingsBase,
-                                     trackingTupleToMerged, PostProcThresh);
+    tfp.performPostProcess<double>(persistenceDiagrams, trackingsBase,
+                                   trackingTupleToMerged, PostProcThresh);
   }
 
   bool useGeometricSpacing = UseGeometricSpacing;
 
   // Build mesh.
-  ttkTrackingFromPersistenceDiagrams::buildMesh<dataType>(
+  ttkTrackingFromPersistenceDiagrams::buildMesh(
     trackingsBase, outputMatchings, persistenceDiagrams, useGeometricSpacing,
     spacing, DoPostProc, trackingTupleToMerged, points, persistenceDiagram,
     persistenceScalars, valueScalars, matchingIdScalars, lengthScalars,
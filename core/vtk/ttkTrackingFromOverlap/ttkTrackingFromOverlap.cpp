@@ -271,6 +271,7 @@ int ttkTrackingFromOverlap::reset() {
   this->timeLevelEdgesNMap.clear();
 
   this->previousIterationData = nullptr;
+  this->previousIterationPointSets.clear();
 
   return 1;
 }
@@ -529,14 +530,15 @@ int ttkTrackingFromOverlap::computeNodes(vtkMultiBlockDataSet *data) {
 // =============================================================================
 // Compute Tracking Graphs
 // =============================================================================
-int ttkTrackingFromOverlap::computeTrackingGraphs(vtkMultiBlockDataSet *data) {
+int ttkTrackingFromOverlap::computeTrackingGraphs(
+  vtkMultiBlockDataSet *data, const bool useStreamingOverTime) {
 
   Timer timer;
 
   size_t nL, nT;
   getNumberOfLevelsAndTimesteps(data, nL, nT);
 
-  if(nT < 2)
+  if(nT < 2 && !useStreamingOverTime)
     return 1;
 
   // Reusable variables
@@ -551,6 +553,8 @@ int ttkTrackingFromOverlap::computeTrackingGraphs(vtkMultiBlockDataSet *data) {
 
   if(this->levelTimeEdgesTMap.size() != nL)
     this->levelTimeEdgesTMap.resize(nL);
+  if(this->previousIterationPointSets.size() != nL)
+    this->previousIterationPointSets.resize(nL);
 
   for(size_t l = 0; l < nL; l++) {
     {
@@ -564,24 +568,47 @@ int ttkTrackingFromOverlap::computeTrackingGraphs(vtkMultiBlockDataSet *data) {
     size_t timeOffset = timeEdgesTMap.size();
     timeEdgesTMap.resize(timeOffset + nT - 1);
 
-    for(size_t t = 1; t < nT; t++) {
-      getData(data, t - 1, l, this->GetLabelFieldName(), pointSet0, labels0);
+    // Every timestep is prepared once and used for the overlaps with its
+    // previous and next timesteps
+    LabeledPointSet preparedSet0{}, preparedSet1{};
+
+    for(size_t t = 0; t < nT; t++) {
+      std::swap(preparedSet0, preparedSet1);
+
       getData(data, t, l, this->GetLabelFieldName(), pointSet1, labels1);
+      size_t nPoints1 = pointSet1->GetNumberOfPoints();
 
+      if(t == 0 && this->previousIterationData != nullptr) {
+        // first timestep is the last one of the previous iteration
+        preparedSet1 = std::move(this->previousIterationPointSets[l]);
+      } else {
+        preparedSet1 = LabeledPointSet{};
+        if(nPoints1 > 0) {
+          switch(this->LabelDataType) {
+            vtkTemplateMacro(this->preparePointSet<VTK_TT>(
+              (VTK_TT *)ttkUtils::GetVoidPointer(labels1), nPoints1,
+              preparedSet1));
+          }
+        }
+      }
+
+      if(t == 0)
+        continue;
+
+      getData(data, t - 1, l, this->GetLabelFieldName(), pointSet0, labels0);
       size_t nPoints0 = pointSet0->GetNumberOfPoints();
-      size_t nPoints1 = pointSet1->GetNumberOfPoints();
       if(nPoints0 < 1 || nPoints1 < 1)
         continue;
 
-      switch(this->LabelDataType) {
-        vtkTemplateMacro(this->computeOverlap<VTK_TT>(
-          (float *)ttkUtils::GetVoidPointer(pointSet0->GetPoints()),
-          (float *)ttkUtils::GetVoidPointer(pointSet1->GetPoints()),
-          (VTK_TT *)ttkUtils::GetVoidPointer(labels0),
-          (VTK_TT *)ttkUtils::GetVoidPointer(labels1), nPoints0, nPoints1,
-          timeEdgesTMap[timeOffset + t - 1]));
-      }
+      this->computeOverlap(
+        (float *)ttkUtils::GetVoidPointer(pointSet0->GetPoints()),
+        (float *)ttkUtils::GetVoidPointer(pointSet1->GetPoints()),
+        preparedSet0, preparedSet1, timeEdgesTMap[timeOffset + t - 1]);
     }
+
+    // Keep the last timestep for the next iteration
+    if(useStreamingOverTime)
+      this->previousIterationPointSets[l] = std::move(preparedSet1);
   }
 
   {
@@ -631,23 +658,37 @@ int ttkTrackingFromOverlap::computeNestingTrees(vtkMultiBlockDataSet *data) {
     vector<Edges> &levelEdgesNMap = this->timeLevelEdgesNMap[timeOffset + t];
     levelEdgesNMap.resize(nL - 1);
 
-    for(size_t l = 1; l < nL; l++) {
-      getData(data, t, l - 1, this->GetLabelFieldName(), pointSet0, labels0);
+    // Every level is prepared once and used for the overlaps with its
+    // parent and child levels
+    LabeledPointSet preparedSet0{}, preparedSet1{};
+
+    for(size_t l = 0; l < nL; l++) {
+      std::swap(preparedSet0, preparedSet1);
+
       getData(data, t, l, this->GetLabelFieldName(), pointSet1, labels1);
+      size_t nPoints1 = pointSet1->GetNumberOfPoints();
+
+      preparedSet1 = LabeledPointSet{};
+      if(nPoints1 > 0) {
+        switch(this->LabelDataType) {
+          vtkTemplateMacro(this->preparePointSet<VTK_TT>(
+            (VTK_TT *)ttkUtils::GetVoidPointer(labels1), nPoints1,
+            preparedSet1));
+        }
+      }
+
+      if(l == 0)
+        continue;
 
+      getData(data, t, l - 1, this->GetLabelFieldName(), pointSet0, labels0);
       size_t nPoints0 = pointSet0->GetNumberOfPoints();
-      size_t nPoints1 = pointSet1->GetNumberOfPoints();
       if(nPoints0 < 1 || nPoints1 < 1)
         continue;
 
-      switch(this->LabelDataType) {
-        vtkTemplateMacro(this->computeOverlap<VTK_TT>(
-          (float *)ttkUtils::GetVoidPointer(pointSet0->GetPoints()),
-          (float *)ttkUtils::GetVoidPointer(pointSet1->GetPoints()),
-          (VTK_TT *)ttkUtils::GetVoidPointer(labels0),
-          (VTK_TT *)ttkUtils::GetVoidPointer(labels1), nPoints0, nPoints1,
-          levelEdgesNMap[l - 1]));
-      }
+      this->computeOverlap(
+        (float *)ttkUtils::GetVoidPointer(pointSet0->GetPoints()),
+        (float *)ttkUtils::GetVoidPointer(pointSet1->GetPoints()),
+        preparedSet0, preparedSet1, levelEdgesNMap[l - 1]);
     }
   }
 
@@ -741,7 +782,7 @@ int ttkTrackingFromOverlap::RequestData(vtkInformation *request,
     return 0;
 
   // Compute tracking graphs
-  if(!this->computeTrackingGraphs(data))
+  if(!this->computeTrackingGraphs(data, useStreamingOverTime))
     return 0;
 
   // Compute nesting trees
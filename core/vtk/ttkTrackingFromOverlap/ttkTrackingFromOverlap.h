@@ -83,7 +83,8 @@ protected:
 
   int storeStreamedData(vtkMultiBlockDataSet *data);
   int computeNodes(vtkMultiBlockDataSet *data);
-  int computeTrackingGraphs(vtkMultiBlockDataSet *data);
+  int computeTrackingGraphs(vtkMultiBlockDataSet *data,
+                            const bool useStreamingOverTime);
   int computeNestingTrees(vtkMultiBlockDataSet *data);
   int computeBranches();
 
@@ -123,6 +124,8 @@ private:
   std::string LabelFieldName;
 
   vtkSmartPointer<vtkMultiBlockDataSet> previousIterationData;
+  // Last timestep of the previous iteration, prepared for the overlap
+  std::vector<LabeledPointSet> previousIterationPointSets;
 
   // Containers for nodes and edges
   std::vector<std::vector<Nodes>> levelTimeNodesMap; // N
@@ -1,5 +1,53 @@
+#include <ttkPersistenceDiagramUtils.h>
 #include <ttkTrackingFromPersistenceDiagrams.h>
 
+#include <vtkNew.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace {
+  using Diagram = ttk::PersistenceDiagramColumns<double>;
+
+  // extremum of the i-th pair (its death if both are extrema), the middle
+  // of the pair for saddle-saddle pairs
+  void getTrackedPoint(const Diagram &diagram,
+                       const int i,
+                       const bool useGeometricSpacing,
+                       const double zOffset,
+                       double p[3]) {
+    const BNodeType t1 = diagram.birthType[i];
+    const BNodeType t2 = diagram.deathType[i];
+    const bool t1Ex = t1 == BLocalMin || t1 == BLocalMax;
+    const bool t2Ex = t2 == BLocalMin || t2 == BLocalMax;
+    const bool bothEx = t1Ex && t2Ex;
+    const bool useDeath = bothEx ? t2 == BLocalMax : t2Ex;
+    const bool useBirth = bothEx ? !useDeath : t1Ex;
+    const std::array<float, 3> birth{
+      diagram.birthX[i], diagram.birthY[i], diagram.birthZ[i]};
+    const std::array<float, 3> death{
+      diagram.deathX[i], diagram.deathY[i], diagram.deathZ[i]};
+    for(int c = 0; c < 3; ++c) {
+      p[c] = useDeath   ? death[c]
+             : useBirth ? birth[c]
+                        : (birth[c] + death[c]) / 2;
+    }
+    if(useGeometricSpacing)
+      p[2] += zOffset;
+  }
+
+  // most significant critical type of the i-th pair
+  BNodeType getPointType(const Diagram &diagram, const int i) {
+    const BNodeType t1 = diagram.birthType[i];
+    const BNodeType t2 = diagram.deathType[i];
+    return t1 == BLocalMax || t2 == BLocalMax   ? BLocalMax
+           : t1 == BLocalMin || t2 == BLocalMin ? BLocalMin
+           : t1 == BSaddle2 || t2 == BSaddle2   ? BSaddle2
+                                                : BSaddle1;
+  }
+} // namespace
+
 vtkStandardNewMacro(ttkTrackingFromPersistenceDiagrams)
 
   using dataType = double;
@@ -51,12 +99,15 @@ int ttkTrackingFromPersistenceDiagrams::RequestData(
     input[i] = vtkDataSet::GetData(inputVector[0], i);
   }
 
-  std::vector<std::vector<diagramTuple>> inputPersistenceDiagrams(
-    (unsigned long)numInputs, std::vector<diagramTuple>());
+  std::vector<ttk::PersistenceDiagramColumns<dataType>>
+    inputPersistenceDiagrams((unsigned long)numInputs);
+  std::vector<std::vector<int>> inputCellIds((unsigned long)numInputs);
 
   std::vector<vtkSmartPointer<vtkUnstructuredGrid>> outputPersistenceDiagrams(
-    (unsigned long)2 * numInputs - 2,
-    vtkSmartPointer<vtkUnstructuredGrid>::New());
+    (unsigned long)2 * numInputs - 2);
+  for(auto &grid : outputPersistenceDiagrams) {
+    grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  }
 
   std::vector<std::vector<matchingTuple>> outputMatchings(
     (unsigned long)numInputs - 1, std::vector<matchingTuple>());
@@ -71,9 +122,14 @@ int ttkTrackingFromPersistenceDiagrams::RequestData(
 
   // Transform inputs into the right structure.
   for(int i = 0; i < numInputs; ++i) {
-    vtkUnstructuredGrid *grid1 = vtkUnstructuredGrid::New();
-    grid1->ShallowCopy(vtkUnstructuredGrid::SafeDownCast(input[i]));
-    this->getPersistenceDiagram(inputPersistenceDiagrams[i], grid1, spacing, 0);
+    auto grid = vtkUnstructuredGrid::SafeDownCast(input[i]);
+    if(grid == nullptr
+       || this->getPersistenceDiagram(inputPersistenceDiagrams[i],
+                                      inputCellIds[i], grid, spacing, 0)
+            < 0) {
+      this->printErr("Inputs are not persistence diagrams");
+      return 0;
+    }
   }
 
   this->performMatchings<dataType>(
@@ -87,24 +143,18 @@ int ttkTrackingFromPersistenceDiagrams::RequestData(
   // Get back meshes.
   //  #pragma omp parallel for num_threads(ThreadNumber)
   for(int i = 0; i < numInputs - 1; ++i) {
-    vtkUnstructuredGrid *grid1 = vtkUnstructuredGrid::New();
-    grid1->ShallowCopy(vtkUnstructuredGrid::SafeDownCast(input[i]));
-    vtkUnstructuredGrid *grid2 = vtkUnstructuredGrid::New();
-    grid2->ShallowCopy(vtkUnstructuredGrid::SafeDownCast(input[i + 1]));
-
     vtkUnstructuredGrid *CTPersistenceDiagram1_
-      = vtkUnstructuredGrid::SafeDownCast(grid1);
+      = outputPersistenceDiagrams[2 * i];
     vtkUnstructuredGrid *CTPersistenceDiagram2_
-      = vtkUnstructuredGrid::SafeDownCast(grid2);
+      = outputPersistenceDiagrams[2 * i + 1];
+    CTPersistenceDiagram1_->ShallowCopy(input[i]);
+    CTPersistenceDiagram2_->ShallowCopy(input[i + 1]);
 
-    int status = this->augmentPersistenceDiagrams<dataType>(
-      inputPersistenceDiagrams[i], inputPersistenceDiagrams[i + 1],
-      outputMatchings[i], CTPersistenceDiagram1_, CTPersistenceDiagram2_);
+    int status = this->augmentPersistenceDiagrams(
+      inputCellIds[i], inputCellIds[i + 1], outputMatchings[i],
+      CTPersistenceDiagram1_, CTPersistenceDiagram2_);
     if(status < 0)
       return -2;
-
-    outputPersistenceDiagrams[2 * i]->ShallowCopy(CTPersistenceDiagram1_);
-    outputPersistenceDiagrams[2 * i + 1]->ShallowCopy(CTPersistenceDiagram2_);
   }
 
   auto numPersistenceDiagramsInput
@@ -191,7 +241,7 @@ int ttkTrackingFromPersistenceDiagrams::RequestData(
   // Col = (id in pd 2, arrival point id)
 
   // Build mesh.
-  buildMesh<dataType>(
+  buildMesh(
     trackingsBase, outputMatchings, inputPersistenceDiagrams,
     useGeometricSpacing, spacing, DoPostProc, trackingTupleToMerged, points,
     persistenceDiagram, persistenceScalars, valueScalars, matchingIdScalars,
@@ -202,3 +252,237 @@ int ttkTrackingFromPersistenceDiagrams::RequestData(
 
   return 1;
 }
+
+int ttkTrackingFromPersistenceDiagrams::buildMesh(
+  std::vector<trackingTuple> &trackings,
+  std::vector<std::vector<matchingTuple>> &outputMatchings,
+  std::vector<ttk::PersistenceDiagramColumns<double>> &inputPersistenceDiagrams,
+  bool useGeometricSpacing,
+  double spacing,
+  bool DoPostProc,
+  std::vector<std::set<int>> &trackingTupleToMerged,
+  vtkPoints *points,
+  vtkUnstructuredGrid *persistenceDiagram,
+  vtkDoubleArray *persistenceScalars,
+  vtkDoubleArray *valueScalars,
+  vtkIntArray *matchingIdScalars,
+  vtkIntArray *lengthScalars,
+  vtkIntArray *timeScalars,
+  vtkIntArray *componentIds,
+  vtkIntArray *pointTypeScalars) {
+  int currentVertex = 0;
+  for(unsigned int k = 0; k < trackings.size(); ++k) {
+    trackingTuple tt = trackings.at((unsigned long)k);
+
+    int numStart = std::get<0>(tt);
+    //     int numEnd = std::get<1>(tt);
+    std::vector<BIdVertex> chain = std::get<2>(tt);
+    int chainLength = chain.size();
+
+    if(chain.size() <= 1) {
+      // printErr("Got an unexpected 0-size chain.");
+      return 0;
+    }
+
+    for(int c = 0; c < (int)chain.size() - 1; ++c) {
+      std::vector<matchingTuple> &matchings1 = outputMatchings[numStart + c];
+      int d1id = numStart + c;
+      int d2id = d1id + 1; // c % 2 == 0 ? d1id + 1 : d1id;
+      const auto &diagram1 = inputPersistenceDiagrams[d1id];
+      const auto &diagram2 = inputPersistenceDiagrams[d2id];
+
+      // Insert segments
+      vtkIdType ids[2];
+      auto n1 = (int)chain.at((unsigned long)c);
+      auto n2 = (int)chain.at((unsigned long)c + 1);
+
+      // Search for right matching.
+      double cost = 0.0;
+      for(matchingTuple tup : matchings1) {
+        auto d1id1 = (int)std::get<0>(tup);
+        if(d1id1 == n1) {
+          cost = std::get<2>(tup);
+          break;
+        }
+      }
+
+      double p1[3], p2[3];
+      BNodeType point1Type = getPointType(diagram1, n1);
+      getTrackedPoint(
+        diagram1, n1, useGeometricSpacing, spacing * (numStart + c), p1);
+
+      // Postproc component ids.
+      int cid = k;
+      bool hasMergedFirst = false;
+      // if(DoPostProc) {
+      if(0) {
+        std::set<int> &connected = trackingTupleToMerged[k];
+        if(!connected.empty()) {
+          int min = *(connected.begin());
+          trackingTuple ttt = trackings.at((unsigned long)min);
+          // int numStart2 = std::get<0>(ttt);
+          int numEnd2 = std::get<1>(ttt);
+          if((numEnd2 > 0 && numStart + c > numEnd2 + 1) && min < (int)k) {
+            cid = min;
+            hasMergedFirst = numStart + c <= numEnd2 + 3;
+          }
+
+          if(hasMergedFirst) {
+            // Replace former first end of the segment with previous ending
+            // segment.
+            std::vector<BIdVertex> chain3 = std::get<2>(ttt);
+            auto nn = (int)chain3.at(chain3.size() - 1);
+            const auto &diagramRematch = inputPersistenceDiagrams[numEnd2];
+            point1Type = getPointType(diagramRematch, nn);
+            getTrackedPoint(diagramRematch, nn, useGeometricSpacing,
+                            spacing * (numStart + c), p1);
+          }
+        }
+      }
+
+      points->InsertNextPoint(p1);
+      ids[0] = 2 * currentVertex;
+      pointTypeScalars->InsertTuple1(ids[0], (double)(int)point1Type);
+      timeScalars->InsertTuple1(ids[0], (double)numStart + c);
+      componentIds->InsertTuple1(ids[0], cid);
+
+      BNodeType point2Type = getPointType(diagram2, n2);
+      getTrackedPoint(
+        diagram2, n2, useGeometricSpacing, spacing * (numStart + c + 1), p2);
+      points->InsertNextPoint(p2);
+      ids[1] = 2 * currentVertex + 1;
+      pointTypeScalars->InsertTuple1(ids[1], (double)(int)point2Type);
+      timeScalars->InsertTuple1(ids[1], (double)numStart + c);
+
+      // Postproc component ids.
+      componentIds->InsertTuple1(ids[1], cid);
+
+      persistenceDiagram->InsertNextCell(VTK_LINE, 2, ids);
+
+      persistenceScalars->InsertTuple1(currentVertex, cost);
+      valueScalars->InsertTuple1(
+        currentVertex, (diagram1.death[n1] + diagram2.death[n2]) / 2);
+      matchingIdScalars->InsertTuple1(currentVertex, currentVertex);
+      lengthScalars->InsertTuple1(currentVertex, chainLength);
+
+      currentVertex++;
+    }
+  }
+
+  persistenceDiagram->SetPoints(points);
+  persistenceDiagram->GetCellData()->AddArray(persistenceScalars);
+  persistenceDiagram->GetCellData()->AddArray(valueScalars);
+  persistenceDiagram->GetCellData()->AddArray(matchingIdScalars);
+  persistenceDiagram->GetCellData()->AddArray(lengthScalars);
+  persistenceDiagram->GetPointData()->AddArray(timeScalars);
+  persistenceDiagram->GetPointData()->AddArray(componentIds);
+  persistenceDiagram->GetPointData()->AddArray(pointTypeScalars);
+
+  return 0;
+}
+
+int ttkTrackingFromPersistenceDiagrams::getPersistenceDiagram(
+  ttk::PersistenceDiagramColumns<double> &diagram,
+  std::vector<int> &cellIds,
+  vtkUnstructuredGrid *const CTPersistenceDiagram_,
+  const double spacing,
+  const int diagramNumber) {
+
+  auto pointData = CTPersistenceDiagram_->GetPointData();
+  if(pointData == nullptr)
+    return -1;
+
+  auto birthScalars = pointData->GetArray(ttk::PersistenceBirthName);
+  auto deathScalars = pointData->GetArray(ttk::PersistenceDeathName);
+  if(!deathScalars != !birthScalars)
+    return -2;
+  bool is2D = !deathScalars && !birthScalars;
+  bool is3D = !is2D;
+  if(Is3D && !is3D)
+    Is3D = false;
+
+  // the input is only read, the pairs being located by their points
+  Diagram pairs{};
+  const int status = VTUToDiagram(pairs, CTPersistenceDiagram_, *this, true);
+  if(status != 0)
+    return status;
+
+  // cells of the pairs (the diagonal is skipped)
+  auto pairIdentifierScalars = CTPersistenceDiagram_->GetCellData()->GetArray(
+    ttk::PersistencePairIdentifierName);
+  std::vector<int> pairCells{};
+  pairCells.reserve(pairs.size());
+  for(vtkIdType i = 0; i < pairIdentifierScalars->GetNumberOfTuples(); ++i) {
+    if(pairIdentifierScalars->GetComponent(i, 0) != -1)
+      pairCells.emplace_back(i);
+  }
+
+  // sorted by birth
+  std::vector<int> order(pairs.size());
+  std::iota(order.begin(), order.end(), 0);
+  const double *const birth = pairs.birth.data();
+  std::stable_sort(
+    order.begin(), order.end(),
+    [birth](const int a, const int b) { return birth[a] < birth[b]; });
+  diagram.gather(pairs, order);
+  cellIds.resize(order.size());
+  for(size_t i = 0; i < order.size(); ++i) {
+    cellIds[i] = pairCells[order[i]];
+  }
+
+  if(!Is3D && diagramNumber == 1) {
+    const float s = spacing;
+    float *const birthZ = diagram.birthZ.data();
+    float *const deathZ = diagram.deathZ.data();
+    for(size_t i = 0; i < diagram.size(); ++i) {
+      birthZ[i] += s;
+      deathZ[i] += s;
+    }
+  }
+
+  return 0;
+}
+
+int ttkTrackingFromPersistenceDiagrams::augmentPersistenceDiagrams(
+  const std::vector<int> &cellIds1,
+  const std::vector<int> &cellIds2,
+  const std::vector<matchingTuple> &matchings,
+  vtkUnstructuredGrid *const CTPersistenceDiagram1_,
+  vtkUnstructuredGrid *const CTPersistenceDiagram2_) {
+
+  if(matchings.empty())
+    return 0;
+
+  const auto nCells1 = CTPersistenceDiagram1_->GetNumberOfCells();
+  const auto nCells2 = CTPersistenceDiagram2_->GetNumberOfCells();
+
+  // Unaffected by default
+  vtkNew<vtkIntArray> matchingIdentifiers1{};
+  matchingIdentifiers1->SetName("MatchingIdentifier");
+  matchingIdentifiers1->SetNumberOfComponents(1);
+  matchingIdentifiers1->SetNumberOfTuples(nCells1);
+  matchingIdentifiers1->Fill(-1);
+
+  vtkNew<vtkIntArray> matchingIdentifiers2{};
+  matchingIdentifiers2->SetName("MatchingIdentifier");
+  matchingIdentifiers2->SetNumberOfComponents(1);
+  matchingIdentifiers2->SetNumberOfTuples(nCells2);
+  matchingIdentifiers2->Fill(-1);
+
+  // Affect bottleneck matchings
+  int pairingIndex = 0;
+  for(const auto &t : matchings) {
+    const int n1 = std::get<0>(t);
+    const int n2 = std::get<1>(t);
+    if(n1 >= 0 && n1 < static_cast<int>(cellIds1.size()))
+      matchingIdentifiers1->SetValue(cellIds1[n1], pairingIndex);
+    if(n2 >= 0 && n2 < static_cast<int>(cellIds2.size()))
+      matchingIdentifiers2->SetValue(cellIds2[n2], pairingIndex);
+    pairingIndex++;
+  }
+
+  CTPersistenceDiagram1_->GetCellData()->AddArray(matchingIdentifiers1);
+  CTPersistenceDiagram2_->GetCellData()->AddArray(matchingIdentifiers2);
+
+  return 0;
+}
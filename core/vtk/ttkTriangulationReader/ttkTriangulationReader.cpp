@@ -76,8 +76,11 @@ int ttkTriangulationReader::RequestData(vtkInformation *request,
   if(!this->validateFilePath()) {
     return 0;
   }
-  std::ifstream in(this->TriangulationFilePath);
-  explTri->readFromFile(in);
+  if(explTri->readFromFile(this->TriangulationFilePath, this->MemoryMap)
+     != 0) {
+    this->printErr("Could not read " + this->TriangulationFilePath);
+    return 0;
+  }
 
   this->printMsg("Restored triangulation from " + this->TriangulationFilePath,
                  1.0, timer.getElapsedTime(), 1);
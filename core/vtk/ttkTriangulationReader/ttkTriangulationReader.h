@@ -9,6 +9,9 @@
 /// sequence of calls SetInputData(), Update(), GetOutput()).
 ///
 /// \param Output Preconditioned triangulation attached to the input dataset
+///
+/// By default, the file is memory-mapped (see SetMemoryMap()): the
+/// preconditioned arrays are then used in-place, without any copy.
 
 #pragma once
 
@@ -28,6 +31,9 @@ public:
   vtkSetMacro(TriangulationFilePath, const std::string &);
   vtkGetMacro(TriangulationFilePath, std::string);
 
+  vtkSetMacro(MemoryMap, bool);
+  vtkGetMacro(MemoryMap, bool);
+
 protected:
   ttkTriangulationReader();
 
@@ -41,4 +47,5 @@ protected:
 
 private:
   std::string TriangulationFilePath{""};
+  bool MemoryMap{true};
 };
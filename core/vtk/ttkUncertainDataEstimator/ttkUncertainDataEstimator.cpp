@@ -1,6 +1,7 @@
 #include <vtkDataArray.h>
 #include <vtkDataSet.h>
 #include <vtkDoubleArray.h>
+#include <vtkFieldData.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
 #include <vtkNew.h>
@@ -97,6 +98,37 @@ int ttkUncertainDataEstimator::RequestData(vtkInformation *request,
     if(!inputScalarField[i])
       return -1;
   }
+
+  this->setHistogramRange(
+    UseHistogramRange, HistogramRange[0], HistogramRange[1]);
+
+  if(numFields == 0) {
+    return 1;
+  }
+
+  // Iteration of a ttkForEach loop?
+  auto iterationInformation
+    = vtkDoubleArray::SafeDownCast(input[0]->GetFieldData()->GetAbstractArray(
+      "_ttk_IterationInfo"));
+  if(iterationInformation) {
+    return this->processStreamed(
+      inputScalarField, static_cast<int>(iterationInformation->GetValue(0)),
+      static_cast<int>(iterationInformation->GetValue(1)), boundFields,
+      probability, mean);
+  }
+
+  return this->processBatch(inputScalarField, boundFields, probability, mean);
+}
+
+int ttkUncertainDataEstimator::processBatch(
+  const std::vector<vtkDataArray *> &inputScalarField,
+  vtkDataSet *boundFields,
+  vtkDataSet *probability,
+  vtkDataSet *mean) {
+
+  const int numFields = inputScalarField.size();
+  const ttk::SimplexId vertexNumber = boundFields->GetNumberOfPoints();
+
   // Allocate the memory for the output bound scalar fields
   vtkSmartPointer<vtkDataArray> outputLowerBoundScalarField{
     inputScalarField[0]->NewInstance()};
@@ -112,7 +144,7 @@ int ttkUncertainDataEstimator::RequestData(vtkInformation *request,
 
   // Create DoubleArray objects and link them to the data set
   for(int b = 0; b < BinCount; b++) {
-    probabilityScalarField[b]->SetNumberOfTuples(input[0]->GetNumberOfPoints());
+    probabilityScalarField[b]->SetNumberOfTuples(vertexNumber);
     probability->GetPointData()->AddArray(probabilityScalarField[b]);
     probabilityScalarField[b]->FillComponent(0, 0.);
   }
@@ -120,7 +152,7 @@ int ttkUncertainDataEstimator::RequestData(vtkInformation *request,
   // Mean field data set
   // Allocate new array
   vtkNew<vtkDoubleArray> meanField{};
-  meanField->SetNumberOfTuples(input[0]->GetNumberOfPoints());
+  meanField->SetNumberOfTuples(vertexNumber);
   meanField->SetName("meanField");
   meanField->FillComponent(0, 0.0);
 
@@ -128,50 +160,167 @@ int ttkUncertainDataEstimator::RequestData(vtkInformation *request,
 
   // Resize arrays and add them in the output if required
   if(ComputeLowerBound) {
-    outputLowerBoundScalarField->SetNumberOfTuples(
-      input[0]->GetNumberOfPoints());
+    outputLowerBoundScalarField->SetNumberOfTuples(vertexNumber);
     boundFields->GetPointData()->AddArray(outputLowerBoundScalarField);
   } else {
     outputLowerBoundScalarField->SetNumberOfTuples(0);
   }
 
   if(ComputeUpperBound) {
-    outputUpperBoundScalarField->SetNumberOfTuples(
-      input[0]->GetNumberOfPoints());
+    outputUpperBoundScalarField->SetNumberOfTuples(vertexNumber);
     boundFields->GetPointData()->AddArray(outputUpperBoundScalarField);
   } else {
     outputUpperBoundScalarField->SetNumberOfTuples(0);
   }
 
   // Calling the executing package
+  this->setVertexNumber(vertexNumber);
+  this->setSinglePass(false);
+  this->setBinCount(BinCount);
+
+  this->setNumberOfInputs(numFields);
+  for(int i = 0; i < numFields; i++) {
+    this->setInputDataPointer(i, ttkUtils::GetVoidPointer(inputScalarField[i]));
+  }
+
+  this->setOutputLowerBoundField(
+    ttkUtils::GetVoidPointer(outputLowerBoundScalarField));
+  this->setOutputUpperBoundField(
+    ttkUtils::GetVoidPointer(outputUpperBoundScalarField));
+  this->setOutputMeanField(ttkUtils::GetVoidPointer(meanField));
+
+  for(int b = 0; b < BinCount; b++) {
+    this->setOutputProbability(b, probabilityScalarField[b]->GetPointer(0));
+  }
+
+  switch(inputScalarField[0]->GetDataType()) {
+    vtkTemplateMacro(this->execute<VTK_TT>());
+  }
+
+  for(int b = 0; b < BinCount; b++) {
+    std::stringstream name{};
+    name << std::setprecision(8) << this->getBinValue(b);
+    probabilityScalarField[b]->SetName(name.str().c_str());
+  }
+
+  return 1;
+}
+
+int ttkUncertainDataEstimator::processStreamed(
+  const std::vector<vtkDataArray *> &inputScalarField,
+  const int iteration,
+  const int iterationNumber,
+  vtkDataSet *boundFields,
+  vtkDataSet *probability,
+  vtkDataSet *mean) {
 
-  if(numFields > 0) {
-    this->setVertexNumber(boundFields->GetNumberOfPoints());
+  const ttk::SimplexId vertexNumber = boundFields->GetNumberOfPoints();
+  const int dataType = inputScalarField[0]->GetDataType();
 
-    this->setNumberOfInputs(numFields);
-    for(int i = 0; i < numFields; i++) {
-      this->setInputDataPointer(
-        i, ttkUtils::GetVoidPointer(inputScalarField[i]));
+  // First iteration: allocate the accumulated outputs
+  if(iteration == 0) {
+    this->StreamedLowerBound = vtkSmartPointer<vtkDataArray>::Take(
+      inputScalarField[0]->NewInstance());
+    this->StreamedUpperBound = vtkSmartPointer<vtkDataArray>::Take(
+      inputScalarField[0]->NewInstance());
+    this->StreamedLowerBound->SetName("lowerBoundField");
+    this->StreamedUpperBound->SetName("upperBoundField");
+    this->StreamedLowerBound->SetNumberOfTuples(
+      ComputeLowerBound ? vertexNumber : 0);
+    this->StreamedUpperBound->SetNumberOfTuples(
+      ComputeUpperBound ? vertexNumber : 0);
+
+    this->StreamedMean = vtkSmartPointer<vtkDoubleArray>::New();
+    this->StreamedMean->SetName("meanField");
+    this->StreamedMean->SetNumberOfTuples(vertexNumber);
+
+    this->StreamedProbabilities.resize(BinCount);
+    for(auto &field : this->StreamedProbabilities) {
+      field = vtkSmartPointer<vtkDoubleArray>::New();
+      field->SetNumberOfTuples(vertexNumber);
+      field->FillComponent(0, 0.);
     }
 
+    this->setVertexNumber(vertexNumber);
+    this->setSinglePass(true);
+    this->setBinCount(BinCount);
     this->setOutputLowerBoundField(
-      ttkUtils::GetVoidPointer(outputLowerBoundScalarField));
+      ttkUtils::GetVoidPointer(this->StreamedLowerBound));
     this->setOutputUpperBoundField(
-      ttkUtils::GetVoidPointer(outputUpperBoundScalarField));
-    this->setOutputMeanField(ttkUtils::GetVoidPointer(meanField));
-
+      ttkUtils::GetVoidPointer(this->StreamedUpperBound));
+    this->setOutputMeanField(ttkUtils::GetVoidPointer(this->StreamedMean));
     for(int b = 0; b < BinCount; b++) {
-      this->setOutputProbability(b, probabilityScalarField[b]->GetPointer(0));
+      this->setOutputProbability(
+        b, this->StreamedProbabilities[b]->GetPointer(0));
     }
 
-    switch(inputScalarField[0]->GetDataType()) {
-      vtkTemplateMacro(this->execute<VTK_TT>());
+    if(this->startStreaming()) {
+      this->printErr("Could not start streaming.");
+      this->LastIteration = -1;
+      return 0;
+    }
+  } else if(iteration != this->LastIteration + 1) {
+    this->printErr("Iteration " + std::to_string(iteration)
+                   + " out of order, restart the loop.");
+    this->LastIteration = -1;
+    return 0;
+  }
+
+  if(dataType != this->StreamedLowerBound->GetDataType()) {
+    this->printErr("Inputs of different data types.");
+    this->LastIteration = -1;
+    return 0;
+  }
+  if(vertexNumber != this->StreamedMean->GetNumberOfTuples()) {
+    this->printErr("Inputs with different number of points.");
+    this->LastIteration = -1;
+    return 0;
+  }
+
+  // Accumulate the members of this iteration
+  for(const auto field : inputScalarField) {
+    const void *member = ttkUtils::GetVoidPointer(field);
+    int status = 0;
+    switch(dataType) {
+      vtkTemplateMacro(
+        status = this->processMember(static_cast<const VTK_TT *>(member)));
     }
+    if(status) {
+      this->printErr("Could not process member of iteration "
+                     + std::to_string(iteration) + ".");
+      this->LastIteration = -1;
+      return 0;
+    }
+  }
+  this->LastIteration = iteration;
+
+  this->printMsg("Accumulated iteration " + std::to_string(iteration) + " / "
+                 + std::to_string(iterationNumber - 1));
+
+  if(iteration < iterationNumber - 1) {
+    return 1;
+  }
 
+  // Last iteration: write the outputs
+  if(this->endStreaming()) {
+    this->printErr("Could not end streaming.");
+    this->LastIteration = -1;
+    return 0;
+  }
+
+  if(ComputeLowerBound) {
+    boundFields->GetPointData()->AddArray(this->StreamedLowerBound);
+  }
+  if(ComputeUpperBound) {
+    boundFields->GetPointData()->AddArray(this->StreamedUpperBound);
+  }
+  mean->GetPointData()->AddArray(this->StreamedMean);
+  if(this->hasHistograms()) {
     for(int b = 0; b < BinCount; b++) {
       std::stringstream name{};
       name << std::setprecision(8) << this->getBinValue(b);
-      probabilityScalarField[b]->SetName(name.str().c_str());
+      this->StreamedProbabilities[b]->SetName(name.str().c_str());
+      probability->GetPointData()->AddArray(this->StreamedProbabilities[b]);
     }
   }
 
@@ -16,6 +16,12 @@
 /// functions (vtkDataSet)
 /// \param Output2 Mean field (vtkDataSet)
 ///
+/// The ensemble members can also be streamed one at a time by a ttkForEach /
+/// ttkEndFor loop: each iteration accumulates its input fields and the
+/// outputs are written at the last iteration. The histograms then need a
+/// range set in advance (see SetUseHistogramRange()), as the members are
+/// only seen once.
+///
 /// This filter can be used as any other VTK filter (for instance, by using the
 /// sequence of calls SetInputData(), Update(), GetOutput()).
 ///
@@ -31,9 +37,16 @@
 #include <ttkAlgorithm.h>
 #include <ttkUncertainDataEstimatorModule.h>
 
+// VTK Includes
+#include <vtkSmartPointer.h>
+
 // ttk code includes
 #include <UncertainDataEstimator.h>
 
+class vtkDataArray;
+class vtkDataSet;
+class vtkDoubleArray;
+
 // in this example, this wrapper takes a data-set on the input and produces a
 // data-set on the output - to adapt.
 // see the documentation of the vtkAlgorithm class to decide from which VTK
@@ -56,6 +69,12 @@ public:
   vtkGetMacro(BinCount, int);
   vtkSetMacro(BinCount, int);
 
+  vtkGetMacro(UseHistogramRange, bool);
+  vtkSetMacro(UseHistogramRange, bool);
+
+  vtkGetVector2Macro(HistogramRange, double);
+  vtkSetVector2Macro(HistogramRange, double);
+
   void SetBoundToCompute(int value) {
     if(value == 0) {
       SetComputeLowerBound(true);
@@ -78,4 +97,27 @@ protected:
   int RequestData(vtkInformation *request,
                   vtkInformationVector **inputVector,
                   vtkInformationVector *outputVector) override;
+
+private:
+  int processBatch(const std::vector<vtkDataArray *> &inputScalarField,
+                   vtkDataSet *boundFields,
+                   vtkDataSet *probability,
+                   vtkDataSet *mean);
+
+  int processStreamed(const std::vector<vtkDataArray *> &inputScalarField,
+                      const int iteration,
+                      const int iterationNumber,
+                      vtkDataSet *boundFields,
+                      vtkDataSet *probability,
+                      vtkDataSet *mean);
+
+  bool UseHistogramRange{false};
+  double HistogramRange[2]{0.0, 1.0};
+
+  // accumulated outputs of a ttkForEach loop
+  vtkSmartPointer<vtkDataArray> StreamedLowerBound{};
+  vtkSmartPointer<vtkDataArray> StreamedUpperBound{};
+  vtkSmartPointer<vtkDoubleArray> StreamedMean{};
+  std::vector<vtkSmartPointer<vtkDoubleArray>> StreamedProbabilities{};
+  int LastIteration{-1};
 };
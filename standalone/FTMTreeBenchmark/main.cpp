@@ -0,0 +1,222 @@
+/// \date October 2021.
+///
+/// \brief Benchmark of the priority queues of the FTM tree propagations.
+///
+/// Benchmark 0 compares the pairing heap with the Boost Fibonacci heap on
+/// a synthetic propagation workload: the vertices of a random order are
+/// distributed over several heaps, which are then melded two by two. Both
+/// heaps pop the vertices in the same order, the checksums must match.
+///
+/// Benchmark 1 builds the merge trees of a scalar field on a regular grid
+/// of n^3 vertices with the heap selected at configuration time
+/// (TTK_ENABLE_FTM_TREE_FIBONACCI_HEAP). Build TTK once per heap to
+/// compare them. The planar field sweeps the grid with a front of n^2
+/// vertices, the widest front of the propagations.
+
+#include <CommandLineParser.h>
+#include <FTMPairingHeap.h>
+#include <FTMTree.h>
+#include <ImplicitTriangulation.h>
+
+#include <boost/heap/fibonacci_heap.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // pops the vertex of lowest offset first, as the pairing heap
+  struct OffsetComparator {
+    const ttk::SimplexId *offsets;
+    bool operator()(const ttk::SimplexId a, const ttk::SimplexId b) const {
+      return offsets[a] > offsets[b];
+    }
+  };
+
+  using FibonacciHeap
+    = boost::heap::fibonacci_heap<ttk::SimplexId,
+                                  boost::heap::compare<OffsetComparator>>;
+
+  template <typename Heap>
+  void popVertex(Heap &heap,
+                 ttk::LongSimplexId &rank,
+                 ttk::LongSimplexId &checksum) {
+    checksum += ++rank * heap.top();
+    heap.pop();
+  }
+
+  // each heap pops one vertex every two insertions, then the heaps are
+  // melded two by two and partially emptied after each meld, as the
+  // propagations do at the saddles
+  template <typename Heap>
+  ttk::LongSimplexId propagate(std::vector<Heap> &heaps,
+                               const ttk::SimplexId vertexNumber) {
+    const ttk::SimplexId heapNumber = heaps.size();
+    const ttk::SimplexId popsPerMeld
+      = std::max<ttk::SimplexId>(1, vertexNumber / (4 * heapNumber));
+    ttk::LongSimplexId rank{}, checksum{};
+
+    for(ttk::SimplexId v = 0; v < vertexNumber; ++v) {
+      auto &heap = heaps[v % heapNumber];
+      heap.emplace(v);
+      if((v / heapNumber) % 2 == 1) {
+        popVertex(heap, rank, checksum);
+      }
+    }
+
+    for(ttk::SimplexId step = 1; step < heapNumber; step *= 2) {
+      for(ttk::SimplexId i = 0; i + step < heapNumber; i += 2 * step) {
+        heaps[i].merge(heaps[i + step]);
+        for(ttk::SimplexId j = 0; j < popsPerMeld && !heaps[i].empty(); ++j) {
+          popVertex(heaps[i], rank, checksum);
+        }
+      }
+    }
+
+    while(!heaps[0].empty()) {
+      popVertex(heaps[0], rank, checksum);
+    }
+
+    return checksum;
+  }
+
+  void benchmarkHeaps(const ttk::Debug &msg,
+                      const ttk::SimplexId vertexNumber,
+                      const int heapNumber) {
+
+    std::vector<ttk::SimplexId> offsets(vertexNumber);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    std::shuffle(offsets.begin(), offsets.end(), std::mt19937{0});
+    const ttk::SimplexId *offsetsPtr = offsets.data();
+
+    msg.printMsg("Input: " + std::to_string(vertexNumber) + " vertices, "
+                 + std::to_string(heapNumber) + " heaps");
+
+    {
+      ttk::Timer t;
+      std::vector<ttk::ftm::PairingHeap> heaps;
+      heaps.reserve(heapNumber);
+      for(int i = 0; i < heapNumber; ++i) {
+        heaps.emplace_back(&offsetsPtr, false);
+      }
+      const auto checksum = propagate(heaps, vertexNumber);
+      msg.printMsg("Pairing heap: " + std::to_string(t.getElapsedTime())
+                   + " s, checksum " + std::to_string(checksum));
+    }
+
+    {
+      ttk::Timer t;
+      std::vector<FibonacciHeap> heaps;
+      heaps.reserve(heapNumber);
+      for(int i = 0; i < heapNumber; ++i) {
+        heaps.emplace_back(OffsetComparator{offsetsPtr});
+      }
+      const auto checksum = propagate(heaps, vertexNumber);
+      msg.printMsg("Fibonacci heap: " + std::to_string(t.getElapsedTime())
+                   + " s, checksum " + std::to_string(checksum));
+    }
+  }
+
+  void benchmarkTree(const ttk::Debug &msg,
+                     const ttk::SimplexId n,
+                     const int field,
+                     const int treeType,
+                     const int threadNumber) {
+
+    ttk::ImplicitTriangulation triangulation;
+    triangulation.setInputGrid(0, 0, 0, 1, 1, 1, n, n, n);
+
+    // sum of sine waves with many saddles, or a slightly perturbed plane
+    const ttk::SimplexId vertexNumber = n * n * n;
+    std::vector<double> scalars(vertexNumber);
+    std::mt19937 gen{0};
+    std::uniform_real_distribution<double> noise{0.0, 1e-3};
+    for(ttk::SimplexId v = 0; v < vertexNumber; ++v) {
+      const double x = v % n, y = (v / n) % n, z = v / (n * n);
+      if(field == 0) {
+        scalars[v] = std::sin(0.2 * x) * std::cos(0.2 * y) + std::sin(0.2 * z);
+      } else {
+        scalars[v] = x + noise(gen);
+      }
+    }
+    std::vector<ttk::SimplexId> order(vertexNumber), offsets(vertexNumber);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&scalars](const ttk::SimplexId a, const ttk::SimplexId b) {
+                return scalars[a] < scalars[b]
+                       || (scalars[a] == scalars[b] && a < b);
+              });
+    for(ttk::SimplexId i = 0; i < vertexNumber; ++i) {
+      offsets[order[i]] = i;
+    }
+
+#ifdef TTK_ENABLE_FTM_TREE_FIBONACCI_HEAP
+    const std::string heapName{"Fibonacci heap"};
+#else
+    const std::string heapName{"pairing heap"};
+#endif // TTK_ENABLE_FTM_TREE_FIBONACCI_HEAP
+    msg.printMsg("Input: " + std::to_string(vertexNumber) + " vertices, "
+                 + heapName);
+
+    ttk::ftm::FTMTree tree;
+    tree.setDebugLevel(0);
+    tree.setThreadNumber(threadNumber);
+    tree.preconditionTriangulation(&triangulation);
+    tree.setVertexScalars(scalars.data());
+    tree.setVertexSoSoffsets(offsets.data());
+    tree.setTreeType(treeType);
+    tree.setSegmentation(true);
+    tree.setNormalizeIds(true);
+
+    ttk::Timer t;
+    tree.build<double, ttk::ImplicitTriangulation>(&triangulation);
+    const double elapsed = t.getElapsedTime();
+
+    msg.printMsg("Tree nodes: "
+                 + std::to_string(
+                   tree.getTree(static_cast<ttk::ftm::TreeType>(treeType))
+                     ->getNumberOfNodes()));
+    msg.printMsg("Time: " + std::to_string(elapsed) + " s");
+  }
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+  int gridSize{128};
+  int benchmark{0};
+  int heapNumber{64};
+  int field{0};
+  int treeType{2};
+  int threadNumber{1};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument("n", &gridSize, "Number of vertices per axis", true);
+    parser.setArgument(
+      "b", &benchmark, "Benchmark {0: heaps, 1: FTM tree}", true);
+    parser.setArgument("H", &heapNumber, "Number of heaps (benchmark 0)", true);
+    parser.setArgument(
+      "f", &field, "Scalar field {0: sine waves, 1: plane}", true);
+    parser.setArgument(
+      "T", &treeType, "Tree type {0: join, 1: split, 2: contour}", true);
+    parser.setArgument("t", &threadNumber, "Number of threads", true);
+    parser.parse(argc, argv);
+  }
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("FTMTreeBenchmark");
+
+  const ttk::SimplexId n = gridSize;
+  if(benchmark == 0) {
+    benchmarkHeaps(msg, n * n * n, std::max(heapNumber, 1));
+  } else {
+    benchmarkTree(msg, n, field, treeType, threadNumber);
+  }
+
+  return 0;
+}
@@ -0,0 +1,153 @@
+/// \date October 2021.
+///
+/// \brief Benchmark of the implicit triangulation, with and without its
+/// per-simplex lookup tables.
+///
+/// The input is a regular grid of n^3 vertices. The program reports the
+/// preconditioning time and memory (peak resident set size of the process
+/// minus the resident set size before preconditioning), then the time of
+/// query loops over every simplex. Run one mode per process to get
+/// meaningful memory figures.
+
+#include <CommandLineParser.h>
+#include <Os.h>
+#include <Triangulation.h>
+
+#include <string>
+
+namespace {
+
+  // sum of the results of a query loop, so that it is not optimized out
+  template <typename Query>
+  ttk::LongSimplexId timeQuery(const ttk::Debug &msg,
+                               const std::string &name,
+                               const ttk::SimplexId simplexNumber,
+                               const Query &query) {
+    ttk::Timer t;
+    ttk::LongSimplexId checksum{};
+    for(ttk::SimplexId i = 0; i < simplexNumber; ++i) {
+      checksum += query(i);
+    }
+    msg.printMsg(name + ": " + std::to_string(t.getElapsedTime()) + " s");
+    return checksum;
+  }
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+  int gridSize{128};
+  bool noLookupTables{false};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument("n", &gridSize, "Number of vertices per axis", true);
+    parser.setOption("t", &noLookupTables, "Disable the lookup tables");
+    parser.parse(argc, argv);
+  }
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("ImplicitTriangulationBenchmark");
+
+  const ttk::SimplexId n = gridSize;
+  ttk::Triangulation triangulation;
+  triangulation.setDebugLevel(0);
+  triangulation.setImplicitLookupTables(!noLookupTables);
+  triangulation.setInputGrid(0, 0, 0, 1, 1, 1, n, n, n);
+
+  msg.printMsg("Input: " + std::to_string(n * n * n) + " vertices, lookup "
+               + (noLookupTables ? "tables disabled" : "tables enabled"));
+
+  const float memoryBefore = ttk::OsCall::getMemoryPeakUsage();
+  ttk::Timer t;
+
+  triangulation.preconditionVertexNeighbors();
+  triangulation.preconditionEdges();
+  triangulation.preconditionEdgeStars();
+  triangulation.preconditionTriangles();
+  triangulation.preconditionTriangleEdges();
+  triangulation.preconditionTriangleStars();
+  triangulation.preconditionCellTriangles();
+
+  const double elapsed = t.getElapsedTime();
+  const float memoryPeak = ttk::OsCall::getMemoryPeakUsage();
+
+  msg.printMsg("Preconditioning: " + std::to_string(elapsed) + " s, "
+               + std::to_string(memoryPeak - memoryBefore) + " MB");
+
+  ttk::LongSimplexId checksum{};
+
+  checksum += timeQuery(
+    msg, "Vertex neighbors", triangulation.getNumberOfVertices(),
+    [&triangulation](const ttk::SimplexId v) {
+      ttk::SimplexId sum{};
+      const auto nNeighbors = triangulation.getVertexNeighborNumber(v);
+      for(ttk::SimplexId i = 0; i < nNeighbors; ++i) {
+        ttk::SimplexId neighbor{};
+        triangulation.getVertexNeighbor(v, i, neighbor);
+        sum += neighbor;
+      }
+      return sum;
+    });
+
+  checksum += timeQuery(msg, "Edge vertices", triangulation.getNumberOfEdges(),
+                        [&triangulation](const ttk::SimplexId e) {
+                          ttk::SimplexId v0{}, v1{};
+                          triangulation.getEdgeVertex(e, 0, v0);
+                          triangulation.getEdgeVertex(e, 1, v1);
+                          return v0 + v1;
+                        });
+
+  checksum += timeQuery(
+    msg, "Edge stars", triangulation.getNumberOfEdges(),
+    [&triangulation](const ttk::SimplexId e) {
+      ttk::SimplexId sum{};
+      const auto nStars = triangulation.getEdgeStarNumber(e);
+      for(ttk::SimplexId i = 0; i < nStars; ++i) {
+        ttk::SimplexId star{};
+        triangulation.getEdgeStar(e, i, star);
+        sum += star;
+      }
+      return sum;
+    });
+
+  checksum += timeQuery(
+    msg, "Triangle edges", triangulation.getNumberOfTriangles(),
+    [&triangulation](const ttk::SimplexId tr) {
+      ttk::SimplexId sum{};
+      for(int i = 0; i < 3; ++i) {
+        ttk::SimplexId edge{};
+        triangulation.getTriangleEdge(tr, i, edge);
+        sum += edge;
+      }
+      return sum;
+    });
+
+  checksum += timeQuery(
+    msg, "Cell vertices", triangulation.getNumberOfCells(),
+    [&triangulation](const ttk::SimplexId c) {
+      ttk::SimplexId sum{};
+      for(int i = 0; i < 4; ++i) {
+        ttk::SimplexId vertex{};
+        triangulation.getCellVertex(c, i, vertex);
+        sum += vertex;
+      }
+      return sum;
+    });
+
+  checksum += timeQuery(
+    msg, "Cell triangles", triangulation.getNumberOfCells(),
+    [&triangulation](const ttk::SimplexId c) {
+      ttk::SimplexId sum{};
+      for(int i = 0; i < 4; ++i) {
+        ttk::SimplexId triangle{};
+        triangulation.getCellTriangle(c, i, triangle);
+        sum += triangle;
+      }
+      return sum;
+    });
+
+  msg.printMsg("Checksum: " + std::to_string(checksum));
+
+  return 0;
+}
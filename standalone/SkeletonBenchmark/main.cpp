@@ -0,0 +1,180 @@
+/// \date October 2021.
+///
+/// \brief Benchmark of the skeleton builders (vertex stars and
+/// neighbors, edge and triangle lists).
+///
+/// The input is a regular grid of n^3 vertices, each cube being split
+/// into 6 tetrahedra. The program reports the build time and the memory
+/// used by the builder (peak resident set size of the process minus the
+/// resident set size before the build). Run one builder per process to
+/// get meaningful memory figures, and vary the number of threads to
+/// measure the scaling.
+
+#include <CommandLineParser.h>
+#include <OneSkeleton.h>
+#include <Os.h>
+#include <TwoSkeleton.h>
+#include <ZeroSkeleton.h>
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // Freudenthal tetrahedralization of a grid of n^3 vertices
+  struct TetrahedralGrid {
+    explicit TetrahedralGrid(const ttk::SimplexId n)
+      : vertexNumber{n * n * n}, cellNumber{6 * (n - 1) * (n - 1) * (n - 1)} {
+
+      const std::array<std::array<int, 3>, 6> permutations{{
+        {0, 1, 2},
+        {0, 2, 1},
+        {1, 0, 2},
+        {1, 2, 0},
+        {2, 0, 1},
+        {2, 1, 0},
+      }};
+      const std::array<ttk::SimplexId, 3> axisSteps{1, n, n * n};
+
+#ifdef TTK_CELL_ARRAY_NEW
+      connectivity.reserve(4 * cellNumber);
+      offsets.reserve(cellNumber + 1);
+      offsets.emplace_back(0);
+#else
+      connectivity.reserve(5 * cellNumber);
+#endif // TTK_CELL_ARRAY_NEW
+
+      for(ttk::SimplexId k = 0; k < n - 1; ++k) {
+        for(ttk::SimplexId j = 0; j < n - 1; ++j) {
+          for(ttk::SimplexId i = 0; i < n - 1; ++i) {
+            const ttk::SimplexId origin = i + j * n + k * n * n;
+            for(const auto &p : permutations) {
+#ifdef TTK_CELL_ARRAY_NEW
+              offsets.emplace_back(offsets.back() + 4);
+#else
+              connectivity.emplace_back(4);
+#endif // TTK_CELL_ARRAY_NEW
+              ttk::SimplexId v = origin;
+              connectivity.emplace_back(v);
+              for(const auto axis : p) {
+                v += axisSteps[axis];
+                connectivity.emplace_back(v);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    ttk::CellArray getCellArray() const {
+#ifdef TTK_CELL_ARRAY_NEW
+      return ttk::CellArray(connectivity.data(), offsets.data(), cellNumber);
+#else
+      return ttk::CellArray(connectivity.data(), cellNumber, 3);
+#endif // TTK_CELL_ARRAY_NEW
+    }
+
+    const ttk::SimplexId vertexNumber;
+    const ttk::SimplexId cellNumber;
+    std::vector<ttk::LongSimplexId> connectivity{};
+#ifdef TTK_CELL_ARRAY_NEW
+    std::vector<ttk::LongSimplexId> offsets{};
+#endif // TTK_CELL_ARRAY_NEW
+  };
+
+  // returns the number of built simplices (or relation entries)
+  size_t runBuilder(const TetrahedralGrid &grid,
+                    const int builder,
+                    const bool withStars,
+                    const int threadNumber) {
+
+    const auto cellArray = grid.getCellArray();
+
+    if(builder == 0) {
+      ttk::OneSkeleton oneSkeleton;
+      oneSkeleton.setThreadNumber(threadNumber);
+      std::vector<std::array<ttk::SimplexId, 2>> edgeList{};
+      ttk::FlatJaggedArray edgeStars{};
+      std::vector<std::array<ttk::SimplexId, 6>> cellEdgeList{};
+      oneSkeleton.buildEdgeList<6>(grid.vertexNumber, cellArray, &edgeList,
+                                   withStars ? &edgeStars : nullptr,
+                                   withStars ? &cellEdgeList : nullptr);
+      return edgeList.size();
+    } else if(builder == 1) {
+      ttk::TwoSkeleton twoSkeleton;
+      twoSkeleton.setThreadNumber(threadNumber);
+      std::vector<std::array<ttk::SimplexId, 3>> triangleList{};
+      ttk::FlatJaggedArray triangleStars{};
+      std::vector<std::array<ttk::SimplexId, 4>> cellTriangleList{};
+      twoSkeleton.buildTriangleList(
+        grid.vertexNumber, cellArray, &triangleList,
+        withStars ? &triangleStars : nullptr,
+        withStars ? &cellTriangleList : nullptr);
+      return triangleList.size();
+    }
+
+    ttk::ZeroSkeleton zeroSkeleton;
+    zeroSkeleton.setThreadNumber(threadNumber);
+    if(builder == 2) {
+      ttk::FlatJaggedArray vertexStars{};
+      zeroSkeleton.buildVertexStars(grid.vertexNumber, cellArray, vertexStars);
+      return vertexStars.dataSize();
+    }
+    // the edge list is built on the way
+    ttk::FlatJaggedArray vertexNeighbors{};
+    zeroSkeleton.buildVertexNeighbors(
+      grid.vertexNumber, cellArray, vertexNeighbors);
+    return vertexNeighbors.dataSize();
+  }
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+  int gridSize{128};
+  int builder{0};
+  bool withStars{false};
+  int threadNumber{1};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument("n", &gridSize, "Number of vertices per axis", true);
+    parser.setArgument("b", &builder,
+                       "Builder {0: edge list, 1: triangle list, "
+                       "2: vertex stars, 3: vertex neighbors}",
+                       true);
+    parser.setOption(
+      "s", &withStars, "Also build the stars and the cell simplex lists");
+    parser.setArgument("t", &threadNumber, "Number of threads", true);
+    parser.parse(argc, argv);
+  }
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("SkeletonBenchmark");
+
+  const TetrahedralGrid grid(gridSize);
+
+  msg.printMsg("Input: " + std::to_string(grid.vertexNumber) + " vertices, "
+               + std::to_string(grid.cellNumber) + " tetrahedra, "
+               + std::to_string(threadNumber) + " thread(s)");
+
+  const float memoryBefore = ttk::OsCall::getMemoryPeakUsage();
+  ttk::Timer t;
+
+  const auto simplexNumber = runBuilder(grid, builder, withStars, threadNumber);
+
+  const double elapsed = t.getElapsedTime();
+  const float memoryPeak = ttk::OsCall::getMemoryPeakUsage();
+
+  const std::array<std::string, 4> builtNames{
+    " edges", " triangles", " vertex star entries", " vertex neighbor entries"};
+  msg.printMsg("Built " + std::to_string(simplexNumber)
+               + builtNames[std::min(std::max(builder, 0), 3)]);
+  msg.printMsg("Time: " + std::to_string(elapsed) + " s");
+  msg.printMsg("Builder peak memory: "
+               + std::to_string(memoryPeak - memoryBefore) + " MB");
+
+  return 0;
+}